@@ -34,4 +34,34 @@ function(scan_for_shaders)
 
     # Add shaders (sources) into a 'Shaders' folder for Visual Studio
     source_group("shaders" FILES ${SHADERS_SRC})
-endfunction()
\ No newline at end of file
+endfunction()
+
+#
+# Build shaders that ship with the framework (framework/shaders/) into this sample's shader output directory.
+# Pass the shader base names, eg add_framework_shaders(GpuSkinning) builds GpuSkinning.comp and copies GpuSkinning.json.
+#
+function(add_framework_shaders)
+    set(SHADER_OUTPUT_PATH "${CMAKE_CURRENT_SOURCE_DIR}/Media/Shaders")
+    if(DEFINED SHADER_DESTINATION)
+        set(SHADER_OUTPUT_PATH "${CMAKE_CURRENT_SOURCE_DIR}/${SHADER_DESTINATION}")
+    endif()
+
+    set(target_prefix "${PROJECT_NAME}")
+    set(framework_shaders_dir "${CMAKE_CURRENT_FUNCTION_LIST_DIR}/../shaders")
+
+    set(glsl_files "")
+    set(json_files "")
+    foreach(shader_name ${ARGN})
+        file(GLOB shader_files "${framework_shaders_dir}/${shader_name}.vert" "${framework_shaders_dir}/${shader_name}.frag" "${framework_shaders_dir}/${shader_name}.comp")
+        if(NOT shader_files)
+            message(FATAL_ERROR "add_framework_shaders: no framework shader named ${shader_name}")
+        endif()
+        list(APPEND glsl_files ${shader_files})
+        if(EXISTS "${framework_shaders_dir}/${shader_name}.json")
+            list(APPEND json_files "${framework_shaders_dir}/${shader_name}.json")
+        endif()
+    endforeach()
+
+    compile_glsl("${glsl_files}" "vulkan1.1" "${SHADER_OUTPUT_PATH}" "${target_prefix}_FrameworkGLSL")
+    copy_json("${json_files}" "json" "${SHADER_OUTPUT_PATH}" "${target_prefix}_FrameworkJSON")
+endfunction()
@@ -0,0 +1,262 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "animationBlend.hpp"
+#include "skeletonData.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include "glm/gtx/quaternion.hpp"
+
+static glm::quat NlerpShortest(const glm::quat& q0, glm::quat q1, float mix)
+{
+    if (glm::dot(q0, q1) < 0.0f)
+        q1 = -q1;
+    return glm::normalize(q0 * (1.0f - mix) + q1 * mix);
+}
+
+/// additive / reference per component (1 where the reference scale is ~0)
+static glm::vec3 ScaleRatio(const glm::vec3& additive, const glm::vec3& reference)
+{
+    glm::vec3 ratio;
+    for (int c = 0; c < 3; ++c)
+        ratio[c] = std::abs(reference[c]) > 0.0001f ? additive[c] / reference[c] : 1.0f;
+    return ratio;
+}
+
+static float WrapTime(float time, float endTime)
+{
+    if (endTime <= 0.0f)
+        return 0.0f;
+    time = std::fmod(time, endTime);
+    return time < 0.0f ? time + endTime : time;
+}
+
+AnimationBlendGraph::AnimationBlendGraph(std::vector<AnimationNodeTransform> restPose)
+    : m_RestPose(std::move(restPose))
+{
+}
+
+AnimationBlendGraph::NodeIdx AnimationBlendGraph::AddClip(const AnimationClip& clip, float playbackRate, bool synchronized)
+{
+    assert(clip.GetNumNodes() == 0 || *std::max_element(clip.GetNodeIds().begin(), clip.GetNodeIds().end()) < m_RestPose.size());
+    Node node;
+    node.Type = NodeType::Clip;
+    node.pClip = &clip;
+    node.Cursor = clip.MakeCursor();
+    node.PlaybackRate = playbackRate;
+    node.Synchronized = synchronized;
+    m_Nodes.push_back(std::move(node));
+    if (m_ClipPose.size() < clip.GetNumNodes())
+        m_ClipPose.resize(clip.GetNumNodes());
+    return m_RootIdx = (NodeIdx)m_Nodes.size() - 1;
+}
+
+AnimationBlendGraph::NodeIdx AnimationBlendGraph::AddBlend(NodeIdx input0, NodeIdx input1, float weight, JointMask mask)
+{
+    assert(input0 < m_Nodes.size() && input1 < m_Nodes.size());
+    assert(mask.empty() || mask.size() == m_RestPose.size());
+    Node node;
+    node.Type = NodeType::Blend;
+    node.Inputs[0] = input0;
+    node.Inputs[1] = input1;
+    node.Weight = weight;
+    node.Mask = std::move(mask);
+    m_Nodes.push_back(std::move(node));
+    return m_RootIdx = (NodeIdx)m_Nodes.size() - 1;
+}
+
+AnimationBlendGraph::NodeIdx AnimationBlendGraph::AddAdditive(NodeIdx base, NodeIdx additiveClipNode, float weight, JointMask mask)
+{
+    assert(base < m_Nodes.size() && additiveClipNode < m_Nodes.size());
+    assert(m_Nodes[additiveClipNode].Type == NodeType::Clip);
+    assert(mask.empty() || mask.size() == m_RestPose.size());
+    Node node;
+    node.Type = NodeType::Additive;
+    node.Inputs[0] = base;
+    node.Inputs[1] = additiveClipNode;
+    node.Weight = weight;
+    node.Mask = std::move(mask);
+    const AnimationClip& additiveClip = *m_Nodes[additiveClipNode].pClip;
+    node.ReferencePose.resize(additiveClip.GetNumNodes());
+    additiveClip.Evaluate(0.0f, node.ReferencePose);
+    m_Nodes.push_back(std::move(node));
+    return m_RootIdx = (NodeIdx)m_Nodes.size() - 1;
+}
+
+float AnimationBlendGraph::CalcSynchronizedDuration(NodeIdx nodeIdx) const
+{
+    const Node& node = m_Nodes[nodeIdx];
+    switch (node.Type)
+    {
+    case NodeType::Clip:
+        return (node.Synchronized && node.PlaybackRate > 0.0f) ? node.pClip->GetEndTime() / node.PlaybackRate : 0.0f;
+    case NodeType::Blend:
+    {
+        const float duration0 = CalcSynchronizedDuration(node.Inputs[0]);
+        const float duration1 = CalcSynchronizedDuration(node.Inputs[1]);
+        if (duration0 <= 0.0f)
+            return duration1;
+        if (duration1 <= 0.0f)
+            return duration0;
+        return glm::mix(duration0, duration1, std::clamp(node.Weight, 0.0f, 1.0f));
+    }
+    case NodeType::Additive:
+        return CalcSynchronizedDuration(node.Inputs[0]);
+    }
+    return 0.0f;
+}
+
+void AnimationBlendGraph::Update(float elapsedTime)
+{
+    if (m_RootIdx == cInvalidNode)
+        return;
+    const float synchronizedDuration = CalcSynchronizedDuration(m_RootIdx);
+    if (synchronizedDuration > 0.0f)
+        m_Phase = WrapTime(m_Phase + elapsedTime / synchronizedDuration, 1.0f);
+
+    for (auto& node : m_Nodes)
+    {
+        if (node.Type != NodeType::Clip)
+            continue;
+        const float endTime = node.pClip->GetEndTime();
+        node.Time = node.Synchronized ? m_Phase * endTime : WrapTime(node.Time + elapsedTime * node.PlaybackRate, endTime);
+    }
+}
+
+std::span<AnimationNodeTransform> AnimationBlendGraph::AcquirePose()
+{
+    if (m_PosesInUse == m_PosePool.size())
+        m_PosePool.emplace_back(m_RestPose.size());
+    return m_PosePool[m_PosesInUse++];
+}
+
+void AnimationBlendGraph::Evaluate(std::span<AnimationNodeTransform> poseOut)
+{
+    assert(poseOut.size() == m_RestPose.size());
+    if (m_RootIdx == cInvalidNode)
+    {
+        std::copy(m_RestPose.begin(), m_RestPose.end(), poseOut.begin());
+        return;
+    }
+    EvaluateNode(m_RootIdx, poseOut);
+    assert(m_PosesInUse == 0);
+}
+
+void AnimationBlendGraph::EvaluateNode(NodeIdx nodeIdx, std::span<AnimationNodeTransform> poseOut)
+{
+    Node& node = m_Nodes[nodeIdx];
+    switch (node.Type)
+    {
+    case NodeType::Clip:
+    {
+        const AnimationClip& clip = *node.pClip;
+        std::copy(m_RestPose.begin(), m_RestPose.end(), poseOut.begin());
+        clip.Evaluate(std::clamp(node.Time, 0.0f, clip.GetEndTime()), m_ClipPose, &node.Cursor);
+        for (uint32_t clipNodeIdx = 0; clipNodeIdx < clip.GetNumNodes(); ++clipNodeIdx)
+            poseOut[clip.GetNodeId(clipNodeIdx)] = m_ClipPose[clipNodeIdx];
+        break;
+    }
+    case NodeType::Blend:
+    {
+        const float weight = std::clamp(node.Weight, 0.0f, 1.0f);
+        if (weight <= 0.0f)
+        {
+            EvaluateNode(node.Inputs[0], poseOut);
+            break;
+        }
+        if (weight >= 1.0f && node.Mask.empty())
+        {
+            EvaluateNode(node.Inputs[1], poseOut);
+            break;
+        }
+        EvaluateNode(node.Inputs[0], poseOut);
+        auto pose1 = AcquirePose();
+        EvaluateNode(node.Inputs[1], pose1);
+        for (size_t nodeId = 0; nodeId < poseOut.size(); ++nodeId)
+        {
+            const float jointWeight = node.Mask.empty() ? weight : weight * node.Mask[nodeId];
+            if (jointWeight <= 0.0f)
+                continue;
+            auto& transform = poseOut[nodeId];
+            const auto& transform1 = pose1[nodeId];
+            transform.Translation = glm::mix(transform.Translation, transform1.Translation, jointWeight);
+            transform.Rotation = NlerpShortest(transform.Rotation, transform1.Rotation, jointWeight);
+            transform.Scale = glm::mix(transform.Scale, transform1.Scale, jointWeight);
+        }
+        ReleasePose();
+        break;
+    }
+    case NodeType::Additive:
+    {
+        EvaluateNode(node.Inputs[0], poseOut);
+        if (node.Weight == 0.0f)
+            break;
+        // Additive clip is evaluated in clip node order (to match the reference pose), only the nodes it animates are changed.
+        Node& additiveNode = m_Nodes[node.Inputs[1]];
+        const AnimationClip& clip = *additiveNode.pClip;
+        clip.Evaluate(std::clamp(additiveNode.Time, 0.0f, clip.GetEndTime()), m_ClipPose, &additiveNode.Cursor);
+        for (uint32_t clipNodeIdx = 0; clipNodeIdx < clip.GetNumNodes(); ++clipNodeIdx)
+        {
+            const uint32_t nodeId = clip.GetNodeId(clipNodeIdx);
+            const float jointWeight = node.Mask.empty() ? node.Weight : node.Weight * node.Mask[nodeId];
+            if (jointWeight == 0.0f)
+                continue;
+            const auto& additive = m_ClipPose[clipNodeIdx];
+            const auto& reference = node.ReferencePose[clipNodeIdx];
+            auto& transform = poseOut[nodeId];
+            transform.Translation += (additive.Translation - reference.Translation) * jointWeight;
+            const glm::quat deltaRotation = glm::inverse(reference.Rotation) * additive.Rotation;
+            transform.Rotation = glm::normalize(transform.Rotation * NlerpShortest(glm::identity<glm::quat>(), deltaRotation, jointWeight));
+            transform.Scale *= glm::mix(glm::vec3(1.0f), ScaleRatio(additive.Scale, reference.Scale), jointWeight);
+        }
+        break;
+    }
+    }
+}
+
+std::vector<AnimationNodeTransform> AnimationBlendGraph::MakeRestPose(const SkeletonData& skeletonData)
+{
+    const auto& sortedNodeIds = skeletonData.GetSortedNodeIds();
+    const uint32_t numNodes = sortedNodeIds.empty() ? 0 : *std::max_element(sortedNodeIds.begin(), sortedNodeIds.end()) + 1;
+    std::vector<AnimationNodeTransform> restPose(numNodes);
+    for (uint32_t nodeId : sortedNodeIds)
+    {
+        const glm::mat4& local = skeletonData.GetNodeById(nodeId)->LocalTransform();
+        auto& transform = restPose[nodeId];
+        transform.Translation = glm::vec3(local[3]);
+        transform.Scale = glm::vec3(glm::length(glm::vec3(local[0])), glm::length(glm::vec3(local[1])), glm::length(glm::vec3(local[2])));
+        const glm::vec3 safeScale = glm::max(transform.Scale, glm::vec3(0.0001f));
+        transform.Rotation = glm::normalize(glm::quat_cast(glm::mat3(glm::vec3(local[0]) / safeScale.x, glm::vec3(local[1]) / safeScale.y, glm::vec3(local[2]) / safeScale.z)));
+    }
+    return restPose;
+}
+
+AnimationBlendGraph::JointMask AnimationBlendGraph::MakeMask(const SkeletonData& skeletonData, uint32_t rootNodeId, float weight)
+{
+    const auto& sortedNodeIds = skeletonData.GetSortedNodeIds();
+    const auto& sortedParents = skeletonData.GetSortedParents();
+    const uint32_t numNodes = sortedNodeIds.empty() ? 0 : *std::max_element(sortedNodeIds.begin(), sortedNodeIds.end()) + 1;
+    JointMask mask(numNodes, 0.0f);
+    // Parents precede their children, so one pass marks the whole subtree.
+    std::vector<uint8_t> inSubtree(sortedNodeIds.size(), 0);
+    for (size_t sortedIdx = 0; sortedIdx < sortedNodeIds.size(); ++sortedIdx)
+    {
+        inSubtree[sortedIdx] = sortedNodeIds[sortedIdx] == rootNodeId || (sortedParents[sortedIdx] >= 0 && inSubtree[sortedParents[sortedIdx]]);
+        if (inSubtree[sortedIdx])
+            mask[sortedNodeIds[sortedIdx]] = weight;
+    }
+    return mask;
+}
+
+void AnimationBlendGraph::PoseToMatrices(std::span<const AnimationNodeTransform> pose, std::span<glm::mat4> matricesOut)
+{
+    assert(matricesOut.size() >= pose.size());
+    for (size_t nodeId = 0; nodeId < pose.size(); ++nodeId)
+        matricesOut[nodeId] = glm::translate(pose[nodeId].Translation) * glm::toMat4(pose[nodeId].Rotation) * glm::scale(pose[nodeId].Scale);
+}
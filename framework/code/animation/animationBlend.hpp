@@ -0,0 +1,116 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "system/glm_common.hpp"
+#include "animationClip.hpp"
+
+// forward declarations
+class SkeletonData;
+
+
+/// @brief Pose blend graph (crossfades, masked layers and additive layers) for one animated character.
+/// @ingroup Animation
+/// Leaf nodes play AnimationClips (sampled with AnimationClip::Evaluate), Blend nodes interpolate two inputs (crossfade, or an override
+/// layer when given a joint mask) and Additive nodes add the difference between a clip and its first frame on to a base pose.
+/// Poses are local space transforms indexed by (gltf) node id, nodes a clip does not animate take the rest pose.
+///
+/// Clips can be phase synchronized: synchronized clips share one normalized phase which advances at the rate of the (blend weighted)
+/// duration of the synchronized clips feeding the root, so eg walk and run cycles stay in step while crossfading.
+/// Intermediate poses come from a pool that grows to the graph depth on the first Evaluate, there are no per-frame allocations after that.
+/// Not thread safe (use one graph per character).
+class AnimationBlendGraph
+{
+    AnimationBlendGraph(const AnimationBlendGraph&) = delete;
+    AnimationBlendGraph& operator=(const AnimationBlendGraph&) = delete;
+public:
+    using NodeIdx = uint32_t;
+    static constexpr NodeIdx cInvalidNode = UINT32_MAX;
+    /// Per joint weight (0-1), indexed by node id
+    using JointMask = std::vector<float>;
+
+    /// @param restPose local transforms (indexed by node id) for nodes not animated by a clip, see MakeRestPose
+    explicit AnimationBlendGraph(std::vector<AnimationNodeTransform> restPose);
+    AnimationBlendGraph(AnimationBlendGraph&&) noexcept = default;
+
+    /// Add a clip player.
+    /// @param playbackRate time scale (of the clip, or of its duration when synchronized)
+    /// @param synchronized play in step with the other synchronized clips (see class description) rather than independently
+    NodeIdx AddClip(const AnimationClip& clip, float playbackRate = 1.0f, bool synchronized = false);
+    /// Add a blend of two nodes, (1 - weight) * input0 + weight * input1 (per joint weight * mask[nodeId] if a mask is given).
+    NodeIdx AddBlend(NodeIdx input0, NodeIdx input1, float weight, JointMask mask = {});
+    /// Add an additive layer, base + weight * (additive clip pose - additive clip pose at its first frame).
+    /// @param additiveClipNode must be a clip node (from AddClip)
+    NodeIdx AddAdditive(NodeIdx base, NodeIdx additiveClipNode, float weight, JointMask mask = {});
+    /// Node evaluated by Evaluate (defaults to the last node added)
+    void SetRoot(NodeIdx nodeIdx)                   { m_RootIdx = nodeIdx; }
+    /// Change a Blend or Additive node's weight (eg to crossfade)
+    void SetWeight(NodeIdx nodeIdx, float weight)   { m_Nodes[nodeIdx].Weight = weight; }
+    float GetWeight(NodeIdx nodeIdx) const          { return m_Nodes[nodeIdx].Weight; }
+    /// Set the (unsynchronized) clip node's playback time
+    void SetClipTime(NodeIdx clipNodeIdx, float time) { m_Nodes[clipNodeIdx].Time = time; }
+    float GetPhase() const                          { return m_Phase; }
+
+    /// Advance clip times (and the synchronized phase), wrapping at the end of each clip.
+    void Update(float elapsedTime);
+    /// Evaluate the root node.
+    /// @param poseOut indexed by node id, same size as the rest pose
+    void Evaluate(std::span<AnimationNodeTransform> poseOut);
+
+    uint32_t GetNumNodes() const                    { return (uint32_t)m_Nodes.size(); }
+    uint32_t GetNumPooledPoses() const              { return (uint32_t)m_PosePool.size(); }
+    const auto& GetRestPose() const                 { return m_RestPose; }
+
+    /// Decompose the skeleton's local transforms in to a rest pose
+    static std::vector<AnimationNodeTransform> MakeRestPose(const SkeletonData& skeletonData);
+    /// Mask with weight for the subtree starting at rootNodeId (and 0 elsewhere), eg an upper body mask
+    static JointMask MakeMask(const SkeletonData& skeletonData, uint32_t rootNodeId, float weight = 1.0f);
+    /// Local matrices (for Skeleton::TransformLocalToWorld) from a pose
+    static void PoseToMatrices(std::span<const AnimationNodeTransform> pose, std::span<glm::mat4> matricesOut);
+
+protected:
+    enum class NodeType
+    {
+        Clip,
+        Blend,
+        Additive
+    };
+    struct Node
+    {
+        NodeType                Type = NodeType::Clip;
+        NodeIdx                 Inputs[2] = { cInvalidNode, cInvalidNode };
+        float                   Weight = 0.0f;
+        JointMask               Mask;                   ///< empty for no mask
+        // Clip nodes
+        const AnimationClip*    pClip = nullptr;
+        AnimationClip::Cursor   Cursor;
+        float                   Time = 0.0f;
+        float                   PlaybackRate = 1.0f;
+        bool                    Synchronized = false;
+        // Additive nodes
+        std::vector<AnimationNodeTransform> ReferencePose;   ///< [clip node] additive clip at its first frame
+    };
+
+    void EvaluateNode(NodeIdx nodeIdx, std::span<AnimationNodeTransform> poseOut);
+    /// @return blend weighted duration of the synchronized clips feeding nodeIdx (0 if there are none)
+    float CalcSynchronizedDuration(NodeIdx nodeIdx) const;
+    std::span<AnimationNodeTransform> AcquirePose();
+    void ReleasePose()                              { --m_PosesInUse; }
+
+    std::vector<Node>                               m_Nodes;
+    NodeIdx                                         m_RootIdx = cInvalidNode;
+    float                                           m_Phase = 0.0f;         ///< synchronized clip phase [0,1)
+    std::vector<AnimationNodeTransform>             m_RestPose;             ///< [node id]
+    std::vector<std::vector<AnimationNodeTransform>> m_PosePool;            ///< [node id] intermediate poses, used as a stack
+    uint32_t                                        m_PosesInUse = 0;
+    std::vector<AnimationNodeTransform>             m_ClipPose;             ///< [clip node] scratch for AnimationClip::Evaluate
+};
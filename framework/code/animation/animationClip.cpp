@@ -0,0 +1,335 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "animationClip.hpp"
+#include "animation.hpp"
+#include "animationData.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+static constexpr float cSmallestThreeRange = 0.70710678f;   // 1/sqrt(2), largest magnitude of the 3 smallest components of a unit quaternion
+static constexpr float cMinFrameDt = 0.0001f;               // same as Animation (CalcFrameMix)
+// [dropped component][x,y,z,w] index in to the three stored components (0-2) and the reconstructed, dropped, component (3).
+static constexpr uint8_t cSmallestThreeSlots[4][4] = { { 3,0,1,2 }, { 0,3,1,2 }, { 0,1,3,2 }, { 0,1,2,3 } };
+
+static glm::quat NlerpShortest(const glm::quat& q0, glm::quat q1, float mix)
+{
+    if (glm::dot(q0, q1) < 0.0f)
+        q1 = -q1;
+    return glm::normalize(q0 * (1.0f - mix) + q1 * mix);
+}
+
+static float RotationAngle(const glm::quat& a, const glm::quat& b)
+{
+    return 2.0f * std::acos(std::min(std::abs(glm::dot(a, b)), 1.0f));
+}
+
+static float MaxAbsDifference(const glm::vec3& a, const glm::vec3& b)
+{
+    const glm::vec3 d = glm::abs(a - b);
+    return std::max(d.x, std::max(d.y, d.z));
+}
+
+/// Select the keys to keep.  Greedy: extend the span from the last kept key until an intermediate key is no longer interpolated (by the span end points) within tolerance.
+/// @param isWithinError(a, b, k, mix) true if key k is within tolerance of the interpolation of keys a and b
+template<typename T_ISWITHINERROR>
+static std::vector<uint32_t> ReduceKeys(std::span<const float> times, const T_ISWITHINERROR& isWithinError, bool reduce)
+{
+    const uint32_t numKeys = (uint32_t)times.size();
+    std::vector<uint32_t> keep;
+    if (!reduce || numKeys <= 2)
+    {
+        keep.resize(numKeys);
+        for (uint32_t i = 0; i < numKeys; ++i)
+            keep[i] = i;
+        return keep;
+    }
+    // Constant track, only needs one key.
+    bool constant = true;
+    for (uint32_t k = 1; k < numKeys && constant; ++k)
+        constant = isWithinError(0, 0, k, 0.0f);
+    if (constant)
+        return { 0 };
+
+    keep.push_back(0);
+    uint32_t a = 0;
+    for (uint32_t b = 2; b < numKeys; ++b)
+    {
+        const float dt = times[b] - times[a];
+        for (uint32_t k = a + 1; k < b; ++k)
+        {
+            const float mix = dt > cMinFrameDt ? (times[k] - times[a]) / dt : 0.0f;
+            if (!isWithinError(a, b, k, mix))
+            {
+                a = b - 1;
+                keep.push_back(a);
+                break;
+            }
+        }
+    }
+    keep.push_back(numKeys - 1);
+    return keep;
+}
+
+AnimationClip AnimationClip::Compile(const Animation& animation, const Config& config)
+{
+    return Compile(animation.GetAnimationData(), animation.GetEndTime(), config);
+}
+
+AnimationClip AnimationClip::Compile(const AnimationData& animationData, float endTime, const Config& config)
+{
+    AnimationClip clip;
+    clip.m_EndTime = endTime;
+    clip.m_Looping = config.Looping;
+
+    const auto& nodes = animationData.GetNodes();
+    clip.m_NodeIds.reserve(nodes.size());
+    clip.m_Tracks.reserve(nodes.size());
+
+    const AnimationFrameData cDefaultFrame{ .Timestamp = 0.0f };
+    std::vector<AnimationFrameData> frames;
+    std::vector<float> times;
+    std::vector<float> keptTimes;
+
+    // Range (and 16 bit step) of the given translation/scale keys.
+    auto calculateRange = [&](std::span<const uint32_t> keep, glm::vec3 AnimationFrameData::* pValue, glm::vec3& minOut, glm::vec3& stepOut) {
+        glm::vec3 minValue = frames[keep[0]].*pValue;
+        glm::vec3 maxValue = minValue;
+        for (uint32_t k : keep)
+        {
+            minValue = glm::min(minValue, frames[k].*pValue);
+            maxValue = glm::max(maxValue, frames[k].*pValue);
+        }
+        minOut = minValue;
+        stepOut = (maxValue - minValue) / 65535.0f;
+    };
+    auto quantize = [](const glm::vec3& value, const glm::vec3& minValue, const glm::vec3& step) -> QuantizedKey {
+        QuantizedKey key;
+        for (int c = 0; c < 3; ++c)
+            key[c] = step[c] > 0.0f ? (uint16_t)std::clamp(std::lround((value[c] - minValue[c]) / step[c]), 0l, 65535l) : 0;
+        return key;
+    };
+
+    for (const auto& node : nodes)
+    {
+        clip.m_NodeIds.push_back(node.NodeId);
+        // Nodes without animation get one key of the default transform (so every node samples the same way).
+        frames.assign(node.Frames.begin(), node.Frames.end());
+        if (frames.empty())
+            frames.push_back(cDefaultFrame);
+        times.clear();
+        for (auto& frame : frames)
+        {
+            frame.Rotation = glm::normalize(frame.Rotation);
+            times.push_back(frame.Timestamp);
+        }
+
+        // One set of keys for all three channels, keeping a key if any channel needs it.
+        const auto keep = ReduceKeys(times, [&](uint32_t a, uint32_t b, uint32_t k, float mix) {
+            return MaxAbsDifference(glm::mix(frames[a].Translation, frames[b].Translation, mix), frames[k].Translation) <= config.TranslationError
+                && RotationAngle(NlerpShortest(frames[a].Rotation, frames[b].Rotation, mix), frames[k].Rotation) <= config.RotationError
+                && MaxAbsDifference(glm::mix(frames[a].Scale, frames[b].Scale, mix), frames[k].Scale) <= config.ScaleError;
+        }, config.ReduceKeys);
+
+        NodeTrack track;
+        keptTimes.clear();
+        for (uint32_t k : keep)
+            keptTimes.push_back(times[k]);
+        track.TimeArray = clip.AddTimeArray(keptTimes);
+        track.KeyOffset = (uint32_t)clip.m_Keys.size();
+        calculateRange(keep, &AnimationFrameData::Translation, track.TranslationMin, track.TranslationStep);
+        calculateRange(keep, &AnimationFrameData::Scale, track.ScaleMin, track.ScaleStep);
+        for (uint32_t k : keep)
+        {
+            const auto& frame = frames[k];
+            clip.m_Keys.push_back({ quantize(frame.Translation, track.TranslationMin, track.TranslationStep), QuantizeRotation(frame.Rotation), quantize(frame.Scale, track.ScaleMin, track.ScaleStep) });
+        }
+        clip.m_Tracks.push_back(track);
+    }
+    return clip;
+}
+
+uint32_t AnimationClip::AddTimeArray(std::span<const float> times)
+{
+    for (uint32_t i = 0; i < (uint32_t)m_TimeArrays.size(); ++i)
+    {
+        const auto& timeArray = m_TimeArrays[i];
+        if (timeArray.Count == times.size() && std::memcmp(m_Times.data() + timeArray.Offset, times.data(), times.size_bytes()) == 0)
+            return i;
+    }
+    m_TimeArrays.push_back({ (uint32_t)m_Times.size(), (uint32_t)times.size() });
+    m_Times.insert(m_Times.end(), times.begin(), times.end());
+    return (uint32_t)m_TimeArrays.size() - 1;
+}
+
+AnimationClip::QuantizedKey AnimationClip::QuantizeRotation(glm::quat rotation)
+{
+    rotation = glm::normalize(rotation);
+    const float components[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i)
+        if (std::abs(components[i]) > std::abs(components[largest]))
+            largest = i;
+    // q and -q are the same rotation, flip so the dropped component is positive (and can be reconstructed with a sqrt).
+    const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+    QuantizedKey key;
+    uint32_t keyIdx = 0;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        const float normalized = std::clamp((components[i] * sign + cSmallestThreeRange) / (2.0f * cSmallestThreeRange), 0.0f, 1.0f);
+        key[keyIdx++] = (uint16_t)std::lround(normalized * 32767.0f);
+    }
+    key[0] |= (uint16_t)((largest & 1) << 15);
+    key[1] |= (uint16_t)((largest >> 1) << 15);
+    return key;
+}
+
+glm::quat AnimationClip::DequantizeRotation(const QuantizedKey& key)
+{
+    // Branch free, dequantize the three stored components and reconstruct the dropped one, then pick them in to x,y,z,w order.
+    const uint32_t largest = (key[0] >> 15) | ((key[1] >> 15) << 1);
+    float values[4];
+    for (uint32_t i = 0; i < 3; ++i)
+        values[i] = float(key[i] & 0x7fff) * (2.0f * cSmallestThreeRange / 32767.0f) - cSmallestThreeRange;
+    values[3] = std::sqrt(std::max(0.0f, 1.0f - values[0] * values[0] - values[1] * values[1] - values[2] * values[2]));
+    const uint8_t* pSlots = cSmallestThreeSlots[largest];
+    return glm::quat(values[pSlots[3]], values[pSlots[0]], values[pSlots[1]], values[pSlots[2]]);
+}
+
+AnimationClip::KeySpan AnimationClip::FindKeys(uint32_t timeArrayIdx, float time, uint32_t& keyHint) const
+{
+    const auto& timeArray = m_TimeArrays[timeArrayIdx];
+    const float* pTimes = m_Times.data() + timeArray.Offset;
+    const uint32_t numKeys = timeArray.Count;
+    if (numKeys <= 1)
+        return {};
+
+    // Check the hinted span (and the one after it), before falling back to a binary search.
+    uint32_t key0;
+    if (keyHint + 1 < numKeys && pTimes[keyHint] <= time && time < pTimes[keyHint + 1])
+        key0 = keyHint;
+    else if (keyHint + 2 < numKeys && pTimes[keyHint + 1] <= time && time < pTimes[keyHint + 2])
+        key0 = keyHint + 1;
+    else if (time < pTimes[0])
+        key0 = numKeys - 1;     // before the first key, interpolate from the last key (looping) or hold the first key (below)
+    else
+        key0 = (uint32_t)(std::upper_bound(pTimes, pTimes + numKeys, time) - pTimes) - 1;
+    keyHint = key0;
+
+    KeySpan keySpan;
+    keySpan.Key0 = key0;
+    float frameDt;
+    float t;
+    if (key0 == numKeys - 1 && !m_Looping)
+    {
+        // Not looping, hold the first key before it and the last key after it.
+        keySpan.Key0 = keySpan.Key1 = time < pTimes[0] ? 0 : key0;
+        return keySpan;
+    }
+    if (key0 == numKeys - 1)
+    {
+        // Straddling the loop, interpolate from the last key to the first.
+        keySpan.Key1 = 0;
+        frameDt = m_EndTime - pTimes[key0] + pTimes[0];
+        t = time >= pTimes[key0] ? time - pTimes[key0] : time + m_EndTime - pTimes[key0];
+    }
+    else
+    {
+        keySpan.Key1 = key0 + 1;
+        frameDt = pTimes[key0 + 1] - pTimes[key0];
+        t = time - pTimes[key0];
+    }
+    keySpan.Mix = frameDt > cMinFrameDt ? std::clamp(t / frameDt, 0.0f, 1.0f) : 0.0f;
+    return keySpan;
+}
+
+AnimationNodeTransform AnimationClip::SampleNode(const NodeTrack& track, const NodeKey& key0, const NodeKey& key1, float mix)
+{
+    // Interpolate in the quantized space and scale once.  Single key (and held) spans have key0 == key1, so need no special case.
+    AnimationNodeTransform transform;
+    for (int c = 0; c < 3; ++c)
+    {
+        const float translation0 = float(key0.Translation[c]);
+        const float scale0 = float(key0.Scale[c]);
+        transform.Translation[c] = track.TranslationMin[c] + (translation0 + (float(key1.Translation[c]) - translation0) * mix) * track.TranslationStep[c];
+        transform.Scale[c] = track.ScaleMin[c] + (scale0 + (float(key1.Scale[c]) - scale0) * mix) * track.ScaleStep[c];
+    }
+
+    // Shortest path nlerp, the sign flip is a select rather than a branch.
+    const glm::quat rotation0 = DequantizeRotation(key0.Rotation);
+    const glm::quat rotation1 = DequantizeRotation(key1.Rotation);
+    const float sign1 = (rotation0.x * rotation1.x + rotation0.y * rotation1.y + rotation0.z * rotation1.z + rotation0.w * rotation1.w) < 0.0f ? -mix : mix;
+    const float x = rotation0.x + (rotation1.x * sign1 - rotation0.x * mix);
+    const float y = rotation0.y + (rotation1.y * sign1 - rotation0.y * mix);
+    const float z = rotation0.z + (rotation1.z * sign1 - rotation0.z * mix);
+    const float w = rotation0.w + (rotation1.w * sign1 - rotation0.w * mix);
+    const float invLength = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+    transform.Rotation = glm::quat(w * invLength, x * invLength, y * invLength, z * invLength);
+    return transform;
+}
+
+void AnimationClip::UpdateKeySpans(float time, Cursor& cursor) const
+{
+    assert(cursor.KeyHints.size() == m_TimeArrays.size());
+    // One key search per time array, shared by every track using it.
+    cursor.KeySpans.resize(m_TimeArrays.size());
+    for (uint32_t i = 0; i < (uint32_t)m_TimeArrays.size(); ++i)
+        cursor.KeySpans[i] = FindKeys(i, time, cursor.KeyHints[i]);
+}
+
+void AnimationClip::Evaluate(float time, std::span<AnimationNodeTransform> transformsOut, Cursor* pCursor) const
+{
+    assert(transformsOut.size() >= m_NodeIds.size());
+    Cursor localCursor;
+    if (!pCursor)
+    {
+        localCursor = MakeCursor();
+        pCursor = &localCursor;
+    }
+    UpdateKeySpans(time, *pCursor);
+
+    const KeySpan* pKeySpans = pCursor->KeySpans.data();
+    const NodeKey* pKeys = m_Keys.data();
+    for (uint32_t nodeIdx = 0; nodeIdx < (uint32_t)m_Tracks.size(); ++nodeIdx)
+    {
+        const NodeTrack& track = m_Tracks[nodeIdx];
+        const KeySpan& keySpan = pKeySpans[track.TimeArray];
+        transformsOut[nodeIdx] = SampleNode(track, pKeys[track.KeyOffset + keySpan.Key0], pKeys[track.KeyOffset + keySpan.Key1], keySpan.Mix);
+    }
+}
+
+AnimationNodeTransform AnimationClip::EvaluateNode(uint32_t clipNodeIdx, float time) const
+{
+    const NodeTrack& track = m_Tracks[clipNodeIdx];
+    uint32_t keyHint = 0;
+    const KeySpan keySpan = FindKeys(track.TimeArray, time, keyHint);
+    return SampleNode(track, m_Keys[track.KeyOffset + keySpan.Key0], m_Keys[track.KeyOffset + keySpan.Key1], keySpan.Mix);
+}
+
+size_t AnimationClip::GetMemorySize() const
+{
+    return sizeof(*this)
+        + m_NodeIds.size() * sizeof(m_NodeIds[0])
+        + m_Tracks.size() * sizeof(NodeTrack)
+        + m_TimeArrays.size() * sizeof(TimeArray)
+        + m_Times.size() * sizeof(float)
+        + m_Keys.size() * sizeof(NodeKey);
+}
+
+size_t AnimationClip::GetMemorySize(const AnimationData& animationData)
+{
+    size_t size = sizeof(animationData);
+    for (const auto& node : animationData.GetNodes())
+        size += sizeof(node) + node.Frames.size() * sizeof(AnimationFrameData);
+    return size;
+}
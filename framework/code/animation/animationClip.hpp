@@ -0,0 +1,148 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "system/glm_common.hpp"
+
+// forward declarations
+class Animation;
+class AnimationData;
+
+
+/// Local transform of one animated node.
+/// @ingroup Animation
+struct AnimationNodeTransform
+{
+    glm::vec3 Translation = { 0.0f,0.0f,0.0f };
+    glm::quat Rotation = glm::identity<glm::quat>();
+    glm::vec3 Scale = { 1.0f,1.0f,1.0f };
+};
+
+/// @brief Compiled (compressed) animation clip.
+/// @ingroup Animation
+/// Runtime alternative to Animation (AnimationData) for evaluating every node of an animation each frame.
+/// Each node has one track, the translation, rotation and scale of a key are stored together (so a key pair is one or two cache lines)
+/// and the track indexes in to a shared key time array (nodes with identical key times share one array), so evaluating a pose does one
+/// key search per time array (shared by every node using the same times) and sampling a node is branch free.
+/// Rotations are quantized to 48 bits ('smallest three'), translation and scale to 16 bits per component across the range of each track.
+/// Keys that can be interpolated (within the Config error) from their neighbours are optionally removed, a key is kept if any of
+/// the node's channels needs it (so the channels keep sharing one time array).
+class AnimationClip
+{
+public:
+    struct Config
+    {
+        bool  ReduceKeys = false;           ///< remove keys that the neighbouring keys interpolate to within the error thresholds below
+        float TranslationError = 0.0001f;   ///< maximum absolute (per component) translation error of a removed key
+        float RotationError = 0.0005f;      ///< maximum angle (radians) between a removed rotation key and its interpolation
+        float ScaleError = 0.0001f;         ///< maximum absolute (per component) scale error of a removed key
+        bool  Looping = true;               ///< interpolate from the last key to the first across the loop (as Animation does), otherwise hold the first key before it and the last key after it
+    };
+
+    /// 16 bits per translation/scale component, or a QuantizeRotation rotation
+    using QuantizedKey = std::array<uint16_t, 3>;
+    /// One key of a node track
+    struct NodeKey
+    {
+        QuantizedKey Translation;
+        QuantizedKey Rotation;
+        QuantizedKey Scale;
+    };
+
+    /// Key pair (and interpolation factor) for a time in a time array
+    struct KeySpan
+    {
+        uint32_t Key0 = 0;
+        uint32_t Key1 = 0;
+        float Mix = 0.0f;
+    };
+    /// Key search hints (and results), one per time array.  Keep one per playing instance of a clip.
+    struct Cursor
+    {
+        std::vector<uint32_t> KeyHints;
+        std::vector<KeySpan>  KeySpans;     ///< scratch, for Evaluate
+    };
+
+    AnimationClip() = default;
+    AnimationClip(AnimationClip&&) noexcept = default;
+    AnimationClip& operator=(AnimationClip&&) noexcept = default;
+    AnimationClip(const AnimationClip&) = delete;
+    AnimationClip& operator=(const AnimationClip&) = delete;
+
+    /// Compile from the source animation data.
+    /// @param endTime loop time of the animation (Animation::GetEndTime)
+    static AnimationClip Compile(const AnimationData& animationData, float endTime, const Config& config);
+    static AnimationClip Compile(const Animation& animation, const Config& config);
+
+    /// Evaluate the local transform of every node in the clip.
+    /// @param time in the range [0, GetEndTime()]
+    /// @param transformsOut indexed by clip node index (same order as the source AnimationData nodes), at least GetNumNodes() long
+    /// @param pCursor optional key search hints (from MakeCursor), a substantial speed-up when time changes a little between calls
+    void Evaluate(float time, std::span<AnimationNodeTransform> transformsOut, Cursor* pCursor = nullptr) const;
+    /// Find the key spans (for every time array) at the given time, in to cursor.KeySpans (first stage of Evaluate).
+    void UpdateKeySpans(float time, Cursor& cursor) const;
+    /// Evaluate the local transform of one node (does its own key searches, use Evaluate for whole poses).
+    AnimationNodeTransform EvaluateNode(uint32_t clipNodeIdx, float time) const;
+
+    Cursor MakeCursor() const                       { return Cursor{ std::vector<uint32_t>( m_TimeArrays.size(), 0 ), std::vector<KeySpan>( m_TimeArrays.size() ) }; }
+    uint32_t GetNumNodes() const                    { return (uint32_t) m_NodeIds.size(); }
+    /// @return (gltf) node id of the given clip node
+    uint32_t GetNodeId(uint32_t clipNodeIdx) const  { return m_NodeIds[clipNodeIdx]; }
+    const auto& GetNodeIds() const                  { return m_NodeIds; }
+    float GetEndTime() const                        { return m_EndTime; }
+    bool IsLooping() const                          { return m_Looping; }
+    uint32_t GetNumTimeArrays() const               { return (uint32_t) m_TimeArrays.size(); }
+    /// @return number of keys (each holding the translation, rotation and scale of one node)
+    uint32_t GetNumKeys() const                     { return (uint32_t) m_Keys.size(); }
+    /// @return bytes used by the clip data
+    size_t GetMemorySize() const;
+    /// @return bytes used by the (AoS) source data
+    static size_t GetMemorySize(const AnimationData& animationData);
+
+    /// 'Smallest three' quaternion quantization (2 bit index of the dropped, largest, component and 15 bits for each of the others).
+    static QuantizedKey QuantizeRotation(glm::quat rotation);
+    static glm::quat DequantizeRotation(const QuantizedKey& key);
+
+protected:
+    friend class AnimationPoseBatch;
+
+    struct TimeArray
+    {
+        uint32_t Offset = 0;    ///< first time in m_Times
+        uint32_t Count = 0;
+    };
+    /// Keys of one node (nodes without animation have one key holding the default transform).  Translation/scale = Min + quantized * Step
+    struct NodeTrack
+    {
+        uint32_t TimeArray = 0;
+        uint32_t KeyOffset = 0;     ///< first key in m_Keys
+        glm::vec3 TranslationMin = {};
+        glm::vec3 TranslationStep = {};
+        glm::vec3 ScaleMin = {};
+        glm::vec3 ScaleStep = {};
+    };
+
+    KeySpan FindKeys(uint32_t timeArrayIdx, float time, uint32_t& keyHint) const;
+    static AnimationNodeTransform SampleNode(const NodeTrack& track, const NodeKey& key0, const NodeKey& key1, float mix);
+
+    /// Add (or find an identical) time array
+    uint32_t AddTimeArray(std::span<const float> times);
+
+    float                           m_EndTime = 0.0f;
+    bool                            m_Looping = true;
+    std::vector<uint32_t>           m_NodeIds;              ///< [clip node]
+    std::vector<NodeTrack>          m_Tracks;               ///< [clip node]
+    std::vector<TimeArray>          m_TimeArrays;
+    std::vector<float>              m_Times;
+    std::vector<NodeKey>            m_Keys;
+};
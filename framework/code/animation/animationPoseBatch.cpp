@@ -0,0 +1,297 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "animationPoseBatch.hpp"
+#include "system/Worker.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include "glm/gtx/quaternion.hpp"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ANIMATIONPOSEBATCH_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ANIMATIONPOSEBATCH_SSE2 1
+#endif
+
+
+//
+// 4 wide float vector (one node per lane)
+//
+namespace
+{
+#if defined(ANIMATIONPOSEBATCH_NEON)
+    struct Float4
+    {
+        float32x4_t v;
+        static Float4 Set( float s ) { return { vdupq_n_f32( s ) }; }
+        static Float4 Load( const float* p ) { return { vld1q_f32( p ) }; }
+        void Store( float* p ) const { vst1q_f32( p, v ); }
+        Float4 operator+( Float4 o ) const { return { vaddq_f32( v, o.v ) }; }
+        Float4 operator-( Float4 o ) const { return { vsubq_f32( v, o.v ) }; }
+        Float4 operator*( Float4 o ) const { return { vmulq_f32( v, o.v ) }; }
+        Float4 operator/( Float4 o ) const { return { vdivq_f32( v, o.v ) }; }
+        static Float4 Sqrt( Float4 a ) { return { vsqrtq_f32( a.v ) }; }
+        /// a, negated in the lanes where test is negative
+        static Float4 NegateIfNegative( Float4 a, Float4 test ) { return { vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( a.v ), vandq_u32( vcltq_f32( test.v, vdupq_n_f32( 0.0f ) ), vdupq_n_u32( 0x80000000u ) ) ) ) }; }
+        static void Transpose( Float4& a, Float4& b, Float4& c, Float4& d )
+        {
+            const float32x4x2_t ab = vtrnq_f32( a.v, b.v );
+            const float32x4x2_t cd = vtrnq_f32( c.v, d.v );
+            a.v = vcombine_f32( vget_low_f32( ab.val[0] ), vget_low_f32( cd.val[0] ) );
+            b.v = vcombine_f32( vget_low_f32( ab.val[1] ), vget_low_f32( cd.val[1] ) );
+            c.v = vcombine_f32( vget_high_f32( ab.val[0] ), vget_high_f32( cd.val[0] ) );
+            d.v = vcombine_f32( vget_high_f32( ab.val[1] ), vget_high_f32( cd.val[1] ) );
+        }
+    };
+#elif defined(ANIMATIONPOSEBATCH_SSE2)
+    struct Float4
+    {
+        __m128 v;
+        static Float4 Set( float s ) { return { _mm_set1_ps( s ) }; }
+        static Float4 Load( const float* p ) { return { _mm_loadu_ps( p ) }; }
+        void Store( float* p ) const { _mm_storeu_ps( p, v ); }
+        Float4 operator+( Float4 o ) const { return { _mm_add_ps( v, o.v ) }; }
+        Float4 operator-( Float4 o ) const { return { _mm_sub_ps( v, o.v ) }; }
+        Float4 operator*( Float4 o ) const { return { _mm_mul_ps( v, o.v ) }; }
+        Float4 operator/( Float4 o ) const { return { _mm_div_ps( v, o.v ) }; }
+        static Float4 Sqrt( Float4 a ) { return { _mm_sqrt_ps( a.v ) }; }
+        /// a, negated in the lanes where test is negative
+        static Float4 NegateIfNegative( Float4 a, Float4 test ) { return { _mm_xor_ps( a.v, _mm_and_ps( _mm_cmplt_ps( test.v, _mm_setzero_ps() ), _mm_set1_ps( -0.0f ) ) ) }; }
+        static void Transpose( Float4& a, Float4& b, Float4& c, Float4& d ) { _MM_TRANSPOSE4_PS( a.v, b.v, c.v, d.v ); }
+    };
+#else
+    struct Float4
+    {
+        float v[4];
+        static Float4 Set( float s ) { return { s, s, s, s }; }
+        static Float4 Load( const float* p ) { return { p[0], p[1], p[2], p[3] }; }
+        void Store( float* p ) const { p[0] = v[0]; p[1] = v[1]; p[2] = v[2]; p[3] = v[3]; }
+        Float4 operator+( Float4 o ) const { return { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] }; }
+        Float4 operator-( Float4 o ) const { return { v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3] }; }
+        Float4 operator*( Float4 o ) const { return { v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3] }; }
+        Float4 operator/( Float4 o ) const { return { v[0] / o.v[0], v[1] / o.v[1], v[2] / o.v[2], v[3] / o.v[3] }; }
+        static Float4 Sqrt( Float4 a ) { return { std::sqrt( a.v[0] ), std::sqrt( a.v[1] ), std::sqrt( a.v[2] ), std::sqrt( a.v[3] ) }; }
+        /// a, negated in the lanes where test is negative
+        static Float4 NegateIfNegative( Float4 a, Float4 test ) { return { test.v[0] < 0.0f ? -a.v[0] : a.v[0], test.v[1] < 0.0f ? -a.v[1] : a.v[1], test.v[2] < 0.0f ? -a.v[2] : a.v[2], test.v[3] < 0.0f ? -a.v[3] : a.v[3] }; }
+        static void Transpose( Float4& a, Float4& b, Float4& c, Float4& d )
+        {
+            std::swap( a.v[1], b.v[0] ); std::swap( a.v[2], c.v[0] ); std::swap( a.v[3], d.v[0] );
+            std::swap( b.v[2], c.v[1] ); std::swap( b.v[3], d.v[1] ); std::swap( c.v[3], d.v[2] );
+        }
+    };
+#endif
+
+    /// Translation or scale of 4 nodes (value = Min + Key * Step), component major.
+    struct Vec3Lanes
+    {
+        float Min[3][4];
+        float Step[3][4];
+        float Key0[3][4];
+        float Key1[3][4];
+        float Mix[4];
+    };
+    /// Rotation keys of 4 nodes, component (x,y,z,w) major.
+    struct RotationLanes
+    {
+        float Key0[4][4];
+        float Key1[4][4];
+        float Mix[4];
+    };
+
+    void SetConstantLane( Vec3Lanes& lanes, uint32_t lane, float value )
+    {
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            lanes.Min[c][lane] = value;
+            lanes.Step[c][lane] = 0.0f;
+            lanes.Key0[c][lane] = 0.0f;
+            lanes.Key1[c][lane] = 0.0f;
+        }
+        lanes.Mix[lane] = 0.0f;
+    }
+
+    void SetRotationLane( RotationLanes& lanes, uint32_t lane, const glm::quat& rotation0, const glm::quat& rotation1, float mix )
+    {
+        const float components0[4] = { rotation0.x, rotation0.y, rotation0.z, rotation0.w };
+        const float components1[4] = { rotation1.x, rotation1.y, rotation1.z, rotation1.w };
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            lanes.Key0[c][lane] = components0[c];
+            lanes.Key1[c][lane] = components1[c];
+        }
+        lanes.Mix[lane] = mix;
+    }
+
+    void LerpVec3( const Vec3Lanes& lanes, Float4 out[3] )
+    {
+        const Float4 mix = Float4::Load( lanes.Mix );
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            const Float4 min = Float4::Load( lanes.Min[c] );
+            const Float4 step = Float4::Load( lanes.Step[c] );
+            const Float4 value0 = min + Float4::Load( lanes.Key0[c] ) * step;
+            const Float4 value1 = min + Float4::Load( lanes.Key1[c] ) * step;
+            out[c] = value0 + (value1 - value0) * mix;
+        }
+    }
+
+    /// Shortest path normalized lerp (as AnimationClip::Evaluate)
+    void NlerpRotation( const RotationLanes& lanes, Float4 out[4] )
+    {
+        Float4 rotation0[4];
+        Float4 rotation1[4];
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            rotation0[c] = Float4::Load( lanes.Key0[c] );
+            rotation1[c] = Float4::Load( lanes.Key1[c] );
+        }
+        const Float4 dot = rotation0[0] * rotation1[0] + rotation0[1] * rotation1[1] + rotation0[2] * rotation1[2] + rotation0[3] * rotation1[3];
+        const Float4 mix = Float4::Load( lanes.Mix );
+        for (uint32_t c = 0; c < 4; ++c)
+            out[c] = rotation0[c] + (Float4::NegateIfNegative( rotation1[c], dot ) - rotation0[c]) * mix;
+        const Float4 invLength = Float4::Set( 1.0f ) / Float4::Sqrt( out[0] * out[0] + out[1] * out[1] + out[2] * out[2] + out[3] * out[3] );
+        for (uint32_t c = 0; c < 4; ++c)
+            out[c] = out[c] * invLength;
+    }
+
+    /// Rows of translate(t) * toMat4(r) * scale(s), rows[row][column] (each holding 4 nodes).
+    void ComposeMatrices( const Float4 t[3], const Float4 r[4], const Float4 s[3], Float4 rows[3][4] )
+    {
+        const Float4 x2 = r[0] + r[0];
+        const Float4 y2 = r[1] + r[1];
+        const Float4 z2 = r[2] + r[2];
+        const Float4 xx = r[0] * x2, yy = r[1] * y2, zz = r[2] * z2;
+        const Float4 xy = r[0] * y2, xz = r[0] * z2, yz = r[1] * z2;
+        const Float4 wx = r[3] * x2, wy = r[3] * y2, wz = r[3] * z2;
+        const Float4 one = Float4::Set( 1.0f );
+
+        rows[0][0] = (one - (yy + zz)) * s[0];
+        rows[0][1] = (xy - wz) * s[1];
+        rows[0][2] = (xz + wy) * s[2];
+        rows[0][3] = t[0];
+        rows[1][0] = (xy + wz) * s[0];
+        rows[1][1] = (one - (xx + zz)) * s[1];
+        rows[1][2] = (yz - wx) * s[2];
+        rows[1][3] = t[1];
+        rows[2][0] = (xz - wy) * s[0];
+        rows[2][1] = (yz + wx) * s[1];
+        rows[2][2] = (one - (xx + yy)) * s[2];
+        rows[2][3] = t[2];
+    }
+}
+
+
+void AnimationPoseBatch::EvaluateInstance(const Instance& instance)
+{
+    assert(instance.pClip);
+    const AnimationClip& clip = *instance.pClip;
+    AnimationClip::Cursor localCursor;
+    AnimationClip::Cursor* pCursor = instance.pCursor;
+    if (!pCursor)
+    {
+        localCursor = clip.MakeCursor();
+        pCursor = &localCursor;
+    }
+    clip.UpdateKeySpans(instance.Time, *pCursor);
+    const auto& keySpans = pCursor->KeySpans;
+
+    const uint32_t numNodes = clip.GetNumNodes();
+    Vec3Lanes translationLanes;
+    RotationLanes rotationLanes;
+    Vec3Lanes scaleLanes;
+
+    auto gatherVec3 = [](Vec3Lanes& lanes, uint32_t lane, const glm::vec3& min, const glm::vec3& step, const AnimationClip::QuantizedKey& key0, const AnimationClip::QuantizedKey& key1, float mix) {
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            lanes.Min[c][lane] = min[c];
+            lanes.Step[c][lane] = step[c];
+            lanes.Key0[c][lane] = float(key0[c]);
+            lanes.Key1[c][lane] = float(key1[c]);
+        }
+        lanes.Mix[lane] = mix;
+    };
+    // Every clip node has a track (nodes without animation have a single default key), so gathering needs no special cases.
+    auto gatherNode = [&](uint32_t lane, uint32_t nodeIdx) {
+        const AnimationClip::NodeTrack& track = clip.m_Tracks[nodeIdx];
+        const AnimationClip::KeySpan& keySpan = keySpans[track.TimeArray];
+        const AnimationClip::NodeKey& key0 = clip.m_Keys[track.KeyOffset + keySpan.Key0];
+        const AnimationClip::NodeKey& key1 = clip.m_Keys[track.KeyOffset + keySpan.Key1];
+        gatherVec3(translationLanes, lane, track.TranslationMin, track.TranslationStep, key0.Translation, key1.Translation, keySpan.Mix);
+        SetRotationLane(rotationLanes, lane, AnimationClip::DequantizeRotation(key0.Rotation), AnimationClip::DequantizeRotation(key1.Rotation), keySpan.Mix);
+        gatherVec3(scaleLanes, lane, track.ScaleMin, track.ScaleStep, key0.Scale, key1.Scale, keySpan.Mix);
+    };
+
+    for (uint32_t firstNodeIdx = 0; firstNodeIdx < numNodes; firstNodeIdx += cLanes)
+    {
+        // Gather (and dequantize the scalar parts of) 4 nodes in to SoA form, unused lanes are identity.
+        const uint32_t numLanes = std::min(cLanes, numNodes - firstNodeIdx);
+        for (uint32_t lane = 0; lane < cLanes; ++lane)
+        {
+            if (lane < numLanes)
+            {
+                gatherNode(lane, firstNodeIdx + lane);
+            }
+            else
+            {
+                SetConstantLane(translationLanes, lane, 0.0f);
+                SetRotationLane(rotationLanes, lane, glm::identity<glm::quat>(), glm::identity<glm::quat>(), 0.0f);
+                SetConstantLane(scaleLanes, lane, 1.0f);
+            }
+        }
+
+        Float4 translation[3];
+        Float4 rotation[4];
+        Float4 scale[3];
+        LerpVec3(translationLanes, translation);
+        NlerpRotation(rotationLanes, rotation);
+        LerpVec3(scaleLanes, scale);
+        Float4 rows[3][4];
+        ComposeMatrices(translation, rotation, scale, rows);
+
+        // Transpose each row from 'element per register' to 'node per register' and store.
+        for (uint32_t row = 0; row < 3; ++row)
+        {
+            Float4::Transpose(rows[row][0], rows[row][1], rows[row][2], rows[row][3]);
+            for (uint32_t lane = 0; lane < numLanes; ++lane)
+                rows[row][lane].Store(&instance.NodeMatrices[clip.m_NodeIds[firstNodeIdx + lane]][row][0]);
+        }
+    }
+}
+
+void AnimationPoseBatch::EvaluateInstanceScalar(const Instance& instance)
+{
+    assert(instance.pClip);
+    const AnimationClip& clip = *instance.pClip;
+    std::vector<AnimationNodeTransform> transforms(clip.GetNumNodes());
+    clip.Evaluate(instance.Time, transforms, instance.pCursor);
+    for (uint32_t nodeIdx = 0; nodeIdx < clip.GetNumNodes(); ++nodeIdx)
+    {
+        const auto& transform = transforms[nodeIdx];
+        const glm::mat4 matrix = glm::translate(transform.Translation) * glm::toMat4(transform.Rotation) * glm::scale(transform.Scale);
+        instance.NodeMatrices[clip.GetNodeId(nodeIdx)] = ToMat3x4(matrix);
+    }
+}
+
+void AnimationPoseBatch::Evaluate(std::span<const Instance> instances, ThreadWorker* pWorker)
+{
+    auto evaluateRange = [instances](uint32_t begin, uint32_t end) {
+        for (uint32_t instanceIdx = begin; instanceIdx < end; ++instanceIdx)
+            EvaluateInstance(instances[instanceIdx]);
+    };
+    if (!pWorker)
+    {
+        evaluateRange(0, (uint32_t)instances.size());
+        return;
+    }
+    // Not worth the threading overhead for less than a handful of instances per range.
+    pWorker->ParallelFor((uint32_t)instances.size(), 8, evaluateRange);
+}
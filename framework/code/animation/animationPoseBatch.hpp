@@ -0,0 +1,53 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include "system/glm_common.hpp"
+#include "animationClip.hpp"
+
+// forward declarations
+class ThreadWorker;
+
+
+/// @brief Batched (SIMD) pose evaluation for many instances of AnimationClips.
+/// @ingroup Animation
+/// Alternative to AnimationList::UpdateSkeletonMatrixes (one skeleton at a time, a glm::mat4 per node built from translate * toMat4 * scale)
+/// for crowds.  Each instance's clip nodes are evaluated 4 at a time in structure of arrays form (one node per SIMD lane, SSE2 or NEON with a scalar
+/// fallback): keys are dequantized, interpolated (nlerp for rotations) and composed straight in to 3x4 matrices.  Instances are split across
+/// the ThreadWorker threads.
+///
+/// Output matrices are the top 3 rows of the (column major) local transform, ie glm::mat3x4 holding the rows of the affine matrix (as used by
+/// the ray tracing instance transforms), 48 bytes per node.
+class AnimationPoseBatch
+{
+public:
+    struct Instance
+    {
+        const AnimationClip*        pClip = nullptr;
+        float                       Time = 0.0f;            ///< in the range [0, pClip->GetEndTime()]
+        AnimationClip::Cursor*      pCursor = nullptr;      ///< optional (but recommended) key search hints, owned by the instance
+        std::span<glm::mat3x4>      NodeMatrices;           ///< local matrices indexed by (gltf) node id, nodes not in the clip are not written
+    };
+
+    /// Number of nodes evaluated together
+    static constexpr uint32_t cLanes = 4;
+
+    /// Evaluate one instance (on the calling thread).
+    static void EvaluateInstance(const Instance& instance);
+    /// Evaluate one instance with AnimationClip::Evaluate and glm (reference for EvaluateInstance).
+    static void EvaluateInstanceScalar(const Instance& instance);
+    /// Evaluate all the instances, split across the worker threads (if given).  Instances must not share a cursor or output matrices.
+    /// Must not be called from one of pWorker's threads.
+    static void Evaluate(std::span<const Instance> instances, ThreadWorker* pWorker = nullptr);
+
+    static glm::mat4 ToMat4(const glm::mat3x4& matrix)      { return glm::transpose(glm::mat4(matrix)); }
+    static glm::mat3x4 ToMat3x4(const glm::mat4& matrix)    { return glm::mat3x4(glm::transpose(matrix)); }
+};
@@ -9,29 +9,90 @@
 #include "skeleton.hpp"
 #include "skeletonData.hpp"
 
+/// Rows of parent * child (with the implied 0,0,0,1 bottom rows).
+static glm::mat3x4 MultiplyAffine(const glm::mat3x4& parent, const glm::mat3x4& child)
+{
+    glm::mat3x4 result;
+    for (int row = 0; row < 3; ++row)
+        result[row] = parent[row].x * child[0] + parent[row].y * child[1] + parent[row].z * child[2] + glm::vec4(0.0f, 0.0f, 0.0f, parent[row].w);
+    return result;
+}
+
 Skeleton::Skeleton(const SkeletonData& skeletonData)
     : m_SkeletonData(skeletonData)
 {
     m_WorldTransforms.resize( m_SkeletonData.m_NodesById.size(), glm::identity<glm::mat4>() );
 
-    // iterate through node hierarchy to calculate the world transforms.
-    for (const auto* rootNode : m_SkeletonData.m_RootNodes)
+    // calculate the world transforms from the node local transforms.
+    for (const auto* node : m_SkeletonData.m_NodesById)
+        if (node)
+            m_WorldTransforms[node->NodeId()] = node->LocalTransform();
+    TransformLocalToWorld(m_WorldTransforms, m_WorldTransforms);
+}
+
+void Skeleton::TransformLocalToWorld(const std::span<const glm::mat4> local, std::span<glm::mat4> world) const
+{
+    assert(local.size() == world.size());
+    assert(world.size() == m_SkeletonData.m_NodesById.size());
+
+    // Parents are always before their children, so the parent's world transform is ready (and local is not yet overwritten when local == world).
+    const auto& sortedNodeIds = m_SkeletonData.m_SortedNodeIds;
+    const auto& sortedParents = m_SkeletonData.m_SortedParents;
+    for (size_t sortedIdx = 0; sortedIdx < sortedNodeIds.size(); ++sortedIdx)
     {
-        const auto TransformTree = [this](auto& rootNode, const auto& ParentTransform) -> void {
-            auto TransformTreeImpl = [this](auto& rootNode, const auto& ParentTransform, auto& TransformTreeRef) -> void
-            {
-                auto WorldTransform = ParentTransform * rootNode.LocalTransform();
-                m_WorldTransforms[rootNode.NodeId()] = WorldTransform;
-                for (auto& child : rootNode.Children())
-                    TransformTreeRef(child, WorldTransform, TransformTreeRef);
-            };
-            TransformTreeImpl(rootNode, ParentTransform, TransformTreeImpl);
-        };
-        TransformTree(*rootNode, glm::identity<glm::mat4>());
+        const uint32_t nodeId = sortedNodeIds[sortedIdx];
+        const int32_t parentIdx = sortedParents[sortedIdx];
+        world[nodeId] = parentIdx < 0 ? local[nodeId] : world[sortedNodeIds[parentIdx]] * local[nodeId];
     }
 }
 
-void Skeleton::TransformLocalToWorld(const std::span<const glm::mat4> local, std::span<glm::mat4> world) const
+void Skeleton::TransformLocalToWorld(const std::span<const glm::mat3x4> local, std::span<glm::mat3x4> world) const
+{
+    assert(local.size() == world.size());
+    assert(world.size() == m_SkeletonData.m_NodesById.size());
+
+    const auto& sortedNodeIds = m_SkeletonData.m_SortedNodeIds;
+    const auto& sortedParents = m_SkeletonData.m_SortedParents;
+    for (size_t sortedIdx = 0; sortedIdx < sortedNodeIds.size(); ++sortedIdx)
+    {
+        const uint32_t nodeId = sortedNodeIds[sortedIdx];
+        const int32_t parentIdx = sortedParents[sortedIdx];
+        if (parentIdx < 0)
+        {
+            world[nodeId] = local[nodeId];
+            continue;
+        }
+        world[nodeId] = MultiplyAffine(world[sortedNodeIds[parentIdx]], local[nodeId]);
+    }
+}
+
+void Skeleton::TransformSortedLocalToWorld(const std::span<const glm::mat4> local, std::span<glm::mat4> world) const
+{
+    assert(local.size() == world.size());
+    assert(world.size() == m_SkeletonData.m_SortedNodeIds.size());
+
+    const int32_t* pParents = m_SkeletonData.m_SortedParents.data();
+    for (size_t sortedIdx = 0; sortedIdx < world.size(); ++sortedIdx)
+    {
+        const int32_t parentIdx = pParents[sortedIdx];
+        world[sortedIdx] = parentIdx < 0 ? local[sortedIdx] : world[parentIdx] * local[sortedIdx];
+    }
+}
+
+void Skeleton::TransformSortedLocalToWorld(const std::span<const glm::mat3x4> local, std::span<glm::mat3x4> world) const
+{
+    assert(local.size() == world.size());
+    assert(world.size() == m_SkeletonData.m_SortedNodeIds.size());
+
+    const int32_t* pParents = m_SkeletonData.m_SortedParents.data();
+    for (size_t sortedIdx = 0; sortedIdx < world.size(); ++sortedIdx)
+    {
+        const int32_t parentIdx = pParents[sortedIdx];
+        world[sortedIdx] = parentIdx < 0 ? local[sortedIdx] : MultiplyAffine(world[parentIdx], local[sortedIdx]);
+    }
+}
+
+void Skeleton::TransformLocalToWorldRecursive(const std::span<const glm::mat4> local, std::span<glm::mat4> world) const
 {
     assert(local.size() == world.size());
     assert(world.size() == m_SkeletonData.m_NodesById.size());
@@ -52,7 +113,6 @@ void Skeleton::TransformLocalToWorld(const std::span<const glm::mat4> local, std
         };
         TransformTree(*rootNode, glm::identity<glm::mat4>());
     }
-
 }
 
 Skeleton::~Skeleton()
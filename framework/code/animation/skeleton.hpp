@@ -31,7 +31,18 @@ public:
 
     /// Transform local matrices for a skeleton to world space (using the skeleton hierarchy)
     /// local and world can point to the same data if desired (skeleton is assumed to be a tree structure)
+    /// One pass over the flattened (parent before child) hierarchy, see SkeletonData::GetSortedNodeIds.  local and world are in node id
+    /// order, so accesses are scattered (much the same cost as the recursive walk), use TransformSortedLocalToWorld where the pose can be stored sorted.
     void TransformLocalToWorld(const std::span<const glm::mat4> local, std::span<glm::mat4> world) const;
+    /// TransformLocalToWorld for 3x4 matrices (rows of the affine transform, as output by AnimationPoseBatch)
+    void TransformLocalToWorld(const std::span<const glm::mat3x4> local, std::span<glm::mat3x4> world) const;
+    /// Transform local matrices to world space, both in sorted order (indexed as SkeletonData::GetSortedNodeIds).
+    /// Linear sweep: local and world are accessed in order and the parent is an earlier (usually recently written) entry of world.
+    /// local and world can point to the same data.
+    void TransformSortedLocalToWorld(const std::span<const glm::mat4> local, std::span<glm::mat4> world) const;
+    void TransformSortedLocalToWorld(const std::span<const glm::mat3x4> local, std::span<glm::mat3x4> world) const;
+    /// TransformLocalToWorld by recursively walking the node hierarchy (reference for the flattened version)
+    void TransformLocalToWorldRecursive(const std::span<const glm::mat4> local, std::span<glm::mat4> world) const;
 
 private:
     const SkeletonData&     m_SkeletonData;     //NOT owned, do not delete before deleting this class!
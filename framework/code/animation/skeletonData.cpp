@@ -7,7 +7,81 @@
 //============================================================================================================
 
 #include "skeletonData.hpp"
+#include <cassert>
+#include <cstdint>
 
 SkeletonData::SkeletonData(std::vector<SkeletonNodeData>&& Nodes, std::vector<const SkeletonNodeData*>&& NodesById, std::vector<const SkeletonNodeData*>&& rootNodes)
     : m_NodesById(std::move(NodesById)), m_RootNodes(std::move(rootNodes)), m_Nodes(std::move(Nodes))
-{}
+{
+    // Flatten the hierarchy, breadth first so siblings are contiguous and every parent is before its children.
+    m_SortedNodeIds.reserve(m_Nodes.size());
+    m_SortedParents.reserve(m_Nodes.size());
+    std::vector<const SkeletonNodeData*> sortedNodes;
+    sortedNodes.reserve(m_Nodes.size());
+    for (const auto* rootNode : m_RootNodes)
+    {
+        sortedNodes.push_back(rootNode);
+        m_SortedParents.push_back(-1);
+    }
+    for (size_t sortedIdx = 0; sortedIdx < sortedNodes.size(); ++sortedIdx)
+    {
+        for (const auto& child : sortedNodes[sortedIdx]->Children())
+        {
+            sortedNodes.push_back(&child);
+            m_SortedParents.push_back((int32_t)sortedIdx);
+        }
+    }
+    for (const auto* node : sortedNodes)
+        m_SortedNodeIds.push_back((uint32_t)node->NodeId());
+}
+
+SkeletonData SkeletonData::FromParents(std::span<const int> parents, std::span<const glm::mat4> localTransforms)
+{
+    assert(parents.size() == localTransforms.size());
+    const int numNodes = (int)parents.size();
+    std::vector<std::vector<int>> childIds(numNodes);
+    std::vector<int> rootIds;
+    for (int nodeId = 0; nodeId < numNodes; ++nodeId)
+    {
+        if (parents[nodeId] < 0)
+            rootIds.push_back(nodeId);
+        else
+        {
+            assert(parents[nodeId] < numNodes);
+            childIds[parents[nodeId]].push_back(nodeId);
+        }
+    }
+
+    std::vector<SkeletonNodeData> nodes;
+    nodes.reserve(numNodes);  // ESSENTIAL that there are no re-allocations, nodes point to their parent and children.
+    std::vector<const SkeletonNodeData*> nodesById(numNodes, nullptr);
+    std::vector<const SkeletonNodeData*> rootNodes;
+    rootNodes.reserve(rootIds.size());
+    const auto addNode = [&nodes, &nodesById, localTransforms](int nodeId, const SkeletonNodeData* parent) {
+        nodes.emplace_back(SkeletonNodeData{ nodeId });
+        SkeletonNodeData& node = nodes.back();
+        node.m_Parent = parent;
+        node.m_LocalTransform = localTransforms[nodeId];
+        nodesById[nodeId] = &node;
+    };
+    for (int rootId : rootIds)
+    {
+        addNode(rootId, nullptr);
+        rootNodes.push_back(&nodes.back());
+    }
+    // Breadth first, so each node's children are added together (contiguous, as Children() expects).
+    for (size_t nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx)
+    {
+        SkeletonNodeData& node = nodes[nodeIdx];
+        const auto& children = childIds[node.m_NodeId];
+        if (children.empty())
+            continue;
+        node.m_Children = nodes.data() + nodes.size();
+        node.m_NumChildren = (uint32_t)children.size();
+        for (int childId : children)
+            addNode(childId, &node);
+    }
+    assert(nodes.size() == parents.size()); // nodes in a cycle are never reached
+
+    return SkeletonData(std::move(nodes), std::move(nodesById), std::move(rootNodes));
+}
@@ -52,14 +52,25 @@ public:
     SkeletonData(SkeletonData&&) = default;
     SkeletonData& operator=(SkeletonData&&) = default;
     SkeletonData(std::vector<SkeletonNodeData>&& Nodes, std::vector<const SkeletonNodeData*>&& NodesById, std::vector<const SkeletonNodeData*>&& rootNodes);
+    /// Build a skeleton from a parent per node (procedural or test skeletons, gltf skeletons come from SkeletonGltfProcessor).
+    /// @param parents [nodeId] parent nodeId, -1 for root nodes (must be a forest, no cycles)
+    /// @param localTransforms [nodeId] local transform of each node
+    static SkeletonData FromParents(std::span<const int> parents, std::span<const glm::mat4> localTransforms);
 
     const SkeletonNodeData* GetNodeById(uint32_t nodeId) const { return m_NodesById[nodeId]; }
     const auto& GetRootNodes() const { return m_RootNodes; }
 
+    /// Flattened hierarchy, node ids sorted (breadth first from the root nodes) so every parent precedes its children.
+    const auto& GetSortedNodeIds() const { return m_SortedNodeIds; }
+    /// Parent of each node in GetSortedNodeIds, as an index in to the sorted nodes (-1 for root nodes).
+    const auto& GetSortedParents() const { return m_SortedParents; }
+
 protected:
     friend class Skeleton;
     friend class SkeletonGltfProcessor;
     std::vector<const SkeletonNodeData*>        m_NodesById;     ///< nodes ordered by NodeId
     std::vector<const SkeletonNodeData*>        m_RootNodes;     ///< root nodes (no set order)
     std::vector<SkeletonNodeData>               m_Nodes;       ///< Node data hierarchy (lookup start node via NodesById)
+    std::vector<uint32_t>                       m_SortedNodeIds; ///< node ids, parents before children
+    std::vector<int32_t>                        m_SortedParents; ///< [sorted node] index of the parent in m_SortedNodeIds, -1 for root nodes
 };
@@ -79,6 +79,15 @@ void Camera::SetCut(bool cut)
     m_Cut = cut;
 }
 
+//-----------------------------------------------------------------------------
+void Camera::BeginFrame()
+//-----------------------------------------------------------------------------
+{
+    m_Temporal.BeginFrame();
+    if (m_Temporal.GetJitterSequenceType() != TemporalContext::JitterSequence::None)
+        m_Jitter = m_Temporal.GetCameraJitter();
+}
+
 //-----------------------------------------------------------------------------
 void Camera::UpdateMatrices()
 //-----------------------------------------------------------------------------
@@ -107,6 +116,10 @@ void Camera::UpdateMatrices()
         auto viewProj = m_ProjectionMatrix * m_ViewMatrix;
         m_InverseViewProjection = glm::inverse( viewProj );
     }
+
+    // Cache the frustum planes (jitter is sub-pixel and is ignored for culling)
+    m_Frustum = CameraFrustum( m_ProjectionMatrixNoJitter * m_ViewMatrix );
+    m_Temporal.SetMatrices( m_ProjectionMatrixNoJitter, m_ViewMatrix, m_Cut );
 }
 
 //-----------------------------------------------------------------------------
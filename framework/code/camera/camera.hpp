@@ -11,6 +11,8 @@
 /// Game Camera functionality.
 
 #include "system/glm_common.hpp"
+#include "cameraFrustum.hpp"
+#include "temporalContext.hpp"
 
 // Forward declarations
 class CameraController;
@@ -56,7 +58,11 @@ public:
         CameraController.Update(ElapsedTimeSeconds, m_CurrentCameraPos, m_CurrentCameraRot, m_Cut);
     }
 
-    /// Update camera matrices (based on current rotation/position)
+    /// Start a new frame: advances the Temporal() context (this frame's jitter, last frame's matrices become the previous ones) and
+    /// sets the jitter from its jitter sequence (if it has one).  Call once per frame, before UpdateMatrices.
+    void BeginFrame();
+
+    /// Update camera matrices (based on current rotation/position and jitter), and the Temporal() context's current matrices.
     void UpdateMatrices();
 
     // Accessors
@@ -74,6 +80,9 @@ public:
     float               Aspect() const { return m_Aspect; }                     ///<@returns the camera aspect ratio
     glm::vec2           Jitter() const { return m_Jitter; }                     ///<@returns the camera jitter offsets
     bool                Cut() const { return m_Cut; }                           ///<@returns if the camera position was suddently 'cut' (dependent on camera controller setting the m_Cut flag)
+    const CameraFrustum& Frustum() const { return m_Frustum; }                  ///<@returns the view frustum planes (as computed by UpdateMatrices, without jitter)
+    const TemporalContext& Temporal() const { return m_Temporal; }              ///<@returns the jitter sequence and previous frame matrices (updated by BeginFrame and UpdateMatrices)
+    TemporalContext&    Temporal() { return m_Temporal; }                       ///<@returns the temporal context (eg to set the jitter sequence or object transforms)
 
 protected:
     // Camera parameters
@@ -97,4 +106,10 @@ protected:
     glm::mat4           m_ViewMatrix;
     glm::mat4           m_ViewMatrixPreTranslation;
     glm::mat4           m_InverseViewProjection;
+
+    // Culling
+    CameraFrustum       m_Frustum;
+
+    // Temporal (jitter and previous frame) state
+    TemporalContext     m_Temporal;
 };
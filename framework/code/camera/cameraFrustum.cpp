@@ -0,0 +1,303 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "cameraFrustum.hpp"
+#include "system/Worker.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define CAMERAFRUSTUM_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CAMERAFRUSTUM_SSE2 1
+#endif
+
+
+//
+// 4 wide float vector (one bound per lane)
+//
+namespace
+{
+#if defined(CAMERAFRUSTUM_NEON)
+    struct Float4
+    {
+        float32x4_t v;
+        static Float4 Set(float s) { return { vdupq_n_f32(s) }; }
+        static Float4 Load(const float* p) { return { vld1q_f32(p) }; }
+        Float4 operator+(Float4 o) const { return { vaddq_f32(v, o.v) }; }
+        Float4 operator-(Float4 o) const { return { vsubq_f32(v, o.v) }; }
+        Float4 operator*(Float4 o) const { return { vmulq_f32(v, o.v) }; }
+        /// @return bit per lane where a >= b
+        static uint32_t GreaterEqualMask(Float4 a, Float4 b)
+        {
+            static const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+            return vaddvq_u32(vandq_u32(vcgeq_f32(a.v, b.v), vld1q_u32(laneBits)));
+        }
+    };
+#elif defined(CAMERAFRUSTUM_SSE2)
+    struct Float4
+    {
+        __m128 v;
+        static Float4 Set(float s) { return { _mm_set1_ps(s) }; }
+        static Float4 Load(const float* p) { return { _mm_loadu_ps(p) }; }
+        Float4 operator+(Float4 o) const { return { _mm_add_ps(v, o.v) }; }
+        Float4 operator-(Float4 o) const { return { _mm_sub_ps(v, o.v) }; }
+        Float4 operator*(Float4 o) const { return { _mm_mul_ps(v, o.v) }; }
+        /// @return bit per lane where a >= b
+        static uint32_t GreaterEqualMask(Float4 a, Float4 b) { return (uint32_t)_mm_movemask_ps(_mm_cmpge_ps(a.v, b.v)); }
+    };
+#else
+    struct Float4
+    {
+        float v[4];
+        static Float4 Set(float s) { return { s, s, s, s }; }
+        static Float4 Load(const float* p) { return { p[0], p[1], p[2], p[3] }; }
+        Float4 operator+(Float4 o) const { return { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] }; }
+        Float4 operator-(Float4 o) const { return { v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3] }; }
+        Float4 operator*(Float4 o) const { return { v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3] }; }
+        /// @return bit per lane where a >= b
+        static uint32_t GreaterEqualMask(Float4 a, Float4 b) { return (a.v[0] >= b.v[0] ? 1u : 0u) | (a.v[1] >= b.v[1] ? 2u : 0u) | (a.v[2] >= b.v[2] ? 4u : 0u) | (a.v[3] >= b.v[3] ? 8u : 0u); }
+    };
+#endif
+
+    /// Planes splatted across 4 lanes.
+    struct Planes4
+    {
+        Float4   X[CameraFrustum::NumPlanes], Y[CameraFrustum::NumPlanes], Z[CameraFrustum::NumPlanes], W[CameraFrustum::NumPlanes];
+        Float4   AbsX[CameraFrustum::NumPlanes], AbsY[CameraFrustum::NumPlanes], AbsZ[CameraFrustum::NumPlanes];
+        uint32_t NumPlanes;
+
+        Planes4(const std::array<glm::vec4, CameraFrustum::NumPlanes>& planes, uint32_t numPlanes) : NumPlanes(numPlanes)
+        {
+            for (uint32_t p = 0; p < numPlanes; ++p)
+            {
+                X[p] = Float4::Set(planes[p].x);
+                Y[p] = Float4::Set(planes[p].y);
+                Z[p] = Float4::Set(planes[p].z);
+                W[p] = Float4::Set(planes[p].w);
+                AbsX[p] = Float4::Set(std::abs(planes[p].x));
+                AbsY[p] = Float4::Set(std::abs(planes[p].y));
+                AbsZ[p] = Float4::Set(std::abs(planes[p].z));
+            }
+        }
+    };
+
+    // Scalar and SIMD tests use the same operation order, so give the same results.
+
+    inline bool SphereVisible(const glm::vec4* pPlanes, uint32_t numPlanes, float x, float y, float z, float radius)
+    {
+        for (uint32_t p = 0; p < numPlanes; ++p)
+        {
+            const float distance = pPlanes[p].x * x + pPlanes[p].y * y + pPlanes[p].z * z + pPlanes[p].w;
+            if (!(distance >= 0.0f - radius))
+                return false;
+        }
+        return true;
+    }
+
+    inline bool AabbVisible(const glm::vec4* pPlanes, uint32_t numPlanes, float x, float y, float z, float extentX, float extentY, float extentZ)
+    {
+        for (uint32_t p = 0; p < numPlanes; ++p)
+        {
+            const float distance = pPlanes[p].x * x + pPlanes[p].y * y + pPlanes[p].z * z + pPlanes[p].w;
+            const float radius = std::abs(pPlanes[p].x) * extentX + std::abs(pPlanes[p].y) * extentY + std::abs(pPlanes[p].z) * extentZ;
+            if (!(distance >= 0.0f - radius))
+                return false;
+        }
+        return true;
+    }
+
+    inline bool IsVisible(const glm::vec4* pPlanes, uint32_t numPlanes, const CameraFrustum::Spheres& spheres, size_t i)
+    {
+        return SphereVisible(pPlanes, numPlanes, spheres.X[i], spheres.Y[i], spheres.Z[i], spheres.Radius[i]);
+    }
+
+    inline bool IsVisible(const glm::vec4* pPlanes, uint32_t numPlanes, const CameraFrustum::Aabbs& aabbs, size_t i)
+    {
+        return AabbVisible(pPlanes, numPlanes, aabbs.CenterX[i], aabbs.CenterY[i], aabbs.CenterZ[i], aabbs.ExtentX[i], aabbs.ExtentY[i], aabbs.ExtentZ[i]);
+    }
+
+    /// @return visible bit per lane for bounds i to i+3
+    inline uint32_t VisibleMask4(const Planes4& planes, const CameraFrustum::Spheres& spheres, size_t i)
+    {
+        const Float4 x = Float4::Load(&spheres.X[i]);
+        const Float4 y = Float4::Load(&spheres.Y[i]);
+        const Float4 z = Float4::Load(&spheres.Z[i]);
+        const Float4 negativeRadius = Float4::Set(0.0f) - Float4::Load(&spheres.Radius[i]);
+        uint32_t visible = 0xf;
+        for (uint32_t p = 0; p < planes.NumPlanes && visible != 0; ++p)
+        {
+            const Float4 distance = planes.X[p] * x + planes.Y[p] * y + planes.Z[p] * z + planes.W[p];
+            visible &= Float4::GreaterEqualMask(distance, negativeRadius);
+        }
+        return visible;
+    }
+
+    inline uint32_t VisibleMask4(const Planes4& planes, const CameraFrustum::Aabbs& aabbs, size_t i)
+    {
+        const Float4 x = Float4::Load(&aabbs.CenterX[i]);
+        const Float4 y = Float4::Load(&aabbs.CenterY[i]);
+        const Float4 z = Float4::Load(&aabbs.CenterZ[i]);
+        const Float4 extentX = Float4::Load(&aabbs.ExtentX[i]);
+        const Float4 extentY = Float4::Load(&aabbs.ExtentY[i]);
+        const Float4 extentZ = Float4::Load(&aabbs.ExtentZ[i]);
+        const Float4 zero = Float4::Set(0.0f);
+        uint32_t visible = 0xf;
+        for (uint32_t p = 0; p < planes.NumPlanes && visible != 0; ++p)
+        {
+            const Float4 distance = planes.X[p] * x + planes.Y[p] * y + planes.Z[p] * z + planes.W[p];
+            const Float4 radius = planes.AbsX[p] * extentX + planes.AbsY[p] * extentY + planes.AbsZ[p] * extentZ;
+            visible &= Float4::GreaterEqualMask(distance, zero - radius);
+        }
+        return visible;
+    }
+
+    template<typename T_BOUNDS>
+    uint32_t CullIndices(const std::array<glm::vec4, CameraFrustum::NumPlanes>& planes, uint32_t numPlanes, const T_BOUNDS& bounds, std::span<uint32_t> visibleIndicesOut)
+    {
+        assert(visibleIndicesOut.size() >= bounds.size());
+        const Planes4 planes4(planes, numPlanes);
+        const size_t count = bounds.size();
+        uint32_t numVisible = 0;
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            for (uint32_t visible = VisibleMask4(planes4, bounds, i); visible != 0; visible &= visible - 1)
+                visibleIndicesOut[numVisible++] = (uint32_t)i + std::countr_zero(visible);
+        }
+        for (; i < count; ++i)
+            if (IsVisible(planes.data(), numPlanes, bounds, i))
+                visibleIndicesOut[numVisible++] = (uint32_t)i;
+        return numVisible;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+CameraFrustum::CameraFrustum()
+//-----------------------------------------------------------------------------
+    : CameraFrustum(glm::mat4(1.0f))
+{
+}
+
+//-----------------------------------------------------------------------------
+CameraFrustum::CameraFrustum(const glm::mat4& viewProjection, DepthMode depthMode)
+//-----------------------------------------------------------------------------
+{
+    // Rows of the view projection (Gribb/Hartmann plane extraction).
+    const glm::mat4 rows = glm::transpose(viewProjection);
+    m_Planes[Left] = rows[3] + rows[0];
+    m_Planes[Right] = rows[3] - rows[0];
+    m_Planes[Bottom] = rows[3] + rows[1];
+    m_Planes[Top] = rows[3] - rows[1];
+    switch (depthMode)
+    {
+    case DepthMode::ZeroToOne:
+        m_Planes[Near] = rows[2];
+        m_Planes[Far] = rows[3] - rows[2];
+        m_NumPlanes = NumPlanes;
+        break;
+    case DepthMode::ReverseZ:
+        m_Planes[Near] = rows[3] - rows[2];
+        m_Planes[Far] = rows[2];
+        m_NumPlanes = NumPlanes;
+        break;
+    case DepthMode::ReverseZInfiniteFar:
+        m_Planes[Near] = rows[3] - rows[2];
+        m_Planes[Far] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);  // always passes (and not tested)
+        m_NumPlanes = NumPlanes - 1;
+        break;
+    }
+    for (uint32_t p = 0; p < m_NumPlanes; ++p)
+    {
+        const float length = glm::length(glm::vec3(m_Planes[p]));
+        if (length > 0.0f)
+            m_Planes[p] /= length;
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool CameraFrustum::IsSphereVisible(const glm::vec3& center, float radius) const
+//-----------------------------------------------------------------------------
+{
+    return SphereVisible(m_Planes.data(), m_NumPlanes, center.x, center.y, center.z, radius);
+}
+
+//-----------------------------------------------------------------------------
+bool CameraFrustum::IsAabbVisible(const glm::vec3& center, const glm::vec3& extent) const
+//-----------------------------------------------------------------------------
+{
+    return AabbVisible(m_Planes.data(), m_NumPlanes, center.x, center.y, center.z, extent.x, extent.y, extent.z);
+}
+
+//-----------------------------------------------------------------------------
+template<typename T_BOUNDS>
+void CameraFrustum::CullRangeBits(const T_BOUNDS& bounds, size_t begin, size_t end, std::span<uint64_t> visibleBitsOut) const
+//-----------------------------------------------------------------------------
+{
+    assert((begin & 63) == 0);
+    const Planes4 planes4(m_Planes, m_NumPlanes);
+    for (size_t wordBegin = begin; wordBegin < end; wordBegin += 64)
+    {
+        const size_t wordEnd = std::min(wordBegin + 64, end);
+        uint64_t bits = 0;
+        size_t i = wordBegin;
+        for (; i + 4 <= wordEnd; i += 4)
+            bits |= (uint64_t)VisibleMask4(planes4, bounds, i) << (i - wordBegin);
+        for (; i < wordEnd; ++i)
+            if (IsVisible(m_Planes.data(), m_NumPlanes, bounds, i))
+                bits |= 1ull << (i - wordBegin);
+        visibleBitsOut[wordBegin / 64] = bits;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void CameraFrustum::CullSpheres(const Spheres& spheres, std::span<uint64_t> visibleBitsOut, ThreadWorker* pWorker) const
+//-----------------------------------------------------------------------------
+{
+    const size_t count = spheres.size();
+    assert(visibleBitsOut.size() >= (count + 63) / 64);
+    if (pWorker)
+        pWorker->ParallelFor((uint32_t)((count + 63) / 64), 64, [&](uint32_t beginWord, uint32_t endWord) {
+            CullRangeBits(spheres, beginWord * size_t(64), std::min(endWord * size_t(64), count), visibleBitsOut);
+        });
+    else
+        CullRangeBits(spheres, 0, count, visibleBitsOut);
+}
+
+//-----------------------------------------------------------------------------
+void CameraFrustum::CullAabbs(const Aabbs& aabbs, std::span<uint64_t> visibleBitsOut, ThreadWorker* pWorker) const
+//-----------------------------------------------------------------------------
+{
+    const size_t count = aabbs.size();
+    assert(visibleBitsOut.size() >= (count + 63) / 64);
+    if (pWorker)
+        pWorker->ParallelFor((uint32_t)((count + 63) / 64), 64, [&](uint32_t beginWord, uint32_t endWord) {
+            CullRangeBits(aabbs, beginWord * size_t(64), std::min(endWord * size_t(64), count), visibleBitsOut);
+        });
+    else
+        CullRangeBits(aabbs, 0, count, visibleBitsOut);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t CameraFrustum::CullSpheres(const Spheres& spheres, std::span<uint32_t> visibleIndicesOut) const
+//-----------------------------------------------------------------------------
+{
+    return CullIndices(m_Planes, m_NumPlanes, spheres, visibleIndicesOut);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t CameraFrustum::CullAabbs(const Aabbs& aabbs, std::span<uint32_t> visibleIndicesOut) const
+//-----------------------------------------------------------------------------
+{
+    return CullIndices(m_Planes, m_NumPlanes, aabbs, visibleIndicesOut);
+}
@@ -0,0 +1,77 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include "system/glm_common.hpp"
+
+// Forward declarations
+class ThreadWorker;
+
+/// View frustum planes and batched (SIMD) visibility tests.
+/// @ingroup Camera
+/// Planes are extracted from a view projection matrix (zero to one depth, as configured by glm_common.hpp), pointing inwards and normalized.
+/// Bounds are passed as structure of arrays and tested 4 at a time (NEON or SSE2, with a scalar fallback), stopping early once all 4 are
+/// outside.  Results are either a bitset (bit per bound) or a compacted list of visible indices.
+/// Unlike ViewFrustum (mesh/octree.hpp) this is intended for flat arrays of bounds rather than octree queries.
+class CameraFrustum
+{
+public:
+    /// How the projection maps depth.
+    enum class DepthMode {
+        ZeroToOne,              ///< near plane at depth 0, far at 1
+        ReverseZ,               ///< near plane at depth 1, far at 0
+        ReverseZInfiniteFar,    ///< near plane at depth 1, no far plane
+    };
+    enum PlaneIdx : uint32_t {
+        Left = 0, Right, Bottom, Top, Near, Far,
+        NumPlanes
+    };
+
+    /// Sphere bounds, structure of arrays (all spans the same size)
+    struct Spheres
+    {
+        std::span<const float> X, Y, Z, Radius;
+        size_t size() const { return X.size(); }
+    };
+    /// Axis aligned boxes (center and half size), structure of arrays (all spans the same size)
+    struct Aabbs
+    {
+        std::span<const float> CenterX, CenterY, CenterZ;
+        std::span<const float> ExtentX, ExtentY, ExtentZ;
+        size_t size() const { return CenterX.size(); }
+    };
+
+    CameraFrustum();
+    explicit CameraFrustum(const glm::mat4& viewProjection, DepthMode depthMode = DepthMode::ZeroToOne);
+
+    const auto& GetPlanes() const { return m_Planes; }
+    uint32_t GetNumPlanes() const { return m_NumPlanes; }   ///< 5 for ReverseZInfiniteFar (no far plane)
+
+    bool IsSphereVisible(const glm::vec3& center, float radius) const;
+    bool IsAabbVisible(const glm::vec3& center, const glm::vec3& extent) const;
+
+    /// Set bit (i & 63) of visibleBitsOut[i / 64] for each visible bound i (and clear it otherwise).
+    /// Work is split (in 64 bound chunks) across pWorker's threads if given.
+    /// @param visibleBitsOut at least (size + 63) / 64 words
+    void CullSpheres(const Spheres& spheres, std::span<uint64_t> visibleBitsOut, ThreadWorker* pWorker = nullptr) const;
+    void CullAabbs(const Aabbs& aabbs, std::span<uint64_t> visibleBitsOut, ThreadWorker* pWorker = nullptr) const;
+    /// Output the indices of the visible bounds (in order).
+    /// @param visibleIndicesOut at least size entries
+    /// @return number of visible bounds
+    uint32_t CullSpheres(const Spheres& spheres, std::span<uint32_t> visibleIndicesOut) const;
+    uint32_t CullAabbs(const Aabbs& aabbs, std::span<uint32_t> visibleIndicesOut) const;
+
+protected:
+    template<typename T_BOUNDS> void CullRangeBits(const T_BOUNDS& bounds, size_t begin, size_t end, std::span<uint64_t> visibleBitsOut) const;
+
+    std::array<glm::vec4, NumPlanes>    m_Planes;
+    uint32_t                            m_NumPlanes = NumPlanes;
+};
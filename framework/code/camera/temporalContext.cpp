@@ -0,0 +1,179 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "temporalContext.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+namespace
+{
+    /// Distance between two points in the unit square, wrapping at the edges (jitter sequences tile across pixels)
+    float ToroidalDistanceSq(const glm::vec2& a, const glm::vec2& b)
+    {
+        glm::vec2 d = glm::abs(a - b);
+        d = glm::min(d, glm::vec2(1.0f) - d);
+        return glm::dot(d, d);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TemporalContext::TemporalContext()
+//-----------------------------------------------------------------------------
+{
+}
+
+//-----------------------------------------------------------------------------
+void TemporalContext::SetJitterSequence(JitterSequence sequence, uint32_t length)
+//-----------------------------------------------------------------------------
+{
+    m_JitterSequenceType = sequence;
+    m_JitterSequence = MakeJitterSequence(sequence, length);
+}
+
+//-----------------------------------------------------------------------------
+glm::vec2 TemporalContext::GetJitter() const
+//-----------------------------------------------------------------------------
+{
+    if (m_JitterSequence.empty())
+        return glm::vec2(0.0f);
+    return m_JitterSequence[m_FrameIndex % m_JitterSequence.size()];
+}
+
+//-----------------------------------------------------------------------------
+void TemporalContext::BeginFrame()
+//-----------------------------------------------------------------------------
+{
+    ++m_FrameIndex;
+    if (m_HasMatrices)
+    {
+        m_PreviousProjection = m_Projection;
+        m_PreviousView = m_View;
+        m_PreviousViewProjection = m_ViewProjection;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TemporalContext::SetMatrices(const glm::mat4& projection, const glm::mat4& view, bool cut)
+//-----------------------------------------------------------------------------
+{
+    m_Projection = projection;
+    m_View = view;
+    m_ViewProjection = projection * view;
+    if (cut || !m_HasMatrices)
+    {
+        // No history
+        m_PreviousProjection = m_Projection;
+        m_PreviousView = m_View;
+        m_PreviousViewProjection = m_ViewProjection;
+        m_CutFrameIndex = m_FrameIndex;
+    }
+    m_HasMatrices = true;
+}
+
+//-----------------------------------------------------------------------------
+bool TemporalContext::IsCameraStill(float threshold) const
+//-----------------------------------------------------------------------------
+{
+    float difference = 0.0f;
+    for (int column = 0; column < 4; ++column)
+        for (int row = 0; row < 4; ++row)
+            difference += std::abs(m_ViewProjection[column][row] - m_PreviousViewProjection[column][row]);
+    return difference < threshold;
+}
+
+//-----------------------------------------------------------------------------
+void TemporalContext::SetObjectTransform(uint32_t objectId, const glm::mat4& transform)
+//-----------------------------------------------------------------------------
+{
+    if (objectId >= m_ObjectTransforms.size())
+        m_ObjectTransforms.resize(objectId + 1);
+    auto& object = m_ObjectTransforms[objectId];
+    if (object.FrameIndex != m_FrameIndex)
+    {
+        // History is only valid if the object was set last frame (and there was no cut since).
+        const bool hasHistory = object.FrameIndex != UINT32_MAX && object.FrameIndex + 1 == m_FrameIndex && m_CutFrameIndex != m_FrameIndex;
+        object.Previous = hasHistory ? object.Current : transform;
+        object.FrameIndex = m_FrameIndex;
+    }
+    object.Current = transform;
+}
+
+//-----------------------------------------------------------------------------
+const glm::mat4& TemporalContext::GetPreviousObjectTransform(uint32_t objectId) const
+//-----------------------------------------------------------------------------
+{
+    static const glm::mat4 identity(1.0f);
+    if (objectId >= m_ObjectTransforms.size())
+        return identity;
+    return m_ObjectTransforms[objectId].Previous;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<glm::vec2> TemporalContext::MakeJitterSequence(JitterSequence sequence, uint32_t length)
+//-----------------------------------------------------------------------------
+{
+    std::vector<glm::vec2> jitter;
+    if (sequence == JitterSequence::None)
+        return jitter;
+    jitter.reserve(length);
+    switch (sequence)
+    {
+    case JitterSequence::None:
+        break;
+    case JitterSequence::Halton23:
+        // Skip index 0 (always 0,0)
+        for (uint32_t i = 0; i < length; ++i)
+            jitter.push_back(glm::vec2(Halton(i + 1, 2), Halton(i + 1, 3)));
+        break;
+    case JitterSequence::R2:
+    {
+        // Roberts' R2 sequence, generalized golden ratio in 2d
+        const double g = 1.32471795724474602596;
+        const double a1 = 1.0 / g;
+        const double a2 = 1.0 / (g * g);
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            const double n = (double)(i + 1);
+            jitter.push_back(glm::vec2((float)std::fmod(0.5 + a1 * n, 1.0), (float)std::fmod(0.5 + a2 * n, 1.0)));
+        }
+        break;
+    }
+    case JitterSequence::BlueNoise:
+    {
+        // Mitchell's best candidate, fixed seed so the sequence is the same every run.  Every prefix is also well distributed.
+        std::mt19937 random(0x5eed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        const uint32_t numCandidates = 32;
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            glm::vec2 bestCandidate(unit(random), unit(random));
+            float bestDistanceSq = -1.0f;
+            for (uint32_t candidateIdx = 0; i > 0 && candidateIdx < numCandidates; ++candidateIdx)
+            {
+                const glm::vec2 candidate(unit(random), unit(random));
+                float distanceSq = FLT_MAX;
+                for (const auto& existing : jitter)
+                    distanceSq = std::min(distanceSq, ToroidalDistanceSq(candidate, existing));
+                if (distanceSq > bestDistanceSq)
+                {
+                    bestDistanceSq = distanceSq;
+                    bestCandidate = candidate;
+                }
+            }
+            jitter.push_back(bestCandidate);
+        }
+        break;
+    }
+    }
+    // [0,1) to pixel offsets
+    for (auto& position : jitter)
+        position -= glm::vec2(0.5f);
+    return jitter;
+}
@@ -0,0 +1,123 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "system/glm_common.hpp"
+
+/// Frame to frame state for temporal techniques (TAA, temporal upscalers such as SGSR2, SMAA reprojection).
+/// @ingroup Camera
+/// Provides the sub-pixel jitter sequence, the current and previous (unjittered) camera matrices and previous object transforms
+/// (for motion vectors).  Owned by Camera: Camera::BeginFrame advances it (once per frame), Camera::UpdateMatrices sets this frame's matrices.
+class TemporalContext
+{
+    TemporalContext(const TemporalContext&) = delete;
+    TemporalContext& operator=(const TemporalContext&) = delete;
+public:
+    enum class JitterSequence {
+        None,           ///< no jitter (Camera::SetJitter is left to the application)
+        Halton23,       ///< Halton sequence, bases 2 and 3 (as used by SGSR2)
+        R2,             ///< additive recurrence on the plastic constant (low discrepancy at any length)
+        BlueNoise,      ///< progressive best candidate samples (well separated, no visible structure)
+    };
+
+    TemporalContext();
+
+    /// @param length number of jitter positions before the sequence repeats
+    void SetJitterSequence(JitterSequence sequence, uint32_t length = 32);
+    JitterSequence GetJitterSequenceType() const        { return m_JitterSequenceType; }
+    const auto& GetJitterSequence() const               { return m_JitterSequence; }
+    /// Render target size, for converting the jitter from pixels
+    void SetRenderSize(uint32_t width, uint32_t height) { m_RenderSize = glm::vec2(std::max(width, 1u), std::max(height, 1u)); }
+
+    /// Jitter for the current frame, in pixels [-0.5, 0.5)
+    glm::vec2 GetJitter() const;
+    /// Jitter for the current frame, as passed to Camera::SetJitter (pixel jitter / render size)
+    glm::vec2 GetCameraJitter() const                   { return GetJitter() / m_RenderSize; }
+    uint32_t GetFrameIndex() const                      { return m_FrameIndex; }
+
+    /// Start a new frame: advances the jitter and makes the last frame's matrices the previous ones.  Called by Camera::BeginFrame, once per frame.
+    void BeginFrame();
+    /// Set this frame's (unjittered) camera matrices, may be called more than once per frame (the previous frame matrices are kept).
+    /// Called by Camera::UpdateMatrices.
+    /// @param cut camera cut (or first frame) so there is no valid history, previous matrices are set to the current ones
+    void SetMatrices(const glm::mat4& projection, const glm::mat4& view, bool cut);
+    /// @return false on the first frame, or a camera cut, when there is no previous frame to reproject from
+    bool HasHistory() const                             { return m_CutFrameIndex != m_FrameIndex; }
+
+    const glm::mat4& GetViewProjection() const          { return m_ViewProjection; }
+    const glm::mat4& GetPreviousViewProjection() const  { return m_PreviousViewProjection; }
+    const glm::mat4& GetPreviousView() const            { return m_PreviousView; }
+    const glm::mat4& GetPreviousProjection() const      { return m_PreviousProjection; }
+    /// Current clip space to previous frame clip space (unjittered), eg for PostProcessSMAA::UpdateUniforms or SGSR2 clip_to_prev_clip
+    glm::mat4 GetClipToPreviousClip() const             { return m_PreviousViewProjection * glm::inverse(m_ViewProjection); }
+    /// @return true if the view projection has not changed (by more than threshold, summed over the matrix elements) since the previous frame
+    bool IsCameraStill(float threshold = 1e-5f) const;
+
+    /// Set an object's world transform for this frame (call every frame the object is drawn).
+    /// @param objectId application defined (small, dense) id
+    void SetObjectTransform(uint32_t objectId, const glm::mat4& transform);
+    /// @return object's transform from the previous frame (its current transform if it was not set last frame, or after a cut)
+    const glm::mat4& GetPreviousObjectTransform(uint32_t objectId) const;
+    /// @return previous frame's object to clip space matrix (for motion vectors)
+    glm::mat4 GetPreviousObjectViewProjection(uint32_t objectId) const { return m_PreviousViewProjection * GetPreviousObjectTransform(objectId); }
+
+    /// Generate jitter positions (pixels, [-0.5, 0.5))
+    static std::vector<glm::vec2> MakeJitterSequence(JitterSequence sequence, uint32_t length);
+    /// Halton(2,3) jitter positions, the same as MakeJitterSequence(JitterSequence::Halton23, T_LENGTH) but built at compile time (for constexpr tables)
+    template<uint32_t T_LENGTH>
+    static constexpr std::array<glm::vec2, T_LENGTH> MakeHaltonJitter()
+    {
+        std::array<glm::vec2, T_LENGTH> jitter;
+        // Skip index 0 (always 0,0)
+        for (uint32_t i = 0; i < T_LENGTH; ++i)
+            jitter[i] = { Halton(i + 1, 2) - 0.5f, Halton(i + 1, 3) - 0.5f };
+        return jitter;
+    }
+    /// Radical inverse of index in the given base, [0,1)
+    static constexpr float Halton(uint32_t index, uint32_t base)
+    {
+        float result = 0.0f;
+        const float invBase = 1.0f / (float)base;
+        float fraction = invBase;
+        while (index > 0)
+        {
+            result += (float)(index % base) * fraction;
+            index /= base;
+            fraction *= invBase;
+        }
+        return result;
+    }
+
+protected:
+    struct ObjectTransform
+    {
+        glm::mat4   Current = glm::mat4(1.0f);
+        glm::mat4   Previous = glm::mat4(1.0f);
+        uint32_t    FrameIndex = UINT32_MAX;    ///< frame Current was set
+    };
+
+    JitterSequence              m_JitterSequenceType = JitterSequence::None;
+    std::vector<glm::vec2>      m_JitterSequence;
+    glm::vec2                   m_RenderSize = glm::vec2(1.0f);
+    uint32_t                    m_FrameIndex = 0;
+    uint32_t                    m_CutFrameIndex = 0;    ///< last frame with no valid history
+
+    glm::mat4                   m_ViewProjection = glm::mat4(1.0f);
+    glm::mat4                   m_View = glm::mat4(1.0f);
+    glm::mat4                   m_Projection = glm::mat4(1.0f);
+    glm::mat4                   m_PreviousViewProjection = glm::mat4(1.0f);
+    glm::mat4                   m_PreviousView = glm::mat4(1.0f);
+    glm::mat4                   m_PreviousProjection = glm::mat4(1.0f);
+    bool                        m_HasMatrices = false;
+
+    std::vector<ObjectTransform> m_ObjectTransforms;    ///< [objectId]
+};
@@ -0,0 +1,308 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "gpuDrivenCulling.hpp"
+#include "zbufferReduce.hpp"
+#include "vulkan/vulkan.hpp"
+#include "vulkan/commandBuffer.hpp"
+#include "texture/vulkan/texture.hpp"
+#include "material/vulkan/computable.hpp"
+#include "material/vulkan/materialManager.hpp"
+#include "mesh/octree.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+//-----------------------------------------------------------------------------
+GpuDrivenCulling::~GpuDrivenCulling()
+//-----------------------------------------------------------------------------
+{
+    Release();
+}
+
+//-----------------------------------------------------------------------------
+std::optional<DrawIndirectBuffer<Vulkan>> GpuDrivenCulling::CreateDrawIndirectBuffer( Vulkan& vulkan, uint32_t maxDraws )
+//-----------------------------------------------------------------------------
+{
+    DrawIndirectBuffer<Vulkan> drawIndirectBuffer( DrawIndirectBuffer<Vulkan>::eType::IndexedDraw );
+    // Written by the compute shader, count cleared by vkCmdFillBuffer.
+    if (!drawIndirectBuffer.Initialize<VkDrawIndexedIndirectCommand, DrawCountPrequel>( &vulkan.GetMemoryManager(), maxDraws, nullptr, nullptr, BufferUsageFlags::Indirect | BufferUsageFlags::Storage | BufferUsageFlags::TransferDst ))
+    {
+        LOGE( "GpuDrivenCulling: failed to create draw indirect buffer (%u draws)", maxDraws );
+        return std::nullopt;
+    }
+    return std::optional<DrawIndirectBuffer<Vulkan>>{ std::move( drawIndirectBuffer ) };
+}
+
+//-----------------------------------------------------------------------------
+bool GpuDrivenCulling::Init( Vulkan& vulkan, const MaterialManager<Vulkan>& materialManager, const Shader<Vulkan>& cullShader, uint32_t numFrameBuffers, std::span<const CullInstance> instances, const ZBufferReduce& hiZ, const DrawIndirectBuffer<Vulkan>& drawIndirectBuffer )
+//-----------------------------------------------------------------------------
+{
+    Release();
+    m_pVulkan = &vulkan;
+    m_NumInstances = (uint32_t) instances.size();
+    m_MaxDraws = (uint32_t) drawIndirectBuffer.GetNumDraws();
+    assert( drawIndirectBuffer.GetIndirectBufferType() == DrawIndirectBuffer<Vulkan>::eType::IndexedDraw );
+    assert( drawIndirectBuffer.GetBufferOffset() == sizeof( DrawCountPrequel ) );
+    if (GetNumDroppedInstances() > 0)
+        LOGW( "GpuDrivenCulling: draw indirect buffer (%u draws) is smaller than the instance count (%u), the last %u instances will never be culled or drawn", m_MaxDraws, m_NumInstances, GetNumDroppedInstances() );
+    m_DrawIndirectVkBuffer = drawIndirectBuffer.GetVkBuffer();
+
+    const auto& hiZTexture = hiZ.GetHierarchicalZTexture();
+    m_HiZSize = { hiZTexture.Width, hiZTexture.Height };
+    m_HiZMipCount = hiZTexture.MipLevels;
+
+    // Instance bounds never change, upload them once.
+    if (!m_InstanceBuffer.Initialize( &vulkan.GetMemoryManager(), std::max<size_t>( instances.size_bytes(), sizeof( CullInstance ) ), BufferUsageFlags::Storage, instances.empty() ? nullptr : instances.data() ))
+    {
+        LOGE( "GpuDrivenCulling: failed to create instance buffer" );
+        return false;
+    }
+
+    m_CullParams.resize( numFrameBuffers, MakeCullParams( glm::mat4( 1.0f ), 0, m_HiZSize, m_HiZMipCount, m_NumInstances - GetNumDroppedInstances() ) );
+    m_CullParamsUniforms.resize( numFrameBuffers );
+    std::vector<VkBuffer> cullParamsVkBuffers;
+    for (uint32_t bufferIdx = 0; bufferIdx < numFrameBuffers; ++bufferIdx)
+    {
+        if (!CreateUniformBuffer( &vulkan, &m_CullParamsUniforms[bufferIdx], sizeof( CullParams ), &m_CullParams[bufferIdx], BufferUsageFlags::Uniform ))
+            return false;
+        cullParamsVkBuffers.push_back( m_CullParamsUniforms[bufferIdx].buf.GetVkBuffer() );
+    }
+
+    auto material = materialManager.CreateMaterial( cullShader, numFrameBuffers,
+        [&hiZTexture]( const std::string& textureName ) -> const MaterialManagerBase::tPerFrameTexInfo {
+            if (textureName == "HiZ")
+                return { &hiZTexture };
+            assert( 0 );
+            return {};
+        },
+        [this, &cullParamsVkBuffers]( const std::string& bufferName ) -> PerFrameBuffer<Vulkan> {
+            if (bufferName == "CullParams")
+                return { cullParamsVkBuffers.begin(), cullParamsVkBuffers.end() };
+            else if (bufferName == "Instances")
+                return { m_InstanceBuffer.GetVkBuffer() };
+            else if (bufferName == "DrawCommands")
+                return { m_DrawIndirectVkBuffer };
+            assert( 0 );
+            return {};
+        }
+    );
+
+    auto pComputable = std::make_unique<Computable<Vulkan>>( vulkan, std::move( material ) );
+    if (!pComputable->Init())
+    {
+        LOGE( "GpuDrivenCulling: failed to initialize culling computable" );
+        return false;
+    }
+    pComputable->SetDispatchThreadCount( 0, { std::max( m_NumInstances, 1u ), 1, 1 } );
+    m_CullComputable = std::move( pComputable );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void GpuDrivenCulling::Release()
+//-----------------------------------------------------------------------------
+{
+    if (!m_pVulkan)
+        return;
+    m_CullComputable.reset();
+    for (auto& uniform : m_CullParamsUniforms)
+        ReleaseUniformBuffer( m_pVulkan, &uniform );
+    m_CullParamsUniforms.clear();
+    m_CullParams.clear();
+    m_InstanceBuffer.Destroy();
+    m_DrawIndirectVkBuffer = VK_NULL_HANDLE;
+    m_NumInstances = 0;
+    m_pVulkan = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void GpuDrivenCulling::UpdateView( uint32_t bufferIdx, const glm::mat4& viewProjection, uint32_t flags )
+//-----------------------------------------------------------------------------
+{
+    // Only cull the instances that fit in the draw indirect buffer (the rest were reported by Init, see GetNumDroppedInstances).
+    m_CullParams[bufferIdx] = MakeCullParams( viewProjection, flags, m_HiZSize, m_HiZMipCount, m_NumInstances - GetNumDroppedInstances() );
+    UpdateUniformBuffer( m_pVulkan, m_CullParamsUniforms[bufferIdx], m_CullParams[bufferIdx] );
+}
+
+//-----------------------------------------------------------------------------
+void GpuDrivenCulling::UpdateCommandBuffer( CommandList<Vulkan>& cmdList, uint32_t bufferIdx )
+//-----------------------------------------------------------------------------
+{
+    VkBufferMemoryBarrier bufferBarrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = m_DrawIndirectVkBuffer;
+    bufferBarrier.offset = 0;
+    bufferBarrier.size = VK_WHOLE_SIZE;
+
+    // Previous use of the draw buffer (as indirect draw parameters) must be done before we clear the count.
+    bufferBarrier.srcAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier( cmdList, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr );
+    vkCmdFillBuffer( cmdList, m_DrawIndirectVkBuffer, offsetof( DrawCountPrequel, DrawCount ), sizeof( DrawCountPrequel::DrawCount ), 0 );
+
+    bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier( cmdList, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr );
+
+    m_CullComputable->Dispatch( cmdList, bufferIdx, false );
+
+    // Compacted draws (and count) are consumed by vkCmdDraw*Indirect*
+    bufferBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    vkCmdPipelineBarrier( cmdList, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr );
+}
+
+//-----------------------------------------------------------------------------
+GpuDrivenCulling::CullParams GpuDrivenCulling::MakeCullParams( const glm::mat4& viewProjection, uint32_t flags, glm::uvec2 hiZSize, uint32_t hiZMipCount, uint32_t numInstances )
+//-----------------------------------------------------------------------------
+{
+    CullParams params{};
+    params.ViewProjection = viewProjection;
+    const ViewFrustum frustum( viewProjection, glm::mat4( 1.0f ) );
+    std::copy( std::begin( frustum.GetPlanes() ), std::end( frustum.GetPlanes() ), std::begin( params.FrustumPlanes ) );
+    params.HiZSize = glm::vec2( hiZSize );
+    params.HiZMipCount = hiZMipCount;
+    params.NumInstances = numInstances;
+    params.Flags = flags;
+    return params;
+}
+
+//-----------------------------------------------------------------------------
+bool GpuDrivenCulling::FrustumTest( const CullInstance& instance, const CullParams& params )
+//-----------------------------------------------------------------------------
+{
+    const glm::vec3 center( instance.BoundsCenter );
+    const glm::vec3 halfSize( instance.BoundsHalfSize );
+    for (const auto& plane : params.FrustumPlanes)
+    {
+        // Box is outside if its closest point to the plane is on the outside.
+        const float distance = glm::dot( glm::vec3( plane ), center ) + plane.w;
+        const float extent = glm::dot( glm::abs( glm::vec3( plane ) ), halfSize );
+        if (distance < -extent)
+            return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool GpuDrivenCulling::OcclusionTest( const CullInstance& instance, const CullParams& params, const HiZReference& hiZ )
+//-----------------------------------------------------------------------------
+{
+    const bool reverseZ = (params.Flags & ReverseZ) != 0;
+
+    // Screen space bounds (uv) and nearest depth of the bounding box.
+    glm::vec2 uvMin( 1.0f ), uvMax( 0.0f );
+    float nearestZ = reverseZ ? 0.0f : 1.0f;
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec3 sign( (corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : -1.0f );
+        const glm::vec4 clip = params.ViewProjection * glm::vec4( glm::vec3( instance.BoundsCenter ) + sign * glm::vec3( instance.BoundsHalfSize ), 1.0f );
+        if (clip.w <= 1e-5f)
+            return false;   // crosses the camera plane, treat as visible
+        const glm::vec3 ndc = glm::vec3( clip ) / clip.w;
+        const glm::vec2 uv = glm::vec2( ndc ) * 0.5f + 0.5f;
+        uvMin = glm::min( uvMin, uv );
+        uvMax = glm::max( uvMax, uv );
+        nearestZ = reverseZ ? std::max( nearestZ, ndc.z ) : std::min( nearestZ, ndc.z );
+    }
+    uvMin = glm::clamp( uvMin, 0.0f, 1.0f );
+    uvMax = glm::clamp( uvMax, 0.0f, 1.0f );
+
+    // Pick the mip where the bounds cover at most 2x2 texels.
+    // If the pyramid stops short of that mip the 4 texels sampled would not cover the bounds, so the instance is treated as visible.
+    const glm::vec2 sizeTexels = (uvMax - uvMin) * params.HiZSize;
+    const float maxSizeTexels = std::max( std::max( sizeTexels.x, sizeTexels.y ), 1.0f );
+    const uint32_t mip = (uint32_t) std::ceil( std::log2( maxSizeTexels ) );
+    if (mip >= params.HiZMipCount)
+        return false;
+    const glm::uvec2 mipSize = glm::max( glm::uvec2( params.HiZSize ) >> mip, glm::uvec2( 1 ) );
+    const glm::uvec2 texelMin = glm::min( glm::uvec2( uvMin * glm::vec2( mipSize ) ), mipSize - 1u );
+    const glm::uvec2 texelMax = glm::min( glm::uvec2( uvMax * glm::vec2( mipSize ) ), mipSize - 1u );
+
+    float farthestZ = hiZ.Fetch( mip, texelMin.x, texelMin.y );
+    for (const auto& texel : { glm::uvec2( texelMax.x, texelMin.y ), glm::uvec2( texelMin.x, texelMax.y ), texelMax })
+    {
+        const float z = hiZ.Fetch( mip, texel.x, texel.y );
+        farthestZ = reverseZ ? std::min( farthestZ, z ) : std::max( farthestZ, z );
+    }
+    return reverseZ ? (nearestZ < farthestZ) : (nearestZ > farthestZ);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t GpuDrivenCulling::CullReference( std::span<const CullInstance> instances, const CullParams& params, const HiZReference* pHiZ, std::span<VkDrawIndexedIndirectCommand> outDraws )
+//-----------------------------------------------------------------------------
+{
+    assert( pHiZ || (params.Flags & OcclusionCull) == 0 );
+    const uint32_t numInstances = std::min( (uint32_t) instances.size(), params.NumInstances );
+    uint32_t drawCount = 0;
+    for (uint32_t instanceIdx = 0; instanceIdx < numInstances; ++instanceIdx)
+    {
+        const auto& instance = instances[instanceIdx];
+        if ((params.Flags & FrustumCull) != 0 && !FrustumTest( instance, params ))
+            continue;
+        if ((params.Flags & OcclusionCull) != 0 && OcclusionTest( instance, params, *pHiZ ))
+            continue;
+        if (drawCount >= outDraws.size())
+            break;
+        outDraws[drawCount++] = { instance.IndexCount, 1, instance.FirstIndex, instance.VertexOffset, instance.FirstInstance };
+    }
+    return drawCount;
+}
+
+//-----------------------------------------------------------------------------
+GpuDrivenCulling::HiZReference GpuDrivenCulling::HiZReference::Build( std::span<const float> depth, uint32_t depthWidth, uint32_t depthHeight, uint32_t numMips, bool reverseZ )
+//-----------------------------------------------------------------------------
+{
+    assert( depth.size() >= size_t( depthWidth ) * depthHeight );
+    HiZReference hiZ;
+    hiZ.Width = std::max( depthWidth / 2, 1u );
+    hiZ.Height = std::max( depthHeight / 2, 1u );
+    hiZ.Mips.resize( numMips );
+
+    std::span<const float> src = depth;
+    uint32_t srcWidth = depthWidth, srcHeight = depthHeight;
+    for (uint32_t mip = 0; mip < numMips; ++mip)
+    {
+        const uint32_t dstWidth = std::max( hiZ.Width >> mip, 1u );
+        const uint32_t dstHeight = std::max( hiZ.Height >> mip, 1u );
+        auto& dst = hiZ.Mips[mip];
+        dst.resize( size_t( dstWidth ) * dstHeight );
+        for (uint32_t y = 0; y < dstHeight; ++y)
+        {
+            // Every source texel overlapping this texel (so odd sized sources stay conservative)
+            const uint32_t srcY0 = y * srcHeight / dstHeight;
+            const uint32_t srcY1 = std::max( ((y + 1) * srcHeight + dstHeight - 1) / dstHeight, srcY0 + 1 );
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                const uint32_t srcX0 = x * srcWidth / dstWidth;
+                const uint32_t srcX1 = std::max( ((x + 1) * srcWidth + dstWidth - 1) / dstWidth, srcX0 + 1 );
+                float farthest = reverseZ ? 1.0f : 0.0f;
+                for (uint32_t sy = srcY0; sy < srcY1; ++sy)
+                    for (uint32_t sx = srcX0; sx < srcX1; ++sx)
+                        farthest = reverseZ ? std::min( farthest, src[size_t( sy ) * srcWidth + sx] ) : std::max( farthest, src[size_t( sy ) * srcWidth + sx] );
+                dst[size_t( y ) * dstWidth + x] = farthest;
+            }
+        }
+        src = dst;
+        srcWidth = dstWidth;
+        srcHeight = dstHeight;
+    }
+    return hiZ;
+}
+
+//-----------------------------------------------------------------------------
+float GpuDrivenCulling::HiZReference::Fetch( uint32_t mip, uint32_t x, uint32_t y ) const
+//-----------------------------------------------------------------------------
+{
+    const uint32_t mipWidth = std::max( Width >> mip, 1u );
+    const uint32_t mipHeight = std::max( Height >> mip, 1u );
+    return Mips[mip][size_t( std::min( y, mipHeight - 1 ) ) * mipWidth + std::min( x, mipWidth - 1 )];
+}
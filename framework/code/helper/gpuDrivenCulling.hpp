@@ -0,0 +1,148 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include <volk/volk.h>
+#include "memory/vulkan/bufferObject.hpp"
+#include "memory/vulkan/drawIndirectBufferObject.hpp"
+#include "memory/vulkan/uniform.hpp"
+
+// Forward declarations
+class Vulkan;
+class ZBufferReduce;
+template<typename T_GFXAPI> class CommandList;
+template<typename T_GFXAPI> class Computable;
+template<typename T_GFXAPI> class MaterialManager;
+template<typename T_GFXAPI> class Shader;
+
+/// @brief GPU driven indirect draw generation.
+/// Instance bounds (and the indexed draw for each instance) are uploaded once.  Each frame a compute shader frustum culls and (optionally)
+/// Hi-Z occlusion culls every instance against ZBufferReduce::GetHierarchicalZTexture and appends the survivors to an indirect draw
+/// buffer (with the draw count in the buffer 'prequel', the layout Drawable<Vulkan> uses for vkCmdDrawIndexedIndirectCountKHR).
+///
+/// The compute shader is supplied by the application (as for ZBufferReduce).  It must have a single pass, with a "WorkGroup" local size,
+/// one thread per instance, and bind:
+///     "CullParams"    UniformBuffer   GpuDrivenCulling::CullParams
+///     "Instances"     StorageBuffer   GpuDrivenCulling::CullInstance[]
+///     "DrawCommands"  StorageBuffer   GpuDrivenCulling::DrawCountPrequel followed by VkDrawIndexedIndirectCommand[]
+///     "HiZ"           ImageSampled    hierarchical z buffer (sampled with texelFetch)
+/// Surviving instances atomicAdd on DrawCountPrequel::DrawCount to get their output slot.  The culling tests must match CullReference
+/// (which is the cpu reference implementation, for validating the shader).  In particular the occlusion test samples the 4 corner texels
+/// of the mip where the bounds cover at most 2x2 texels, and treats the instance as visible when that mip is past HiZMipCount.
+class GpuDrivenCulling
+{
+    GpuDrivenCulling( const GpuDrivenCulling& ) = delete;
+    GpuDrivenCulling& operator=( const GpuDrivenCulling& ) = delete;
+public:
+    /// Per instance data (std430 layout)
+    struct CullInstance
+    {
+        glm::vec4   BoundsCenter;       ///< world space bounding box center (w unused)
+        glm::vec4   BoundsHalfSize;     ///< world space bounding box half size (w unused)
+        uint32_t    IndexCount;
+        uint32_t    FirstIndex;
+        int32_t     VertexOffset;
+        uint32_t    FirstInstance;      ///< passed through to the draw (eg for the vertex shader to find its per instance data)
+    };
+    static_assert(sizeof( CullInstance ) == 48);
+
+    enum CullFlags : uint32_t {
+        FrustumCull = 1,
+        OcclusionCull = 2,
+        ReverseZ = 4,                   ///< depth buffer (and Hi-Z) has 1 at the near plane
+    };
+
+    /// Per frame culling parameters (std140 layout)
+    struct CullParams
+    {
+        glm::mat4   ViewProjection;
+        glm::vec4   FrustumPlanes[6];   ///< normalized, pointing in to the frustum
+        glm::vec2   HiZSize;            ///< size of Hi-Z mip 0 (texels)
+        uint32_t    HiZMipCount;
+        uint32_t    NumInstances;
+        uint32_t    Flags;              ///< CullFlags
+        uint32_t    Pad[3];
+    };
+
+    /// Start of the DrawCommands buffer
+    struct DrawCountPrequel
+    {
+        uint32_t    DrawCount;
+        uint32_t    Pad[3];
+    };
+
+    /// Cpu copy of a Hi-Z pyramid, for CullReference.
+    /// Same layout as ZBufferReduce: mip 0 is half the size of the depth buffer and each texel holds the farthest depth it covers.
+    struct HiZReference
+    {
+        uint32_t                        Width = 0;      ///< mip 0 width
+        uint32_t                        Height = 0;     ///< mip 0 height
+        std::vector<std::vector<float>> Mips;
+
+        /// Build the pyramid from a (full sized) depth buffer.
+        static HiZReference Build( std::span<const float> depth, uint32_t depthWidth, uint32_t depthHeight, uint32_t numMips, bool reverseZ );
+        float Fetch( uint32_t mip, uint32_t x, uint32_t y ) const;
+    };
+
+    GpuDrivenCulling() = default;
+    ~GpuDrivenCulling();
+
+    /// Create an indirect draw buffer with the layout written by the culling shader (DrawCountPrequel followed by maxDraws indexed draw commands).
+    /// Pass it to Drawable::Init (the Drawable takes ownership) and to Init.
+    static std::optional<DrawIndirectBuffer<Vulkan>> CreateDrawIndirectBuffer( Vulkan& vulkan, uint32_t maxDraws );
+
+    /// @param instances    uploaded once
+    /// @param hiZ          hierarchical z buffer to occlusion test against (typically reduced from the previous frame's depth)
+    /// @param drawIndirectBuffer output buffer (from CreateDrawIndirectBuffer), must stay alive while this object is used.  May be moved (in to a Drawable) after Init.
+    bool Init( Vulkan& vulkan, const MaterialManager<Vulkan>& materialManager, const Shader<Vulkan>& cullShader, uint32_t numFrameBuffers, std::span<const CullInstance> instances, const ZBufferReduce& hiZ, const DrawIndirectBuffer<Vulkan>& drawIndirectBuffer );
+    void Release();
+
+    /// Update the culling parameters for the given frame buffer.
+    /// @param flags CullFlags
+    void UpdateView( uint32_t bufferIdx, const glm::mat4& viewProjection, uint32_t flags );
+
+    /// Add the commands to clear the draw count, cull, and barrier the output for use by vkCmdDraw*Indirect*.
+    /// Call outside of a render pass, after the Hi-Z has been generated.
+    void UpdateCommandBuffer( CommandList<Vulkan>& cmdList, uint32_t bufferIdx );
+
+    uint32_t GetNumInstances() const        { return m_NumInstances; }
+    /// Number of instances (at the end of the Init instance list) that do not fit in the draw indirect buffer, and so are never culled or drawn.
+    uint32_t GetNumDroppedInstances() const { return m_NumInstances > m_MaxDraws ? m_NumInstances - m_MaxDraws : 0; }
+    const CullParams& GetCullParams( uint32_t bufferIdx ) const { return m_CullParams[bufferIdx]; }
+
+    /// Build CullParams (including the frustum planes) on the cpu.
+    static CullParams MakeCullParams( const glm::mat4& viewProjection, uint32_t flags, glm::uvec2 hiZSize, uint32_t hiZMipCount, uint32_t numInstances );
+    /// @return true if the instance bounds are (at least partially) inside the frustum
+    static bool FrustumTest( const CullInstance& instance, const CullParams& params );
+    /// @return true if the instance bounds are entirely behind the Hi-Z (ie can be culled), false if they may be visible (including
+    ///         when they cross the camera plane or cover more than 2x2 texels of the smallest mip)
+    static bool OcclusionTest( const CullInstance& instance, const CullParams& params, const HiZReference& hiZ );
+    /// Cpu reference of the culling and compaction shader.  Surviving draws are written in instance order (the gpu order is not deterministic).
+    /// @param pHiZ may be null if params.Flags does not contain OcclusionCull
+    /// @return number of draws written to outDraws
+    static uint32_t CullReference( std::span<const CullInstance> instances, const CullParams& params, const HiZReference* pHiZ, std::span<VkDrawIndexedIndirectCommand> outDraws );
+
+protected:
+    Vulkan*                                 m_pVulkan = nullptr;
+    Buffer<Vulkan>                          m_InstanceBuffer;
+    std::vector<Uniform<Vulkan>>            m_CullParamsUniforms;   ///< one per frame buffer
+    std::vector<CullParams>                 m_CullParams;           ///< cpu copy of m_CullParamsUniforms
+    std::unique_ptr<Computable<Vulkan>>     m_CullComputable;
+    VkBuffer                                m_DrawIndirectVkBuffer = VK_NULL_HANDLE;   ///< not owned
+    uint32_t                                m_NumInstances = 0;
+    uint32_t                                m_MaxDraws = 0;
+    glm::uvec2                              m_HiZSize{ 0, 0 };
+    uint32_t                                m_HiZMipCount = 0;
+};
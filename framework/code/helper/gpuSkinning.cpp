@@ -0,0 +1,495 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "gpuSkinning.hpp"
+#include "vulkan/vulkan.hpp"
+#include "vulkan/commandBuffer.hpp"
+#include "material/vulkan/computable.hpp"
+#include "material/vulkan/materialManager.hpp"
+#include "mesh/meshIntermediate.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define GPUSKINNING_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GPUSKINNING_SSE2 1
+#endif
+
+
+//
+// 4 wide float vector (one joint matrix row, or one quaternion)
+//
+namespace
+{
+#if defined(GPUSKINNING_NEON)
+    struct Float4
+    {
+        float32x4_t v;
+        static Float4 Zero() { return { vdupq_n_f32( 0.0f ) }; }
+        static Float4 Load( const glm::vec4& p ) { return { vld1q_f32( &p.x ) }; }
+        glm::vec4 Store() const { glm::vec4 p; vst1q_f32( &p.x, v ); return p; }
+        Float4 MulAdd( Float4 a, float s ) const { return { vmlaq_n_f32( v, a.v, s ) }; }   ///< this + a * s
+        float Dot( Float4 o ) const { return vaddvq_f32( vmulq_f32( v, o.v ) ); }
+    };
+#elif defined(GPUSKINNING_SSE2)
+    struct Float4
+    {
+        __m128 v;
+        static Float4 Zero() { return { _mm_setzero_ps() }; }
+        static Float4 Load( const glm::vec4& p ) { return { _mm_loadu_ps( &p.x ) }; }
+        glm::vec4 Store() const { glm::vec4 p; _mm_storeu_ps( &p.x, v ); return p; }
+        Float4 MulAdd( Float4 a, float s ) const { return { _mm_add_ps( v, _mm_mul_ps( a.v, _mm_set1_ps( s ) ) ) }; }
+        float Dot( Float4 o ) const
+        {
+            const __m128 m = _mm_mul_ps( v, o.v );
+            const __m128 s = _mm_add_ps( m, _mm_shuffle_ps( m, m, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+            return _mm_cvtss_f32( _mm_add_ss( s, _mm_movehl_ps( s, s ) ) );
+        }
+    };
+#else
+    struct Float4
+    {
+        glm::vec4 v;
+        static Float4 Zero() { return { glm::vec4( 0.0f ) }; }
+        static Float4 Load( const glm::vec4& p ) { return { p }; }
+        glm::vec4 Store() const { return v; }
+        Float4 MulAdd( Float4 a, float s ) const { return { v + a.v * s }; }
+        float Dot( Float4 o ) const { return glm::dot( v, o.v ); }
+    };
+#endif
+
+    /// Rotate v by the unit quaternion q (xyzw)
+    glm::vec3 RotateVector( const glm::vec4& q, const glm::vec3& v )
+    {
+        const glm::vec3 qv( q );
+        return v + 2.0f * glm::cross( qv, glm::cross( qv, v ) + q.w * v );
+    }
+
+    void SkinLinearBlend( const GpuSkinning::SkinVertex& vertex, std::span<const glm::vec4> joints, glm::vec3& positionOut, glm::vec3& normalOut )
+    {
+        // Blend the matrix rows, then transform.
+        Float4 rows[3] = { Float4::Zero(), Float4::Zero(), Float4::Zero() };
+        for (int influence = 0; influence < 4; ++influence)
+        {
+            const float weight = vertex.Weights[influence];
+            if (weight == 0.0f)
+                continue;
+            const glm::vec4* pJoint = &joints[vertex.Joints[influence] * 3];
+            for (int row = 0; row < 3; ++row)
+                rows[row] = rows[row].MulAdd( Float4::Load( pJoint[row] ), weight );
+        }
+        const Float4 position = Float4::Load( glm::vec4( glm::vec3( vertex.Position ), 1.0f ) );
+        positionOut = glm::vec3( rows[0].Dot( position ), rows[1].Dot( position ), rows[2].Dot( position ) );
+
+        // Normals by the inverse transpose of the (upper 3x3) blended matrix.  Its rows are the cross products of the matrix rows divided
+        // by the determinant, only the determinant's sign matters as the result is normalized.
+        const glm::vec3 row0( rows[0].Store() );
+        const glm::vec3 row1( rows[1].Store() );
+        const glm::vec3 row2( rows[2].Store() );
+        const glm::vec3 cofactor0 = glm::cross( row1, row2 );
+        const glm::vec3 normal( vertex.Normal );
+        glm::vec3 skinnedNormal( glm::dot( cofactor0, normal ), glm::dot( glm::cross( row2, row0 ), normal ), glm::dot( glm::cross( row0, row1 ), normal ) );
+        if (glm::dot( row0, cofactor0 ) < 0.0f)
+            skinnedNormal = -skinnedNormal;
+        const float normalLength = glm::length( skinnedNormal );
+        normalOut = normalLength > 0.0f ? skinnedNormal / normalLength : skinnedNormal;
+    }
+
+    void SkinDualQuaternion( const GpuSkinning::SkinVertex& vertex, std::span<const glm::vec4> joints, glm::vec3& positionOut, glm::vec3& normalOut )
+    {
+        // Blend the dual quaternions (in the same hemisphere as the first influence), normalize, then transform.
+        const Float4 firstReal = Float4::Load( joints[vertex.Joints[0] * 2] );
+        Float4 real = Float4::Zero();
+        Float4 dual = Float4::Zero();
+        for (int influence = 0; influence < 4; ++influence)
+        {
+            float weight = vertex.Weights[influence];
+            if (weight == 0.0f)
+                continue;
+            const Float4 jointReal = Float4::Load( joints[vertex.Joints[influence] * 2] );
+            const Float4 jointDual = Float4::Load( joints[vertex.Joints[influence] * 2 + 1] );
+            if (firstReal.Dot( jointReal ) < 0.0f)
+                weight = -weight;
+            real = real.MulAdd( jointReal, weight );
+            dual = dual.MulAdd( jointDual, weight );
+        }
+        glm::vec4 blendedReal = real.Store();
+        glm::vec4 blendedDual = dual.Store();
+        const float length = glm::length( blendedReal );
+        if (length > 0.0f)
+        {
+            blendedReal /= length;
+            blendedDual /= length;
+        }
+        const glm::vec3 realVector( blendedReal );
+        const glm::vec3 dualVector( blendedDual );
+        const glm::vec3 translation = 2.0f * (blendedReal.w * dualVector - blendedDual.w * realVector + glm::cross( realVector, dualVector ));
+        positionOut = RotateVector( blendedReal, glm::vec3( vertex.Position ) ) + translation;
+        normalOut = RotateVector( blendedReal, glm::vec3( vertex.Normal ) );
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+GpuSkinning::~GpuSkinning()
+//-----------------------------------------------------------------------------
+{
+    Release();
+}
+
+//-----------------------------------------------------------------------------
+std::vector<GpuSkinning::SkinVertex> GpuSkinning::MakeSkinVertices( const MeshObjectIntermediate& meshObject )
+//-----------------------------------------------------------------------------
+{
+    const auto& fatVertices = meshObject.m_VertexBuffer;
+    const auto& fatWeights = meshObject.m_WeightBuffer;
+    assert( fatWeights.empty() || fatWeights.size() == fatVertices.size() );
+
+    std::vector<SkinVertex> vertices( fatVertices.size() );
+    for (size_t i = 0; i < fatVertices.size(); ++i)
+    {
+        auto& vertex = vertices[i];
+        vertex.Position = glm::vec4( fatVertices[i].position[0], fatVertices[i].position[1], fatVertices[i].position[2], 1.0f );
+        vertex.Normal = glm::vec4( fatVertices[i].normal[0], fatVertices[i].normal[1], fatVertices[i].normal[2], 0.0f );
+        vertex.Joints = glm::uvec4( 0 );
+        vertex.Weights = glm::vec4( 1.0f, 0.0f, 0.0f, 0.0f );
+        if (fatWeights.empty())
+            continue;
+        // Renormalize (gltf weights should sum to 1, but exporters are not always precise).
+        float totalWeight = 0.0f;
+        for (int influence = 0; influence < 4; ++influence)
+            totalWeight += std::max( fatWeights[i].weight[influence], 0.0f );
+        if (totalWeight <= 0.0f)
+            continue;
+        for (int influence = 0; influence < 4; ++influence)
+        {
+            vertex.Joints[influence] = (uint32_t) std::max( fatWeights[i].joint[influence], 0 );
+            vertex.Weights[influence] = std::max( fatWeights[i].weight[influence], 0.0f ) / totalWeight;
+        }
+    }
+    return vertices;
+}
+
+//-----------------------------------------------------------------------------
+bool GpuSkinning::Init( Vulkan& vulkan, const MaterialManager<Vulkan>& materialManager, const Shader<Vulkan>* pSkinShader, uint32_t numFrameBuffers, std::span<const SkinVertex> vertices, uint32_t numJoints, Mode mode, VkBuffer externalPositions, bool accelerationStructureInput )
+//-----------------------------------------------------------------------------
+{
+    Release();
+    m_pVulkan = &vulkan;
+    m_Mode = mode;
+    m_NumVertices = (uint32_t) vertices.size();
+    m_NumJoints = numJoints;
+    auto& memoryManager = vulkan.GetMemoryManager();
+
+    // Outputs are written by the compute shader (or copied from the cpu fallback) and read as vertex data (and as acceleration structure build input).
+    const BufferUsageFlags outputUsage = BufferUsageFlags::Storage | BufferUsageFlags::Vertex | BufferUsageFlags::TransferDst;
+    m_ExternalPositions = externalPositions != VK_NULL_HANDLE;
+    if (!m_ExternalPositions)
+    {
+        if (!m_SkinnedPositionBuffer.Initialize( &memoryManager, std::max<size_t>( m_NumVertices, 1 ) * sizeof( glm::vec3 ), outputUsage, nullptr ))
+        {
+            LOGE( "GpuSkinning: failed to create skinned position buffer" );
+            return false;
+        }
+        externalPositions = m_SkinnedPositionBuffer.GetVkBuffer();
+    }
+    m_SkinnedPositionsVkBuffer = externalPositions;
+
+    // Acceleration structure build stage is only valid with the extension (and its feature) enabled.
+    m_AccelerationStructureInput = false;
+#if VK_KHR_acceleration_structure
+    if (accelerationStructureInput)
+    {
+        const auto* pAccelerationStructureExt = vulkan.m_DeviceExtensions.GetExtension( VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME );
+        m_AccelerationStructureInput = pAccelerationStructureExt && pAccelerationStructureExt->Status == VulkanExtensionStatus::eLoaded;
+    }
+#endif // VK_KHR_acceleration_structure
+    if (accelerationStructureInput && !m_AccelerationStructureInput)
+        LOGW( "GpuSkinning: acceleration structure input requested but VK_KHR_acceleration_structure is not loaded" );
+    if (!m_SkinnedNormalBuffer.Initialize( &memoryManager, std::max<size_t>( m_NumVertices, 1 ) * sizeof( glm::vec4 ), outputUsage, nullptr ))
+    {
+        LOGE( "GpuSkinning: failed to create skinned normal buffer" );
+        return false;
+    }
+
+    if (pSkinShader)
+    {
+        if (InitCompute( materialManager, *pSkinShader, numFrameBuffers, vertices ))
+            return true;
+        LOGW( "GpuSkinning: compute skinning unavailable, falling back to cpu skinning" );
+        ReleaseCompute();
+    }
+    return InitCpuFallback( numFrameBuffers, vertices );
+}
+
+//-----------------------------------------------------------------------------
+bool GpuSkinning::InitCompute( const MaterialManager<Vulkan>& materialManager, const Shader<Vulkan>& skinShader, uint32_t numFrameBuffers, std::span<const SkinVertex> vertices )
+//-----------------------------------------------------------------------------
+{
+    auto& vulkan = *m_pVulkan;
+
+    // Rest pose never changes, upload it once.
+    if (!m_SourceVertexBuffer.Initialize( &vulkan.GetMemoryManager(), std::max<size_t>( vertices.size_bytes(), sizeof( SkinVertex ) ), BufferUsageFlags::Storage, vertices.empty() ? nullptr : vertices.data() ))
+    {
+        LOGE( "GpuSkinning: failed to create source vertex buffer" );
+        return false;
+    }
+
+    const SkinParams skinParams{ m_NumVertices, m_NumJoints, (uint32_t) m_Mode, 0 };
+    const size_t jointBufferSize = std::max( m_NumJoints, 1u ) * (m_Mode == Mode::LinearBlend ? 3 : 2) * sizeof( glm::vec4 );
+    m_SkinParamsUniforms.resize( numFrameBuffers );
+    m_JointBuffers.resize( numFrameBuffers );
+    std::vector<VkBuffer> skinParamsVkBuffers;
+    std::vector<VkBuffer> jointVkBuffers;
+    for (uint32_t bufferIdx = 0; bufferIdx < numFrameBuffers; ++bufferIdx)
+    {
+        if (!CreateUniformBuffer( &vulkan, &m_SkinParamsUniforms[bufferIdx], sizeof( SkinParams ), &skinParams, BufferUsageFlags::Uniform ))
+            return false;
+        if (!CreateUniformBuffer( &vulkan, &m_JointBuffers[bufferIdx], jointBufferSize, nullptr, BufferUsageFlags::Storage ))
+            return false;
+        skinParamsVkBuffers.push_back( m_SkinParamsUniforms[bufferIdx].buf.GetVkBuffer() );
+        jointVkBuffers.push_back( m_JointBuffers[bufferIdx].buf.GetVkBuffer() );
+    }
+
+    auto material = materialManager.CreateMaterial( skinShader, numFrameBuffers,
+        []( const std::string& textureName ) -> const MaterialManagerBase::tPerFrameTexInfo {
+            assert( 0 );
+            return {};
+        },
+        [this, &skinParamsVkBuffers, &jointVkBuffers]( const std::string& bufferName ) -> PerFrameBuffer<Vulkan> {
+            if (bufferName == "SkinParams")
+                return { skinParamsVkBuffers.begin(), skinParamsVkBuffers.end() };
+            else if (bufferName == "Joints")
+                return { jointVkBuffers.begin(), jointVkBuffers.end() };
+            else if (bufferName == "SourceVertices")
+                return { m_SourceVertexBuffer.GetVkBuffer() };
+            else if (bufferName == "SkinnedPositions")
+                return { m_SkinnedPositionsVkBuffer };
+            else if (bufferName == "SkinnedNormals")
+                return { m_SkinnedNormalBuffer.GetVkBuffer() };
+            assert( 0 );
+            return {};
+        }
+    );
+
+    auto pComputable = std::make_unique<Computable<Vulkan>>( vulkan, std::move( material ) );
+    if (!pComputable->Init())
+    {
+        LOGE( "GpuSkinning: failed to initialize skinning computable" );
+        return false;
+    }
+    pComputable->SetDispatchThreadCount( 0, { std::max( m_NumVertices, 1u ), 1, 1 } );
+    m_SkinComputable = std::move( pComputable );
+    m_CpuFallback = false;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool GpuSkinning::InitCpuFallback( uint32_t numFrameBuffers, std::span<const SkinVertex> vertices )
+//-----------------------------------------------------------------------------
+{
+    // Rest pose stays on the cpu, each frame's skinned vertices go through a host visible buffer (per frame buffer, so we never write
+    // one the gpu may still be copying from) and are copied in to the output buffers by UpdateCommandBuffer.
+    m_CpuSourceVertices.assign( vertices.begin(), vertices.end() );
+    m_CpuPositions.resize( m_NumVertices );
+    m_CpuNormals.resize( m_NumVertices );
+    m_CpuPackedNormals.resize( m_NumVertices );
+    m_CpuPositionBuffers.resize( numFrameBuffers );
+    m_CpuNormalBuffers.resize( numFrameBuffers );
+    for (uint32_t bufferIdx = 0; bufferIdx < numFrameBuffers; ++bufferIdx)
+    {
+        if (!CreateUniformBuffer( m_pVulkan, &m_CpuPositionBuffers[bufferIdx], std::max<size_t>( m_NumVertices, 1 ) * sizeof( glm::vec3 ), nullptr, BufferUsageFlags::TransferSrc ))
+            return false;
+        if (!CreateUniformBuffer( m_pVulkan, &m_CpuNormalBuffers[bufferIdx], std::max<size_t>( m_NumVertices, 1 ) * sizeof( glm::vec4 ), nullptr, BufferUsageFlags::TransferSrc ))
+            return false;
+    }
+    m_CpuFallback = true;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void GpuSkinning::ReleaseCompute()
+//-----------------------------------------------------------------------------
+{
+    m_SkinComputable.reset();
+    for (auto& uniform : m_SkinParamsUniforms)
+        ReleaseUniformBuffer( m_pVulkan, &uniform );
+    m_SkinParamsUniforms.clear();
+    for (auto& jointBuffer : m_JointBuffers)
+        ReleaseUniformBuffer( m_pVulkan, &jointBuffer );
+    m_JointBuffers.clear();
+    m_SourceVertexBuffer.Destroy();
+}
+
+//-----------------------------------------------------------------------------
+void GpuSkinning::Release()
+//-----------------------------------------------------------------------------
+{
+    if (!m_pVulkan)
+        return;
+    ReleaseCompute();
+    for (auto& positionBuffer : m_CpuPositionBuffers)
+        ReleaseUniformBuffer( m_pVulkan, &positionBuffer );
+    m_CpuPositionBuffers.clear();
+    for (auto& normalBuffer : m_CpuNormalBuffers)
+        ReleaseUniformBuffer( m_pVulkan, &normalBuffer );
+    m_CpuNormalBuffers.clear();
+    m_CpuSourceVertices.clear();
+    m_CpuPositions.clear();
+    m_CpuNormals.clear();
+    m_CpuPackedNormals.clear();
+    m_SkinnedPositionBuffer.Destroy();
+    m_SkinnedNormalBuffer.Destroy();
+    m_SkinnedPositionsVkBuffer = VK_NULL_HANDLE;
+    m_ExternalPositions = false;
+    m_AccelerationStructureInput = false;
+    m_CpuFallback = false;
+    m_NumVertices = 0;
+    m_NumJoints = 0;
+    m_pVulkan = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void GpuSkinning::UpdateJoints( uint32_t bufferIdx, std::span<const glm::mat4> skinMatrices, ThreadWorker* pWorker )
+//-----------------------------------------------------------------------------
+{
+    assert( skinMatrices.size() == m_NumJoints );
+    PackJoints( skinMatrices, m_Mode, m_PackedJoints );
+    if (!m_CpuFallback)
+    {
+        if (!m_PackedJoints.empty())
+            UpdateUniformBuffer( m_pVulkan, &m_JointBuffers[bufferIdx], m_PackedJoints.size() * sizeof( glm::vec4 ), m_PackedJoints.data() );
+        return;
+    }
+    if (m_NumVertices == 0)
+        return;
+
+    SkinReference( m_CpuSourceVertices, m_PackedJoints, m_Mode, m_CpuPositions, m_CpuNormals, pWorker );
+    for (uint32_t i = 0; i < m_NumVertices; ++i)
+        m_CpuPackedNormals[i] = glm::vec4( m_CpuNormals[i], 0.0f );
+    UpdateUniformBuffer( m_pVulkan, &m_CpuPositionBuffers[bufferIdx], m_CpuPositions.size() * sizeof( glm::vec3 ), m_CpuPositions.data() );
+    UpdateUniformBuffer( m_pVulkan, &m_CpuNormalBuffers[bufferIdx], m_CpuPackedNormals.size() * sizeof( glm::vec4 ), m_CpuPackedNormals.data() );
+}
+
+//-----------------------------------------------------------------------------
+void GpuSkinning::UpdateCommandBuffer( CommandList<Vulkan>& cmdList, uint32_t bufferIdx )
+//-----------------------------------------------------------------------------
+{
+    VkBufferMemoryBarrier bufferBarriers[2]{};
+    for (auto& bufferBarrier : bufferBarriers)
+    {
+        bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bufferBarrier.offset = 0;
+        bufferBarrier.size = VK_WHOLE_SIZE;
+    }
+    bufferBarriers[0].buffer = m_SkinnedPositionsVkBuffer;
+    bufferBarriers[1].buffer = m_SkinnedNormalBuffer.GetVkBuffer();
+
+    // Output is written by the compute shader, or by a transfer (copy) when skinning on the cpu.
+    const VkPipelineStageFlags writeStage = m_CpuFallback ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    const VkAccessFlags writeAccess = m_CpuFallback ? VK_ACCESS_TRANSFER_WRITE_BIT : VK_ACCESS_SHADER_WRITE_BIT;
+
+    // Previous frame's reads (as vertex data, or acceleration structure build input) must be done before we overwrite the output.
+    VkPipelineStageFlags consumerStages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+#if VK_KHR_acceleration_structure
+    if (m_AccelerationStructureInput)
+        consumerStages |= VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+#endif // VK_KHR_acceleration_structure
+    for (auto& bufferBarrier : bufferBarriers)
+    {
+        bufferBarrier.srcAccessMask = 0;    // write-after-read only needs an execution dependency
+        bufferBarrier.dstAccessMask = writeAccess;
+    }
+    vkCmdPipelineBarrier( cmdList, consumerStages, writeStage, 0, 0, nullptr, 2, bufferBarriers, 0, nullptr );
+
+    if (m_CpuFallback)
+    {
+        // Host writes (UpdateJoints) are made visible by the queue submit, no barrier needed before the copy.
+        if (m_NumVertices > 0)
+        {
+            const VkBufferCopy positionCopy{ 0, 0, m_NumVertices * sizeof( glm::vec3 ) };
+            vkCmdCopyBuffer( cmdList, m_CpuPositionBuffers[bufferIdx].buf.GetVkBuffer(), m_SkinnedPositionsVkBuffer, 1, &positionCopy );
+            const VkBufferCopy normalCopy{ 0, 0, m_NumVertices * sizeof( glm::vec4 ) };
+            vkCmdCopyBuffer( cmdList, m_CpuNormalBuffers[bufferIdx].buf.GetVkBuffer(), m_SkinnedNormalBuffer.GetVkBuffer(), 1, &normalCopy );
+        }
+    }
+    else
+    {
+        m_SkinComputable->Dispatch( cmdList, bufferIdx, false );
+    }
+
+    for (auto& bufferBarrier : bufferBarriers)
+    {
+        bufferBarrier.srcAccessMask = writeAccess;
+        bufferBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+    }
+    vkCmdPipelineBarrier( cmdList, writeStage, consumerStages, 0, 0, nullptr, 2, bufferBarriers, 0, nullptr );
+}
+
+//-----------------------------------------------------------------------------
+void GpuSkinning::PackJoints( std::span<const glm::mat4> skinMatrices, Mode mode, std::vector<glm::vec4>& jointsOut )
+//-----------------------------------------------------------------------------
+{
+    jointsOut.clear();
+    if (mode == Mode::LinearBlend)
+    {
+        // Rows of the affine transform.
+        jointsOut.reserve( skinMatrices.size() * 3 );
+        for (const auto& matrix : skinMatrices)
+        {
+            const glm::mat4 transposed = glm::transpose( matrix );
+            jointsOut.push_back( transposed[0] );
+            jointsOut.push_back( transposed[1] );
+            jointsOut.push_back( transposed[2] );
+        }
+    }
+    else
+    {
+        // Unit dual quaternion (real = rotation, dual = 0.5 * translation * real).  Joint matrices are assumed rigid (any scale is dropped).
+        jointsOut.reserve( skinMatrices.size() * 2 );
+        for (const auto& matrix : skinMatrices)
+        {
+            const glm::mat3 rotationMatrix( glm::normalize( glm::vec3( matrix[0] ) ), glm::normalize( glm::vec3( matrix[1] ) ), glm::normalize( glm::vec3( matrix[2] ) ) );
+            const glm::quat real = glm::normalize( glm::quat_cast( rotationMatrix ) );
+            const glm::vec3 translation( matrix[3] );
+            const glm::quat dual = glm::quat( 0.0f, translation.x, translation.y, translation.z ) * real * 0.5f;
+            jointsOut.push_back( glm::vec4( real.x, real.y, real.z, real.w ) );
+            jointsOut.push_back( glm::vec4( dual.x, dual.y, dual.z, dual.w ) );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void GpuSkinning::SkinReference( std::span<const SkinVertex> vertices, std::span<const glm::vec4> joints, Mode mode, std::span<glm::vec3> positionsOut, std::span<glm::vec3> normalsOut, ThreadWorker* pWorker )
+//-----------------------------------------------------------------------------
+{
+    assert( positionsOut.size() >= vertices.size() && normalsOut.size() >= vertices.size() );
+    auto skinRange = [=]( uint32_t begin, uint32_t end ) {
+        if (mode == Mode::LinearBlend)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+                SkinLinearBlend( vertices[i], joints, positionsOut[i], normalsOut[i] );
+        }
+        else
+        {
+            for (uint32_t i = begin; i < end; ++i)
+                SkinDualQuaternion( vertices[i], joints, positionsOut[i], normalsOut[i] );
+        }
+    };
+    if (pWorker)
+        pWorker->ParallelFor( (uint32_t) vertices.size(), 4096, skinRange );
+    else
+        skinRange( 0, (uint32_t) vertices.size() );
+}
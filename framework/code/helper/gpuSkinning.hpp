@@ -0,0 +1,145 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "system/glm_common.hpp"
+#include <volk/volk.h>
+#include "memory/vulkan/bufferObject.hpp"
+#include "memory/vulkan/uniform.hpp"
+
+// Forward declarations
+class MeshObjectIntermediate;
+class ThreadWorker;
+class Vulkan;
+template<typename T_GFXAPI> class CommandList;
+template<typename T_GFXAPI> class Computable;
+template<typename T_GFXAPI> class MaterialManager;
+template<typename T_GFXAPI> class Shader;
+
+/// @brief Compute shader vertex skinning.
+/// Pre-skins a mesh's vertices once per frame (in to a buffer every render pass then reads as a normal, unskinned, vertex buffer) so
+/// the application's material shaders (including the shadow passes) do not each need to skin.  Skinned positions are tightly packed
+/// vec3s (MeshObjectRT::accelerationStructureVertexFormat), so they can be written straight in to a MeshUpdateRT vertex buffer and
+/// used for ray tracing BLAS updates.
+///
+/// Supports linear blend skinning (joint matrices) and dual quaternion skinning (no candy wrapper artifacts, but rigid joint transforms only).
+/// Linear blend normals are transformed by the inverse transpose of the blended matrix (so non uniform joint scales keep them perpendicular).
+///
+/// The compute shader ships with the framework: framework/shaders/GpuSkinning.comp and GpuSkinning.json (build them in to the sample's
+/// Media/Shaders with add_framework_shaders(GpuSkinning) in its CMakeLists.txt, then load "GpuSkinning.json").  It has a single pass, with a
+/// "WorkGroup" local size, one thread per vertex, and binds:
+///     "SkinParams"        UniformBuffer   GpuSkinning::SkinParams
+///     "SourceVertices"    StorageBuffer   GpuSkinning::SkinVertex[]
+///     "Joints"            StorageBuffer   vec4[], per joint 3 vec4 (matrix rows) for LinearBlend or 2 vec4 (real, dual quaternion, xyzw) for DualQuaternion
+///     "SkinnedPositions"  StorageBuffer   float[] (3 per vertex)
+///     "SkinnedNormals"    StorageBuffer   vec4[] (xyz normal, w 0)
+/// The skinning math must match SkinReference (the cpu reference implementation).
+///
+/// When compute skinning is unavailable (no shader given, or its computable fails to initialize) GpuSkinning falls back to SkinReference:
+/// UpdateJoints skins on the cpu in to per frame host visible buffers and UpdateCommandBuffer copies them to the same output buffers.
+class GpuSkinning
+{
+    GpuSkinning( const GpuSkinning& ) = delete;
+    GpuSkinning& operator=( const GpuSkinning& ) = delete;
+public:
+    enum class Mode : uint32_t {
+        LinearBlend = 0,
+        DualQuaternion = 1,
+    };
+
+    /// Rest pose vertex (std430 layout)
+    struct SkinVertex
+    {
+        glm::vec4   Position;       ///< w unused
+        glm::vec4   Normal;         ///< w unused
+        glm::uvec4  Joints;         ///< indices in to the skin's joints
+        glm::vec4   Weights;        ///< sum to 1
+    };
+    static_assert(sizeof( SkinVertex ) == 64);
+
+    /// Per frame parameters (std140 layout)
+    struct SkinParams
+    {
+        uint32_t    NumVertices;
+        uint32_t    NumJoints;
+        uint32_t    Mode;           ///< GpuSkinning::Mode
+        uint32_t    Pad;
+    };
+
+    GpuSkinning() = default;
+    ~GpuSkinning();
+
+    /// Rest pose vertices from a (skinned) mesh, vertices without weights are bound rigidly to joint 0.
+    static std::vector<SkinVertex> MakeSkinVertices( const MeshObjectIntermediate& meshObject );
+
+    /// @param pSkinShader          skinning compute shader (GpuSkinning.json), nullptr to always skin on the cpu
+    /// @param vertices             rest pose, uploaded once
+    /// @param numJoints            joints in the skin (Skin::GetSkinTransformMatrices().size())
+    /// @param externalPositions    optional buffer to write the skinned positions in to (eg MeshUpdateRT::GetVertexVkBuffer, must have Storage and TransferDst
+    ///                             usage and room for vertices.size() vec3s), if VK_NULL_HANDLE a position buffer is created (see GetSkinnedPositionsVkBuffer)
+    /// @param accelerationStructureInput skinned positions are read by acceleration structure builds (eg MeshUpdateRT), the barriers then include the
+    ///                             acceleration structure build stage (ignored unless VK_KHR_acceleration_structure is loaded)
+    bool Init( Vulkan& vulkan, const MaterialManager<Vulkan>& materialManager, const Shader<Vulkan>* pSkinShader, uint32_t numFrameBuffers, std::span<const SkinVertex> vertices, uint32_t numJoints, Mode mode, VkBuffer externalPositions = VK_NULL_HANDLE, bool accelerationStructureInput = false );
+    void Release();
+
+    /// Update the joints for the given frame buffer.
+    /// @param skinMatrices joint matrices (Skin::GetSkinTransformMatrices)
+    /// @param pWorker      threads for the cpu fallback skinning (ignored when skinning in compute)
+    void UpdateJoints( uint32_t bufferIdx, std::span<const glm::mat4> skinMatrices, ThreadWorker* pWorker = nullptr );
+
+    /// Add the skinning dispatch, or the copy of the cpu skinned vertices when falling back (and barriers so the output can be read as vertex data, and as acceleration structure build input if Init was asked to).
+    /// Call outside of a render pass, once per frame, before any pass that uses the skinned vertices.
+    void UpdateCommandBuffer( CommandList<Vulkan>& cmdList, uint32_t bufferIdx );
+
+    Mode GetMode() const                                { return m_Mode; }
+    bool IsCpuFallback() const                          { return m_CpuFallback; }
+    uint32_t GetNumVertices() const                     { return m_NumVertices; }
+    VkBuffer GetSkinnedPositionsVkBuffer() const        { return m_SkinnedPositionsVkBuffer; }
+    VkBuffer GetSkinnedNormalsVkBuffer() const          { return m_SkinnedNormalBuffer.GetVkBuffer(); }
+
+    /// Pack joint matrices in to the "Joints" buffer layout for the given mode.
+    static void PackJoints( std::span<const glm::mat4> skinMatrices, Mode mode, std::vector<glm::vec4>& jointsOut );
+    /// Cpu reference (SIMD) skinning, matching the compute shader (and used as the fallback when compute skinning is unavailable).  Work is split (by vertex ranges) across pWorker's threads if given.
+    /// @param joints from PackJoints
+    static void SkinReference( std::span<const SkinVertex> vertices, std::span<const glm::vec4> joints, Mode mode, std::span<glm::vec3> positionsOut, std::span<glm::vec3> normalsOut, ThreadWorker* pWorker = nullptr );
+
+protected:
+    bool InitCompute( const MaterialManager<Vulkan>& materialManager, const Shader<Vulkan>& skinShader, uint32_t numFrameBuffers, std::span<const SkinVertex> vertices );
+    bool InitCpuFallback( uint32_t numFrameBuffers, std::span<const SkinVertex> vertices );
+    void ReleaseCompute();
+
+protected:
+    Vulkan*                                 m_pVulkan = nullptr;
+    Mode                                    m_Mode = Mode::LinearBlend;
+    uint32_t                                m_NumVertices = 0;
+    uint32_t                                m_NumJoints = 0;
+    Buffer<Vulkan>                          m_SourceVertexBuffer;
+    Buffer<Vulkan>                          m_SkinnedPositionBuffer;    ///< unused if Init was given externalPositions
+    Buffer<Vulkan>                          m_SkinnedNormalBuffer;
+    VkBuffer                                m_SkinnedPositionsVkBuffer = VK_NULL_HANDLE;
+    bool                                    m_ExternalPositions = false;
+    bool                                    m_AccelerationStructureInput = false;
+    bool                                    m_CpuFallback = false;
+    std::vector<Uniform<Vulkan>>            m_SkinParamsUniforms;       ///< one per frame buffer
+    std::vector<Uniform<Vulkan>>            m_JointBuffers;             ///< one per frame buffer (storage)
+    std::vector<glm::vec4>                  m_PackedJoints;             ///< scratch (for UpdateJoints)
+    std::unique_ptr<Computable<Vulkan>>     m_SkinComputable;
+
+    // Cpu fallback (SkinReference) state, empty when skinning in compute.
+    std::vector<SkinVertex>                 m_CpuSourceVertices;
+    std::vector<glm::vec3>                  m_CpuPositions;             ///< scratch (for UpdateJoints)
+    std::vector<glm::vec3>                  m_CpuNormals;               ///< scratch (for UpdateJoints)
+    std::vector<glm::vec4>                  m_CpuPackedNormals;         ///< scratch, SkinnedNormals layout
+    std::vector<Uniform<Vulkan>>            m_CpuPositionBuffers;       ///< one per frame buffer (host visible copy source)
+    std::vector<Uniform<Vulkan>>            m_CpuNormalBuffers;         ///< one per frame buffer (host visible copy source)
+};
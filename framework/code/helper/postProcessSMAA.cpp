@@ -7,6 +7,7 @@
 //============================================================================================================
 
 #include "postProcessSMAA.hpp"
+#include "camera/temporalContext.hpp"
 #include "imgui/imgui.h"
 #include "material/vulkan/computable.hpp"
 #include "material/vulkan/materialManager.hpp"
@@ -74,7 +75,7 @@ bool PostProcessSMAA::Init(const Shader<Vulkan>& shader, MaterialManager<Vulkan>
     return true;
 }
 
-bool PostProcessSMAA::UpdateUniforms(uint32_t WhichFrame, float ElapsedTime, const glm::mat4& clipToPrevClip)
+bool PostProcessSMAA::UpdateUniforms(uint32_t WhichFrame, float ElapsedTime, const glm::mat4& clipToPrevClip, bool cameraCut)
 {
     m_UniformData = {};
 
@@ -84,7 +85,7 @@ bool PostProcessSMAA::UpdateUniforms(uint32_t WhichFrame, float ElapsedTime, con
     m_UniformData.OutputViewportSize = { m_historyDiffuse[0].Width, m_historyDiffuse[0].Height, 1.0f / m_historyDiffuse[0].Width, 1.0f / m_historyDiffuse[0].Height };
     m_UniformData.HistoryPreExposureCorrection = 1.0f;
     m_UniformData.CurrentFrameWeight = 0.04f; //amount of ghosting vs jitter (0.04 default)
-    m_UniformData.bCameraCut = 0;
+    m_UniformData.bCameraCut = cameraCut ? 1 : 0;
     m_UniformData.PlusWeights[0] = 0.01659f;
     m_UniformData.PlusWeights[1] = 0.12913f;
     m_UniformData.PlusWeights[2] = 0.60175f;
@@ -97,6 +98,11 @@ bool PostProcessSMAA::UpdateUniforms(uint32_t WhichFrame, float ElapsedTime, con
     return true;
 }
 
+bool PostProcessSMAA::UpdateUniforms(uint32_t WhichFrame, float ElapsedTime, const TemporalContext& temporal)
+{
+    return UpdateUniforms(WhichFrame, ElapsedTime, temporal.GetClipToPreviousClip(), !temporal.HasHistory());
+}
+
 void PostProcessSMAA::UpdateGui()
 {
 }
@@ -20,6 +20,7 @@
 template<typename T_GFXAPI> class Computable;
 template<typename T_GFXAPI> class MaterialManager;
 template<typename T_GFXAPI> class Shader;
+class TemporalContext;
 
 
 class PostProcessSMAA : public PostProcess<Vulkan>
@@ -32,7 +33,9 @@ public:
 
     bool Init(const Shader<Vulkan>& shader, MaterialManager<Vulkan>& materialManager, TextureVulkan* diffuseRenderTarget, TextureVulkan* depthRenderTarget);
     bool UpdateUniforms(uint32_t WhichFrame, float ElapsedTime) override { return UpdateUniforms(WhichFrame, ElapsedTime, glm::mat4(1.0f)); }
-    bool UpdateUniforms(uint32_t WhichFrame, float ElapsedTime, const glm::mat4& clipToPrevClip);
+    bool UpdateUniforms(uint32_t WhichFrame, float ElapsedTime, const glm::mat4& clipToPrevClip, bool cameraCut = false);
+    /// Reprojection (clip to previous clip) and camera cut from the camera's temporal context (Camera::Temporal, after Camera::UpdateMatrices).
+    bool UpdateUniforms(uint32_t WhichFrame, float ElapsedTime, const TemporalContext& temporal);
     void UpdateGui() override;
 
     const ComputableBase* const GetComputable() const override;
@@ -0,0 +1,487 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "softwareOcclusion.hpp"
+#include "mesh/meshIntermediate.hpp"
+#include "system/Worker.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <variant>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SOFTWAREOCCLUSION_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFTWAREOCCLUSION_SSE2 1
+#endif
+
+
+//
+// 4 wide float vector (4 horizontally adjacent pixels)
+//
+namespace
+{
+#if defined(SOFTWAREOCCLUSION_NEON)
+    struct Mask4
+    {
+        uint32x4_t v;
+        Mask4 operator&( Mask4 o ) const { return { vandq_u32( v, o.v ) }; }
+        bool Any() const { return vmaxvq_u32( v ) != 0; }
+    };
+    struct Float4
+    {
+        float32x4_t v;
+        static Float4 Set( float s ) { return { vdupq_n_f32( s ) }; }
+        static Float4 Load( const float* p ) { return { vld1q_f32( p ) }; }
+        void Store( float* p ) const { vst1q_f32( p, v ); }
+        Float4 operator+( Float4 o ) const { return { vaddq_f32( v, o.v ) }; }
+        Float4 operator*( Float4 o ) const { return { vmulq_f32( v, o.v ) }; }
+        static Float4 Min( Float4 a, Float4 b ) { return { vminq_f32( a.v, b.v ) }; }
+        static Mask4 GreaterEqual( Float4 a, Float4 b ) { return { vcgeq_f32( a.v, b.v ) }; }
+        /// @return a where mask is set, b otherwise
+        static Float4 Select( Mask4 mask, Float4 a, Float4 b ) { return { vbslq_f32( mask.v, a.v, b.v ) }; }
+    };
+#elif defined(SOFTWAREOCCLUSION_SSE2)
+    struct Mask4
+    {
+        __m128 v;
+        Mask4 operator&( Mask4 o ) const { return { _mm_and_ps( v, o.v ) }; }
+        bool Any() const { return _mm_movemask_ps( v ) != 0; }
+    };
+    struct Float4
+    {
+        __m128 v;
+        static Float4 Set( float s ) { return { _mm_set1_ps( s ) }; }
+        static Float4 Load( const float* p ) { return { _mm_loadu_ps( p ) }; }
+        void Store( float* p ) const { _mm_storeu_ps( p, v ); }
+        Float4 operator+( Float4 o ) const { return { _mm_add_ps( v, o.v ) }; }
+        Float4 operator*( Float4 o ) const { return { _mm_mul_ps( v, o.v ) }; }
+        static Float4 Min( Float4 a, Float4 b ) { return { _mm_min_ps( a.v, b.v ) }; }
+        static Mask4 GreaterEqual( Float4 a, Float4 b ) { return { _mm_cmpge_ps( a.v, b.v ) }; }
+        /// @return a where mask is set, b otherwise
+        static Float4 Select( Mask4 mask, Float4 a, Float4 b ) { return { _mm_or_ps( _mm_and_ps( mask.v, a.v ), _mm_andnot_ps( mask.v, b.v ) ) }; }
+    };
+#else
+    struct Mask4
+    {
+        bool v[4];
+        Mask4 operator&( Mask4 o ) const { return { v[0] && o.v[0], v[1] && o.v[1], v[2] && o.v[2], v[3] && o.v[3] }; }
+        bool Any() const { return v[0] || v[1] || v[2] || v[3]; }
+    };
+    struct Float4
+    {
+        float v[4];
+        static Float4 Set( float s ) { return { s, s, s, s }; }
+        static Float4 Load( const float* p ) { return { p[0], p[1], p[2], p[3] }; }
+        void Store( float* p ) const { p[0] = v[0]; p[1] = v[1]; p[2] = v[2]; p[3] = v[3]; }
+        Float4 operator+( Float4 o ) const { return { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] }; }
+        Float4 operator*( Float4 o ) const { return { v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3] }; }
+        static Float4 Min( Float4 a, Float4 b ) { return { std::min( a.v[0], b.v[0] ), std::min( a.v[1], b.v[1] ), std::min( a.v[2], b.v[2] ), std::min( a.v[3], b.v[3] ) }; }
+        static Mask4 GreaterEqual( Float4 a, Float4 b ) { return { a.v[0] >= b.v[0], a.v[1] >= b.v[1], a.v[2] >= b.v[2], a.v[3] >= b.v[3] }; }
+        /// @return a where mask is set, b otherwise
+        static Float4 Select( Mask4 mask, Float4 a, Float4 b ) { return { mask.v[0] ? a.v[0] : b.v[0], mask.v[1] ? a.v[1] : b.v[1], mask.v[2] ? a.v[2] : b.v[2], mask.v[3] ? a.v[3] : b.v[3] }; }
+    };
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+SoftwareOcclusion::SoftwareOcclusion()
+//-----------------------------------------------------------------------------
+{
+}
+
+//-----------------------------------------------------------------------------
+SoftwareOcclusion::~SoftwareOcclusion()
+//-----------------------------------------------------------------------------
+{
+}
+
+//-----------------------------------------------------------------------------
+bool SoftwareOcclusion::Initialize( uint32_t width, uint32_t height )
+//-----------------------------------------------------------------------------
+{
+    if (width == 0 || height == 0)
+        return false;
+    m_NumTilesX = (width + cTileWidth - 1) / cTileWidth;
+    m_NumTilesY = (height + cTileHeight - 1) / cTileHeight;
+    m_Width = m_NumTilesX * cTileWidth;
+    m_Height = m_NumTilesY * cTileHeight;
+
+    // Hierarchical z levels, down to 1x1.
+    m_HiZLevels.clear();
+    uint32_t levelWidth = m_Width;
+    uint32_t levelHeight = m_Height;
+    for (;;)
+    {
+        auto& level = m_HiZLevels.emplace_back();
+        level.Width = levelWidth;
+        level.Height = levelHeight;
+        level.Depth.assign( size_t( levelWidth ) * levelHeight, 1.0f );
+        if (levelWidth == 1 && levelHeight == 1)
+            break;
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+    m_Chunks.clear();
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool SoftwareOcclusion::IsOccluderCandidate( const MeshObjectIntermediate& meshObject, float minExtent )
+//-----------------------------------------------------------------------------
+{
+    if (meshObject.m_Occluder)
+        return true;
+    if (meshObject.m_VertexBuffer.empty())
+        return false;
+    glm::vec3 boundsMin( FLT_MAX );
+    glm::vec3 boundsMax( -FLT_MAX );
+    for (const auto& vertex : meshObject.m_VertexBuffer)
+    {
+        const glm::vec3 position = glm::vec3( meshObject.m_Transform * glm::vec4( vertex.position[0], vertex.position[1], vertex.position[2], 1.0f ) );
+        boundsMin = glm::min( boundsMin, position );
+        boundsMax = glm::max( boundsMax, position );
+    }
+    const glm::vec3 extent = boundsMax - boundsMin;
+    return std::max( { extent.x, extent.y, extent.z } ) >= minExtent;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t SoftwareOcclusion::AddOccluder( const MeshObjectIntermediate& meshObject )
+//-----------------------------------------------------------------------------
+{
+    std::vector<glm::vec3> positions;
+    positions.reserve( meshObject.m_VertexBuffer.size() );
+    for (const auto& vertex : meshObject.m_VertexBuffer)
+        positions.push_back( glm::vec3( vertex.position[0], vertex.position[1], vertex.position[2] ) );
+
+    std::vector<uint32_t> indices;
+    std::visit( [&]( auto& indexBuffer ) {
+        using T = std::decay_t<decltype( indexBuffer )>;
+        if constexpr (std::is_same_v<T, std::monostate>)
+        {
+            // Every 3 vertices are a triangle
+            indices.resize( positions.size() - positions.size() % 3 );
+            for (uint32_t i = 0; i < (uint32_t) indices.size(); ++i)
+                indices[i] = i;
+        }
+        else
+        {
+            indices.assign( indexBuffer.begin(), indexBuffer.begin() + (indexBuffer.size() - indexBuffer.size() % 3) );
+        }
+    }, meshObject.m_IndexBuffer );
+
+    return AddOccluder( positions, indices );
+}
+
+//-----------------------------------------------------------------------------
+uint32_t SoftwareOcclusion::AddOccluder( std::span<const glm::vec3> positions, std::span<const uint32_t> indices )
+//-----------------------------------------------------------------------------
+{
+    auto& occluder = m_Occluders.emplace_back();
+    occluder.Positions.assign( positions.begin(), positions.end() );
+    // Drop triangles with out of range indices (rather than checking every Render)
+    occluder.Indices.reserve( indices.size() );
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        if (indices[i] < positions.size() && indices[i + 1] < positions.size() && indices[i + 2] < positions.size())
+            occluder.Indices.insert( occluder.Indices.end(), { indices[i], indices[i + 1], indices[i + 2] } );
+    }
+    return (uint32_t) m_Occluders.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+void SoftwareOcclusion::ClearOccluders()
+//-----------------------------------------------------------------------------
+{
+    m_Occluders.clear();
+}
+
+//-----------------------------------------------------------------------------
+void SoftwareOcclusion::Render( const glm::mat4& viewProjection, std::span<const OccluderInstance> instances, ThreadWorker* pWorker )
+//-----------------------------------------------------------------------------
+{
+    if (m_HiZLevels.empty())
+        return;
+    m_ViewProjection = viewProjection;
+    const uint32_t numTiles = m_NumTilesX * m_NumTilesY;
+
+    // Bin.  Instances are split in to contiguous chunks (one per range of work) so tiles see triangles in instance order whatever the thread count.
+    const uint32_t numInstances = (uint32_t) instances.size();
+    const uint32_t numChunks = std::max( 1u, pWorker ? std::min( pWorker->NumThreads() * 4, numInstances ) : 1u );
+    if (m_Chunks.size() < numChunks)
+        m_Chunks.resize( numChunks );
+    for (uint32_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx)
+    {
+        auto& chunk = m_Chunks[chunkIdx];
+        chunk.TileTriangles.resize( numTiles );
+        for (auto& tileTriangles : chunk.TileTriangles)
+            tileTriangles.clear();      // keeps capacity frame to frame
+        chunk.NumBinned = 0;
+    }
+    auto binChunks = [&]( uint32_t begin, uint32_t end ) {
+        for (uint32_t chunkIdx = begin; chunkIdx < end; ++chunkIdx)
+        {
+            const uint32_t firstInstance = uint32_t( uint64_t( numInstances ) * chunkIdx / numChunks );
+            const uint32_t lastInstance = uint32_t( uint64_t( numInstances ) * (chunkIdx + 1) / numChunks );
+            BinInstances( instances.subspan( firstInstance, lastInstance - firstInstance ), m_Chunks[chunkIdx] );
+        }
+    };
+    if (pWorker)
+        pWorker->ParallelFor( numChunks, 1, binChunks );
+    else
+        binChunks( 0, numChunks );
+
+    m_NumBinnedTriangles = 0;
+    for (uint32_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx)
+        m_NumBinnedTriangles += m_Chunks[chunkIdx].NumBinned;
+
+    // Rasterize, each tile is independent.
+    auto rasterizeTiles = [&]( uint32_t begin, uint32_t end ) {
+        for (uint32_t tileIdx = begin; tileIdx < end; ++tileIdx)
+            RasterizeTile( tileIdx, numChunks );
+    };
+    if (pWorker)
+        pWorker->ParallelFor( numTiles, 1, rasterizeTiles );
+    else
+        rasterizeTiles( 0, numTiles );
+
+    BuildHiZ();
+}
+
+//-----------------------------------------------------------------------------
+void SoftwareOcclusion::BinInstances( std::span<const OccluderInstance> instances, Chunk& chunk )
+//-----------------------------------------------------------------------------
+{
+    const float halfWidth = 0.5f * (float) m_Width;
+    const float halfHeight = 0.5f * (float) m_Height;
+
+    for (const auto& instance : instances)
+    {
+        if (instance.OccluderIdx >= m_Occluders.size())
+            continue;
+        const auto& occluder = m_Occluders[instance.OccluderIdx];
+        const glm::mat4 transform = m_ViewProjection * instance.Transform;
+
+        chunk.ClipPositions.resize( occluder.Positions.size() );
+        for (size_t i = 0; i < occluder.Positions.size(); ++i)
+            chunk.ClipPositions[i] = transform * glm::vec4( occluder.Positions[i], 1.0f );
+
+        for (size_t i = 0; i < occluder.Indices.size(); i += 3)
+        {
+            const glm::vec4& c0 = chunk.ClipPositions[occluder.Indices[i]];
+            const glm::vec4& c1 = chunk.ClipPositions[occluder.Indices[i + 1]];
+            const glm::vec4& c2 = chunk.ClipPositions[occluder.Indices[i + 2]];
+
+            // Drop triangles crossing the near plane (no clipping, they just do not occlude) and trivially reject triangles outside a frustum plane.
+            if (c0.z < 0.0f || c1.z < 0.0f || c2.z < 0.0f)
+                continue;
+            if ((c0.x < -c0.w && c1.x < -c1.w && c2.x < -c2.w) || (c0.x > c0.w && c1.x > c1.w && c2.x > c2.w) ||
+                (c0.y < -c0.w && c1.y < -c1.w && c2.y < -c2.w) || (c0.y > c0.w && c1.y > c1.w && c2.y > c2.w) ||
+                (c0.z > c0.w && c1.z > c1.w && c2.z > c2.w))
+                continue;
+
+            Triangle triangle;
+            const glm::vec4* clip[3] = { &c0, &c1, &c2 };
+            for (int v = 0; v < 3; ++v)
+            {
+                const float invW = 1.0f / clip[v]->w;
+                triangle.X[v] = (clip[v]->x * invW + 1.0f) * halfWidth;
+                triangle.Y[v] = (clip[v]->y * invW + 1.0f) * halfHeight;
+                triangle.Z[v] = clip[v]->z * invW;
+            }
+
+            const float minX = std::max( std::min( { triangle.X[0], triangle.X[1], triangle.X[2] } ), 0.0f );
+            const float maxX = std::min( std::max( { triangle.X[0], triangle.X[1], triangle.X[2] } ), (float) m_Width - 1.0f );
+            const float minY = std::max( std::min( { triangle.Y[0], triangle.Y[1], triangle.Y[2] } ), 0.0f );
+            const float maxY = std::min( std::max( { triangle.Y[0], triangle.Y[1], triangle.Y[2] } ), (float) m_Height - 1.0f );
+            if (!(minX <= maxX && minY <= maxY))
+                continue;
+
+            const uint32_t tileX0 = (uint32_t) minX / cTileWidth;
+            const uint32_t tileX1 = (uint32_t) maxX / cTileWidth;
+            const uint32_t tileY0 = (uint32_t) minY / cTileHeight;
+            const uint32_t tileY1 = (uint32_t) maxY / cTileHeight;
+            for (uint32_t tileY = tileY0; tileY <= tileY1; ++tileY)
+                for (uint32_t tileX = tileX0; tileX <= tileX1; ++tileX)
+                    chunk.TileTriangles[tileY * m_NumTilesX + tileX].push_back( triangle );
+            ++chunk.NumBinned;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void SoftwareOcclusion::RasterizeTile( uint32_t tileIdx, uint32_t numChunks )
+//-----------------------------------------------------------------------------
+{
+    const int tileX0 = int( (tileIdx % m_NumTilesX) * cTileWidth );
+    const int tileY0 = int( (tileIdx / m_NumTilesX) * cTileHeight );
+    const int tileX1 = tileX0 + int( cTileWidth ) - 1;
+    const int tileY1 = tileY0 + int( cTileHeight ) - 1;
+    float* const pDepth = m_HiZLevels[0].Depth.data();
+    const size_t stride = m_Width;
+
+    for (int y = tileY0; y <= tileY1; ++y)
+        std::fill_n( pDepth + y * stride + tileX0, cTileWidth, 1.0f );
+
+    static const float cPixelOffsets[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+    const Float4 pixelOffsets = Float4::Load( cPixelOffsets );
+    const Float4 zero = Float4::Set( 0.0f );
+
+    for (uint32_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx)
+    {
+        for (const Triangle& triangle : m_Chunks[chunkIdx].TileTriangles[tileIdx])
+        {
+            const float* x = triangle.X;
+            const float* y = triangle.Y;
+            const float* z = triangle.Z;
+            const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+            if (!(area != 0.0f))
+                continue;
+            // Edge functions (positive inside, for either winding) and depth plane.
+            const float sign = area > 0.0f ? 1.0f : -1.0f;
+            float edgeA[3], edgeB[3], edgeC[3];
+            for (int e = 0; e < 3; ++e)
+            {
+                const int e1 = (e + 1) % 3;
+                edgeA[e] = sign * (y[e] - y[e1]);
+                edgeB[e] = sign * (x[e1] - x[e]);
+                edgeC[e] = sign * (x[e] * y[e1] - x[e1] * y[e]);
+            }
+            const float dzdx = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+            const float dzdy = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+
+            // Pixel bounds within the tile (x aligned to 4 pixels)
+            const int minX = std::max( tileX0, int( std::floor( std::min( { x[0], x[1], x[2] } ) ) ) ) & ~3;
+            const int maxX = std::min( tileX1, int( std::ceil( std::max( { x[0], x[1], x[2] } ) ) ) );
+            const int minY = std::max( tileY0, int( std::floor( std::min( { y[0], y[1], y[2] } ) ) ) );
+            const int maxY = std::min( tileY1, int( std::ceil( std::max( { y[0], y[1], y[2] } ) ) ) );
+
+            const Float4 a0 = Float4::Set( edgeA[0] ), a1 = Float4::Set( edgeA[1] ), a2 = Float4::Set( edgeA[2] );
+            const Float4 depthX = Float4::Set( dzdx );
+            for (int py = minY; py <= maxY; ++py)
+            {
+                const float pixelY = (float) py + 0.5f;
+                const Float4 row0 = Float4::Set( edgeB[0] * pixelY + edgeC[0] );
+                const Float4 row1 = Float4::Set( edgeB[1] * pixelY + edgeC[1] );
+                const Float4 row2 = Float4::Set( edgeB[2] * pixelY + edgeC[2] );
+                const Float4 rowDepth = Float4::Set( z[0] - dzdx * x[0] + dzdy * (pixelY - y[0]) );
+                float* pRow = pDepth + py * stride;
+                for (int px = minX; px <= maxX; px += 4)
+                {
+                    const Float4 pixelX = Float4::Set( (float) px ) + pixelOffsets;
+                    const Mask4 inside = Float4::GreaterEqual( a0 * pixelX + row0, zero ) & Float4::GreaterEqual( a1 * pixelX + row1, zero ) & Float4::GreaterEqual( a2 * pixelX + row2, zero );
+                    if (!inside.Any())
+                        continue;
+                    const Float4 depth = depthX * pixelX + rowDepth;
+                    const Float4 current = Float4::Load( pRow + px );
+                    Float4::Select( inside, Float4::Min( current, depth ), current ).Store( pRow + px );
+                }
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void SoftwareOcclusion::BuildHiZ()
+//-----------------------------------------------------------------------------
+{
+    // Farthest depth of each 2x2 (clamped at odd edges)
+    for (size_t levelIdx = 1; levelIdx < m_HiZLevels.size(); ++levelIdx)
+    {
+        const HiZLevel& src = m_HiZLevels[levelIdx - 1];
+        HiZLevel& dst = m_HiZLevels[levelIdx];
+        for (uint32_t y = 0; y < dst.Height; ++y)
+        {
+            const float* pRow0 = &src.Depth[size_t( y * 2 ) * src.Width];
+            const float* pRow1 = &src.Depth[size_t( std::min( y * 2 + 1, src.Height - 1 ) ) * src.Width];
+            float* pDst = &dst.Depth[size_t( y ) * dst.Width];
+            for (uint32_t x = 0; x < dst.Width; ++x)
+            {
+                const uint32_t x0 = x * 2;
+                const uint32_t x1 = std::min( x0 + 1, src.Width - 1 );
+                pDst[x] = std::max( { pRow0[x0], pRow0[x1], pRow1[x0], pRow1[x1] } );
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool SoftwareOcclusion::IsAabbVisible( const Aabb& aabb ) const
+//-----------------------------------------------------------------------------
+{
+    if (m_HiZLevels.empty())
+        return true;
+
+    // Screen rectangle and nearest depth of the box corners.
+    float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX, minZ = FLT_MAX;
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec4 clip = m_ViewProjection * glm::vec4( (corner & 1) ? aabb.Max.x : aabb.Min.x, (corner & 2) ? aabb.Max.y : aabb.Min.y, (corner & 4) ? aabb.Max.z : aabb.Min.z, 1.0f );
+        if (clip.z < 0.0f || clip.w <= 0.0f)
+            return true;    // crosses the near plane
+        const float invW = 1.0f / clip.w;
+        minX = std::min( minX, clip.x * invW );
+        maxX = std::max( maxX, clip.x * invW );
+        minY = std::min( minY, clip.y * invW );
+        maxY = std::max( maxY, clip.y * invW );
+        minZ = std::min( minZ, clip.z * invW );
+    }
+    // Boxes off screen are left to frustum culling.
+    if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f)
+        return true;
+
+    // Pixels (partially) covered by the box.
+    const int x0 = std::max( 0, int( std::floor( (minX + 1.0f) * 0.5f * (float) m_Width ) ) );
+    const int x1 = std::min( int( m_Width ) - 1, int( std::floor( (maxX + 1.0f) * 0.5f * (float) m_Width ) ) );
+    const int y0 = std::max( 0, int( std::floor( (minY + 1.0f) * 0.5f * (float) m_Height ) ) );
+    const int y1 = std::min( int( m_Height ) - 1, int( std::floor( (maxY + 1.0f) * 0.5f * (float) m_Height ) ) );
+
+    // Smallest level where the box covers at most 2x2 texels.
+    uint32_t levelIdx = 0;
+    while (levelIdx + 1 < m_HiZLevels.size() && ((x1 >> levelIdx) - (x0 >> levelIdx) > 1 || (y1 >> levelIdx) - (y0 >> levelIdx) > 1))
+        ++levelIdx;
+    const HiZLevel& level = m_HiZLevels[levelIdx];
+    for (int y = y0 >> levelIdx; y <= (y1 >> levelIdx); ++y)
+        for (int x = x0 >> levelIdx; x <= (x1 >> levelIdx); ++x)
+            if (level.Depth[size_t( y ) * level.Width + x] >= minZ)
+                return true;
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t SoftwareOcclusion::CullAabbs( std::span<const Aabb> aabbs, std::span<uint32_t> visibleIndicesOut, ThreadWorker* pWorker ) const
+//-----------------------------------------------------------------------------
+{
+    assert( visibleIndicesOut.size() >= aabbs.size() );
+    const uint32_t numAabbs = (uint32_t) aabbs.size();
+    if (!pWorker)
+    {
+        uint32_t numVisible = 0;
+        for (uint32_t i = 0; i < numAabbs; ++i)
+            if (IsAabbVisible( aabbs[i] ))
+                visibleIndicesOut[numVisible++] = i;
+        return numVisible;
+    }
+
+    // Test in parallel, compact in order.
+    std::vector<uint8_t> visible( numAabbs );
+    pWorker->ParallelFor( numAabbs, 256, [&]( uint32_t begin, uint32_t end ) {
+        for (uint32_t i = begin; i < end; ++i)
+            visible[i] = IsAabbVisible( aabbs[i] ) ? 1 : 0;
+    } );
+    uint32_t numVisible = 0;
+    for (uint32_t i = 0; i < numAabbs; ++i)
+        if (visible[i])
+            visibleIndicesOut[numVisible++] = i;
+    return numVisible;
+}
@@ -0,0 +1,126 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "system/glm_common.hpp"
+
+// Forward declarations
+class MeshObjectIntermediate;
+class ThreadWorker;
+
+/// @brief Cpu occlusion culling against a software rasterized depth buffer.
+/// A small set of occluder meshes is rasterized (4 pixels at a time, NEON or SSE2 with a scalar fallback) in to a low resolution depth
+/// buffer (eg 256x128), a hierarchical (farthest depth) z buffer is built from it and instance bounding boxes are tested against that,
+/// all before any command buffers are recorded.  Complements (rather than replaces) the gpu Hi-Z in ZBufferReduce / GpuDrivenCulling.
+///
+/// Occluder triangles are transformed and binned in to screen tiles (split by occluder instance across pWorker's threads) and then
+/// each tile is rasterized independently (split by tile).  Both faces of every triangle are rasterized, so winding does not matter.
+/// Triangles crossing the near plane are dropped (conservative, they only fail to occlude), as are boxes crossing the near plane
+/// (always visible).  Expects zero to one depth (as configured by glm_common.hpp), near depth 0.
+class SoftwareOcclusion
+{
+    SoftwareOcclusion( const SoftwareOcclusion& ) = delete;
+    SoftwareOcclusion& operator=( const SoftwareOcclusion& ) = delete;
+public:
+    static constexpr uint32_t cTileWidth = 32;
+    static constexpr uint32_t cTileHeight = 32;
+
+    /// Occluder mesh (added with AddOccluder) placed in the world.
+    struct OccluderInstance
+    {
+        uint32_t    OccluderIdx;
+        glm::mat4   Transform;      ///< occluder space to world
+    };
+    /// World space axis aligned bounding box.
+    struct Aabb
+    {
+        glm::vec3   Min;
+        glm::vec3   Max;
+    };
+    /// One level of the hierarchical z buffer.  Level 0 is the rasterized depth buffer, each following level is the farthest depth of 2x2 texels of the level above.
+    struct HiZLevel
+    {
+        uint32_t            Width = 0;
+        uint32_t            Height = 0;
+        std::vector<float>  Depth;
+    };
+
+    SoftwareOcclusion();
+    ~SoftwareOcclusion();
+
+    /// @param width, height depth buffer dimensions (rounded up to a multiple of the tile size)
+    bool Initialize( uint32_t width = 256, uint32_t height = 128 );
+
+    /// @return true if the mesh is flagged as an occluder (MeshObjectIntermediate::m_Occluder) or its (transformed) bounds are at least minExtent along any axis.
+    static bool IsOccluderCandidate( const MeshObjectIntermediate& meshObject, float minExtent );
+
+    /// Add an occluder mesh (triangle list).  Positions are in occluder space (MeshObjectIntermediate::m_Transform is not applied, pass it as the OccluderInstance::Transform).
+    /// @return index of the occluder, for OccluderInstance::OccluderIdx
+    uint32_t AddOccluder( const MeshObjectIntermediate& meshObject );
+    uint32_t AddOccluder( std::span<const glm::vec3> positions, std::span<const uint32_t> indices );
+    void ClearOccluders();
+    uint32_t GetNumOccluders() const                            { return (uint32_t) m_Occluders.size(); }
+    size_t GetNumOccluderTriangles( uint32_t occluderIdx ) const { return m_Occluders[occluderIdx].Indices.size() / 3; }
+
+    /// Clear and rasterize the occluder instances, then build the hierarchical z buffer.
+    void Render( const glm::mat4& viewProjection, std::span<const OccluderInstance> instances, ThreadWorker* pWorker = nullptr );
+
+    /// @return false if the box is entirely behind the occluders rendered by the last Render (true if it may be visible).
+    bool IsAabbVisible( const Aabb& aabb ) const;
+    /// Output the indices of the boxes that may be visible (in order).
+    /// @param visibleIndicesOut at least aabbs.size() entries
+    /// @return number of visible boxes
+    uint32_t CullAabbs( std::span<const Aabb> aabbs, std::span<uint32_t> visibleIndicesOut, ThreadWorker* pWorker = nullptr ) const;
+
+    uint32_t GetWidth() const                                   { return m_Width; }
+    uint32_t GetHeight() const                                  { return m_Height; }
+    const auto& GetHiZLevels() const                            { return m_HiZLevels; }
+    /// Rasterized depth (row major, GetWidth() * GetHeight(), cleared to 1.0)
+    std::span<const float> GetDepthBuffer() const               { return m_HiZLevels.empty() ? std::span<const float>() : std::span<const float>( m_HiZLevels[0].Depth ); }
+    /// Number of occluder triangles binned (not rejected) by the last Render
+    uint32_t GetNumBinnedTriangles() const                      { return m_NumBinnedTriangles; }
+
+protected:
+    /// Screen space triangle (pixels, depth)
+    struct Triangle
+    {
+        float X[3];
+        float Y[3];
+        float Z[3];
+    };
+    struct Occluder
+    {
+        std::vector<glm::vec3>  Positions;
+        std::vector<uint32_t>   Indices;
+    };
+    /// Binning output for a contiguous range of occluder instances.
+    struct Chunk
+    {
+        std::vector<std::vector<Triangle>>  TileTriangles;  ///< [tileIdx]
+        std::vector<glm::vec4>              ClipPositions;  ///< scratch
+        uint32_t                            NumBinned = 0;
+    };
+
+    void BinInstances( std::span<const OccluderInstance> instances, Chunk& chunk );
+    void RasterizeTile( uint32_t tileIdx, uint32_t numChunks );
+    void BuildHiZ();
+
+    uint32_t                m_Width = 0;
+    uint32_t                m_Height = 0;
+    uint32_t                m_NumTilesX = 0;
+    uint32_t                m_NumTilesY = 0;
+
+    std::vector<Occluder>   m_Occluders;
+    std::vector<Chunk>      m_Chunks;
+    std::vector<HiZLevel>   m_HiZLevels;
+    glm::mat4               m_ViewProjection = glm::mat4( 1.0f );
+    uint32_t                m_NumBinnedTriangles = 0;
+};
@@ -0,0 +1,417 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "lightClusters.hpp"
+#include "light.hpp"
+#include "lightList.hpp"
+#include "camera/camera.hpp"
+#include "system/Worker.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define LIGHTCLUSTERS_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHTCLUSTERS_SSE2 1
+#endif
+
+
+//
+// 4 wide float vector (one light per lane)
+//
+namespace
+{
+#if defined(LIGHTCLUSTERS_NEON)
+    struct Float4
+    {
+        float32x4_t v;
+        static Float4 Set(float s) { return { vdupq_n_f32(s) }; }
+        static Float4 Load(const float* p) { return { vld1q_f32(p) }; }
+        Float4 operator+(Float4 o) const { return { vaddq_f32(v, o.v) }; }
+        Float4 operator-(Float4 o) const { return { vsubq_f32(v, o.v) }; }
+        Float4 operator*(Float4 o) const { return { vmulq_f32(v, o.v) }; }
+        static Float4 Max(Float4 a, Float4 b) { return { vmaxq_f32(a.v, b.v) }; }
+        static Float4 Sqrt(Float4 a) { return { vsqrtq_f32(a.v) }; }
+        /// @return bit per lane where a <= b
+        static uint32_t LessEqualMask(Float4 a, Float4 b)
+        {
+            static const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+            return vaddvq_u32(vandq_u32(vcleq_f32(a.v, b.v), vld1q_u32(laneBits)));
+        }
+    };
+#elif defined(LIGHTCLUSTERS_SSE2)
+    struct Float4
+    {
+        __m128 v;
+        static Float4 Set(float s) { return { _mm_set1_ps(s) }; }
+        static Float4 Load(const float* p) { return { _mm_loadu_ps(p) }; }
+        Float4 operator+(Float4 o) const { return { _mm_add_ps(v, o.v) }; }
+        Float4 operator-(Float4 o) const { return { _mm_sub_ps(v, o.v) }; }
+        Float4 operator*(Float4 o) const { return { _mm_mul_ps(v, o.v) }; }
+        static Float4 Max(Float4 a, Float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+        static Float4 Sqrt(Float4 a) { return { _mm_sqrt_ps(a.v) }; }
+        /// @return bit per lane where a <= b
+        static uint32_t LessEqualMask(Float4 a, Float4 b) { return (uint32_t)_mm_movemask_ps(_mm_cmple_ps(a.v, b.v)); }
+    };
+#else
+    struct Float4
+    {
+        float v[4];
+        static Float4 Set(float s) { return { s, s, s, s }; }
+        static Float4 Load(const float* p) { return { p[0], p[1], p[2], p[3] }; }
+        Float4 operator+(Float4 o) const { return { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] }; }
+        Float4 operator-(Float4 o) const { return { v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3] }; }
+        Float4 operator*(Float4 o) const { return { v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3] }; }
+        static Float4 Max(Float4 a, Float4 b) { return { std::max(a.v[0], b.v[0]), std::max(a.v[1], b.v[1]), std::max(a.v[2], b.v[2]), std::max(a.v[3], b.v[3]) }; }
+        static Float4 Sqrt(Float4 a) { return { std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3]) }; }
+        /// @return bit per lane where a <= b
+        static uint32_t LessEqualMask(Float4 a, Float4 b) { return (a.v[0] <= b.v[0] ? 1u : 0u) | (a.v[1] <= b.v[1] ? 2u : 0u) | (a.v[2] <= b.v[2] ? 4u : 0u) | (a.v[3] <= b.v[3] ? 8u : 0u); }
+    };
+#endif
+
+    /// Distance from a box to a sphere center, squared (0 if inside)
+    inline float BoxDistanceSq(const glm::vec3& boxMin, const glm::vec3& boxMax, float x, float y, float z)
+    {
+        const float dx = std::max(std::max(boxMin.x - x, x - boxMax.x), 0.0f);
+        const float dy = std::max(std::max(boxMin.y - y, y - boxMax.y), 0.0f);
+        const float dz = std::max(std::max(boxMin.z - z, z - boxMax.z), 0.0f);
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    /// Cone (apex, direction, angle, range) vs sphere test, conservative.
+    inline bool ConeSphereTest(const glm::vec3& apex, const glm::vec3& direction, float cosAngle, float sinAngle, float range, const glm::vec3& center, float radius)
+    {
+        const glm::vec3 v = center - apex;
+        const float lengthSq = v.x * v.x + v.y * v.y + v.z * v.z;
+        const float axisDistance = v.x * direction.x + v.y * direction.y + v.z * direction.z;
+        const float closestDistance = cosAngle * std::sqrt(std::max(lengthSq - axisDistance * axisDistance, 0.0f)) - axisDistance * sinAngle;
+        return closestDistance <= radius && axisDistance <= radius + range && -radius <= axisDistance;
+    }
+}
+
+
+void LightClusters::ViewLights::Clear()
+{
+    for (auto* pArray : { &X, &Y, &Z, &RadiusSq, &ApexX, &ApexY, &ApexZ, &DirX, &DirY, &DirZ, &CosAngle, &SinAngle, &Range, &MinDepth, &MaxDepth })
+        pArray->clear();
+    LightIndex.clear();
+}
+
+void LightClusters::ViewLights::Push(const ViewLights& from, size_t idx)
+{
+    X.push_back(from.X[idx]);
+    Y.push_back(from.Y[idx]);
+    Z.push_back(from.Z[idx]);
+    RadiusSq.push_back(from.RadiusSq[idx]);
+    ApexX.push_back(from.ApexX[idx]);
+    ApexY.push_back(from.ApexY[idx]);
+    ApexZ.push_back(from.ApexZ[idx]);
+    DirX.push_back(from.DirX[idx]);
+    DirY.push_back(from.DirY[idx]);
+    DirZ.push_back(from.DirZ[idx]);
+    CosAngle.push_back(from.CosAngle[idx]);
+    SinAngle.push_back(from.SinAngle[idx]);
+    Range.push_back(from.Range[idx]);
+    LightIndex.push_back(from.LightIndex[idx]);
+    MinDepth.push_back(from.MinDepth[idx]);
+    MaxDepth.push_back(from.MaxDepth[idx]);
+}
+
+void LightClusters::ViewLights::Pad()
+{
+    // Negative radius never passes the sphere test.
+    while (X.size() % 4 != 0)
+    {
+        for (auto* pArray : { &X, &Y, &Z, &ApexX, &ApexY, &ApexZ, &DirX, &DirY, &DirZ, &CosAngle, &SinAngle, &Range })
+            pArray->push_back(0.0f);
+        RadiusSq.push_back(-1.0f);
+        LightIndex.push_back(UINT32_MAX);
+        MinDepth.push_back(FLT_MAX);
+        MaxDepth.push_back(-FLT_MAX);
+    }
+}
+
+
+LightClusters::LightClusters(uint32_t numX, uint32_t numY, uint32_t numZ)
+    : m_NumX(std::max(numX, 1u))
+    , m_NumY(std::max(numY, 1u))
+    , m_NumZ(std::max(numZ, 1u))
+{
+    m_Slices.resize(m_NumZ);
+}
+
+uint32_t LightClusters::GetSlice(float viewDepth) const
+{
+    if (viewDepth <= 0.0f)
+        return 0;
+    const float slice = std::floor(std::log(viewDepth) * m_ClusterParams.SliceScale + m_ClusterParams.SliceBias);
+    return (uint32_t)std::clamp(slice, 0.0f, (float)(m_NumZ - 1));
+}
+
+void LightClusters::Setup(const glm::mat4& viewMatrix, float fov, float aspect, float nearPlane, float farPlane, const LightList& lightList)
+{
+    assert(nearPlane > 0.0f && farPlane > nearPlane);
+    m_TanHalfFovY = std::tan(fov * 0.5f);
+    m_TanHalfFovX = m_TanHalfFovY * aspect;
+
+    // Exponential depth slices (constant cluster aspect ratio).
+    m_SliceDepths.resize(m_NumZ + 1);
+    for (uint32_t z = 0; z <= m_NumZ; ++z)
+        m_SliceDepths[z] = nearPlane * std::pow(farPlane / nearPlane, (float)z / (float)m_NumZ);
+    m_SliceDepths[m_NumZ] = farPlane;
+
+    const float logDepthRange = std::log(farPlane / nearPlane);
+    const auto& pointLights = lightList.GetPointLights();
+    const auto& spotLights = lightList.GetSpotLights();
+    m_ClusterParams.NumX = m_NumX;
+    m_ClusterParams.NumY = m_NumY;
+    m_ClusterParams.NumZ = m_NumZ;
+    m_ClusterParams.NumLights = (uint32_t)(pointLights.size() + spotLights.size());
+    m_ClusterParams.SliceScale = (float)m_NumZ / logDepthRange;
+    m_ClusterParams.SliceBias = -(float)m_NumZ * std::log(nearPlane) / logDepthRange;
+
+    // Lights in to view space.
+    auto pushLight = [](ViewLights& lights, uint32_t lightIndex, const glm::vec3& center, float radius, const glm::vec3& apex, const glm::vec3& direction, float angle, float range)
+    {
+        lights.X.push_back(center.x);
+        lights.Y.push_back(center.y);
+        lights.Z.push_back(center.z);
+        lights.RadiusSq.push_back(radius * radius);
+        lights.ApexX.push_back(apex.x);
+        lights.ApexY.push_back(apex.y);
+        lights.ApexZ.push_back(apex.z);
+        lights.DirX.push_back(direction.x);
+        lights.DirY.push_back(direction.y);
+        lights.DirZ.push_back(direction.z);
+        lights.CosAngle.push_back(std::cos(angle));
+        lights.SinAngle.push_back(std::sin(angle));
+        lights.Range.push_back(range);
+        lights.LightIndex.push_back(lightIndex);
+        lights.MinDepth.push_back(-center.z - radius);
+        lights.MaxDepth.push_back(-center.z + radius);
+    };
+
+    m_PointLights.Clear();
+    for (uint32_t i = 0; i < (uint32_t)pointLights.size(); ++i)
+    {
+        const glm::vec3 center = glm::vec3(viewMatrix * glm::vec4(pointLights[i].GetPosition(), 1.0f));
+        pushLight(m_PointLights, i, center, pointLights[i].GetRange(), center, glm::vec3(0.0f), 0.0f, pointLights[i].GetRange());
+    }
+
+    m_SpotLights.Clear();
+    for (uint32_t i = 0; i < (uint32_t)spotLights.size(); ++i)
+    {
+        const auto& light = spotLights[i];
+        const glm::vec3 apex = glm::vec3(viewMatrix * glm::vec4(light.GetPosition(), 1.0f));
+        glm::vec3 direction = glm::mat3(viewMatrix) * light.GetDirection();
+        const float directionLength = glm::length(direction);
+        direction = directionLength > 0.0f ? direction / directionLength : glm::vec3(0.0f, 0.0f, -1.0f);
+        const float angle = std::clamp(light.GetSpotAngle(), 0.0f, glm::half_pi<float>());
+        const float range = light.GetRange();
+        // Tightest sphere around the cone (and its spherical cap).
+        float radius;
+        glm::vec3 center;
+        if (angle > glm::quarter_pi<float>())
+        {
+            radius = std::sin(angle) * range;
+            center = apex + direction * (std::cos(angle) * range);
+        }
+        else
+        {
+            radius = range / (2.0f * std::cos(angle));
+            center = apex + direction * radius;
+        }
+        pushLight(m_SpotLights, (uint32_t)pointLights.size() + i, center, radius, apex, direction, angle, range);
+    }
+}
+
+void LightClusters::CalcClusterBox(uint32_t x, uint32_t y, uint32_t z, glm::vec3& boxMin, glm::vec3& boxMax) const
+{
+    const float nearDepth = m_SliceDepths[z];
+    const float farDepth = m_SliceDepths[z + 1];
+    // Tile edges in normalized device coordinates (y up, tile row 0 at the top).
+    const float left = -1.0f + 2.0f * (float)x / (float)m_NumX;
+    const float right = -1.0f + 2.0f * (float)(x + 1) / (float)m_NumX;
+    const float top = 1.0f - 2.0f * (float)y / (float)m_NumY;
+    const float bottom = 1.0f - 2.0f * (float)(y + 1) / (float)m_NumY;
+    boxMin.x = std::min(left * nearDepth, left * farDepth) * m_TanHalfFovX;
+    boxMax.x = std::max(right * nearDepth, right * farDepth) * m_TanHalfFovX;
+    boxMin.y = std::min(bottom * nearDepth, bottom * farDepth) * m_TanHalfFovY;
+    boxMax.y = std::max(top * nearDepth, top * farDepth) * m_TanHalfFovY;
+    boxMin.z = -farDepth;
+    boxMax.z = -nearDepth;
+}
+
+void LightClusters::BinSlice(uint32_t z)
+{
+    auto& slice = m_Slices[z];
+    const float nearDepth = m_SliceDepths[z];
+    const float farDepth = m_SliceDepths[z + 1];
+
+    // Candidate lights (those overlapping this slice's depth range).
+    auto gatherCandidates = [nearDepth, farDepth](const ViewLights& lights, ViewLights& candidates)
+    {
+        candidates.Clear();
+        for (size_t i = 0; i < lights.LightIndex.size(); ++i)
+            if (lights.MaxDepth[i] >= nearDepth && lights.MinDepth[i] <= farDepth)
+                candidates.Push(lights, i);
+        candidates.Pad();
+    };
+    gatherCandidates(m_PointLights, slice.PointLights);
+    gatherCandidates(m_SpotLights, slice.SpotLights);
+
+    slice.Counts.assign(m_NumX * m_NumY, 0);
+    slice.LightIndices.clear();
+
+    auto sphereTest = [](const ViewLights& lights, size_t i, Float4 boxMinX, Float4 boxMinY, Float4 boxMinZ, Float4 boxMaxX, Float4 boxMaxY, Float4 boxMaxZ) -> uint32_t
+    {
+        const Float4 zero = Float4::Set(0.0f);
+        const Float4 x = Float4::Load(&lights.X[i]);
+        const Float4 y = Float4::Load(&lights.Y[i]);
+        const Float4 z = Float4::Load(&lights.Z[i]);
+        const Float4 dx = Float4::Max(Float4::Max(boxMinX - x, x - boxMaxX), zero);
+        const Float4 dy = Float4::Max(Float4::Max(boxMinY - y, y - boxMaxY), zero);
+        const Float4 dz = Float4::Max(Float4::Max(boxMinZ - z, z - boxMaxZ), zero);
+        return Float4::LessEqualMask(dx * dx + dy * dy + dz * dz, Float4::Load(&lights.RadiusSq[i]));
+    };
+
+    for (uint32_t y = 0; y < m_NumY; ++y)
+    {
+        for (uint32_t x = 0; x < m_NumX; ++x)
+        {
+            glm::vec3 boxMin, boxMax;
+            CalcClusterBox(x, y, z, boxMin, boxMax);
+            const Float4 boxMinX = Float4::Set(boxMin.x), boxMinY = Float4::Set(boxMin.y), boxMinZ = Float4::Set(boxMin.z);
+            const Float4 boxMaxX = Float4::Set(boxMax.x), boxMaxY = Float4::Set(boxMax.y), boxMaxZ = Float4::Set(boxMax.z);
+            const size_t firstIndex = slice.LightIndices.size();
+
+            // Point lights, bounding sphere vs cluster box.
+            const auto& pointLights = slice.PointLights;
+            for (size_t i = 0; i < pointLights.LightIndex.size(); i += 4)
+            {
+                uint32_t mask = sphereTest(pointLights, i, boxMinX, boxMinY, boxMinZ, boxMaxX, boxMaxY, boxMaxZ);
+                for (; mask != 0; mask &= mask - 1)
+                    slice.LightIndices.push_back(pointLights.LightIndex[i + std::countr_zero(mask)]);
+            }
+
+            // Spot lights, bounding sphere vs cluster box then cone vs cluster bounding sphere.
+            const glm::vec3 boxCenter = (boxMin + boxMax) * 0.5f;
+            const Float4 centerX = Float4::Set(boxCenter.x), centerY = Float4::Set(boxCenter.y), centerZ = Float4::Set(boxCenter.z);
+            const Float4 radius = Float4::Set(glm::length(boxMax - boxMin) * 0.5f);
+            const Float4 negativeRadius = Float4::Set(-glm::length(boxMax - boxMin) * 0.5f);
+            const auto& spotLights = slice.SpotLights;
+            for (size_t i = 0; i < spotLights.LightIndex.size(); i += 4)
+            {
+                uint32_t mask = sphereTest(spotLights, i, boxMinX, boxMinY, boxMinZ, boxMaxX, boxMaxY, boxMaxZ);
+                if (mask == 0)
+                    continue;
+                const Float4 vx = centerX - Float4::Load(&spotLights.ApexX[i]);
+                const Float4 vy = centerY - Float4::Load(&spotLights.ApexY[i]);
+                const Float4 vz = centerZ - Float4::Load(&spotLights.ApexZ[i]);
+                const Float4 lengthSq = vx * vx + vy * vy + vz * vz;
+                const Float4 axisDistance = vx * Float4::Load(&spotLights.DirX[i]) + vy * Float4::Load(&spotLights.DirY[i]) + vz * Float4::Load(&spotLights.DirZ[i]);
+                const Float4 closestDistance = Float4::Load(&spotLights.CosAngle[i]) * Float4::Sqrt(Float4::Max(lengthSq - axisDistance * axisDistance, Float4::Set(0.0f))) - axisDistance * Float4::Load(&spotLights.SinAngle[i]);
+                mask &= Float4::LessEqualMask(closestDistance, radius);
+                mask &= Float4::LessEqualMask(axisDistance, radius + Float4::Load(&spotLights.Range[i]));
+                mask &= Float4::LessEqualMask(negativeRadius, axisDistance);
+                for (; mask != 0; mask &= mask - 1)
+                    slice.LightIndices.push_back(spotLights.LightIndex[i + std::countr_zero(mask)]);
+            }
+
+            slice.Counts[x + y * m_NumX] = (uint32_t)(slice.LightIndices.size() - firstIndex);
+        }
+    }
+}
+
+void LightClusters::Gather()
+{
+    size_t totalIndices = 0;
+    for (const auto& slice : m_Slices)
+        totalIndices += slice.LightIndices.size();
+    m_LightIndices.clear();
+    m_LightIndices.reserve(totalIndices);
+    m_Clusters.resize(m_NumX * m_NumY * m_NumZ);
+
+    // Slices are contiguous in the cluster grid (z is the outer index).
+    uint32_t clusterIdx = 0;
+    for (const auto& slice : m_Slices)
+    {
+        uint32_t offset = (uint32_t)m_LightIndices.size();
+        for (uint32_t count : slice.Counts)
+        {
+            m_Clusters[clusterIdx++] = { offset, count };
+            offset += count;
+        }
+        m_LightIndices.insert(m_LightIndices.end(), slice.LightIndices.begin(), slice.LightIndices.end());
+    }
+}
+
+void LightClusters::Build(const Camera& camera, const LightList& lightList, ThreadWorker* pWorker)
+{
+    Build(camera.ViewMatrix(), camera.Fov(), camera.Aspect(), camera.NearClip(), camera.FarClip(), lightList, pWorker);
+}
+
+void LightClusters::Build(const glm::mat4& viewMatrix, float fov, float aspect, float nearPlane, float farPlane, const LightList& lightList, ThreadWorker* pWorker)
+{
+    Setup(viewMatrix, fov, aspect, nearPlane, farPlane, lightList);
+    if (pWorker)
+    {
+        pWorker->ParallelFor(m_NumZ, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t z = begin; z < end; ++z)
+                BinSlice(z);
+        });
+    }
+    else
+    {
+        for (uint32_t z = 0; z < m_NumZ; ++z)
+            BinSlice(z);
+    }
+    Gather();
+}
+
+void LightClusters::BuildReference(const glm::mat4& viewMatrix, float fov, float aspect, float nearPlane, float farPlane, const LightList& lightList)
+{
+    Setup(viewMatrix, fov, aspect, nearPlane, farPlane, lightList);
+    for (uint32_t z = 0; z < m_NumZ; ++z)
+    {
+        auto& slice = m_Slices[z];
+        slice.Counts.assign(m_NumX * m_NumY, 0);
+        slice.LightIndices.clear();
+        for (uint32_t y = 0; y < m_NumY; ++y)
+        {
+            for (uint32_t x = 0; x < m_NumX; ++x)
+            {
+                glm::vec3 boxMin, boxMax;
+                CalcClusterBox(x, y, z, boxMin, boxMax);
+                const size_t firstIndex = slice.LightIndices.size();
+                for (size_t i = 0; i < m_PointLights.LightIndex.size(); ++i)
+                    if (BoxDistanceSq(boxMin, boxMax, m_PointLights.X[i], m_PointLights.Y[i], m_PointLights.Z[i]) <= m_PointLights.RadiusSq[i])
+                        slice.LightIndices.push_back(m_PointLights.LightIndex[i]);
+
+                const glm::vec3 boxCenter = (boxMin + boxMax) * 0.5f;
+                const float boxRadius = glm::length(boxMax - boxMin) * 0.5f;
+                for (size_t i = 0; i < m_SpotLights.LightIndex.size(); ++i)
+                {
+                    if (BoxDistanceSq(boxMin, boxMax, m_SpotLights.X[i], m_SpotLights.Y[i], m_SpotLights.Z[i]) > m_SpotLights.RadiusSq[i])
+                        continue;
+                    const glm::vec3 apex(m_SpotLights.ApexX[i], m_SpotLights.ApexY[i], m_SpotLights.ApexZ[i]);
+                    const glm::vec3 direction(m_SpotLights.DirX[i], m_SpotLights.DirY[i], m_SpotLights.DirZ[i]);
+                    if (ConeSphereTest(apex, direction, m_SpotLights.CosAngle[i], m_SpotLights.SinAngle[i], m_SpotLights.Range[i], boxCenter, boxRadius))
+                        slice.LightIndices.push_back(m_SpotLights.LightIndex[i]);
+                }
+                slice.Counts[x + y * m_NumX] = (uint32_t)(slice.LightIndices.size() - firstIndex);
+            }
+        }
+    }
+    Gather();
+}
@@ -0,0 +1,118 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "system/glm_common.hpp"
+
+// Forward declarations
+class Camera;
+class LightList;
+class ThreadWorker;
+
+/// @brief Clustered (froxel) light binning on the cpu.
+/// @ingroup Light
+/// Bins the point and spot lights of a LightList in to a grid of view frustum clusters (NumX x NumY screen tiles, NumZ exponentially
+/// spaced depth slices) and outputs compact per cluster light index lists ready for upload to the gpu.
+/// Lights are tested 4 at a time (SIMD sphere vs cluster box, and cone vs cluster bounding sphere for spot lights) and the depth
+/// slices are binned in parallel when given a ThreadWorker.  Can be used instead of gpu light culling, or to validate it.
+///
+/// Light indices are point lights (0 to NumPointLights-1) followed by spot lights (NumPointLights onwards).
+/// Cluster x runs left to right, y top to bottom (framebuffer order) and z near to far,
+/// cluster index = x + (y + z * NumY) * NumX.
+class LightClusters
+{
+    LightClusters(const LightClusters&) = delete;
+    LightClusters& operator=(const LightClusters&) = delete;
+public:
+    /// Location of a cluster's lights in the light index list (std430 uvec2)
+    struct Cluster
+    {
+        uint32_t Offset;
+        uint32_t Count;
+    };
+
+    /// Grid parameters for the shader (std140)
+    struct ClusterParams
+    {
+        uint32_t NumX;
+        uint32_t NumY;
+        uint32_t NumZ;
+        uint32_t NumLights;
+        float    SliceScale;    ///< z slice = floor(log(view depth) * SliceScale + SliceBias)
+        float    SliceBias;
+        float    Pad[2];
+    };
+
+    LightClusters(uint32_t numX = 16, uint32_t numY = 9, uint32_t numZ = 24);
+
+    /// Bin the lights for the camera's current view (Camera::UpdateMatrices must have been called).
+    void Build(const Camera& camera, const LightList& lightList, ThreadWorker* pWorker = nullptr);
+    /// Bin the lights for a perspective view.
+    /// @param fov vertical field of view (radians)
+    void Build(const glm::mat4& viewMatrix, float fov, float aspect, float nearPlane, float farPlane, const LightList& lightList, ThreadWorker* pWorker = nullptr);
+    /// Scalar brute force binning (every light against every cluster) with the same tests as Build, for validation.
+    void BuildReference(const glm::mat4& viewMatrix, float fov, float aspect, float nearPlane, float farPlane, const LightList& lightList);
+
+    uint32_t GetNumX() const                            { return m_NumX; }
+    uint32_t GetNumY() const                            { return m_NumY; }
+    uint32_t GetNumZ() const                            { return m_NumZ; }
+    uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z) const { return x + (y + z * m_NumY) * m_NumX; }
+    /// @return depth slice containing the given (positive) view space depth, clamped to the grid
+    uint32_t GetSlice(float viewDepth) const;
+    const ClusterParams& GetClusterParams() const       { return m_ClusterParams; }
+
+    /// Per cluster light list location (NumX * NumY * NumZ entries)
+    const std::vector<Cluster>& GetClusters() const     { return m_Clusters; }
+    /// Light indices of all the clusters, packed
+    const std::vector<uint32_t>& GetLightIndices() const { return m_LightIndices; }
+
+protected:
+    /// View space light bounds, structure of arrays (padded to a multiple of 4 with lights that never pass)
+    struct ViewLights
+    {
+        std::vector<float>      X, Y, Z, RadiusSq;          ///< bounding sphere
+        std::vector<float>      ApexX, ApexY, ApexZ;        ///< [spot] cone apex
+        std::vector<float>      DirX, DirY, DirZ;           ///< [spot] cone direction
+        std::vector<float>      CosAngle, SinAngle, Range;  ///< [spot]
+        std::vector<uint32_t>   LightIndex;
+        std::vector<float>      MinDepth, MaxDepth;         ///< view depth range of the bounding sphere
+        void Clear();
+        void Push(const ViewLights& from, size_t idx);
+        void Pad();
+    };
+    /// Per depth slice binning output (and candidate lights)
+    struct Slice
+    {
+        ViewLights              PointLights;
+        ViewLights              SpotLights;
+        std::vector<uint32_t>   Counts;                     ///< [NumX * NumY]
+        std::vector<uint32_t>   LightIndices;
+    };
+    void Setup(const glm::mat4& viewMatrix, float fov, float aspect, float nearPlane, float farPlane, const LightList& lightList);
+    void BinSlice(uint32_t z);
+    /// Bounds of a cluster's box (view space)
+    void CalcClusterBox(uint32_t x, uint32_t y, uint32_t z, glm::vec3& boxMin, glm::vec3& boxMax) const;
+    /// Concatenate the slice outputs in to m_Clusters and m_LightIndices
+    void Gather();
+
+    uint32_t                m_NumX;
+    uint32_t                m_NumY;
+    uint32_t                m_NumZ;
+    float                   m_TanHalfFovX = 1.0f;
+    float                   m_TanHalfFovY = 1.0f;
+    std::vector<float>      m_SliceDepths;                  ///< [NumZ + 1] view depth of each slice boundary
+    ClusterParams           m_ClusterParams{};
+    ViewLights              m_PointLights;                  ///< all point lights, view space
+    ViewLights              m_SpotLights;                   ///< all spot lights, view space
+    std::vector<Slice>      m_Slices;
+    std::vector<Cluster>    m_Clusters;
+    std::vector<uint32_t>   m_LightIndices;
+};
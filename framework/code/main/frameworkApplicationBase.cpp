@@ -11,6 +11,7 @@
 #include "gui/gui.hpp"
 #include "graphicsApi/graphicsApiBase.hpp"
 #include "system/os_common.h"
+#include "system/profile.h"
 
 // Bring in the timestamp (and assign to a variable)
 //#include "../../project/buildtimestamp.h"
@@ -49,6 +50,11 @@ VAR(char*,    gHLMDumpFile, "output", kVariableNonpersistent);
 
 VAR(bool,     gFifoPresentMode, false, kVariableNonpersistent); // enable to use FIFO present mode (locks app to refresh rate)
 
+VAR(uint32_t, gAssetCacheBudgetMB, 0, kVariableNonpersistent); // size of the in-memory AssetCache (0, the default, disables caching of loaded files)
+
+VAR(bool,     gCpuTrace, false, kVariableNonpersistent);                // record PROFILE_* scopes (non Android builds) and write them out on exit
+VAR(char*,    gCpuTraceFile, "cputrace.json", kVariableNonpersistent);  // trace file written when gCpuTrace is enabled (Perfetto protobuf if it ends .pftrace, Chrome json otherwise)
+
 
 //#########################################################
 // Config options - End
@@ -128,6 +134,18 @@ bool FrameworkApplicationBase::LoadConfigFile()
 bool FrameworkApplicationBase::Initialize(uintptr_t windowHandle, uintptr_t instanceHandle)
 //-----------------------------------------------------------------------------
 {
+    PROFILE_INITIALIZE();
+#if defined(SYS_PROFILE_CPUTRACE)
+    CpuTrace::SetEnabled(gCpuTrace);
+    PROFILE_THREAD_NAME(GROUP_VKFRAMEWORK, 0, "Main");
+#endif
+
+    // Cache budget comes from the config file, so create the cache here rather than in the constructor.
+    if (gAssetCacheBudgetMB > 0)
+    {
+        m_AssetCache = std::make_unique<AssetCache>(*m_AssetManager, size_t(gAssetCacheBudgetMB) * 1024 * 1024);
+        m_AssetManager->SetAssetCache(m_AssetCache.get());
+    }
     return true;
 }
 
@@ -150,6 +168,23 @@ bool FrameworkApplicationBase::ReInitialize(uintptr_t windowHandle, uintptr_t in
 void FrameworkApplicationBase::Destroy()
 //-----------------------------------------------------------------------------
 {
+    if (m_AssetCache)
+    {
+        const auto stats = m_AssetCache->GetStats();
+        LOGI("AssetCache: %llu hits, %llu misses (%.1f%% hit rate), %llu deduplicated, %llu evictions", (unsigned long long)stats.Hits, (unsigned long long)stats.Misses, stats.HitRate() * 100.0f, (unsigned long long)stats.DedupedLoads, (unsigned long long)stats.Evictions);
+        m_AssetManager->SetAssetCache(nullptr);
+        m_AssetCache.reset();
+    }
+
+#if defined(SYS_PROFILE_CPUTRACE)
+    if (CpuTrace::IsEnabled())
+    {
+        CpuTrace::SetEnabled(false);
+        if (CpuTrace::WriteTrace(gCpuTraceFile))
+            LOGI("CpuTrace: wrote %llu events to %s", (unsigned long long)CpuTrace::GetTotalEventCount(), gCpuTraceFile);
+    }
+#endif
+    PROFILE_SHUTDOWN();
 }
 
 //-----------------------------------------------------------------------------
@@ -221,7 +256,12 @@ bool FrameworkApplicationBase::Render()
     //
     // Call in to the derived application class
     //
-    Render(fltDiffTime);
+    PROFILE_TICK();
+    {
+        PROFILE_SCOPE(GROUP_VKFRAMEWORK, 0, "Render");
+        Render(fltDiffTime);
+        PROFILE_SCOPE_END();
+    }
 
     //
     // Gather post render timing statistics
@@ -143,6 +143,7 @@ protected:
     std::unique_ptr<GraphicsApiBase> m_gfxBase;
     std::unique_ptr<Gui>    m_Gui;
     std::unique_ptr<AssetManager> m_AssetManager;
+    std::unique_ptr<AssetCache> m_AssetCache;      ///< (optional) cache of loaded file data, attached to m_AssetManager
     std::string             m_ConfigFilename;
 
     uint32_t                m_WindowWidth = 0;              ///< Window width in pixels.  MAY not be the resolution of the render buffer or the rendering/backbuffer surface.  In an Android app MAY not be the full screeen device size.  DOES match the mouse/touch co-oordinates (mouse 0,0 is the edge of this window area)
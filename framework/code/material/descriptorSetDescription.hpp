@@ -81,4 +81,5 @@ public:
     std::string                         m_name;
     uint32_t                            m_setIndex = 0;         ///< numbered from 0 (0 is the root descriptor on DX12)
     std::vector<DescriptorTypeAndCount> m_descriptorTypes;
+    bool                                m_bindless = false;     ///< set is the (global) bindless descriptor heap (m_descriptorTypes is empty), see BindlessDescriptorHeap
 };
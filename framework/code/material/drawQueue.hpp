@@ -0,0 +1,251 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+/// @file drawQueue.hpp
+/// Graphics api agnostic draw sorting (DrawQueue) and redundant bind elimination (DrawStateCache).
+/// Neither makes any graphics api calls, state is identified by (short lists of) opaque 64bit handles.
+/// @ingroup Material
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+/// Exact identity of one piece of bound state, as a short list of opaque handles (eg a VkBuffer and its offset cast to uint64_t).
+/// Compared handle by handle (never hashed down) so different state can not be mistaken for the state already bound.
+/// Empty is 'nothing bound'.
+struct DrawStateHandles
+{
+    static constexpr uint32_t cMaxHandles = 8;
+
+    DrawStateHandles() = default;
+    DrawStateHandles( std::initializer_list<uint64_t> handles )
+    {
+        for (uint64_t handle : handles)
+            Push( handle );
+    }
+
+    /// Append a handle.  If there is no room the state is flagged as Overflowed (and DrawStateCache will always bind it).
+    void Push( uint64_t handle )
+    {
+        if (Count < cMaxHandles)
+            Handles[Count++] = handle;
+        else
+            Overflowed = true;
+    }
+    bool empty() const                              { return Count == 0 && !Overflowed; }
+    bool operator==( const DrawStateHandles& ) const = default;
+
+    /// For unordered containers (equality is still exact)
+    struct Hash
+    {
+        size_t operator()( const DrawStateHandles& state ) const
+        {
+            uint64_t hash = state.Overflowed ? 1 : 0;
+            for (uint32_t i = 0; i < state.Count; ++i)
+                hash = (hash ^ state.Handles[i]) * 0x100000001b3ull;
+            return size_t( hash ^ (hash >> 32) );
+        }
+    };
+
+    std::array<uint64_t, cMaxHandles> Handles = {};    ///< unused entries are zero
+    uint32_t                          Count = 0;
+    bool                              Overflowed = false;
+};
+
+
+/// State bound by a draw.
+struct DrawState
+{
+    DrawStateHandles Pipeline;
+    DrawStateHandles DescriptorSet;     ///< descriptor set(s) and the layout (and set index) they are bound with
+    DrawStateHandles VertexBuffers;     ///< (buffer, offset) pair for each vertex buffer binding
+    DrawStateHandles IndexBuffer;       ///< index buffer and index type
+};
+
+
+/// Tracks the state bound to a command buffer and reports which binds are redundant.
+/// Reset whenever the command buffer state becomes undefined (eg start of a command buffer).
+class DrawStateCache
+{
+public:
+    struct BindCounter
+    {
+        uint32_t Bound = 0;
+        uint32_t Skipped = 0;
+    };
+    struct Stats
+    {
+        BindCounter Pipeline;
+        BindCounter DescriptorSet;
+        BindCounter VertexBuffers;
+        BindCounter IndexBuffer;
+        uint32_t    Draws = 0;
+        uint32_t BindsAvoided() const   { return Pipeline.Skipped + DescriptorSet.Skipped + VertexBuffers.Skipped + IndexBuffer.Skipped; }
+        uint32_t BindsIssued() const    { return Pipeline.Bound + DescriptorSet.Bound + VertexBuffers.Bound + IndexBuffer.Bound; }
+        Stats& operator+=( const Stats& other )
+        {
+            for (auto [pDst, pSrc] : { std::pair{ &Pipeline, &other.Pipeline }, { &DescriptorSet, &other.DescriptorSet }, { &VertexBuffers, &other.VertexBuffers }, { &IndexBuffer, &other.IndexBuffer } })
+            {
+                pDst->Bound += pSrc->Bound;
+                pDst->Skipped += pSrc->Skipped;
+            }
+            Draws += other.Draws;
+            return *this;
+        }
+    };
+
+    /// Forget the bound state (stats are kept)
+    void Reset()                                    { m_Bound = {}; m_Valid = {}; }
+    void ResetStats()                               { m_Stats = {}; }
+
+    /// @return true if the pipeline needs binding (differs from the currently bound pipeline)
+    bool BindPipeline( const DrawStateHandles& pipeline )           { return Bind( 0, pipeline, m_Stats.Pipeline ); }
+    /// @return true if the descriptor set needs binding
+    bool BindDescriptorSet( const DrawStateHandles& descriptorSet ) { return Bind( 1, descriptorSet, m_Stats.DescriptorSet ); }
+    /// @return true if the vertex buffers need binding
+    bool BindVertexBuffers( const DrawStateHandles& vertexBuffers ) { return Bind( 2, vertexBuffers, m_Stats.VertexBuffers ); }
+    /// @return true if the index buffer needs binding
+    bool BindIndexBuffer( const DrawStateHandles& indexBuffer )     { return Bind( 3, indexBuffer, m_Stats.IndexBuffer ); }
+    void CountDraw()                                { ++m_Stats.Draws; }
+
+    const Stats& GetStats() const                   { return m_Stats; }
+
+private:
+    bool Bind( int slot, const DrawStateHandles& value, BindCounter& counter )
+    {
+        if (m_Valid[slot] && !value.Overflowed && m_Bound[slot] == value)
+        {
+            ++counter.Skipped;
+            return false;
+        }
+        m_Valid[slot] = !value.Overflowed;
+        m_Bound[slot] = value;
+        ++counter.Bound;
+        return true;
+    }
+
+    std::array<DrawStateHandles, 4> m_Bound = {};
+    std::array<bool, 4>             m_Valid = {};
+    Stats                           m_Stats;
+};
+
+
+/// Order draws are issued in by a DrawQueue
+enum class DrawSortMode
+{
+    StateThenDepth, ///< group by pipeline, descriptor set and vertex buffers, then front to back (opaque geometry)
+    BackToFront,    ///< farthest first, then by state (blended geometry)
+};
+
+
+/// Gathers draws (any payload) and sorts them by a 64bit key built from their DrawState and depth.
+///
+/// Key layout (most significant first):
+///   StateThenDepth: pipeline (16 bits), descriptor set (16), vertex buffers (12), depth (20)
+///   BackToFront:    inverted depth (24 bits), pipeline (16), descriptor set (16), vertex buffers (8)
+/// States are mapped to small dense ids (in first seen order, kept across frames, compared exactly) so draws with the same state sort together.
+template<typename T_PAYLOAD>
+class DrawQueue
+{
+public:
+    struct Item
+    {
+        DrawState   State;
+        T_PAYLOAD   Payload;
+    };
+
+    explicit DrawQueue( DrawSortMode mode = DrawSortMode::StateThenDepth ) noexcept : m_Mode( mode ) {}
+
+    /// Add a draw.
+    /// @param depth normalized (0 = near plane, 1 = far plane) distance, clamped
+    void Add( const DrawState& state, float depth, T_PAYLOAD payload )
+    {
+        const uint64_t pipelineId = GetId( m_PipelineIds, state.Pipeline );
+        const uint64_t descriptorSetId = GetId( m_DescriptorSetIds, state.DescriptorSet );
+        const uint64_t vertexBuffersId = GetId( m_VertexBufferIds, state.VertexBuffers );
+        const float clampedDepth = std::clamp( depth, 0.0f, 1.0f );
+        uint64_t key;
+        if (m_Mode == DrawSortMode::StateThenDepth)
+        {
+            const uint64_t depthBits = uint64_t( clampedDepth * float( (1u << 20) - 1 ) );
+            key = (std::min<uint64_t>( pipelineId, 0xffff ) << 48) | (std::min<uint64_t>( descriptorSetId, 0xffff ) << 32) | (std::min<uint64_t>( vertexBuffersId, 0xfff ) << 20) | depthBits;
+        }
+        else
+        {
+            const uint64_t depthBits = uint64_t( (1.0f - clampedDepth) * float( (1u << 24) - 1 ) );
+            key = (depthBits << 40) | (std::min<uint64_t>( pipelineId, 0xffff ) << 24) | (std::min<uint64_t>( descriptorSetId, 0xffff ) << 8) | std::min<uint64_t>( vertexBuffersId, 0xff );
+        }
+        m_Keys.push_back( { key, (uint32_t) m_Items.size() } );
+        m_Items.push_back( { state, std::move( payload ) } );
+        m_Sorted = false;
+    }
+
+    /// Sort by key (stable, so equal keys keep the order they were added in).
+    void Sort()
+    {
+        if (!m_Sorted)
+            std::sort( m_Keys.begin(), m_Keys.end() );  // (key, add order) pairs are unique so this is effectively stable
+        m_Sorted = true;
+    }
+
+    /// Call fn(const Item&) for every draw in sorted order (sorting first if needed).
+    template<typename T_FN>
+    void ForEachSorted( T_FN&& fn )
+    {
+        Sort();
+        for (const auto& [key, index] : m_Keys)
+            fn( std::as_const( m_Items[index] ) );
+    }
+
+    /// Remove the draws (keeps the state ids so keys are consistent from frame to frame).
+    void Clear()
+    {
+        m_Items.clear();
+        m_Keys.clear();
+        m_Sorted = true;
+        // Do not let the id maps grow forever (eg when buffers are recreated every frame)
+        for (auto* pIds : { &m_PipelineIds, &m_DescriptorSetIds, &m_VertexBufferIds })
+            if (pIds->size() > cMaxIds)
+                pIds->clear();
+    }
+
+    size_t size() const                             { return m_Items.size(); }
+    bool empty() const                              { return m_Items.empty(); }
+    std::span<const Item> GetItems() const          { return m_Items; }    ///< in the order added
+    std::span<const std::pair<uint64_t, uint32_t>> GetKeys() const { return m_Keys; }   ///< (key, index in GetItems) pairs
+    DrawSortMode GetSortMode() const                { return m_Mode; }
+
+private:
+    static constexpr size_t cMaxIds = 0xffff;
+
+    typedef std::unordered_map<DrawStateHandles, uint32_t, DrawStateHandles::Hash> tIdMap;
+
+    static uint32_t GetId( tIdMap& ids, const DrawStateHandles& state )
+    {
+        return ids.try_emplace( state, (uint32_t) ids.size() ).first->second;
+    }
+
+    DrawSortMode                                m_Mode;
+    std::vector<Item>                           m_Items;
+    std::vector<std::pair<uint64_t, uint32_t>>  m_Keys;         ///< sort key and index in to m_Items
+    bool                                        m_Sorted = true;
+    tIdMap                                      m_PipelineIds;
+    tIdMap                                      m_DescriptorSetIds;
+    tIdMap                                      m_VertexBufferIds;
+};
+
+
+/// Sorted queue of Drawable passes that records them with redundant binds removed.  Specialized per graphics api (eg DrawableQueue<Vulkan>).
+template<typename T_GFXAPI> class DrawableQueue;
@@ -10,6 +10,7 @@
 #include <optional>
 #include <span>
 #include "texture/textureFormat.hpp" //for Msaa
+#include "drawQueue.hpp"
 
 // Forward Declarations
 class MaterialBase;
@@ -81,6 +82,10 @@ public:
     /// Binds the pipeline, descriptor sets, vertex buffers, index buffers, and issues the appropriate vkCmdDraw*
     /// @param vertexBindingsOverride allows user to replace @DrawablePass::mVertexBuffers with their own.  Span is for each 'bufferIdx' (can be size()==1 if all buffers bind the same).  DrawablePassVertexBuffers contains multiple buffers so all  mesh and instance streams are overridden.
     void DrawPass(CommandList& cmdList, const DrawablePass& drawablePass, uint32_t bufferIdx, const std::span<DrawablePassVertexBuffers> vertexBuffersOverride = {} ) const;
+    /// Version of DrawPass that skips binding state already bound to the command list (stateCache tracks what is bound, see DrawableQueue).
+    void DrawPass(CommandList& cmdList, const DrawablePass& drawablePass, uint32_t bufferIdx, DrawStateCache& stateCache, const std::span<DrawablePassVertexBuffers> vertexBuffersOverride = {} ) const;
+    /// Opaque handles of the state DrawPass binds for the given pass and buffer (as tracked by DrawStateCache).
+    DrawState GetDrawState(const DrawablePass& drawablePass, uint32_t bufferIdx, const std::span<DrawablePassVertexBuffers> vertexBuffersOverride = {} ) const;
 
     const DrawablePass* GetDrawablePass( const std::string& passName ) const;
     const auto& GetDrawablePasses() const       { return mPasses; };
@@ -96,6 +101,10 @@ public:
     void SetDispatchGroupCount(std::array<uint32_t, 3> count) { mDispatchGroupCount = count; }
     const auto& GetDispatchGroupCount() const   { return mDispatchGroupCount; }
 
+    /// Material id (in the BindlessDescriptorHeap material table) pushed by DrawPass for passes using a bindless material.
+    void SetBindlessMaterialId( uint32_t materialId ) { mBindlessMaterialId = materialId; }
+    uint32_t GetBindlessMaterialId() const      { return mBindlessMaterialId; }
+
 public:
     Material                                    mMaterial;
     Mesh                                        mMeshObject;
@@ -106,6 +115,7 @@ protected:
     uint32_t                                    mPassMask = 0;
     int                                         mNodeId = -1;       // Identifier used by application to determine what this drawable is attached to, eg for attaching to animations.  Not used by Drawable.
     std::array<uint32_t, 3>                     mDispatchGroupCount{1u,1u,1u};
+    uint32_t                                    mBindlessMaterialId = 0;
 
     std::optional<VertexBuffer>                 mVertexInstanceBuffer;
     std::optional<DrawIndirectBuffer>           mDrawIndirectBuffer;
@@ -161,6 +171,7 @@ Drawable<T_GFXAPI>::Drawable( Drawable<T_GFXAPI>&& other ) noexcept
     , mPasses( std::move( other.mPasses ) )
     , mPassNameToIndex( std::move( other.mPassNameToIndex ) )
     , mPassMask( other.mPassMask )
+    , mBindlessMaterialId( other.mBindlessMaterialId )
     , mVertexInstanceBuffer( std::move( other.mVertexInstanceBuffer ) )
     , mDrawIndirectBuffer( std::move( other.mDrawIndirectBuffer ) )
 {
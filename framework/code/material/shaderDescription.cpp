@@ -405,7 +405,11 @@ std::optional<ShaderDescription> ShaderDescriptionLoader::Load(AssetManager& ass
                     {
                         name = ar["Name"s];
                     }
-                    sets.push_back( { name, setIndex++, std::move( descriptors ) } );
+                    // A 'Bindless' set is the global bindless descriptor heap, its layout is fixed (by the heap) so any Buffers are ignored.
+                    const bool bindless = ar.contains( "Bindless"s ) ? (bool) ar["Bindless"s] : false;
+                    if (bindless)
+                        descriptors.clear();
+                    sets.push_back( { name, setIndex++, std::move( descriptors ), bindless } );
                 }
             }
             else if (el.key().compare("Outputs"s) == 0)
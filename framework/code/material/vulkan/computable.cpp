@@ -435,6 +435,7 @@ void Computable<Vulkan>::DispatchPass(CommandList<Vulkan>& cmdList, const Comput
 
     // Bind everything the shader needs
     const std::span<const VkDescriptorSet> descriptorSets = computablePass.GetMaterialPass().GetVkDescriptorSets(bufferIdx);
+    computablePass.GetMaterialPass().GetVulkan().FlushDescriptorUpdates();
     vkCmdBindDescriptorSets(vkCmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computablePass.mPipelineLayout, 0, descriptorSets.size(), descriptorSets.data(), 0, nullptr);
 
     // Dispatch the compute task
@@ -9,6 +9,7 @@
 #include "descriptorSetLayout.hpp"
 #include "../descriptorSetDescription.hpp"
 #include "vulkan/vulkan.hpp"
+#include "system/os_common.h"
 #include <array>
 #include <cassert>
 
@@ -37,6 +38,7 @@ DescriptorSetLayout<Vulkan>::DescriptorSetLayout(DescriptorSetLayout<Vulkan>&& o
     : DescriptorSetLayoutBase(std::move(other))
     , m_descriptorSetLayoutBindings(std::move(other.m_descriptorSetLayoutBindings))
     , m_descriptorPoolSizes(std::move(other.m_descriptorPoolSizes))
+    , m_bindless(other.m_bindless)
 {
     m_descriptorSetLayout = other.m_descriptorSetLayout;
     other.m_descriptorSetLayout = VK_NULL_HANDLE;
@@ -47,6 +49,23 @@ bool DescriptorSetLayout<Vulkan>::Init(Vulkan& vulkan, const DescriptorSetDescri
     if (!DescriptorSetLayoutBase::Init(description))
         return false;
 
+    m_bindless = description.m_bindless;
+    if (m_bindless)
+    {
+        // Layout of the bindless set is defined by the global heap (shader just picks the set index).
+        const auto* pBindlessHeap = vulkan.GetBindlessDescriptorHeap();
+        if (!pBindlessHeap)
+        {
+            LOGE("Descriptor set %u is marked Bindless but the bindless descriptor heap was not created (see Vulkan::CreateBindlessDescriptorHeap)", description.m_setIndex);
+            return false;
+        }
+        const auto heapBindings = pBindlessHeap->GetLayoutBindings();
+        m_descriptorSetLayoutBindings.assign(heapBindings.begin(), heapBindings.end());
+        m_descriptorPoolSizes.clear();
+        m_descriptorSetLayout = pBindlessHeap->CreateCompatibleVkDescriptorSetLayout();
+        return m_descriptorSetLayout != VK_NULL_HANDLE;
+    }
+
     const size_t numBindings = description.m_descriptorTypes.size();
     uint32_t index = 0;
     bool dynamicDescriptorCount = false;
@@ -42,10 +42,13 @@ public:
     const auto& GetVkDescriptorSetLayoutBinding() const { return m_descriptorSetLayoutBindings; }
     const auto& GetVkDescriptorSetLayout() const { return m_descriptorSetLayout; }
     const auto& GetDescriptorPoolSizes() const { return m_descriptorPoolSizes; }
+    /// Set is the global bindless descriptor heap (descriptor sets come from BindlessDescriptorHeap rather than being allocated per material).
+    bool IsBindless() const { return m_bindless; }
 
 private:
     // Vulkan objects
     VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;   ///< Vulkan descriptor set layout object.  Can be VK_NULL_HANDLE after Init if there are bindings with 'dynamic' descriptorCount (0)
     std::vector<VkDescriptorSetLayoutBinding > m_descriptorSetLayoutBindings;
     std::vector<VkDescriptorPoolSize> m_descriptorPoolSizes;
+    bool m_bindless = false;
 };
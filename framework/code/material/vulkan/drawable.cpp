@@ -245,18 +245,60 @@ bool Drawable<Vulkan>::ReInitMeshShader(std::span<const RenderContext> renderCon
     return true;
 }
 
+template<>
+DrawState Drawable<Vulkan>::GetDrawState(const DrawablePass& drawablePass, uint32_t bufferIdx, const std::span<DrawablePassVertexBuffers> vertexBufferOverrides) const
+{
+    DrawState state;
+    state.Pipeline = { (uint64_t) drawablePass.mPipeline.GetVkPipeline() };
+    if (drawablePass.mMaterialPass.IsBindless())
+    {
+        // Bindless passes all bind the same heap descriptor set (material id is pushed per draw)
+        const auto* pBindlessHeap = drawablePass.mMaterialPass.GetVulkan().GetBindlessDescriptorHeap();
+        state.DescriptorSet = { (uint64_t) pBindlessHeap->GetVkDescriptorSet(bufferIdx), (uint64_t) drawablePass.mPipelineLayout, drawablePass.mMaterialPass.GetBindlessSetIndex() };
+    }
+    else if (!drawablePass.mDescriptorSet.empty())
+        state.DescriptorSet = { (uint64_t) drawablePass.mDescriptorSet[bufferIdx], (uint64_t) drawablePass.mPipelineLayout };
+    const auto& vertexBuffers = vertexBufferOverrides.empty() ? drawablePass.mVertexBuffers : vertexBufferOverrides[bufferIdx % vertexBufferOverrides.size()];
+    for (size_t i = 0; i < vertexBuffers.mVertexBuffers.size(); ++i)
+    {
+        state.VertexBuffers.Push( (uint64_t) vertexBuffers.mVertexBuffers[i] );
+        state.VertexBuffers.Push( (uint64_t) vertexBuffers.mVertexBufferOffsets[i] );
+    }
+    if (drawablePass.mIndexBuffer != VK_NULL_HANDLE)
+        state.IndexBuffer = { (uint64_t) drawablePass.mIndexBuffer, (uint64_t) drawablePass.mIndexBufferType };
+    return state;
+}
+
 template<>
 void Drawable<Vulkan>::DrawPass(CommandList& cmdBuffer, const DrawablePass& drawablePass, uint32_t bufferIdx, const std::span<DrawablePassVertexBuffers> vertexBufferOverrides) const
+{
+    // Fresh cache, so everything gets bound.
+    DrawStateCache stateCache;
+    DrawPass(cmdBuffer, drawablePass, bufferIdx, stateCache, vertexBufferOverrides);
+}
+
+template<>
+void Drawable<Vulkan>::DrawPass(CommandList& cmdBuffer, const DrawablePass& drawablePass, uint32_t bufferIdx, DrawStateCache& stateCache, const std::span<DrawablePassVertexBuffers> vertexBufferOverrides) const
 {
     VkCommandBuffer vkCmdBuffer = cmdBuffer;
+    const DrawState drawState = GetDrawState(drawablePass, bufferIdx, vertexBufferOverrides);
 
     // Bind the pipeline for this material
-    vkCmdBindPipeline(vkCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, drawablePass.mPipeline.GetVkPipeline());
+    if (stateCache.BindPipeline(drawState.Pipeline))
+        vkCmdBindPipeline(vkCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, drawablePass.mPipeline.GetVkPipeline());
 
     // Bind everything the shader needs
-    if (!drawablePass.mDescriptorSet.empty())
+    if (drawablePass.mMaterialPass.IsBindless())
+    {
+        // Descriptor set is the global bindless heap (only bound when the state cache has not already got it bound), only the material id changes per draw.
+        if (stateCache.BindDescriptorSet(drawState.DescriptorSet))
+            drawablePass.mMaterialPass.GetVulkan().GetBindlessDescriptorHeap()->Bind(vkCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, drawablePass.mPipelineLayout, drawablePass.mMaterialPass.GetBindlessSetIndex(), bufferIdx);
+        BindlessDescriptorHeap::PushMaterialId(vkCmdBuffer, drawablePass.mPipelineLayout, mBindlessMaterialId);
+    }
+    else if (!drawablePass.mDescriptorSet.empty() && stateCache.BindDescriptorSet(drawState.DescriptorSet))
     {
         VkDescriptorSet vkDescriptorSet = drawablePass.mDescriptorSet.size() >= 1 ? drawablePass.mDescriptorSet[bufferIdx] : drawablePass.mDescriptorSet[0];
+        drawablePass.mMaterialPass.GetVulkan().FlushDescriptorUpdates();
         vkCmdBindDescriptorSets(vkCmdBuffer,
             VK_PIPELINE_BIND_POINT_GRAPHICS,
             drawablePass.mPipelineLayout,
@@ -266,6 +308,7 @@ void Drawable<Vulkan>::DrawPass(CommandList& cmdBuffer, const DrawablePass& draw
             0,
             NULL);
     }
+    stateCache.CountDraw();
 
     const auto& shaderPassDescription = drawablePass.mMaterialPass.mShaderPass.m_shaderPassDescription;
     if (shaderPassDescription.m_meshName.empty())
@@ -275,7 +318,7 @@ void Drawable<Vulkan>::DrawPass(CommandList& cmdBuffer, const DrawablePass& draw
         //
         const auto& vertexBuffers = vertexBufferOverrides.empty() ? drawablePass.mVertexBuffers : vertexBufferOverrides[bufferIdx % vertexBufferOverrides.size()];
 
-        if (!vertexBuffers.mVertexBuffers.empty())
+        if (!vertexBuffers.mVertexBuffers.empty() && stateCache.BindVertexBuffers(drawState.VertexBuffers))
         {
             // Bind mesh vertex/instance buffer(s)
             vkCmdBindVertexBuffers( vkCmdBuffer,
@@ -295,10 +338,11 @@ void Drawable<Vulkan>::DrawPass(CommandList& cmdBuffer, const DrawablePass& draw
             assert( drawablePass.mIndexBufferType != VK_INDEX_TYPE_MAX_ENUM );
 
             // Bind index buffer data
-            vkCmdBindIndexBuffer(vkCmdBuffer,
-                drawablePass.mIndexBuffer,
-                0,
-                drawablePass.mIndexBufferType);
+            if (stateCache.BindIndexBuffer(drawState.IndexBuffer))
+                vkCmdBindIndexBuffer(vkCmdBuffer,
+                    drawablePass.mIndexBuffer,
+                    0,
+                    drawablePass.mIndexBufferType);
 
             if (drawablePass.mDrawIndirectBuffer != VK_NULL_HANDLE)
             {
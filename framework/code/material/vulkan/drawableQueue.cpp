@@ -0,0 +1,61 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "drawableQueue.hpp"
+#include "drawable.hpp"
+#include "vulkan/commandBuffer.hpp"
+#include "system/os_common.h"
+
+
+DrawableQueue<Vulkan>::DrawableQueue( DrawSortMode sortMode ) noexcept
+    : m_Queue( sortMode )
+{
+}
+
+void DrawableQueue<Vulkan>::Add( const Drawable<Vulkan>& drawable, const DrawablePass<Vulkan>& drawablePass, uint32_t bufferIdx, float depth )
+{
+    // Same descriptor set index selection as ApplicationHelperBase::AddDrawableToCmdBuffers
+    const uint32_t descriptorSetIdx = drawablePass.mDescriptorSet.empty() ? 0 : bufferIdx % (uint32_t) drawablePass.mDescriptorSet.size();
+    m_Queue.Add( drawable.GetDrawState( drawablePass, descriptorSetIdx ), depth, Entry{ &drawable, &drawablePass, descriptorSetIdx } );
+}
+
+void DrawableQueue<Vulkan>::Add( const Drawable<Vulkan>& drawable, uint32_t passIdx, uint32_t bufferIdx, float depth )
+{
+    if ((drawable.GetPassMask() & (1u << passIdx)) == 0)
+        return;
+    for (const auto& drawablePass : drawable.GetDrawablePasses())
+    {
+        if (drawablePass.mPassIdx == passIdx)
+            Add( drawable, drawablePass, bufferIdx, depth );
+    }
+}
+
+void DrawableQueue<Vulkan>::Submit( CommandList<Vulkan>& cmdList )
+{
+    m_StateCache.Reset();
+    m_StateCache.ResetStats();
+    m_Queue.ForEachSorted( [this, &cmdList]( const DrawQueue<Entry>::Item& item ) {
+        const auto& entry = item.Payload;
+        entry.pDrawable->DrawPass( cmdList, *entry.pDrawablePass, entry.BufferIdx, m_StateCache );
+        ++cmdList.m_NumDrawCalls;
+        cmdList.m_NumTriangles += entry.pDrawablePass->mNumVertices / 3;
+    } );
+    m_Queue.Clear();
+
+    m_LastSubmitStats = m_StateCache.GetStats();
+    m_FrameStats += m_LastSubmitStats;
+}
+
+void DrawableQueue<Vulkan>::LogFrameStats( const char* pName ) const
+{
+    const auto& stats = m_FrameStats;
+    LOGI( "DrawableQueue %s: %u draws, %u binds issued, %u binds avoided (pipeline %u/%u, descriptor set %u/%u, vertex buffers %u/%u, index buffer %u/%u bound/skipped)",
+          pName, stats.Draws, stats.BindsIssued(), stats.BindsAvoided(),
+          stats.Pipeline.Bound, stats.Pipeline.Skipped, stats.DescriptorSet.Bound, stats.DescriptorSet.Skipped,
+          stats.VertexBuffers.Bound, stats.VertexBuffers.Skipped, stats.IndexBuffer.Bound, stats.IndexBuffer.Skipped );
+}
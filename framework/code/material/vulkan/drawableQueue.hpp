@@ -0,0 +1,69 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include "../drawQueue.hpp"
+
+// Forward Declarations
+class Vulkan;
+template<typename T_GFXAPI> class CommandList;
+template<typename T_GFXAPI> class Drawable;
+template<typename T_GFXAPI> class DrawablePass;
+
+
+/// Render queue for Vulkan drawables.
+/// Template specialization of DrawableQueue<T_GFXAPI>.
+/// Gathers DrawablePasses (for a single render pass), sorts them by state (and depth) and records them with Drawable::DrawPass
+/// skipping pipeline, descriptor set, vertex buffer and index buffer binds that are already bound.
+/// @ingroup Material
+template<>
+class DrawableQueue<Vulkan>
+{
+    DrawableQueue( const DrawableQueue<Vulkan>& ) = delete;
+    DrawableQueue& operator=( const DrawableQueue<Vulkan>& ) = delete;
+public:
+    struct Entry
+    {
+        const Drawable<Vulkan>*     pDrawable;
+        const DrawablePass<Vulkan>* pDrawablePass;
+        uint32_t                    BufferIdx;
+    };
+
+    explicit DrawableQueue( DrawSortMode sortMode = DrawSortMode::StateThenDepth ) noexcept;
+
+    /// Queue a single drawable pass.
+    /// @param depth normalized distance from the camera (0 near, 1 far)
+    void Add( const Drawable<Vulkan>& drawable, const DrawablePass<Vulkan>& drawablePass, uint32_t bufferIdx, float depth = 0.0f );
+    /// Queue every pass of the drawable that renders in to the given render pass index (DrawablePass::mPassIdx).
+    void Add( const Drawable<Vulkan>& drawable, uint32_t passIdx, uint32_t bufferIdx, float depth = 0.0f );
+
+    /// Sort and record everything queued in to the command list, then clear the queue.
+    /// Bound state is assumed to be unknown at the start of the call (nothing is assumed bound).
+    void Submit( CommandList<Vulkan>& cmdList );
+    /// Remove everything queued (without recording).
+    void Clear()                                                { m_Queue.Clear(); }
+
+    /// Bind counts of the last Submit
+    const DrawStateCache::Stats& GetLastSubmitStats() const     { return m_LastSubmitStats; }
+    /// Bind counts accumulated over every Submit since ResetFrameStats (call at the start of each frame)
+    const DrawStateCache::Stats& GetFrameStats() const          { return m_FrameStats; }
+    void ResetFrameStats()                                      { m_FrameStats = {}; }
+    /// Log the frame stats (using LOGI)
+    void LogFrameStats( const char* pName ) const;
+
+    size_t size() const                                         { return m_Queue.size(); }
+    bool empty() const                                          { return m_Queue.empty(); }
+
+private:
+    DrawQueue<Entry>        m_Queue;
+    DrawStateCache          m_StateCache;
+    DrawStateCache::Stats   m_LastSubmitStats;
+    DrawStateCache::Stats   m_FrameStats;
+};
@@ -9,9 +9,23 @@
 #include "material.hpp"
 #include "shader.hpp"
 #include "vulkan/vulkan.hpp"
+#include "vulkan/descriptorUpdateBatch.hpp"
 #include <array>
 #include "system/os_common.h"
 #include "vulkan/TextureFuncts.h"
 #include "texture/vulkan/texture.hpp"
 
 
+template<>
+bool Material<Vulkan>::UpdateDescriptorSets(uint32_t bufferIdx)
+{
+    if (m_materialPasses.empty())
+        return true;
+    Vulkan& vulkan = m_materialPasses.front().GetVulkan();
+    bool success = true;
+    for (const auto& materialPass : m_materialPasses)
+    {
+        success &= materialPass.QueueDescriptorSetUpdates(bufferIdx, vulkan.GetDescriptorUpdateBatch());
+    }
+    return success;
+}
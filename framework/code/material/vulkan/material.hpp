@@ -29,3 +29,7 @@
 /// For more complex models the user should use DrawableLoader::LoadDrawable to load the mesh model file (and return a vector of Drawables).  This api greatly simplifies the material creation and binding, splitting model meshes across material boundaries, automatically detecting instances (optionally).
 /// 
 
+
+/// Vulkan specialization queues the writes for every pass on the DescriptorUpdateBatch, they are applied with the frame's other writes (see Vulkan::GetDescriptorUpdateBatch).
+template<>
+bool Material<Vulkan>::UpdateDescriptorSets(uint32_t bufferIdx);
@@ -13,6 +13,8 @@
 #include "../shaderDescription.hpp"
 #include "system/os_common.h"
 #include "vulkan/vulkan.hpp"
+#include "vulkan/descriptorPoolAllocator.hpp"
+#include "vulkan/descriptorUpdateBatch.hpp"
 #include "texture/vulkan/texture.hpp"
 
 #include <glm/glm.hpp>
@@ -51,7 +53,8 @@ MaterialPass<Vulkan> MaterialManager<Vulkan>::CreateMaterialPassInternal(
     // Storage for the dynamic descriptor set layouts
     std::vector<VkDescriptorSetLayout> dynamicVkDescriptorSetLayouts;
 
-    std::vector<VkDescriptorPoolSize> poolSizes;
+    // Descriptor counts (per type) needed by each of the descriptor sets.
+    std::vector<std::vector<VkDescriptorPoolSize>> setPoolSizes(descriptorSetLayouts.size());
 
     //
     // Gather the (named) texture and uniform buffer slots (for this material pass)
@@ -156,91 +159,39 @@ MaterialPass<Vulkan> MaterialManager<Vulkan>::CreateMaterialPassInternal(
             // Create the descriptor set layout that is unique to this descriptor set (ideally we share the layouts but in the case of 'dynamic' descriptorCounts we cannot)
             vkDescSetLayout = dynamicVkDescriptorSetLayouts.emplace_back(DescriptorSetLayout<Vulkan>::CreateVkDescriptorSetLayout(vulkan, vkBindings));
 
-            // Add counts directly into pool sizes array!
-            DescriptorSetLayout<Vulkan>::CalculatePoolSizes(vkBindings, poolSizes);
+            DescriptorSetLayout<Vulkan>::CalculatePoolSizes(vkBindings, setPoolSizes[layoutIdx]);
         }
-    }
-
-    //
-    // Add in the pool sizes for non 'dynamic' descriptor set layouts
-    //
-    for (const auto& layout : descriptorSetLayouts)
-    {
-        if (poolSizes.size() == 0)
-            poolSizes = layout.GetDescriptorPoolSizes();
         else
         {
-            ///TODO: n^2 search, 'could' be slowish - although not normal to have more than one or two sets
-            for (const auto& newPoolSize : layout.GetDescriptorPoolSizes())
-            {
-                bool found = false;
-                for (auto& poolSize : poolSizes)
-                {
-                    if (poolSize.type == newPoolSize.type)
-                    {
-                        poolSize.descriptorCount += newPoolSize.descriptorCount;
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found)
-                    poolSizes.push_back(newPoolSize);
-            }
-        }
-    }
-
-    uint32_t poolSizeTotal = 0;
-    for (auto& poolSize : poolSizes)
-    {
-        poolSize.descriptorCount *= numFrameBuffers;
-        poolSizeTotal += poolSize.descriptorCount;
-    }
-
-    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
-    //if (poolSizeTotal > 0)  ok to make a pool with size zero (expected if a shader has a descriptor set with no entries)
-    {
-        VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
-        //PoolInfo.flags = 0;     // VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT to allow them to be returned
-        poolInfo.maxSets = numFrameBuffers * descriptorSetLayouts.size();  // Descriptor sets also come out of this pool
-        poolInfo.poolSizeCount = (uint32_t)poolSizes.size();
-        poolInfo.pPoolSizes = poolSizes.data();
-        if (VK_SUCCESS != vkCreateDescriptorPool(vulkan.m_VulkanDevice, &poolInfo, NULL, &descriptorPool))
-        {
-            assert(0);
+            setPoolSizes[layoutIdx] = descSetLayout.GetDescriptorPoolSizes();
         }
     }
 
     //
-    // Create the descriptor sets to be populated
+    // Allocate the descriptor sets to be populated (from the shared descriptor pools)
     //
 
-    std::vector<VkDescriptorSet> descriptorSets;
-    descriptorSets.reserve(numFrameBuffers * descriptorSetLayouts.size());	// pre-size so memory does not move in emplace_back
+    std::vector<DescriptorPoolAllocator::Allocation> descriptorSetAllocations;
+    descriptorSetAllocations.reserve(numFrameBuffers * descriptorSetLayouts.size());
 
-    if (!descriptorSetLayouts.empty())
+    auto& descriptorPoolAllocator = vulkan.GetDescriptorPoolAllocator();
+    for (uint32_t whichBuffer = 0; whichBuffer < numFrameBuffers; ++whichBuffer)
     {
-        for (uint32_t whichBuffer = 0; whichBuffer < numFrameBuffers; ++whichBuffer)
+        for (size_t layoutIdx = 0; layoutIdx < vkDescSetLayouts.size(); ++layoutIdx)
         {
-            //
-            // Create the descriptor set
-            //
-            VkDescriptorSetAllocateInfo descSetInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
-            descSetInfo.descriptorPool = descriptorPool;
-            descSetInfo.descriptorSetCount = (uint32_t) vkDescSetLayouts.size();
-            descSetInfo.pSetLayouts = vkDescSetLayouts.data();
-            descriptorSets.resize( descriptorSets.size() + descSetInfo.descriptorSetCount, VK_NULL_HANDLE );
-            VkDescriptorSet* pNewDescriptorSets = &descriptorSets[descriptorSets.size() - descSetInfo.descriptorSetCount];
-            VkResult result = vkAllocateDescriptorSets( vulkan.m_VulkanDevice, &descSetInfo, pNewDescriptorSets );
-            if (result != VK_SUCCESS)
+            if (descriptorSetLayouts[layoutIdx].IsBindless())
             {
-                assert(0);
+                // Bindless set is the global heap's descriptor set (not owned by the material, so no PoolSlot)
+                descriptorSetAllocations.push_back({ vulkan.GetBindlessDescriptorHeap()->GetVkDescriptorSet(whichBuffer) });
+                continue;
             }
-
-            for (const VkDescriptorSet* pDescriptorSet = pNewDescriptorSets; pDescriptorSet <= &descriptorSets.back(); ++pDescriptorSet)
+            auto& allocation = descriptorSetAllocations.emplace_back(descriptorPoolAllocator.Allocate(vkDescSetLayouts[layoutIdx], setPoolSizes[layoutIdx]));
+            if (allocation.Set == VK_NULL_HANDLE)
             {
-                vulkan.SetDebugObjectName( *pDescriptorSet, passDebugName.c_str() );
-                ++pNewDescriptorSets;
+                assert(0);
+                continue;
             }
+            vulkan.SetDebugObjectName( allocation.Set, passDebugName.c_str() );
         }
     }
 
@@ -254,7 +205,7 @@ MaterialPass<Vulkan> MaterialManager<Vulkan>::CreateMaterialPassInternal(
     SpecializationConstants<Vulkan> specializationConstants;
     specializationConstants.Init( shaderPass.GetSpecializationConstantsLayout(), { shaderConstantDatas } );
 
-    return MaterialPass<Vulkan>(vulkan, shaderPass, std::move(descriptorPool), std::move(descriptorSets), std::move(dynamicVkDescriptorSetLayouts), std::move(textureBindings), std::move(imageBindings), std::move(bufferBindings), std::move(accelerationStructureBindings), std::move(specializationConstants));
+    return MaterialPass<Vulkan>(vulkan, shaderPass, std::move(descriptorSetAllocations), std::move(dynamicVkDescriptorSetLayouts), std::move(textureBindings), std::move(imageBindings), std::move(bufferBindings), std::move(accelerationStructureBindings), std::move(specializationConstants));
 }
 
 template<>
@@ -280,9 +231,11 @@ Material<Vulkan> MaterialManager<Vulkan>::CreateMaterial(const Shader<Vulkan>& s
         ++passIdx;
     }
 
+    // Queue the descriptor writes for every buffer and pass, they are applied (along with every other material's) before the sets are first bound.
     for (uint32_t whichBuffer = 0; whichBuffer < numFrameBuffers; ++whichBuffer)
     {
-        material.UpdateDescriptorSets(whichBuffer);
+        for (const auto& materialPass : material.GetMaterialPasses())
+            materialPass.QueueDescriptorSetUpdates(whichBuffer, vulkan.GetDescriptorUpdateBatch());
     }
 
     return material;
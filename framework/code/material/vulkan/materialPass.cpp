@@ -9,6 +9,8 @@
 #include "material.hpp"
 #include "shader.hpp"
 #include "vulkan/vulkan.hpp"
+#include "vulkan/descriptorUpdateBatch.hpp"
+#include <algorithm>
 #include <array>
 #include "system/os_common.h"
 #include "vulkan/TextureFuncts.h"
@@ -37,13 +39,14 @@ static constexpr VkDescriptorType EnumToVk(const DescriptorSetDescription::Descr
 
 
 
-MaterialPass<Vulkan>::MaterialPass(Vulkan& vulkan, const ShaderPass<Vulkan>& shaderPass, VkDescriptorPool descriptorPool, std::vector<VkDescriptorSet> descriptorSets, std::vector<VkDescriptorSetLayout> dynamicDescriptorSetLayouts, tTextureBindings textureBindings, tImageBindings imageBindings, tBufferBindings bufferBindings, tAccelerationStructureBindings accelerationStructureBindings, SpecializationConstants<Vulkan> specializationConstants ) noexcept
+MaterialPass<Vulkan>::MaterialPass(Vulkan& vulkan, const ShaderPass<Vulkan>& shaderPass, std::vector<DescriptorPoolAllocator::Allocation> descriptorSetAllocations, std::vector<VkDescriptorSetLayout> dynamicDescriptorSetLayouts, tTextureBindings textureBindings, tImageBindings imageBindings, tBufferBindings bufferBindings, tAccelerationStructureBindings accelerationStructureBindings, SpecializationConstants<Vulkan> specializationConstants ) noexcept
 	: MaterialPassBase(shaderPass)
     , mVulkan( vulkan )
     , mNumDescriptorSetsPerBuffer(uint32_t(shaderPass.GetDescriptorSetLayouts().size()))
-    , mNumBuffers(mNumDescriptorSetsPerBuffer>0 ? uint32_t(descriptorSets.size() / mNumDescriptorSetsPerBuffer) : 0)
-    , mDescriptorPool(descriptorPool)
-	, mDescriptorSets(std::move(descriptorSets))
+    , mNumBuffers(mNumDescriptorSetsPerBuffer>0 ? uint32_t(descriptorSetAllocations.size() / mNumDescriptorSetsPerBuffer) : 0)
+    , mBindless(std::any_of(shaderPass.GetDescriptorSetLayouts().begin(), shaderPass.GetDescriptorSetLayouts().end(), [](const auto& layout) { return layout.IsBindless(); }))
+    , mBindlessSetIndex(uint32_t(std::find_if(shaderPass.GetDescriptorSetLayouts().begin(), shaderPass.GetDescriptorSetLayouts().end(), [](const auto& layout) { return layout.IsBindless(); }) - shaderPass.GetDescriptorSetLayouts().begin()))
+    , mDescriptorSetAllocations(std::move(descriptorSetAllocations))
 	, mDynamicDescriptorSetLayouts(std::move(dynamicDescriptorSetLayouts))
     , mSpecializationConstants( std::move( specializationConstants ) )
     , mTextureBindings(std::move(textureBindings))
@@ -51,11 +54,18 @@ MaterialPass<Vulkan>::MaterialPass(Vulkan& vulkan, const ShaderPass<Vulkan>& sha
 	, mBufferBindings(std::move(bufferBindings))
     , mAccelerationStructureBindings( std::move( accelerationStructureBindings ) )
 {
+    mDescriptorSets.reserve(mDescriptorSetAllocations.size());
+    for (const auto& allocation : mDescriptorSetAllocations)
+        mDescriptorSets.push_back(allocation.Set);
+
 	if (!mDynamicDescriptorSetLayouts.empty())
-		mDynamicPipelineLayout.Init(vulkan, mDynamicDescriptorSetLayouts);
+	{
+		if (mBindless)
+			mDynamicPipelineLayout.Init(vulkan, mDynamicDescriptorSetLayouts, { &BindlessDescriptorHeap::cPushConstantRange, 1 });
+		else
+			mDynamicPipelineLayout.Init(vulkan, mDynamicDescriptorSetLayouts);
+	}
     assert( mDescriptorSets.size() == mNumBuffers*mNumDescriptorSetsPerBuffer );
-
-	descriptorPool = VK_NULL_HANDLE;	// we took owenership
 }
 
 MaterialPass<Vulkan>::MaterialPass(MaterialPass<Vulkan>&& other) noexcept
@@ -63,7 +73,9 @@ MaterialPass<Vulkan>::MaterialPass(MaterialPass<Vulkan>&& other) noexcept
     , mVulkan( other.mVulkan )
     , mNumDescriptorSetsPerBuffer( other.mNumDescriptorSetsPerBuffer )
     , mNumBuffers( other.mNumBuffers )
-    , mDescriptorPool(other.mDescriptorPool)
+    , mBindless( other.mBindless )
+    , mBindlessSetIndex( other.mBindlessSetIndex )
+    , mDescriptorSetAllocations(std::move(other.mDescriptorSetAllocations))
 	, mDescriptorSets(std::move(other.mDescriptorSets))
 	, mDynamicDescriptorSetLayouts(std::move(other.mDynamicDescriptorSetLayouts))
 	, mDynamicPipelineLayout(std::move(other.mDynamicPipelineLayout))
@@ -73,16 +85,22 @@ MaterialPass<Vulkan>::MaterialPass(MaterialPass<Vulkan>&& other) noexcept
 	, mBufferBindings(std::move(other.mBufferBindings))
     , mSpecializationConstants( std::move( other.mSpecializationConstants ) )
 {
-	other.mDescriptorPool = VK_NULL_HANDLE;
+	other.mDescriptorSetAllocations.clear();
 }
 
 MaterialPass<Vulkan>::~MaterialPass()
 {
-	if (mDescriptorPool != VK_NULL_HANDLE)
+	if (!mDescriptorSetAllocations.empty())
 	{
-		//if (mDescriptorSet != VK_NULL_HANDLE)
-		//	vkFreeDescriptorSets(mVulkan.m_VulkanDevice, mDescriptorPool, 1, &mDescriptorSet); only if VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT
-		vkDestroyDescriptorPool(mVulkan.m_VulkanDevice, mDescriptorPool, nullptr);
+		// Only forget the sets this pass owns (not the shared bindless heap sets).
+		std::vector<VkDescriptorSet> ownedDescriptorSets;
+		ownedDescriptorSets.reserve(mDescriptorSetAllocations.size());
+		for (const auto& allocation : mDescriptorSetAllocations)
+			if (allocation.PoolSlot.IsValid())
+				ownedDescriptorSets.push_back(allocation.Set);
+		mVulkan.GetDescriptorUpdateBatch().ForgetDescriptorSets(ownedDescriptorSets);
+		// Sets are returned to the shared pools once the gpu has finished any frames that may be using them.
+		mVulkan.GetDescriptorPoolAllocator().Free(mDescriptorSetAllocations);
 	}
 
 	mDynamicPipelineLayout.Destroy(mVulkan);
@@ -93,24 +111,18 @@ MaterialPass<Vulkan>::~MaterialPass()
 
 bool MaterialPass<Vulkan>::UpdateDescriptorSets(uint32_t bufferIdx)
 {
-    // TODO: All these need to become vectors that can dynamically grow
-	static const int cMAX_WRITES = 32;
-	static const int cMAX_IMAGE_INFOS = 1048;
-	static const int cMAX_BUFFER_INFOS = 1048;
-	static const int cMAX_ACCELERATIONSTRUCTURE_INFOS = 32;
-	std::array<VkWriteDescriptorSet, cMAX_WRITES> writeInfo{/*zero it*/ };
-	std::array<VkDescriptorImageInfo, cMAX_IMAGE_INFOS> imageInfo{/*zero it*/ };
-    std::array<VkDescriptorBufferInfo, cMAX_BUFFER_INFOS> bufferInfoFixed/*not initialized*/;
-    std::vector<VkDescriptorBufferInfo> bufferInfoDynamic;
-
-	//	std::vector<m_descriptorSetBindings>
-
-	uint32_t writeInfoIdx = 0;
-	uint32_t imageInfoCount = 0;
-	uint32_t bufferInfoCount = 0;
+    // Applied with the rest of the frame's descriptor writes (see Vulkan::FlushDescriptorUpdates).
+    return QueueDescriptorSetUpdates(bufferIdx, mVulkan.GetDescriptorUpdateBatch());
+}
+
+bool MaterialPass<Vulkan>::QueueDescriptorSetUpdates(uint32_t bufferIdx, DescriptorUpdateBatch& batch) const
+{
     const size_t numDescriptorSetsPerFrame = GetShaderPass().GetDescriptorSetLayouts().size();
     const auto descriptorSetBaseIdx = bufferIdx * numDescriptorSetsPerFrame;
 
+    // Descriptor infos are copied by the batch, so one (growable) scratch array can be reused for every binding.
+    std::vector<VkDescriptorImageInfo> imageInfo;
+
 	// Go through the textures first
 	for (const auto& textureBinding : mTextureBindings)
 	{
@@ -121,34 +133,13 @@ bool MaterialPass<Vulkan>::UpdateDescriptorSets(uint32_t bufferIdx)
 		uint32_t numTexToBind = textureBinding.second.setBinding.isArray ? (uint32_t)textureBinding.first.size() : 1;
 		uint32_t texIndex = textureBinding.second.setBinding.isArray ? 0 : (bufferIdx % textureBinding.first.size());
 
-		writeInfo[writeInfoIdx].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		writeInfo[writeInfoIdx].descriptorType = bindingType;
-		writeInfo[writeInfoIdx].dstSet = mDescriptorSets[descriptorSetBaseIdx + setIndex];
-		writeInfo[writeInfoIdx].dstBinding = bindingIndex;
-		writeInfo[writeInfoIdx].dstArrayElement = 0;
-		writeInfo[writeInfoIdx].descriptorCount = numTexToBind;
-		writeInfo[writeInfoIdx].pBufferInfo = nullptr;
-		writeInfo[writeInfoIdx].pImageInfo = &imageInfo[imageInfoCount];
-		for (uint32_t t = 0; t < numTexToBind; ++t, ++imageInfoCount, ++texIndex)
-        {
-            if (imageInfoCount >= cMAX_IMAGE_INFOS)
-            {
-                LOGE("Max number (%d) of VkDescriptorImageInfo elements reached!", cMAX_IMAGE_INFOS);
-                assert(0);
-                return false;
-            }
-
-            imageInfo[imageInfoCount] = apiCast<Vulkan>(textureBinding.first[texIndex])->GetVkDescriptorImageInfo();
-            assert(imageInfo[imageInfoCount].imageView != VK_NULL_HANDLE);
-        }
-
-		++writeInfoIdx;
-        if (writeInfoIdx >= cMAX_WRITES)
+        imageInfo.resize(numTexToBind);
+		for (uint32_t t = 0; t < numTexToBind; ++t, ++texIndex)
         {
-            LOGE("Max number (%d) of VkWriteDescriptorSet elements reached!", cMAX_WRITES);
-            assert(0);
-            return false;
+            imageInfo[t] = apiCast<Vulkan>(textureBinding.first[texIndex])->GetVkDescriptorImageInfo();
+            assert(imageInfo[t].imageView != VK_NULL_HANDLE);
         }
+        batch.QueueImageWrite(mDescriptorSets[descriptorSetBaseIdx + setIndex], bindingIndex, 0, bindingType, imageInfo);
 	}
 
 	// Go through the images
@@ -163,51 +154,19 @@ bool MaterialPass<Vulkan>::UpdateDescriptorSets(uint32_t bufferIdx)
 		uint32_t numImgToBind = imageBinding.second.setBinding.isArray ? (uint32_t)imageBinding.first.size() : 1;
 		uint32_t imgIndex = imageBinding.second.setBinding.isArray ? 0 : (bufferIdx % imageBinding.first.size());
 
-		writeInfo[writeInfoIdx].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		writeInfo[writeInfoIdx].descriptorType = bindingType;
-		writeInfo[writeInfoIdx].dstSet = mDescriptorSets[descriptorSetBaseIdx + setIndex];
-		writeInfo[writeInfoIdx].dstBinding = bindingIndex;
-		writeInfo[writeInfoIdx].dstArrayElement = 0;
-		writeInfo[writeInfoIdx].descriptorCount = numImgToBind;
-		writeInfo[writeInfoIdx].pBufferInfo = nullptr;
-		writeInfo[writeInfoIdx].pImageInfo = &imageInfo[imageInfoCount];
-		for (uint32_t t = 0; t < numImgToBind; ++t, ++imageInfoCount, ++imgIndex)
+        imageInfo.resize(numImgToBind);
+		for (uint32_t t = 0; t < numImgToBind; ++t, ++imgIndex)
 		{
-            if (imageInfoCount >= cMAX_IMAGE_INFOS)
-            {
-                LOGE("Max number (%d) of VkDescriptorImageInfo elements reached!", cMAX_IMAGE_INFOS);
-                assert(0);
-                return false;
-            }
-
-            imageInfo[imageInfoCount].sampler = VK_NULL_HANDLE;
-			imageInfo[imageInfoCount].imageView = imageBinding.first[imgIndex].imageView;
-			imageInfo[imageInfoCount].imageLayout = imageBinding.first[imgIndex].imageLayout;
+            imageInfo[t].sampler = VK_NULL_HANDLE;
+			imageInfo[t].imageView = imageBinding.first[imgIndex].imageView;
+			imageInfo[t].imageLayout = imageBinding.first[imgIndex].imageLayout;
             assert(imageBinding.first[imgIndex].imageView != VK_NULL_HANDLE);
 		}
-		++writeInfoIdx;
-
-        if (writeInfoIdx >= cMAX_WRITES)
-        {
-            LOGE("Max number (%d) of VkWriteDescriptorSet elements reached!", cMAX_WRITES);
-            assert(0);
-            return false;
-        }
+        batch.QueueImageWrite(mDescriptorSets[descriptorSetBaseIdx + setIndex], bindingIndex, 0, bindingType, imageInfo);
 	}
 
     // Now do the buffers
-
-    for (const auto& bufferBinding : mBufferBindings)
-    {
-        bufferInfoCount += bufferBinding.second.setBinding.isArray ? (uint32_t) bufferBinding.first.size() : 1;
-    }
-    auto* pBufferInfo = bufferInfoFixed.data();
-    if (bufferInfoCount > cMAX_BUFFER_INFOS)
-    {
-        bufferInfoDynamic.resize( bufferInfoCount );
-        pBufferInfo = bufferInfoDynamic.data();
-    }
-
+    std::vector<VkDescriptorBufferInfo> bufferInfo;
     for (const auto& bufferBinding : mBufferBindings)
     {
         uint32_t setIndex = bufferBinding.second.setIndex;
@@ -217,95 +176,34 @@ bool MaterialPass<Vulkan>::UpdateDescriptorSets(uint32_t bufferIdx)
 		uint32_t numBuffersToBind = bufferBinding.second.setBinding.isArray ? (uint32_t)bufferBinding.first.size() : 1;
 		uint32_t bufferIndex = bufferBinding.second.setBinding.isArray ? 0 : (bufferIdx % bufferBinding.first.size());
 
-		writeInfo[writeInfoIdx].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		writeInfo[writeInfoIdx].descriptorType = bindingType;
-		writeInfo[writeInfoIdx].dstSet = mDescriptorSets[descriptorSetBaseIdx + setIndex];
-		writeInfo[writeInfoIdx].dstBinding = bindingIndex;
-		writeInfo[writeInfoIdx].dstArrayElement = 0;
-		writeInfo[writeInfoIdx].descriptorCount = numBuffersToBind;
-		writeInfo[writeInfoIdx].pBufferInfo = pBufferInfo;
-		writeInfo[writeInfoIdx].pImageInfo = nullptr;
-
+        bufferInfo.resize(numBuffersToBind);
 		for (uint32_t t = 0; t < numBuffersToBind; ++t, ++bufferIndex)
 		{
-			pBufferInfo->buffer = bufferBinding.first[bufferIndex].buffer();
-            pBufferInfo->offset = bufferBinding.first[bufferIndex].offset();
-            pBufferInfo->range = VK_WHOLE_SIZE;
-            ++pBufferInfo;
+			bufferInfo[t].buffer = bufferBinding.first[bufferIndex].buffer();
+            bufferInfo[t].offset = bufferBinding.first[bufferIndex].offset();
+            bufferInfo[t].range = VK_WHOLE_SIZE;
 		}
-
-		++writeInfoIdx;
-        if (writeInfoIdx >= cMAX_WRITES)
-        {
-            LOGE("Max number (%d) of VkWriteDescriptorSet elements reached!", cMAX_WRITES);
-            assert(0);
-            return false;
-        }
+        batch.QueueBufferWrite(mDescriptorSets[descriptorSetBaseIdx + setIndex], bindingIndex, 0, bindingType, bufferInfo);
 	}
 
 #if VK_KHR_acceleration_structure
 	// And the acceleration structures
-	std::array<VkWriteDescriptorSetAccelerationStructureKHR, cMAX_ACCELERATIONSTRUCTURE_INFOS> accelerationStructureInfo{};
-	uint32_t accelerationStructureCount = 0;
-
 	for (const auto& accelerationBinding : mAccelerationStructureBindings)
 	{
         uint32_t setIndex = accelerationBinding.second.setIndex;
         uint32_t bindingIndex = accelerationBinding.second.setBinding.index;
-		VkDescriptorType bindingType =  EnumToVk(accelerationBinding.second.setBinding.type);
-
-		uint32_t numAccelToBind = accelerationBinding.second.setBinding.isArray ? (uint32_t)accelerationBinding.first.size() : 1;
 		uint32_t accelIndex = accelerationBinding.second.setBinding.isArray ? 0 : (bufferIdx < accelerationBinding.first.size() ? bufferIdx : 0);
 
-        if (writeInfoIdx >= cMAX_WRITES)
-        {
-            LOGE("Max number (%d) of VkWriteDescriptorSet elements reached!", cMAX_WRITES);
-            assert(0);
-            return false;
-        }
-
-        if (accelerationStructureCount >= cMAX_ACCELERATIONSTRUCTURE_INFOS)
-        {
-            LOGE("Max number (%d) of VkWriteDescriptorSetAccelerationStructureKHR elements reached!", cMAX_ACCELERATIONSTRUCTURE_INFOS);
-            assert(0);
-            return false;
-        }
-        
         const auto* pAs = apiCast<Vulkan>(accelerationBinding.first[accelIndex]);
-		accelerationStructureInfo[accelerationStructureCount].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
-		accelerationStructureInfo[accelerationStructureCount].accelerationStructureCount = 1;
-		accelerationStructureInfo[accelerationStructureCount].pAccelerationStructures = &pAs->GetVkAccelerationStructure();
-
-		writeInfo[writeInfoIdx].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		writeInfo[writeInfoIdx].descriptorType = bindingType;//VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR
-		writeInfo[writeInfoIdx].dstSet = mDescriptorSets[descriptorSetBaseIdx + setIndex];
-		writeInfo[writeInfoIdx].dstBinding = bindingIndex;
-		writeInfo[writeInfoIdx].dstArrayElement = 0;
-		writeInfo[writeInfoIdx].descriptorCount = accelerationStructureInfo[accelerationStructureCount].accelerationStructureCount;
-		writeInfo[writeInfoIdx].pBufferInfo = nullptr;
-		writeInfo[writeInfoIdx].pImageInfo = nullptr;
-		writeInfo[writeInfoIdx].pNext = &accelerationStructureInfo[accelerationStructureCount];
-		++writeInfoIdx;
-		++accelerationStructureCount;
-
+        batch.QueueAccelerationStructureWrite(mDescriptorSets[descriptorSetBaseIdx + setIndex], bindingIndex, 0, { &pAs->GetVkAccelerationStructure(), 1 });
 	}
 #endif // VK_KHR_acceleration_structure
 
-	// LOGI("Updating Descriptor Set (bufferIdx %d) with %d objects", bufferIdx, writeInfoIdx);
-	vkUpdateDescriptorSets(mVulkan.m_VulkanDevice, writeInfoIdx, writeInfo.data(), 0, NULL);
-	// LOGI("Descriptor Set Updated!");
-
 	return true;
 }
 
 bool MaterialPass<Vulkan>::UpdateDescriptorSetBinding(uint32_t bufferIdx, const std::string& bindingName, const Texture<Vulkan>& newTexture) const
 {
-    std::array<VkWriteDescriptorSet, 1>  writeInfo{ {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET} };
-	std::array<VkDescriptorImageInfo, 1> imageInfo{/*zero it*/ };
-
-	uint32_t writeInfoIdx = 0;
-	uint32_t imageInfoCount = 0;
-
     for (int setIdx = 0; const auto & setLayout : GetShaderPass().GetDescriptorSetLayouts())
     {
         const auto& nameToBinding = setLayout.GetNameToBinding();
@@ -316,21 +214,8 @@ bool MaterialPass<Vulkan>::UpdateDescriptorSetBinding(uint32_t bufferIdx, const
             VkDescriptorType bindingType = EnumToVk(bindingIt->second.type);
             assert( bindingType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER || bindingType == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE || bindingType == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
 
-            uint32_t bindingIndex = bindingIt->second.index;
-
-            writeInfo[writeInfoIdx].descriptorType = bindingType;
-            writeInfo[writeInfoIdx].dstSet = descriptorSet;
-            writeInfo[writeInfoIdx].dstBinding = bindingIndex;
-            writeInfo[writeInfoIdx].dstArrayElement = 0;
-            writeInfo[writeInfoIdx].descriptorCount = 1;
-            writeInfo[writeInfoIdx].pBufferInfo = nullptr;
-            writeInfo[writeInfoIdx].pImageInfo = &imageInfo[imageInfoCount];
-            imageInfo[imageInfoCount] = newTexture.GetVkDescriptorImageInfo();
-
-            ++imageInfoCount;
-            ++writeInfoIdx;
-
-            vkUpdateDescriptorSets( mVulkan.m_VulkanDevice, writeInfoIdx, writeInfo.data(), 0, NULL );
+            const VkDescriptorImageInfo imageInfo = newTexture.GetVkDescriptorImageInfo();
+            mVulkan.GetDescriptorUpdateBatch().QueueImageWrite( descriptorSet, bindingIt->second.index, 0, bindingType, { &imageInfo, 1 } );
             return true;
         }
         ++setIdx;
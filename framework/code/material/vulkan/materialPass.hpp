@@ -9,6 +9,7 @@
 
 #include <optional>
 #include "vulkan/vulkan.hpp"
+#include "vulkan/descriptorPoolAllocator.hpp"
 #include "../descriptorSetLayout.hpp"
 #include "shader.hpp"
 #include "pipelineLayout.hpp"
@@ -19,6 +20,7 @@
 
 
 // Forward declarations
+class DescriptorUpdateBatch;
 class TextureBase;
 template<typename T_GFXAPI> struct ImageInfo;
 template<typename T_GFXAPI> class PipelineLayout;
@@ -67,11 +69,12 @@ public:
     typedef std::vector <std::pair<PerFrameBufferVulkan,                   DescriptorSetLayoutBase::DescriptorBinding>> tBufferBindings;
     typedef std::vector <std::pair<MaterialManagerBase::tPerFrameAccelerationStructure, DescriptorSetLayoutBase::DescriptorBinding>> tAccelerationStructureBindings;
 
-    MaterialPass(Vulkan& vulkan, const ShaderPass<Vulkan>&, VkDescriptorPool, std::vector<VkDescriptorSet>, std::vector<VkDescriptorSetLayout> dynamicDescriptorSetLayouts, tTextureBindings, tImageBindings, tBufferBindings, tAccelerationStructureBindings, SpecializationConstants<Vulkan>) noexcept;
+    MaterialPass(Vulkan& vulkan, const ShaderPass<Vulkan>&, std::vector<DescriptorPoolAllocator::Allocation> descriptorSetAllocations, std::vector<VkDescriptorSetLayout> dynamicDescriptorSetLayouts, tTextureBindings, tImageBindings, tBufferBindings, tAccelerationStructureBindings, SpecializationConstants<Vulkan>) noexcept;
     MaterialPass(MaterialPass<Vulkan>&&) noexcept;
     ~MaterialPass();
 
     const auto& GetShaderPass() const               { return apiCast<Vulkan>( mShaderPass ); }
+    Vulkan& GetVulkan() const                       { return mVulkan; }
 
     /// Get the descriptor set for the (numbered) frame buffer index, allows for a single descriptor set identical for all frames if required.
     const auto& GetVkDescriptorSet(uint32_t bufferIndex, int32_t setIndex) const { return mDescriptorSets[mDescriptorSets.size() > 1 ? bufferIndex : 0]; }
@@ -79,12 +82,21 @@ public:
     const auto& GetVkDescriptorSets() const         { return mDescriptorSets; }
     const auto& GetPipelineLayout() const           { return mDynamicPipelineLayout; }
     const auto& GetSpecializationConstants() const  { return mSpecializationConstants; };
+    /// Pass uses the global bindless descriptor heap (draws bind the heap's descriptor set, when not already bound, and push a material id rather than binding mDescriptorSets, see BindlessDescriptorHeap).
+    bool IsBindless() const                         { return mBindless; }
+    /// Descriptor set index of the bindless heap (only valid if IsBindless).
+    uint32_t GetBindlessSetIndex() const            { return mBindlessSetIndex; }
 
     const auto& GetTextureBindings() const          { return mTextureBindings; }
     const auto& GetImageBindings() const            { return mImageBindings; }
     const auto& GetBufferBindings() const           { return mBufferBindings; }
 
+    /// Write all the bindings in to the descriptor sets for the given buffer index (queues them with QueueDescriptorSetUpdates, applied before the sets are next bound).
     bool UpdateDescriptorSets(uint32_t bufferIdx);
+    /// Queue the writes of all the bindings (for the given buffer index) on to batch, without applying them (see Vulkan::FlushDescriptorUpdates).
+    /// Thread safe (for different or identical passes) as long as the bindings are not being modified.
+    bool QueueDescriptorSetUpdates(uint32_t bufferIdx, DescriptorUpdateBatch& batch) const;
+    /// Queue a write of newTexture to the named binding (applied before the set is next bound).
     bool UpdateDescriptorSetBinding(uint32_t bufferIdx, const std::string& bindingName, const Texture<Vulkan>& newTexture) const;
 
 protected:
@@ -93,9 +105,11 @@ protected:
     // Helpers for size of mDescriptorSets
     const uint32_t mNumDescriptorSetsPerBuffer;                 ///< number of descriptor sets needed by the shader(pass).  Usually 1 but some shaders will use more then one secriptor set.
     const uint32_t mNumBuffers;                                 ///< Number of buffers worth of descriptors (may be 1, or number of framebuffers, or something else)
+    const bool mBindless;                                       ///< one (or more) of the descriptor sets is the bindless heap
+    const uint32_t mBindlessSetIndex;                           ///< (first) descriptor set index of the bindless heap, if mBindless
 
     // Vulkan objects
-    VkDescriptorPool mDescriptorPool;
+    std::vector<DescriptorPoolAllocator::Allocation> mDescriptorSetAllocations;   ///< allocations (from Vulkan::GetDescriptorPoolAllocator) of the mDescriptorSets
     std::vector<VkDescriptorSet> mDescriptorSets;               ///< array of descriptor sets (mNumDescriptorSetsPerBuffer * mNumBuffers))
     std::vector<VkDescriptorSetLayout> mDynamicDescriptorSetLayouts;///< array of descriptor set layouts specific for to this materialPass (usually they are shared across all materials with a specific shader, except in the case of descriptor sets that are 'dynamically' sized to fit the material specific contents)
     PipelineLayout<Vulkan> mDynamicPipelineLayout;              ///< pipeline layout specific to this materiaPass (usually shaderPass contains the pipeline layout but for materials with 'dynamic' descriptor set layouts we have to have a unique pipeline per materialPass
@@ -0,0 +1,216 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "parallelDrawableRecorder.hpp"
+#include "drawable.hpp"
+#include "vulkan/commandBuffer.hpp"
+#include "vulkan/renderContext.hpp"
+#include "system/os_common.h"
+#include "system/profile.h"
+#include "system/Worker.h"
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+
+ParallelDrawableRecorder::ParallelDrawableRecorder( Vulkan& vulkan, ThreadWorker& threadWorker ) noexcept
+    : m_Vulkan( vulkan )
+    , m_ThreadWorker( threadWorker )
+{
+}
+
+ParallelDrawableRecorder::~ParallelDrawableRecorder()
+{
+    Destroy();
+}
+
+bool ParallelDrawableRecorder::Initialize( const Config& config, uint32_t numFrameBuffers, uint32_t queueIndex )
+{
+    Destroy();
+    m_Config = config;
+    m_QueueIndex = queueIndex;
+    const uint32_t numSlots = std::max( config.MaxSlots ? config.MaxSlots : m_ThreadWorker.NumThreads() + 1, 1u );
+
+    // One command pool per slot per frame, so slots can record concurrently and a frame's pools can be reset in one go once the gpu is done with them.
+    const VkCommandPoolCreateInfo cmdPoolInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        .queueFamilyIndex = (uint32_t) m_Vulkan.m_VulkanQueues[queueIndex].QueueFamilyIndex
+    };
+    m_Slots.reserve( numSlots );
+    for (uint32_t slotIdx = 0; slotIdx < numSlots; ++slotIdx)
+    {
+        auto& slot = *m_Slots.emplace_back( std::make_unique<Slot>() );
+        slot.Frames.resize( numFrameBuffers );
+        for (auto& slotFrame : slot.Frames)
+        {
+            if (!CheckVkError( "vkCreateCommandPool()", vkCreateCommandPool( m_Vulkan.m_VulkanDevice, &cmdPoolInfo, nullptr, &slotFrame.CommandPool ) ))
+            {
+                Destroy();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void ParallelDrawableRecorder::Destroy()
+{
+    for (auto& pSlot : m_Slots)
+    {
+        for (auto& slotFrame : pSlot->Frames)
+        {
+            // Command lists free themselves back to the pool, so release them before destroying it.
+            slotFrame.CommandLists.clear();
+            if (slotFrame.CommandPool != VK_NULL_HANDLE)
+                vkDestroyCommandPool( m_Vulkan.m_VulkanDevice, slotFrame.CommandPool, nullptr );
+        }
+    }
+    m_Slots.clear();
+}
+
+bool ParallelDrawableRecorder::BeginFrame( uint32_t frameIdx )
+{
+    bool success = true;
+    for (auto& pSlot : m_Slots)
+    {
+        auto& slotFrame = pSlot->Frames[frameIdx % pSlot->Frames.size()];
+        slotFrame.NumUsed = 0;
+        success &= CheckVkError( "vkResetCommandPool()", vkResetCommandPool( m_Vulkan.m_VulkanDevice, slotFrame.CommandPool, 0 ) );
+    }
+    return success;
+}
+
+CommandList<Vulkan>* ParallelDrawableRecorder::AcquireCommandList( Slot& slot, uint32_t frameIdx, uint32_t slotIdx )
+{
+    auto& slotFrame = slot.Frames[frameIdx % slot.Frames.size()];
+    if (slotFrame.NumUsed == slotFrame.CommandLists.size())
+    {
+        auto pCmdList = std::make_unique<CommandList<Vulkan>>();
+        const std::string name = "ParallelDrawableRecorder slot " + std::to_string( slotIdx ) + " frame " + std::to_string( frameIdx ) + " #" + std::to_string( slotFrame.NumUsed );
+        if (!pCmdList->Initialize( &m_Vulkan, name, CommandListBase::Type::Secondary, m_QueueIndex, slotFrame.CommandPool ))
+            return nullptr;
+        slotFrame.CommandLists.push_back( std::move( pCmdList ) );
+    }
+    return slotFrame.CommandLists[slotFrame.NumUsed++].get();
+}
+
+bool ParallelDrawableRecorder::RecordSlot( Slot& slot, CommandList<Vulkan>& cmdList, const RenderContext<Vulkan>& renderContext, std::span<const Drawable<Vulkan>* const> drawables, uint32_t passIdx, uint32_t frameIdx, double& elapsedMs )
+{
+    PROFILE_SCOPE( GROUP_VKFRAMEWORK, 0, "ParallelDrawableRecorder::RecordSlot" );
+    const auto startTime = std::chrono::steady_clock::now();
+
+    if (!cmdList.Begin( renderContext, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT ))
+    {
+        PROFILE_SCOPE_END();
+        return false;
+    }
+    if (m_Config.SortDraws)
+    {
+        // State order only (no depth), which is only valid because the caller opted in for an opaque pass.
+        for (const auto* pDrawable : drawables)
+            slot.Queue.Add( *pDrawable, passIdx, frameIdx );
+        slot.Queue.ResetFrameStats();
+        slot.Queue.Submit( cmdList );
+    }
+    else
+    {
+        for (const auto* pDrawable : drawables)
+        {
+            if ((pDrawable->GetPassMask() & (1u << passIdx)) == 0)
+                continue;
+            for (const auto& drawablePass : pDrawable->GetDrawablePasses())
+            {
+                if (drawablePass.mPassIdx != passIdx)
+                    continue;
+                pDrawable->DrawPass( cmdList, drawablePass, drawablePass.mDescriptorSet.empty() ? 0 : frameIdx % (uint32_t) drawablePass.mDescriptorSet.size() );
+                ++cmdList.m_NumDrawCalls;
+                cmdList.m_NumTriangles += drawablePass.mNumVertices / 3;
+            }
+        }
+    }
+    const bool success = cmdList.End();
+
+    elapsedMs = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - startTime ).count();
+    PROFILE_SCOPE_END();
+    return success;
+}
+
+bool ParallelDrawableRecorder::Record( CommandList<Vulkan>& primaryCmdList, const RenderContext<Vulkan>& renderContext, std::span<const Drawable<Vulkan>* const> drawables, uint32_t passIdx, uint32_t frameIdx )
+{
+    PROFILE_SCOPE( GROUP_VKFRAMEWORK, 0, "ParallelDrawableRecorder::Record" );
+    const auto startTime = std::chrono::steady_clock::now();
+    assert( !m_Slots.empty() );
+
+    // Partition sizing: as many slots as are worthwhile (at least MinDrawablesPerSlot each), up to the configured maximum.
+    const uint32_t numDrawables = (uint32_t) drawables.size();
+    const uint32_t maxSlots = std::min( (uint32_t) m_Slots.size(), m_Config.MaxSlots ? m_Config.MaxSlots : (uint32_t) m_Slots.size() );
+    const uint32_t numSlots = std::clamp( numDrawables / std::max( m_Config.MinDrawablesPerSlot, 1u ), 1u, maxSlots );
+
+    std::vector<CommandList<Vulkan>*> cmdLists( numSlots );
+    for (uint32_t slotIdx = 0; slotIdx < numSlots; ++slotIdx)
+    {
+        cmdLists[slotIdx] = AcquireCommandList( *m_Slots[slotIdx], frameIdx, slotIdx );
+        if (!cmdLists[slotIdx])
+        {
+            PROFILE_SCOPE_END();
+            return false;
+        }
+    }
+
+    m_Timings.SlotMs.assign( numSlots, 0.0 );
+    std::vector<uint8_t> slotSuccess( numSlots, 0 );
+    auto recordSlot = [&]( uint32_t slotIdx ) {
+        const uint32_t begin = uint32_t( uint64_t( numDrawables ) * slotIdx / numSlots );
+        const uint32_t end = uint32_t( uint64_t( numDrawables ) * (slotIdx + 1) / numSlots );
+        slotSuccess[slotIdx] = RecordSlot( *m_Slots[slotIdx], *cmdLists[slotIdx], renderContext, drawables.subspan( begin, end - begin ), passIdx, frameIdx, m_Timings.SlotMs[slotIdx] ) ? 1 : 0;
+    };
+
+    // Slots 1..n on the worker threads, slot 0 on this thread.
+    ReverseSemaphore slotsOutstanding{ 0 };
+    for (uint32_t slotIdx = 1; slotIdx < numSlots; ++slotIdx)
+    {
+        slotsOutstanding.Lock();
+        m_ThreadWorker.DoWork3( [&recordSlot, &slotsOutstanding, slotIdx]() {
+            recordSlot( slotIdx );
+            slotsOutstanding.Unlock();
+        } );
+    }
+    recordSlot( 0 );
+    {
+        PROFILE_SCOPE( GROUP_VKFRAMEWORK, 0, "ParallelDrawableRecorder wait" );
+        slotsOutstanding.WaitAndLock();
+        PROFILE_SCOPE_END();
+    }
+
+    // Stitch the secondaries in to the primary (in drawable order).
+    std::vector<VkCommandBuffer> vkCmdBuffers;
+    vkCmdBuffers.reserve( numSlots );
+    bool success = true;
+    m_Timings.BindStats = {};
+    for (uint32_t slotIdx = 0; slotIdx < numSlots; ++slotIdx)
+    {
+        if (!slotSuccess[slotIdx])
+        {
+            success = false;
+            continue;
+        }
+        vkCmdBuffers.push_back( cmdLists[slotIdx]->m_VkCommandBuffer );
+        primaryCmdList.m_NumDrawCalls += cmdLists[slotIdx]->m_NumDrawCalls;
+        primaryCmdList.m_NumTriangles += cmdLists[slotIdx]->m_NumTriangles;
+        if (m_Config.SortDraws)
+            m_Timings.BindStats += m_Slots[slotIdx]->Queue.GetLastSubmitStats();
+    }
+    primaryCmdList.ExecuteCommands( vkCmdBuffers );
+
+    m_Timings.NumDrawables = numDrawables;
+    m_Timings.SlowestSlotMs = *std::max_element( m_Timings.SlotMs.begin(), m_Timings.SlotMs.end() );
+    m_Timings.TotalMs = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - startTime ).count();
+    PROFILE_SCOPE_END();
+    return success;
+}
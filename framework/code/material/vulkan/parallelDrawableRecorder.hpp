@@ -0,0 +1,98 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <volk/volk.h>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "drawableQueue.hpp"
+#include "vulkan/vulkan.hpp"
+
+// Forward Declarations
+class ThreadWorker;
+template<typename T_GFXAPI> class CommandList;
+template<typename T_GFXAPI> class Drawable;
+template<typename T_GFXAPI> class RenderContext;
+
+
+/// Records the drawables of a render pass in parallel.
+/// The drawable list is partitioned in to contiguous ranges ('slots'), each slot is recorded (on a ThreadWorker thread, or the
+/// calling thread) in to its own secondary CommandList allocated from a command pool owned by that slot for the current frame,
+/// then the secondary command lists are executed (in order) from the primary command list.
+/// @ingroup Material
+class ParallelDrawableRecorder
+{
+    ParallelDrawableRecorder( const ParallelDrawableRecorder& ) = delete;
+    ParallelDrawableRecorder& operator=( const ParallelDrawableRecorder& ) = delete;
+public:
+    struct Config
+    {
+        uint32_t MaxSlots = 0;              ///< maximum number of ranges (secondary command lists) per Record, 0 for the number of worker threads + 1
+        uint32_t MinDrawablesPerSlot = 64;  ///< smallest range worth recording in its own secondary command list
+        /// Sort each slot's draws by state and skip redundant binds (see DrawableQueue).
+        /// Drawables are queued with no depth, so this changes draw order in ways only an opaque (depth tested, unblended) pass is
+        /// insensitive to; leave false for blended passes, or anything else that relies on the drawables being recorded in order.
+        bool     SortDraws = false;
+    };
+
+    /// Cpu timings (and counts) of the last Record
+    struct Timings
+    {
+        double                  TotalMs = 0.0;          ///< wall time of Record (partition, record, execute)
+        double                  SlowestSlotMs = 0.0;
+        std::vector<double>     SlotMs;                 ///< recording time of each slot
+        uint32_t                NumDrawables = 0;
+        DrawStateCache::Stats   BindStats;              ///< summed over the slots (only when Config::SortDraws)
+    };
+
+    ParallelDrawableRecorder( Vulkan& vulkan, ThreadWorker& threadWorker ) noexcept;
+    ~ParallelDrawableRecorder();
+
+    /// @param numFrameBuffers number of frames that may be in flight (each has its own command pools)
+    bool Initialize( const Config& config, uint32_t numFrameBuffers, uint32_t queueIndex = Vulkan::eGraphicsQueue );
+    void Destroy();
+
+    /// Reset the command pools of the given frame, ready for recording.  Call once per frame (after the frame's fence has been waited on), before Record.
+    bool BeginFrame( uint32_t frameIdx );
+
+    /// Record the passes (for passIdx) of the drawables in to secondary command lists and execute them from primaryCmdList.
+    /// primaryCmdList must be inside the render pass described by renderContext (begun with secondary command buffer contents).
+    /// Must not be called from one of the ThreadWorker's threads.
+    /// Draws are recorded in drawables order unless Config::SortDraws is set (opaque passes only).
+    bool Record( CommandList<Vulkan>& primaryCmdList, const RenderContext<Vulkan>& renderContext, std::span<const Drawable<Vulkan>* const> drawables, uint32_t passIdx, uint32_t frameIdx );
+
+    const Timings& GetLastTimings() const       { return m_Timings; }
+    const Config& GetConfig() const             { return m_Config; }
+    void SetConfig( const Config& config )      { m_Config = config; }  ///< MaxSlots larger than the initialized value is clamped
+
+private:
+    /// Per slot (per frame) recording state.  Only ever used by one thread at a time.
+    struct SlotFrame
+    {
+        VkCommandPool                                       CommandPool = VK_NULL_HANDLE;
+        std::vector<std::unique_ptr<CommandList<Vulkan>>>   CommandLists;   ///< allocated from CommandPool (reused each frame)
+        uint32_t                                            NumUsed = 0;    ///< CommandLists used since BeginFrame
+    };
+    struct Slot
+    {
+        std::vector<SlotFrame>                              Frames;         ///< [frameIdx]
+        DrawableQueue<Vulkan>                               Queue;
+    };
+
+    CommandList<Vulkan>* AcquireCommandList( Slot& slot, uint32_t frameIdx, uint32_t slotIdx );
+    bool RecordSlot( Slot& slot, CommandList<Vulkan>& cmdList, const RenderContext<Vulkan>& renderContext, std::span<const Drawable<Vulkan>* const> drawables, uint32_t passIdx, uint32_t frameIdx, double& elapsedMs );
+
+    Vulkan&                             m_Vulkan;
+    ThreadWorker&                       m_ThreadWorker;
+    Config                              m_Config;
+    uint32_t                            m_QueueIndex = 0;
+    std::vector<std::unique_ptr<Slot>>  m_Slots;
+    Timings                             m_Timings;
+};
@@ -39,8 +39,10 @@ bool PipelineLayout<Vulkan>::Init(Vulkan& vulkan, const std::span<const Descript
 	assert(rootSamplers.empty());	// not supported in Vulkan
 	std::vector<VkDescriptorSetLayout> vkDescriptorSetLayouts;
 	vkDescriptorSetLayouts.reserve(descriptorSetLayouts.size());
+	bool bindless = false;
 	for (const auto& descriptorSetLayout : descriptorSetLayouts)
 	{
+		bindless |= descriptorSetLayout.IsBindless();
 		VkDescriptorSetLayout vkDescriptorSetLayout = descriptorSetLayout.GetVkDescriptorSetLayout();
 		if (vkDescriptorSetLayout == VK_NULL_HANDLE)
 			// early exit if we dont have a 'solid' descriptor set layout yet!
@@ -48,15 +50,20 @@ bool PipelineLayout<Vulkan>::Init(Vulkan& vulkan, const std::span<const Descript
 		vkDescriptorSetLayouts.push_back(vkDescriptorSetLayout);
 	}
 
+	// Bindless materials pass their material id as a push constant.
+	if (bindless)
+		return Init(vulkan, vkDescriptorSetLayouts, { &BindlessDescriptorHeap::cPushConstantRange, 1 });
 	return Init(vulkan, vkDescriptorSetLayouts);
 }
 
-bool PipelineLayout<Vulkan>::Init(Vulkan& vulkan, const std::span<const VkDescriptorSetLayout> vkDescriptorSetLayouts)
+bool PipelineLayout<Vulkan>::Init(Vulkan& vulkan, const std::span<const VkDescriptorSetLayout> vkDescriptorSetLayouts, const std::span<const VkPushConstantRange> pushConstantRanges)
 {
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
 	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutInfo.setLayoutCount = (uint32_t)vkDescriptorSetLayouts.size();
 	pipelineLayoutInfo.pSetLayouts = vkDescriptorSetLayouts.data();
+	pipelineLayoutInfo.pushConstantRangeCount = (uint32_t)pushConstantRanges.size();
+	pipelineLayoutInfo.pPushConstantRanges = pushConstantRanges.data();
 
 	VkResult retVal = vkCreatePipelineLayout(vulkan.m_VulkanDevice, &pipelineLayoutInfo, NULL, &m_pipelineLayout);
 	if (!CheckVkError("vkCreatePipelineLayout()", retVal))
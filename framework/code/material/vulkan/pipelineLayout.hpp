@@ -35,7 +35,7 @@ public:
 	operator bool() const { return m_pipelineLayout != VK_NULL_HANDLE; }
 
 	bool Init(Vulkan& vulkan, const std::span<const DescriptorSetLayout<Vulkan>>, const std::span<const CreateSamplerObjectInfo>);
-	bool Init(Vulkan& vulkan, const std::span<const VkDescriptorSetLayout> vkDescriptorSetLayouts);
+	bool Init(Vulkan& vulkan, const std::span<const VkDescriptorSetLayout> vkDescriptorSetLayouts, const std::span<const VkPushConstantRange> pushConstantRanges = {});
 	void Destroy(Vulkan& vulkan);
 
 	const auto& GetVkPipelineLayout() const { return m_pipelineLayout; }
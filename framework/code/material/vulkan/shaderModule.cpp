@@ -44,8 +44,9 @@ bool ShaderModule<Vulkan>::Load(Vulkan& vulkan, AssetManager& assetManager, cons
 
     if (!m_filename.empty())
     {
-        std::vector<char> data;
-        if ( assetManager.LoadFileIntoMemory(m_filename.c_str(), data) )
+        // SPIR-V comes through the (shared) asset cache, vkCreateShaderModule takes its own copy so we do not need to hold on to the data.
+        const AssetBuffer data = assetManager.LoadFileShared(m_filename);
+        if ( data )
         {
             VkShaderModuleCreateInfo createInfo = {};
             createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
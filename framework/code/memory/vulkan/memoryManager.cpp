@@ -8,6 +8,7 @@
 
 #include "memoryManager.hpp"
 #include "vulkan/vulkan.hpp"
+#include "vulkan/descriptorUpdateBatch.hpp"
 #include <cassert>
 
 //
@@ -369,6 +370,7 @@ void MemoryManager<Vulkan>::Destroy(MemoryAllocatedBuffer<Vulkan, VkBuffer> vmaA
 {
     assert(mVmaAllocator);
     vmaDestroyBuffer(mVmaAllocator, vmaAllocatedBuffer.buffer, static_cast<VmaAllocation>(vmaAllocatedBuffer.allocation.allocation));
+    DescriptorUpdateBatch::NotifyResourceDestroyed();
     // Set the allocated buffer to a clean (deletable) state.
     vmaAllocatedBuffer.allocation.clear();
     vmaAllocatedBuffer.buffer = VK_NULL_HANDLE;
@@ -381,6 +383,7 @@ void MemoryManager<Vulkan>::Destroy(MemoryAllocatedBuffer<Vulkan, VkImage> vmaAl
 {
     assert(mVmaAllocator);
     vmaDestroyImage(mVmaAllocator, vmaAllocatedImage.buffer, static_cast<VmaAllocation>(vmaAllocatedImage.allocation.allocation));
+    DescriptorUpdateBatch::NotifyResourceDestroyed();
     // Set the allocated buffer to a clean (deletable) state.
     vmaAllocatedImage.allocation.clear();
     vmaAllocatedImage.buffer = VK_NULL_HANDLE;
@@ -404,6 +407,7 @@ MemoryAllocatedBuffer<Vulkan, VkDeviceMemory> MemoryManager<Vulkan>::DestroyBuff
 {
     assert(mVmaAllocator);
     vkDestroyBuffer(mGpuDevice, vmaAllocatedBuffer.buffer, nullptr);
+    DescriptorUpdateBatch::NotifyResourceDestroyed();
     MemoryAllocatedBuffer<Vulkan, VkDeviceMemory> allocatedMemory;
     allocatedMemory.buffer = static_cast<VmaAllocation>(vmaAllocatedBuffer.allocation.allocation)->GetMemory();
     allocatedMemory.allocation = std::move(vmaAllocatedBuffer.allocation);
@@ -416,6 +420,7 @@ MemoryAllocatedBuffer<Vulkan, VkDeviceMemory> MemoryManager<Vulkan>::DestroyBuff
 {
     assert(mVmaAllocator);
     vkDestroyImage(mGpuDevice, vmaAllocatedImage.buffer, nullptr);
+    DescriptorUpdateBatch::NotifyResourceDestroyed();
     MemoryAllocatedBuffer<Vulkan, VkDeviceMemory> allocatedMemory;
     allocatedMemory.buffer = static_cast<VmaAllocation>(vmaAllocatedImage.allocation.allocation)->GetMemory();
     allocatedMemory.allocation = std::move(vmaAllocatedImage.allocation);
@@ -458,6 +463,14 @@ void MemoryManager<Vulkan>::UnmapInternal(void* vmaAllocation, void* cpuLocation
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool MemoryManager<Vulkan>::FlushMapped(const MemoryCpuMappedUntyped<Vulkan>& mapped, size_t offset, size_t size)
+{
+    assert(mapped.mCpuLocation);
+    return vmaFlushAllocation(mVmaAllocator, static_cast<VmaAllocation>(mapped.mAllocation.allocation), offset, size) == VK_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 MemoryPool<Vulkan> MemoryManager<Vulkan>::CreateCustomPool( uint32_t typeIndex, uint32_t poolAllocationSize, uint32_t maxPoolAllocations, uint32_t bufferUsageFlag, uint32_t imageUsageFlag ) const
 {
     VmaPoolCreateInfo poolCreateInfo{
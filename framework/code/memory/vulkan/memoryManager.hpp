@@ -148,7 +148,12 @@ public:
     template<typename T_VKTYPE>
     void Unmap(MemoryAllocatedBuffer<Vulkan, T_VKTYPE>& buffer, MemoryCpuMappedUntyped<Vulkan> allocation);
 
+    /// Make cpu writes to a range of mapped memory visible to the gpu.  Needed when the memory is not HOST_COHERENT (does nothing if it is).
+    /// @param offset, size relative to the start of the mapped allocation (rounded out to nonCoherentAtomSize)
+    bool FlushMapped(const MemoryCpuMappedUntyped<Vulkan>& mapped, size_t offset, size_t size);
+
     /// Copy data in one buffer into another.  Assumes buffers created with appropriate VK_BUFFER_USAGE_TRANSFER_SRC_BIT and VK_BUFFER_USAGE_TRANSFER_DST_BIT
+    /// Only records a device side vkCmdCopyBuffer in to vkCommandBuffer (no staging, submit or wait).  To get cpu data in to a gpu buffer use UploadManager::Upload.
     bool CopyData(VkCommandBuffer vkCommandBuffer, const MemoryAllocatedBuffer<Vulkan, VkBuffer>& src, MemoryAllocatedBuffer<Vulkan, VkBuffer>& dst, size_t copySize, size_t srcOffset = 0, size_t dstOffset = 0);
 
     /// Query the device address (assuming that Vulkan extension was enabled)
@@ -0,0 +1,555 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "uploadManager.hpp"
+#include "memoryManager.hpp"
+#include "vulkan/extensionLib.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <iterator>
+
+
+///////////////////////////////////////////////////////////////////////////////
+// UploadManager
+///////////////////////////////////////////////////////////////////////////////
+
+UploadManager::UploadManager() noexcept
+{}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UploadManager::~UploadManager()
+{
+    Destroy();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool UploadManager::Initialize( const Config& config, std::unique_ptr<Backend> backend )
+{
+    Destroy();
+    if (!backend)
+        return false;
+    std::span<std::byte> stagingMemory = backend->GetStagingMemory();
+    // Ring capacity must be a multiple of the alignment, and at least 2 aligned chunks (uploads are split in to chunks of up to half the ring).
+    stagingMemory = stagingMemory.first( stagingMemory.size() & ~(cAlignment - 1) );
+    if (stagingMemory.size() < 2 * cAlignment)
+    {
+        LOGE( "UploadManager: staging memory too small (%zu bytes)", stagingMemory.size() );
+        return false;
+    }
+    m_Config = config;
+    m_Backend = std::move( backend );
+    m_StagingMemory = stagingMemory;
+    m_Ring.Reset( m_StagingMemory.size() );
+    m_PendingTicket = m_Backend->GetCompletedTicket() + 1;
+    m_LastCompletedTicket = m_PendingTicket - 1;
+    m_Ring.BeginFrame( (uint32_t) m_PendingTicket, TicketFence{ m_Backend.get(), m_PendingTicket } );
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UploadManager::Destroy()
+{
+    if (m_Backend)
+        m_Backend->Wait( m_PendingTicket - 1 );
+    m_PendingCopies.clear();
+    m_PendingRanges.clear();
+    m_PendingBytes = 0;
+    m_PendingUploads = 0;
+    m_Ring.Reset( 0 );
+    m_StagingMemory = {};
+    m_Backend.reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UploadManager::Ticket UploadManager::Upload( VkBuffer dstBuffer, size_t dstOffset, std::span<const std::byte> data )
+{
+    if (!m_Backend || dstBuffer == VK_NULL_HANDLE)
+        return cInvalidTicket;
+    if (data.empty())
+        return m_PendingTicket;
+    if (!m_FirstUploadTime)
+        m_FirstUploadTime = std::chrono::steady_clock::now();
+    ++m_Stats.Uploads;
+
+    // Chunks of at most half the ring always fit once the older batches have completed (even if the ring has to wrap).
+    const size_t maxChunkSize = (m_StagingMemory.size() / 2) & ~(cAlignment - 1);
+    Ticket ticket = cInvalidTicket;
+    while (!data.empty())
+    {
+        const size_t chunkSize = std::min( data.size(), maxChunkSize );
+        ticket = UploadChunk( dstBuffer, dstOffset, data.first( chunkSize ) );
+        if (ticket == cInvalidTicket)
+            return cInvalidTicket;
+        dstOffset += chunkSize;
+        data = data.subspan( chunkSize );
+    }
+    return ticket;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UploadManager::Ticket UploadManager::UploadChunk( VkBuffer dstBuffer, size_t dstOffset, std::span<const std::byte> data )
+{
+    // Copies in one batch are not ordered with respect to each other, so an overlapping upload has to go in the next batch.
+    if (OverlapsPending( dstBuffer, dstOffset, dstOffset + data.size() ))
+    {
+        ++m_Stats.OverlapFlushes;
+        Flush();
+    }
+    else if (m_PendingUploads >= m_Config.MaxCopiesPerSubmit)
+    {
+        Flush();
+    }
+
+    const uint32_t ringWaits = m_Ring.GetStats().FenceWaits;
+    size_t stagingOffset = m_Ring.Allocate( data.size(), cAlignment );
+    if (stagingOffset == FrameRingAllocator<TicketFence>::cInvalidOffset)
+    {
+        // Pending batch has filled the ring, submit it and wait for space.
+        Flush();
+        stagingOffset = m_Ring.Allocate( data.size(), cAlignment );
+        if (stagingOffset == FrameRingAllocator<TicketFence>::cInvalidOffset)
+        {
+            LOGE( "UploadManager: failed to allocate %zu bytes of staging memory", data.size() );
+            return cInvalidTicket;
+        }
+    }
+    m_Stats.RingWaits += m_Ring.GetStats().FenceWaits - ringWaits;
+
+    std::memcpy( m_StagingMemory.data() + stagingOffset, data.data(), data.size() );
+    m_PendingCopies.push_back( { dstBuffer, VkBufferCopy{ stagingOffset, dstOffset, data.size() } } );
+    m_PendingRanges[dstBuffer].emplace( dstOffset, dstOffset + data.size() );
+    m_PendingBytes += data.size();
+    ++m_PendingUploads;
+    m_Stats.BytesUploaded += data.size();
+
+    const Ticket ticket = m_PendingTicket;
+    if (m_PendingBytes >= m_Config.FlushThreshold)
+        Flush();
+    return ticket;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool UploadManager::OverlapsPending( VkBuffer buffer, size_t begin, size_t end ) const
+{
+    const auto rangesIt = m_PendingRanges.find( buffer );
+    if (rangesIt == m_PendingRanges.end())
+        return false;
+    const auto& ranges = rangesIt->second;
+    // Pending ranges do not overlap each other, so only the ranges either side of begin need checking.
+    auto it = ranges.upper_bound( begin );
+    if (it != ranges.end() && it->first < end)
+        return true;
+    return it != ranges.begin() && std::prev( it )->second > begin;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UploadManager::Ticket UploadManager::Flush()
+{
+    if (m_PendingCopies.empty())
+        return m_PendingTicket - 1;
+
+    // Group by destination and merge copies that are contiguous in both the staging ring and the destination.
+    std::sort( m_PendingCopies.begin(), m_PendingCopies.end(), []( const PendingCopy& a, const PendingCopy& b ) {
+        return a.Buffer != b.Buffer ? std::less<VkBuffer>()( a.Buffer, b.Buffer ) : a.Region.dstOffset < b.Region.dstOffset;
+    } );
+    m_SubmitRegions.clear();
+    m_SubmitRegions.reserve( m_PendingCopies.size() );
+    std::vector<std::pair<VkBuffer, size_t>> destinations;  // buffer, first region
+    for (const auto& copy : m_PendingCopies)
+    {
+        if (destinations.empty() || destinations.back().first != copy.Buffer)
+        {
+            destinations.push_back( { copy.Buffer, m_SubmitRegions.size() } );
+            m_SubmitRegions.push_back( copy.Region );
+            continue;
+        }
+        auto& last = m_SubmitRegions.back();
+        if (last.srcOffset + last.size == copy.Region.srcOffset && last.dstOffset + last.size == copy.Region.dstOffset)
+            last.size += copy.Region.size;
+        else
+            m_SubmitRegions.push_back( copy.Region );
+    }
+    m_SubmitCopies.clear();
+    for (size_t i = 0; i < destinations.size(); ++i)
+    {
+        const size_t end = i + 1 < destinations.size() ? destinations[i + 1].second : m_SubmitRegions.size();
+        m_SubmitCopies.push_back( { destinations[i].first, std::span<const VkBufferCopy>( m_SubmitRegions ).subspan( destinations[i].second, end - destinations[i].second ) } );
+    }
+
+    const Ticket ticket = m_PendingTicket;
+    if (!m_Backend->Submit( m_SubmitCopies, ticket ))
+    {
+        // Uploads are lost, the ring space stays with the (next) pending batch and is released when that completes.
+        LOGE( "UploadManager: failed to submit %zu uploads", m_PendingCopies.size() );
+        m_PendingCopies.clear();
+        m_PendingRanges.clear();
+        m_PendingBytes = 0;
+        m_PendingUploads = 0;
+        return cInvalidTicket;
+    }
+    ++m_Stats.Submits;
+    m_Stats.Copies += (uint32_t) m_SubmitRegions.size();
+    m_PendingCopies.clear();
+    m_PendingRanges.clear();
+    m_PendingBytes = 0;
+    m_PendingUploads = 0;
+
+    // Close this batch's ring 'frame' (released once ticket completes) and start the next.  Tickets are unique (for far longer than any
+    // batch is in flight) so the ring never releases a batch by index, only by testing its ticket.
+    ++m_PendingTicket;
+    m_Ring.BeginFrame( (uint32_t) m_PendingTicket, TicketFence{ m_Backend.get(), m_PendingTicket } );
+    return ticket;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool UploadManager::IsComplete( Ticket ticket ) const
+{
+    if (ticket >= m_PendingTicket || !m_Backend)
+        return false;
+    return m_Backend->GetCompletedTicket() >= ticket;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UploadManager::Wait( Ticket ticket )
+{
+    if (!m_Backend || ticket == cInvalidTicket)
+        return;
+    if (ticket >= m_PendingTicket)
+        Flush();
+    m_Backend->Wait( std::min( ticket, m_PendingTicket - 1 ) );
+    ObserveCompletion();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UploadManager::WaitIdle()
+{
+    Wait( m_PendingTicket );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UploadManager::Update()
+{
+    if (m_Backend)
+        ObserveCompletion();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UploadManager::ObserveCompletion()
+{
+    const Ticket completed = m_Backend->GetCompletedTicket();
+    if (completed > m_LastCompletedTicket)
+    {
+        m_LastCompletedTicket = completed;
+        if (m_FirstUploadTime)
+            m_Stats.Seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - *m_FirstUploadTime ).count();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UploadManager::LogStats()
+{
+    Update();
+    LOGI( "UploadManager: %u uploads (%zu bytes) in %u submits, %.1f uploads/submit, %.1f copies/submit, %u ring waits, %u overlap flushes, %.1f MB/s",
+          m_Stats.Uploads, m_Stats.BytesUploaded, m_Stats.Submits, m_Stats.UploadsPerSubmit(), m_Stats.CopiesPerSubmit(), m_Stats.RingWaits, m_Stats.OverlapFlushes, m_Stats.MegabytesPerSecond() );
+    ResetStats();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// UploadBackendVulkan
+///////////////////////////////////////////////////////////////////////////////
+
+UploadBackendVulkan::UploadBackendVulkan( Vulkan& vulkan ) noexcept : m_Vulkan( vulkan )
+{}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UploadBackendVulkan::~UploadBackendVulkan()
+{
+    Destroy();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool UploadBackendVulkan::Initialize( size_t stagingSize, uint32_t queueIndex, uint32_t consumerQueueIndex )
+{
+    assert( m_CommandPool == VK_NULL_HANDLE );
+    if (m_Vulkan.m_VulkanQueues[queueIndex].Queue == VK_NULL_HANDLE)
+    {
+        LOGI( "UploadBackendVulkan: queue %u not available, uploading on the graphics queue", queueIndex );
+        queueIndex = Vulkan::eGraphicsQueue;
+    }
+
+    // Timeline semaphores are core in Vulkan 1.2 (the core entry points are not available on a 1.1 device, the KHR ones are).
+    const auto* pTimelineExt = m_Vulkan.GetExtension<ExtensionLib::Ext_VK_KHR_timeline_semaphore>();
+    if (!pTimelineExt || pTimelineExt->Status != VulkanExtensionStatus::eLoaded || !pTimelineExt->RequestedFeatures.timelineSemaphore)
+    {
+        LOGE( "UploadBackendVulkan: timeline semaphores not enabled (request ExtensionLib::Ext_VK_KHR_timeline_semaphore)" );
+        return false;
+    }
+    m_vkGetSemaphoreCounterValue = vkGetSemaphoreCounterValue ? vkGetSemaphoreCounterValue : vkGetSemaphoreCounterValueKHR;
+    m_vkWaitSemaphores = vkWaitSemaphores ? vkWaitSemaphores : vkWaitSemaphoresKHR;
+    if (!m_vkGetSemaphoreCounterValue || !m_vkWaitSemaphores)
+    {
+        LOGE( "UploadBackendVulkan: timeline semaphore functions not found" );
+        return false;
+    }
+
+    m_QueueIndex = queueIndex;
+    m_QueueFamilyIndex = (uint32_t) m_Vulkan.m_VulkanQueues[queueIndex].QueueFamilyIndex;
+    m_ConsumerQueueFamilyIndex = (uint32_t) m_Vulkan.m_VulkanQueues[consumerQueueIndex].QueueFamilyIndex;
+
+    auto& memoryManager = m_Vulkan.GetMemoryManager();
+    m_StagingSize = stagingSize;
+    m_StagingBuffer = memoryManager.CreateBuffer( stagingSize, BufferUsageFlags::TransferSrc, MemoryUsage::CpuToGpu );
+    if (!m_StagingBuffer)
+    {
+        LOGE( "UploadBackendVulkan: failed to create staging buffer (%zu bytes)", stagingSize );
+        Destroy();
+        return false;
+    }
+    m_StagingMapped.emplace( memoryManager.Map<std::byte>( m_StagingBuffer ) );
+    if (m_StagingMapped->data() == nullptr)
+    {
+        LOGE( "UploadBackendVulkan: failed to map staging buffer" );
+        Destroy();
+        return false;
+    }
+
+    VkSemaphoreTypeCreateInfo timelineInfo{ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+                                            .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+                                            .initialValue = UploadManager::cInvalidTicket };
+    VkSemaphoreCreateInfo semaphoreInfo{ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+                                         .pNext = &timelineInfo };
+    if (!CheckVkError( "vkCreateSemaphore()", vkCreateSemaphore( m_Vulkan.m_VulkanDevice, &semaphoreInfo, nullptr, &m_TimelineSemaphore ) ))
+    {
+        Destroy();
+        return false;
+    }
+
+    const VkCommandPoolCreateInfo cmdPoolInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+        .queueFamilyIndex = m_QueueFamilyIndex
+    };
+    if (!CheckVkError( "vkCreateCommandPool()", vkCreateCommandPool( m_Vulkan.m_VulkanDevice, &cmdPoolInfo, nullptr, &m_CommandPool ) ))
+    {
+        Destroy();
+        return false;
+    }
+    LOGI( "UploadBackendVulkan: %zu byte staging ring, queue %u (family %u)%s", stagingSize, m_QueueIndex, m_QueueFamilyIndex, NeedsOwnershipTransfer() ? ", with queue family ownership transfer" : "" );
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UploadBackendVulkan::Destroy()
+{
+    if (m_TimelineSemaphore != VK_NULL_HANDLE && !m_InFlightCommandBuffers.empty())
+        Wait( m_InFlightCommandBuffers.back().Ticket );
+    if (m_CommandPool != VK_NULL_HANDLE)
+    {
+        // Command buffers are freed with the pool.
+        vkDestroyCommandPool( m_Vulkan.m_VulkanDevice, m_CommandPool, nullptr );
+        m_CommandPool = VK_NULL_HANDLE;
+    }
+    m_InFlightCommandBuffers.clear();
+    m_FreeCommandBuffers.clear();
+    m_PendingAcquireBarriers.clear();
+    if (m_TimelineSemaphore != VK_NULL_HANDLE)
+    {
+        vkDestroySemaphore( m_Vulkan.m_VulkanDevice, m_TimelineSemaphore, nullptr );
+        m_TimelineSemaphore = VK_NULL_HANDLE;
+    }
+    auto& memoryManager = m_Vulkan.GetMemoryManager();
+    if (m_StagingMapped.has_value())
+    {
+        if (m_StagingMapped->data() != nullptr)
+            memoryManager.Unmap( m_StagingBuffer, std::move( *m_StagingMapped ) );
+        m_StagingMapped.reset();
+    }
+    if (m_StagingBuffer)
+        memoryManager.Destroy( std::move( m_StagingBuffer ) );
+    m_StagingSize = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::span<std::byte> UploadBackendVulkan::GetStagingMemory()
+{
+    if (!m_StagingMapped.has_value())
+        return {};
+    return { m_StagingMapped->data(), m_StagingSize };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+VkCommandBuffer UploadBackendVulkan::AcquireCommandBuffer()
+{
+    // Recycle the command buffers of completed batches.
+    const UploadManager::Ticket completed = GetCompletedTicket();
+    while (!m_InFlightCommandBuffers.empty() && m_InFlightCommandBuffers.front().Ticket <= completed)
+    {
+        m_FreeCommandBuffers.push_back( m_InFlightCommandBuffers.front().CmdBuffer );
+        m_InFlightCommandBuffers.pop_front();
+    }
+    if (!m_FreeCommandBuffers.empty())
+    {
+        VkCommandBuffer cmdBuffer = m_FreeCommandBuffers.back();
+        m_FreeCommandBuffers.pop_back();
+        return cmdBuffer;
+    }
+    VkCommandBufferAllocateInfo allocateInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+    allocateInfo.commandPool = m_CommandPool;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = 1;
+    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+    if (!CheckVkError( "vkAllocateCommandBuffers()", vkAllocateCommandBuffers( m_Vulkan.m_VulkanDevice, &allocateInfo, &cmdBuffer ) ))
+        return VK_NULL_HANDLE;
+    return cmdBuffer;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool UploadBackendVulkan::Submit( std::span<const UploadManager::DestinationCopies> copies, UploadManager::Ticket ticket )
+{
+    // Flush the staged data (in case the staging memory is not host coherent).  One range, covering every copy (a wrapped ring flushes most of the ring).
+    size_t flushBegin = m_StagingSize;
+    size_t flushEnd = 0;
+    for (const auto& destination : copies)
+        for (const auto& region : destination.Regions)
+        {
+            flushBegin = std::min( flushBegin, (size_t) region.srcOffset );
+            flushEnd = std::max( flushEnd, (size_t) (region.srcOffset + region.size) );
+        }
+    if (flushBegin < flushEnd && !m_Vulkan.GetMemoryManager().FlushMapped( *m_StagingMapped, flushBegin, flushEnd - flushBegin ))
+    {
+        LOGE( "UploadBackendVulkan: failed to flush the staging buffer" );
+        return false;
+    }
+
+    VkCommandBuffer cmdBuffer = AcquireCommandBuffer();
+    if (cmdBuffer == VK_NULL_HANDLE)
+        return false;
+
+    VkCommandBufferBeginInfo beginInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (!CheckVkError( "vkBeginCommandBuffer()", vkBeginCommandBuffer( cmdBuffer, &beginInfo ) ))
+    {
+        m_FreeCommandBuffers.push_back( cmdBuffer );
+        return false;
+    }
+
+    // Order against the previous batch's copies (a destination may be written by consecutive batches).
+    VkMemoryBarrier memoryBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr );
+
+    m_ReleaseBarriers.clear();
+    for (const auto& destination : copies)
+    {
+        vkCmdCopyBuffer( cmdBuffer, m_StagingBuffer.GetVkBuffer(), destination.Buffer, (uint32_t) destination.Regions.size(), destination.Regions.data() );
+        if (NeedsOwnershipTransfer())
+        {
+            for (const auto& region : destination.Regions)
+            {
+                VkBufferMemoryBarrier barrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.srcQueueFamilyIndex = m_QueueFamilyIndex;
+                barrier.dstQueueFamilyIndex = m_ConsumerQueueFamilyIndex;
+                barrier.buffer = destination.Buffer;
+                barrier.offset = region.dstOffset;
+                barrier.size = region.size;
+                m_ReleaseBarriers.push_back( barrier );
+            }
+        }
+    }
+    if (!m_ReleaseBarriers.empty())
+    {
+        vkCmdPipelineBarrier( cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, (uint32_t) m_ReleaseBarriers.size(), m_ReleaseBarriers.data(), 0, nullptr );
+    }
+    if (!CheckVkError( "vkEndCommandBuffer()", vkEndCommandBuffer( cmdBuffer ) ))
+    {
+        m_FreeCommandBuffers.push_back( cmdBuffer );
+        return false;
+    }
+
+    VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+    timelineSubmitInfo.signalSemaphoreValueCount = 1;
+    timelineSubmitInfo.pSignalSemaphoreValues = &ticket;
+    VkSubmitInfo submitInfo{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
+    submitInfo.pNext = &timelineSubmitInfo;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &cmdBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &m_TimelineSemaphore;
+    if (!m_Vulkan.QueueSubmit( std::span<const VkSubmitInfo>( &submitInfo, 1 ), m_QueueIndex, VK_NULL_HANDLE ))
+    {
+        m_FreeCommandBuffers.push_back( cmdBuffer );
+        return false;
+    }
+    m_InFlightCommandBuffers.push_back( { cmdBuffer, ticket } );
+
+    // Matching acquires (same buffer ranges) for the consumer queue.
+    for (auto barrier : m_ReleaseBarriers)
+    {
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+        m_PendingAcquireBarriers.push_back( barrier );
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+UploadManager::Ticket UploadBackendVulkan::GetCompletedTicket() const
+{
+    uint64_t value = UploadManager::cInvalidTicket;
+    CheckVkError( "vkGetSemaphoreCounterValue()", m_vkGetSemaphoreCounterValue( m_Vulkan.m_VulkanDevice, m_TimelineSemaphore, &value ) );
+    return value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UploadBackendVulkan::Wait( UploadManager::Ticket ticket ) const
+{
+    if (ticket == UploadManager::cInvalidTicket)
+        return;
+    VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_TimelineSemaphore;
+    waitInfo.pValues = &ticket;
+    CheckVkError( "vkWaitSemaphores()", m_vkWaitSemaphores( m_Vulkan.m_VulkanDevice, &waitInfo, UINT64_MAX ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UploadBackendVulkan::RecordAcquireBarriers( VkCommandBuffer consumerCmdBuffer )
+{
+    if (m_PendingAcquireBarriers.empty())
+        return;
+    vkCmdPipelineBarrier( consumerCmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, (uint32_t) m_PendingAcquireBarriers.size(), m_PendingAcquireBarriers.data(), 0, nullptr );
+    m_PendingAcquireBarriers.clear();
+}
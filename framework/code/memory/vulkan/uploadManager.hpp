@@ -0,0 +1,215 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <volk/volk.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "vulkan/frameRingBuffer.hpp"
+#include "vulkan/vulkan.hpp"
+
+
+/// Batches buffer uploads through a persistently mapped staging ring.
+/// Upload copies the data in to the ring and queues a copy to the destination, copies are coalesced (per destination buffer) and
+/// submitted in batches (on Flush, or once a batch is big enough).  Each batch is identified by a Ticket which consumers can test or wait on.
+/// Ring space is reused once the batch that used it has completed.
+///
+/// Submission (and completion) goes through a Backend, UploadBackendVulkan for the transfer queue, or a mock backend for testing the
+/// ring and batching logic without a device.
+/// MeshHelper::CreateMesh has an overload that uploads through an UploadManager (in to GpuExclusive buffers).
+/// Not thread safe.
+/// @ingroup Memory
+class UploadManager
+{
+    UploadManager( const UploadManager& ) = delete;
+    UploadManager& operator=( const UploadManager& ) = delete;
+public:
+    /// Batch identifier, increases by one for every submitted batch.  Batch n is complete once the backend's completed ticket is >= n.
+    using Ticket = uint64_t;
+    static constexpr Ticket cInvalidTicket = 0;
+
+    /// Copies to one destination buffer (non overlapping, so one vkCmdCopyBuffer), srcOffset is relative to the start of the staging memory.
+    struct DestinationCopies
+    {
+        VkBuffer                        Buffer = VK_NULL_HANDLE;
+        std::span<const VkBufferCopy>   Regions;
+    };
+
+    /// Interface to the queue the copies are submitted to.
+    class Backend
+    {
+    public:
+        virtual ~Backend() = default;
+        /// Persistently mapped staging memory (the copy source).
+        virtual std::span<std::byte> GetStagingMemory() = 0;
+        /// Submit the copies and signal ticket once they (and all previously submitted copies) have completed.
+        virtual bool Submit( std::span<const DestinationCopies> copies, Ticket ticket ) = 0;
+        /// @return the highest completed ticket
+        virtual Ticket GetCompletedTicket() const = 0;
+        /// Block until ticket is complete
+        virtual void Wait( Ticket ticket ) const = 0;
+    };
+
+    struct Config
+    {
+        size_t      FlushThreshold = 4 * 1024 * 1024;  ///< batch is submitted once it holds this many bytes (and on Flush)
+        uint32_t    MaxCopiesPerSubmit = 1024;          ///< batch is submitted once it holds this many uploads
+    };
+
+    struct Stats
+    {
+        uint32_t    Uploads = 0;            ///< Upload calls
+        uint32_t    Copies = 0;             ///< copy regions submitted (after coalescing)
+        uint32_t    Submits = 0;
+        uint32_t    RingWaits = 0;          ///< times an upload had to wait for a batch to complete to free ring space
+        uint32_t    OverlapFlushes = 0;     ///< batches submitted early because an upload overlapped a pending upload
+        size_t      BytesUploaded = 0;
+        double      Seconds = 0.0;          ///< from the first upload to the last observed batch completion (see Update)
+
+        double UploadsPerSubmit() const     { return Submits ? double( Uploads ) / Submits : 0.0; }
+        double CopiesPerSubmit() const      { return Submits ? double( Copies ) / Submits : 0.0; }
+        double MegabytesPerSecond() const   { return Seconds > 0.0 ? double( BytesUploaded ) / (1024.0 * 1024.0) / Seconds : 0.0; }
+    };
+
+    /// Staging ring alignment (of each upload's data)
+    static constexpr size_t cAlignment = 16;
+
+    UploadManager() noexcept;
+    ~UploadManager();
+
+    bool Initialize( const Config& config, std::unique_ptr<Backend> backend );
+    /// Wait for all submitted uploads and release the backend.  Unsubmitted uploads are discarded.
+    void Destroy();
+
+    /// Queue an upload.  data is copied immediately (and can be released), uploads larger than half the ring are split.
+    /// @return ticket of the batch containing the (last part of the) upload, cInvalidTicket on failure
+    Ticket Upload( VkBuffer dstBuffer, size_t dstOffset, std::span<const std::byte> data );
+    template<typename T>
+    Ticket Upload( VkBuffer dstBuffer, size_t dstOffset, std::span<const T> data )  { return Upload( dstBuffer, dstOffset, std::as_bytes( data ) ); }
+
+    /// Submit the pending batch (if any).
+    /// @return ticket of the last submitted batch (cInvalidTicket if nothing has been submitted)
+    Ticket Flush();
+    /// @return true if the batch has completed (false if it is not yet submitted)
+    bool IsComplete( Ticket ticket ) const;
+    /// Wait for the batch to complete, submitting it first if it is still pending.
+    void Wait( Ticket ticket );
+    /// Submit and wait for everything.
+    void WaitIdle();
+    /// Poll for completed batches (updates the throughput stats), call once per frame.
+    void Update();
+
+    /// @return ticket the next Upload will (probably) be given
+    Ticket GetPendingTicket() const         { return m_PendingTicket; }
+    Backend* GetBackend() const             { return m_Backend.get(); }
+    const Stats& GetStats() const           { return m_Stats; }
+    void ResetStats()                       { m_Stats = {}; m_FirstUploadTime.reset(); }
+    /// Log (LOGI) and reset the stats
+    void LogStats();
+
+private:
+    /// FrameRingAllocator fence for a batch ticket
+    struct TicketFence
+    {
+        const Backend*  pBackend = nullptr;
+        Ticket          Value = cInvalidTicket;
+        bool IsSignalled() const            { return pBackend->GetCompletedTicket() >= Value; }
+        void Wait() const                   { pBackend->Wait( Value ); }
+    };
+    struct PendingCopy
+    {
+        VkBuffer        Buffer;
+        VkBufferCopy    Region;
+    };
+
+    Ticket UploadChunk( VkBuffer dstBuffer, size_t dstOffset, std::span<const std::byte> data );
+    /// @return true if [begin,end) overlaps a pending upload to buffer
+    bool OverlapsPending( VkBuffer buffer, size_t begin, size_t end ) const;
+    void ObserveCompletion();
+
+    Config                                                  m_Config;
+    std::unique_ptr<Backend>                                m_Backend;
+    std::span<std::byte>                                    m_StagingMemory;
+    FrameRingAllocator<TicketFence>                         m_Ring;             ///< one ring 'frame' per batch
+    Ticket                                                  m_PendingTicket = 1;
+    Ticket                                                  m_LastCompletedTicket = cInvalidTicket;
+    std::vector<PendingCopy>                                m_PendingCopies;
+    std::unordered_map<VkBuffer, std::map<size_t, size_t>>  m_PendingRanges;    ///< per destination buffer, begin -> end of each pending upload
+    size_t                                                  m_PendingBytes = 0;
+    uint32_t                                                m_PendingUploads = 0;
+    std::vector<VkBufferCopy>                               m_SubmitRegions;    ///< scratch (for Flush)
+    std::vector<DestinationCopies>                          m_SubmitCopies;     ///< scratch (for Flush)
+    Stats                                                   m_Stats;
+    std::optional<std::chrono::steady_clock::time_point>    m_FirstUploadTime;
+};
+
+
+/// UploadManager backend submitting to a Vulkan queue (the dedicated transfer queue if the device has one), signalling a timeline semaphore with the batch ticket.
+/// Requires timeline semaphores (the application requesting ExtensionLib::Ext_VK_KHR_timeline_semaphore), uses the core entry points on Vulkan 1.2 and the KHR ones on 1.1.
+/// Staging memory need not be host coherent, the staged data is flushed before each submit.
+///
+/// Gpu consumers wait on GetVkTimelineSemaphore (for the ticket value) in their own submit.  If the upload queue is in a different
+/// queue family to the consumer queue the copies are followed by queue family ownership releases, and the consumer must call
+/// RecordAcquireBarriers (in a command buffer submitted after that wait) before using the uploaded buffers.
+/// @ingroup Memory
+class UploadBackendVulkan final : public UploadManager::Backend
+{
+    UploadBackendVulkan( const UploadBackendVulkan& ) = delete;
+    UploadBackendVulkan& operator=( const UploadBackendVulkan& ) = delete;
+public:
+    explicit UploadBackendVulkan( Vulkan& vulkan ) noexcept;
+    ~UploadBackendVulkan() override;
+
+    /// @param stagingSize size of the staging ring (bytes)
+    /// @param queueIndex queue to submit the copies on (falls back to the graphics queue if the device has no such queue)
+    /// @param consumerQueueIndex queue the uploaded buffers are used on
+    bool Initialize( size_t stagingSize, uint32_t queueIndex = Vulkan::eTransferQueue, uint32_t consumerQueueIndex = Vulkan::eGraphicsQueue );
+    void Destroy();
+
+    std::span<std::byte> GetStagingMemory() override;
+    bool Submit( std::span<const UploadManager::DestinationCopies> copies, UploadManager::Ticket ticket ) override;
+    UploadManager::Ticket GetCompletedTicket() const override;
+    void Wait( UploadManager::Ticket ticket ) const override;
+
+    VkSemaphore GetVkTimelineSemaphore() const  { return m_TimelineSemaphore; }
+    bool NeedsOwnershipTransfer() const         { return m_QueueFamilyIndex != m_ConsumerQueueFamilyIndex; }
+    /// Record the queue family ownership acquires for the buffers released by the batches submitted since the last call (nothing if no ownership transfer is needed).
+    void RecordAcquireBarriers( VkCommandBuffer consumerCmdBuffer );
+
+private:
+    struct InFlightCommandBuffer
+    {
+        VkCommandBuffer         CmdBuffer;
+        UploadManager::Ticket   Ticket;
+    };
+    VkCommandBuffer AcquireCommandBuffer();
+
+    Vulkan&                                         m_Vulkan;
+    MemoryAllocatedBuffer<Vulkan, VkBuffer>         m_StagingBuffer;
+    std::optional<MemoryCpuMapped<Vulkan, std::byte>> m_StagingMapped;
+    size_t                                          m_StagingSize = 0;
+    VkSemaphore                                     m_TimelineSemaphore = VK_NULL_HANDLE;
+    PFN_vkGetSemaphoreCounterValue                  m_vkGetSemaphoreCounterValue = nullptr;    ///< core (1.2) or KHR entry point
+    PFN_vkWaitSemaphores                            m_vkWaitSemaphores = nullptr;              ///< core (1.2) or KHR entry point
+    VkCommandPool                                   m_CommandPool = VK_NULL_HANDLE;
+    std::deque<InFlightCommandBuffer>               m_InFlightCommandBuffers;   ///< oldest first
+    std::vector<VkCommandBuffer>                    m_FreeCommandBuffers;
+    uint32_t                                        m_QueueIndex = 0;
+    uint32_t                                        m_QueueFamilyIndex = 0;
+    uint32_t                                        m_ConsumerQueueFamilyIndex = 0;
+    std::vector<VkBufferMemoryBarrier>              m_PendingAcquireBarriers;
+    std::vector<VkBufferMemoryBarrier>              m_ReleaseBarriers;          ///< scratch (for Submit)
+};
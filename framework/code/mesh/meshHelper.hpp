@@ -16,6 +16,8 @@
 
 // Forward declarations
 class MeshObjectIntermediate;
+class UploadManager;
+class Vulkan;
 template<typename T_GFXAPI> class MemoryManager;
 
 
@@ -45,6 +47,14 @@ struct MeshHelper
     template<typename T_GFXAPI>
     static bool CreateMesh(MemoryManager<T_GFXAPI>& memoryManager, const MeshObjectIntermediate& meshObject, uint32_t bindingIndex, const std::span<const VertexFormat> pVertexFormat, Mesh<T_GFXAPI>* meshObjectOut);
 
+    /// @brief Create a renderable Mesh in gpu only memory, with the vertex and index data uploaded through the UploadManager (Vulkan only).
+    /// Same layout as CreateMesh, but without host visible vertex/index buffers and with the copies batched with other uploads.
+    /// The mesh must not be drawn until the upload has completed (UploadManager::Wait/IsComplete on the ticket, or a gpu wait on
+    /// UploadBackendVulkan's timeline semaphore followed by its RecordAcquireBarriers).
+    /// @param ticketOut UploadManager::Ticket of the last upload (cInvalidTicket if there was nothing to upload)
+    /// @return true on success
+    static bool CreateMesh(MemoryManager<Vulkan>& memoryManager, UploadManager& uploadManager, const MeshObjectIntermediate& meshObject, uint32_t bindingIndex, const std::span<const VertexFormat> pVertexFormat, Mesh<Vulkan>* meshObjectOut, uint64_t& ticketOut);
+
     /// Helper to create a IndexBuffer object, IF the mesh object has index buffer data.
     /// @returns true on success (including no index buffer data existing in IndexBuffer object), false on error.
     template<typename T_GFXAPI>
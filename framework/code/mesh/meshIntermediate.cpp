@@ -159,6 +159,19 @@ static void CalculateTangentAndBitangent(const float* objNormal, const glm::vec3
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/// @return true if gltf extras (node or mesh) flag the object as an occluder ("occluder": true or non zero, eg a Blender custom property)
+static bool IsOccluderExtras(const tinygltf::Value& extras)
+{
+    if (!extras.IsObject() || !extras.Has("occluder"))
+        return false;
+    const tinygltf::Value& occluder = extras.Get("occluder");
+    if (occluder.IsBool())
+        return occluder.Get<bool>();
+    return occluder.IsInt() && occluder.Get<int>() != 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void MeshObjectIntermediate::Release()
 {
     std::vector<FatVertex>().swap(m_VertexBuffer);  // use swap so we know the memory disappears (clear may leave the memory 'reserved').
@@ -166,6 +179,7 @@ void MeshObjectIntermediate::Release()
     std::vector<MaterialDef>().swap(m_Materials);
     m_Transform = glm::identity<glm::mat4>();
     m_NodeId = -1;
+    m_Occluder = false;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -237,6 +251,7 @@ MeshObjectIntermediate MeshObjectIntermediate::CopyFlattened() const
     dst.m_Transform = m_Transform;
     dst.m_NodeId = m_NodeId;
     dst.m_WeightsPerVertex = m_WeightsPerVertex;
+    dst.m_Occluder = m_Occluder;
     return dst;
 }
 
@@ -949,6 +964,7 @@ bool MeshObjectIntermediateGltfProcessor::operator()(const tinygltf::Model& Mode
                 meshObject.m_Transform = m_ignoreTransforms ? glm::mat4{1.0f} : Transform;
                 meshObject.m_Transform[3] *= glm::vec4(m_globalScale, 1.0f);// Transform position needs scale applying, dont scale entire transform as the vertex data is scaled independantly (below).
                 meshObject.m_NodeId = (int)NodeIdx;
+                meshObject.m_Occluder = IsOccluderExtras(NodeData.extras) || IsOccluderExtras(MeshData.extras);
 
                 // Want the vertex color to be the base color from the material
                 glm::vec4 materialColor = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
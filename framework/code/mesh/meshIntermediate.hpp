@@ -153,6 +153,8 @@ public:
     int                         m_NodeId = -1;
     /// Number of joint weights per vertex (or 0)
     uint32_t                    m_WeightsPerVertex = 0;
+    /// Use this mesh as an occluder for cpu occlusion culling (see SoftwareOcclusion::IsOccluderCandidate), from the gltf node or mesh extras ("occluder": true)
+    bool                        m_Occluder = false;
 };
 
 
@@ -0,0 +1,76 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "../meshHelper.hpp"
+#include "memory/vulkan/indexBufferObject.hpp"
+#include "memory/vulkan/uploadManager.hpp"
+#include "memory/vulkan/vertexBufferObject.hpp"
+#include <variant>
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool MeshHelper::CreateMesh( MemoryManager<Vulkan>& memoryManager, UploadManager& uploadManager, const MeshObjectIntermediate& meshObject, uint32_t bindingIndex, const std::span<const VertexFormat> pVertexFormat, Mesh<Vulkan>* meshObjectOut, uint64_t& ticketOut )
+{
+    assert( meshObjectOut );
+    meshObjectOut->Destroy();
+    ticketOut = UploadManager::cInvalidTicket;
+
+    const size_t numVertices = meshObject.m_VertexBuffer.size();
+    meshObjectOut->m_NumVertices = (uint32_t) numVertices;
+
+    // Same buffer layout as the host visible CreateMesh, but the buffers are gpu only and filled by (batched) staging copies.
+    for (uint32_t vertexBufferIdx = 0; vertexBufferIdx < pVertexFormat.size(); ++vertexBufferIdx)
+    {
+        const auto& vertexFormat = pVertexFormat[vertexBufferIdx];
+        if (vertexFormat.inputRate != VertexFormat::eInputRate::Vertex)
+            continue;
+        const std::vector<uint32_t> formattedVertexData = MeshObjectIntermediate::CopyFatVertexToFormattedBuffer( meshObject.m_VertexBuffer, meshObject.m_WeightBuffer, vertexFormat );
+
+        auto& vertexBuffer = meshObjectOut->m_VertexBuffers.emplace_back();
+        if (!vertexBuffer.Initialize( &memoryManager, vertexFormat.span, numVertices, nullptr, false, BufferUsageFlags::Vertex | BufferUsageFlags::TransferDst ))
+        {
+            LOGE( "Cannot Initialize vertex buffer %d", vertexBufferIdx );
+            return false;
+        }
+        vertexBuffer.AddBindingAndAtributes( bindingIndex + vertexBufferIdx, vertexFormat );
+
+        const auto vertexData = std::as_bytes( std::span( formattedVertexData ) ).first( vertexFormat.span * numVertices );
+        if (!vertexData.empty())
+        {
+            ticketOut = uploadManager.Upload( vertexBuffer.GetVkBuffer(), 0, vertexData );
+            if (ticketOut == UploadManager::cInvalidTicket)
+            {
+                LOGE( "Cannot upload vertex buffer %d", vertexBufferIdx );
+                return false;
+            }
+        }
+    }
+
+    // Index buffer (if the meshObject has 16 or 32bit index data, as CreateIndexBuffer).
+    const auto uploadIndices = [&]<typename T>( const std::vector<T>& indices, IndexType indexType ) -> bool {
+        auto& indexBuffer = meshObjectOut->m_IndexBuffer.emplace( indexType );
+        if (!indexBuffer.Initialize( &memoryManager, indices.size(), false, BufferUsageFlags::Index | BufferUsageFlags::TransferDst ))
+            return false;
+        if (indices.empty())
+            return true;
+        ticketOut = uploadManager.Upload( indexBuffer.GetVkBuffer(), 0, std::span<const T>( indices ) );
+        return ticketOut != UploadManager::cInvalidTicket;
+    };
+    bool indicesUploaded = true;
+    if (const auto* pIndices32 = std::get_if<std::vector<uint32_t>>( &meshObject.m_IndexBuffer ))
+        indicesUploaded = uploadIndices( *pIndices32, IndexType::IndexU32 );
+    else if (const auto* pIndices16 = std::get_if<std::vector<uint16_t>>( &meshObject.m_IndexBuffer ))
+        indicesUploaded = uploadIndices( *pIndices16, IndexType::IndexU16 );
+    if (!indicesUploaded)
+    {
+        LOGE( "Cannot Initialize index buffer" );
+        meshObjectOut->m_IndexBuffer.reset();
+        return false;
+    }
+    return true;
+}
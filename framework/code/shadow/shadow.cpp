@@ -7,6 +7,9 @@
 //============================================================================================================
 
 #include "shadow.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 
 Shadow::Shadow() : m_ShadowLightPos(0.0f, 1.0f, 0.1f), m_ShadowLightTarget()
 {
@@ -33,6 +36,13 @@ void Shadow::SetEyeClipPlanes(float eyeCameraFov, float eyeCameraAspect, float e
     m_farPlane = shadowFarPlane;
 }
 
+void Shadow::SetCascades(uint32_t numCascades, float splitLambda, float casterDistance)
+{
+    m_NumCascades = std::clamp(numCascades, 1u, cMaxCascades);
+    m_CascadeSplitLambda = splitLambda;
+    m_CascadeCasterDistance = casterDistance;
+}
+
 void Shadow::Update(const glm::mat4& eyeViewMatrix)
 {
     // Shadows are faded out some distance from the 'eye' camera (attempt to control fustrum sizes)
@@ -71,6 +81,113 @@ void Shadow::Update(const glm::mat4& eyeViewMatrix)
     m_ShadowProj = glm::ortho(orthoMin.x, orthoMax.x, orthoMin.y, orthoMax.y, -orthoMax.z, -orthoMin.z);
 
     m_ShadowViewProj = m_ShadowProj * m_ShadowView;
+
+    if (m_NumCascades == 1)
+    {
+        // Single shadow covering the whole eye frustum (as above).
+        auto& cascade = m_Cascades[0];
+        cascade = {};
+        cascade.Proj = m_ShadowProj;
+        cascade.ViewProj = m_ShadowViewProj;
+        cascade.AtlasScaleOffset = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+        cascade.SplitNear = m_eyeNearPlane;
+        cascade.SplitFar = m_farPlane;
+        return;
+    }
+
+    const glm::mat4 eyeInverseView = glm::inverse(eyeViewMatrix);
+    std::array<float, cMaxCascades> splits;
+    CalcCascadeSplits(m_eyeNearPlane, m_farPlane, m_CascadeSplitLambda, std::span(splits.data(), m_NumCascades));
+    for (uint32_t cascadeIdx = 0; cascadeIdx < m_NumCascades; ++cascadeIdx)
+    {
+        uint32_t tileX, tileY, tileWidth, tileHeight;
+        GetCascadeTile(cascadeIdx, tileX, tileY, tileWidth, tileHeight);
+        const float splitNear = cascadeIdx == 0 ? m_eyeNearPlane : splits[cascadeIdx - 1];
+        auto& cascade = m_Cascades[cascadeIdx];
+        cascade = FitCascade(m_ShadowView, eyeInverseView, m_eyeCameraFov, m_eyeCameraAspect, splitNear, splits[cascadeIdx], tileWidth, tileHeight, m_CascadeCasterDistance);
+        cascade.AtlasScaleOffset = glm::vec4((float)tileWidth / (float)m_ShadowMapWidth, (float)tileHeight / (float)m_ShadowMapHeight, (float)tileX / (float)m_ShadowMapWidth, (float)tileY / (float)m_ShadowMapHeight);
+    }
+}
+
+glm::mat4 Shadow::GetCascadeShadowMatrix(uint32_t cascadeIdx) const
+{
+    // Clip space xy [-1,1] to the cascade's atlas tile uv (depth is already [0,1]).
+    const auto& cascade = m_Cascades[cascadeIdx];
+    const glm::vec4& scaleOffset = cascade.AtlasScaleOffset;
+    glm::mat4 clipToAtlas(1.0f);
+    clipToAtlas[0][0] = 0.5f * scaleOffset.x;
+    clipToAtlas[1][1] = 0.5f * scaleOffset.y;
+    clipToAtlas[3][0] = 0.5f * scaleOffset.x + scaleOffset.z;
+    clipToAtlas[3][1] = 0.5f * scaleOffset.y + scaleOffset.w;
+    return clipToAtlas * cascade.ViewProj;
+}
+
+glm::vec4 Shadow::GetCascadeSplitDistances() const
+{
+    glm::vec4 splitDistances(FLT_MAX);
+    for (uint32_t cascadeIdx = 0; cascadeIdx < m_NumCascades; ++cascadeIdx)
+        splitDistances[cascadeIdx] = m_Cascades[cascadeIdx].SplitFar;
+    return splitDistances;
+}
+
+void Shadow::GetCascadeTile(uint32_t cascadeIdx, uint32_t& x, uint32_t& y, uint32_t& width, uint32_t& height) const
+{
+    const uint32_t columns = m_NumCascades > 1 ? 2 : 1;
+    const uint32_t rows = m_NumCascades > 2 ? 2 : 1;
+    width = m_ShadowMapWidth / columns;
+    height = m_ShadowMapHeight / rows;
+    x = (cascadeIdx % columns) * width;
+    y = (cascadeIdx / columns) * height;
+}
+
+void Shadow::CalcCascadeSplits(float nearPlane, float farPlane, float lambda, std::span<float> splitsOut)
+{
+    const size_t numCascades = splitsOut.size();
+    for (size_t i = 0; i < numCascades; ++i)
+    {
+        const float fraction = (float)(i + 1) / (float)numCascades;
+        const float logSplit = nearPlane * std::pow(farPlane / nearPlane, fraction);
+        const float uniformSplit = nearPlane + (farPlane - nearPlane) * fraction;
+        splitsOut[i] = lambda * logSplit + (1.0f - lambda) * uniformSplit;
+    }
+    if (numCascades > 0)
+        splitsOut[numCascades - 1] = farPlane;
+}
+
+Shadow::Cascade Shadow::FitCascade(const glm::mat4& lightView, const glm::mat4& inverseEyeView, float eyeFov, float eyeAspect, float splitNear, float splitFar, uint32_t resolutionX, uint32_t resolutionY, float casterDistance)
+{
+    // Smallest sphere around the frustum slice, centered on the view axis.  Its radius only depends on the projection so
+    // the cascade size does not change as the eye camera rotates.
+    const float tanHalfFov = std::tan(eyeFov * 0.5f);
+    const float k = (1.0f + eyeAspect * eyeAspect) * tanHalfFov * tanHalfFov;   // (corner distance from the view axis / depth)^2
+    const float n = splitNear;
+    const float f = splitFar;
+    const float centerDistance = std::min(0.5f * (f + n) * (1.0f + k), f);
+    const float radius = std::sqrt(std::max((f - centerDistance) * (f - centerDistance) + f * f * k, (centerDistance - n) * (centerDistance - n) + n * n * k));
+
+    // Square texels sized so the sphere (padded by a texel, so snapping the center can not move it outside the projection) fits the
+    // shorter side of the tile, the longer side of a non square tile covers more of the light's view rather than stretching the texels.
+    resolutionX = std::max(resolutionX, 3u);
+    resolutionY = std::max(resolutionY, 3u);
+    const float texelSize = 2.0f * radius / (float)(std::min(resolutionX, resolutionY) - 2);
+    const float halfSizeX = 0.5f * texelSize * (float)resolutionX;
+    const float halfSizeY = 0.5f * texelSize * (float)resolutionY;
+
+    // Snap (in light view space) to whole texels.
+    glm::vec3 center = glm::vec3(lightView * (inverseEyeView * glm::vec4(0.0f, 0.0f, -centerDistance, 1.0f)));
+    center.x = std::round(center.x / texelSize) * texelSize;
+    center.y = std::round(center.y / texelSize) * texelSize;
+
+    // Light looks down -z.
+    Cascade cascade;
+    cascade.Proj = glm::ortho(center.x - halfSizeX, center.x + halfSizeX, center.y - halfSizeY, center.y + halfSizeY, -(center.z + radius) - casterDistance, -(center.z - radius));
+    cascade.ViewProj = cascade.Proj * lightView;
+    cascade.AtlasScaleOffset = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+    cascade.SphereCenter = center;
+    cascade.SphereRadius = radius;
+    cascade.SplitNear = splitNear;
+    cascade.SplitFar = splitFar;
+    return cascade;
 }
 
 bool Shadow::Initialize(uint32_t shadowMapWidth, uint32_t shadowMapHeight, bool addColorTarget)
@@ -85,5 +202,7 @@ bool Shadow::Initialize(uint32_t shadowMapWidth, uint32_t shadowMapHeight, bool
                                   glm::vec4(0.0f, 0.0f, 0.5f, 0.0f),
                                   glm::vec4(0.5f, 0.5f, 0.5f, 1.0f));
     m_shadowCameraAspect = (float)shadowMapWidth / (float)shadowMapHeight;
+    m_ShadowMapWidth = shadowMapWidth;
+    m_ShadowMapHeight = shadowMapHeight;
     return true;
 }
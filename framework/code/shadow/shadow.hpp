@@ -8,14 +8,36 @@
 #pragma once
 
 #include "system/glm_common.hpp"
+#include <array>
+#include <span>
+#include <utility>
+
+// Forward declarations
+class ViewFrustum;
+struct FrustumTest;
 
 /// Simple projected shadow.
 /// Platform agnostic base class.
+/// Optionally cascaded (see SetCascades), with each cascade rendered in to its own tile of the (atlas) shadow map.
 class Shadow
 {
     Shadow(const Shadow&) = delete;
     Shadow& operator=(const Shadow&) = delete;
 public:
+    static constexpr uint32_t cMaxCascades = 4;
+
+    /// One shadow cascade (covers the eye frustum between SplitNear and SplitFar).
+    struct Cascade
+    {
+        glm::mat4   Proj = glm::mat4(1.0f);     ///< light space orthographic projection
+        glm::mat4   ViewProj = glm::mat4(1.0f); ///< world to cascade clip space (see QueryCascadeCasters)
+        glm::vec4   AtlasScaleOffset = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);  ///< xy scale, zw offset from cascade uv to shadow (atlas) texture uv
+        glm::vec3   SphereCenter = glm::vec3(0.0f); ///< bounding sphere of the cascade's eye frustum slice (light view space, texel snapped)
+        float       SphereRadius = 0.0f;
+        float       SplitNear = 0.0f;   ///< eye view space distance
+        float       SplitFar = 0.0f;
+    };
+
     Shadow();
 
     bool Initialize(uint32_t shadowMapWidth, uint32_t shadowMapHeight, bool addColorTarget);
@@ -24,18 +46,59 @@ public:
     glm::vec3 GetLightPos() const;
     void SetEyeClipPlanes(float eyeCameraFov, float cameraAspect, float eyeNearPlane, float shadowFarPlane);
 
+    /// Set the number of cascades (1 for a single shadow covering the whole eye frustum, the default).
+    /// Cascades are packed in to tiles of the shadow map (2x1 for 2 cascades, 2x2 for 3 or 4).
+    /// @param splitLambda blend between uniform (0) and logarithmic (1) split distances, see CalcCascadeSplits
+    /// @param casterDistance distance (toward the light) beyond each cascade's bounding sphere to include shadow casters from
+    void SetCascades(uint32_t numCascades, float splitLambda = 0.75f, float casterDistance = 0.0f);
+
     void Update(const glm::mat4& eyeViewMatrix);
 
     const auto& GetViewProj() const { return m_ShadowViewProj; }
     const auto& GetProjection() const { return m_ShadowProj; }
     const auto& GetView() const { return m_ShadowView; }
 
+    uint32_t GetNumCascades() const { return m_NumCascades; }
+    const Cascade& GetCascade(uint32_t cascadeIdx) const { return m_Cascades[cascadeIdx]; }
+    /// World space to shadow (atlas) texture uv (xy) and depth (z) for the given cascade.
+    glm::mat4 GetCascadeShadowMatrix(uint32_t cascadeIdx) const;
+    /// Far distance (eye view space) of each cascade, for cascade selection in the shader (unused cascades are FLT_MAX)
+    glm::vec4 GetCascadeSplitDistances() const;
+    /// Atlas tile (in pixels) for the given cascade.
+    void GetCascadeTile(uint32_t cascadeIdx, uint32_t& x, uint32_t& y, uint32_t& width, uint32_t& height) const;
+    /// Query the scene octree for the shadow casters of one cascade (objects overlapping the cascade's volume, which extends casterDistance toward the light).
+    /// Caller must include mesh/octree.hpp (T_FRUSTUM and T_TEST default to its ViewFrustum and FrustumTest, so this header does not need it).
+    /// @param outputFn called with each caster (Octree::tObject)
+    template<typename T_OCTREE, typename T_OUTPUT, typename T_FRUSTUM = ViewFrustum, typename T_TEST = FrustumTest>
+    void QueryCascadeCasters(uint32_t cascadeIdx, const T_OCTREE& octree, T_OUTPUT&& outputFn) const
+    {
+        const T_FRUSTUM frustum(m_Cascades[cascadeIdx].ViewProj, glm::mat4(1.0f));
+        octree.Query(T_TEST(frustum), std::forward<T_OUTPUT>(outputFn));
+    }
+
+    /// Practical split scheme: split distances blended between uniform and logarithmic distributions.
+    /// @param splitsOut far distance of each cascade (last one is farPlane)
+    static void CalcCascadeSplits(float nearPlane, float farPlane, float lambda, std::span<float> splitsOut);
+    /// Fit a cascade to the bounding sphere of an eye frustum slice, snapping its position to whole shadow map texels (so the
+    /// shadow does not shimmer as the eye camera moves or rotates).
+    /// @param lightView world to light view matrix
+    /// @param inverseEyeView eye view to world matrix
+    /// @param resolutionX, resolutionY cascade (atlas tile) size in shadow map texels, texels stay square when the tile is not
+    static Cascade FitCascade(const glm::mat4& lightView, const glm::mat4& inverseEyeView, float eyeFov, float eyeAspect, float splitNear, float splitFar, uint32_t resolutionX, uint32_t resolutionY, float casterDistance);
+
 protected:
     float           m_eyeCameraFov = 1.0f;// fov of the scene (not the shadow) camera
     float           m_eyeCameraAspect = 1.0f;// aspect of the scene (not the shadow) camera
     float           m_eyeNearPlane = 1.0f;// near plane of the scene camera
     float           m_farPlane = 1000.0f; // farthest distance we want to see shadows (from the scene camera's origin - can be lower than the scenes draw distance)
     float           m_shadowCameraAspect = 1.0f;    // Aspect ratio of shadow camera (if we have a non-square shadow map)
+    uint32_t        m_ShadowMapWidth = 1;
+    uint32_t        m_ShadowMapHeight = 1;
+
+    uint32_t        m_NumCascades = 1;
+    float           m_CascadeSplitLambda = 0.75f;
+    float           m_CascadeCasterDistance = 0.0f;
+    std::array<Cascade, cMaxCascades> m_Cascades;
 
     glm::vec3       m_ShadowLightPos;
     glm::vec3       m_ShadowLightTarget;
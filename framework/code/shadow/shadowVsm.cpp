@@ -43,6 +43,10 @@ bool ShadowVSM::Initialize<Vulkan>(Vulkan& gfxApi, const ShaderManager<Vulkan>&
     //// Create the intermediate render target (result of 1st pass), width is half of output width (xy and zw channels hold alternating columns)
     auto vsmTargetIntermediate = CreateTextureObject(vulkan, width / 2, height, TextureFormat::R16G16B16A16_SFLOAT, TEXTURE_TYPE::TT_COMPUTE_TARGET, "VSM Intermediate");
 
+    // Blur is clamped to each cascade's atlas tile (so cascades do not bleed in to each other), all tiles are the same size.
+    uint32_t tileX, tileY, tileWidth, tileHeight;
+    shadowVulkan.GetCascadeTile(0, tileX, tileY, tileWidth, tileHeight);
+
     // Make a material (from the vsm shader)
     Material<Vulkan> material = materialManager.CreateMaterial(*pComputeShader, 1,
         [this, &shadowVulkan, &vsmTarget, &vsmTargetIntermediate](const std::string& texName) -> MaterialManagerBase::tPerFrameTexInfo {
@@ -54,7 +58,15 @@ bool ShadowVSM::Initialize<Vulkan>(Vulkan& gfxApi, const ShaderManager<Vulkan>&
                 return { &vsmTargetIntermediate };
             assert(0);
             return {};
-        }, nullptr);
+        }, nullptr, nullptr, nullptr,
+        [tileWidth, tileHeight](const std::string& constantName) -> const VertexElementData {
+            if (constantName == "TileWidth")
+                return VertexElementData{ VertexFormat::Element::ElementType::t::Int32, (int)tileWidth };
+            else if (constantName == "TileHeight")
+                return VertexElementData{ VertexFormat::Element::ElementType::t::Int32, (int)tileHeight };
+            assert(0);
+            return {};
+        });
 
     // Create the computable to execute the material
     auto computable = std::make_unique<Computable<Vulkan>>(vulkan, std::move(material));
@@ -22,6 +22,9 @@ template<class T_GFXAPI> class ShaderManager;
 template<class T_GFXAPI> class ShadowT;
 
 /// Variance Shadow Map
+/// Same size (and so same cascade atlas layout) as the shadow depth target, sample cascades using Shadow::GetCascadeShadowMatrix.
+/// The "VarianceShadowMap" compute shader is given the cascade tile size as specialization constants ("TileWidth" for a horizontal
+/// blur pass, "TileHeight" for a vertical one, read at Initialize so call Shadow::SetCascades first) and must clamp its blur taps to the tile.
 class ShadowVSM
 {
     ShadowVSM(const ShadowVSM&) = delete;
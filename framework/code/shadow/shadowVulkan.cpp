@@ -64,6 +64,24 @@ bool ShadowT<Vulkan>::Initialize(Vulkan& rGfxApi, uint32_t shadowMapWidth, uint3
     return true;
 }
 
+VkViewport ShadowT<Vulkan>::GetCascadeViewport(uint32_t cascadeIdx) const
+{
+    const VkRect2D scissor = GetCascadeScissor(cascadeIdx);
+    VkViewport viewport = m_Viewport;
+    viewport.x = (float) scissor.offset.x;
+    viewport.y = (float) scissor.offset.y;
+    viewport.width = (float) scissor.extent.width;
+    viewport.height = (float) scissor.extent.height;
+    return viewport;
+}
+
+VkRect2D ShadowT<Vulkan>::GetCascadeScissor(uint32_t cascadeIdx) const
+{
+    uint32_t x, y, width, height;
+    GetCascadeTile(cascadeIdx, x, y, width, height);
+    return { { (int32_t) x, (int32_t) y }, { width, height } };
+}
+
 void ShadowT<Vulkan>::Release()
 {
 }
@@ -32,6 +32,10 @@ public:
         return m_Scissor;
     }
 
+    /// Viewport for rendering the given cascade in to its tile of the shadow map (see Shadow::SetCascades).
+    VkViewport GetCascadeViewport(uint32_t cascadeIdx) const;
+    VkRect2D GetCascadeScissor(uint32_t cascadeIdx) const;
+
     const auto& GetRenderContext() const
     {
         return m_ShadowMapRC;
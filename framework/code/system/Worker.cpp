@@ -8,6 +8,7 @@
 
 #include "Worker.h"
 #include "os_common.h"
+#include "profile.h"
 #include <cassert>
 
 
@@ -30,6 +31,8 @@ void ThreadWorker::WorkerThreadProc()
     // One more worker started.  Hello!
     m_WorkersRunning.Lock();
 
+    PROFILE_THREAD_NAME(GROUP_GENERIC, 0, "%s", m_Name.c_str());
+
     // Wait to be told do do something
     while(true)
     {
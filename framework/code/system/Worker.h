@@ -8,6 +8,7 @@
 #pragma once
 
 // Standard Headers
+#include <algorithm>
 #include <vector>
 #include <thread>
 #include <mutex>
@@ -72,14 +73,10 @@ public:
     /// @note Thread safe
     void Unlock()
     {
-        uint32_t count;
-        {
-            std::lock_guard<std::mutex> lock( m_Mutex );
-            assert( m_Counter!=0 );
-            count = --m_Counter;
-        }
-        // potentially another thread gets in here and has already incremented m_Counter.  In that case a 'Waiter' will be woken up to find m_Counter is not zero and it needs to go wait again.
-        if (count == 0)
+        std::lock_guard<std::mutex> lock( m_Mutex );
+        assert( m_Counter!=0 );
+        // Notify while still holding the mutex; the waiter cannot return from WaitAndLock (and potentially destroy this semaphore, eg ThreadWorker::ParallelFor's stack local) until we release it.
+        if (--m_Counter == 0)
             m_Condition.notify_one();
     }
 
@@ -216,6 +213,34 @@ public:
         DoWork( +lambdaWrap, pWork, 1000 );
     }
 
+    /// Split [0,count) in to ranges and call fn(begin, end) for each range on the worker threads, returning once all ranges are complete.
+    /// Runs everything on the calling thread if there is only one worker thread (or count is too small to split).
+    /// @param minPerRange smallest range worth sending to a worker thread
+    /// @note Must not be called from one of this worker's threads (would deadlock if all the threads are waiting).
+    template<typename T_FN>
+    void        ParallelFor( uint32_t count, uint32_t minPerRange, const T_FN& fn )
+    {
+        const uint32_t numThreads = NumThreads();
+        const uint32_t numRanges = std::min( numThreads * 4, count / std::max( minPerRange, 1u ) );
+        if (numThreads <= 1 || numRanges <= 1)
+        {
+            fn( 0u, count );
+            return;
+        }
+        ReverseSemaphore rangesOutstanding{ 0 };
+        for (uint32_t range = 0; range < numRanges; ++range)
+        {
+            const uint32_t begin = uint32_t( uint64_t( count ) * range / numRanges );
+            const uint32_t end = uint32_t( uint64_t( count ) * (range + 1) / numRanges );
+            rangesOutstanding.Lock();
+            DoWork3( [&fn, &rangesOutstanding, begin, end]() {
+                fn( begin, end );
+                rangesOutstanding.Unlock();
+            } );
+        }
+        rangesOutstanding.WaitAndLock();
+    }
+
     void        Terminate();
 
 protected:
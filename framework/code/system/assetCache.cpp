@@ -0,0 +1,213 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "assetCache.hpp"
+#include "assetManager.hpp"
+#include "os_common.h"
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+
+
+AssetCache::AssetCache(AssetManager& assetManager, size_t budgetBytes) noexcept
+    : m_AssetManager(assetManager)
+    , m_BudgetBytes(budgetBytes)
+{
+}
+
+AssetCache::~AssetCache()
+{
+    Clear();
+}
+
+std::string AssetCache::CanonicalPath(const std::string& portableFileName)
+{
+    std::string path = std::filesystem::path(portableFileName).lexically_normal().generic_string();
+#if OS_WINDOWS
+    // Windows filesystem is case insensitive, make sure "Foo.ktx" and "foo.ktx" share an entry.
+    for (auto& c : path)
+        c = (c >= 'A' && c <= 'Z') ? char(c + 32) : c;
+#endif
+    return path;
+}
+
+uint64_t AssetCache::ContentHash(std::span<const uint8_t> data)
+{
+    // 64bit FNV-1a style hash, consuming 8 bytes per step (with a final mix) so hashing multi-megabyte textures stays cheap compared to the file read.
+    constexpr uint64_t prime = 0x100000001b3ull;
+    uint64_t h = 0xcbf29ce484222325ull ^ data.size();
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t))
+    {
+        uint64_t v;
+        memcpy(&v, data.data() + i, sizeof(v));
+        h ^= v;
+        h *= prime;
+        h ^= h >> 29;
+    }
+    for (; i < data.size(); ++i)
+    {
+        h ^= data[i];
+        h *= prime;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+bool AssetCache::LoadFromStorage(const std::string& portableFileName, std::vector<uint8_t>& fileData)
+{
+    return m_AssetManager.LoadFileIntoMemory(portableFileName, fileData);
+}
+
+AssetBuffer AssetCache::Load(const std::string& portableFileName)
+{
+    const std::string key = CanonicalPath(portableFileName);
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_ByPath.find(key);
+        if (it != m_ByPath.end())
+        {
+            // Hit - move to the front of the LRU
+            m_Lru.splice(m_Lru.begin(), m_Lru, it->second);
+            ++m_Stats.Hits;
+            return it->second->Buffer;
+        }
+        ++m_Stats.Misses;
+    }
+
+    // Load outside of the lock (file reads are slow and may happen on multiple worker threads simultaneously).
+    std::vector<uint8_t> fileData;
+    if (!LoadFromStorage(portableFileName, fileData))
+        return {};
+    const uint64_t hash = ContentHash(fileData);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stats.BytesLoaded += fileData.size();
+
+    // Another thread may have loaded the same path while we were reading.
+    if (auto it = m_ByPath.find(key); it != m_ByPath.end())
+    {
+        m_Lru.splice(m_Lru.begin(), m_Lru, it->second);
+        return it->second->Buffer;
+    }
+
+    // Look for identical content already in the cache (under a different path).
+    ContentEntry* pContent = nullptr;
+    auto [rangeBegin, rangeEnd] = m_ByContent.equal_range(hash);
+    for (auto it = rangeBegin; it != rangeEnd; ++it)
+    {
+        const auto& existing = it->second.Buffer;
+        if (existing.size() == fileData.size() && memcmp(existing.data(), fileData.data(), fileData.size()) == 0)
+        {
+            pContent = &it->second;
+            ++m_Stats.DedupedLoads;
+            break;
+        }
+    }
+    if (!pContent)
+    {
+        m_Stats.ResidentBytes += fileData.size();
+        pContent = &m_ByContent.emplace(hash, ContentEntry{ AssetBuffer{ std::move(fileData) }, 0 })->second;
+    }
+    ++pContent->PathRefCount;
+
+    m_Lru.push_front(PathEntry{ key, hash, pContent->Buffer });
+    m_ByPath.emplace(key, m_Lru.begin());
+    m_Stats.ResidentEntries = m_ByPath.size();
+
+    AssetBuffer result = pContent->Buffer;
+    EvictToBudget();
+    return result;
+}
+
+void AssetCache::ReleasePathEntry(tLruList::iterator pathIt)
+{
+    auto [rangeBegin, rangeEnd] = m_ByContent.equal_range(pathIt->Hash);
+    for (auto it = rangeBegin; it != rangeEnd; ++it)
+    {
+        if (it->second.Buffer.SharesDataWith(pathIt->Buffer))
+        {
+            assert(it->second.PathRefCount > 0);
+            if (--it->second.PathRefCount == 0)
+            {
+                m_Stats.ResidentBytes -= it->second.Buffer.size();
+                m_ByContent.erase(it);
+            }
+            break;
+        }
+    }
+    m_ByPath.erase(pathIt->Path);
+    m_Lru.erase(pathIt);
+    m_Stats.ResidentEntries = m_ByPath.size();
+}
+
+void AssetCache::EvictToBudget()
+{
+    // Always keep the most recently used entry (even if it alone is over budget), it was just handed out and may be immediately re-requested.
+    while (m_Stats.ResidentBytes > m_BudgetBytes && m_Lru.size() > 1)
+    {
+        ReleasePathEntry(std::prev(m_Lru.end()));
+        ++m_Stats.Evictions;
+    }
+}
+
+void AssetCache::Evict(const std::string& portableFileName)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_ByPath.find(CanonicalPath(portableFileName));
+    if (it != m_ByPath.end())
+        ReleasePathEntry(it->second);
+}
+
+void AssetCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_ByPath.clear();
+    m_ByContent.clear();
+    m_Lru.clear();
+    m_Stats.ResidentBytes = 0;
+    m_Stats.ResidentEntries = 0;
+}
+
+void AssetCache::SetBudget(size_t budgetBytes)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_BudgetBytes = budgetBytes;
+    EvictToBudget();
+}
+
+AssetCache::Stats AssetCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Stats;
+}
+
+void AssetCache::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stats.Hits = 0;
+    m_Stats.Misses = 0;
+    m_Stats.DedupedLoads = 0;
+    m_Stats.Evictions = 0;
+    m_Stats.BytesLoaded = 0;
+}
+
+//
+// AssetManager::LoadFileShared (platform independant so lives here rather than in the platform specific AssetManager implementations)
+//
+AssetBuffer AssetManager::LoadFileShared(const std::string& portableFileName)
+{
+    if (m_AssetCache)
+        return m_AssetCache->Load(portableFileName);
+    std::vector<uint8_t> fileData;
+    if (!LoadFileIntoMemory(portableFileName, fileData))
+        return {};
+    return AssetBuffer{ std::move(fileData) };
+}
@@ -0,0 +1,128 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+//
+// AssetCache
+// In-memory (LRU, byte budgeted) cache of file contents that sits in front of the AssetManager.
+//
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+class AssetManager;
+
+/// Shared, immutable, reference counted block of file data.
+/// Handed out by the AssetCache (and AssetManager::LoadFileShared); the data stays valid for as long as any AssetBuffer references it (even if evicted from the cache).
+/// @ingroup System
+class AssetBuffer
+{
+public:
+    AssetBuffer() noexcept = default;
+    explicit AssetBuffer(std::vector<uint8_t>&& data) : m_Data(std::make_shared<const std::vector<uint8_t>>(std::move(data))) {}
+
+    const uint8_t* data() const noexcept { return m_Data ? m_Data->data() : nullptr; }
+    size_t size() const noexcept { return m_Data ? m_Data->size() : 0; }
+    bool empty() const noexcept { return size() == 0; }
+    std::span<const uint8_t> span() const noexcept { return { data(), size() }; }
+    explicit operator bool() const noexcept { return m_Data != nullptr; }
+
+    /// @return number of AssetBuffers (including cache entries) sharing this data
+    long use_count() const noexcept { return m_Data.use_count(); }
+
+    /// @return true if both buffers reference the same underlying data block.
+    bool SharesDataWith(const AssetBuffer& other) const noexcept { return m_Data == other.m_Data; }
+
+private:
+    std::shared_ptr<const std::vector<uint8_t>> m_Data;
+};
+
+
+/// LRU cache of loaded file data, keyed by canonical (normalized) path and de-duplicated by content hash.
+/// Files with identical contents (loaded via different paths) share a single AssetBuffer.
+/// Cache is limited to a budget (in bytes), least recently used entries are evicted when the budget is exceeded.
+/// Evicting an entry does not free the data if a loader still holds an AssetBuffer referencing it.
+/// @note Thread safe (texture loading calls in from worker threads).
+/// @ingroup System
+class AssetCache
+{
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+public:
+    /// @param assetManager used to load files that are not already in the cache
+    /// @param budgetBytes maximum number of (unique) file bytes held by the cache
+    AssetCache(AssetManager& assetManager, size_t budgetBytes) noexcept;
+    virtual ~AssetCache();
+
+    /// Return the contents of the given file, loading it through the AssetManager if it is not already cached.
+    /// @return the (shared) file data, or empty AssetBuffer if the file could not be loaded.
+    AssetBuffer Load(const std::string& portableFileName);
+
+    /// Drop the given file from the cache (outstanding AssetBuffers remain valid).
+    void Evict(const std::string& portableFileName);
+
+    /// Drop everything from the cache (outstanding AssetBuffers remain valid).
+    void Clear();
+
+    /// Change the cache budget (evicting if we are now over budget).
+    void SetBudget(size_t budgetBytes);
+    size_t GetBudget() const { return m_BudgetBytes; }
+
+    struct Stats {
+        uint64_t Hits = 0;              ///< Load requests satisfied by the path lookup
+        uint64_t Misses = 0;            ///< Load requests that went to the AssetManager
+        uint64_t DedupedLoads = 0;      ///< Misses where the loaded contents matched data already in the cache (loaded data was discarded)
+        uint64_t Evictions = 0;         ///< Entries evicted to stay under budget
+        uint64_t BytesLoaded = 0;       ///< Total bytes read through the AssetManager
+        size_t   ResidentBytes = 0;     ///< Current unique bytes held by the cache
+        size_t   ResidentEntries = 0;   ///< Current number of cached paths
+        float HitRate() const { return (Hits + Misses) > 0 ? float(Hits) / float(Hits + Misses) : 0.0f; }
+    };
+    /// @return snapshot of the cache counters
+    Stats GetStats() const;
+    void ResetStats();
+
+    /// Convert a portable filename to the key used for lookups (normalized, forward slashes, lowercase on case insensitive platforms)
+    static std::string CanonicalPath(const std::string& portableFileName);
+    /// Hash used to de-duplicate file contents.
+    static uint64_t ContentHash(std::span<const uint8_t> data);
+
+protected:
+    /// Load from the underlying AssetManager (virtual so a derived cache can supply file data from elsewhere).
+    virtual bool LoadFromStorage(const std::string& portableFileName, std::vector<uint8_t>& fileData);
+
+private:
+    struct ContentEntry {
+        AssetBuffer Buffer;
+        uint32_t    PathRefCount = 0;   ///< number of path entries referencing this content
+    };
+    struct PathEntry {
+        std::string Path;
+        uint64_t    Hash;
+        AssetBuffer Buffer;
+    };
+    using tLruList = std::list<PathEntry>;
+
+    void ReleasePathEntry(tLruList::iterator it);   // requires m_Mutex
+    void EvictToBudget();                           // requires m_Mutex
+
+private:
+    AssetManager&                                   m_AssetManager;
+    size_t                                          m_BudgetBytes;
+    mutable std::mutex                              m_Mutex;
+    tLruList                                        m_Lru;          ///< most recently used at front (protected by m_Mutex)
+    std::unordered_map<std::string, tLruList::iterator> m_ByPath;   ///< protected by m_Mutex
+    std::unordered_multimap<uint64_t, ContentEntry> m_ByContent;    ///< protected by m_Mutex (multimap in case of hash collision)
+    Stats                                           m_Stats;        ///< protected by m_Mutex
+};
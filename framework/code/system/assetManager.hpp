@@ -12,6 +12,7 @@
 // Handles file loading from device storage.
 // Implementations are expected to be device specific (eg in android/androidAssetManager.cpp)
 #include "system/os_common.h"
+#include "system/assetCache.hpp"
 #include <assert.h>
 #include <istream>
 #include <optional>
@@ -174,6 +175,15 @@ public:
         return true;
     }
 
+    /// Load the contents of the given file in to a shared (immutable) buffer.
+    /// Goes through the AssetCache (if one is attached with SetAssetCache) so repeated loads of the same file (or of files with identical contents) share data.
+    /// @return loaded data, empty AssetBuffer on failure
+    AssetBuffer LoadFileShared(const std::string& portableFileName);
+
+    /// Attach a cache that LoadFileShared will go through (nullptr to detach).  Cache must outlive its attachment.
+    void SetAssetCache(AssetCache* pAssetCache) { m_AssetCache = pAssetCache; }
+    AssetCache* GetAssetCache() const { return m_AssetCache; }
+
     AssetHandleGuard OpenFile( const std::string& portableFilename )
     {
         auto* fileHandle = OpenFile( portableFilename, Mode::Read );
@@ -284,6 +294,7 @@ protected:
 
 private:
     AAssetManager* m_AAssetManager = nullptr;
+    AssetCache* m_AssetCache = nullptr;
     std::string m_AndroidExternalFilesDir;
     std::vector<AssetHandle*> m_OpenHandles;    // Managed by platform implementation
 };
@@ -0,0 +1,666 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "cpuTrace.hpp"
+#include "os_common.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct CpuTrace::Registry
+{
+    std::mutex                                  Mutex;          ///< protects everything in here (except FrameNumber)
+    std::vector<std::unique_ptr<ThreadBuffer>>  Threads;        ///< never freed (threads cache a pointer to their buffer)
+    std::vector<std::unique_ptr<RingEvent[]>>   EventStorage;
+    std::unordered_set<std::string>             Strings;
+    std::unordered_map<uint64_t, const char*>   LockNames;
+    uint32_t                                    EventsPerThread = 64 * 1024;
+    uint64_t                                    CalibrationTicks = 0;
+    std::chrono::steady_clock::time_point       CalibrationTime = std::chrono::steady_clock::now();
+    std::atomic<uint64_t>                       FrameNumber{ 0 };
+};
+
+CpuTrace::Registry& CpuTrace::GetRegistry()
+{
+    static Registry sRegistry;
+    return sRegistry;
+}
+
+void CpuTrace::Initialize( uint32_t eventsPerThread )
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock( registry.Mutex );
+    uint32_t size = 1024;
+    while (size < eventsPerThread)
+        size <<= 1;
+    registry.EventsPerThread = size;
+
+    // Timestamp calibration.  Export re-calibrates over the (much longer) time since Initialize.
+    registry.CalibrationTime = std::chrono::steady_clock::now();
+    registry.CalibrationTicks = Now();
+#if defined(__aarch64__)
+    uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    sTicksPerMicrosecond = double( frequency ) * 1e-6;
+#elif defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    // Short spin to get an initial rate (needed by PROFILE_SCOPE_FILTERED thresholds).
+    std::chrono::steady_clock::time_point time;
+    do {
+        time = std::chrono::steady_clock::now();
+    } while (time - registry.CalibrationTime < std::chrono::milliseconds( 2 ));
+    sTicksPerMicrosecond = double( Now() - registry.CalibrationTicks ) / double( std::chrono::duration_cast<std::chrono::nanoseconds>(time - registry.CalibrationTime).count() * 1e-3 );
+#else
+    sTicksPerMicrosecond = 1000.0;   // steady_clock nanoseconds
+#endif
+    LOGI( "CpuTrace initialized (%u events per thread, %.1f ticks per microsecond)", size, sTicksPerMicrosecond );
+}
+
+void CpuTrace::Shutdown()
+{
+    SetEnabled( false );
+}
+
+const char* CpuTrace::Intern( const char* pString )
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock( registry.Mutex );
+    return registry.Strings.emplace( pString ).first->c_str();
+}
+
+// Registry mutex must be held.
+CpuTrace::ThreadBuffer* CpuTrace::AddBuffer( bool allocateEvents )
+{
+    auto& registry = GetRegistry();
+    auto& pBuffer = registry.Threads.emplace_back( std::make_unique<ThreadBuffer>() );
+    pBuffer->ThreadId = (uint32_t) registry.Threads.size();
+    if (allocateEvents)
+    {
+        auto& pEvents = registry.EventStorage.emplace_back( std::make_unique<RingEvent[]>( registry.EventsPerThread ) );
+        pBuffer->pEvents = pEvents.get();
+        pBuffer->Mask = registry.EventsPerThread - 1;
+    }
+    return pBuffer.get();
+}
+
+// Register the calling thread (without allocating its ring buffer).
+CpuTrace::ThreadBuffer* CpuTrace::RegisterThread()
+{
+    std::lock_guard<std::mutex> lock( GetRegistry().Mutex );
+    if (!tThreadBuffer)
+        tThreadBuffer = AddBuffer( false );
+    return tThreadBuffer;
+}
+
+// First event recorded by the calling thread, register it (if SetThreadName has not already) and allocate its ring buffer.
+CpuTrace::ThreadBuffer* CpuTrace::AllocateThreadEvents()
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock( registry.Mutex );
+    if (!tThreadBuffer)
+        tThreadBuffer = AddBuffer( true );
+    else if (!tThreadBuffer->pEvents)
+    {
+        auto& pEvents = registry.EventStorage.emplace_back( std::make_unique<RingEvent[]>( registry.EventsPerThread ) );
+        tThreadBuffer->Mask = registry.EventsPerThread - 1;
+        tThreadBuffer->pEvents = pEvents.get();
+    }
+    return tThreadBuffer;
+}
+
+CpuTrace::TrackId CpuTrace::CreateTrack( const char* pName )
+{
+    const char* pInterned = Intern( pName );
+    std::lock_guard<std::mutex> lock( GetRegistry().Mutex );
+    ThreadBuffer* pBuffer = AddBuffer( true );
+    pBuffer->pThreadName = pInterned;
+    pBuffer->IsTrack = true;
+    return TrackId( pBuffer->ThreadId - 1 );
+}
+
+void CpuTrace::RecordToTrack( TrackId track, EventType type, const char* pName, uint64_t value, uint64_t timestamp )
+{
+    ThreadBuffer* pBuffer;
+    {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock( registry.Mutex );
+        if (track >= registry.Threads.size() || !registry.Threads[track]->IsTrack)
+            return;
+        pBuffer = registry.Threads[track].get();
+    }
+    Write( *pBuffer, type, pName, value, timestamp );
+}
+
+void CpuTrace::SetLockState( const void* pLock, CpuTraceLockState state, const char* pDescription )
+{
+    if (IsEnabled())
+        Record( state == CpuTraceLockState::Locked ? EventType::LockAcquired : EventType::LockReleased, pDescription, (uint64_t) (uintptr_t) pLock );
+}
+
+void CpuTrace::Tick()
+{
+    const uint64_t frame = GetRegistry().FrameNumber.fetch_add( 1, std::memory_order_relaxed ) + 1;
+    if (IsEnabled())
+        Record( EventType::Frame, "Frame", frame );
+}
+
+void CpuTrace::SetThreadName( const char* pName )
+{
+    const char* pInterned = Intern( pName );
+    ThreadBuffer* pBuffer = RegisterThread();
+    std::lock_guard<std::mutex> lock( GetRegistry().Mutex );
+    pBuffer->pThreadName = pInterned;
+}
+
+void CpuTrace::SetLockName( const void* pLock, const char* pName )
+{
+    const char* pInterned = Intern( pName );
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock( registry.Mutex );
+    registry.LockNames[(uint64_t) (uintptr_t) pLock] = pInterned;
+}
+
+void CpuTrace::Clear()
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock( registry.Mutex );
+    for (auto& pBuffer : registry.Threads)
+        pBuffer->WriteIndex.store( 0, std::memory_order_relaxed );
+}
+
+uint64_t CpuTrace::GetTotalEventCount()
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock( registry.Mutex );
+    uint64_t count = 0;
+    for (const auto& pBuffer : registry.Threads)
+        count += pBuffer->WriteIndex.load( std::memory_order_acquire );
+    return count;
+}
+
+size_t CpuTrace::GetEventStorageBytes()
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock( registry.Mutex );
+    size_t bytes = 0;
+    for (const auto& pBuffer : registry.Threads)
+        bytes += pBuffer->pEvents ? size_t( pBuffer->Mask + 1 ) * sizeof( RingEvent ) : 0;
+    return bytes;
+}
+
+namespace
+{
+    void AppendJsonString( std::string& out, const char* pString )
+    {
+        out += '"';
+        for (const char* p = pString ? pString : ""; *p; ++p)
+        {
+            const unsigned char c = (unsigned char) *p;
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += char( c );
+            }
+            else if (c < 0x20)
+            {
+                char escaped[8];
+                snprintf( escaped, sizeof( escaped ), "\\u%04x", c );
+                out += escaped;
+            }
+            else
+                out += char( c );
+        }
+        out += '"';
+    }
+
+    /// Append the fields common to every event (minus the closing brace).
+    void AppendEventHeader( std::string& out, const char* pName, const char* pPhase, const char* pCategory, double timestampUs, uint32_t threadId )
+    {
+        char buffer[128];
+        out += "{\"name\":";
+        AppendJsonString( out, pName );
+        snprintf( buffer, sizeof( buffer ), ",\"ph\":\"%s\",\"cat\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%u", pPhase, pCategory, timestampUs, threadId );
+        out += buffer;
+    }
+}
+
+struct CpuTrace::Snapshot
+{
+    /// Copy of one thread's (or track's) ring buffer.
+    struct Thread
+    {
+        uint32_t            ThreadId;
+        const char*         pName;          ///< null if unnamed
+        bool                IsTrack;
+        std::vector<Event>  Events;         ///< oldest first, with any overwritten during the copy removed
+    };
+    std::vector<Thread>                         Threads;
+    std::unordered_map<uint64_t, const char*>   LockNames;
+    uint64_t                                    BaseTicks = 0;
+    double                                      MicrosecondsPerTick = 0.001;
+
+    /// @return microseconds since Initialize
+    double ToMicroseconds( uint64_t ticks ) const { return double( int64_t( ticks - BaseTicks ) ) * MicrosecondsPerTick; }
+};
+
+CpuTrace::Snapshot CpuTrace::TakeSnapshot()
+{
+    auto& registry = GetRegistry();
+
+    // Snapshot what we need from the registry (buffers themselves are never freed, but a thread's pEvents/Mask may be set after this snapshot).
+    struct ThreadSnapshot
+    {
+        ThreadBuffer*       pBuffer;
+        const RingEvent*    pEvents;
+        uint64_t            Mask;
+    };
+    std::vector<ThreadSnapshot> threads;
+    Snapshot snapshot;
+    {
+        std::lock_guard<std::mutex> lock( registry.Mutex );
+        for (auto& pBuffer : registry.Threads)
+        {
+            threads.push_back( { pBuffer.get(), pBuffer->pEvents, pBuffer->Mask } );
+            snapshot.Threads.push_back( { pBuffer->ThreadId, pBuffer->pThreadName, pBuffer->IsTrack, {} } );
+        }
+        snapshot.LockNames = registry.LockNames;
+        snapshot.BaseTicks = registry.CalibrationTicks;
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        // Recalibrate the cycle counter over the whole run.
+        const auto elapsed = std::chrono::steady_clock::now() - registry.CalibrationTime;
+        const uint64_t elapsedTicks = Now() - registry.CalibrationTicks;
+        if (elapsed > std::chrono::milliseconds( 100 ))
+            sTicksPerMicrosecond = double( elapsedTicks ) / (double( std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() ) * 1e-3);
+#endif
+    }
+    snapshot.MicrosecondsPerTick = 1.0 / sTicksPerMicrosecond;
+
+    for (size_t threadIdx = 0; threadIdx < threads.size(); ++threadIdx)
+    {
+        const ThreadSnapshot& threadSnapshot = threads[threadIdx];
+        if (!threadSnapshot.pEvents)
+            continue;       // named thread that has not recorded anything
+        const ThreadBuffer& thread = *threadSnapshot.pBuffer;
+        std::vector<Event>& events = snapshot.Threads[threadIdx].Events;
+
+        // Copy the ring buffer, then discard anything the (still running) thread may have overwritten while we were copying.
+        // Seqlock style reader: the acquire load pairs with Write's WriteIndex release store (events before endIndex are complete) and the
+        // acquire fence pairs with Write's release fence (if we copied any part of an overwrite, writeIndexAfter includes it).
+        const uint64_t capacity = threadSnapshot.Mask + 1;
+        const uint64_t endIndex = thread.WriteIndex.load( std::memory_order_acquire );
+        uint64_t beginIndex = endIndex > capacity ? endIndex - capacity : 0;
+        events.reserve( size_t( endIndex - beginIndex ) );
+        for (uint64_t index = beginIndex; index < endIndex; ++index)
+        {
+            const RingEvent& ringEvent = threadSnapshot.pEvents[index & threadSnapshot.Mask];
+            events.push_back( { ringEvent.Timestamp.load( std::memory_order_relaxed ), ringEvent.pName.load( std::memory_order_relaxed ),
+                                ringEvent.Value.load( std::memory_order_relaxed ), ringEvent.Type.load( std::memory_order_relaxed ) } );
+        }
+        std::atomic_thread_fence( std::memory_order_acquire );
+        const uint64_t writeIndexAfter = thread.WriteIndex.load( std::memory_order_relaxed );
+        const uint64_t firstValidIndex = writeIndexAfter >= capacity ? writeIndexAfter - capacity + 1 : 0;
+        const size_t skip = size_t( std::min( endIndex, std::max( beginIndex, firstValidIndex ) ) - beginIndex );
+        events.erase( events.begin(), events.begin() + skip );
+    }
+    return snapshot;
+}
+
+std::string CpuTrace::ExportChromeTrace()
+{
+    const Snapshot snapshot = TakeSnapshot();
+    const double microsecondsPerTick = snapshot.MicrosecondsPerTick;
+
+    std::string out;
+    out.reserve( 1024 * 1024 );
+    out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    auto nextEvent = [&]() {
+        if (!first)
+            out += ",\n";
+        first = false;
+    };
+
+    char buffer[128];
+    for (const auto& thread : snapshot.Threads)
+    {
+        const uint32_t tid = thread.ThreadId;
+        if (thread.pName)
+        {
+            nextEvent();
+            snprintf( buffer, sizeof( buffer ), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", tid );
+            out += buffer;
+            AppendJsonString( out, thread.pName );
+            out += "}}";
+        }
+
+        uint32_t depth = 0;     // open Begin/LockWaitBegin events (Ends without a Begin, eg overwritten, are dropped)
+        for (const Event& event : thread.Events)
+        {
+            const double ts = snapshot.ToMicroseconds( event.Timestamp );
+            switch (event.Type) {
+            case EventType::Begin:
+            case EventType::LockWaitBegin:
+                nextEvent();
+                AppendEventHeader( out, event.pName, "B", event.Type == EventType::Begin ? "cpu" : "lock", ts, tid );
+                out += '}';
+                ++depth;
+                break;
+            case EventType::End:
+            case EventType::LockWaitEnd:
+                if (depth == 0)
+                    break;
+                --depth;
+                nextEvent();
+                snprintf( buffer, sizeof( buffer ), "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u", ts, tid );
+                out += buffer;
+                if (event.Type == EventType::LockWaitEnd)
+                    out += event.Value ? ",\"args\":{\"acquired\":true}" : ",\"args\":{\"acquired\":false}";
+                out += '}';
+                break;
+            case EventType::Complete:
+                nextEvent();
+                AppendEventHeader( out, event.pName, "X", thread.IsTrack ? "track" : "cpu", ts, tid );
+                snprintf( buffer, sizeof( buffer ), ",\"dur\":%.3f}", double( event.Value ) * microsecondsPerTick );
+                out += buffer;
+                break;
+            case EventType::Counter:
+            {
+                double value;
+                memcpy( &value, &event.Value, sizeof( value ) );
+                nextEvent();
+                AppendEventHeader( out, event.pName, "C", "counter", ts, tid );
+                snprintf( buffer, sizeof( buffer ), ",\"args\":{\"value\":%.9g}}", value );
+                out += buffer;
+                break;
+            }
+            case EventType::Instant:
+            {
+                static const char* const cCategories[] = { "marker", "message", "warning", "error" };
+                nextEvent();
+                AppendEventHeader( out, event.pName, "i", cCategories[std::min<uint64_t>( event.Value, 3 )], ts, tid );
+                out += ",\"s\":\"t\"}";
+                break;
+            }
+            case EventType::Frame:
+                nextEvent();
+                AppendEventHeader( out, event.pName, "i", "frame", ts, tid );
+                snprintf( buffer, sizeof( buffer ), ",\"s\":\"g\",\"args\":{\"frame\":%llu}}", (unsigned long long) event.Value );
+                out += buffer;
+                break;
+            case EventType::SpanBegin:
+            case EventType::SpanEnd:
+                nextEvent();
+                AppendEventHeader( out, event.pName, event.Type == EventType::SpanBegin ? "b" : "e", "span", ts, tid );
+                snprintf( buffer, sizeof( buffer ), ",\"id\":\"0x%llx\"}", (unsigned long long) event.Value );
+                out += buffer;
+                break;
+            case EventType::LockAcquired:
+            case EventType::LockReleased:
+            {
+                // Held locks are async spans keyed (and named) by the lock, so acquire/release on different threads still pair up.
+                const auto lockNameIt = snapshot.LockNames.find( event.Value );
+                char lockName[64];
+                if (lockNameIt == snapshot.LockNames.end())
+                    snprintf( lockName, sizeof( lockName ), "Lock 0x%llx", (unsigned long long) event.Value );
+                nextEvent();
+                AppendEventHeader( out, lockNameIt != snapshot.LockNames.end() ? lockNameIt->second : lockName, event.Type == EventType::LockAcquired ? "b" : "e", "lock", ts, tid );
+                snprintf( buffer, sizeof( buffer ), ",\"id\":\"0x%llx\",\"args\":{\"description\":", (unsigned long long) event.Value );
+                out += buffer;
+                AppendJsonString( out, event.pName );
+                out += "}}";
+                break;
+            }
+            }
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+namespace
+{
+    /// Minimal protobuf writer, just enough for the Perfetto trace packets (perfetto/protos/perfetto/trace/trace_packet.proto)
+    void AppendVarint( std::string& out, uint64_t value )
+    {
+        while (value >= 0x80)
+        {
+            out += char( (value & 0x7f) | 0x80 );
+            value >>= 7;
+        }
+        out += char( value );
+    }
+    void AppendUint( std::string& out, uint32_t field, uint64_t value )
+    {
+        AppendVarint( out, (uint64_t( field ) << 3) | 0 );
+        AppendVarint( out, value );
+    }
+    void AppendDouble( std::string& out, uint32_t field, double value )
+    {
+        AppendVarint( out, (uint64_t( field ) << 3) | 1 );
+        uint64_t bits;
+        memcpy( &bits, &value, sizeof( bits ) );
+        for (int byte = 0; byte < 8; ++byte)
+            out += char( (bits >> (byte * 8)) & 0xff );
+    }
+    void AppendBytes( std::string& out, uint32_t field, const char* pData, size_t size )
+    {
+        AppendVarint( out, (uint64_t( field ) << 3) | 2 );
+        AppendVarint( out, size );
+        out.append( pData, size );
+    }
+    void AppendBytes( std::string& out, uint32_t field, const std::string& message ) { AppendBytes( out, field, message.data(), message.size() ); }
+    void AppendString( std::string& out, uint32_t field, const char* pString ) { AppendBytes( out, field, pString ? pString : "", pString ? strlen( pString ) : 0 ); }
+
+    // Perfetto field numbers
+    enum : uint32_t {
+        cTrace_Packet = 1,
+        cPacket_Timestamp = 8,
+        cPacket_SequenceId = 10,        ///< trusted_packet_sequence_id
+        cPacket_TrackEvent = 11,
+        cPacket_SequenceFlags = 13,
+        cPacket_TrackDescriptor = 60,
+        cTrack_Uuid = 1,
+        cTrack_Name = 2,
+        cTrack_Process = 3,
+        cTrack_Thread = 4,
+        cTrack_ParentUuid = 5,
+        cTrack_Counter = 8,
+        cProcess_Pid = 1,
+        cThread_Pid = 1,
+        cThread_Tid = 2,
+        cThread_Name = 5,
+        cEvent_Type = 9,
+        cEvent_TrackUuid = 11,
+        cEvent_Categories = 22,
+        cEvent_Name = 23,
+        cEvent_DoubleCounterValue = 44,
+    };
+    enum : uint64_t {
+        cEventType_SliceBegin = 1,
+        cEventType_SliceEnd = 2,
+        cEventType_Instant = 3,
+        cEventType_Counter = 4,
+    };
+    const uint64_t cSequenceIncrementalStateCleared = 1;
+    const uint32_t cPid = 1;
+    const uint64_t cProcessUuid = 1;
+
+    /// Unique track ids for thread/track buffers, counters, async spans and locks.
+    uint64_t ThreadTrackUuid( uint32_t threadId )                   { return (uint64_t( 1 ) << 32) | threadId; }
+    uint64_t KeyedTrackUuid( uint64_t kind, uint64_t key )          { return (kind << 60) ^ (key * 0x9e3779b97f4a7c15ull) ^ (key >> 29); }
+}
+
+std::string CpuTrace::ExportPerfettoTrace()
+{
+    const Snapshot snapshot = TakeSnapshot();
+
+    // Track descriptors (written first) and events are built separately.
+    std::string descriptors;
+    std::string events;
+    descriptors.reserve( 64 * 1024 );
+    events.reserve( 1024 * 1024 );
+    std::string message, subMessage, packet;
+    bool firstPacket = true;
+
+    auto appendPacket = [&]( std::string& out, uint32_t field, const std::string& body, const uint64_t* pTimestamp ) {
+        packet.clear();
+        if (pTimestamp)
+            AppendUint( packet, cPacket_Timestamp, *pTimestamp );
+        AppendUint( packet, cPacket_SequenceId, 1 );
+        if (firstPacket)
+            AppendUint( packet, cPacket_SequenceFlags, cSequenceIncrementalStateCleared );
+        firstPacket = false;
+        AppendBytes( packet, field, body );
+        AppendBytes( out, cTrace_Packet, packet );
+    };
+    auto appendTrack = [&]( uint64_t uuid, const char* pName, bool counter ) {
+        message.clear();
+        AppendUint( message, cTrack_Uuid, uuid );
+        AppendString( message, cTrack_Name, pName );
+        AppendUint( message, cTrack_ParentUuid, cProcessUuid );
+        if (counter)
+            AppendBytes( message, cTrack_Counter, nullptr, 0 );
+        appendPacket( descriptors, cPacket_TrackDescriptor, message, nullptr );
+    };
+    auto appendEvent = [&]( uint64_t timestamp, uint64_t type, uint64_t trackUuid, const char* pName, const char* pCategory, const double* pCounterValue ) {
+        message.clear();
+        AppendUint( message, cEvent_Type, type );
+        AppendUint( message, cEvent_TrackUuid, trackUuid );
+        if (pCategory)
+            AppendString( message, cEvent_Categories, pCategory );
+        if (type != cEventType_SliceEnd && type != cEventType_Counter)
+            AppendString( message, cEvent_Name, pName );
+        if (pCounterValue)
+            AppendDouble( message, cEvent_DoubleCounterValue, *pCounterValue );
+        appendPacket( events, cPacket_TrackEvent, message, &timestamp );
+    };
+    auto toNanoseconds = [&]( uint64_t ticks ) -> uint64_t { return uint64_t( std::max( 0.0, snapshot.ToMicroseconds( ticks ) * 1000.0 ) ); };
+
+    // Process track (parent of everything that is not a thread).
+    message.clear();
+    AppendUint( message, cTrack_Uuid, cProcessUuid );
+    AppendUint( subMessage, cProcess_Pid, cPid );
+    AppendBytes( message, cTrack_Process, subMessage );
+    appendPacket( descriptors, cPacket_TrackDescriptor, message, nullptr );
+
+    std::unordered_set<uint64_t> keyedTracks;      // counter, span and lock tracks already described
+    auto keyedTrack = [&]( uint64_t kind, uint64_t key, const char* pName, bool counter ) -> uint64_t {
+        const uint64_t uuid = KeyedTrackUuid( kind, key );
+        if (keyedTracks.insert( uuid ).second)
+            appendTrack( uuid, pName, counter );
+        return uuid;
+    };
+
+    for (const auto& thread : snapshot.Threads)
+    {
+        const uint64_t threadUuid = ThreadTrackUuid( thread.ThreadId );
+        if (thread.IsTrack)
+            appendTrack( threadUuid, thread.pName, false );
+        else
+        {
+            message.clear();
+            AppendUint( message, cTrack_Uuid, threadUuid );
+            subMessage.clear();
+            AppendUint( subMessage, cThread_Pid, cPid );
+            AppendUint( subMessage, cThread_Tid, thread.ThreadId );
+            if (thread.pName)
+                AppendString( subMessage, cThread_Name, thread.pName );
+            AppendBytes( message, cTrack_Thread, subMessage );
+            appendPacket( descriptors, cPacket_TrackDescriptor, message, nullptr );
+        }
+
+        uint32_t depth = 0;     // open Begin/LockWaitBegin events (Ends without a Begin, eg overwritten, are dropped)
+        for (const Event& event : thread.Events)
+        {
+            const uint64_t ts = toNanoseconds( event.Timestamp );
+            switch (event.Type) {
+            case EventType::Begin:
+            case EventType::LockWaitBegin:
+                appendEvent( ts, cEventType_SliceBegin, threadUuid, event.pName, event.Type == EventType::Begin ? "cpu" : "lock", nullptr );
+                ++depth;
+                break;
+            case EventType::End:
+            case EventType::LockWaitEnd:
+                if (depth == 0)
+                    break;
+                --depth;
+                appendEvent( ts, cEventType_SliceEnd, threadUuid, nullptr, nullptr, nullptr );
+                break;
+            case EventType::Complete:
+                appendEvent( ts, cEventType_SliceBegin, threadUuid, event.pName, thread.IsTrack ? "track" : "cpu", nullptr );
+                appendEvent( toNanoseconds( event.Timestamp + event.Value ), cEventType_SliceEnd, threadUuid, nullptr, nullptr, nullptr );
+                break;
+            case EventType::Counter:
+            {
+                // Counter track per name (and thread, as the json export).
+                double value;
+                memcpy( &value, &event.Value, sizeof( value ) );
+                const uint64_t counterUuid = keyedTrack( 1, uint64_t( uintptr_t( event.pName ) ) ^ (uint64_t( thread.ThreadId ) << 48), event.pName, true );
+                appendEvent( ts, cEventType_Counter, counterUuid, nullptr, "counter", &value );
+                break;
+            }
+            case EventType::Instant:
+            {
+                static const char* const cCategories[] = { "marker", "message", "warning", "error" };
+                appendEvent( ts, cEventType_Instant, threadUuid, event.pName, cCategories[std::min<uint64_t>( event.Value, 3 )], nullptr );
+                break;
+            }
+            case EventType::Frame:
+                appendEvent( ts, cEventType_Instant, cProcessUuid, event.pName, "frame", nullptr );
+                break;
+            case EventType::SpanBegin:
+            case EventType::SpanEnd:
+            {
+                // Async spans get a track per id (so they can start and end on different threads).
+                const uint64_t spanUuid = keyedTrack( 2, event.Value, event.pName, false );
+                appendEvent( ts, event.Type == EventType::SpanBegin ? cEventType_SliceBegin : cEventType_SliceEnd, spanUuid, event.pName, "span", nullptr );
+                break;
+            }
+            case EventType::LockAcquired:
+            case EventType::LockReleased:
+            {
+                // Held locks are slices on a track per lock (named by the lock, the slice named by the description).
+                const auto lockNameIt = snapshot.LockNames.find( event.Value );
+                char lockName[64];
+                if (lockNameIt == snapshot.LockNames.end())
+                    snprintf( lockName, sizeof( lockName ), "Lock 0x%llx", (unsigned long long) event.Value );
+                const uint64_t lockUuid = keyedTrack( 3, event.Value, lockNameIt != snapshot.LockNames.end() ? lockNameIt->second : lockName, false );
+                appendEvent( ts, event.Type == EventType::LockAcquired ? cEventType_SliceBegin : cEventType_SliceEnd, lockUuid, event.pName ? event.pName : "Locked", "lock", nullptr );
+                break;
+            }
+            }
+        }
+    }
+    return descriptors + events;
+}
+
+bool CpuTrace::WriteTrace( const char* pFilename )
+{
+    const size_t length = strlen( pFilename );
+    auto endsWith = [&]( const char* pExtension ) { const size_t extensionLength = strlen( pExtension ); return length >= extensionLength && strcmp( pFilename + length - extensionLength, pExtension ) == 0; };
+    const bool perfetto = endsWith( ".pftrace" ) || endsWith( ".perfetto-trace" );
+    const std::string trace = perfetto ? ExportPerfettoTrace() : ExportChromeTrace();
+
+    FILE* fp = fopen( pFilename, "wb" );
+    if (!fp)
+    {
+        LOGE( "CpuTrace: unable to open %s for writing", pFilename );
+        return false;
+    }
+    const bool success = fwrite( trace.data(), 1, trace.size(), fp ) == trace.size();
+    fclose( fp );
+    if (success)
+        LOGI( "CpuTrace: wrote %zu bytes to %s", trace.size(), pFilename );
+    else
+        LOGE( "CpuTrace: error writing %s", pFilename );
+    return success;
+}
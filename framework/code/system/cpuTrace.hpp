@@ -0,0 +1,263 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+///
+/// Cpu trace event recorder, the backend for the PROFILE_* macros (profile.h) on platforms without ATrace.
+/// Each thread records in to its own fixed size ring buffer (single writer, no locks on the recording path, oldest events are overwritten)
+/// and the buffers are exported on demand as Chrome Trace Event JSON (loads in chrome://tracing and ui.perfetto.dev) or Perfetto protobuf.
+/// A thread's ring buffer is allocated by the first event it records (while recording is enabled), so naming threads or leaving recording
+/// disabled costs no memory.
+///
+/// Recording a scope with a constant name is two timestamped 32 byte writes (the timestamp is the cpu cycle/virtual counter where available).
+/// Names are stored as pointers, so must remain valid until exported (string literals, __FUNCTION__ etc).  Formatted names (printf style with
+/// arguments) are copied in to a shared string table, which takes a lock and is much slower; avoid them in hot code.
+///
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#if !(defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__) || defined(__aarch64__))
+#include <chrono>
+#endif
+
+
+/// Lock states for CpuTrace::SetLockState (and PROFILE_SET_LOCK_STATE)
+enum class CpuTraceLockState : uint32_t {
+    Released,
+    Locked,
+    Destroyed
+};
+
+
+/// Static interface to the cpu trace recorder.
+/// @ingroup System
+class CpuTrace
+{
+public:
+    enum class EventType : uint32_t {
+        Begin,          ///< start of a (thread) scope
+        End,            ///< end of the most recent Begin on this thread
+        Complete,       ///< whole scope in one event (Value is the duration)
+        Counter,        ///< Value is a double
+        Instant,        ///< Value is the instant category (InstantCategory)
+        SpanBegin,      ///< start of an asynchronous (not thread bound) span, Value is the span id
+        SpanEnd,
+        LockWaitBegin,  ///< started trying to take a lock, Value is the lock pointer
+        LockWaitEnd,    ///< finished trying to take a lock, Value is the result (non zero for success)
+        LockAcquired,   ///< Value is the lock pointer
+        LockReleased,   ///< Value is the lock pointer
+        Frame           ///< frame boundary, Value is the frame number
+    };
+    enum class InstantCategory : uint64_t {
+        Marker,
+        Message,
+        Warning,
+        Error
+    };
+
+    struct Event
+    {
+        uint64_t    Timestamp;
+        const char* pName;
+        uint64_t    Value;          ///< meaning depends on Type (double values are stored bitwise)
+        EventType   Type;
+    };
+
+    /// Initialize the recorder (calibrates the timestamp counter).  Recording starts disabled.
+    /// @param eventsPerThread ring buffer size (rounded up to a power of 2) for threads that first record after this call
+    static void Initialize( uint32_t eventsPerThread = 64 * 1024 );
+    /// Stop recording.  Thread buffers are kept (so can still be exported).
+    static void Shutdown();
+
+    static void SetEnabled( bool enabled ) { sEnabled.store( enabled, std::memory_order_relaxed ); }
+    static bool IsEnabled() { return sEnabled.load( std::memory_order_relaxed ); }
+
+    /// @return current timestamp (in trace ticks, see TicksPerMicrosecond)
+    static uint64_t Now()
+    {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+    static double TicksPerMicrosecond() { return sTicksPerMicrosecond; }
+
+    /// Name helpers.  A name with no format arguments is used as-is (no copy), otherwise it is formatted and interned.
+    static const char* Name( const char* pName ) { return pName; }
+    template<typename... T_ARGS>
+    static const char* Name( const char* pFormat, T_ARGS&&... args )
+    {
+        char buffer[256];
+        snprintf( buffer, sizeof( buffer ), pFormat, std::forward<T_ARGS>( args )... );
+        return Intern( buffer );
+    }
+    /// Copy the string in to the (never freed) trace string table.
+    /// @return pointer valid for the lifetime of the application
+    static const char* Intern( const char* pString );
+
+    /// Record an event on the calling thread (no check of IsEnabled, callers are expected to have already done so).
+    static void Record( EventType type, const char* pName, uint64_t value, uint64_t timestamp )
+    {
+        ThreadBuffer* pBuffer = tThreadBuffer;
+        if (!pBuffer || !pBuffer->pEvents)
+            pBuffer = AllocateThreadEvents();
+        Write( *pBuffer, type, pName, value, timestamp );
+    }
+    static void Record( EventType type, const char* pName, uint64_t value = 0 ) { Record( type, pName, value, Now() ); }
+
+    static void Begin( const char* pName )                                  { if (IsEnabled()) Record( EventType::Begin, pName ); }
+    static void End()                                                       { if (IsEnabled()) Record( EventType::End, nullptr ); }
+    static void Complete( const char* pName, uint64_t startTimestamp, uint64_t durationTicks ) { if (IsEnabled()) Record( EventType::Complete, pName, durationTicks, startTimestamp ); }
+    static void Counter( const char* pName, double value, uint64_t timestamp ) { if (IsEnabled()) Record( EventType::Counter, pName, DoubleBits( value ), timestamp ); }
+    static void Counter( const char* pName, double value )                  { Counter( pName, value, Now() ); }
+    static void Instant( const char* pName, InstantCategory category = InstantCategory::Marker ) { if (IsEnabled()) Record( EventType::Instant, pName, uint64_t( category ) ); }
+    static void SpanBegin( const char* pName, uint64_t id, uint64_t timestamp ) { if (IsEnabled()) Record( EventType::SpanBegin, pName, id, timestamp ); }
+    static void SpanEnd( const char* pName, uint64_t id, uint64_t timestamp )   { if (IsEnabled()) Record( EventType::SpanEnd, pName, id, timestamp ); }
+    static void TryLockBegin( const void* pLock, const char* pName )        { if (IsEnabled()) Record( EventType::LockWaitBegin, pName, (uint64_t) (uintptr_t) pLock ); }
+    static void TryLockEnd( const void* pLock, bool acquired )              { if (IsEnabled()) Record( EventType::LockWaitEnd, nullptr, acquired ? 1 : 0 ); (void) pLock; }
+    static void SetLockState( const void* pLock, CpuTraceLockState state, const char* pDescription );
+    /// Advance the frame counter (and record a frame marker).
+    static void Tick();
+
+    /// Identifies a track created with CreateTrack
+    typedef uint32_t TrackId;
+    /// Create a named track for events that are not recorded by the thread they belong to (eg gpu timer results, read back frames after they happened).
+    /// Tracks are exported alongside the thread tracks (and are never destroyed).
+    static TrackId CreateTrack( const char* pName );
+    /// Record an event (with an explicit timestamp) on a track.  Each track has a single writer, callers must not record to the same track from multiple threads at once.
+    static void RecordToTrack( TrackId track, EventType type, const char* pName, uint64_t value, uint64_t timestamp );
+
+    /// Name the calling thread (shown on the thread's track).
+    static void SetThreadName( const char* pName );
+    /// Name a lock (used for the lock's track in place of the description given to SetLockState).
+    static void SetLockName( const void* pLock, const char* pName );
+
+    /// Export everything currently in the thread buffers as Chrome Trace Event JSON.
+    /// Can be called while other threads are recording (events overwritten during the export are skipped).
+    static std::string ExportChromeTrace();
+    /// Export everything currently in the thread buffers as a (binary) Perfetto protobuf trace, using TrackDescriptor and TrackEvent packets.
+    /// Can be called while other threads are recording, as ExportChromeTrace.
+    static std::string ExportPerfettoTrace();
+    /// Export to a file, Perfetto protobuf (ExportPerfettoTrace) if the filename ends .pftrace or .perfetto-trace, Chrome JSON (ExportChromeTrace) otherwise.
+    static bool WriteTrace( const char* pFilename );
+    /// Discard all recorded events.  Only safe when no other threads are recording.
+    static void Clear();
+
+    /// @return number of events recorded (including any that have since been overwritten) across all threads
+    static uint64_t GetTotalEventCount();
+    /// @return bytes allocated for ring buffers (threads that have recorded, and tracks)
+    static size_t GetEventStorageBytes();
+
+private:
+    /// Ring buffer slot.  Relaxed atomics (plain loads and stores on our targets) so ExportChromeTrace can read slots while their thread overwrites them.
+    struct RingEvent
+    {
+        std::atomic<uint64_t>       Timestamp;
+        std::atomic<const char*>    pName;
+        std::atomic<uint64_t>       Value;
+        std::atomic<EventType>      Type;
+    };
+    struct ThreadBuffer
+    {
+        RingEvent*              pEvents = nullptr;  ///< null until the thread first records (set once, under the registry mutex)
+        uint64_t                Mask = 0;
+        std::atomic<uint64_t>   WriteIndex{ 0 };
+        uint32_t                ThreadId = 0;
+        const char*             pThreadName = nullptr;
+        bool                    IsTrack = false;    ///< created by CreateTrack (not owned by a thread)
+    };
+    struct Registry;
+    static Registry& GetRegistry();
+    /// Copy of every thread's events (for the exporters)
+    struct Snapshot;
+    static Snapshot TakeSnapshot();
+    static ThreadBuffer* RegisterThread();
+    static ThreadBuffer* AllocateThreadEvents();
+    static ThreadBuffer* AddBuffer( bool allocateEvents );
+    static void Write( ThreadBuffer& buffer, EventType type, const char* pName, uint64_t value, uint64_t timestamp )
+    {
+        // Seqlock style writer.  The release fence orders the previous WriteIndex store before the slot stores, so an exporter that
+        // sees any of this event's data will also see WriteIndex >= index (and so knows this slot is being overwritten).
+        const uint64_t index = buffer.WriteIndex.load( std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+        RingEvent& event = buffer.pEvents[index & buffer.Mask];
+        event.Timestamp.store( timestamp, std::memory_order_relaxed );
+        event.pName.store( pName, std::memory_order_relaxed );
+        event.Value.store( value, std::memory_order_relaxed );
+        event.Type.store( type, std::memory_order_relaxed );
+        buffer.WriteIndex.store( index + 1, std::memory_order_release );
+    }
+    static uint64_t DoubleBits( double value ) { uint64_t bits; static_assert(sizeof( bits ) == sizeof( value )); memcpy( &bits, &value, sizeof( bits ) ); return bits; }
+
+    static inline std::atomic<bool>     sEnabled{ false };
+    static inline double                sTicksPerMicrosecond = 1000.0;
+    static inline thread_local ThreadBuffer* tThreadBuffer = nullptr;
+};
+
+
+/// Records a Begin/End pair around its lifetime (PROFILE_SCOPE).
+class CpuTraceScope
+{
+    CpuTraceScope( const CpuTraceScope& ) = delete;
+    CpuTraceScope& operator=( const CpuTraceScope& ) = delete;
+public:
+    template<typename... T_ARGS>
+    explicit CpuTraceScope( const char* pFormat, T_ARGS&&... args ) : m_Active( CpuTrace::IsEnabled() )
+    {
+        if (m_Active)
+            CpuTrace::Record( CpuTrace::EventType::Begin, CpuTrace::Name( pFormat, std::forward<T_ARGS>( args )... ) );
+    }
+    ~CpuTraceScope()
+    {
+        if (m_Active)
+            CpuTrace::Record( CpuTrace::EventType::End, nullptr );
+    }
+private:
+    const bool m_Active;
+};
+
+
+/// Records its lifetime as a single event, but only if it lasted at least the given threshold (PROFILE_SCOPE_FILTERED).
+class CpuTraceFilteredScope
+{
+    CpuTraceFilteredScope( const CpuTraceFilteredScope& ) = delete;
+    CpuTraceFilteredScope& operator=( const CpuTraceFilteredScope& ) = delete;
+public:
+    /// @param thresholdUs minimum duration (microseconds) to record
+    template<typename... T_ARGS>
+    CpuTraceFilteredScope( uint32_t thresholdUs, const char* pFormat, T_ARGS&&... args )
+        : m_pName( CpuTrace::IsEnabled() ? CpuTrace::Name( pFormat, std::forward<T_ARGS>( args )... ) : nullptr )
+        , m_ThresholdTicks( uint64_t( thresholdUs * CpuTrace::TicksPerMicrosecond() ) )
+        , m_Start( CpuTrace::Now() )
+    {}
+    ~CpuTraceFilteredScope()
+    {
+        const uint64_t duration = CpuTrace::Now() - m_Start;
+        if (m_pName && duration >= m_ThresholdTicks)
+            CpuTrace::Complete( m_pName, m_Start, duration );
+    }
+private:
+    const char*    m_pName;
+    const uint64_t m_ThresholdTicks;
+    const uint64_t m_Start;
+};
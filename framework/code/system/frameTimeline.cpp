@@ -0,0 +1,162 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameTimeline.hpp"
+#include "os_common.h"
+#include <algorithm>
+#include <cmath>
+
+
+FrameTimeline::FrameTimeline( uint32_t historySize ) : m_HistorySize( std::max( historySize, 1u ) )
+{
+}
+
+void FrameTimeline::SetTimestampPeriod( double nanosecondsPerGpuTick )
+{
+    m_NanosecondsPerGpuTick = nanosecondsPerGpuTick;
+    if (m_Calibration.IsValid())
+        m_Calibration.CpuTicksPerGpuTick = nanosecondsPerGpuTick * CpuTrace::TicksPerMicrosecond() * 1e-3;
+}
+
+void FrameTimeline::SetCalibration( uint64_t gpuTicks, uint64_t cpuTraceTicks )
+{
+    m_Calibration.GpuTicks = gpuTicks;
+    m_Calibration.CpuTicks = cpuTraceTicks;
+    m_Calibration.CpuTicksPerGpuTick = m_NanosecondsPerGpuTick * CpuTrace::TicksPerMicrosecond() * 1e-3;
+    m_Calibration.Exact = true;
+    m_CalibrationBounds.clear();
+}
+
+FrameTimeline::Timer& FrameTimeline::FindOrAddTimer( std::string_view name, uint32_t queue )
+{
+    auto& pTimer = m_Timers[{ std::string( name ), queue }];
+    if (!pTimer)
+        pTimer = std::make_unique<Timer>( name, queue );
+    return *pTimer;
+}
+
+void FrameTimeline::AddResult( Timer& timer, uint64_t startTick, uint64_t stopTick )
+{
+    const Sample sample{ m_FrameNumber, startTick, stopTick };
+    if (timer.Samples.size() < m_HistorySize)
+        timer.Samples.push_back( sample );
+    else
+    {
+        timer.Samples[timer.NextSample] = sample;
+        timer.NextSample = (timer.NextSample + 1) % m_HistorySize;
+    }
+    ++timer.TotalSamples;
+    m_FrameResults.push_back( { &timer, startTick, stopTick } );
+}
+
+void FrameTimeline::EndFrame( uint64_t cpuTraceTicksAtReadback )
+{
+    if (!m_FrameResults.empty())
+    {
+        // Without an exact calibration point use the readback time as an upper bound for when the latest gpu work finished.
+        // The tightest bound (the frame where the cpu read the results back soonest after the gpu finished) gives an offset closest to the true one.
+        // Only bounds from the last cCalibrationWindow frames are considered, so drift between the gpu and cpu clocks (in either direction) is corrected.
+        if (!m_Calibration.Exact)
+        {
+            const uint64_t latestStopTick = std::max_element( m_FrameResults.begin(), m_FrameResults.end(), []( const auto& a, const auto& b ) { return int64_t( a.StopTick - b.StopTick ) < 0; } )->StopTick;
+            const double cpuTicksPerGpuTick = m_NanosecondsPerGpuTick * CpuTrace::TicksPerMicrosecond() * 1e-3;
+            m_CalibrationBounds.push_back( { latestStopTick, cpuTraceTicksAtReadback } );
+            if (m_CalibrationBounds.size() > cCalibrationWindow)
+                m_CalibrationBounds.pop_front();
+
+            // Offset of each bound relative to this frame's (lowest is tightest).
+            const CalibrationBound* pTightest = &m_CalibrationBounds.back();
+            double tightestOffset = 0.0;
+            for (const auto& bound : m_CalibrationBounds)
+            {
+                const double offset = double( int64_t( bound.CpuTicks - cpuTraceTicksAtReadback ) ) - double( int64_t( bound.GpuTicks - latestStopTick ) ) * cpuTicksPerGpuTick;
+                if (offset < tightestOffset)
+                {
+                    tightestOffset = offset;
+                    pTightest = &bound;
+                }
+            }
+            m_Calibration.GpuTicks = pTightest->GpuTicks;
+            m_Calibration.CpuTicks = pTightest->CpuTicks;
+            m_Calibration.CpuTicksPerGpuTick = cpuTicksPerGpuTick;
+        }
+
+        if (CpuTrace::IsEnabled() && m_Calibration.IsValid())
+        {
+            for (const auto& result : m_FrameResults)
+            {
+                Timer& timer = *result.pTimer;
+                auto trackIt = m_QueueTracks.find( timer.Queue );
+                if (trackIt == m_QueueTracks.end())
+                    trackIt = m_QueueTracks.try_emplace( timer.Queue, CpuTrace::CreateTrack( CpuTrace::Name( "GPU (queue family %u)", timer.Queue ) ) ).first;
+                if (!timer.pTraceName)
+                    timer.pTraceName = CpuTrace::Intern( timer.Name.c_str() );
+                const uint64_t start = m_Calibration.ToCpuTicks( result.StartTick );
+                const uint64_t stop = m_Calibration.ToCpuTicks( result.StopTick );
+                CpuTrace::RecordToTrack( trackIt->second, CpuTrace::EventType::Complete, timer.pTraceName, stop > start ? stop - start : 0, start );
+            }
+        }
+        m_FrameResults.clear();
+    }
+    ++m_FrameNumber;
+}
+
+FrameTimeline::Stats FrameTimeline::GetStats( const Timer& timer ) const
+{
+    std::vector<double> durations;
+    durations.reserve( timer.Samples.size() );
+    for (const auto& sample : timer.Samples)
+        durations.push_back( ToMs( sample.StopTick - sample.StartTick ) );
+    return CalculateStats( durations );
+}
+
+FrameTimeline::Stats FrameTimeline::CalculateStats( std::vector<double>& durationsMs )
+{
+    Stats stats;
+    if (durationsMs.empty())
+        return stats;
+    std::sort( durationsMs.begin(), durationsMs.end() );
+    const size_t count = durationsMs.size();
+    auto percentile = [&]( double p ) -> double {
+        const size_t rank = (size_t) std::ceil( p * 0.01 * double( count ) );
+        return durationsMs[std::clamp( rank, size_t( 1 ), count ) - 1];
+    };
+    double total = 0.0;
+    for (double duration : durationsMs)
+        total += duration;
+    stats.Count = (uint32_t) count;
+    stats.MinMs = durationsMs.front();
+    stats.MaxMs = durationsMs.back();
+    stats.MeanMs = total / double( count );
+    stats.P50Ms = percentile( 50.0 );
+    stats.P95Ms = percentile( 95.0 );
+    stats.P99Ms = percentile( 99.0 );
+    return stats;
+}
+
+void FrameTimeline::Log() const
+{
+    LOGI( "GPU timers (last %u results per timer):", m_HistorySize );
+    for (const auto& [key, pTimer] : m_Timers)
+    {
+        const Stats stats = GetStats( *pTimer );
+        if (stats.Count == 0)
+            continue;
+        LOGI( "  %-32s (queue %u) : mean %.3fms  p50 %.3fms  p95 %.3fms  p99 %.3fms  (min %.3fms max %.3fms, %u samples)", pTimer->Name.c_str(), pTimer->Queue, stats.MeanMs, stats.P50Ms, stats.P95Ms, stats.P99Ms, stats.MinMs, stats.MaxMs, stats.Count );
+    }
+}
+
+void FrameTimeline::Clear()
+{
+    for (auto& [key, pTimer] : m_Timers)
+    {
+        pTimer->Samples.clear();
+        pTimer->NextSample = 0;
+    }
+    m_FrameResults.clear();
+}
@@ -0,0 +1,132 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+///
+/// Per-frame history of gpu timer results (raw start/stop ticks), with percentile statistics and
+/// conversion of gpu ticks on to the CpuTrace timebase so gpu work appears on the same timeline as the cpu scopes.
+/// Graphics api independent; the api specific timer pool (eg TimerPoolTimeline) feeds it the timer results and calibration points.
+///
+
+#include "cpuTrace.hpp"
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+/// Mapping from gpu timestamp ticks to CpuTrace ticks (a single calibration point plus the relative tick rate).
+struct GpuClockCalibration
+{
+    uint64_t GpuTicks = 0;              ///< gpu timestamp at the calibration point
+    uint64_t CpuTicks = 0;              ///< CpuTrace::Now() at the same moment
+    double   CpuTicksPerGpuTick = 0.0;  ///< 0 if not yet calibrated
+    bool     Exact = false;             ///< true if the calibration point came from the driver (eg VK_EXT_calibrated_timestamps), false if estimated from result readback times
+
+    bool IsValid() const { return CpuTicksPerGpuTick > 0.0; }
+    uint64_t ToCpuTicks( uint64_t gpuTicks ) const { return CpuTicks + uint64_t( int64_t( double( int64_t( gpuTicks - GpuTicks ) ) * CpuTicksPerGpuTick ) ); }
+};
+
+
+/// History of gpu timer results.
+/// @ingroup System
+class FrameTimeline
+{
+    FrameTimeline( const FrameTimeline& ) = delete;
+    FrameTimeline& operator=( const FrameTimeline& ) = delete;
+public:
+    /// One timer result
+    struct Sample
+    {
+        uint64_t Frame;         ///< FrameTimeline frame number the result was read back on
+        uint64_t StartTick;     ///< raw gpu ticks
+        uint64_t StopTick;
+    };
+
+    /// Results for one named timer (on one queue).  Pointers remain valid for the lifetime of the FrameTimeline.
+    struct Timer
+    {
+        Timer( std::string_view name, uint32_t queue ) : Name( name ), Queue( queue ) {}
+        const std::string       Name;
+        const uint32_t          Queue;
+        std::vector<Sample>     Samples;        ///< ring buffer (of up to the FrameTimeline's history size)
+        size_t                  NextSample = 0; ///< index in Samples of the next write (once Samples is full)
+        uint64_t                TotalSamples = 0;
+        const char*             pTraceName = nullptr;
+    };
+
+    /// Statistics (in milliseconds) over the samples currently held for a timer.  Percentiles use the nearest rank method.
+    struct Stats
+    {
+        uint32_t Count = 0;
+        double   MinMs = 0.0;
+        double   MeanMs = 0.0;
+        double   P50Ms = 0.0;
+        double   P95Ms = 0.0;
+        double   P99Ms = 0.0;
+        double   MaxMs = 0.0;
+    };
+
+    /// Number of frames of readback times used to estimate the calibration (when there is no exact calibration).
+    static constexpr uint32_t cCalibrationWindow = 120;
+
+    /// @param historySize number of samples kept per timer
+    explicit FrameTimeline( uint32_t historySize = 256 );
+
+    /// @param nanosecondsPerGpuTick gpu timestamp period (eg VkPhysicalDeviceLimits::timestampPeriod)
+    void SetTimestampPeriod( double nanosecondsPerGpuTick );
+    double GetTimestampPeriod() const { return m_NanosecondsPerGpuTick; }
+
+    /// Set an exact calibration point (gpu and cpu timestamps taken at the same moment, eg from vkGetCalibratedTimestampsEXT).
+    /// Overrides any estimated calibration.
+    void SetCalibration( uint64_t gpuTicks, uint64_t cpuTraceTicks );
+    const GpuClockCalibration& GetCalibration() const { return m_Calibration; }
+
+    /// @return the timer with the given name and queue (created if it does not exist)
+    Timer& FindOrAddTimer( std::string_view name, uint32_t queue );
+
+    /// Add a (completed) timer result to the current frame.
+    void AddResult( Timer& timer, uint64_t startTick, uint64_t stopTick );
+
+    /// Finish the current frame's results.
+    /// If there is no exact calibration the calibration is estimated from the frame's latest stop tick (which must have happened before the cpu read it back),
+    /// taking the tightest of the last cCalibrationWindow frames' estimates.
+    /// When CpuTrace is enabled the frame's results are then recorded on a CpuTrace track per queue.
+    /// @param cpuTraceTicksAtReadback CpuTrace::Now() at the point the results were read back (ie after the gpu work completed)
+    void EndFrame( uint64_t cpuTraceTicksAtReadback );
+
+    uint64_t GetFrameNumber() const { return m_FrameNumber; }
+    const auto& GetTimers() const { return m_Timers; }
+
+    Stats GetStats( const Timer& timer ) const;
+    /// Calculate statistics for an arbitrary set of durations (modifies the order of the given durations).
+    static Stats CalculateStats( std::vector<double>& durationsMs );
+
+    /// Log the statistics for every timer (using LOGI)
+    void Log() const;
+
+    /// Discard all results (timers and calibration are kept)
+    void Clear();
+
+private:
+    double ToMs( uint64_t ticks ) const { return double( ticks ) * m_NanosecondsPerGpuTick * 1e-6; }
+
+    const uint32_t                                          m_HistorySize;
+    double                                                  m_NanosecondsPerGpuTick = 1.0;
+    GpuClockCalibration                                     m_Calibration;
+    uint64_t                                                m_FrameNumber = 0;
+    std::map<std::pair<std::string, uint32_t>, std::unique_ptr<Timer>> m_Timers;
+    std::map<uint32_t, CpuTrace::TrackId>                   m_QueueTracks;
+    struct PendingResult { Timer* pTimer; uint64_t StartTick; uint64_t StopTick; };
+    std::vector<PendingResult>                              m_FrameResults;     ///< results added since the last EndFrame
+    struct CalibrationBound { uint64_t GpuTicks; uint64_t CpuTicks; };
+    std::deque<CalibrationBound>                            m_CalibrationBounds;    ///< latest stop tick and readback time of recent frames (estimated calibration)
+};
@@ -13,6 +13,14 @@
 #define SYS_PROFILING_ENABLED
 #define SYS_PROFILE_ATRACE
 
+#elif !defined(SYS_PROFILING_DISABLED)
+
+// Other platforms use the built in cpu trace recorder (system/cpuTrace.hpp), define SYS_PROFILING_DISABLED to compile the macros out.
+#define SYS_PROFILING_ENABLED
+#define SYS_PROFILE_CPUTRACE
+
+#endif // OS_ANDROID
+
 #if defined(SYS_PROFILING_ENABLED)
 
 #if defined(SYS_PROFILE_ATRACE)
@@ -162,6 +170,118 @@ void ShutdownATrace();
 
 #endif //defined(SYS_PROFILE_ATRACE)
 
+#if defined(SYS_PROFILE_CPUTRACE)
+
+#include "cpuTrace.hpp"
+
+#define SYS_PROFILE_CONCAT_(a, b) a##b
+#define SYS_PROFILE_CONCAT(a, b) SYS_PROFILE_CONCAT_(a, b)
+
+#define GROUP_GENERIC
+#define GROUP_VKFRAMEWORK
+
+// Timestamp in CpuTrace ticks (for the _AT macros)
+#define PROFILE_FASTTIME() CpuTrace::Now()
+
+#define PROFILE_INITIALIZE() CpuTrace::Initialize()
+
+#define PROFILE_SHUTDOWN() CpuTrace::Shutdown()
+
+// Scopes last until the end of the enclosing C++ scope.  PROFILE_SCOPE_END is accepted (for code written against ATrace) but does nothing.
+#define PROFILE_SCOPE_FILTERED(context, threshold, flags, format, ...) CpuTraceFilteredScope SYS_PROFILE_CONCAT(sysProfileScope, __LINE__)( (threshold), format, ##__VA_ARGS__ )
+
+#define PROFILE_SCOPE(context, flags, format, ...) CpuTraceScope SYS_PROFILE_CONCAT(sysProfileScope, __LINE__)( format, ##__VA_ARGS__ )
+
+#define PROFILE_SCOPE_END()
+
+#define PROFILE_SCOPE_DEFAULT(context) PROFILE_SCOPE(context, 0, __FUNCTION__)
+#define PROFILE_SCOPE_IDLE(context) PROFILE_SCOPE(context, 0, "Idle")
+#define PROFILE_SCOPE_STALL(context) PROFILE_SCOPE(context, 0, "Stall")
+
+#define PROFILE_TICK() CpuTrace::Tick()
+
+#define PROFILE_EXIT(context) CpuTrace::End()
+
+#define PROFILE_EXIT_EX(context, match_id, thread_id, filename, line) CpuTrace::End()
+
+#define PROFILE_TRY_LOCK(context, ptr, lock_name, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::TryLockBegin( (ptr), CpuTrace::Name( lock_name, ##__VA_ARGS__ ) ); } while(0)
+
+#define PROFILE_TRY_LOCK_EX(context, matcher, threshold, filename, line, ptr, lock_name, ... ) PROFILE_TRY_LOCK(context, ptr, lock_name, ##__VA_ARGS__)
+
+#define PROFILE_END_TRY_LOCK(context, ptr, result ) CpuTrace::TryLockEnd( (ptr), (result) )
+
+#define PROFILE_END_TRY_LOCK_EX(context, match_id, filename, line, ptr, result ) CpuTrace::TryLockEnd( (ptr), (result) )
+
+#define PROFILE_BEGIN_TIME_SPAN(context, id, flags, name_format, ... ) PROFILE_BEGIN_TIME_SPAN_AT(context, id, flags, CpuTrace::Now(), name_format, ##__VA_ARGS__)
+
+#define PROFILE_END_TIME_SPAN(context, id, flags, name_format, ... ) PROFILE_END_TIME_SPAN_AT(context, id, flags, CpuTrace::Now(), name_format, ##__VA_ARGS__)
+
+#define PROFILE_BEGIN_TIME_SPAN_AT(context, id, flags, timestamp, name_format, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::SpanBegin( CpuTrace::Name( name_format, ##__VA_ARGS__ ), (uint64_t)(id), (timestamp) ); } while(0)
+
+#define PROFILE_END_TIME_SPAN_AT(context, id, flags, timestamp, name_format, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::SpanEnd( CpuTrace::Name( name_format, ##__VA_ARGS__ ), (uint64_t)(id), (timestamp) ); } while(0)
+
+#define PROFILE_SIGNAL_LOCK_COUNT(context, ptr, count, description, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::Counter( CpuTrace::Name( description, ##__VA_ARGS__ ), double(count) ); } while(0)
+
+// state is a CpuTraceLockState
+#define PROFILE_SET_LOCK_STATE(context, ptr, state, description, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::SetLockState( (ptr), (state), CpuTrace::Name( description, ##__VA_ARGS__ ) ); } while(0)
+
+#define PROFILE_SET_LOCK_STATE_EX(context, filename, line, ptr, state, description, ... ) PROFILE_SET_LOCK_STATE(context, ptr, state, description, ##__VA_ARGS__)
+
+#define PROFILE_SET_LOCK_STATE_MIN_TIME(context, buf, ptr, state, description, ... ) PROFILE_SET_LOCK_STATE(context, ptr, state, description, ##__VA_ARGS__)
+
+#define PROFILE_SET_LOCK_STATE_MIN_TIME_EX(context, buf, filename, line, ptr, state, description, ... ) PROFILE_SET_LOCK_STATE(context, ptr, state, description, ##__VA_ARGS__)
+
+// Only naming the calling thread (thread_id 0) is supported.
+#define PROFILE_THREAD_NAME(context, thread_id, name_format, ... ) do { if ((thread_id) == 0) CpuTrace::SetThreadName( CpuTrace::Name( name_format, ##__VA_ARGS__ ) ); } while(0)
+
+#define PROFILE_LOCK_NAME(context, ptr, name_format, ... ) CpuTrace::SetLockName( (ptr), CpuTrace::Name( name_format, ##__VA_ARGS__ ) )
+
+// start and total are in CpuTrace ticks
+#define PROFILE_EMIT_ACCUMULATION_ZONE(context, zone_flags, start, count, total, zone_format, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::Complete( CpuTrace::Name( zone_format, ##__VA_ARGS__ ), (start), (total) ); } while(0)
+
+#define PROFILE_SET_VARIABLE(context, key, value_format, ... )
+
+#define PROFILE_SET_TIMELINE_SECTION_NAME(context, name_format, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::Instant( CpuTrace::Name( name_format, ##__VA_ARGS__ ) ); } while(0)
+
+#define PROFILE_ENTER(context, flags, zone_name, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::Begin( CpuTrace::Name( zone_name, ##__VA_ARGS__ ) ); } while(0)
+
+#define PROFILE_ENTER_EX(context, match_id, thread_id, threshold, filename, line, flags, zone_name, ... ) PROFILE_ENTER(context, flags, zone_name, ##__VA_ARGS__)
+
+#define PROFILE_ALLOC(context, ptr, size, description, ... )
+
+#define PROFILE_ALLOC_EX(context, filename, line_number, ptr, size, description, ... )
+
+#define PROFILE_FREE(context, ptr)
+
+#define PROFILE_MESSAGE(context, flags, format_string, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::Instant( CpuTrace::Name( format_string, ##__VA_ARGS__ ), CpuTrace::InstantCategory::Message ); } while(0)
+#define PROFILE_LOG(context, flags, format_string, ... ) PROFILE_MESSAGE(context, flags, format_string, ##__VA_ARGS__)
+#define PROFILE_WARNING(context, flags, format_string, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::Instant( CpuTrace::Name( format_string, ##__VA_ARGS__ ), CpuTrace::InstantCategory::Warning ); } while(0)
+#define PROFILE_ERROR(context, flags, format_string, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::Instant( CpuTrace::Name( format_string, ##__VA_ARGS__ ), CpuTrace::InstantCategory::Error ); } while(0)
+
+#define PROFILE_PLOT(context, type, flags, value, name_format, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::Counter( CpuTrace::Name( name_format, ##__VA_ARGS__ ), double(value) ); } while(0)
+
+#define PROFILE_PLOT_F32(context, type, flags, value, name_format, ... ) PROFILE_PLOT(context, type, flags, value, name_format, ##__VA_ARGS__)
+
+#define PROFILE_PLOT_F64(context, type, flags, value, name_format, ... ) PROFILE_PLOT(context, type, flags, value, name_format, ##__VA_ARGS__)
+
+#define PROFILE_PLOT_I32(context, type, flags, value, name_format, ... ) PROFILE_PLOT(context, type, flags, value, name_format, ##__VA_ARGS__)
+
+#define PROFILE_PLOT_U32(context, type, flags, value, name_format, ... ) PROFILE_PLOT(context, type, flags, value, name_format, ##__VA_ARGS__)
+
+#define PROFILE_PLOT_I64(context, type, flags, value, name_format, ... ) PROFILE_PLOT(context, type, flags, value, name_format, ##__VA_ARGS__)
+
+#define PROFILE_PLOT_U64(context, type, flags, value, name_format, ... ) PROFILE_PLOT(context, type, flags, value, name_format, ##__VA_ARGS__)
+
+#define PROFILE_PLOT_AT(context, timestamp, type, flags, value, name_format, ... ) do { if (CpuTrace::IsEnabled()) CpuTrace::Counter( CpuTrace::Name( name_format, ##__VA_ARGS__ ), double(value), (timestamp) ); } while(0)
+
+#define PROFILE_BLOB(context, data, data_size, plugin_identifier, blob_name, ...)
+
+#define PROFILE_DISJOINT_BLOB(context, num_pieces, data, data_sizes, plugin_identifier, blob_name, ... )
+
+#define PROFILE_SEND_CALLSTACK(context, callstack)
+
+#endif //defined(SYS_PROFILE_CPUTRACE)
+
 #else  //defined(SYS_PROFILING_ENABLED)
 
 #define GROUP_GENERIC              
@@ -262,5 +382,3 @@ void ShutdownATrace();
 
 #endif //defined(SYS_PROFILING_ENABLED)
 
-#endif // OS_ANDROID
-
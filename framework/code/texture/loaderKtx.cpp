@@ -17,7 +17,7 @@ TextureKtxFileWrapper::~TextureKtxFileWrapper() noexcept
 {
     Release();
 }
-TextureKtxFileWrapper::TextureKtxFileWrapper(TextureKtxFileWrapper&& other) noexcept : m_fileData(std::move(other.m_fileData))
+TextureKtxFileWrapper::TextureKtxFileWrapper(TextureKtxFileWrapper&& other) noexcept : m_fileData(std::move(other.m_fileData)), m_sharedFileData(std::move(other.m_sharedFileData))
 {
     std::swap(m_ktxTexture, other.m_ktxTexture);
 }
@@ -29,6 +29,7 @@ TextureKtxFileWrapper& TextureKtxFileWrapper::operator=(TextureKtxFileWrapper&&
         this->m_ktxTexture = other.m_ktxTexture;
         other.m_ktxTexture = nullptr;
         this->m_fileData = std::move(other.m_fileData);
+        this->m_sharedFileData = std::move(other.m_sharedFileData);
     }
     return *this;
 }
@@ -52,14 +53,16 @@ bool TextureKtxBase::Initialize()
 
 TextureKtxFileWrapper TextureKtxBase::LoadFile(AssetManager& assetManager, const char* const pFileName) const
 {
-    std::vector<uint8_t> fileData;
-    if (!assetManager.LoadFileIntoMemory(pFileName, fileData))
+    // File data is shared with the AssetCache (repeat loads of the same texture do not go back to storage).
+    AssetBuffer sharedFileData = assetManager.LoadFileShared(pFileName);
+    if (!sharedFileData)
     {
         LOGE("Error reading texture file: %s", pFileName);
         return {};
     }
 
     ///HACK: some of our ktx files have gl internal format and gl format set to be the same thing, which is the ktx library doesnt like.
+    // The shared data is immutable, so only take a (patchable) copy of the file when the header needs fixing up.
     if (1)
     {
         struct KtxHeader {
@@ -78,43 +81,55 @@ TextureKtxFileWrapper TextureKtxBase::LoadFile(AssetManager& assetManager, const
             uint32_t  numberOfMipmapLevels;
             uint32_t  bytesOfKeyValueData;
         };
-        KtxHeader* pHeader = (KtxHeader*)fileData.data();
+        const KtxHeader* pHeader = (const KtxHeader*)sharedFileData.data();
 
         ktx_uint8_t ktx_identifier[] = KTX_IDENTIFIER_REF;
-        if (fileData.size() >= sizeof( KtxHeader ) && memcmp( pHeader->identifier, ktx_identifier, sizeof( ktx_identifier ) ) == 0)
+        if (sharedFileData.size() >= sizeof( KtxHeader ) && memcmp( pHeader->identifier, ktx_identifier, sizeof( ktx_identifier ) ) == 0)
         {
             const auto glFormat = pHeader->glFormat;
             const auto glType = pHeader->glType;
+            uint32_t glInternalFormat = pHeader->glInternalFormat;
 
             // Pure hack!
-            if (glFormat == 6408 && pHeader->glInternalFormat == 36220 && glType == GL_UNSIGNED_BYTE)
+            if (glFormat == 6408 && glInternalFormat == 36220 && glType == GL_UNSIGNED_BYTE)
             {
-                pHeader->glInternalFormat = GL_RGBA8;
+                glInternalFormat = GL_RGBA8;
             }
 
             // Internal format should be sized but some exporters write it as untyped, see if we can fix that!
-            if ((glFormat == pHeader->glInternalFormat) && glFormat != 0)
+            if ((glFormat == glInternalFormat) && glFormat != 0)
             {
                 if (glType == GL_UNSIGNED_BYTE && glFormat == GL_RGB)
                 {
-                    pHeader->glInternalFormat = GL_RGB8;
+                    glInternalFormat = GL_RGB8;
                 }
                 else if (glType == GL_UNSIGNED_BYTE && glFormat == GL_RED)
                 {
-                    pHeader->glInternalFormat = GL_R8;
+                    glInternalFormat = GL_R8;
                 }
                 else if (glType == GL_UNSIGNED_BYTE && glFormat == GL_RGBA)
                 {
-                    //pHeader->glInternalFormat = GL_SRGB8_ALPHA8_EXT;
-                    pHeader->glInternalFormat = GL_RGBA8;
+                    //glInternalFormat = GL_SRGB8_ALPHA8_EXT;
+                    glInternalFormat = GL_RGBA8;
                 }
             }
+
+            if (glInternalFormat != pHeader->glInternalFormat)
+            {
+                std::vector<uint8_t> fileData{ sharedFileData.data(), sharedFileData.data() + sharedFileData.size() };
+                ((KtxHeader*)fileData.data())->glInternalFormat = glInternalFormat;
+
+                TextureKtxFileWrapper textureData {std::move(fileData)};
+                if (KTX_SUCCESS != ktxTexture_CreateFromMemory(textureData.m_fileData.data(), textureData.m_fileData.size(), KTX_TEXTURE_CREATE_NO_FLAGS, &textureData.m_ktxTexture))
+                    return {};
+                return textureData;
+            }
         }
     }
     ///ENDHACK
 
-    TextureKtxFileWrapper textureData {std::move(fileData)};
-    if (KTX_SUCCESS != ktxTexture_CreateFromMemory(textureData.m_fileData.data(), textureData.m_fileData.size(), KTX_TEXTURE_CREATE_NO_FLAGS, &textureData.m_ktxTexture))
+    TextureKtxFileWrapper textureData {std::move(sharedFileData)};
+    if (KTX_SUCCESS != ktxTexture_CreateFromMemory(textureData.m_sharedFileData.data(), textureData.m_sharedFileData.size(), KTX_TEXTURE_CREATE_NO_FLAGS, &textureData.m_ktxTexture))
         return {};
     return textureData;
 }
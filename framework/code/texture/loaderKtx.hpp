@@ -7,6 +7,7 @@
 #pragma once
 
 #include <vector>
+#include "system/assetCache.hpp"
 
 ///
 /// KTX image file loading
@@ -27,6 +28,7 @@ class TextureKtxFileWrapper final
 public:
     TextureKtxFileWrapper() noexcept = default;
     TextureKtxFileWrapper(std::vector<uint8_t>&& fileData) noexcept : m_fileData(std::move(fileData)) {}
+    TextureKtxFileWrapper(AssetBuffer sharedFileData) noexcept : m_sharedFileData(std::move(sharedFileData)) {}
     ~TextureKtxFileWrapper() noexcept;
     TextureKtxFileWrapper(TextureKtxFileWrapper&&) noexcept;
     TextureKtxFileWrapper& operator=(TextureKtxFileWrapper&&) noexcept;
@@ -37,7 +39,8 @@ protected:
     auto GetKtxTexture() const { return m_ktxTexture; }
 private:
     ktxTexture* m_ktxTexture = nullptr;
-    std::vector<uint8_t> m_fileData;            ///< contents of .ktx file (ktxTexture_CreateFromMemory does not take a copy of all the data in here, so we need to retain it)
+    std::vector<uint8_t> m_fileData;            ///< contents of .ktx file (ktxTexture_CreateFromMemory does not take a copy of all the data in here, so we need to retain it).  Only used when the file data had to be patched.
+    AssetBuffer m_sharedFileData;               ///< contents of .ktx file when used as-is (shared with the AssetCache)
 };
 
 /// @brief Class to handle loading KTX textures
@@ -0,0 +1,911 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "textureCompress.hpp"
+#include "textureConvert.hpp"
+#include "system/Worker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    /// How each supported format encodes a 4x4 block.
+    enum class BlockEncoding {
+        None,
+        Bc1,        ///< 4 color BC1
+        Bc1Alpha,   ///< BC1 using the 3 color + transparent mode for blocks with alpha < 128
+        Bc3,        ///< BC4 alpha + BC1 color
+        Bc4,        ///< red
+        Bc5,        ///< red, green (two BC4 blocks)
+        Etc2Rgb,
+        Etc2Rgba,   ///< EAC alpha + ETC2 color
+        EacR11,
+        EacRg11     ///< red, green (two EAC R11 blocks)
+    };
+
+    BlockEncoding GetBlockEncoding( TextureFormat format )
+    {
+        switch (format) {
+        case TextureFormat::BC1_RGB_UNORM_BLOCK:
+        case TextureFormat::BC1_RGB_SRGB_BLOCK:
+            return BlockEncoding::Bc1;
+        case TextureFormat::BC1_RGBA_UNORM_BLOCK:
+        case TextureFormat::BC1_RGBA_SRGB_BLOCK:
+            return BlockEncoding::Bc1Alpha;
+        case TextureFormat::BC3_UNORM_BLOCK:
+        case TextureFormat::BC3_SRGB_BLOCK:
+            return BlockEncoding::Bc3;
+        case TextureFormat::BC4_UNORM_BLOCK:
+            return BlockEncoding::Bc4;
+        case TextureFormat::BC5_UNORM_BLOCK:
+            return BlockEncoding::Bc5;
+        case TextureFormat::ETC2_R8G8B8_UNORM_BLOCK:
+        case TextureFormat::ETC2_R8G8B8_SRGB_BLOCK:
+            return BlockEncoding::Etc2Rgb;
+        case TextureFormat::ETC2_R8G8B8A8_UNORM_BLOCK:
+        case TextureFormat::ETC2_R8G8B8A8_SRGB_BLOCK:
+            return BlockEncoding::Etc2Rgba;
+        case TextureFormat::EAC_R11_UNORM_BLOCK:
+            return BlockEncoding::EacR11;
+        case TextureFormat::EAC_R11G11_UNORM_BLOCK:
+            return BlockEncoding::EacRg11;
+        default:
+            return BlockEncoding::None;
+        }
+    }
+
+    size_t BlockBytes( BlockEncoding encoding )
+    {
+        switch (encoding) {
+        case BlockEncoding::Bc1:
+        case BlockEncoding::Bc1Alpha:
+        case BlockEncoding::Bc4:
+        case BlockEncoding::Etc2Rgb:
+        case BlockEncoding::EacR11:
+            return 8;
+        case BlockEncoding::None:
+            return 0;
+        default:
+            return 16;
+        }
+    }
+
+    /// 4x4 block of RGBA8 pixels, pixel index is y*4+x
+    struct PixelBlock
+    {
+        uint8_t Rgba[16][4];
+
+        void GetChannel( uint32_t channel, uint8_t values[16] ) const
+        {
+            for (uint32_t i = 0; i < 16; ++i)
+                values[i] = Rgba[i][channel];
+        }
+    };
+
+    /// Load a block from a tightly packed RGBA8 image, clamping at the right and bottom edges.
+    void LoadBlock( const uint8_t* pImage, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, PixelBlock& block )
+    {
+        for (uint32_t y = 0; y < 4; ++y)
+        {
+            const uint8_t* pRow = pImage + size_t( std::min( blockY * 4 + y, height - 1 ) ) * width * 4;
+            for (uint32_t x = 0; x < 4; ++x)
+                memcpy( block.Rgba[y * 4 + x], pRow + size_t( std::min( blockX * 4 + x, width - 1 ) ) * 4, 4 );
+        }
+    }
+
+    void WriteBigEndian( uint8_t* pDst, uint64_t value, uint32_t numBytes )
+    {
+        for (uint32_t i = 0; i < numBytes; ++i)
+            pDst[i] = uint8_t( value >> (8 * (numBytes - 1 - i)) );
+    }
+
+    void WriteLittleEndian( uint8_t* pDst, uint64_t value, uint32_t numBytes )
+    {
+        for (uint32_t i = 0; i < numBytes; ++i)
+            pDst[i] = uint8_t( value >> (8 * i) );
+    }
+
+    int ColorDistanceSq( const int a[3], const uint8_t b[4] )
+    {
+        const int dr = a[0] - b[0], dg = a[1] - b[1], db = a[2] - b[2];
+        return dr * dr + dg * dg + db * db;
+    }
+
+
+    //
+    // BC1 (and the color part of BC3)
+    //
+
+    uint16_t PackRgb565( const float rgb[3] )
+    {
+        const int r = std::clamp( int( rgb[0] * (31.0f / 255.0f) + 0.5f ), 0, 31 );
+        const int g = std::clamp( int( rgb[1] * (63.0f / 255.0f) + 0.5f ), 0, 63 );
+        const int b = std::clamp( int( rgb[2] * (31.0f / 255.0f) + 0.5f ), 0, 31 );
+        return uint16_t( (r << 11) | (g << 5) | b );
+    }
+
+    void UnpackRgb565( uint16_t color, int rgb[3] )
+    {
+        const int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+        rgb[0] = (r << 3) | (r >> 2);
+        rgb[1] = (g << 2) | (g >> 4);
+        rgb[2] = (b << 3) | (b >> 2);
+    }
+
+    struct Bc1Candidate
+    {
+        uint16_t Color0 = 0;
+        uint16_t Color1 = 0;
+        uint8_t  Indices[16] = {};
+        uint32_t Error = std::numeric_limits<uint32_t>::max();
+    };
+
+    /// Choose the best palette index for each pixel, given (unordered) endpoints.
+    /// Orders the endpoints for the requested mode (Color0 > Color1 for 4 color, Color0 <= Color1 for 3 color + transparent).
+    /// @param opaqueMask bit per pixel, pixels without their bit set get the transparent index (3 color mode only)
+    Bc1Candidate EvaluateBc1( const PixelBlock& block, uint16_t color0, uint16_t color1, bool threeColor, uint32_t opaqueMask )
+    {
+        Bc1Candidate candidate;
+        if (threeColor ? (color0 > color1) : (color0 < color1))
+            std::swap( color0, color1 );
+        candidate.Color0 = color0;
+        candidate.Color1 = color1;
+
+        int palette[4][3];
+        UnpackRgb565( color0, palette[0] );
+        UnpackRgb565( color1, palette[1] );
+        uint32_t paletteSize;
+        if (threeColor)
+        {
+            for (int c = 0; c < 3; ++c)
+                palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            paletteSize = 3;
+        }
+        else if (color0 == color1)
+        {
+            // Equal endpoints decode as 3 color mode, only index 0 is safe to use.
+            paletteSize = 1;
+        }
+        else
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+            paletteSize = 4;
+        }
+
+        uint32_t error = 0;
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            if ((opaqueMask & (1u << i)) == 0)
+            {
+                candidate.Indices[i] = 3;
+                continue;
+            }
+            int bestDistance = ColorDistanceSq( palette[0], block.Rgba[i] );
+            uint8_t bestIndex = 0;
+            for (uint32_t p = 1; p < paletteSize; ++p)
+            {
+                const int distance = ColorDistanceSq( palette[p], block.Rgba[i] );
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    bestIndex = uint8_t( p );
+                }
+            }
+            candidate.Indices[i] = bestIndex;
+            error += uint32_t( bestDistance );
+        }
+        candidate.Error = error;
+        return candidate;
+    }
+
+    /// Initial endpoints.  Fastest uses the (inset) bounding box, otherwise the extent of the pixels along the principal axis.
+    void Bc1InitialEndpoints( const PixelBlock& block, uint32_t opaqueMask, BlockCompressQuality quality, float endpoint0[3], float endpoint1[3] )
+    {
+        float minC[3] = { 255.0f, 255.0f, 255.0f }, maxC[3] = { 0.0f, 0.0f, 0.0f };
+        float mean[3] = {};
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            if ((opaqueMask & (1u << i)) == 0)
+                continue;
+            for (int c = 0; c < 3; ++c)
+            {
+                const float v = block.Rgba[i][c];
+                minC[c] = std::min( minC[c], v );
+                maxC[c] = std::max( maxC[c], v );
+                mean[c] += v;
+            }
+            ++count;
+        }
+
+        if (quality == BlockCompressQuality::Fastest)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                const float inset = (maxC[c] - minC[c]) * (1.0f / 16.0f);
+                endpoint0[c] = maxC[c] - inset;
+                endpoint1[c] = minC[c] + inset;
+            }
+            return;
+        }
+
+        for (int c = 0; c < 3; ++c)
+            mean[c] /= float( count );
+        float covariance[6] = {};    // rr, rg, rb, gg, gb, bb
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            if ((opaqueMask & (1u << i)) == 0)
+                continue;
+            const float r = block.Rgba[i][0] - mean[0], g = block.Rgba[i][1] - mean[1], b = block.Rgba[i][2] - mean[2];
+            covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+            covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+        }
+
+        // Power iteration for the principal axis (starting along the bounding box diagonal).
+        float axis[3] = { maxC[0] - minC[0], maxC[1] - minC[1], maxC[2] - minC[2] };
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            const float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+            const float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+            const float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+            const float scale = std::max( std::max( std::abs( x ), std::abs( y ) ), std::abs( z ) );
+            if (scale < 1e-6f)
+                break;
+            axis[0] = x / scale; axis[1] = y / scale; axis[2] = z / scale;
+        }
+        const float lengthSq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        if (lengthSq < 1e-6f)
+        {
+            // Single color
+            for (int c = 0; c < 3; ++c)
+                endpoint0[c] = endpoint1[c] = mean[c];
+            return;
+        }
+
+        float tMin = std::numeric_limits<float>::max(), tMax = -std::numeric_limits<float>::max();
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            if ((opaqueMask & (1u << i)) == 0)
+                continue;
+            const float t = ((block.Rgba[i][0] - mean[0]) * axis[0] + (block.Rgba[i][1] - mean[1]) * axis[1] + (block.Rgba[i][2] - mean[2]) * axis[2]) / lengthSq;
+            tMin = std::min( tMin, t );
+            tMax = std::max( tMax, t );
+        }
+        for (int c = 0; c < 3; ++c)
+        {
+            endpoint0[c] = std::clamp( mean[c] + axis[c] * tMax, 0.0f, 255.0f );
+            endpoint1[c] = std::clamp( mean[c] + axis[c] * tMin, 0.0f, 255.0f );
+        }
+    }
+
+    /// Least squares fit of the (4 color mode) endpoints to the pixels, given each pixel's palette index.
+    /// @return false if the system is degenerate (all pixels on one index)
+    bool Bc1FitEndpoints( const PixelBlock& block, const uint8_t indices[16], float endpoint0[3], float endpoint1[3] )
+    {
+        static constexpr float cWeight0[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+        float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+        float ax[3] = {}, bx[3] = {};
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            const float a = cWeight0[indices[i]];
+            const float b = 1.0f - a;
+            aa += a * a; bb += b * b; ab += a * b;
+            for (int c = 0; c < 3; ++c)
+            {
+                ax[c] += a * block.Rgba[i][c];
+                bx[c] += b * block.Rgba[i][c];
+            }
+        }
+        const float determinant = aa * bb - ab * ab;
+        if (std::abs( determinant ) < 1e-6f)
+            return false;
+        const float rcp = 1.0f / determinant;
+        for (int c = 0; c < 3; ++c)
+        {
+            endpoint0[c] = std::clamp( (ax[c] * bb - bx[c] * ab) * rcp, 0.0f, 255.0f );
+            endpoint1[c] = std::clamp( (bx[c] * aa - ax[c] * ab) * rcp, 0.0f, 255.0f );
+        }
+        return true;
+    }
+
+    /// Encode the 8 byte BC1 color block.
+    /// @param punchThrough use the 3 color + transparent mode if any pixels have alpha < 128 (BC1_RGBA formats only, BC3 color blocks are always 4 color)
+    void EncodeBc1( const PixelBlock& block, uint8_t* pDst, bool punchThrough, BlockCompressQuality quality )
+    {
+        uint32_t opaqueMask = 0xffff;
+        if (punchThrough)
+        {
+            for (uint32_t i = 0; i < 16; ++i)
+                if (block.Rgba[i][3] < 128)
+                    opaqueMask &= ~(1u << i);
+            if (opaqueMask == 0)
+            {
+                // Fully transparent (3 color mode, all index 3)
+                WriteLittleEndian( pDst, 0, 4 );
+                WriteLittleEndian( pDst + 4, 0xffffffffu, 4 );
+                return;
+            }
+        }
+        const bool threeColor = opaqueMask != 0xffff;
+
+        float endpoint0[3], endpoint1[3];
+        Bc1InitialEndpoints( block, opaqueMask, quality, endpoint0, endpoint1 );
+        Bc1Candidate best = EvaluateBc1( block, PackRgb565( endpoint0 ), PackRgb565( endpoint1 ), threeColor, opaqueMask );
+
+        // Refine the endpoints (given the current indices) until the error stops improving.
+        const int refinements = threeColor ? 0 : (quality == BlockCompressQuality::Best ? 4 : (quality == BlockCompressQuality::Normal ? 1 : 0));
+        for (int refinement = 0; refinement < refinements && best.Error > 0; ++refinement)
+        {
+            if (!Bc1FitEndpoints( block, best.Indices, endpoint0, endpoint1 ))
+                break;
+            const Bc1Candidate candidate = EvaluateBc1( block, PackRgb565( endpoint0 ), PackRgb565( endpoint1 ), false, opaqueMask );
+            if (candidate.Error >= best.Error)
+                break;
+            best = candidate;
+        }
+
+        uint32_t indexBits = 0;
+        for (uint32_t i = 0; i < 16; ++i)
+            indexBits |= uint32_t( best.Indices[i] ) << (2 * i);
+        WriteLittleEndian( pDst, best.Color0, 2 );
+        WriteLittleEndian( pDst + 2, best.Color1, 2 );
+        WriteLittleEndian( pDst + 4, indexBits, 4 );
+    }
+
+
+    //
+    // BC4 (also BC3 alpha and BC5)
+    //
+
+    /// Choose the best index for each value given the endpoints (mode is determined by endpoint order).
+    /// @return total squared error
+    uint32_t EvaluateBc4( const uint8_t values[16], int endpoint0, int endpoint1, uint8_t indices[16] )
+    {
+        int palette[8] = { endpoint0, endpoint1 };
+        if (endpoint0 > endpoint1)
+        {
+            for (int i = 1; i < 7; ++i)
+                palette[i + 1] = ((7 - i) * endpoint0 + i * endpoint1 + 3) / 7;
+        }
+        else
+        {
+            for (int i = 1; i < 5; ++i)
+                palette[i + 1] = ((5 - i) * endpoint0 + i * endpoint1 + 2) / 5;
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+        uint32_t error = 0;
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            int bestDistance = std::numeric_limits<int>::max();
+            for (uint8_t p = 0; p < 8; ++p)
+            {
+                const int distance = (palette[p] - values[i]) * (palette[p] - values[i]);
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    indices[i] = p;
+                }
+            }
+            error += uint32_t( bestDistance );
+        }
+        return error;
+    }
+
+    /// Encode an 8 byte BC4 block.
+    void EncodeBc4( const uint8_t values[16], uint8_t* pDst, BlockCompressQuality quality )
+    {
+        int minV = 255, maxV = 0;
+        int innerMin = 255, innerMax = 0;   // excluding 0 and 255 (which the 6 value mode has for free)
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            minV = std::min( minV, int( values[i] ) );
+            maxV = std::max( maxV, int( values[i] ) );
+            if (values[i] != 0 && values[i] != 255)
+            {
+                innerMin = std::min( innerMin, int( values[i] ) );
+                innerMax = std::max( innerMax, int( values[i] ) );
+            }
+        }
+
+        int bestEndpoint0 = maxV, bestEndpoint1 = minV;
+        uint8_t bestIndices[16];
+        uint32_t bestError = EvaluateBc4( values, maxV, minV, bestIndices );
+        auto tryEndpoints = [&]( int endpoint0, int endpoint1 ) {
+            uint8_t indices[16];
+            const uint32_t error = EvaluateBc4( values, endpoint0, endpoint1, indices );
+            if (error < bestError)
+            {
+                bestError = error;
+                bestEndpoint0 = endpoint0;
+                bestEndpoint1 = endpoint1;
+                memcpy( bestIndices, indices, sizeof( indices ) );
+            }
+        };
+
+        if (quality != BlockCompressQuality::Fastest && bestError > 0)
+        {
+            // 6 value mode (endpoint0 <= endpoint1) spends its interpolants on the values between the 0/255 extremes.
+            if (innerMin <= innerMax && (minV == 0 || maxV == 255))
+                tryEndpoints( innerMin, innerMax );
+        }
+        if (quality == BlockCompressQuality::Best && bestError > 0 && maxV - minV > 8)
+        {
+            // Pulling the endpoints in slightly usually lands the interpolants closer to the values.
+            for (int inset0 = 0; inset0 <= 3; ++inset0)
+                for (int inset1 = 0; inset1 <= 3; ++inset1)
+                    if (inset0 || inset1)
+                        tryEndpoints( maxV - inset0, minV + inset1 );
+        }
+
+        uint64_t indexBits = 0;
+        for (uint32_t i = 0; i < 16; ++i)
+            indexBits |= uint64_t( bestIndices[i] ) << (3 * i);
+        pDst[0] = uint8_t( bestEndpoint0 );
+        pDst[1] = uint8_t( bestEndpoint1 );
+        WriteLittleEndian( pDst + 2, indexBits, 6 );
+    }
+
+
+    //
+    // ETC2 RGB (individual and differential modes, which is everything ETC1 can express, decodable by any ETC2 decoder)
+    //
+
+    constexpr int cEtcModifiers[8][4] = {
+        { 2, 8, -2, -8 }, { 5, 17, -5, -17 }, { 9, 29, -9, -29 }, { 13, 42, -13, -42 },
+        { 18, 60, -18, -60 }, { 24, 80, -24, -80 }, { 33, 106, -33, -106 }, { 47, 183, -47, -183 }
+    };
+
+    /// Pixels (y*4+x) in each subblock, for flip 0 (2x4 side by side) and flip 1 (4x2 one above the other).
+    constexpr uint8_t cEtcSubblockPixels[2][2][8] = {
+        { { 0, 4, 8, 12, 1, 5, 9, 13 }, { 2, 6, 10, 14, 3, 7, 11, 15 } },
+        { { 0, 1, 2, 3, 4, 5, 6, 7 }, { 8, 9, 10, 11, 12, 13, 14, 15 } }
+    };
+
+    struct EtcSubblock
+    {
+        int      Base[3] = {};          ///< quantized (4 or 5 bit) base color
+        uint8_t  Table = 0;
+        uint8_t  Indices[8] = {};       ///< modifier index (in cEtcModifiers order) of each subblock pixel
+        uint32_t Error = std::numeric_limits<uint32_t>::max();
+    };
+
+    /// Find the best modifier table (and indices) for a subblock with the given quantized base color.
+    /// @param exact search every modifier for every pixel, otherwise pick the modifier closest to each pixel's (average channel) offset from the base, which only differs when channels clamp
+    EtcSubblock EvaluateEtcSubblock( const PixelBlock& block, const uint8_t pixels[8], const int base[3], uint32_t baseBits, bool exact )
+    {
+        EtcSubblock result;
+        int expanded[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            result.Base[c] = base[c];
+            expanded[c] = baseBits == 4 ? (base[c] << 4) | base[c] : (base[c] << 3) | (base[c] >> 2);
+        }
+        int offsets[8];
+        for (uint32_t p = 0; p < 8; ++p)
+        {
+            const uint8_t* pPixel = block.Rgba[pixels[p]];
+            offsets[p] = pPixel[0] + pPixel[1] + pPixel[2] - expanded[0] - expanded[1] - expanded[2];   // 3x the average offset
+        }
+
+        for (uint8_t table = 0; table < 8; ++table)
+        {
+            uint8_t indices[8];
+            uint32_t error = 0;
+            for (uint32_t p = 0; p < 8 && error < result.Error; ++p)
+            {
+                const uint8_t* pPixel = block.Rgba[pixels[p]];
+                uint8_t firstModifier = 0, lastModifier = 4;
+                if (!exact)
+                {
+                    // Modifiers are { a, b, -a, -b }, pick the sign then the closer magnitude.
+                    const int small = cEtcModifiers[table][0] * 3, large = cEtcModifiers[table][1] * 3;
+                    const int magnitude = std::abs( offsets[p] );
+                    firstModifier = uint8_t( (offsets[p] < 0 ? 2 : 0) + (std::abs( magnitude - large ) < std::abs( magnitude - small ) ? 1 : 0) );
+                    lastModifier = firstModifier + 1;
+                }
+                int bestDistance = std::numeric_limits<int>::max();
+                for (uint8_t m = firstModifier; m < lastModifier; ++m)
+                {
+                    const int modifier = cEtcModifiers[table][m];
+                    const int color[3] = { std::clamp( expanded[0] + modifier, 0, 255 ), std::clamp( expanded[1] + modifier, 0, 255 ), std::clamp( expanded[2] + modifier, 0, 255 ) };
+                    const int distance = ColorDistanceSq( color, pPixel );
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        indices[p] = m;
+                    }
+                }
+                error += uint32_t( bestDistance );
+            }
+            if (error < result.Error)
+            {
+                result.Error = error;
+                result.Table = table;
+                memcpy( result.Indices, indices, sizeof( indices ) );
+            }
+        }
+        return result;
+    }
+
+    /// Best subblock encoding with the base color starting at the pixel average.
+    /// Refinement re-fits the base color to the chosen modifiers (the average ignores them), Best also tries the neighbouring base colors.
+    /// @param baseConstraint if not null, base color channels must be within [-4,3] of this (differential mode delta range)
+    EtcSubblock EncodeEtcSubblock( const PixelBlock& block, const uint8_t pixels[8], uint32_t baseBits, BlockCompressQuality quality, const int* baseConstraint = nullptr )
+    {
+        const int maxBase = (1 << baseBits) - 1;
+        auto quantizeBase = [&]( const float sum[3], int base[3] ) {
+            for (int c = 0; c < 3; ++c)
+            {
+                base[c] = std::clamp( int( sum[c] * (1.0f / 8.0f) * float( maxBase ) / 255.0f + 0.5f ), 0, maxBase );
+                if (baseConstraint)
+                    base[c] = std::clamp( base[c], baseConstraint[c] - 4, baseConstraint[c] + 3 );
+            }
+        };
+        auto tryBase = [&]( const int base[3], EtcSubblock& best ) {
+            for (int c = 0; c < 3; ++c)
+            {
+                if (base[c] < 0 || base[c] > maxBase)
+                    return false;
+                if (baseConstraint && (base[c] < baseConstraint[c] - 4 || base[c] > baseConstraint[c] + 3))
+                    return false;
+            }
+            const EtcSubblock candidate = EvaluateEtcSubblock( block, pixels, base, baseBits, quality == BlockCompressQuality::Best );
+            if (candidate.Error >= best.Error)
+                return false;
+            best = candidate;
+            return true;
+        };
+
+        float sum[3] = {};
+        for (uint32_t p = 0; p < 8; ++p)
+            for (int c = 0; c < 3; ++c)
+                sum[c] += block.Rgba[pixels[p]][c];
+        int base[3];
+        quantizeBase( sum, base );
+        EtcSubblock best = EvaluateEtcSubblock( block, pixels, base, baseBits, quality == BlockCompressQuality::Best );
+
+        const int refinements = quality == BlockCompressQuality::Best ? 2 : (quality == BlockCompressQuality::Normal ? 1 : 0);
+        for (int refinement = 0; refinement < refinements && best.Error > 0; ++refinement)
+        {
+            float refit[3] = {};
+            for (uint32_t p = 0; p < 8; ++p)
+                for (int c = 0; c < 3; ++c)
+                    refit[c] += float( block.Rgba[pixels[p]][c] - cEtcModifiers[best.Table][best.Indices[p]] );
+            quantizeBase( refit, base );
+            if (!tryBase( base, best ))
+                break;
+        }
+
+        if (quality == BlockCompressQuality::Best && best.Error > 0)
+        {
+            static constexpr int cSteps[8][3] = { { 1, 1, 1 }, { -1, -1, -1 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+            const int center[3] = { best.Base[0], best.Base[1], best.Base[2] };
+            for (const auto& step : cSteps)
+            {
+                const int neighbour[3] = { center[0] + step[0], center[1] + step[1], center[2] + step[2] };
+                tryBase( neighbour, best );
+            }
+        }
+        return best;
+    }
+
+    /// Encode an 8 byte ETC2 RGB block.
+    void EncodeEtc2Rgb( const PixelBlock& block, uint8_t* pDst, BlockCompressQuality quality )
+    {
+        int flips[2] = { 0, 1 };
+        int numFlips = 2;
+        if (quality == BlockCompressQuality::Fastest)
+        {
+            // Only try the orientation whose halves differ the most.
+            float difference[2] = {};
+            for (int flip = 0; flip < 2; ++flip)
+                for (int c = 0; c < 3; ++c)
+                {
+                    int sum[2] = {};
+                    for (int s = 0; s < 2; ++s)
+                        for (uint32_t p = 0; p < 8; ++p)
+                            sum[s] += block.Rgba[cEtcSubblockPixels[flip][s][p]][c];
+                    difference[flip] += float( (sum[0] - sum[1]) * (sum[0] - sum[1]) );
+                }
+            flips[0] = difference[1] > difference[0] ? 1 : 0;
+            numFlips = 1;
+        }
+
+        uint32_t bestError = std::numeric_limits<uint32_t>::max();
+        EtcSubblock bestSubblocks[2];
+        bool bestDifferential = false;
+        int bestFlip = 0;
+        for (int f = 0; f < numFlips; ++f)
+        {
+            const int flip = flips[f];
+            const uint8_t* pixels0 = cEtcSubblockPixels[flip][0];
+            const uint8_t* pixels1 = cEtcSubblockPixels[flip][1];
+
+            // Differential: 555 base + 333 signed delta for the second subblock.
+            EtcSubblock differential0 = EncodeEtcSubblock( block, pixels0, 5, quality );
+            EtcSubblock differential1 = EncodeEtcSubblock( block, pixels1, 5, quality, differential0.Base );
+            if (differential0.Error + differential1.Error < bestError)
+            {
+                bestError = differential0.Error + differential1.Error;
+                bestSubblocks[0] = differential0;
+                bestSubblocks[1] = differential1;
+                bestDifferential = true;
+                bestFlip = flip;
+            }
+            if (bestError == 0)
+                break;
+
+            // Individual: two 444 bases (better when the subblocks are very different colors).
+            if (quality != BlockCompressQuality::Fastest || std::max( differential0.Error, differential1.Error ) > 8 * 8 * 3 * 8)
+            {
+                EtcSubblock individual0 = EncodeEtcSubblock( block, pixels0, 4, quality );
+                EtcSubblock individual1 = EncodeEtcSubblock( block, pixels1, 4, quality );
+                if (individual0.Error + individual1.Error < bestError)
+                {
+                    bestError = individual0.Error + individual1.Error;
+                    bestSubblocks[0] = individual0;
+                    bestSubblocks[1] = individual1;
+                    bestDifferential = false;
+                    bestFlip = flip;
+                }
+            }
+        }
+
+        const EtcSubblock& s0 = bestSubblocks[0];
+        const EtcSubblock& s1 = bestSubblocks[1];
+        uint32_t high;
+        if (bestDifferential)
+        {
+            high = (uint32_t( s0.Base[0] ) << 27) | (uint32_t( s1.Base[0] - s0.Base[0] ) & 7) << 24 |
+                   (uint32_t( s0.Base[1] ) << 19) | (uint32_t( s1.Base[1] - s0.Base[1] ) & 7) << 16 |
+                   (uint32_t( s0.Base[2] ) << 11) | (uint32_t( s1.Base[2] - s0.Base[2] ) & 7) << 8 | 2;
+        }
+        else
+        {
+            high = (uint32_t( s0.Base[0] ) << 28) | (uint32_t( s1.Base[0] ) << 24) |
+                   (uint32_t( s0.Base[1] ) << 20) | (uint32_t( s1.Base[1] ) << 16) |
+                   (uint32_t( s0.Base[2] ) << 12) | (uint32_t( s1.Base[2] ) << 8);
+        }
+        high |= (uint32_t( s0.Table ) << 5) | (uint32_t( s1.Table ) << 2) | uint32_t( bestFlip );
+
+        // Pixel indices are stored column major (x*4+y), msb plane in the top 16 bits.
+        uint32_t low = 0;
+        for (int s = 0; s < 2; ++s)
+            for (uint32_t p = 0; p < 8; ++p)
+            {
+                const uint32_t pixel = cEtcSubblockPixels[bestFlip][s][p];
+                const uint32_t bit = (pixel & 3) * 4 + (pixel >> 2);
+                const uint32_t index = bestSubblocks[s].Indices[p];
+                low |= ((index >> 1) << (16 + bit)) | ((index & 1) << bit);
+            }
+        WriteBigEndian( pDst, (uint64_t( high ) << 32) | low, 8 );
+    }
+
+
+    //
+    // EAC (ETC2 alpha, R11 and RG11)
+    //
+
+    constexpr int cEacModifiers[16][8] = {
+        { -3, -6, -9, -15, 2, 5, 8, 14 }, { -3, -7, -10, -13, 2, 6, 9, 12 }, { -2, -5, -8, -13, 1, 4, 7, 12 }, { -2, -4, -6, -13, 1, 3, 5, 12 },
+        { -3, -6, -8, -12, 2, 5, 7, 11 }, { -3, -7, -9, -11, 2, 6, 8, 10 }, { -4, -7, -8, -11, 3, 6, 7, 10 }, { -3, -5, -8, -11, 2, 4, 7, 10 },
+        { -2, -6, -8, -10, 1, 5, 7, 9 }, { -2, -5, -8, -10, 1, 4, 7, 9 }, { -2, -4, -8, -10, 1, 3, 7, 9 }, { -2, -5, -7, -10, 1, 4, 6, 9 },
+        { -3, -4, -7, -10, 2, 3, 6, 9 }, { -1, -2, -3, -10, 0, 1, 2, 9 }, { -4, -6, -8, -9, 3, 5, 7, 8 }, { -3, -5, -7, -9, 2, 4, 6, 8 }
+    };
+
+    /// Encode an 8 byte EAC block.
+    /// @param r11 encode for the 11bit (EAC R11/RG11) decode rather than the 8bit (ETC2 alpha) decode
+    void EncodeEac( const uint8_t values[16], uint8_t* pDst, bool r11, BlockCompressQuality quality )
+    {
+        // Work in the decoder's output precision.
+        const int scale = r11 ? 8 : 1;
+        const int offset = r11 ? 4 : 0;
+        const int maxOutput = r11 ? 2047 : 255;
+        int targets[16];
+        int minT = maxOutput, maxT = 0;
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            targets[i] = r11 ? (values[i] * 2047 + 127) / 255 : values[i];
+            minT = std::min( minT, targets[i] );
+            maxT = std::max( maxT, targets[i] );
+        }
+
+        uint32_t bestError = std::numeric_limits<uint32_t>::max();
+        int bestBase = 0, bestMultiplier = 1, bestTable = 0;
+        uint8_t bestIndices[16] = {};
+        auto tryBase = [&]( int table, int multiplier, int base, uint8_t indices[16] ) {
+            int palette[8];
+            for (int m = 0; m < 8; ++m)
+                palette[m] = std::clamp( base * scale + offset + cEacModifiers[table][m] * multiplier * scale, 0, maxOutput );
+            uint32_t error = 0;
+            for (uint32_t i = 0; i < 16 && error < bestError; ++i)
+            {
+                int bestDistance = std::numeric_limits<int>::max();
+                for (uint8_t m = 0; m < 8; ++m)
+                {
+                    const int distance = (palette[m] - targets[i]) * (palette[m] - targets[i]);
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        indices[i] = m;
+                    }
+                }
+                error += uint32_t( bestDistance );
+            }
+            if (error >= bestError)
+                return false;
+            bestError = error;
+            bestBase = base;
+            bestMultiplier = multiplier;
+            bestTable = table;
+            memcpy( bestIndices, indices, 16 );
+            return true;
+        };
+
+        // Every table, with the multiplier that spans the value range (Normal and Best also try neighbouring multipliers).
+        // The base starts by centering the table on the value range and is then refit to the chosen modifiers.
+        const int multiplierRadius = quality == BlockCompressQuality::Best ? 2 : (quality == BlockCompressQuality::Normal ? 1 : 0);
+        const int refinements = quality == BlockCompressQuality::Fastest ? 0 : 1;
+        for (int table = 0; table < 16 && bestError > 0; ++table)
+        {
+            const int* modifiers = cEacModifiers[table];
+            const int modifierMin = modifiers[3], modifierMax = modifiers[7];
+            const int centerMultiplier = std::clamp( int( float( maxT - minT ) / float( (modifierMax - modifierMin) * scale ) + 0.5f ), 1, 15 );
+            for (int multiplier = std::max( 1, centerMultiplier - multiplierRadius ); multiplier <= std::min( 15, centerMultiplier + multiplierRadius ); ++multiplier)
+            {
+                const float baseF = (float( minT + maxT ) * 0.5f - float( offset )) / float( scale ) - float( modifierMin + modifierMax ) * float( multiplier ) * 0.5f;
+                int base = std::clamp( int( std::floor( baseF + 0.5f ) ), 0, 255 );
+                uint8_t indices[16];
+                if (!tryBase( table, multiplier, base, indices ))
+                    continue;
+                for (int refinement = 0; refinement < refinements && bestError > 0; ++refinement)
+                {
+                    float sum = 0.0f;
+                    for (uint32_t i = 0; i < 16; ++i)
+                        sum += float( targets[i] - offset ) / float( scale ) - float( modifiers[indices[i]] * multiplier );
+                    const int refit = std::clamp( int( std::floor( sum * (1.0f / 16.0f) + 0.5f ) ), 0, 255 );
+                    if (refit == base || !tryBase( table, multiplier, refit, indices ))
+                        break;
+                    base = refit;
+                }
+            }
+        }
+
+        // Indices are stored column major (x*4+y), first pixel in the most significant bits.
+        uint64_t bits = (uint64_t( bestBase ) << 56) | (uint64_t( bestMultiplier ) << 52) | (uint64_t( bestTable ) << 48);
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            const uint32_t position = (i & 3) * 4 + (i >> 2);
+            bits |= uint64_t( bestIndices[i] ) << (45 - 3 * position);
+        }
+        WriteBigEndian( pDst, bits, 8 );
+    }
+
+
+    void EncodeBlock( BlockEncoding encoding, const PixelBlock& block, uint8_t* pDst, BlockCompressQuality quality )
+    {
+        uint8_t channel[16];
+        switch (encoding) {
+        case BlockEncoding::Bc1:
+            EncodeBc1( block, pDst, false, quality );
+            break;
+        case BlockEncoding::Bc1Alpha:
+            EncodeBc1( block, pDst, true, quality );
+            break;
+        case BlockEncoding::Bc3:
+            block.GetChannel( 3, channel );
+            EncodeBc4( channel, pDst, quality );
+            EncodeBc1( block, pDst + 8, false, quality );
+            break;
+        case BlockEncoding::Bc4:
+            block.GetChannel( 0, channel );
+            EncodeBc4( channel, pDst, quality );
+            break;
+        case BlockEncoding::Bc5:
+            block.GetChannel( 0, channel );
+            EncodeBc4( channel, pDst, quality );
+            block.GetChannel( 1, channel );
+            EncodeBc4( channel, pDst + 8, quality );
+            break;
+        case BlockEncoding::Etc2Rgb:
+            EncodeEtc2Rgb( block, pDst, quality );
+            break;
+        case BlockEncoding::Etc2Rgba:
+            block.GetChannel( 3, channel );
+            EncodeEac( channel, pDst, false, quality );
+            EncodeEtc2Rgb( block, pDst + 8, quality );
+            break;
+        case BlockEncoding::EacR11:
+            block.GetChannel( 0, channel );
+            EncodeEac( channel, pDst, true, quality );
+            break;
+        case BlockEncoding::EacRg11:
+            block.GetChannel( 0, channel );
+            EncodeEac( channel, pDst, true, quality );
+            block.GetChannel( 1, channel );
+            EncodeEac( channel, pDst + 8, true, quality );
+            break;
+        case BlockEncoding::None:
+            break;
+        }
+    }
+
+} // anonymous namespace
+
+
+bool CanBlockCompress( TextureFormat compressedFormat )
+{
+    return GetBlockEncoding( compressedFormat ) != BlockEncoding::None;
+}
+
+size_t BlockCompressedSize( TextureFormat compressedFormat, uint32_t width, uint32_t height )
+{
+    return BlockBytes( GetBlockEncoding( compressedFormat ) ) * ((width + 3) / 4) * ((height + 3) / 4);
+}
+
+bool BlockCompressImage( const void* pSrc, TextureFormat srcFormat, uint32_t width, uint32_t height, void* pDst, TextureFormat dstFormat, BlockCompressQuality quality, ThreadWorker* pWorker )
+{
+    const BlockEncoding encoding = GetBlockEncoding( dstFormat );
+    if (encoding == BlockEncoding::None || width == 0 || height == 0)
+        return false;
+
+    // Encoders work on 8bit RGBA.
+    const uint8_t* pRgba = static_cast<const uint8_t*>(pSrc);
+    std::vector<uint8_t> converted;
+    if (srcFormat != TextureFormat::R8G8B8A8_UNORM && srcFormat != TextureFormat::R8G8B8A8_SRGB)
+    {
+        converted = ConvertImage( pSrc, srcFormat, FormatIsSrgb( dstFormat ) ? TextureFormat::R8G8B8A8_SRGB : TextureFormat::R8G8B8A8_UNORM, width, height, pWorker );
+        if (converted.empty())
+            return false;
+        pRgba = converted.data();
+    }
+
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const size_t blockBytes = BlockBytes( encoding );
+    uint8_t* pDstBytes = static_cast<uint8_t*>(pDst);
+
+    auto compressRows = [&]( uint32_t rowBegin, uint32_t rowEnd ) {
+        PixelBlock block;
+        for (uint32_t blockY = rowBegin; blockY < rowEnd; ++blockY)
+        {
+            uint8_t* pDstBlock = pDstBytes + size_t( blockY ) * blocksX * blockBytes;
+            for (uint32_t blockX = 0; blockX < blocksX; ++blockX, pDstBlock += blockBytes)
+            {
+                LoadBlock( pRgba, width, height, blockX, blockY, block );
+                EncodeBlock( encoding, block, pDstBlock, quality );
+            }
+        }
+    };
+
+    if (pWorker)
+    {
+        // Each range wants a few hundred blocks to be worth handing to another thread.
+        pWorker->ParallelFor( blocksY, std::max( 1u, 256u / blocksX ), compressRows );
+    }
+    else
+    {
+        compressRows( 0, blocksY );
+    }
+    return true;
+}
+
+std::vector<uint8_t> BlockCompressImage( const void* pSrc, TextureFormat srcFormat, uint32_t width, uint32_t height, TextureFormat dstFormat, BlockCompressQuality quality, ThreadWorker* pWorker )
+{
+    std::vector<uint8_t> compressed( BlockCompressedSize( dstFormat, width, height ) );
+    if (compressed.empty() || !BlockCompressImage( pSrc, srcFormat, width, height, compressed.data(), dstFormat, quality, pWorker ))
+        return {};
+    return compressed;
+}
@@ -0,0 +1,48 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+///
+/// Cpu side block compression (for textures generated or loaded uncompressed at runtime).
+/// Supports the BC1/BC3/BC4/BC5 (desktop) and ETC2/EAC (mobile) formats that have straightforward endpoint/table encodings.
+/// Block data is laid out exactly as the graphics api expects (rows of 4x4 blocks, ready to upload).
+///
+
+#include "textureFormat.hpp"
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+class ThreadWorker;
+
+
+/// Speed vs quality trade off for BlockCompressImage.
+enum class BlockCompressQuality {
+    Fastest,    ///< bounding box endpoints / average colors, no refinement (for per-frame or very large images)
+    Normal,     ///< principal axis endpoints with a refinement pass, both ETC subblock orientations
+    Best        ///< multiple refinement passes and wider endpoint/base color searches (offline quality, up to 10x slower than Normal)
+};
+
+/// @return true if BlockCompressImage can output the given format.
+/// Supported: BC1 (RGB and RGBA), BC3, BC4_UNORM, BC5_UNORM, ETC2_R8G8B8, ETC2_R8G8B8A8, EAC_R11_UNORM, EAC_R11G11_UNORM (unorm and srgb variants where they exist).
+bool CanBlockCompress( TextureFormat compressedFormat );
+
+/// @return size (in bytes) of the block compressed data for an image of the given dimensions (0 if the format is not supported by BlockCompressImage).
+size_t BlockCompressedSize( TextureFormat compressedFormat, uint32_t width, uint32_t height );
+
+/// Block compress a (tightly packed) image.
+/// 8bit RGBA sources are compressed as-is (the destination format decides if the data is sampled as sRGB), any other source format
+/// supported by ConvertImage is first converted to 8bit RGBA (in the destination's color space).  Partial edge blocks are padded by clamping.
+/// @param pDst output buffer, must be at least BlockCompressedSize(dstFormat, width, height) bytes
+/// @param pWorker optional thread worker to split the compression (by rows of blocks) across (must not be called from one of its threads)
+/// @return false if either format is unsupported
+bool BlockCompressImage( const void* pSrc, TextureFormat srcFormat, uint32_t width, uint32_t height, void* pDst, TextureFormat dstFormat, BlockCompressQuality quality = BlockCompressQuality::Normal, ThreadWorker* pWorker = nullptr );
+
+/// Block compress a (tightly packed) image.
+/// @return block compressed data, empty on failure
+std::vector<uint8_t> BlockCompressImage( const void* pSrc, TextureFormat srcFormat, uint32_t width, uint32_t height, TextureFormat dstFormat, BlockCompressQuality quality = BlockCompressQuality::Normal, ThreadWorker* pWorker = nullptr );
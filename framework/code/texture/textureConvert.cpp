@@ -0,0 +1,880 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "textureConvert.hpp"
+#include "system/Worker.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define TEXTURECONVERT_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTURECONVERT_SSE2 1
+#endif
+
+
+//
+// 4 wide float vector (used by the mip filters)
+//
+namespace
+{
+#if defined(TEXTURECONVERT_NEON)
+    struct Vec4
+    {
+        float32x4_t v;
+        static Vec4 Zero() { return { vdupq_n_f32( 0.0f ) }; }
+        static Vec4 Load( const float* p ) { return { vld1q_f32( p ) }; }
+        void Store( float* p ) const { vst1q_f32( p, v ); }
+        Vec4 operator+( Vec4 o ) const { return { vaddq_f32( v, o.v ) }; }
+        Vec4 operator*( float s ) const { return { vmulq_n_f32( v, s ) }; }
+        Vec4 MulAdd( Vec4 a, float s ) const { return { vmlaq_n_f32( v, a.v, s ) }; }   ///< this + a * s
+    };
+#elif defined(TEXTURECONVERT_SSE2)
+    struct Vec4
+    {
+        __m128 v;
+        static Vec4 Zero() { return { _mm_setzero_ps() }; }
+        static Vec4 Load( const float* p ) { return { _mm_loadu_ps( p ) }; }
+        void Store( float* p ) const { _mm_storeu_ps( p, v ); }
+        Vec4 operator+( Vec4 o ) const { return { _mm_add_ps( v, o.v ) }; }
+        Vec4 operator*( float s ) const { return { _mm_mul_ps( v, _mm_set1_ps( s ) ) }; }
+        Vec4 MulAdd( Vec4 a, float s ) const { return { _mm_add_ps( v, _mm_mul_ps( a.v, _mm_set1_ps( s ) ) ) }; }
+    };
+#else
+    struct Vec4
+    {
+        float v[4];
+        static Vec4 Zero() { return { 0.0f, 0.0f, 0.0f, 0.0f }; }
+        static Vec4 Load( const float* p ) { return { p[0], p[1], p[2], p[3] }; }
+        void Store( float* p ) const { memcpy( p, v, sizeof( v ) ); }
+        Vec4 operator+( Vec4 o ) const { return { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] }; }
+        Vec4 operator*( float s ) const { return { v[0] * s, v[1] * s, v[2] * s, v[3] * s }; }
+        Vec4 MulAdd( Vec4 a, float s ) const { return { v[0] + a.v[0] * s, v[1] + a.v[1] * s, v[2] + a.v[2] * s, v[3] + a.v[3] * s }; }
+    };
+#endif
+}
+
+
+//
+// Single value conversions
+//
+
+float SrgbToLinear( float srgb )
+{
+    return srgb <= 0.04045f ? srgb * (1.0f / 12.92f) : std::pow( (srgb + 0.055f) * (1.0f / 1.055f), 2.4f );
+}
+
+float LinearToSrgb( float linear )
+{
+    return linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow( linear, 1.0f / 2.4f ) - 0.055f;
+}
+
+uint16_t FloatToHalf( float value )
+{
+    // Round to nearest even, handles denormals/inf/nan.
+    constexpr uint32_t f32infty = 255u << 23;
+    constexpr uint32_t f16max = (127u + 16u) << 23;
+    constexpr uint32_t denormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+    uint32_t u;
+    memcpy( &u, &value, sizeof( u ) );
+    const uint32_t sign = u & 0x80000000u;
+    u ^= sign;
+
+    uint32_t o;
+    if (u >= f16max)
+        o = (u > f32infty) ? 0x7e00u : 0x7c00u;     // NaN->qNaN and Inf->Inf
+    else if (u < (113u << 23))
+    {
+        // Resulting value is a subnormal or zero.  Use a magic value to align the mantissa bits (and have the fpu do the rounding).
+        float f, magic;
+        memcpy( &f, &u, sizeof( f ) );
+        memcpy( &magic, &denormMagic, sizeof( magic ) );
+        f += magic;
+        memcpy( &o, &f, sizeof( o ) );
+        o -= denormMagic;
+    }
+    else
+    {
+        const uint32_t mantOdd = (u >> 13) & 1u;
+        u += ((15u - 127u) << 23) + 0xfffu;     // rebias exponent and round
+        u += mantOdd;
+        o = u >> 13;
+    }
+    return uint16_t( o | (sign >> 16) );
+}
+
+float HalfToFloat( uint16_t value )
+{
+    constexpr uint32_t shiftedExp = 0x7c00u << 13;
+    uint32_t o = uint32_t( value & 0x7fffu ) << 13;
+    const uint32_t exp = shiftedExp & o;
+    o += (127u - 15u) << 23;                    // exponent adjust
+
+    float f;
+    if (exp == shiftedExp)
+    {
+        o += (128u - 16u) << 23;                // Inf/NaN: extra exponent adjust
+        memcpy( &f, &o, sizeof( f ) );
+    }
+    else if (exp == 0)
+    {
+        o += 1u << 23;                          // Zero/Denormal: renormalize
+        memcpy( &f, &o, sizeof( f ) );
+        f -= 6.10351562e-05f;                   // 2^-14
+    }
+    else
+        memcpy( &f, &o, sizeof( f ) );
+
+    uint32_t result;
+    memcpy( &result, &f, sizeof( result ) );
+    result |= uint32_t( value & 0x8000u ) << 16;
+    memcpy( &f, &result, sizeof( f ) );
+    return f;
+}
+
+
+//
+// sRGB lookup tables
+//
+namespace
+{
+    constexpr uint32_t cSrgbTableFirstExponent = 127 - 13;  // values smaller than 2^-13 always encode to sRGB 0
+    constexpr uint32_t cSrgbTableNumBuckets = 13 * 256;     // 256 buckets for each exponent from 2^-13 up to 1.0
+
+    struct SrgbTables
+    {
+        float ToLinear[256];        ///< sRGB byte to linear float
+        float UnormToFloat[256];    ///< unorm byte to float
+        /// Linear float to sRGB byte buckets, each packed in to one 32bit word (one load per value for the simd encode).
+        /// Encoded value at the start of the bucket in the top 16 bits, low 16 bits are the (bottom 15 bits of the) first float in the bucket that encodes to one more (0x8000 if none).
+        uint32_t FromLinear[cSrgbTableNumBuckets];
+
+        SrgbTables()
+        {
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                const double srgb = i / 255.0;
+                ToLinear[i] = float( srgb <= 0.04045 ? srgb / 12.92 : std::pow( (srgb + 0.055) / 1.055, 2.4 ) );
+                UnormToFloat[i] = float( srgb );
+            }
+
+            // Buckets are indexed by the float's exponent and top 8 mantissa bits.
+            // The encoded value changes by at most 1 across a bucket, so store the first float where that happens to give exact (correctly rounded) results.
+            // Found by binary search over the bucket's bit patterns (rounding the decoded midpoint to float can land one float either side of the true boundary).
+            auto encodeBits = []( uint32_t bits ) -> uint32_t {
+                float linearF;
+                memcpy( &linearF, &bits, sizeof( linearF ) );
+                const double linear = linearF;
+                return uint32_t( 255.0 * (linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow( linear, 1.0 / 2.4 ) - 0.055) + 0.5 );
+            };
+            for (uint32_t i = 0; i < cSrgbTableNumBuckets; ++i)
+            {
+                const uint32_t startBits = (cSrgbTableFirstExponent << 23) + (i << 15);
+                const uint32_t endBits = startBits + (1u << 15);
+                const uint32_t base = encodeBits( startBits );
+                uint32_t lo = startBits, hi = endBits;
+                while (lo < hi)
+                {
+                    const uint32_t mid = lo + (hi - lo) / 2;
+                    if (encodeBits( mid ) > base)
+                        hi = mid;
+                    else
+                        lo = mid + 1;
+                }
+                FromLinear[i] = (base << 16) | (lo - startBits);
+                assert( encodeBits( endBits - 1 ) <= base + 1 );
+            }
+        }
+
+        uint8_t Encode( float linear ) const
+        {
+            constexpr uint32_t cMinBits = cSrgbTableFirstExponent << 23;
+            uint32_t bits;
+            memcpy( &bits, &linear, sizeof( bits ) );
+            if (bits < cMinBits || bits >= 0x80000000u)
+                return 0;                                   // tiny or negative
+            if (bits >= (127u << 23))
+                return bits > 0x7f800000u ? 0 : 255;        // >= 1.0 (or NaN)
+            const uint32_t bucket = FromLinear[(bits - cMinBits) >> 15];
+            return uint8_t( (bucket >> 16) + ((bits & 0x7fffu) >= (bucket & 0xffffu) ? 1 : 0) );
+        }
+    };
+
+    const SrgbTables& GetSrgbTables()
+    {
+        static const SrgbTables sTables;
+        return sTables;
+    }
+}
+
+
+//
+// Row conversions
+//
+
+void ConvertRGB8ToRGBA8( const uint8_t* pSrc, uint8_t* pDst, size_t numPixels, uint8_t alpha )
+{
+    size_t i = 0;
+#if defined(TEXTURECONVERT_NEON)
+    const uint8x16_t alphas = vdupq_n_u8( alpha );
+    for (; i + 16 <= numPixels; i += 16)
+    {
+        const uint8x16x3_t rgb = vld3q_u8( pSrc + i * 3 );
+        const uint8x16x4_t rgba = { rgb.val[0], rgb.val[1], rgb.val[2], alphas };
+        vst4q_u8( pDst + i * 4, rgba );
+    }
+#endif
+    // 4 pixels (3 32bit words in, 4 out) at a time.  Assumes little endian (as are all our targets).
+    const uint32_t alphaBits = uint32_t( alpha ) << 24;
+    for (; i + 4 <= numPixels; i += 4)
+    {
+        uint32_t in[3];
+        memcpy( in, pSrc + i * 3, sizeof( in ) );
+        const uint32_t out[4] = {
+            (in[0] & 0xffffffu) | alphaBits,
+            (in[0] >> 24) | ((in[1] & 0xffffu) << 8) | alphaBits,
+            (in[1] >> 16) | ((in[2] & 0xffu) << 16) | alphaBits,
+            (in[2] >> 8) | alphaBits };
+        memcpy( pDst + i * 4, out, sizeof( out ) );
+    }
+    for (; i < numPixels; ++i)
+    {
+        pDst[i * 4 + 0] = pSrc[i * 3 + 0];
+        pDst[i * 4 + 1] = pSrc[i * 3 + 1];
+        pDst[i * 4 + 2] = pSrc[i * 3 + 2];
+        pDst[i * 4 + 3] = alpha;
+    }
+}
+
+void SwizzleRGBA8ToBGRA8( const uint8_t* pSrc, uint8_t* pDst, size_t numPixels )
+{
+    size_t i = 0;
+#if defined(TEXTURECONVERT_NEON)
+    for (; i + 16 <= numPixels; i += 16)
+    {
+        uint8x16x4_t rgba = vld4q_u8( pSrc + i * 4 );
+        std::swap( rgba.val[0], rgba.val[2] );
+        vst4q_u8( pDst + i * 4, rgba );
+    }
+#elif defined(TEXTURECONVERT_SSE2)
+    const __m128i maskAG = _mm_set1_epi32( int( 0xff00ff00u ) );
+    const __m128i maskRB = _mm_set1_epi32( 0x00ff00ff );
+    for (; i + 4 <= numPixels; i += 4)
+    {
+        const __m128i v = _mm_loadu_si128( (const __m128i*) (pSrc + i * 4) );
+        const __m128i ag = _mm_and_si128( v, maskAG );
+        const __m128i rb = _mm_and_si128( v, maskRB );
+        const __m128i br = _mm_or_si128( _mm_slli_epi32( rb, 16 ), _mm_srli_epi32( rb, 16 ) );
+        _mm_storeu_si128( (__m128i*) (pDst + i * 4), _mm_or_si128( ag, br ) );
+    }
+#endif
+    for (; i < numPixels; ++i)
+    {
+        uint32_t v;
+        memcpy( &v, pSrc + i * 4, sizeof( v ) );
+        v = (v & 0xff00ff00u) | ((v & 0xffu) << 16) | ((v >> 16) & 0xffu);
+        memcpy( pDst + i * 4, &v, sizeof( v ) );
+    }
+}
+
+void ConvertSrgb8ToLinear( const uint8_t* pSrc, float* pDst, size_t numValues )
+{
+    const auto& toLinear = GetSrgbTables().ToLinear;
+    for (size_t i = 0; i < numValues; ++i)
+        pDst[i] = toLinear[pSrc[i]];
+}
+
+void ConvertLinearToSrgb8( const float* pSrc, uint8_t* pDst, size_t numValues )
+{
+    // Simd versions of SrgbTables::Encode.  Range checks, bucket index and threshold compare are vectorized, the bucket lookups are 4 scalar loads (no gather in NEON/SSE2).
+    const auto& tables = GetSrgbTables();
+    size_t i = 0;
+#if defined(TEXTURECONVERT_NEON)
+    const uint32x4_t minBits = vdupq_n_u32( cSrgbTableFirstExponent << 23 );
+    const uint32x4_t oneBits = vdupq_n_u32( 127u << 23 );
+    const uint32x4_t infBits = vdupq_n_u32( 0x7f800000u );
+    const uint32x4_t signBit = vdupq_n_u32( 0x80000000u );
+    for (; i + 4 <= numValues; i += 4)
+    {
+        const uint32x4_t bits = vreinterpretq_u32_f32( vld1q_f32( pSrc + i ) );
+        const uint32x4_t isZero = vorrq_u32( vcltq_u32( bits, minBits ), vcgtq_u32( bits, infBits ) );  // tiny, negative or nan
+        const uint32x4_t isOne = vbicq_u32( vcgeq_u32( bits, oneBits ), isZero );                       // >= 1.0
+        const uint32x4_t inTable = vmvnq_u32( vorrq_u32( isZero, isOne ) );
+        const uint32x4_t index = vandq_u32( vshrq_n_u32( vsubq_u32( bits, minBits ), 15 ), inTable );
+        const uint32_t bucketValues[4] = { tables.FromLinear[vgetq_lane_u32( index, 0 )], tables.FromLinear[vgetq_lane_u32( index, 1 )], tables.FromLinear[vgetq_lane_u32( index, 2 )], tables.FromLinear[vgetq_lane_u32( index, 3 )] };
+        const uint32x4_t bucket = vld1q_u32( bucketValues );
+        // Compare mask is all ones (-1) when the value reaches the threshold, so subtract it to add 1.
+        uint32x4_t encoded = vsubq_u32( vshrq_n_u32( bucket, 16 ), vcgeq_u32( vandq_u32( bits, vdupq_n_u32( 0x7fffu ) ), vandq_u32( bucket, vdupq_n_u32( 0xffffu ) ) ) );
+        encoded = vorrq_u32( vandq_u32( encoded, inTable ), vandq_u32( isOne, vdupq_n_u32( 255 ) ) );
+        const uint8x8_t packed = vmovn_u16( vcombine_u16( vmovn_u32( encoded ), vdup_n_u16( 0 ) ) );
+        vst1_lane_u32( (uint32_t*) (pDst + i), vreinterpret_u32_u8( packed ), 0 );
+    }
+#elif defined(TEXTURECONVERT_SSE2)
+    // Float bit patterns compared as signed integers, so negative values (sign bit set) are all less than minBits.
+    const __m128i minBits = _mm_set1_epi32( int( cSrgbTableFirstExponent << 23 ) );
+    const __m128i oneBitsMinus1 = _mm_set1_epi32( int( (127u << 23) - 1 ) );
+    const __m128i infBits = _mm_set1_epi32( 0x7f800000 );
+    const __m128i low15Bits = _mm_set1_epi32( 0x7fff );
+    const __m128i low16Bits = _mm_set1_epi32( 0xffff );
+    const __m128i all255 = _mm_set1_epi32( 255 );
+    for (; i + 4 <= numValues; i += 4)
+    {
+        const __m128i bits = _mm_castps_si128( _mm_loadu_ps( pSrc + i ) );
+        const __m128i isZero = _mm_or_si128( _mm_cmplt_epi32( bits, minBits ), _mm_cmpgt_epi32( bits, infBits ) );     // tiny, negative or nan
+        const __m128i isOne = _mm_andnot_si128( isZero, _mm_cmpgt_epi32( bits, oneBitsMinus1 ) );                      // >= 1.0
+        const __m128i inTable = _mm_andnot_si128( _mm_or_si128( isZero, isOne ), _mm_set1_epi32( -1 ) );
+        const __m128i index = _mm_and_si128( _mm_srli_epi32( _mm_sub_epi32( bits, minBits ), 15 ), inTable );
+        // Bucket indices are less than 2^16, so can be extracted as 16 bit values.
+        const __m128i bucket = _mm_setr_epi32( int( tables.FromLinear[_mm_extract_epi16( index, 0 )] ), int( tables.FromLinear[_mm_extract_epi16( index, 2 )] ), int( tables.FromLinear[_mm_extract_epi16( index, 4 )] ), int( tables.FromLinear[_mm_extract_epi16( index, 6 )] ) );
+        // Compare mask is all ones (-1) when the value is below the threshold, add 1 where it is not.
+        const __m128i belowThreshold = _mm_cmplt_epi32( _mm_and_si128( bits, low15Bits ), _mm_and_si128( bucket, low16Bits ) );
+        __m128i encoded = _mm_add_epi32( _mm_srli_epi32( bucket, 16 ), _mm_andnot_si128( belowThreshold, _mm_set1_epi32( 1 ) ) );
+        encoded = _mm_or_si128( _mm_and_si128( encoded, inTable ), _mm_and_si128( isOne, all255 ) );
+        const __m128i packed = _mm_packus_epi16( _mm_packs_epi32( encoded, encoded ), encoded );
+        const int32_t packed4 = _mm_cvtsi128_si32( packed );
+        memcpy( pDst + i, &packed4, sizeof( packed4 ) );
+    }
+#endif
+    for (; i < numValues; ++i)
+        pDst[i] = tables.Encode( pSrc[i] );
+}
+
+void ConvertFloatToHalf( const float* pSrc, uint16_t* pDst, size_t numValues )
+{
+    size_t i = 0;
+#if defined(TEXTURECONVERT_NEON) && defined(__aarch64__)
+    for (; i + 4 <= numValues; i += 4)
+        vst1_u16( pDst + i, vreinterpret_u16_f16( vcvt_f16_f32( vld1q_f32( pSrc + i ) ) ) );
+#elif defined(TEXTURECONVERT_SSE2)
+    // SSE2 version of FloatToHalf (same rounding and special case handling).
+    const __m128i maskSign = _mm_set1_epi32( int( 0x80000000u ) );
+    const __m128i f16max = _mm_set1_epi32( (127 + 16) << 23 );
+    const __m128i nanBit = _mm_set1_epi32( 0x200 );
+    const __m128i inftyAsFp16 = _mm_set1_epi32( 0x7c00 );
+    const __m128i minNormal = _mm_set1_epi32( (127 - 14) << 23 );
+    const __m128i subnormMagic = _mm_set1_epi32( ((127 - 15) + (23 - 10) + 1) << 23 );
+    const __m128i normalBias = _mm_set1_epi32( 0xfff - ((127 - 15) << 23) );
+    for (; i + 8 <= numValues; i += 8)
+    {
+        __m128i halves[2];
+        for (int j = 0; j < 2; ++j)
+        {
+            const __m128 f = _mm_loadu_ps( pSrc + i + j * 4 );
+            const __m128i fi = _mm_castps_si128( f );
+            const __m128i justSign = _mm_and_si128( fi, maskSign );
+            const __m128i absInt = _mm_xor_si128( fi, justSign );
+            const __m128 absF = _mm_castsi128_ps( absInt );
+
+            const __m128i isNan = _mm_castps_si128( _mm_cmpunord_ps( absF, absF ) );
+            const __m128i isRegular = _mm_cmpgt_epi32( f16max, absInt );
+            const __m128i infOrNan = _mm_or_si128( _mm_and_si128( isNan, nanBit ), inftyAsFp16 );
+
+            const __m128i isSubnormal = _mm_cmpgt_epi32( minNormal, absInt );
+            const __m128i subnormal = _mm_sub_epi32( _mm_castps_si128( _mm_add_ps( absF, _mm_castsi128_ps( subnormMagic ) ) ), subnormMagic );
+
+            const __m128i mantOdd = _mm_srai_epi32( _mm_slli_epi32( absInt, 31 - 13 ), 31 );    // -1 if odd
+            const __m128i normal = _mm_srli_epi32( _mm_sub_epi32( _mm_add_epi32( absInt, normalBias ), mantOdd ), 13 );
+
+            const __m128i nonSpecial = _mm_or_si128( _mm_and_si128( isSubnormal, subnormal ), _mm_andnot_si128( isSubnormal, normal ) );
+            const __m128i joined = _mm_or_si128( _mm_and_si128( isRegular, nonSpecial ), _mm_andnot_si128( isRegular, infOrNan ) );
+            const __m128i result = _mm_or_si128( joined, _mm_srai_epi32( justSign, 16 ) );
+            // Sign extend from 16 bits so the signed saturating pack below does not clamp.
+            halves[j] = _mm_srai_epi32( _mm_slli_epi32( result, 16 ), 16 );
+        }
+        _mm_storeu_si128( (__m128i*) (pDst + i), _mm_packs_epi32( halves[0], halves[1] ) );
+    }
+#endif
+    for (; i < numValues; ++i)
+        pDst[i] = FloatToHalf( pSrc[i] );
+}
+
+void ConvertHalfToFloat( const uint16_t* pSrc, float* pDst, size_t numValues )
+{
+    size_t i = 0;
+#if defined(TEXTURECONVERT_NEON) && defined(__aarch64__)
+    for (; i + 4 <= numValues; i += 4)
+        vst1q_f32( pDst + i, vcvt_f32_f16( vreinterpret_f16_u16( vld1_u16( pSrc + i ) ) ) );
+#elif defined(TEXTURECONVERT_SSE2)
+    const __m128i maskNoSign = _mm_set1_epi32( 0x7fff );
+    const __m128 magic = _mm_castsi128_ps( _mm_set1_epi32( (254 - 15) << 23 ) );
+    const __m128i wasInfNan = _mm_set1_epi32( 0x7bff );
+    const __m128i expInfNan = _mm_set1_epi32( 255 << 23 );
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= numValues; i += 8)
+    {
+        const __m128i h8 = _mm_loadu_si128( (const __m128i*) (pSrc + i) );
+        const __m128i h4[2] = { _mm_unpacklo_epi16( h8, zero ), _mm_unpackhi_epi16( h8, zero ) };
+        for (int j = 0; j < 2; ++j)
+        {
+            const __m128i expMant = _mm_and_si128( maskNoSign, h4[j] );
+            const __m128i justSign = _mm_xor_si128( h4[j], expMant );
+            const __m128 scaled = _mm_mul_ps( _mm_castsi128_ps( _mm_slli_epi32( expMant, 13 ) ), magic );
+            const __m128i isInfNan = _mm_cmpgt_epi32( expMant, wasInfNan );
+            const __m128i signInf = _mm_or_si128( _mm_slli_epi32( justSign, 16 ), _mm_and_si128( isInfNan, expInfNan ) );
+            _mm_storeu_ps( pDst + i + j * 4, _mm_or_ps( scaled, _mm_castsi128_ps( signInf ) ) );
+        }
+    }
+#endif
+    for (; i < numValues; ++i)
+        pDst[i] = HalfToFloat( pSrc[i] );
+}
+
+/// Convert a float to an unsigned float with a 5 bit exponent and mantissaBits bits of mantissa (round to nearest even, rounded once from the float).
+/// Negative values clamp to zero and finite values too large for the format clamp to the largest finite value (infinity and nan are kept).
+static uint32_t FloatToUfloat( float value, uint32_t mantissaBits )
+{
+    const uint32_t infinity = 0x1fu << mantissaBits;
+    uint32_t bits;
+    memcpy( &bits, &value, sizeof( bits ) );
+    if ((bits & 0x7fffffffu) > 0x7f800000u)
+        return infinity | ((1u << mantissaBits) - 1);       // nan
+    if (bits & 0x80000000u)
+        return 0;                                           // negative (clamps to zero)
+    if (bits == 0x7f800000u)
+        return infinity;
+
+    const int32_t exponent = int32_t( bits >> 23 ) - 127 + 15;
+    uint32_t shift = 23 - mantissaBits;
+    if (exponent >= 1)
+        bits -= (127u - 15u) << 23;                         // normal, rebias the exponent in place
+    else
+    {
+        shift += uint32_t( 1 - exponent );                  // subnormal, shift the mantissa (with its implicit 1) down
+        if (shift > 24)
+            return 0;
+        bits = (bits & 0x7fffffu) | 0x800000u;
+    }
+    const uint32_t rounded = (bits + (1u << (shift - 1)) - 1 + ((bits >> shift) & 1u)) >> shift;
+    return std::min( rounded, infinity - 1 );               // rounding up (or too large) clamps to the largest finite value
+}
+
+void PackR11G11B10( const float* pSrc, size_t srcStride, uint32_t* pDst, size_t numPixels )
+{
+    for (size_t i = 0; i < numPixels; ++i, pSrc += srcStride)
+        pDst[i] = FloatToUfloat( pSrc[0], 6 ) | (FloatToUfloat( pSrc[1], 6 ) << 11) | (FloatToUfloat( pSrc[2], 5 ) << 22);
+}
+
+void UnpackR11G11B10( const uint32_t* pSrc, float* pDst, size_t dstStride, size_t numPixels )
+{
+    constexpr size_t cBatch = 64;
+    uint16_t halves[cBatch * 3];
+    float rgb[cBatch * 3];
+    for (size_t i = 0; i < numPixels; i += cBatch)
+    {
+        const size_t count = std::min( cBatch, numPixels - i );
+        for (size_t p = 0; p < count; ++p)
+        {
+            const uint32_t packed = pSrc[i + p];
+            halves[p * 3 + 0] = uint16_t( (packed & 0x7ffu) << 4 );
+            halves[p * 3 + 1] = uint16_t( ((packed >> 11) & 0x7ffu) << 4 );
+            halves[p * 3 + 2] = uint16_t( ((packed >> 22) & 0x3ffu) << 5 );
+        }
+        ConvertHalfToFloat( halves, rgb, count * 3 );
+        for (size_t p = 0; p < count; ++p)
+            memcpy( pDst + (i + p) * dstStride, &rgb[p * 3], sizeof( float ) * 3 );
+    }
+}
+
+
+//
+// Image level conversion
+//
+namespace
+{
+    enum class ChannelType { Unorm8, Srgb8, Half, Float, Ufloat111110 };
+
+    struct FormatLayout
+    {
+        ChannelType Type;
+        uint32_t    NumChannels;
+        bool        Bgr;            ///< red and blue swapped
+        uint32_t    BytesPerPixel;
+    };
+
+    bool GetFormatLayout( TextureFormat format, FormatLayout& layout )
+    {
+        switch (format) {
+        case TextureFormat::R8_UNORM:               layout = { ChannelType::Unorm8, 1, false, 1 }; return true;
+        case TextureFormat::R8_SRGB:                layout = { ChannelType::Srgb8, 1, false, 1 }; return true;
+        case TextureFormat::R8G8_UNORM:             layout = { ChannelType::Unorm8, 2, false, 2 }; return true;
+        case TextureFormat::R8G8_SRGB:              layout = { ChannelType::Srgb8, 2, false, 2 }; return true;
+        case TextureFormat::R8G8B8_UNORM:           layout = { ChannelType::Unorm8, 3, false, 3 }; return true;
+        case TextureFormat::R8G8B8_SRGB:            layout = { ChannelType::Srgb8, 3, false, 3 }; return true;
+        case TextureFormat::B8G8R8_UNORM:           layout = { ChannelType::Unorm8, 3, true, 3 }; return true;
+        case TextureFormat::B8G8R8_SRGB:            layout = { ChannelType::Srgb8, 3, true, 3 }; return true;
+        case TextureFormat::R8G8B8A8_UNORM:         layout = { ChannelType::Unorm8, 4, false, 4 }; return true;
+        case TextureFormat::R8G8B8A8_SRGB:          layout = { ChannelType::Srgb8, 4, false, 4 }; return true;
+        case TextureFormat::B8G8R8A8_UNORM:         layout = { ChannelType::Unorm8, 4, true, 4 }; return true;
+        case TextureFormat::B8G8R8A8_SRGB:          layout = { ChannelType::Srgb8, 4, true, 4 }; return true;
+        case TextureFormat::R16_SFLOAT:             layout = { ChannelType::Half, 1, false, 2 }; return true;
+        case TextureFormat::R16G16_SFLOAT:          layout = { ChannelType::Half, 2, false, 4 }; return true;
+        case TextureFormat::R16G16B16_SFLOAT:       layout = { ChannelType::Half, 3, false, 6 }; return true;
+        case TextureFormat::R16G16B16A16_SFLOAT:    layout = { ChannelType::Half, 4, false, 8 }; return true;
+        case TextureFormat::R32_SFLOAT:             layout = { ChannelType::Float, 1, false, 4 }; return true;
+        case TextureFormat::R32G32_SFLOAT:          layout = { ChannelType::Float, 2, false, 8 }; return true;
+        case TextureFormat::R32G32B32_SFLOAT:       layout = { ChannelType::Float, 3, false, 12 }; return true;
+        case TextureFormat::R32G32B32A32_SFLOAT:    layout = { ChannelType::Float, 4, false, 16 }; return true;
+        case TextureFormat::B10G11R11_UFLOAT_PACK32:layout = { ChannelType::Ufloat111110, 3, false, 4 }; return true;
+        default:
+            return false;
+        }
+    }
+
+    /// Decode a row of pixels to linear RGBA floats.
+    void DecodeRow( const uint8_t* pSrc, const FormatLayout& layout, float* pDst, size_t width, std::vector<float>& scratch )
+    {
+        const uint32_t numChannels = layout.NumChannels;
+        switch (layout.Type) {
+        case ChannelType::Unorm8:
+        case ChannelType::Srgb8:
+        {
+            const auto& tables = GetSrgbTables();
+            const float* colorTable = layout.Type == ChannelType::Srgb8 ? tables.ToLinear : tables.UnormToFloat;
+            for (size_t x = 0; x < width; ++x, pSrc += numChannels, pDst += 4)
+            {
+                pDst[0] = colorTable[pSrc[0]];
+                pDst[1] = numChannels > 1 ? colorTable[pSrc[1]] : 0.0f;
+                pDst[2] = numChannels > 2 ? colorTable[pSrc[2]] : 0.0f;
+                pDst[3] = numChannels > 3 ? tables.UnormToFloat[pSrc[3]] : 1.0f;   // alpha is always linear
+                if (layout.Bgr)
+                    std::swap( pDst[0], pDst[2] );
+            }
+            break;
+        }
+        case ChannelType::Half:
+        case ChannelType::Float:
+        {
+            const float* pFloats = (const float*) pSrc;
+            if (layout.Type == ChannelType::Half)
+            {
+                scratch.resize( width * numChannels );
+                ConvertHalfToFloat( (const uint16_t*) pSrc, scratch.data(), width * numChannels );
+                pFloats = scratch.data();
+            }
+            if (numChannels == 4)
+            {
+                memcpy( pDst, pFloats, width * 4 * sizeof( float ) );
+                break;
+            }
+            for (size_t x = 0; x < width; ++x, pFloats += numChannels, pDst += 4)
+            {
+                float pixel[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+                memcpy( pixel, pFloats, numChannels * sizeof( float ) );
+                memcpy( pDst, pixel, sizeof( pixel ) );
+            }
+            break;
+        }
+        case ChannelType::Ufloat111110:
+            UnpackR11G11B10( (const uint32_t*) pSrc, pDst, 4, width );
+            for (size_t x = 0; x < width; ++x)
+                pDst[x * 4 + 3] = 1.0f;
+            break;
+        }
+    }
+
+    /// Encode a row of linear RGBA floats to the given format.
+    void EncodeRow( const float* pSrc, const FormatLayout& layout, uint8_t* pDst, size_t width, std::vector<float>& scratch )
+    {
+        const uint32_t numChannels = layout.NumChannels;
+        const uint32_t swap = layout.Bgr ? 2 : 0;   // xor with channel index 0/2 to swap red and blue
+        switch (layout.Type) {
+        case ChannelType::Unorm8:
+        case ChannelType::Srgb8:
+        {
+            const auto& tables = GetSrgbTables();
+            const bool srgb = layout.Type == ChannelType::Srgb8;
+            for (size_t x = 0; x < width; ++x, pSrc += 4, pDst += numChannels)
+            {
+                for (uint32_t c = 0; c < numChannels; ++c)
+                {
+                    const float v = pSrc[c < 3 ? (c ^ swap) : c];
+                    if (srgb && c < 3)
+                        pDst[c] = tables.Encode( v );
+                    else
+                        pDst[c] = uint8_t( std::clamp( v, 0.0f, 1.0f ) * 255.0f + 0.5f );
+                }
+            }
+            break;
+        }
+        case ChannelType::Half:
+        case ChannelType::Float:
+        {
+            const float* pFloats = pSrc;
+            if (numChannels != 4)
+            {
+                scratch.resize( width * numChannels );
+                for (size_t x = 0; x < width; ++x)
+                    memcpy( &scratch[x * numChannels], pSrc + x * 4, numChannels * sizeof( float ) );
+                pFloats = scratch.data();
+            }
+            if (layout.Type == ChannelType::Half)
+                ConvertFloatToHalf( pFloats, (uint16_t*) pDst, width * numChannels );
+            else
+                memcpy( pDst, pFloats, width * numChannels * sizeof( float ) );
+            break;
+        }
+        case ChannelType::Ufloat111110:
+            PackR11G11B10( pSrc, 4, (uint32_t*) pDst, width );
+            break;
+        }
+    }
+
+    /// Run fn(rowBegin, rowEnd) over all the rows, split across the thread worker's threads (if given and worthwhile).
+    /// Must not be called from one of pWorker's threads.
+    template<typename T_FN>
+    void ForEachRowRange( uint32_t numRows, size_t bytesPerRow, ThreadWorker* pWorker, const T_FN& fn )
+    {
+        if (!pWorker)
+        {
+            fn( 0u, numRows );
+            return;
+        }
+        // Not worth the threading overhead for less than 64k of output per range.
+        const uint32_t minRows = uint32_t( std::max<size_t>( 1, (64 * 1024) / std::max<size_t>( bytesPerRow, 1 ) ) );
+        pWorker->ParallelFor( numRows, minRows, fn );
+    }
+
+    /// Kaiser windowed sinc weights for a 2:1 downsample.  Taps are at source pixels 2x-3 .. 2x+4 for destination pixel x.
+    struct KaiserWeights
+    {
+        static constexpr int cNumTaps = 8;
+        float Weights[cNumTaps];
+        KaiserWeights()
+        {
+            constexpr double alpha = 4.0;
+            constexpr double width = 2.0;   // window half width (in destination pixels)
+            auto besselI0 = []( double x ) {
+                double sum = 1.0, term = 1.0;
+                for (int k = 1; k < 32; ++k)
+                {
+                    term *= (x * 0.5 / k) * (x * 0.5 / k);
+                    sum += term;
+                }
+                return sum;
+            };
+            double total = 0.0;
+            double weights[cNumTaps];
+            for (int k = 0; k < cNumTaps; ++k)
+            {
+                const double x = (k - 3.5) * 0.5;   // distance from the destination pixel center (in destination pixels)
+                const double sinc = std::sin( 3.14159265358979 * x ) / (3.14159265358979 * x);
+                const double r = x / width;
+                const double window = besselI0( alpha * std::sqrt( std::max( 0.0, 1.0 - r * r ) ) ) / besselI0( alpha );
+                weights[k] = sinc * window;
+                total += weights[k];
+            }
+            for (int k = 0; k < cNumTaps; ++k)
+                Weights[k] = float( weights[k] / total );
+        }
+    };
+}
+
+bool CanConvertFormat( TextureFormat format )
+{
+    FormatLayout layout;
+    return GetFormatLayout( format, layout );
+}
+
+bool ConvertImage( const void* pSrc, TextureFormat srcFormat, void* pDst, TextureFormat dstFormat, uint32_t width, uint32_t height, ThreadWorker* pWorker )
+{
+    FormatLayout srcLayout, dstLayout;
+    if (!GetFormatLayout( srcFormat, srcLayout ) || !GetFormatLayout( dstFormat, dstLayout ))
+        return false;
+
+    const uint8_t* pSrcBytes = (const uint8_t*) pSrc;
+    uint8_t* pDstBytes = (uint8_t*) pDst;
+    const size_t srcPitch = size_t( width ) * srcLayout.BytesPerPixel;
+    const size_t dstPitch = size_t( width ) * dstLayout.BytesPerPixel;
+
+    if (srcFormat == dstFormat)
+    {
+        memcpy( pDst, pSrc, srcPitch * height );
+        return true;
+    }
+
+    // Fast paths (no conversion to/from linear float)
+    const bool sameType = srcLayout.Type == dstLayout.Type;
+    const bool bytes = sameType && (srcLayout.Type == ChannelType::Unorm8 || srcLayout.Type == ChannelType::Srgb8);
+    if (bytes && srcLayout.NumChannels == 3 && dstLayout.NumChannels == 4)
+    {
+        ForEachRowRange( height, dstPitch, pWorker, [&]( uint32_t rowBegin, uint32_t rowEnd ) {
+            for (uint32_t y = rowBegin; y < rowEnd; ++y)
+            {
+                ConvertRGB8ToRGBA8( pSrcBytes + y * srcPitch, pDstBytes + y * dstPitch, width );
+                if (srcLayout.Bgr != dstLayout.Bgr)
+                    SwizzleRGBA8ToBGRA8( pDstBytes + y * dstPitch, pDstBytes + y * dstPitch, width );
+            }
+        } );
+        return true;
+    }
+    if (bytes && srcLayout.NumChannels == 4 && dstLayout.NumChannels == 4 && srcLayout.Bgr != dstLayout.Bgr)
+    {
+        ForEachRowRange( height, dstPitch, pWorker, [&]( uint32_t rowBegin, uint32_t rowEnd ) {
+            SwizzleRGBA8ToBGRA8( pSrcBytes + rowBegin * srcPitch, pDstBytes + rowBegin * dstPitch, size_t( rowEnd - rowBegin ) * width );
+        } );
+        return true;
+    }
+    if (srcLayout.NumChannels == dstLayout.NumChannels && ((srcLayout.Type == ChannelType::Float && dstLayout.Type == ChannelType::Half) || (srcLayout.Type == ChannelType::Half && dstLayout.Type == ChannelType::Float)))
+    {
+        const bool toHalf = dstLayout.Type == ChannelType::Half;
+        ForEachRowRange( height, dstPitch, pWorker, [&]( uint32_t rowBegin, uint32_t rowEnd ) {
+            const size_t numValues = size_t( rowEnd - rowBegin ) * width * srcLayout.NumChannels;
+            if (toHalf)
+                ConvertFloatToHalf( (const float*) (pSrcBytes + rowBegin * srcPitch), (uint16_t*) (pDstBytes + rowBegin * dstPitch), numValues );
+            else
+                ConvertHalfToFloat( (const uint16_t*) (pSrcBytes + rowBegin * srcPitch), (float*) (pDstBytes + rowBegin * dstPitch), numValues );
+        } );
+        return true;
+    }
+    if (srcLayout.Type == ChannelType::Float && srcLayout.NumChannels >= 3 && dstLayout.Type == ChannelType::Ufloat111110)
+    {
+        ForEachRowRange( height, dstPitch, pWorker, [&]( uint32_t rowBegin, uint32_t rowEnd ) {
+            PackR11G11B10( (const float*) (pSrcBytes + rowBegin * srcPitch), srcLayout.NumChannels, (uint32_t*) (pDstBytes + rowBegin * dstPitch), size_t( rowEnd - rowBegin ) * width );
+        } );
+        return true;
+    }
+
+    // General case, through linear RGBA float.
+    ForEachRowRange( height, dstPitch, pWorker, [&]( uint32_t rowBegin, uint32_t rowEnd ) {
+        std::vector<float> row( size_t( width ) * 4 );
+        std::vector<float> scratch;
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
+        {
+            DecodeRow( pSrcBytes + y * srcPitch, srcLayout, row.data(), width, scratch );
+            EncodeRow( row.data(), dstLayout, pDstBytes + y * dstPitch, width, scratch );
+        }
+    } );
+    return true;
+}
+
+std::vector<uint8_t> ConvertImage( const void* pSrc, TextureFormat srcFormat, TextureFormat dstFormat, uint32_t width, uint32_t height, ThreadWorker* pWorker )
+{
+    FormatLayout dstLayout;
+    if (!CanConvertFormat( srcFormat ) || !GetFormatLayout( dstFormat, dstLayout ))
+        return {};
+    std::vector<uint8_t> converted( size_t( width ) * height * dstLayout.BytesPerPixel );
+    if (!ConvertImage( pSrc, srcFormat, converted.data(), dstFormat, width, height, pWorker ))
+        return {};
+    return converted;
+}
+
+bool GenerateMipLevel( const void* pSrc, uint32_t srcWidth, uint32_t srcHeight, void* pDst, TextureFormat format, MipFilter filter, ThreadWorker* pWorker )
+{
+    FormatLayout layout;
+    if (!GetFormatLayout( format, layout ) || srcWidth == 0 || srcHeight == 0)
+        return false;
+
+    const uint32_t dstWidth = std::max( 1u, srcWidth / 2 );
+    const uint32_t dstHeight = std::max( 1u, srcHeight / 2 );
+    const uint8_t* pSrcBytes = (const uint8_t*) pSrc;
+    uint8_t* pDstBytes = (uint8_t*) pDst;
+    const size_t srcPitch = size_t( srcWidth ) * layout.BytesPerPixel;
+    const size_t dstPitch = size_t( dstWidth ) * layout.BytesPerPixel;
+
+    if (filter == MipFilter::Box)
+    {
+        ForEachRowRange( dstHeight, srcPitch * 2, pWorker, [&]( uint32_t rowBegin, uint32_t rowEnd ) {
+            std::vector<float> row0( size_t( srcWidth ) * 4 ), row1( size_t( srcWidth ) * 4 ), out( size_t( dstWidth ) * 4 );
+            std::vector<float> scratch;
+            for (uint32_t y = rowBegin; y < rowEnd; ++y)
+            {
+                const uint32_t sy0 = std::min( y * 2, srcHeight - 1 );
+                const uint32_t sy1 = std::min( y * 2 + 1, srcHeight - 1 );
+                DecodeRow( pSrcBytes + sy0 * srcPitch, layout, row0.data(), srcWidth, scratch );
+                const float* pRow1 = row0.data();
+                if (sy1 != sy0)
+                {
+                    DecodeRow( pSrcBytes + sy1 * srcPitch, layout, row1.data(), srcWidth, scratch );
+                    pRow1 = row1.data();
+                }
+                for (uint32_t x = 0; x < dstWidth; ++x)
+                {
+                    const size_t sx0 = size_t( std::min( x * 2, srcWidth - 1 ) ) * 4;
+                    const size_t sx1 = size_t( std::min( x * 2 + 1, srcWidth - 1 ) ) * 4;
+                    const Vec4 sum = Vec4::Load( &row0[sx0] ) + Vec4::Load( &row0[sx1] ) + Vec4::Load( &pRow1[sx0] ) + Vec4::Load( &pRow1[sx1] );
+                    (sum * 0.25f).Store( &out[size_t( x ) * 4] );
+                }
+                EncodeRow( out.data(), layout, pDstBytes + y * dstPitch, dstWidth, scratch );
+            }
+        } );
+        return true;
+    }
+
+    // Kaiser - separable, vertical pass (in to a row of srcWidth) then horizontal.
+    static const KaiserWeights sKaiser;
+    constexpr int cNumTaps = KaiserWeights::cNumTaps;
+    ForEachRowRange( dstHeight, srcPitch * 2, pWorker, [&]( uint32_t rowBegin, uint32_t rowEnd ) {
+        // Consecutive destination rows share 6 of their 8 source rows, keep the decoded rows around (source row r lives in slot r%8).
+        std::vector<float> rowCache[cNumTaps];
+        int64_t rowCacheTags[cNumTaps];
+        for (int i = 0; i < cNumTaps; ++i)
+        {
+            rowCache[i].resize( size_t( srcWidth ) * 4 );
+            rowCacheTags[i] = -1;
+        }
+        std::vector<float> vertical( size_t( srcWidth ) * 4 ), out( size_t( dstWidth ) * 4 );
+        std::vector<float> scratch;
+
+        for (uint32_t y = rowBegin; y < rowEnd; ++y)
+        {
+            for (uint32_t x = 0; x < srcWidth; ++x)
+                Vec4::Zero().Store( &vertical[size_t( x ) * 4] );
+            for (int k = 0; k < cNumTaps; ++k)
+            {
+                const int64_t sy = std::clamp<int64_t>( int64_t( y ) * 2 - 3 + k, 0, srcHeight - 1 );
+                const int slot = int( sy % cNumTaps );
+                if (rowCacheTags[slot] != sy)
+                {
+                    DecodeRow( pSrcBytes + sy * srcPitch, layout, rowCache[slot].data(), srcWidth, scratch );
+                    rowCacheTags[slot] = sy;
+                }
+                const float* pRow = rowCache[slot].data();
+                const float w = sKaiser.Weights[k];
+                for (size_t i = 0; i < size_t( srcWidth ) * 4; i += 4)
+                    Vec4::Load( &vertical[i] ).MulAdd( Vec4::Load( &pRow[i] ), w ).Store( &vertical[i] );
+            }
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                Vec4 sum = Vec4::Zero();
+                for (int k = 0; k < cNumTaps; ++k)
+                {
+                    const int64_t sx = std::clamp<int64_t>( int64_t( x ) * 2 - 3 + k, 0, srcWidth - 1 );
+                    sum = sum.MulAdd( Vec4::Load( &vertical[size_t( sx ) * 4] ), sKaiser.Weights[k] );
+                }
+                sum.Store( &out[size_t( x ) * 4] );
+            }
+            EncodeRow( out.data(), layout, pDstBytes + y * dstPitch, dstWidth, scratch );
+        }
+    } );
+    return true;
+}
+
+std::vector<std::vector<uint8_t>> GenerateMipChain( const void* pSrc, uint32_t width, uint32_t height, TextureFormat format, MipFilter filter, ThreadWorker* pWorker, uint32_t maxLevels )
+{
+    FormatLayout layout;
+    if (!GetFormatLayout( format, layout ) || width == 0 || height == 0)
+        return {};
+
+    std::vector<std::vector<uint8_t>> levels;
+    const void* pLevelSrc = pSrc;
+    while ((width > 1 || height > 1) && (maxLevels == 0 || levels.size() < maxLevels))
+    {
+        const uint32_t levelWidth = std::max( 1u, width / 2 );
+        const uint32_t levelHeight = std::max( 1u, height / 2 );
+        auto& level = levels.emplace_back( size_t( levelWidth ) * levelHeight * layout.BytesPerPixel );
+        GenerateMipLevel( pLevelSrc, width, height, level.data(), format, filter, pWorker );
+        pLevelSrc = level.data();
+        width = levelWidth;
+        height = levelHeight;
+    }
+    return levels;
+}
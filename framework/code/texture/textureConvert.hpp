@@ -0,0 +1,93 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+///
+/// Cpu side image format conversion and mip generation.
+/// Row functions use NEON (Arm) or SSE2 (x86/x64) where available, with scalar fallbacks.
+/// Image functions can optionally split the work (by rows) across a ThreadWorker.
+///
+
+#include "textureFormat.hpp"
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+class ThreadWorker;
+
+
+//
+// Row conversions (operate on contiguous runs of pixels/values)
+//
+
+/// Expand 3 byte per pixel (RGB or BGR) data to 4 bytes per pixel with the given alpha.
+void ConvertRGB8ToRGBA8( const uint8_t* pSrc, uint8_t* pDst, size_t numPixels, uint8_t alpha = 255 );
+
+/// Swap the red and blue channels of 4 byte per pixel data (RGBA8 to BGRA8 or BGRA8 to RGBA8).  pSrc and pDst may be the same buffer.
+void SwizzleRGBA8ToBGRA8( const uint8_t* pSrc, uint8_t* pDst, size_t numPixels );
+
+/// Convert sRGB encoded bytes to linear floats (0-1).  Converts every value, alpha channels should be handled by the caller.
+void ConvertSrgb8ToLinear( const uint8_t* pSrc, float* pDst, size_t numValues );
+
+/// Convert linear floats to sRGB encoded bytes (values are clamped to 0-1).  Table based (range checks and compares vectorized), but correctly rounded (not an approximation).
+void ConvertLinearToSrgb8( const float* pSrc, uint8_t* pDst, size_t numValues );
+
+/// Convert floats to IEEE half floats (round to nearest even, out of range values become infinity).
+void ConvertFloatToHalf( const float* pSrc, uint16_t* pDst, size_t numValues );
+
+/// Convert IEEE half floats to floats.
+void ConvertHalfToFloat( const uint16_t* pSrc, float* pDst, size_t numValues );
+
+/// Pack floating point RGB in to TextureFormat::B10G11R11_UFLOAT_PACK32 (round to nearest even).
+/// Negative values clamp to zero and values too large for the format clamp to the largest finite value (65024 red/green, 64512 blue), infinity and nan are kept.
+/// @param srcStride number of floats between each source pixel (3 for RGB, 4 for RGBA)
+void PackR11G11B10( const float* pSrc, size_t srcStride, uint32_t* pDst, size_t numPixels );
+
+/// Unpack TextureFormat::B10G11R11_UFLOAT_PACK32 in to floating point RGB.
+/// @param dstStride number of floats between each destination pixel (3 for RGB, 4 for RGBA - alpha is left untouched)
+void UnpackR11G11B10( const uint32_t* pSrc, float* pDst, size_t dstStride, size_t numPixels );
+
+/// Single value helpers (exact, not table based)
+float SrgbToLinear( float srgb );
+float LinearToSrgb( float linear );
+uint16_t FloatToHalf( float value );
+float HalfToFloat( uint16_t value );
+
+
+//
+// Image conversion and mip generation
+//
+
+/// @return true if the format is supported by ConvertImage and GenerateMipLevel/GenerateMipChain (uncompressed 8bit unorm/srgb, 16/32bit float and B10G11R11 formats).
+bool CanConvertFormat( TextureFormat format );
+
+/// Convert a (tightly packed) image between formats.
+/// sRGB formats are converted through linear space, missing channels are filled with 0 (color) and 1 (alpha).
+/// @param pWorker optional thread worker to split the conversion (by rows) across (must not be called from one of its threads)
+/// @return false if either format is unsupported (see CanConvertFormat)
+bool ConvertImage( const void* pSrc, TextureFormat srcFormat, void* pDst, TextureFormat dstFormat, uint32_t width, uint32_t height, ThreadWorker* pWorker = nullptr );
+
+/// Convert a (tightly packed) image between formats.
+/// @return converted image data, empty on failure
+std::vector<uint8_t> ConvertImage( const void* pSrc, TextureFormat srcFormat, TextureFormat dstFormat, uint32_t width, uint32_t height, ThreadWorker* pWorker = nullptr );
+
+/// Filter used to downsample mip levels
+enum class MipFilter {
+    Box,        ///< 2x2 average (fast)
+    Kaiser      ///< 8 tap (per axis) Kaiser windowed sinc (sharper, less aliasing)
+};
+
+/// Generate the next mip level (max(1,width/2) x max(1,height/2)) from the given image.
+/// Filtering is done in linear space (sRGB formats are linearized first), alpha is filtered as-is.
+/// @return false if the format is unsupported
+bool GenerateMipLevel( const void* pSrc, uint32_t srcWidth, uint32_t srcHeight, void* pDst, TextureFormat format, MipFilter filter, ThreadWorker* pWorker = nullptr );
+
+/// Generate a mip chain for the given image.
+/// @param maxLevels maximum number of levels to generate (not including the source level), 0 for a full chain down to 1x1
+/// @return mip levels 1 onwards (level 0 is the source image), empty on failure
+std::vector<std::vector<uint8_t>> GenerateMipChain( const void* pSrc, uint32_t width, uint32_t height, TextureFormat format, MipFilter filter, ThreadWorker* pWorker = nullptr, uint32_t maxLevels = 0 );
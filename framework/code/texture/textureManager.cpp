@@ -45,3 +45,19 @@ const TextureBase* TextureManagerBase::CreateTextureObject( uint32_t Width, uint
     createInfo.Msaa = Msaa;
     return CreateTextureObject( createInfo );
 }
+
+const TextureBase* TextureManagerBase::CreateCompressedTextureFromBuffer( const void* pData, uint32_t Width, uint32_t Height, TextureFormat SrcFormat, TextureFormat CompressedFormat, BlockCompressQuality Quality, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name )
+{
+    if (!CanBlockCompress( CompressedFormat ))
+    {
+        LOGE( "CreateCompressedTextureFromBuffer: unsupported compressed format (%s)", name.c_str() );
+        return nullptr;
+    }
+    std::vector<uint8_t> compressed = BlockCompressImage( pData, SrcFormat, Width, Height, CompressedFormat, Quality, &m_LoadingThreadWorker );
+    if (compressed.empty())
+    {
+        LOGE( "CreateCompressedTextureFromBuffer: unable to compress (unsupported source format?) (%s)", name.c_str() );
+        return nullptr;
+    }
+    return CreateTextureFromBuffer( compressed.data(), compressed.size(), Width, Height, 1, CompressedFormat, SamplerMode, Filter, std::move( name ) );
+}
@@ -16,6 +16,7 @@
 
 #include "system/Worker.h"
 #include "texture.hpp"
+#include "textureCompress.hpp"
 
 // Forward declarations
 class AssetManager;
@@ -87,9 +88,31 @@ public:
     /// Create texture from a block of texture data in memory (with correct format, span etc).
     virtual const TextureBase* CreateTextureFromBuffer( const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name) = 0;
 
+    /// Create a block compressed texture from uncompressed image data in memory (eg procedurally generated or captured at runtime).
+    /// Compresses on the cpu (split across the texture loading threads) then creates the texture with CreateTextureFromBuffer.
+    /// @param SrcFormat format of pData (RGBA8 or anything ConvertImage supports), tightly packed
+    /// @param CompressedFormat format to create, must pass CanBlockCompress (and be supported by the gpu, eg ETC2/EAC on mobile, BC on desktop)
+    /// @return nullptr on failure
+    const TextureBase* CreateCompressedTextureFromBuffer( const void* pData, uint32_t Width, uint32_t Height, TextureFormat SrcFormat, TextureFormat CompressedFormat, BlockCompressQuality Quality, SamplerAddressMode SamplerMode, SamplerFilter Filter, std::string name );
+
     /// Get a 'default' sampler for the given address mode (all other sampler settings assumed to be 'normal' ie linearly sampled etc)
     virtual const SamplerBase* const GetSampler( SamplerAddressMode ) const = 0;
 
+    /// Set the maximum number of textures BatchLoad will read/transcode simultaneously (0 = one per loading worker thread).
+    /// Limits contention for storage and the loading threads, not memory; every transcoded texture in the batch is held until the single batched upload.
+    void SetMaxConcurrentLoads( uint32_t maxConcurrentLoads ) { m_MaxConcurrentLoads = maxConcurrentLoads; }
+
+    /// Timings for the stages of the most recent BatchLoad.
+    struct BatchLoadStats {
+        uint32_t NumTextures = 0;
+        uint32_t Concurrency = 0;       ///< number of textures read/transcoded simultaneously
+        uint64_t ReadUs = 0;            ///< file read time (summed across worker threads)
+        uint64_t TranscodeUs = 0;       ///< transcode (and supercompression inflate) time (summed across worker threads)
+        uint64_t ReadTranscodeWallUs = 0; ///< wall clock time of the read and transcode stages
+        uint64_t UploadWallUs = 0;      ///< wall clock time of the staging packing and (batched) upload
+    };
+    const BatchLoadStats& GetLastBatchLoadStats() const { return m_LastBatchLoadStats; }
+
 protected:
     const TextureBase* GetOrLoadTexture_( const std::string& textureSlotName, const std::string& filename, const SamplerAddressMode& sampler )
     {
@@ -105,6 +128,8 @@ protected:
     std::unique_ptr<TexturePpmBase>		        m_LoaderPpm;
     std::function<void(std::string&)>			m_DefaultFilenameManipulator = [](std::string&) {return; };
 	ThreadWorker								m_LoadingThreadWorker;
+    uint32_t                                    m_MaxConcurrentLoads = 0;
+    BatchLoadStats                              m_LastBatchLoadStats;
 };
 
 
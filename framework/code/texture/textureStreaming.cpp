@@ -0,0 +1,208 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "textureStreaming.hpp"
+#include "camera/camera.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <queue>
+
+
+TextureMipEstimate EstimateTextureMip(const Camera& camera, const glm::vec3& boundsCenter, float boundsRadius, uint32_t textureSize, uint32_t viewportHeight, float uvDensity)
+{
+    const float distance = glm::length(boundsCenter - camera.Position());
+    if (distance <= boundsRadius)
+        return { 0.0f, 1.0f };     // camera inside the bounds, want everything
+
+    // Projected diameter of the bounding sphere (in pixels), approximating the sphere's angular size as radius/distance (fine for anything not very close to the camera).
+    const float tanHalfFov = std::tan(camera.Fov() * 0.5f);
+    const float screenCoverage = boundsRadius / (distance * tanHalfFov);
+    const float projectedPixels = std::max(screenCoverage * float(viewportHeight), 1.0f);
+
+    // One texel per pixel.
+    const float texelsAcross = float(textureSize) * uvDensity;
+    const float mipLevel = std::max(0.0f, std::log2(texelsAcross / projectedPixels));
+    return { mipLevel, std::min(screenCoverage, 1.0f) };
+}
+
+
+TextureStreamingResidency::TextureStreamingResidency(size_t budgetBytes) noexcept
+    : m_BudgetBytes(budgetBytes)
+{
+}
+
+/*static*/ uint32_t TextureStreamingResidency::CalculateMipTailFirstLevel(uint32_t baseWidth, uint32_t baseHeight, uint32_t numLevels, uint32_t maxTailDimension)
+{
+    assert(numLevels > 0);
+    uint32_t level = 0;
+    while (level < numLevels - 1 && std::max(baseWidth >> level, baseHeight >> level) > maxTailDimension)
+        ++level;
+    return level;
+}
+
+TextureStreamingResidency::tHandle TextureStreamingResidency::Register(std::span<const size_t> levelBytes, uint32_t mipTailFirstLevel)
+{
+    assert(!levelBytes.empty());
+    mipTailFirstLevel = std::min(mipTailFirstLevel, uint32_t(levelBytes.size() - 1));
+
+    tHandle handle;
+    if (!m_FreeHandles.empty())
+    {
+        handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+    }
+    else
+    {
+        handle = (tHandle) m_Textures.size();
+        m_Textures.emplace_back();
+    }
+
+    auto& texture = m_Textures[handle];
+    texture = StreamedTexture{};
+    texture.LevelBytes.assign(levelBytes.begin(), levelBytes.end());
+    texture.MipTailFirstLevel = mipTailFirstLevel;
+    texture.ResidentMip = mipTailFirstLevel;
+    texture.TargetMip = mipTailFirstLevel;
+    texture.LastRequestedMip = mipTailFirstLevel;
+    texture.Registered = true;
+
+    const size_t tailBytes = ResidentSize(handle, mipTailFirstLevel);
+    m_MipTailBytes += tailBytes;
+    m_ResidentBytes += tailBytes;
+    return handle;
+}
+
+void TextureStreamingResidency::Unregister(tHandle handle)
+{
+    auto& texture = m_Textures[handle];
+    assert(texture.Registered);
+    m_MipTailBytes -= ResidentSize(handle, texture.MipTailFirstLevel);
+    m_ResidentBytes -= ResidentSize(handle, texture.ResidentMip);
+    texture = StreamedTexture{};
+    m_FreeHandles.push_back(handle);
+}
+
+size_t TextureStreamingResidency::ResidentSize(tHandle handle, uint32_t firstMip) const
+{
+    const auto& levelBytes = m_Textures[handle].LevelBytes;
+    size_t bytes = 0;
+    for (size_t level = firstMip; level < levelBytes.size(); ++level)
+        bytes += levelBytes[level];
+    return bytes;
+}
+
+void TextureStreamingResidency::RequestMip(tHandle handle, float mipLevel, float priority)
+{
+    auto& texture = m_Textures[handle];
+    assert(texture.Registered);
+    if (texture.RequestedPriority < 0.0f)
+    {
+        texture.RequestedMip = mipLevel;
+        texture.RequestedPriority = std::max(priority, 0.0f);
+    }
+    else
+    {
+        texture.RequestedMip = std::min(texture.RequestedMip, mipLevel);
+        texture.RequestedPriority = std::max(texture.RequestedPriority, priority);
+    }
+}
+
+void TextureStreamingResidency::SetResidentMip(tHandle handle, uint32_t residentMip)
+{
+    auto& texture = m_Textures[handle];
+    assert(texture.Registered);
+    assert(residentMip <= texture.MipTailFirstLevel);
+    m_ResidentBytes -= ResidentSize(handle, texture.ResidentMip);
+    texture.ResidentMip = residentMip;
+    m_ResidentBytes += ResidentSize(handle, texture.ResidentMip);
+}
+
+std::vector<TextureStreamingResidency::Change> TextureStreamingResidency::Update()
+{
+    // Determine the mip each texture would like (from this frame's requests or, for a while after the requests stop, the last requests).
+    std::vector<float> priorities(m_Textures.size(), 0.0f);
+    size_t totalBytes = 0;
+    for (tHandle handle = 0; handle < (tHandle) m_Textures.size(); ++handle)
+    {
+        auto& texture = m_Textures[handle];
+        if (!texture.Registered)
+            continue;
+        if (texture.RequestedPriority >= 0.0f)
+        {
+            texture.LastRequestedMip = std::min((uint32_t) std::max(0.0f, std::floor(texture.RequestedMip)), texture.MipTailFirstLevel);
+            texture.LastRequestedPriority = texture.RequestedPriority;
+            texture.LastRequestedFrame = m_FrameIndex;
+        }
+        else if (m_FrameIndex - texture.LastRequestedFrame > m_EvictionDelayFrames)
+        {
+            texture.LastRequestedMip = texture.MipTailFirstLevel;
+            texture.LastRequestedPriority = 0.0f;
+        }
+        texture.TargetMip = texture.LastRequestedMip;
+        priorities[handle] = texture.LastRequestedPriority;
+        totalBytes += ResidentSize(handle, texture.TargetMip);
+
+        // Ready for the next frame's requests
+        texture.RequestedPriority = -1.0f;
+    }
+
+    // Over budget?  Drop mips (one level at a time) from the least important textures.
+    // Each level dropped quadruples a texture's effective priority (it has a quarter of the texels left to lose), so reductions spread across
+    // textures rather than taking the lowest priority texture all the way down to its tail.
+    if (totalBytes > m_BudgetBytes)
+    {
+        using tCandidate = std::pair<float/*priority*/, tHandle>;
+        std::priority_queue<tCandidate, std::vector<tCandidate>, std::greater<tCandidate>> candidates;
+        for (tHandle handle = 0; handle < (tHandle) m_Textures.size(); ++handle)
+        {
+            const auto& texture = m_Textures[handle];
+            if (texture.Registered && texture.TargetMip < texture.MipTailFirstLevel)
+                candidates.push({ priorities[handle], handle });
+        }
+        while (totalBytes > m_BudgetBytes && !candidates.empty())
+        {
+            const auto [priority, handle] = candidates.top();
+            candidates.pop();
+            auto& texture = m_Textures[handle];
+            totalBytes -= texture.LevelBytes[texture.TargetMip];
+            ++texture.TargetMip;
+            if (texture.TargetMip < texture.MipTailFirstLevel)
+                candidates.push({ std::max(priority, FLT_MIN) * 4.0f, handle });   // FLT_MIN so unimportant (zero priority) textures spread their reductions too
+        }
+    }
+
+    // Evictions first (frees memory for the loads), then the loads in priority order.
+    std::vector<Change> changes;
+    std::vector<Change> loads;
+    for (tHandle handle = 0; handle < (tHandle) m_Textures.size(); ++handle)
+    {
+        const auto& texture = m_Textures[handle];
+        if (!texture.Registered)
+            continue;
+        if (texture.TargetMip > texture.ResidentMip)
+            changes.push_back({ handle, texture.ResidentMip, texture.TargetMip, priorities[handle] });
+        else if (texture.TargetMip < texture.ResidentMip)
+            loads.push_back({ handle, texture.ResidentMip, texture.TargetMip, priorities[handle] });
+    }
+    std::stable_sort(loads.begin(), loads.end(), [](const Change& a, const Change& b) { return a.Priority > b.Priority; });
+
+    size_t loadBytes = 0;
+    for (const auto& load : loads)
+    {
+        const size_t bytes = ResidentSize(load.Handle, load.ToMip) - ResidentSize(load.Handle, load.FromMip);
+        if (loadBytes > 0 && loadBytes + bytes > m_MaxLoadBytesPerUpdate)
+            break;
+        loadBytes += bytes;
+        changes.push_back(load);
+    }
+
+    ++m_FrameIndex;
+    return changes;
+}
@@ -0,0 +1,134 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+//
+// Texture streaming residency.
+// Graphics api independant (cpu only) bookkeeping of which mip levels each streamed texture wants resident, and which
+// it gets given the streaming memory budget.  The graphics api specific TextureManager does the actual uploads.
+//
+#include "system/glm_common.hpp"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Forward declarations
+class Camera;
+
+
+/// Result of EstimateTextureMip.
+struct TextureMipEstimate
+{
+    float MipLevel = 0.0f;          ///< (fractional) mip level needed to get roughly one texel per pixel
+    float ScreenCoverage = 0.0f;    ///< approximate fraction of the screen height covered by the object, useful as a streaming priority
+};
+
+/// Estimate the texture mip level needed to render an object with the given bounding sphere.
+/// Assumes the texture is mapped once across the object's bounds (scale with uvDensity for tiled textures).
+/// @param camera camera the object is being rendered with (uses position and vertical fov, objects beyond the far clip are not special cased)
+/// @param boundsCenter world space center of the object's bounding sphere
+/// @param boundsRadius radius of the object's bounding sphere
+/// @param textureSize largest dimension of the texture (mip 0)
+/// @param viewportHeight height (in pixels) of the render target
+/// @param uvDensity number of times the texture repeats across the object
+TextureMipEstimate EstimateTextureMip(const Camera& camera, const glm::vec3& boundsCenter, float boundsRadius, uint32_t textureSize, uint32_t viewportHeight, float uvDensity = 1.0f);
+
+
+/// Tracks requested and resident mip levels for a set of streamed textures and decides what to load/evict to stay within a memory budget.
+/// Each texture has an always resident 'mip tail' (the small mips, loaded with the texture) and streams its larger mips in and out on demand.
+/// Usage (once per frame): RequestMip for every visible texture, then Update and apply the returned changes (calling SetResidentMip as they complete).
+/// @note Not thread safe.
+class TextureStreamingResidency
+{
+    TextureStreamingResidency(const TextureStreamingResidency&) = delete;
+    TextureStreamingResidency& operator=(const TextureStreamingResidency&) = delete;
+public:
+    using tHandle = uint32_t;
+    static constexpr tHandle cInvalidHandle = ~0u;
+
+    /// @param budgetBytes memory budget for all registered textures (mip tails included, although they are never evicted)
+    explicit TextureStreamingResidency(size_t budgetBytes) noexcept;
+
+    /// Register a texture for streaming.  It is assumed to initially have just its mip tail resident.
+    /// @param levelBytes size (in bytes) of each mip level (all layers/faces), index 0 is the largest mip
+    /// @param mipTailFirstLevel first (largest) mip level of the always resident mip tail
+    /// @return handle for subsequent calls
+    tHandle Register(std::span<const size_t> levelBytes, uint32_t mipTailFirstLevel);
+
+    /// Stop tracking the given texture.
+    void Unregister(tHandle handle);
+
+    /// Request a mip level for the current frame (can be called multiple times per frame, the finest mip and highest priority are kept).
+    /// @param mipLevel mip level wanted (fractional mips round down to the finer level)
+    /// @param priority relative importance (eg EstimateTextureMip ScreenCoverage).  Low priority textures are the first to be reduced when over budget.
+    void RequestMip(tHandle handle, float mipLevel, float priority);
+
+    /// A change in mip residency that should be applied by the caller.
+    struct Change
+    {
+        tHandle  Handle;
+        uint32_t FromMip;           ///< currently resident (largest) mip
+        uint32_t ToMip;             ///< mip that should be resident. ToMip > FromMip is an eviction, ToMip < FromMip is a load
+        float    Priority;
+    };
+
+    /// Determine the target residency for each texture (given this frame's requests and the budget) and return the changes needed to get there.
+    /// Evictions are returned first, then loads in priority order (limited to SetMaxLoadBytesPerUpdate).
+    /// Resets the requests ready for the next frame.
+    std::vector<Change> Update();
+
+    /// Tell the residency tracker the mip level that is now resident (eg once a Change has been applied).
+    void SetResidentMip(tHandle handle, uint32_t residentMip);
+
+    uint32_t GetResidentMip(tHandle handle) const { return m_Textures[handle].ResidentMip; }
+    uint32_t GetTargetMip(tHandle handle) const { return m_Textures[handle].TargetMip; }
+    uint32_t GetMipTailFirstLevel(tHandle handle) const { return m_Textures[handle].MipTailFirstLevel; }
+
+    void SetBudget(size_t budgetBytes) { m_BudgetBytes = budgetBytes; }
+    size_t GetBudget() const { return m_BudgetBytes; }
+    /// Limit the bytes of loads returned by each Update (at least one load is always returned if any are needed).
+    void SetMaxLoadBytesPerUpdate(size_t maxBytes) { m_MaxLoadBytesPerUpdate = maxBytes; }
+    /// Number of Updates a texture keeps its last requested mips after it stops being requested (avoids thrashing when objects briefly go out of view).
+    void SetEvictionDelayFrames(uint32_t frames) { m_EvictionDelayFrames = frames; }
+
+    /// @return bytes used by the currently resident mips of all textures.
+    size_t GetResidentBytes() const { return m_ResidentBytes; }
+    /// @return bytes used by the (always resident) mip tails.
+    size_t GetMipTailBytes() const { return m_MipTailBytes; }
+
+    /// Helper to determine the mip tail for a texture, all mips with both dimensions less than or equal to maxTailDimension are in the tail.
+    /// @return first level of the mip tail (numLevels-1 if only the smallest mip fits)
+    static uint32_t CalculateMipTailFirstLevel(uint32_t baseWidth, uint32_t baseHeight, uint32_t numLevels, uint32_t maxTailDimension);
+
+protected:
+    /// Bytes used by the given texture when mips from firstMip downwards are resident.
+    size_t ResidentSize(tHandle handle, uint32_t firstMip) const;
+
+private:
+    struct StreamedTexture
+    {
+        std::vector<size_t> LevelBytes;
+        uint32_t MipTailFirstLevel = 0;
+        uint32_t ResidentMip = 0;
+        uint32_t TargetMip = 0;
+        float    RequestedMip = 0.0f;       ///< finest mip requested this frame
+        float    RequestedPriority = -1.0f; ///< highest priority requested this frame (<0 if not requested)
+        uint32_t LastRequestedMip = 0;
+        float    LastRequestedPriority = 0.0f;
+        uint64_t LastRequestedFrame = 0;
+        bool     Registered = false;
+    };
+    std::vector<StreamedTexture> m_Textures;
+    std::vector<tHandle>        m_FreeHandles;
+    size_t                      m_BudgetBytes;
+    size_t                      m_MaxLoadBytesPerUpdate = 16 * 1024 * 1024;
+    uint32_t                    m_EvictionDelayFrames = 30;
+    uint64_t                    m_FrameIndex = 1;
+    size_t                      m_ResidentBytes = 0;
+    size_t                      m_MipTailBytes = 0;
+};
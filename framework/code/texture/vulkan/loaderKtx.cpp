@@ -6,10 +6,14 @@
 //============================================================================================================
 
 #include "vulkan/vulkan.hpp"
+#include "vulkan/descriptorUpdateBatch.hpp"
 #include "vulkan/TextureFuncts.h"
 #include "texture/vulkan/texture.hpp"
 #include "loaderKtx.hpp"
 #include <ktxvulkan.h>  // KTX-Software
+#include <algorithm>
+#include <cassert>
+#include <numeric>
 
 
 // Static
@@ -88,6 +92,14 @@ TextureKtxFileWrapper TextureKtx<Vulkan>::Transcode(TextureKtxFileWrapper&& file
             return {};
         }
     }
+    // Pull the image data in to memory now (inflates zstd supercompressed ktx2), rather than have it done during the upload.
+    if (pKtxData != nullptr && ktxTexture_GetData(pKtxData) == nullptr)
+    {
+        if (KTX_SUCCESS != ktxTexture_LoadImageData(pKtxData, nullptr, 0))
+        {
+            return {};
+        }
+    }
     return std::move(fileData);
 }
 
@@ -142,6 +154,257 @@ TextureVulkan TextureKtx<Vulkan>::LoadKtx( Vulkan& vulkan, AssetManager& assetMa
     return LoadKtx( vulkan, ktxData, std::move(sampler) );
 }
 
+/*static*/ bool TextureKtx<Vulkan>::CanBatchUpload(ktxTexture* pKtxTexture)
+{
+    if (pKtxTexture->generateMipmaps)
+        return false;   // leave mip generation to the ktx library upload
+    if (ktxTexture_NeedsTranscoding(pKtxTexture) || ktxTexture_GetData(pKtxTexture) == nullptr)
+        return false;   // expected to have been through Transcode
+    // Ktx1 pads uncompressed rows to 4 bytes (ktx2 and block compressed data is tightly packed and can be copied as-is).
+    if (pKtxTexture->classId != class_id::ktxTexture2_c && !pKtxTexture->isCompressed)
+        return false;
+    return ktxTexture_GetVkFormat(pKtxTexture) != VK_FORMAT_UNDEFINED;
+}
+
+std::vector<TextureVulkan> TextureKtx<Vulkan>::LoadKtxBatch(Vulkan& vulkan, std::span<const TextureKtxFileWrapper* const> textureFiles, const Sampler<Vulkan>& sampler, size_t maxStagingBytes)
+{
+    return LoadKtxBatch(vulkan, textureFiles, {}, sampler, maxStagingBytes);
+}
+
+TextureVulkan TextureKtx<Vulkan>::LoadKtxMips(Vulkan& vulkan, const TextureKtxFileWrapper& textureFile, uint32_t firstLevel, const Sampler<Vulkan>& sampler)
+{
+    const TextureKtxFileWrapper* const pFile = &textureFile;
+    auto textures = LoadKtxBatch(vulkan, { &pFile, 1 }, { &firstLevel, 1 }, sampler);
+    return std::move(textures[0]);
+}
+
+/*static*/ size_t TextureKtx<Vulkan>::GetLevelDataSize(ktxTexture* pKtx, uint32_t level)
+{
+    // Image size is for a single layer/face/depth slice.
+    return ktxTexture_GetImageSize(pKtx, level) * pKtx->numLayers * pKtx->numFaces * std::max(1u, pKtx->baseDepth >> level);
+}
+
+std::vector<size_t> TextureKtx<Vulkan>::GetLevelDataSizes(const TextureKtxFileWrapper& textureFile) const
+{
+    ktxTexture* pKtx = GetKtxTexture(textureFile);
+    if (!pKtx)
+        return {};
+    std::vector<size_t> levelSizes;
+    levelSizes.reserve(pKtx->numLevels);
+    for (uint32_t level = 0; level < pKtx->numLevels; ++level)
+        levelSizes.push_back(GetLevelDataSize(pKtx, level));
+    return levelSizes;
+}
+
+bool TextureKtx<Vulkan>::Get2dDimensions(const TextureKtxFileWrapper& textureFile, uint32_t& width, uint32_t& height, uint32_t& numLevels) const
+{
+    ktxTexture* pKtx = GetKtxTexture(textureFile);
+    if (!pKtx || pKtx->numDimensions != 2)
+        return false;
+    width = pKtx->baseWidth;
+    height = pKtx->baseHeight;
+    numLevels = pKtx->numLevels;
+    return true;
+}
+
+bool TextureKtx<Vulkan>::CanStream(const TextureKtxFileWrapper& textureFile) const
+{
+    ktxTexture* pKtx = GetKtxTexture(textureFile);
+    if (!pKtx || pKtx->numLevels < 2 || pKtx->numDimensions != 2)
+        return false;
+    return CanBatchUpload(pKtx) && (m_Vulkan.GetFormatProperties(ktxTexture_GetVkFormat(pKtx)).optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
+}
+
+std::vector<TextureVulkan> TextureKtx<Vulkan>::LoadKtxBatch(Vulkan& vulkan, std::span<const TextureKtxFileWrapper* const> textureFiles, std::span<const uint32_t> firstLevels, const Sampler<Vulkan>& sampler, size_t maxStagingBytes)
+{
+    assert(firstLevels.empty() || firstLevels.size() == textureFiles.size());
+    std::vector<TextureVulkan> textures;
+    textures.resize(textureFiles.size());
+
+    auto& memoryManager = vulkan.GetMemoryManager();
+
+    // Textures that are part of the current submission (and where their data lives in the staging buffer)
+    struct PendingTexture {
+        size_t      Index;
+        ktxTexture* pKtx;
+        VkFormat    Format;
+        uint32_t    FirstLevel;
+        size_t      Alignment;
+        size_t      StagingOffset;
+    };
+    std::vector<PendingTexture> pending;
+    size_t pendingStagingBytes = 0;
+
+    // Pack the pending textures into a single staging buffer, record all the copies into one command buffer and submit it.
+    auto flushPending = [&]()
+    {
+        if (pending.empty())
+            return;
+
+        auto stagingBuffer = memoryManager.CreateBuffer(pendingStagingBytes, BufferUsageFlags::TransferSrc, MemoryUsage::CpuToGpu);
+        if (!stagingBuffer)
+        {
+            LOGE("LoadKtxBatch: unable to allocate %zu byte staging buffer", pendingStagingBytes);
+            pending.clear();
+            pendingStagingBytes = 0;
+            return;
+        }
+        {
+            // Levels are packed individually (largest first) so we can skip levels above FirstLevel (regardless of the level ordering in the ktx/ktx2 data).
+            auto mappedStaging = memoryManager.Map<uint8_t>(stagingBuffer);
+            for (const auto& p : pending)
+            {
+                size_t stagingOffset = p.StagingOffset;
+                for (uint32_t level = p.FirstLevel; level < p.pKtx->numLevels; ++level)
+                {
+                    ktx_size_t levelOffset = 0;
+                    ktxTexture_GetImageOffset(p.pKtx, level, 0, 0, &levelOffset);
+                    const size_t levelSize = GetLevelDataSize(p.pKtx, level);
+                    memcpy(mappedStaging.data() + stagingOffset, ktxTexture_GetData(p.pKtx) + levelOffset, levelSize);
+                    stagingOffset = (stagingOffset + levelSize + p.Alignment - 1) / p.Alignment * p.Alignment;
+                }
+            }
+            memoryManager.Unmap(stagingBuffer, std::move(mappedStaging));
+        }
+
+        VkCommandBuffer setupCmdBuffer = vulkan.StartSetupCommandBuffer();
+
+        std::vector<MemoryAllocatedBuffer<Vulkan, VkImage>> images;
+        images.reserve(pending.size());
+        std::vector<VkBufferImageCopy> regions;
+        for (const auto& p : pending)
+        {
+            const ktxTexture& ktx = *p.pKtx;
+            const uint32_t numLayers = ktx.numLayers * ktx.numFaces;
+            const uint32_t numLevels = ktx.numLevels - p.FirstLevel;
+
+            VkImageCreateInfo imageInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+            imageInfo.flags = ktx.isCubemap ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+            imageInfo.imageType = ktx.numDimensions == 1 ? VK_IMAGE_TYPE_1D : (ktx.numDimensions == 2 ? VK_IMAGE_TYPE_2D : VK_IMAGE_TYPE_3D);
+            imageInfo.format = p.Format;
+            imageInfo.extent = { std::max(1u, ktx.baseWidth >> p.FirstLevel), std::max(1u, ktx.baseHeight >> p.FirstLevel), std::max(1u, ktx.baseDepth >> p.FirstLevel) };
+            imageInfo.mipLevels = numLevels;
+            imageInfo.arrayLayers = numLayers;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            auto& image = images.emplace_back(memoryManager.CreateImage(imageInfo, MemoryUsage::GpuExclusive));
+            if (!image)
+            {
+                LOGE("LoadKtxBatch: unable to create image for texture %zu", p.Index);
+                continue;
+            }
+
+            // One copy region per mip level per layer/face (depth slices of a 3d texture are contiguous so go in a single region)
+            regions.clear();
+            size_t stagingLevelOffset = p.StagingOffset;
+            for (uint32_t level = p.FirstLevel; level < ktx.numLevels; ++level)
+            {
+                ktx_size_t levelOffset = 0;
+                ktxTexture_GetImageOffset(p.pKtx, level, 0, 0, &levelOffset);
+                for (uint32_t layer = 0; layer < ktx.numLayers; ++layer)
+                {
+                    for (uint32_t face = 0; face < ktx.numFaces; ++face)
+                    {
+                        ktx_size_t imageOffset = 0;
+                        ktxTexture_GetImageOffset(p.pKtx, level, layer, face, &imageOffset);
+
+                        VkBufferImageCopy& region = regions.emplace_back();
+                        region.bufferOffset = stagingLevelOffset + (imageOffset - levelOffset);
+                        region.bufferRowLength = 0;     // tightly packed
+                        region.bufferImageHeight = 0;
+                        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                        region.imageSubresource.mipLevel = level - p.FirstLevel;
+                        region.imageSubresource.baseArrayLayer = layer * ktx.numFaces + face;
+                        region.imageSubresource.layerCount = 1;
+                        region.imageOffset = { 0, 0, 0 };
+                        region.imageExtent = { std::max(1u, ktx.baseWidth >> level), std::max(1u, ktx.baseHeight >> level), std::max(1u, ktx.baseDepth >> level) };
+                    }
+                }
+                stagingLevelOffset = (stagingLevelOffset + GetLevelDataSize(p.pKtx, level) + p.Alignment - 1) / p.Alignment * p.Alignment;
+            }
+
+            vulkan.SetImageLayout(image.GetVkBuffer(), setupCmdBuffer, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                  VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, numLevels, 0, numLayers);
+            vkCmdCopyBufferToImage(setupCmdBuffer, stagingBuffer.GetVkBuffer(), image.GetVkBuffer(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t)regions.size(), regions.data());
+            vulkan.SetImageLayout(image.GetVkBuffer(), setupCmdBuffer, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                  VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, numLevels, 0, numLayers);
+        }
+
+        // Single submission for the whole batch (waits for completion)
+        vulkan.FinishSetupCommandBuffer(setupCmdBuffer);
+        memoryManager.Destroy(std::move(stagingBuffer));
+
+        for (size_t i = 0; i < pending.size(); ++i)
+        {
+            const auto& p = pending[i];
+            if (!images[i])
+                continue;
+            const ktxTexture& ktx = *p.pKtx;
+            const uint32_t numLayers = ktx.numLayers * ktx.numFaces;
+            const uint32_t numLevels = ktx.numLevels - p.FirstLevel;
+            const TextureFormat textureFormat = VkToTextureFormat(p.Format);
+
+            ImageViewType viewType;
+            if (ktx.isCubemap)
+                viewType = ktx.isArray ? ImageViewType::ViewCubeArray : ImageViewType::ViewCube;
+            else if (ktx.numDimensions == 3)
+                viewType = ImageViewType::View3D;
+            else if (ktx.numDimensions == 1)
+                viewType = ktx.isArray ? ImageViewType::View1DArray : ImageViewType::View1D;
+            else
+                viewType = ktx.isArray ? ImageViewType::View2DArray : ImageViewType::View2D;
+
+            Image<Vulkan> image{ std::move(images[i]) };
+            auto imageView = CreateImageView(vulkan, image, textureFormat, numLevels, 0, numLayers, 0, viewType);
+            if (imageView.IsEmpty())
+            {
+                ReleaseImage(vulkan, &image);
+                continue;
+            }
+            textures[p.Index] = TextureVulkan{ std::max(1u, ktx.baseWidth >> p.FirstLevel), std::max(1u, ktx.baseHeight >> p.FirstLevel), std::max(1u, ktx.baseDepth >> p.FirstLevel), numLevels, 0, numLayers, 0, textureFormat, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VkClearValue{}, std::move(image), sampler.Copy(), std::move(imageView) };
+        }
+
+        pending.clear();
+        pendingStagingBytes = 0;
+    };
+
+    for (size_t index = 0; index < textureFiles.size(); ++index)
+    {
+        const TextureKtxFileWrapper* pFile = textureFiles[index];
+        if (!pFile || !*pFile)
+            continue;
+        ktxTexture* pKtx = GetKtxTexture(*pFile);
+        const uint32_t firstLevel = firstLevels.empty() ? 0 : std::min(firstLevels[index], pKtx->numLevels - 1);
+        if (!CanBatchUpload(pKtx) || (vulkan.GetFormatProperties(ktxTexture_GetVkFormat(pKtx)).optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) == 0)
+        {
+            // Let the ktx library deal with (or report) anything out of the ordinary (always loads every mip level).
+            textures[index] = LoadKtx(vulkan, *pFile, sampler.Copy());
+            continue;
+        }
+
+        // Staging offsets (of each level) must be aligned to 4 bytes and to the texel (block) size.
+        const size_t alignment = std::lcm(size_t(4), size_t(ktxTexture_GetElementSize(pKtx)));
+        size_t dataSize = 0;
+        for (uint32_t level = firstLevel; level < pKtx->numLevels; ++level)
+            dataSize = (dataSize + GetLevelDataSize(pKtx, level) + alignment - 1) / alignment * alignment;
+        size_t offset = (pendingStagingBytes + alignment - 1) / alignment * alignment;
+        if (!pending.empty() && offset + dataSize > maxStagingBytes)
+        {
+            flushPending();
+            offset = 0;
+        }
+        pending.push_back({ index, pKtx, ktxTexture_GetVkFormat(pKtx), firstLevel, alignment, offset });
+        pendingStagingBytes = offset + dataSize;
+    }
+    flushPending();
+
+    return textures;
+}
+
 // Comparison functions so we can look for VkBuffer in a set of MemoryAllocatedBuffer<Vulkan, VkBuffer>
 static bool operator<(const MemoryAllocatedBuffer<Vulkan, VkBuffer>& a, const MemoryAllocatedBuffer<Vulkan, VkBuffer>& b) { return a.GetVkBuffer() < b.GetVkBuffer(); }
 static bool operator<(const VkBuffer& a, const MemoryAllocatedBuffer<Vulkan, VkBuffer>& b) { return a < b.GetVkBuffer(); }
@@ -224,7 +487,10 @@ static bool operator<(const MemoryAllocatedBuffer<Vulkan, VkDeviceMemory>& a, co
         }
     }
     else
+    {
         vkDestroyImage(device, image, pAllocator);
+        DescriptorUpdateBatch::NotifyResourceDestroyed();
+    }
 }
 
 /// @brief Function specialization
@@ -15,7 +15,9 @@
 #include "texture.hpp"
 #include <volk/volk.h>
 #include <set>
+#include <span>
 #include <memory>
+#include <vector>
 
 // Forward declarations
 struct ktxVulkanDeviceInfo;
@@ -55,8 +57,38 @@ public:
     /// @returns a &TextureVulkan, will be empty on failure
     TextureVulkan LoadKtx(Vulkan& vulkan, AssetManager& assetManager, const char* const pFileName, Sampler<Vulkan> sampler);
 
+    /// @brief Upload a batch of ktx textures using one staging buffer and one queue submission (rather than a submit and wait per texture).
+    /// Textures are expected to have already been through Transcode (so the image data is ready to be copied).
+    /// Textures the batched path does not handle (mip generation requested, uncompressed ktx1 with padded rows) fall back to the single texture LoadKtx.
+    /// @param textureFiles ktx file data we want to load as vulkan textures (null entries are skipped)
+    /// @param sampler sampler that each loaded texture will be given a copy of
+    /// @param maxStagingBytes textures are split into multiple submissions if their packed data exceeds this size
+    /// @returns textures in the same order as textureFiles, entries will be empty on failure
+    std::vector<TextureVulkan> LoadKtxBatch(Vulkan& vulkan, std::span<const TextureKtxFileWrapper* const> textureFiles, const Sampler<Vulkan>& sampler, size_t maxStagingBytes = 128 * 1024 * 1024);
+
+    /// @brief As LoadKtxBatch, but only uploading the mip levels from firstLevels[i] downwards (used when streaming, where the largest mips are loaded on demand).
+    /// The returned textures' Width/Height/MipLevels are those of the uploaded levels (ie mip firstLevel becomes mip 0).
+    /// @param firstLevels first (largest) mip level to upload for each of textureFiles (empty span loads all levels)
+    std::vector<TextureVulkan> LoadKtxBatch(Vulkan& vulkan, std::span<const TextureKtxFileWrapper* const> textureFiles, std::span<const uint32_t> firstLevels, const Sampler<Vulkan>& sampler, size_t maxStagingBytes = 128 * 1024 * 1024);
+
+    /// @brief Upload a single ktx texture, starting at the given mip level (see LoadKtxBatch).
+    /// @returns a &TextureVulkan, will be empty on failure
+    TextureVulkan LoadKtxMips(Vulkan& vulkan, const TextureKtxFileWrapper& textureFile, uint32_t firstLevel, const Sampler<Vulkan>& sampler);
+
+    /// @brief Get the size (in bytes) of each mip level in the (transcoded) texture file, including all layers/faces/slices.
+    /// @return level sizes (largest mip first), empty on failure
+    std::vector<size_t> GetLevelDataSizes(const TextureKtxFileWrapper& textureFile) const;
+
+    /// @brief Get the dimensions and level count of the (transcoded) texture file.
+    /// @return false if the texture file is empty or not a 2d texture.
+    bool Get2dDimensions(const TextureKtxFileWrapper& textureFile, uint32_t& width, uint32_t& height, uint32_t& numLevels) const;
+
+    /// @brief Determine if the given (transcoded) texture can be uploaded a mip range at a time (ie streamed).  Only 2d (and 2d array) textures with mips are streamable.
+    bool CanStream(const TextureKtxFileWrapper& textureFile) const;
+
     /// @brief Run the Ktx2 transcoding step (if needed) 
     /// Will do nothing for textures that do not need transcoding.
+    /// Also loads (and inflates any supercompressed) image data, so this is the cpu heavy stage that should be run on worker threads prior to upload.
     /// Performance will depend on ktx2 texture size and intermediate encoding format.
     /// @param fileData ktx file data loaded by TextureKtx::LoadData or similar.
     /// @return transcoded Ktx texture.
@@ -71,6 +103,12 @@ protected:
 
     uint32_t DetermineTranscodeOutputFormat() const;
 
+    /// @brief Determine if the given (transcoded) texture can be uploaded by LoadKtxBatch.
+    static bool CanBatchUpload(ktxTexture* pKtxTexture);
+
+    /// @brief Size of a mip level's data (all layers, faces and depth slices).
+    static size_t GetLevelDataSize(ktxTexture* pKtxTexture, uint32_t level);
+
 private:
     Vulkan& m_Vulkan;
     std::unique_ptr<ktxVulkanDeviceInfo> m_VulkanDeviceInfo;
@@ -8,6 +8,7 @@
 #include "memory/vulkan/memoryMapped.hpp"
 #include "texture.hpp"
 #include "vulkan/vulkan.hpp"
+#include "vulkan/descriptorUpdateBatch.hpp"
 #include <cstring>
 
 Texture<Vulkan>::Texture() noexcept
@@ -760,6 +761,85 @@ Texture<Vulkan> CreateTextureObjectView( Vulkan& vulkan, const Texture<Vulkan>&
 }
 
 
+//-----------------------------------------------------------------------------
+static Texture<Vulkan> CreateTextureFromCompressedBuffer( Vulkan& vulkan, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter )
+//-----------------------------------------------------------------------------
+{
+    // Block compressed formats are generally not supported with linear tiling, so copy from a staging buffer straight into the optimal tiled image.
+    auto& memoryManager = vulkan.GetMemoryManager();
+
+    auto stagingBuffer = memoryManager.CreateBuffer( DataSize, BufferUsageFlags::TransferSrc, MemoryUsage::CpuToGpu );
+    if (!stagingBuffer)
+    {
+        LOGE( "CreateTextureFromBuffer: Unable to allocate %zu byte staging buffer", DataSize );
+        return {};
+    }
+    {
+        auto mappedStaging = memoryManager.Map<uint8_t>( stagingBuffer );
+        memcpy( mappedStaging.data(), pData, DataSize );
+        memoryManager.Unmap( stagingBuffer, std::move( mappedStaging ) );
+    }
+
+    VkImageCreateInfo ImageInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    ImageInfo.imageType = VK_IMAGE_TYPE_2D;
+    ImageInfo.format = TextureFormatToVk( Format );
+    ImageInfo.extent = { Width, Height, 1 };
+    ImageInfo.mipLevels = 1;
+    ImageInfo.arrayLayers = 1;
+    ImageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    ImageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    ImageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    ImageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    ImageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    auto FinalVmaImage = memoryManager.CreateImage( ImageInfo, MemoryUsage::GpuExclusive );
+    if (!FinalVmaImage)
+    {
+        LOGE( "CreateTextureFromBuffer: Unable to initialize texture image" );
+        memoryManager.Destroy( std::move( stagingBuffer ) );
+        return {};
+    }
+
+    VkBufferImageCopy region{};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;     // tightly packed
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = { 0, 0, 0 };
+    region.imageExtent = { Width, Height, 1 };
+
+    VkCommandBuffer SetupCmdBuffer = vulkan.StartSetupCommandBuffer();
+    vulkan.SetImageLayout( FinalVmaImage.GetVkBuffer(), SetupCmdBuffer, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, 0, 1 );
+    vkCmdCopyBufferToImage( SetupCmdBuffer, stagingBuffer.GetVkBuffer(), FinalVmaImage.GetVkBuffer(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region );
+    vulkan.SetImageLayout( FinalVmaImage.GetVkBuffer(), SetupCmdBuffer, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 1, 0, 1 );
+    vulkan.FinishSetupCommandBuffer( SetupCmdBuffer );
+    memoryManager.Destroy( std::move( stagingBuffer ) );
+
+    Image<Vulkan> Image{ std::move( FinalVmaImage ) };
+
+    SamplerVulkan sampler = CreateSampler( vulkan, SamplerMode, Filter, SamplerBorderColor::TransparentBlackFloat, 0.0f );
+    if (sampler.IsEmpty())
+    {
+        ReleaseImage( vulkan, &Image );
+        return {};
+    }
+    ImageViewVulkan imageView = CreateImageView( vulkan, Image, Format, 1, 0, 1, 0, ImageViewType::View2D );
+    if (imageView.IsEmpty())
+    {
+        ReleaseSampler( vulkan, &sampler );
+        ReleaseImage( vulkan, &Image );
+        return {};
+    }
+
+    return { Width, Height, 1, 1, 0/*firstmip*/, 1, 0/*firstface*/, Format, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VkClearValue{}, std::move( Image ), std::move( sampler ), std::move( imageView ) };
+}
+
+
 //-----------------------------------------------------------------------------
 template<>
 Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan& vulkan, const void* pData, size_t DataSize, uint32_t Width, uint32_t Height, uint32_t Depth, TextureFormat Format, SamplerAddressMode SamplerMode, SamplerFilter Filter, const char* pName )
@@ -770,6 +850,16 @@ Texture<Vulkan> CreateTextureFromBuffer<Vulkan>( Vulkan& vulkan, const void* pDa
     else
         LOGI( "CreateTextureFromBuffer (%dx%d): %s", Width, Height, pName );
 
+    if (FormatIsCompressed( Format ))
+    {
+        if (Depth != 1)
+        {
+            LOGE( "CreateTextureFromBuffer: block compressed formats only supported for 2d textures" );
+            return {};
+        }
+        return CreateTextureFromCompressedBuffer( vulkan, pData, DataSize, Width, Height, Format, SamplerMode, Filter );
+    }
+
     auto& memoryManager = vulkan.GetMemoryManager();
 
     uint32_t Faces = 1;
@@ -1157,6 +1247,7 @@ void ReleaseImageView( Vulkan& vulkan, ImageView<Vulkan>* pImageView )
     if (!pImageView || pImageView->IsEmpty())
         return;
     vkDestroyImageView( vulkan.m_VulkanDevice, pImageView->m_ImageView, nullptr );
+    DescriptorUpdateBatch::NotifyResourceDestroyed();
     pImageView->m_ImageView = VK_NULL_HANDLE;
     pImageView->m_ImageViewType = ImageViewType::View1D;
 }
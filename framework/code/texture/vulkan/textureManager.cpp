@@ -10,6 +10,9 @@
 #include "../loaderPpm.hpp"
 #include "vulkan/vulkan.hpp"
 #include "memory/memory.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <atomic>
 
 
 //-----------------------------------------------------------------------------
@@ -50,6 +53,14 @@ bool TextureManager<Vulkan>::Initialize()
 void TextureManager<Vulkan>::Release()
 //-----------------------------------------------------------------------------
 {
+    for (auto& [releaseFrame, texture] : m_StreamingReleaseQueue)
+    {
+        texture.Release(&m_GfxApi);
+    }
+    m_StreamingReleaseQueue.clear();
+    m_StreamedTextures.clear();
+    m_StreamingResidency.reset();
+
     for (auto& [key, texture] : m_LoadedTextures)
     {
         texture.Release(&m_GfxApi);
@@ -84,6 +95,23 @@ const TextureBase* TextureManager<Vulkan>::GetOrLoadTexture_(const std::string&
     if (!pTexture)
     {
         const SamplerVulkan& samplerVulkan = static_cast<const SamplerVulkan&>(sampler);
+        if (IsStreamingEnabled())
+        {
+            // Load just the mip tail of streamable textures (the other mips are streamed from the file on demand).
+            auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(GetLoader());
+            auto ktxData = pKtxLoader->Transcode(pKtxLoader->LoadFile(m_AssetManager, filename.c_str()));
+            if (!ktxData)
+                return nullptr;
+            const uint32_t firstLevel = GetStreamingFirstLevel(ktxData);
+            auto loadedTexture = firstLevel > 0 ? pKtxLoader->LoadKtxMips(m_GfxApi, ktxData, firstLevel, samplerVulkan) : pKtxLoader->LoadKtx(m_GfxApi, ktxData, samplerVulkan.Copy());
+            if (loadedTexture.IsEmpty())
+                return nullptr;
+            auto insertedIt = m_LoadedTextures.insert({ textureSlotName, std::move(loadedTexture) });
+            if (firstLevel > 0)
+                AddStreamedTexture(insertedIt.first->second, ktxData, filename, firstLevel);
+            return &(insertedIt.first->second);
+        }
+
         auto loadedTexture = GetLoader()->LoadKtx(m_GfxApi, m_AssetManager, filename.c_str(), std::move(samplerVulkan.Copy()));
         if (!loadedTexture.IsEmpty())
         {
@@ -95,101 +123,98 @@ const TextureBase* TextureManager<Vulkan>::GetOrLoadTexture_(const std::string&
     return pTexture;
 }
 
-typedef std::queue<std::pair<size_t, TextureKtxFileWrapper>> tLoadedFileQueue;
-struct BatchLoadThreadParams {
-    AssetManager& assetManager;
-    std::mutex& loadedFileQueueMutex;
-    tLoadedFileQueue& loadedFileQueue;
-    Semaphore& dataReadySema;
-    const std::string& filename;
-    size_t slotIndex;;
-};
-
 //-----------------------------------------------------------------------------
 void TextureManager<Vulkan>::BatchLoad(const std::span<std::pair<std::string/*textureSlotName*/, std::string/*filename*/>> slotAndFileNames, const SamplerBase& defaultSampler)
 //-----------------------------------------------------------------------------
 {
-    std::mutex loadedFileQueueMutex;
-    tLoadedFileQueue loadedFileQueue;
-    Semaphore dataReadySema{ 0 };
-    Semaphore finishedSema{ 0 };
+    // Staged pipeline:
+    //  1) file read and 2) transcode - on the loading worker threads (up to m_MaxConcurrentLoads textures in flight at once)
+    //  3) staging buffer packing and 4) upload - on this thread, all textures in one batched submission (LoadKtxBatch)
+    const uint64_t startTimeUs = OS_GetTimeUS();
+
+    const uint32_t concurrency = std::max(1u, m_MaxConcurrentLoads == 0 ? m_LoadingThreadWorker.NumThreads() : std::min(m_MaxConcurrentLoads, m_LoadingThreadWorker.NumThreads()));
+    Semaphore loadSlotsSema{ concurrency };
+    ReverseSemaphore loadsOutstanding{ 0 };
+    std::atomic<uint64_t> readUs{ 0 };
+    std::atomic<uint64_t> transcodeUs{ 0 };
 
-    // Setup the output textures
-    std::vector<Texture> vulkanTextures;
-    vulkanTextures.resize(slotAndFileNames.size());
+    // Loaded (and transcoded) file data, one per slot (empty for slots already loaded)
+    std::vector<TextureKtxFileWrapper> loadedFiles;
+    loadedFiles.resize(slotAndFileNames.size());
 
-    // We have one worker job just grabbing loaded textures and transfering them to vulkan (gpu memory).
-    struct TransferWorkerParams {
-        std::mutex& loadedFileQueueMutex;
-        tLoadedFileQueue& loadedFileQueue;
-        Semaphore& dataReadySema;
-        Semaphore& finishedSema;
-        const SamplerVulkan& defaultSampler;
-        std::vector<Texture>& vulkanTextures;
-    } transferWorkerParams{ loadedFileQueueMutex, loadedFileQueue, dataReadySema, finishedSema, apiCast<Vulkan>(defaultSampler), vulkanTextures };
+    struct BatchLoadThreadParams {
+        AssetManager& assetManager;
+        Semaphore& loadSlotsSema;
+        ReverseSemaphore& loadsOutstanding;
+        std::atomic<uint64_t>& readUs;
+        std::atomic<uint64_t>& transcodeUs;
+        const std::string& filename;
+        TextureKtxFileWrapper& output;
+    };
 
-    m_LoadingThreadWorker.DoWork2([](TextureManagerVulkan* pThis, TransferWorkerParams params)
+    for (size_t slotIndex = 0; slotIndex < slotAndFileNames.size(); ++slotIndex)
     {
-        size_t texturesRemaining = params.vulkanTextures.size();
-        while (texturesRemaining > 0)
+        const auto& [textureSlotName, filename] = slotAndFileNames[slotIndex];
+        if (m_LoadedTextures.find(textureSlotName) != m_LoadedTextures.end())
+            continue;
+
+        loadSlotsSema.Wait();
+        loadsOutstanding.Lock();
+        BatchLoadThreadParams params{ m_AssetManager, loadSlotsSema, loadsOutstanding, readUs, transcodeUs, filename, loadedFiles[slotIndex] };
+
+        m_LoadingThreadWorker.DoWork2([](TextureManagerVulkan* pThis, BatchLoadThreadParams params)
         {
-            TextureKtxFileWrapper ktxData;
-            size_t slotIndex;
-            params.dataReadySema.Wait();
-            {
-                std::lock_guard<std::mutex> lock(params.loadedFileQueueMutex);
-                auto&& loadedData = params.loadedFileQueue.front();
-                ktxData = std::move(loadedData.second);
-                slotIndex = loadedData.first;
-                params.loadedFileQueue.pop();
-            }
-            if (ktxData)
-                params.vulkanTextures[slotIndex] = pThis->GetLoader()->LoadKtx(pThis->m_GfxApi, ktxData, std::move(params.defaultSampler.Copy()) );
-            --texturesRemaining;
-        }
-        params.finishedSema.Post();
+            const uint64_t readStartUs = OS_GetTimeUS();
+            auto ktxData = pThis->m_Loader->LoadFile(params.assetManager, params.filename.c_str());
+            const uint64_t transcodeStartUs = OS_GetTimeUS();
+            auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(pThis->GetLoader());
+            params.output = pKtxLoader->Transcode(std::move(ktxData));
+            const uint64_t endUs = OS_GetTimeUS();
+
+            params.readUs += transcodeStartUs - readStartUs;
+            params.transcodeUs += endUs - transcodeStartUs;
+            params.loadSlotsSema.Post();
+            params.loadsOutstanding.Unlock();
+        }, this, params);
+    }
 
-    }, this, transferWorkerParams);
+    // Wait for all the reads/transcodes to complete.
+    loadsOutstanding.WaitAndLock();
+    const uint64_t transcodedTimeUs = OS_GetTimeUS();
 
-    size_t currentSlotIndex = 0;
-    for (const auto& [textureSlotName, filename] : slotAndFileNames)
+    // Upload everything in one go (only the mip tails of textures being streamed).
+    std::vector<const TextureKtxFileWrapper*> filesToUpload;
+    std::vector<uint32_t> firstLevels;
+    filesToUpload.reserve(loadedFiles.size());
+    firstLevels.reserve(loadedFiles.size());
+    for (const auto& loadedFile : loadedFiles)
     {
-        auto iter = m_LoadedTextures.find(textureSlotName);
-        if (iter == m_LoadedTextures.end())
-        {
-            BatchLoadThreadParams params{ m_AssetManager, loadedFileQueueMutex, loadedFileQueue, dataReadySema, filename, currentSlotIndex };
-
-            m_LoadingThreadWorker.DoWork2([](TextureManagerVulkan* pThis, BatchLoadThreadParams params)
-            {
-                auto ktxData = pThis->m_Loader->LoadFile(params.assetManager, params.filename.c_str());
-                auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(pThis->GetLoader());
-                ktxData = pKtxLoader->Transcode(std::move(ktxData));
-                {
-                    std::lock_guard<std::mutex> lock(params.loadedFileQueueMutex);
-                    params.loadedFileQueue.emplace(std::pair{ params.slotIndex, std::move(ktxData) });
-                }
-                params.dataReadySema.Post();
-            }, this, params);
-
-            ++currentSlotIndex;
-        }
-        else
-        {
-            // Signal the transfer thread, but dont give it any data (it finishes when it has recieved a signal for every texture being BatchLoaded)
-            dataReadySema.Post();
-        }
+        filesToUpload.push_back(loadedFile ? &loadedFile : nullptr);
+        firstLevels.push_back(loadedFile ? GetStreamingFirstLevel(loadedFile) : 0);
     }
 
-    finishedSema.Wait();
+    auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(GetLoader());
+    std::vector<Texture> vulkanTextures = pKtxLoader->LoadKtxBatch(m_GfxApi, filesToUpload, firstLevels, apiCast<Vulkan>(defaultSampler));
 
     // Transfer all the loaded textures to m_LoadedTextures 
     for (size_t i = 0; i < vulkanTextures.size(); ++i)
     {
         if (!vulkanTextures[i].IsEmpty())
         {
-            m_LoadedTextures.emplace(std::pair<std::string, Texture>{ slotAndFileNames[i].first/*slot*/, std::move(vulkanTextures[i])});
+            auto insertedIt = m_LoadedTextures.emplace(std::pair<std::string, Texture>{ slotAndFileNames[i].first/*slot*/, std::move(vulkanTextures[i])});
+            if (firstLevels[i] > 0 && insertedIt.second)
+                AddStreamedTexture(insertedIt.first->second, loadedFiles[i], slotAndFileNames[i].second, firstLevels[i]);
         }
     }
+    loadedFiles.clear();
+
+    const uint64_t endTimeUs = OS_GetTimeUS();
+    m_LastBatchLoadStats.NumTextures = (uint32_t) std::count_if(filesToUpload.begin(), filesToUpload.end(), [](auto* p) { return p != nullptr; });
+    m_LastBatchLoadStats.Concurrency = concurrency;
+    m_LastBatchLoadStats.ReadUs = readUs;
+    m_LastBatchLoadStats.TranscodeUs = transcodeUs;
+    m_LastBatchLoadStats.ReadTranscodeWallUs = transcodedTimeUs - startTimeUs;
+    m_LastBatchLoadStats.UploadWallUs = endTimeUs - transcodedTimeUs;
 }
 
 //-----------------------------------------------------------------------------
@@ -242,3 +267,140 @@ const TextureBase* TextureManager<Vulkan>::CreateTextureObjectView( const Textur
     else
         return &it.first->second;
 }
+
+//-----------------------------------------------------------------------------
+void TextureManager<Vulkan>::EnableStreaming( size_t budgetBytes, uint32_t mipTailMaxDimension )
+//-----------------------------------------------------------------------------
+{
+    if (!m_StreamingResidency)
+        m_StreamingResidency = std::make_unique<TextureStreamingResidency>( budgetBytes );
+    else
+        m_StreamingResidency->SetBudget( budgetBytes );
+    m_MipTailMaxDimension = std::max( mipTailMaxDimension, 1u );
+}
+
+//-----------------------------------------------------------------------------
+uint32_t TextureManager<Vulkan>::GetStreamingFirstLevel( const TextureKtxFileWrapper& textureFile ) const
+//-----------------------------------------------------------------------------
+{
+    if (!IsStreamingEnabled())
+        return 0;
+    const auto* pKtxLoader = static_cast<const TextureKtx<Vulkan>*>(GetLoader());
+    uint32_t width, height, numLevels;
+    if (!pKtxLoader->CanStream( textureFile ) || !pKtxLoader->Get2dDimensions( textureFile, width, height, numLevels ))
+        return 0;
+    return TextureStreamingResidency::CalculateMipTailFirstLevel( width, height, numLevels, m_MipTailMaxDimension );
+}
+
+//-----------------------------------------------------------------------------
+void TextureManager<Vulkan>::AddStreamedTexture( Texture& texture, const TextureKtxFileWrapper& textureFile, std::string filename, uint32_t mipTailFirstLevel )
+//-----------------------------------------------------------------------------
+{
+    assert( IsStreamingEnabled() );
+    const auto* pKtxLoader = static_cast<const TextureKtx<Vulkan>*>(GetLoader());
+    uint32_t width, height, numLevels;
+    pKtxLoader->Get2dDimensions( textureFile, width, height, numLevels );
+    const auto levelSizes = pKtxLoader->GetLevelDataSizes( textureFile );
+
+    const auto handle = m_StreamingResidency->Register( levelSizes, mipTailFirstLevel );
+    m_StreamedTextures.try_emplace( &texture, StreamedTexture{ &texture, std::move( filename ), handle, std::max( width, height ) } );
+}
+
+//-----------------------------------------------------------------------------
+void TextureManager<Vulkan>::RequestTextureMip( const TextureBase* pTexture, float mipLevel, float priority )
+//-----------------------------------------------------------------------------
+{
+    auto it = m_StreamedTextures.find( pTexture );
+    if (it != m_StreamedTextures.end())
+        m_StreamingResidency->RequestMip( it->second.Handle, mipLevel, priority );
+}
+
+//-----------------------------------------------------------------------------
+void TextureManager<Vulkan>::RequestTextureMip( const TextureBase* pTexture, const Camera& camera, const glm::vec3& boundsCenter, float boundsRadius, uint32_t viewportHeight, float uvDensity )
+//-----------------------------------------------------------------------------
+{
+    auto it = m_StreamedTextures.find( pTexture );
+    if (it != m_StreamedTextures.end())
+    {
+        const auto estimate = EstimateTextureMip( camera, boundsCenter, boundsRadius, it->second.BaseSize, viewportHeight, uvDensity );
+        m_StreamingResidency->RequestMip( it->second.Handle, estimate.MipLevel, estimate.ScreenCoverage );
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool TextureManager<Vulkan>::UpdateStreaming()
+//-----------------------------------------------------------------------------
+{
+    if (!IsStreamingEnabled())
+        return false;
+    ++m_StreamingFrame;
+
+    // Release textures that the gpu has finished with.
+    while (!m_StreamingReleaseQueue.empty() && m_StreamingReleaseQueue.front().first <= m_StreamingFrame)
+    {
+        m_StreamingReleaseQueue.front().second.Release( &m_GfxApi );
+        m_StreamingReleaseQueue.pop_front();
+    }
+
+    const auto changes = m_StreamingResidency->Update();
+    if (changes.empty())
+        return false;
+
+    // Handle -> streamed texture lookup for the textures that are changing.
+    std::vector<StreamedTexture*> changing;
+    changing.reserve( changes.size() );
+    for (const auto& change : changes)
+    {
+        auto it = std::find_if( m_StreamedTextures.begin(), m_StreamedTextures.end(), [&change]( const auto& streamed ) { return streamed.second.Handle == change.Handle; } );
+        assert( it != m_StreamedTextures.end() );
+        changing.push_back( &it->second );
+    }
+
+    // Read (and transcode) the changing textures' files on the loading threads.  File data is only held until the upload below.
+    // Evictions are re-created too (from the mip tail), it is the simplest way to free the larger mips.
+    std::vector<TextureKtxFileWrapper> loadedFiles( changes.size() );
+    m_LoadingThreadWorker.ParallelFor( (uint32_t) changes.size(), 1, [&]( uint32_t begin, uint32_t end ) {
+        auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(GetLoader());
+        for (uint32_t i = begin; i < end; ++i)
+            loadedFiles[i] = pKtxLoader->Transcode( pKtxLoader->LoadFile( m_AssetManager, changing[i]->Filename.c_str() ) );
+    } );
+
+    // Re-create the changing textures (with their new mip ranges) in a single batched upload.
+    std::vector<const TextureKtxFileWrapper*> files;
+    std::vector<uint32_t> firstLevels;
+    files.reserve( changes.size() );
+    firstLevels.reserve( changes.size() );
+    for (size_t i = 0; i < changes.size(); ++i)
+    {
+        files.push_back( loadedFiles[i] ? &loadedFiles[i] : nullptr );
+        firstLevels.push_back( changes[i].ToMip );
+    }
+
+    auto* pKtxLoader = static_cast<TextureKtx<Vulkan>*>(GetLoader());
+    std::vector<Texture> newTextures = pKtxLoader->LoadKtxBatch( m_GfxApi, files, firstLevels, changing[0]->pTexture->Sampler );
+    loadedFiles.clear();
+
+    // Swap the new textures in (in place, so pointers handed out by GetOrLoadTexture stay valid) and queue the old ones for release once the gpu is done with them.
+    const uint64_t releaseFrame = m_StreamingFrame + m_GfxApi.GetSwapchainBufferCount() + 1;
+    uint32_t numChanged = 0;
+    for (size_t i = 0; i < changes.size(); ++i)
+    {
+        Texture& texture = *changing[i]->pTexture;
+        if (newTextures[i].IsEmpty())
+        {
+            LOGW( "UpdateStreaming: failed to re-create texture with mips %u+, leaving at mip %u", changes[i].ToMip, changes[i].FromMip );
+            continue;
+        }
+        // Keep the texture's own sampler (the batch upload gave every texture a reference to the first texture's sampler).
+        newTextures[i].Sampler = texture.Sampler.Copy();
+
+        m_StreamingReleaseQueue.emplace_back( releaseFrame, std::move( texture ) );
+        texture = std::move( newTextures[i] );
+        m_StreamingResidency->SetResidentMip( changes[i].Handle, changes[i].ToMip );
+        ++numChanged;
+    }
+    if (numChanged == 0)
+        return false;
+    ++m_StreamingGeneration;
+    return true;
+}
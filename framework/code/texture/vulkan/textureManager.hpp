@@ -7,9 +7,15 @@
 #pragma once
 
 #include "../textureManager.hpp"
+#include "../loaderKtx.hpp"
+#include "../textureStreaming.hpp"
+#include <deque>
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 // Forward declarations
+class Camera;
 class Vulkan;
 
 template<typename T_GFXAPI> class LoaderKtxT;
@@ -59,13 +65,62 @@ public:
     /// Get a 'default' sampler for the given address mode (all other sampler settings assumed to be 'normal' ie linearly sampled etc)
     const SamplerBase* const GetSampler( SamplerAddressMode ) const override;
 
+    /// @brief Enable texture streaming.  Must be called before loading the textures that are to be streamed.
+    /// Streamable textures (2d ktx textures with mips) subsequently loaded by GetOrLoadTexture or BatchLoad only upload their 'mip tail' (the small mips).
+    /// Larger mips are then loaded (and evicted) by UpdateStreaming, driven by RequestTextureMip.
+    /// @param budgetBytes memory budget for the streamed textures
+    /// @param mipTailMaxDimension mips with dimensions no larger than this are always resident
+    void EnableStreaming( size_t budgetBytes, uint32_t mipTailMaxDimension = 256 );
+    bool IsStreamingEnabled() const { return m_StreamingResidency != nullptr; }
+
+    /// @brief Request a mip level for a (streamed) texture, call every frame for every texture being rendered.  Does nothing for textures that are not being streamed.
+    /// @param mipLevel mip level (of the full sized texture) that is needed
+    /// @param priority relative importance of this texture (when over the streaming budget)
+    void RequestTextureMip( const TextureBase* pTexture, float mipLevel, float priority );
+
+    /// @brief Request the mip level needed to render an object (with the given bounding sphere) using this texture.  Does nothing for textures that are not being streamed.
+    void RequestTextureMip( const TextureBase* pTexture, const Camera& camera, const glm::vec3& boundsCenter, float boundsRadius, uint32_t viewportHeight, float uvDensity = 1.0f );
+
+    /// @brief Load/evict streamed texture mips (based on this frame's RequestTextureMip calls).  Expected to be called once per frame.
+    /// Streamed textures are re-created (in place) with the new mip range, any descriptor sets referencing them must be updated when this returns true.
+    /// The replaced vulkan images are released once they are guaranteed to no longer be in use by the gpu (a number of calls later).
+    /// @return true if any textures changed.
+    bool UpdateStreaming();
+
+    /// @return a counter that increments every time UpdateStreaming changes one or more textures.
+    uint32_t GetStreamingGeneration() const { return m_StreamingGeneration; }
+    /// @return the streaming residency tracker (null if streaming not enabled).
+    const TextureStreamingResidency* GetStreamingResidency() const { return m_StreamingResidency.get(); }
+
 protected:
     const TextureBase* GetOrLoadTexture_(const std::string& textureSlotName, const std::string& filename, const SamplerBase& sampler) override;
     void BatchLoad(const std::span<std::pair<std::string, std::string>>, const SamplerBase& defaultSampler) override;
 
+    /// @return the first level of the mip tail for the given texture, or 0 if the texture should not be streamed.
+    uint32_t GetStreamingFirstLevel( const TextureKtxFileWrapper& textureFile ) const;
+    /// Start streaming the given texture (which has been loaded with just its mip tail).
+    /// Only the texture's dimensions and level sizes are kept, the file is re-read (and transcoded) when its mips change.
+    void AddStreamedTexture( Texture& texture, const TextureKtxFileWrapper& textureFile, std::string filename, uint32_t mipTailFirstLevel );
+
 private:
+    /// Texture being streamed, and the data we need to stream it.
+    struct StreamedTexture {
+        Texture*                                pTexture;   ///< texture object in m_LoadedTextures (updated in-place when mips are streamed)
+        std::string                             Filename;   ///< ktx file the mips are streamed from
+        TextureStreamingResidency::tHandle      Handle;
+        uint32_t                                BaseSize;   ///< largest dimension of mip 0
+    };
+
     std::map<std::string, Texture>          m_LoadedTextures;
     std::vector<Sampler>                    m_DefaultSamplers;
     const bool                              m_MirrorClampToEdgeSupported = false;  // currently this is never set, if we add VK_KHR_sampler_mirror_clamp_to_edge extension support or samplerMirrorClampToEdge feature flag then we can change this to non const and set/reset
     tGfxApi&                                m_GfxApi;
+
+    // Streaming
+    std::unique_ptr<TextureStreamingResidency>  m_StreamingResidency;
+    std::unordered_map<const TextureBase*, StreamedTexture> m_StreamedTextures;
+    std::deque<std::pair<uint64_t, Texture>>    m_StreamingReleaseQueue;  ///< textures replaced by UpdateStreaming waiting for the gpu to finish with them (and the frame they can be released)
+    uint64_t                                    m_StreamingFrame = 0;
+    uint32_t                                    m_StreamingGeneration = 0;
+    uint32_t                                    m_MipTailMaxDimension = 256;
 };
@@ -0,0 +1,426 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "bindlessDescriptorHeap.hpp"
+#include "descriptorUpdateBatch.hpp"
+#include "extensionLib.hpp"
+#include "vulkan.hpp"
+#include "memory/vulkan/memoryManager.hpp"
+#include "texture/vulkan/texture.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+
+
+//-----------------------------------------------------------------------------
+// BindlessHandleAllocator
+//-----------------------------------------------------------------------------
+
+BindlessHandleAllocator::BindlessHandleAllocator( uint32_t capacity ) noexcept
+{
+    Reset( capacity );
+}
+
+void BindlessHandleAllocator::Reset( uint32_t capacity )
+{
+    m_Allocated.assign( capacity, false );
+    m_Retiring.assign( capacity, false );
+    m_FreeList.clear();
+    m_Retired.clear();
+    m_Frame = 0;
+    m_NumAllocated = 0;
+    m_HighWaterMark = 0;
+}
+
+uint32_t BindlessHandleAllocator::Allocate()
+{
+    uint32_t handle;
+    if (!m_FreeList.empty())
+    {
+        std::pop_heap( m_FreeList.begin(), m_FreeList.end(), std::greater<uint32_t>() );
+        handle = m_FreeList.back();
+        m_FreeList.pop_back();
+    }
+    else if (m_HighWaterMark < m_Allocated.size())
+    {
+        handle = m_HighWaterMark++;
+    }
+    else
+    {
+        return cInvalidHandle;
+    }
+    m_Allocated[handle] = true;
+    ++m_NumAllocated;
+    return handle;
+}
+
+bool BindlessHandleAllocator::Release( uint32_t handle )
+{
+    if (!IsAllocated( handle ))
+    {
+        assert( handle == cInvalidHandle && "releasing a handle that is not allocated" );
+        return false;
+    }
+    // Queuing it again would put the handle on the free list twice (and hand it out to two owners).
+    if (m_Retiring[handle])
+        return false;
+    // Still counted as allocated (and IsAllocated) until it is safe to reuse.
+    m_Retiring[handle] = true;
+    m_Retired.push_back( { handle, m_Frame } );
+    return true;
+}
+
+void BindlessHandleAllocator::NextFrame( uint32_t framesInFlight )
+{
+    ++m_Frame;
+    auto it = std::partition( m_Retired.begin(), m_Retired.end(), [this, framesInFlight]( const auto& retired ) { return retired.second + framesInFlight > m_Frame; } );
+    for (auto freeIt = it; freeIt != m_Retired.end(); ++freeIt)
+    {
+        m_Allocated[freeIt->first] = false;
+        m_Retiring[freeIt->first] = false;
+        --m_NumAllocated;
+        m_FreeList.push_back( freeIt->first );
+        std::push_heap( m_FreeList.begin(), m_FreeList.end(), std::greater<uint32_t>() );
+    }
+    m_Retired.erase( it, m_Retired.end() );
+}
+
+
+//-----------------------------------------------------------------------------
+// BindlessMaterialTable
+//-----------------------------------------------------------------------------
+
+BindlessMaterialTable::BindlessMaterialTable( uint32_t stride, uint32_t capacity ) noexcept
+{
+    Reset( stride, capacity );
+}
+
+void BindlessMaterialTable::Reset( uint32_t stride, uint32_t capacity )
+{
+    m_Stride = (stride + cStrideAlignment - 1) & ~(cStrideAlignment - 1);
+    m_Ids.Reset( capacity );
+    m_Data.assign( size_t( m_Stride ) * capacity, std::byte{ 0 } );
+    m_DirtyBegin = 0;
+    m_DirtyEnd = m_Data.size();
+}
+
+uint32_t BindlessMaterialTable::Allocate()
+{
+    const uint32_t materialId = m_Ids.Allocate();
+    if (materialId != BindlessHandleAllocator::cInvalidHandle)
+    {
+        const size_t offset = size_t( materialId ) * m_Stride;
+        std::fill_n( m_Data.begin() + offset, m_Stride, std::byte{ 0 } );
+        MarkDirty( offset, offset + m_Stride );
+    }
+    return materialId;
+}
+
+bool BindlessMaterialTable::Set( uint32_t materialId, std::span<const std::byte> data, uint32_t offset )
+{
+    if (!m_Ids.IsAllocated( materialId ) || size_t( offset ) + data.size() > m_Stride)
+        return false;
+    const size_t begin = size_t( materialId ) * m_Stride + offset;
+    std::memcpy( m_Data.data() + begin, data.data(), data.size() );
+    MarkDirty( begin, begin + data.size() );
+    return true;
+}
+
+std::pair<size_t, size_t> BindlessMaterialTable::TakeDirtyRange()
+{
+    std::pair<size_t, size_t> range{ m_DirtyBegin, m_DirtyEnd };
+    m_DirtyBegin = m_DirtyEnd = 0;
+    return range;
+}
+
+void BindlessMaterialTable::MarkDirty( size_t begin, size_t end )
+{
+    if (begin >= end)
+        return;
+    if (m_DirtyBegin == m_DirtyEnd)
+    {
+        m_DirtyBegin = begin;
+        m_DirtyEnd = end;
+    }
+    else
+    {
+        m_DirtyBegin = std::min( m_DirtyBegin, begin );
+        m_DirtyEnd = std::max( m_DirtyEnd, end );
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// BindlessDescriptorHeap
+//-----------------------------------------------------------------------------
+
+BindlessDescriptorHeap::BindlessDescriptorHeap( Vulkan& vulkan ) noexcept : m_Vulkan( vulkan )
+{
+}
+
+BindlessDescriptorHeap::~BindlessDescriptorHeap()
+{
+    assert( m_DescriptorPool == VK_NULL_HANDLE && "call Destroy" );
+}
+
+bool BindlessDescriptorHeap::IsSupported( const Vulkan& vulkan )
+{
+#if VK_EXT_descriptor_indexing
+    const auto* pDescriptorIndexingExt = vulkan.GetExtension<ExtensionLib::Ext_VK_EXT_descriptor_indexing>();
+    if (!pDescriptorIndexingExt || pDescriptorIndexingExt->Status != VulkanExtensionStatus::eLoaded)
+        return false;
+    const auto& features = pDescriptorIndexingExt->RequestedFeatures;
+    return features.runtimeDescriptorArray
+        && features.descriptorBindingPartiallyBound
+        && features.descriptorBindingUpdateUnusedWhilePending
+        && features.descriptorBindingSampledImageUpdateAfterBind
+        && features.descriptorBindingStorageBufferUpdateAfterBind
+        && features.shaderSampledImageArrayNonUniformIndexing;
+#else
+    return false;
+#endif // VK_EXT_descriptor_indexing
+}
+
+bool BindlessDescriptorHeap::Initialize( const Config& config )
+{
+    assert( m_DescriptorPool == VK_NULL_HANDLE );
+    if (!IsSupported( m_Vulkan ))
+    {
+        LOGE( "BindlessDescriptorHeap: VK_EXT_descriptor_indexing (with partially bound, update after bind and runtime descriptor arrays) is not available" );
+        return false;
+    }
+    // Every binding is visible to all shader stages, so the per stage limits apply to the whole set (combined image samplers count as both a sampler and a sampled image).
+    const auto& limits = m_Vulkan.GetExtension<ExtensionLib::Ext_VK_EXT_descriptor_indexing>()->Properties;
+    const uint32_t maxTextures = std::min( { limits.maxDescriptorSetUpdateAfterBindSampledImages, limits.maxDescriptorSetUpdateAfterBindSamplers, limits.maxPerStageDescriptorUpdateAfterBindSampledImages, limits.maxPerStageDescriptorUpdateAfterBindSamplers } );
+    const uint32_t maxStorageBuffers = std::min( limits.maxDescriptorSetUpdateAfterBindStorageBuffers, limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers ) - 1;
+    if (config.MaxTextures > maxTextures || config.MaxStorageBuffers > maxStorageBuffers)
+    {
+        LOGE( "BindlessDescriptorHeap: requested %u textures and %u storage buffers, device limits are %u and %u", config.MaxTextures, config.MaxStorageBuffers, maxTextures, maxStorageBuffers );
+        return false;
+    }
+    if (uint64_t( config.MaxTextures ) + config.MaxStorageBuffers + 1 > limits.maxPerStageUpdateAfterBindResources)
+    {
+        LOGE( "BindlessDescriptorHeap: requested %u textures and %u storage buffers (plus the material table), device per stage resource limit is %u", config.MaxTextures, config.MaxStorageBuffers, limits.maxPerStageUpdateAfterBindResources );
+        return false;
+    }
+
+    const uint32_t numFrameBuffers = config.NumFrameBuffers ? config.NumFrameBuffers : m_Vulkan.m_SwapchainImageCount;
+    m_TextureHandles.Reset( config.MaxTextures );
+    m_StorageBufferHandles.Reset( config.MaxStorageBuffers );
+    m_MaterialTable.Reset( config.MaterialStride, config.MaxMaterials );
+
+    m_LayoutBindings = {
+        { cTextureBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, config.MaxTextures, VK_SHADER_STAGE_ALL, nullptr },
+        { cStorageBufferBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, config.MaxStorageBuffers, VK_SHADER_STAGE_ALL, nullptr },
+        { cMaterialTableBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr },
+    };
+    m_DescriptorSetLayout = CreateCompatibleVkDescriptorSetLayout();
+    if (m_DescriptorSetLayout == VK_NULL_HANDLE)
+    {
+        Destroy();
+        return false;
+    }
+
+    const VkDescriptorPoolSize poolSizes[] = {
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, config.MaxTextures * numFrameBuffers },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, (config.MaxStorageBuffers + 1) * numFrameBuffers },
+    };
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    poolInfo.maxSets = numFrameBuffers;
+    poolInfo.poolSizeCount = (uint32_t) std::size( poolSizes );
+    poolInfo.pPoolSizes = poolSizes;
+    if (VK_SUCCESS != vkCreateDescriptorPool( m_Vulkan.m_VulkanDevice, &poolInfo, nullptr, &m_DescriptorPool ))
+    {
+        LOGE( "BindlessDescriptorHeap: failed to create descriptor pool" );
+        Destroy();
+        return false;
+    }
+
+    auto& memoryManager = m_Vulkan.GetMemoryManager();
+    auto& updateBatch = m_Vulkan.GetDescriptorUpdateBatch();
+    const size_t materialTableSize = std::max( m_MaterialTable.GetData().size(), size_t( BindlessMaterialTable::cStrideAlignment ) );
+    m_Frames.resize( numFrameBuffers );
+    for (auto& frame : m_Frames)
+    {
+        VkDescriptorSetAllocateInfo allocateInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+        allocateInfo.descriptorPool = m_DescriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = &m_DescriptorSetLayout;
+        if (VK_SUCCESS != vkAllocateDescriptorSets( m_Vulkan.m_VulkanDevice, &allocateInfo, &frame.DescriptorSet ))
+        {
+            LOGE( "BindlessDescriptorHeap: failed to allocate descriptor set" );
+            Destroy();
+            return false;
+        }
+        frame.MaterialBuffer = memoryManager.CreateBuffer( materialTableSize, BufferUsageFlags::Storage, MemoryUsage::CpuToGpu, &frame.MaterialBufferInfo );
+        if (!frame.MaterialBuffer)
+        {
+            LOGE( "BindlessDescriptorHeap: failed to create material table buffer (%zu bytes)", materialTableSize );
+            Destroy();
+            return false;
+        }
+        // Whole table is uploaded on the first BeginFrame for this buffer.
+        frame.DirtyBegin = 0;
+        frame.DirtyEnd = m_MaterialTable.GetData().size();
+        updateBatch.QueueBufferWrite( frame.DescriptorSet, cMaterialTableBinding, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, { &frame.MaterialBufferInfo, 1 } );
+    }
+    m_MaterialTable.TakeDirtyRange();
+
+    LOGI( "BindlessDescriptorHeap: %u textures, %u storage buffers, %u materials (%u bytes each), %u frame buffers", config.MaxTextures, config.MaxStorageBuffers, config.MaxMaterials, m_MaterialTable.GetStride(), numFrameBuffers );
+    return true;
+}
+
+void BindlessDescriptorHeap::Destroy()
+{
+    std::vector<VkDescriptorSet> sets;
+    for (auto& frame : m_Frames)
+    {
+        if (frame.DescriptorSet != VK_NULL_HANDLE)
+            sets.push_back( frame.DescriptorSet );
+        if (frame.MaterialBuffer)
+            m_Vulkan.GetMemoryManager().Destroy( std::move( frame.MaterialBuffer ) );
+    }
+    m_Vulkan.GetDescriptorUpdateBatch().ForgetDescriptorSets( sets );
+    m_Frames.clear();
+    if (m_DescriptorPool != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorPool( m_Vulkan.m_VulkanDevice, m_DescriptorPool, nullptr );
+        m_DescriptorPool = VK_NULL_HANDLE;
+    }
+    if (m_DescriptorSetLayout != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorSetLayout( m_Vulkan.m_VulkanDevice, m_DescriptorSetLayout, nullptr );
+        m_DescriptorSetLayout = VK_NULL_HANDLE;
+    }
+    m_LayoutBindings.clear();
+    m_TextureHandles.Reset( 0 );
+    m_StorageBufferHandles.Reset( 0 );
+    m_MaterialTable.Reset( 0, 0 );
+}
+
+VkDescriptorSetLayout BindlessDescriptorHeap::CreateCompatibleVkDescriptorSetLayout() const
+{
+    std::vector<VkDescriptorBindingFlagsEXT> bindingFlags( m_LayoutBindings.size(), VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT );
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT };
+    bindingFlagsInfo.bindingCount = (uint32_t) bindingFlags.size();
+    bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    layoutInfo.pNext = &bindingFlagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    layoutInfo.bindingCount = (uint32_t) m_LayoutBindings.size();
+    layoutInfo.pBindings = m_LayoutBindings.data();
+
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    if (VK_SUCCESS != vkCreateDescriptorSetLayout( m_Vulkan.m_VulkanDevice, &layoutInfo, nullptr, &layout ))
+    {
+        LOGE( "BindlessDescriptorHeap: failed to create descriptor set layout" );
+        return VK_NULL_HANDLE;
+    }
+    return layout;
+}
+
+uint32_t BindlessDescriptorHeap::RegisterTexture( const VkDescriptorImageInfo& imageInfo )
+{
+    const uint32_t index = m_TextureHandles.Allocate();
+    if (index == cInvalidIndex)
+    {
+        LOGE( "BindlessDescriptorHeap: out of texture slots (%u)", m_TextureHandles.GetCapacity() );
+        return cInvalidIndex;
+    }
+    // Update after bind, so every frame's set can be written (at the next flush) even if in use by the gpu.
+    auto& updateBatch = m_Vulkan.GetDescriptorUpdateBatch();
+    for (const auto& frame : m_Frames)
+        updateBatch.QueueImageWrite( frame.DescriptorSet, cTextureBinding, index, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &imageInfo, 1 } );
+    return index;
+}
+
+uint32_t BindlessDescriptorHeap::RegisterTexture( const Texture<Vulkan>& texture )
+{
+    return RegisterTexture( texture.GetVkDescriptorImageInfo() );
+}
+
+void BindlessDescriptorHeap::ReleaseTexture( uint32_t index )
+{
+    // Descriptor is left as-is (partially bound), the slot is rewritten when reused.
+    m_TextureHandles.Release( index );
+}
+
+uint32_t BindlessDescriptorHeap::RegisterStorageBuffer( const VkDescriptorBufferInfo& bufferInfo )
+{
+    const uint32_t index = m_StorageBufferHandles.Allocate();
+    if (index == cInvalidIndex)
+    {
+        LOGE( "BindlessDescriptorHeap: out of storage buffer slots (%u)", m_StorageBufferHandles.GetCapacity() );
+        return cInvalidIndex;
+    }
+    auto& updateBatch = m_Vulkan.GetDescriptorUpdateBatch();
+    for (const auto& frame : m_Frames)
+        updateBatch.QueueBufferWrite( frame.DescriptorSet, cStorageBufferBinding, index, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, { &bufferInfo, 1 } );
+    return index;
+}
+
+void BindlessDescriptorHeap::ReleaseStorageBuffer( uint32_t index )
+{
+    m_StorageBufferHandles.Release( index );
+}
+
+void BindlessDescriptorHeap::BeginFrame( uint32_t bufferIdx )
+{
+    if (m_Frames.empty())
+        return;
+    const uint32_t framesInFlight = (uint32_t) m_Frames.size();
+    m_TextureHandles.NextFrame( framesInFlight );
+    m_StorageBufferHandles.NextFrame( framesInFlight );
+    m_MaterialTable.NextFrame( framesInFlight );
+
+    // Accumulate the modified range in to every frame's pending range, then bring this frame's buffer up to date.
+    const auto [dirtyBegin, dirtyEnd] = m_MaterialTable.TakeDirtyRange();
+    if (dirtyBegin != dirtyEnd)
+    {
+        for (auto& frame : m_Frames)
+        {
+            if (frame.DirtyBegin == frame.DirtyEnd)
+            {
+                frame.DirtyBegin = dirtyBegin;
+                frame.DirtyEnd = dirtyEnd;
+            }
+            else
+            {
+                frame.DirtyBegin = std::min( frame.DirtyBegin, dirtyBegin );
+                frame.DirtyEnd = std::max( frame.DirtyEnd, dirtyEnd );
+            }
+        }
+    }
+
+    auto& frame = m_Frames[bufferIdx % m_Frames.size()];
+    if (frame.DirtyBegin == frame.DirtyEnd)
+        return;
+    auto& memoryManager = m_Vulkan.GetMemoryManager();
+    auto mapped = memoryManager.Map<uint8_t>( frame.MaterialBuffer );
+    if (mapped.data() == nullptr)
+        return;
+    std::memcpy( mapped.data() + frame.DirtyBegin, m_MaterialTable.GetData().data() + frame.DirtyBegin, frame.DirtyEnd - frame.DirtyBegin );
+    memoryManager.Unmap( frame.MaterialBuffer, std::move( mapped ) );
+    frame.DirtyBegin = frame.DirtyEnd = 0;
+}
+
+void BindlessDescriptorHeap::Bind( VkCommandBuffer cmdBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t setIndex, uint32_t bufferIdx ) const
+{
+    const VkDescriptorSet descriptorSet = GetVkDescriptorSet( bufferIdx );
+    m_Vulkan.FlushDescriptorUpdates();
+    vkCmdBindDescriptorSets( cmdBuffer, bindPoint, pipelineLayout, setIndex, 1, &descriptorSet, 0, nullptr );
+}
+
+void BindlessDescriptorHeap::PushMaterialId( VkCommandBuffer cmdBuffer, VkPipelineLayout pipelineLayout, uint32_t materialId )
+{
+    vkCmdPushConstants( cmdBuffer, pipelineLayout, cPushConstantRange.stageFlags, cPushConstantRange.offset, cPushConstantRange.size, &materialId );
+}
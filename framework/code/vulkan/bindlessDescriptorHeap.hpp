@@ -0,0 +1,213 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+/// @file bindlessDescriptorHeap.hpp
+/// Global 'bindless' descriptor heap (VK_EXT_descriptor_indexing) and material data table.
+/// @ingroup Vulkan
+
+#include <volk/volk.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "memory/vulkan/memoryMapped.hpp"
+
+// Forward declarations
+class Vulkan;
+template<typename T_GFXAPI> class Texture;
+
+
+/// Allocates indices (handles) in the range [0, capacity).  Released indices are not reused until the frames that may still
+/// reference them have completed (see NextFrame).  Makes no Vulkan calls.
+class BindlessHandleAllocator
+{
+public:
+    static constexpr uint32_t cInvalidHandle = UINT32_MAX;
+
+    explicit BindlessHandleAllocator( uint32_t capacity = 0 ) noexcept;
+    /// Release everything and change the capacity.
+    void Reset( uint32_t capacity );
+
+    /// @return lowest unused handle (so the live range stays compact), or cInvalidHandle if all handles are in use
+    uint32_t Allocate();
+    /// Queue a handle for reuse once framesInFlight more frames have completed.
+    /// @return false if the handle has already been released (or is not allocated, which also asserts)
+    bool Release( uint32_t handle );
+    /// Advance the frame counter, handles released at least framesInFlight frames ago become available.
+    void NextFrame( uint32_t framesInFlight );
+
+    bool IsAllocated( uint32_t handle ) const           { return handle < m_Allocated.size() && m_Allocated[handle]; }
+    /// Released but not yet reusable (still IsAllocated)
+    bool IsRetired( uint32_t handle ) const             { return handle < m_Retiring.size() && m_Retiring[handle]; }
+    uint32_t GetCapacity() const                        { return (uint32_t) m_Allocated.size(); }
+    uint32_t GetNumAllocated() const                    { return m_NumAllocated; }
+    /// Number of handles waiting for the gpu to finish with them (included in GetNumAllocated)
+    uint32_t GetNumRetired() const                      { return (uint32_t) m_Retired.size(); }
+    /// One past the highest handle ever allocated (since Reset)
+    uint32_t GetHighWaterMark() const                   { return m_HighWaterMark; }
+
+private:
+    std::vector<bool>                           m_Allocated;
+    std::vector<bool>                           m_Retiring;         ///< handle is in m_Retired
+    std::vector<uint32_t>                       m_FreeList;         ///< min heap of free handles below m_HighWaterMark
+    std::vector<std::pair<uint32_t, uint64_t>>  m_Retired;          ///< released handle and the frame it was released on
+    uint64_t                                    m_Frame = 0;
+    uint32_t                                    m_NumAllocated = 0;
+    uint32_t                                    m_HighWaterMark = 0;
+};
+
+
+/// Cpu copy of a table of fixed size per-material records (indexed by material id) and tracking of the range modified since
+/// the last upload.  Makes no Vulkan calls.
+class BindlessMaterialTable
+{
+public:
+    /// Record stride is rounded up to this (std430 alignment of a vec4)
+    static constexpr uint32_t cStrideAlignment = 16;
+
+    BindlessMaterialTable( uint32_t stride = 0, uint32_t capacity = 0 ) noexcept;
+    /// Release everything and change the layout.  Every record is zeroed (and dirty).
+    void Reset( uint32_t stride, uint32_t capacity );
+
+    /// @return new material id (record is zeroed), or BindlessHandleAllocator::cInvalidHandle if the table is full
+    uint32_t Allocate();
+    /// Release a material id (reused once the gpu is done with it, see NextFrame)
+    bool Release( uint32_t materialId )                 { return m_Ids.Release( materialId ); }
+    void NextFrame( uint32_t framesInFlight )           { m_Ids.NextFrame( framesInFlight ); }
+
+    /// Write (part of) a material record.
+    /// @return false if the id is not allocated or the data does not fit in the record
+    bool Set( uint32_t materialId, std::span<const std::byte> data, uint32_t offset = 0 );
+    template<typename T>
+    bool Set( uint32_t materialId, const T& data, uint32_t offset = 0 )
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "material data must be trivially copyable");
+        return Set( materialId, std::as_bytes( std::span<const T>( &data, 1 ) ), offset );
+    }
+
+    /// @return byte range [first, second) modified since the last call (empty if nothing changed)
+    std::pair<size_t, size_t> TakeDirtyRange();
+
+    std::span<const std::byte> GetData() const          { return m_Data; }
+    uint32_t GetStride() const                          { return m_Stride; }
+    uint32_t GetCapacity() const                        { return m_Ids.GetCapacity(); }
+    const BindlessHandleAllocator& GetIds() const       { return m_Ids; }
+
+private:
+    void MarkDirty( size_t begin, size_t end );
+
+    BindlessHandleAllocator m_Ids;
+    std::vector<std::byte>  m_Data;
+    uint32_t                m_Stride = 0;
+    size_t                  m_DirtyBegin = 0;
+    size_t                  m_DirtyEnd = 0;
+};
+
+
+/// Global descriptor heap for 'bindless' rendering.
+///
+/// One descriptor set (per frame buffer) holding large, partially bound, update after bind arrays of textures and storage buffers
+/// plus a storage buffer of per-material records.  Resources are registered once and referenced (by index) from the material
+/// records; drawables using a bindless material just push their material id (as a push constant, cPushConstantRange) rather
+/// than binding descriptor sets, so every drawable sharing a pipeline is drawn with zero descriptor set rebinds.
+///
+/// Shader bindings (descriptor set marked "Bindless" in the shader json, any set index):
+///   binding 0 (cTextureBinding)        - sampler2D textures[]
+///   binding 1 (cStorageBufferBinding)  - buffer[] storage buffers
+///   binding 2 (cMaterialTableBinding)  - buffer of material records (GetMaterialStride bytes each)
+///   push_constant { uint materialId; }
+///
+/// Opt-in, created by Vulkan::CreateBindlessDescriptorHeap.  Material data set during a frame is visible to the gpu from the next frame.  Not thread safe.
+class BindlessDescriptorHeap
+{
+    BindlessDescriptorHeap( const BindlessDescriptorHeap& ) = delete;
+    BindlessDescriptorHeap& operator=( const BindlessDescriptorHeap& ) = delete;
+public:
+    struct Config
+    {
+        uint32_t MaxTextures = 4096;
+        uint32_t MaxStorageBuffers = 1024;
+        uint32_t MaxMaterials = 4096;
+        uint32_t MaterialStride = 64;       ///< bytes per material record (rounded up to BindlessMaterialTable::cStrideAlignment)
+        uint32_t NumFrameBuffers = 0;       ///< copies of the descriptor set and material table, 0 for the swapchain image count
+    };
+
+    static constexpr uint32_t cTextureBinding = 0;
+    static constexpr uint32_t cStorageBufferBinding = 1;
+    static constexpr uint32_t cMaterialTableBinding = 2;
+    static constexpr VkPushConstantRange cPushConstantRange{ VK_SHADER_STAGE_ALL, 0, sizeof( uint32_t ) };
+    static constexpr uint32_t cInvalidIndex = BindlessHandleAllocator::cInvalidHandle;
+
+    explicit BindlessDescriptorHeap( Vulkan& vulkan ) noexcept;
+    ~BindlessDescriptorHeap();
+
+    /// @return true if the device supports the descriptor indexing features the heap needs
+    static bool IsSupported( const Vulkan& vulkan );
+
+    bool Initialize( const Config& config );
+    void Destroy();
+
+    /// Add a texture to the heap.
+    /// @return index in the texture array, cInvalidIndex if the heap is full
+    uint32_t RegisterTexture( const VkDescriptorImageInfo& imageInfo );
+    uint32_t RegisterTexture( const Texture<Vulkan>& texture );
+    /// Remove a texture (index is reused once the gpu is done with it)
+    void ReleaseTexture( uint32_t index );
+    /// Add a storage buffer to the heap.
+    /// @return index in the storage buffer array, cInvalidIndex if the heap is full
+    uint32_t RegisterStorageBuffer( const VkDescriptorBufferInfo& bufferInfo );
+    void ReleaseStorageBuffer( uint32_t index );
+
+    /// @return new material id (record zeroed), cInvalidIndex if the table is full
+    uint32_t AllocateMaterial()                                                         { return m_MaterialTable.Allocate(); }
+    void ReleaseMaterial( uint32_t materialId )                                         { m_MaterialTable.Release( materialId ); }
+    bool SetMaterialData( uint32_t materialId, std::span<const std::byte> data, uint32_t offset = 0 ) { return m_MaterialTable.Set( materialId, data, offset ); }
+    template<typename T>
+    bool SetMaterialData( uint32_t materialId, const T& data, uint32_t offset = 0 )    { return m_MaterialTable.Set( materialId, data, offset ); }
+
+    /// Called once per frame (by Vulkan::SetNextBackBuffer) after waiting on the frame's fence.
+    /// Makes released indices available (once no longer in flight) and uploads modified material records to this frame's table.
+    void BeginFrame( uint32_t bufferIdx );
+
+    /// Bind the heap's descriptor set.  Pipelines using bindless materials only need this bound once per command buffer (and pipeline bind point), Drawable::DrawPass does this through its DrawStateCache.
+    void Bind( VkCommandBuffer cmdBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t setIndex, uint32_t bufferIdx ) const;
+    /// Push the material id used by the next draw/dispatch.
+    static void PushMaterialId( VkCommandBuffer cmdBuffer, VkPipelineLayout pipelineLayout, uint32_t materialId );
+
+    VkDescriptorSet GetVkDescriptorSet( uint32_t bufferIdx ) const                      { return m_Frames[bufferIdx % m_Frames.size()].DescriptorSet; }
+    std::span<const VkDescriptorSetLayoutBinding> GetLayoutBindings() const             { return m_LayoutBindings; }
+    /// Create a VkDescriptorSetLayout compatible with the heap's descriptor sets (caller owns it).
+    VkDescriptorSetLayout CreateCompatibleVkDescriptorSetLayout() const;
+    uint32_t GetNumFrameBuffers() const                                                 { return (uint32_t) m_Frames.size(); }
+    uint32_t GetMaterialStride() const                                                  { return m_MaterialTable.GetStride(); }
+    const BindlessHandleAllocator& GetTextureHandles() const                            { return m_TextureHandles; }
+    const BindlessHandleAllocator& GetStorageBufferHandles() const                      { return m_StorageBufferHandles; }
+    const BindlessMaterialTable& GetMaterialTable() const                               { return m_MaterialTable; }
+
+private:
+    struct FrameData
+    {
+        VkDescriptorSet                         DescriptorSet = VK_NULL_HANDLE;
+        MemoryAllocatedBuffer<Vulkan, VkBuffer> MaterialBuffer;
+        VkDescriptorBufferInfo                  MaterialBufferInfo{};
+        size_t                                  DirtyBegin = 0;     ///< material table range not yet uploaded to MaterialBuffer
+        size_t                                  DirtyEnd = 0;
+    };
+
+    Vulkan&                                     m_Vulkan;
+    std::vector<VkDescriptorSetLayoutBinding>   m_LayoutBindings;
+    VkDescriptorSetLayout                       m_DescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool                            m_DescriptorPool = VK_NULL_HANDLE;
+    std::vector<FrameData>                      m_Frames;
+    BindlessHandleAllocator                     m_TextureHandles;
+    BindlessHandleAllocator                     m_StorageBufferHandles;
+    BindlessMaterialTable                       m_MaterialTable;
+};
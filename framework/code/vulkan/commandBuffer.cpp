@@ -46,6 +46,13 @@ CommandList<Vulkan>& CommandList<Vulkan>::operator=(CommandList<Vulkan> && other
 //-----------------------------------------------------------------------------
 bool CommandList<Vulkan>::Initialize(Vulkan* pVulkan, const std::string& Name, CommandListBase::Type CmdBuffType, uint32_t QueueIndex, TimerPoolBase* pGpuTimerPool)
 //-----------------------------------------------------------------------------
+{
+    return Initialize(pVulkan, Name, CmdBuffType, QueueIndex, VK_NULL_HANDLE, pGpuTimerPool);
+}
+
+//-----------------------------------------------------------------------------
+bool CommandList<Vulkan>::Initialize(Vulkan* pVulkan, const std::string& Name, CommandListBase::Type CmdBuffType, uint32_t QueueIndex, VkCommandPool CommandPool, TimerPoolBase* pGpuTimerPool)
+//-----------------------------------------------------------------------------
 {
     m_Name = Name;
 
@@ -78,7 +85,18 @@ bool CommandList<Vulkan>::Initialize(Vulkan* pVulkan, const std::string& Name, C
     // Store which queue this command list is using (index in to Vulkan::m_VulkanQueues) so we can submit to the associated device queue.
     assert(pVulkan->m_VulkanQueues[QueueIndex].Queue != VK_NULL_HANDLE);
     m_QueueIndex = QueueIndex;
-    pVulkan->AllocateCommandBuffer(CmdBuffLevel, QueueIndex, &m_VkCommandBuffer);
+    m_VkCommandPool = CommandPool;
+    if (CommandPool != VK_NULL_HANDLE)
+    {
+        VkCommandBufferAllocateInfo AllocInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+        AllocInfo.commandPool = CommandPool;
+        AllocInfo.level = CmdBuffLevel;
+        AllocInfo.commandBufferCount = 1;
+        if (!CheckVkError("vkAllocateCommandBuffers()", vkAllocateCommandBuffers(pVulkan->m_VulkanDevice, &AllocInfo, &m_VkCommandBuffer)))
+            return false;
+    }
+    else
+        pVulkan->AllocateCommandBuffer(CmdBuffLevel, QueueIndex, &m_VkCommandBuffer);
     pVulkan->SetDebugObjectName(m_VkCommandBuffer, m_Name.c_str());
     return true;
 }
@@ -533,6 +551,14 @@ void CommandList<Vulkan>::ExecuteCommands( VkCommandBuffer vkCommandBuffer )
     vkCmdExecuteCommands( m_VkCommandBuffer, 1, &vkCommandBuffer );
 }
 
+//-----------------------------------------------------------------------------
+void CommandList<Vulkan>::ExecuteCommands( std::span<const VkCommandBuffer> vkCommandBuffers )
+//-----------------------------------------------------------------------------
+{
+    if (!vkCommandBuffers.empty())
+        vkCmdExecuteCommands( m_VkCommandBuffer, (uint32_t) vkCommandBuffers.size(), vkCommandBuffers.data() );
+}
+
 //-----------------------------------------------------------------------------
 bool CommandList<Vulkan>::End()
 //-----------------------------------------------------------------------------
@@ -625,9 +651,13 @@ void CommandList<Vulkan>::Release()
     {
         // Do not need to worry about the device or pool being NULL since we could 
         // not have created the command buffer!
-        m_pVulkan->FreeCommandBuffer(m_QueueIndex, m_VkCommandBuffer);
+        if (m_VkCommandPool != VK_NULL_HANDLE)
+            vkFreeCommandBuffers(m_pVulkan->m_VulkanDevice, m_VkCommandPool, 1, &m_VkCommandBuffer);
+        else
+            m_pVulkan->FreeCommandBuffer(m_QueueIndex, m_VkCommandBuffer);
         m_VkCommandBuffer = nullptr;
     }
+    m_VkCommandPool = VK_NULL_HANDLE;
 
     m_QueueIndex = 0;
     m_GpuTimerPool = nullptr;
@@ -7,6 +7,7 @@
 //============================================================================================================
 #pragma once
 
+#include <span>
 #include <string>
 
 // Need the vulkan wrapper
@@ -47,6 +48,9 @@ public:
     operator VkCommandBuffer() const { return m_VkCommandBuffer; }
 
     bool Initialize(Vulkan* pVulkan, const std::string& Name = {}, CommandListBase::Type CmdBuffType = Type::Primary, uint32_t QueueIndex = Vulkan::eGraphicsQueue, TimerPoolBase* pTimerPool = nullptr);
+    /// Initialize, allocating the command buffer from the given pool (rather than the queue's shared pool), eg a per-thread pool for multithreaded recording.
+    /// CommandPool must have been created for QueueIndex's queue family and must outlive this command list.
+    bool Initialize(Vulkan* pVulkan, const std::string& Name, CommandListBase::Type CmdBuffType, uint32_t QueueIndex, VkCommandPool CommandPool, TimerPoolBase* pTimerPool = nullptr);
     //bool Initialize(Vulkan* pVulkan, const std::string& Name, VkCommandBufferLevel CmdBuffLevel, std::same_as<bool> auto QueueIndex, TimerPoolBase* pTimerPool = nullptr) = delete;
 
     // Begin primary command buffer
@@ -83,6 +87,8 @@ public:
     /// Execute contents of the supplied command buffer (must be a secondary command buffer)
     void ExecuteCommands( const CommandList<Vulkan>& secondaryCommands );
     void ExecuteCommands( VkCommandBuffer );
+    /// Execute contents of the supplied (secondary) command buffers, in order
+    void ExecuteCommands( std::span<const VkCommandBuffer> );
 
     bool End();
 
@@ -136,4 +142,5 @@ public:
 
 private:
     Vulkan*             m_pVulkan = nullptr;
+    VkCommandPool       m_VkCommandPool = VK_NULL_HANDLE;   // pool m_VkCommandBuffer was allocated from, VK_NULL_HANDLE for the queue's shared pool
 };
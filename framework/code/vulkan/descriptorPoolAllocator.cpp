@@ -0,0 +1,353 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "descriptorPoolAllocator.hpp"
+#include "vulkan.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+
+DescriptorPoolBuckets::DescriptorPoolBuckets( uint32_t firstPoolSetCount, uint32_t maxPoolSetCount, uint32_t releaseDelayFrames ) noexcept
+    : m_FirstPoolSetCount( std::max( firstPoolSetCount, 1u ) )
+    , m_MaxPoolSetCount( std::max( maxPoolSetCount, std::max( firstPoolSetCount, 1u ) ) )
+    , m_ReleaseDelayFrames( releaseDelayFrames )
+{
+}
+
+std::vector<VkDescriptorPoolSize> DescriptorPoolBuckets::CalculateSizeClass( std::span<const VkDescriptorPoolSize> setPoolSizes )
+{
+    std::vector<VkDescriptorPoolSize> sizeClass;
+    sizeClass.reserve( setPoolSizes.size() );
+    for (const auto& poolSize : setPoolSizes)
+    {
+        if (poolSize.descriptorCount == 0)
+            continue;
+        auto it = std::find_if( sizeClass.begin(), sizeClass.end(), [&poolSize]( const VkDescriptorPoolSize& x ) { return x.type == poolSize.type; } );
+        if (it == sizeClass.end())
+            sizeClass.push_back( poolSize );
+        else
+            it->descriptorCount += poolSize.descriptorCount;
+    }
+    std::sort( sizeClass.begin(), sizeClass.end(), []( const VkDescriptorPoolSize& a, const VkDescriptorPoolSize& b ) { return a.type < b.type; } );
+    for (auto& poolSize : sizeClass)
+        poolSize.descriptorCount = std::bit_ceil( poolSize.descriptorCount );
+    return sizeClass;
+}
+
+uint32_t DescriptorPoolBuckets::DescriptorCount( std::span<const VkDescriptorPoolSize> poolSizes )
+{
+    uint32_t count = 0;
+    for (const auto& poolSize : poolSizes)
+        count += poolSize.descriptorCount;
+    return count;
+}
+
+DescriptorPoolBuckets::Slot DescriptorPoolBuckets::Allocate( std::span<const VkDescriptorPoolSize> setPoolSizes, VkDescriptorPoolCreateFlags poolFlags, bool& newPool )
+{
+    newPool = false;
+    std::vector<VkDescriptorPoolSize> sizeClass = CalculateSizeClass( setPoolSizes );
+
+    std::vector<std::pair<int, uint32_t>> key;
+    key.reserve( sizeClass.size() );
+    for (const auto& poolSize : sizeClass)
+        key.emplace_back( int( poolSize.type ), poolSize.descriptorCount );
+
+    auto [lookupIt, newBucket] = m_BucketLookup.try_emplace( { poolFlags, std::move( key ) }, uint32_t( m_Buckets.size() ) );
+    if (newBucket)
+    {
+        Bucket& bucket = m_Buckets.emplace_back();
+        bucket.DescriptorsPerSet = DescriptorCount( sizeClass );
+        bucket.SizeClass = std::move( sizeClass );
+        bucket.Flags = poolFlags;
+    }
+    const uint32_t bucketIdx = lookupIt->second;
+    Bucket& bucket = m_Buckets[bucketIdx];
+
+    // Fill the earliest pools first, so later (larger) pools empty out when sets are freed.  Released pools have no capacity.
+    uint32_t poolIdx = 0;
+    for (; poolIdx < (uint32_t) bucket.Pools.size(); ++poolIdx)
+    {
+        const Pool& pool = bucket.Pools[poolIdx];
+        if (!pool.Full && pool.Used < pool.Capacity)
+            break;
+    }
+    if (poolIdx == (uint32_t) bucket.Pools.size())
+    {
+        // New pool goes in the first released slot (or on the end), sized for its position.
+        poolIdx = 0;
+        while (poolIdx < (uint32_t) bucket.Pools.size() && bucket.Pools[poolIdx].Capacity != 0)
+            ++poolIdx;
+        if (poolIdx == (uint32_t) bucket.Pools.size())
+            bucket.Pools.emplace_back();
+        const uint32_t shift = std::min( poolIdx, 31u );
+        const uint64_t capacity = std::min( uint64_t( m_FirstPoolSetCount ) << shift, uint64_t( m_MaxPoolSetCount ) );
+        bucket.Pools[poolIdx] = { uint32_t( capacity ), 0, false };
+        newPool = true;
+    }
+    Pool& pool = bucket.Pools[poolIdx];
+    ++pool.Used;
+    pool.EmptySinceFrame = UINT64_MAX;
+    m_DescriptorsRequested += DescriptorCount( setPoolSizes );
+    return { bucketIdx, poolIdx };
+}
+
+void DescriptorPoolBuckets::Free( Slot slot, uint32_t numDescriptors )
+{
+    if (!slot.IsValid() || slot.Bucket >= m_Buckets.size() || slot.Pool >= m_Buckets[slot.Bucket].Pools.size())
+        return;
+    Pool& pool = m_Buckets[slot.Bucket].Pools[slot.Pool];
+    assert( pool.Used > 0 );
+    --pool.Used;
+    pool.Full = false;
+    if (pool.Used == 0)
+        pool.EmptySinceFrame = m_Frame;
+    m_DescriptorsRequested -= numDescriptors;
+}
+
+void DescriptorPoolBuckets::MarkPoolFull( Slot slot )
+{
+    m_Buckets[slot.Bucket].Pools[slot.Pool].Full = true;
+}
+
+void DescriptorPoolBuckets::Retire( Slot slot, VkDescriptorSet set, uint32_t numDescriptors )
+{
+    m_Retired.push_back( { { slot, set, numDescriptors }, m_Frame } );
+}
+
+std::vector<DescriptorPoolBuckets::RetiredSet> DescriptorPoolBuckets::NextFrame( uint32_t framesInFlight )
+{
+    ++m_Frame;
+    std::vector<RetiredSet> released;
+    auto keepIt = std::partition( m_Retired.begin(), m_Retired.end(), [this, framesInFlight]( const Retired& retired ) { return retired.Frame + framesInFlight > m_Frame; } );
+    released.reserve( std::distance( keepIt, m_Retired.end() ) );
+    for (auto it = keepIt; it != m_Retired.end(); ++it)
+    {
+        Free( it->Set.PoolSlot, it->Set.NumDescriptors );
+        released.push_back( it->Set );
+    }
+    m_Retired.erase( keepIt, m_Retired.end() );
+
+    // Release pools that have stayed empty (keeping the first pool of each bucket, so a bucket that is used intermittently does not keep recreating it).
+    for (uint32_t bucketIdx = 0; bucketIdx < (uint32_t) m_Buckets.size(); ++bucketIdx)
+    {
+        auto& pools = m_Buckets[bucketIdx].Pools;
+        for (uint32_t poolIdx = 1; poolIdx < (uint32_t) pools.size(); ++poolIdx)
+        {
+            Pool& pool = pools[poolIdx];
+            if (pool.Capacity == 0 || pool.Used > 0)
+                continue;
+            if (pool.EmptySinceFrame == UINT64_MAX)
+                pool.EmptySinceFrame = m_Frame;
+            else if (m_Frame - pool.EmptySinceFrame >= m_ReleaseDelayFrames)
+            {
+                pool = Pool{};
+                m_ReleasedPools.push_back( { bucketIdx, poolIdx } );
+            }
+        }
+    }
+    return released;
+}
+
+std::vector<DescriptorPoolBuckets::Slot> DescriptorPoolBuckets::TakeReleasedPools()
+{
+    return std::exchange( m_ReleasedPools, {} );
+}
+
+std::vector<DescriptorPoolBuckets::RetiredSet> DescriptorPoolBuckets::TakeAllRetired()
+{
+    std::vector<RetiredSet> released;
+    released.reserve( m_Retired.size() );
+    for (const auto& retired : m_Retired)
+    {
+        Free( retired.Set.PoolSlot, retired.Set.NumDescriptors );
+        released.push_back( retired.Set );
+    }
+    m_Retired.clear();
+    return released;
+}
+
+std::vector<VkDescriptorPoolSize> DescriptorPoolBuckets::GetPoolSizes( Slot slot ) const
+{
+    const Bucket& bucket = m_Buckets[slot.Bucket];
+    const uint32_t setCount = bucket.Pools[slot.Pool].Capacity;
+    std::vector<VkDescriptorPoolSize> poolSizes = bucket.SizeClass;
+    for (auto& poolSize : poolSizes)
+        poolSize.descriptorCount *= setCount;
+    return poolSizes;
+}
+
+DescriptorPoolBuckets::Stats DescriptorPoolBuckets::GetStats() const
+{
+    Stats stats;
+    stats.Buckets = (uint32_t) m_Buckets.size();
+    for (const auto& bucket : m_Buckets)
+    {
+        for (const auto& pool : bucket.Pools)
+        {
+            stats.Pools += pool.Capacity > 0 ? 1 : 0;
+            stats.SetsAllocated += pool.Used;
+            stats.SetsCapacity += pool.Capacity;
+            stats.DescriptorsReserved += uint64_t( pool.Used ) * bucket.DescriptorsPerSet;
+        }
+    }
+    stats.SetsRetired = (uint32_t) m_Retired.size();
+    stats.DescriptorsRequested = m_DescriptorsRequested;
+    return stats;
+}
+
+void DescriptorPoolBuckets::Clear()
+{
+    m_Buckets.clear();
+    m_BucketLookup.clear();
+    m_Retired.clear();
+    m_ReleasedPools.clear();
+    m_DescriptorsRequested = 0;
+}
+
+
+DescriptorPoolAllocator::DescriptorPoolAllocator( Vulkan& vulkan ) noexcept : m_Vulkan( vulkan )
+{
+}
+
+DescriptorPoolAllocator::~DescriptorPoolAllocator()
+{
+    Destroy();
+}
+
+DescriptorPoolAllocator::Allocation DescriptorPoolAllocator::Allocate( VkDescriptorSetLayout layout, std::span<const VkDescriptorPoolSize> setPoolSizes, VkDescriptorPoolCreateFlags poolFlags )
+{
+    Allocation allocation;
+    allocation.NumDescriptors = DescriptorPoolBuckets::DescriptorCount( setPoolSizes );
+    poolFlags |= VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+
+    std::lock_guard<std::mutex> lock( m_Mutex );
+
+    // Pools are sized so the allocation should always succeed, but the driver is allowed to report fragmentation so try a second pool if it does.
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        bool newPool = false;
+        const DescriptorPoolBuckets::Slot slot = m_Buckets.Allocate( setPoolSizes, poolFlags, newPool );
+        if (slot.Bucket >= m_Pools.size())
+            m_Pools.resize( slot.Bucket + 1 );
+        auto& bucketPools = m_Pools[slot.Bucket];
+        if (newPool)
+        {
+            // New pools are added on the end, or replace a released (destroyed) pool.
+            assert( slot.Pool == bucketPools.size() || bucketPools[slot.Pool] == VK_NULL_HANDLE );
+            if (slot.Pool == bucketPools.size())
+                bucketPools.push_back( VK_NULL_HANDLE );
+            const std::vector<VkDescriptorPoolSize> poolSizes = m_Buckets.GetPoolSizes( slot );
+            VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+            poolInfo.flags = m_Buckets.GetPoolFlags( slot );
+            poolInfo.maxSets = m_Buckets.GetPoolSetCount( slot );
+            poolInfo.poolSizeCount = (uint32_t) poolSizes.size();
+            poolInfo.pPoolSizes = poolSizes.data();
+            VkDescriptorPool pool = VK_NULL_HANDLE;
+            if (VK_SUCCESS != vkCreateDescriptorPool( m_Vulkan.m_VulkanDevice, &poolInfo, nullptr, &pool ))
+            {
+                LOGE( "DescriptorPoolAllocator: failed to create descriptor pool (%u sets)", poolInfo.maxSets );
+                m_Buckets.Free( slot, allocation.NumDescriptors );
+                m_Buckets.MarkPoolFull( slot );
+                return allocation;
+            }
+            bucketPools[slot.Pool] = pool;
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+        allocateInfo.descriptorPool = bucketPools[slot.Pool];
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = &layout;
+        if (VK_SUCCESS == vkAllocateDescriptorSets( m_Vulkan.m_VulkanDevice, &allocateInfo, &allocation.Set ))
+        {
+            allocation.PoolSlot = slot;
+            return allocation;
+        }
+        allocation.Set = VK_NULL_HANDLE;
+        m_Buckets.Free( slot, allocation.NumDescriptors );
+        m_Buckets.MarkPoolFull( slot );
+    }
+    LOGE( "DescriptorPoolAllocator: failed to allocate descriptor set" );
+    return allocation;
+}
+
+void DescriptorPoolAllocator::Free( std::span<const Allocation> allocations )
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    for (const auto& allocation : allocations)
+    {
+        if (allocation.Set != VK_NULL_HANDLE && allocation.PoolSlot.IsValid())
+            m_Buckets.Retire( allocation.PoolSlot, allocation.Set, allocation.NumDescriptors );
+    }
+}
+
+void DescriptorPoolAllocator::NextFrame( uint32_t framesInFlight )
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    FreeRetired( m_Buckets.NextFrame( framesInFlight ) );
+    // Empty pools have no sets left for the gpu to be using.
+    for (const DescriptorPoolBuckets::Slot slot : m_Buckets.TakeReleasedPools())
+    {
+        VkDescriptorPool& pool = m_Pools[slot.Bucket][slot.Pool];
+        if (pool != VK_NULL_HANDLE)
+            vkDestroyDescriptorPool( m_Vulkan.m_VulkanDevice, pool, nullptr );
+        pool = VK_NULL_HANDLE;
+    }
+}
+
+void DescriptorPoolAllocator::FreeRetired( std::span<const DescriptorPoolBuckets::RetiredSet> retired )
+{
+    if (retired.empty())
+        return;
+    // Group by pool so each pool gets a single vkFreeDescriptorSets.
+    std::vector<DescriptorPoolBuckets::RetiredSet> sorted( retired.begin(), retired.end() );
+    std::sort( sorted.begin(), sorted.end(), []( const auto& a, const auto& b ) { return a.PoolSlot.Bucket != b.PoolSlot.Bucket ? a.PoolSlot.Bucket < b.PoolSlot.Bucket : a.PoolSlot.Pool < b.PoolSlot.Pool; } );
+    std::vector<VkDescriptorSet> sets;
+    for (size_t first = 0; first < sorted.size(); )
+    {
+        const DescriptorPoolBuckets::Slot slot = sorted[first].PoolSlot;
+        sets.clear();
+        size_t last = first;
+        for (; last < sorted.size() && sorted[last].PoolSlot.Bucket == slot.Bucket && sorted[last].PoolSlot.Pool == slot.Pool; ++last)
+            sets.push_back( sorted[last].Set );
+        if (slot.Bucket < m_Pools.size() && slot.Pool < m_Pools[slot.Bucket].size() && m_Pools[slot.Bucket][slot.Pool] != VK_NULL_HANDLE)
+            vkFreeDescriptorSets( m_Vulkan.m_VulkanDevice, m_Pools[slot.Bucket][slot.Pool], (uint32_t) sets.size(), sets.data() );
+        first = last;
+    }
+}
+
+void DescriptorPoolAllocator::Destroy()
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    // Destroying the pools frees every set in them.
+    for (auto& bucketPools : m_Pools)
+    {
+        for (VkDescriptorPool pool : bucketPools)
+        {
+            if (pool != VK_NULL_HANDLE)
+                vkDestroyDescriptorPool( m_Vulkan.m_VulkanDevice, pool, nullptr );
+        }
+    }
+    m_Pools.clear();
+    m_Buckets.Clear();
+}
+
+DescriptorPoolBuckets::Stats DescriptorPoolAllocator::GetStats() const
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    return m_Buckets.GetStats();
+}
+
+void DescriptorPoolAllocator::LogStats() const
+{
+    const DescriptorPoolBuckets::Stats stats = GetStats();
+    LOGI( "Descriptor pools: %u pools in %u size classes, %u/%u sets used (%.1f%% unused), %u sets retired, %llu descriptors requested (%.1f%% size class rounding)",
+          stats.Pools, stats.Buckets, stats.SetsAllocated, stats.SetsCapacity, stats.Fragmentation() * 100.0f, stats.SetsRetired,
+          (unsigned long long) stats.DescriptorsRequested, stats.RoundingWaste() * 100.0f );
+}
@@ -0,0 +1,182 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+/// @file descriptorPoolAllocator.hpp
+/// Shared (growable) descriptor pools that descriptor sets are allocated from, rather than a VkDescriptorPool per material.
+/// @ingroup Vulkan
+
+#include <volk/volk.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Forward declarations
+class Vulkan;
+
+
+/// Bookkeeping (and policy) for the pools used by DescriptorPoolAllocator.  Makes no Vulkan calls.
+///
+/// Descriptor sets are put in to buckets by their 'size class' (the set's descriptor counts for each type rounded up to a power of two).
+/// Each pool in a bucket holds a fixed number of size class sized sets, so a pool can never run out of any descriptor type before it runs
+/// out of sets and freed sets leave holes that exactly fit the next allocation from the same bucket.
+/// The first pool in a bucket holds firstPoolSetCount sets, each subsequent pool doubles in size (up to maxPoolSetCount).
+/// Pools (other than the first in each bucket) that stay empty for releaseDelayFrames frames are released (see TakeReleasedPools), their
+/// slot is reused by the next pool the bucket needs.
+class DescriptorPoolBuckets
+{
+public:
+    /// Location of an allocated set (bucket and pool index).
+    struct Slot
+    {
+        uint32_t Bucket = UINT32_MAX;
+        uint32_t Pool = UINT32_MAX;
+        bool IsValid() const { return Bucket != UINT32_MAX; }
+    };
+
+    struct Stats
+    {
+        uint32_t Buckets = 0;
+        uint32_t Pools = 0;                 ///< pools currently created (not including released pools)
+        uint32_t SetsAllocated = 0;         ///< sets currently allocated (including retired sets not yet freed)
+        uint32_t SetsCapacity = 0;          ///< total sets the pools can hold
+        uint32_t SetsRetired = 0;           ///< sets waiting for the gpu to finish with them
+        uint64_t DescriptorsRequested = 0;  ///< descriptors needed by the allocated sets
+        uint64_t DescriptorsReserved = 0;   ///< descriptors reserved for the allocated sets (after size class rounding)
+        /// Fraction of the pool set capacity that is unused
+        float Fragmentation() const { return SetsCapacity ? 1.0f - float( SetsAllocated ) / float( SetsCapacity ) : 0.0f; }
+        /// Fraction of the reserved descriptors (of allocated sets) wasted by size class rounding
+        float RoundingWaste() const { return DescriptorsReserved ? 1.0f - float( DescriptorsRequested ) / float( DescriptorsReserved ) : 0.0f; }
+    };
+
+    /// A retired set that is now safe to free
+    struct RetiredSet
+    {
+        Slot            PoolSlot;
+        VkDescriptorSet Set;
+        uint32_t        NumDescriptors;
+    };
+
+    explicit DescriptorPoolBuckets( uint32_t firstPoolSetCount = 16, uint32_t maxPoolSetCount = 256, uint32_t releaseDelayFrames = 120 ) noexcept;
+
+    /// Merge the (per type) descriptor counts of a single set, sort by type and round each count up to a power of two.
+    static std::vector<VkDescriptorPoolSize> CalculateSizeClass( std::span<const VkDescriptorPoolSize> setPoolSizes );
+
+    /// Reserve space for one set.  If there is no pool in the bucket with space a new pool is added (possibly in the slot of a released pool) and
+    /// newPool is set, the caller should then create the VkDescriptorPool (using GetPoolSizes/GetPoolSetCount/GetPoolFlags).
+    Slot Allocate( std::span<const VkDescriptorPoolSize> setPoolSizes, VkDescriptorPoolCreateFlags poolFlags, bool& newPool );
+    /// Return the space used by a set (immediately).
+    /// @param numDescriptors total descriptors in the set (as passed to Allocate), for the stats
+    void Free( Slot slot, uint32_t numDescriptors );
+    /// Stop allocating from the given pool until sets are freed from it (eg the driver reported it as fragmented or out of memory).
+    void MarkPoolFull( Slot slot );
+
+    /// Queue a set to be freed once framesInFlight more frames have completed (see NextFrame).
+    void Retire( Slot slot, VkDescriptorSet set, uint32_t numDescriptors );
+    /// Advance the frame counter and return the retired sets that are now safe to free (their space is already returned to the pools).
+    /// Also releases pools that have been empty for the release delay (see TakeReleasedPools).
+    std::vector<RetiredSet> NextFrame( uint32_t framesInFlight );
+    /// Return the pools released since the last call, the caller should destroy their VkDescriptorPool (every set in them has been freed).
+    std::vector<Slot> TakeReleasedPools();
+    /// Return every retired set (and free its space) regardless of frame (eg when the device is idle).
+    std::vector<RetiredSet> TakeAllRetired();
+
+    uint32_t GetPoolSetCount( Slot slot ) const                             { return m_Buckets[slot.Bucket].Pools[slot.Pool].Capacity; }
+    VkDescriptorPoolCreateFlags GetPoolFlags( Slot slot ) const             { return m_Buckets[slot.Bucket].Flags; }
+    /// Pool sizes needed to create the VkDescriptorPool for the given slot's pool.
+    std::vector<VkDescriptorPoolSize> GetPoolSizes( Slot slot ) const;
+    /// Number of pool slots in the bucket (including released pools).
+    uint32_t GetNumPools( uint32_t bucket ) const                           { return (uint32_t) m_Buckets[bucket].Pools.size(); }
+    bool IsPoolReleased( Slot slot ) const                                  { return m_Buckets[slot.Bucket].Pools[slot.Pool].Capacity == 0; }
+    uint32_t GetNumBuckets() const                                          { return (uint32_t) m_Buckets.size(); }
+
+    Stats GetStats() const;
+    void Clear();
+
+    /// Total number of descriptors (of all types)
+    static uint32_t DescriptorCount( std::span<const VkDescriptorPoolSize> poolSizes );
+
+private:
+    struct Pool
+    {
+        uint32_t Capacity = 0;      ///< 0 once released
+        uint32_t Used = 0;
+        bool Full = false;          ///< MarkPoolFull was called
+        uint64_t EmptySinceFrame = UINT64_MAX;  ///< frame the pool was first seen empty (UINT64_MAX if in use)
+    };
+    struct Bucket
+    {
+        std::vector<VkDescriptorPoolSize>   SizeClass;
+        VkDescriptorPoolCreateFlags         Flags = 0;
+        uint32_t                            DescriptorsPerSet = 0;  ///< after size class rounding
+        std::vector<Pool>                   Pools;
+    };
+    struct Retired
+    {
+        RetiredSet  Set;
+        uint64_t    Frame;          ///< frame the set was retired on
+    };
+
+    const uint32_t                                                                      m_FirstPoolSetCount;
+    const uint32_t                                                                      m_MaxPoolSetCount;
+    const uint32_t                                                                      m_ReleaseDelayFrames;
+    std::vector<Bucket>                                                                 m_Buckets;
+    std::map<std::pair<VkDescriptorPoolCreateFlags, std::vector<std::pair<int, uint32_t>>>, uint32_t> m_BucketLookup;   ///< (flags, size class) to index in m_Buckets
+    std::vector<Retired>                                                                m_Retired;
+    std::vector<Slot>                                                                   m_ReleasedPools;    ///< released but not yet taken by TakeReleasedPools
+    uint64_t                                                                            m_Frame = 0;
+    uint64_t                                                                            m_DescriptorsRequested = 0;
+};
+
+
+/// Allocates descriptor sets from shared pools (see DescriptorPoolBuckets for the bucketing policy).
+/// Pools are created with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, freed sets are returned to their pool once the
+/// frames that may be using them have completed (Vulkan::SetNextBackBuffer calls NextFrame), pools left empty are destroyed.  Thread safe.
+class DescriptorPoolAllocator
+{
+    DescriptorPoolAllocator( const DescriptorPoolAllocator& ) = delete;
+    DescriptorPoolAllocator& operator=( const DescriptorPoolAllocator& ) = delete;
+public:
+    struct Allocation
+    {
+        VkDescriptorSet             Set = VK_NULL_HANDLE;
+        DescriptorPoolBuckets::Slot PoolSlot;
+        uint32_t                    NumDescriptors = 0; ///< total descriptors in the set layout
+    };
+
+    explicit DescriptorPoolAllocator( Vulkan& vulkan ) noexcept;
+    ~DescriptorPoolAllocator();
+
+    /// Allocate a descriptor set.
+    /// @param setPoolSizes number of descriptors (of each type) in the layout (see DescriptorSetLayout<Vulkan>::CalculatePoolSizes)
+    /// @param poolFlags flags needed on the pool (in addition to VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT), eg for update after bind layouts
+    /// @return allocation, Set is VK_NULL_HANDLE on failure
+    Allocation Allocate( VkDescriptorSetLayout layout, std::span<const VkDescriptorPoolSize> setPoolSizes, VkDescriptorPoolCreateFlags poolFlags = 0 );
+    /// Free the given sets once the gpu is done with them.
+    void Free( std::span<const Allocation> allocations );
+    /// Advance a frame, freeing any sets the gpu has finished using.
+    /// @param framesInFlight number of frames the gpu may be behind the cpu
+    void NextFrame( uint32_t framesInFlight );
+    /// Destroy all the pools (and every set allocated from them).
+    void Destroy();
+
+    DescriptorPoolBuckets::Stats GetStats() const;
+    /// Log the pool count and fragmentation (using LOGI)
+    void LogStats() const;
+
+private:
+    void FreeRetired( std::span<const DescriptorPoolBuckets::RetiredSet> retired );
+
+    Vulkan&                                     m_Vulkan;
+    mutable std::mutex                          m_Mutex;
+    DescriptorPoolBuckets                       m_Buckets;
+    std::vector<std::vector<VkDescriptorPool>>  m_Pools;        ///< [bucket][pool]
+};
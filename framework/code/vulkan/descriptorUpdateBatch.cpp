@@ -0,0 +1,299 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "descriptorUpdateBatch.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <unordered_set>
+
+
+void DescriptorUpdateBatch::Arena::Clear()
+{
+    Writes.clear();
+    ImageInfos.clear();
+    BufferInfos.clear();
+#if VK_KHR_acceleration_structure
+    AccelerationStructures.clear();
+#endif // VK_KHR_acceleration_structure
+}
+
+
+DescriptorUpdateBatch::PreparedWrites::PreparedWrites() noexcept = default;
+DescriptorUpdateBatch::PreparedWrites::PreparedWrites( PreparedWrites&& ) noexcept = default;
+DescriptorUpdateBatch::PreparedWrites& DescriptorUpdateBatch::PreparedWrites::operator=( PreparedWrites&& ) noexcept = default;
+DescriptorUpdateBatch::PreparedWrites::~PreparedWrites() = default;
+
+void DescriptorUpdateBatch::PreparedWrites::Clear()
+{
+    // Keeps the capacity of everything (so a reused PreparedWrites does not allocate).
+    Writes.clear();
+    NumQueued = 0;
+    NumSuperseded = 0;
+    NumRedundant = 0;
+    m_Arena.Clear();
+#if VK_KHR_acceleration_structure
+    m_AccelerationStructureWrites.clear();
+#endif // VK_KHR_acceleration_structure
+}
+
+
+DescriptorUpdateBatch::DescriptorUpdateBatch() noexcept
+{
+}
+
+DescriptorUpdateBatch::~DescriptorUpdateBatch()
+{
+}
+
+void DescriptorUpdateBatch::PushLocked( VkDescriptorSet set, uint32_t binding, uint32_t arrayElement, VkDescriptorType type, uint32_t count, InfoArray infos, uint32_t firstInfo )
+{
+    m_Queue.Writes.push_back( { set, binding, arrayElement, type, count, infos, firstInfo } );
+    m_NumUnapplied.fetch_add( 1, std::memory_order_release );
+    m_NumQueued.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void DescriptorUpdateBatch::QueueImageWrite( VkDescriptorSet set, uint32_t binding, uint32_t arrayElement, VkDescriptorType type, std::span<const VkDescriptorImageInfo> imageInfos )
+{
+    if (imageInfos.empty())
+        return;
+    std::lock_guard<std::mutex> lock( m_QueueMutex );
+    const uint32_t firstInfo = (uint32_t) m_Queue.ImageInfos.size();
+    m_Queue.ImageInfos.insert( m_Queue.ImageInfos.end(), imageInfos.begin(), imageInfos.end() );
+    PushLocked( set, binding, arrayElement, type, (uint32_t) imageInfos.size(), InfoArray::Image, firstInfo );
+}
+
+void DescriptorUpdateBatch::QueueBufferWrite( VkDescriptorSet set, uint32_t binding, uint32_t arrayElement, VkDescriptorType type, std::span<const VkDescriptorBufferInfo> bufferInfos )
+{
+    if (bufferInfos.empty())
+        return;
+    std::lock_guard<std::mutex> lock( m_QueueMutex );
+    const uint32_t firstInfo = (uint32_t) m_Queue.BufferInfos.size();
+    m_Queue.BufferInfos.insert( m_Queue.BufferInfos.end(), bufferInfos.begin(), bufferInfos.end() );
+    PushLocked( set, binding, arrayElement, type, (uint32_t) bufferInfos.size(), InfoArray::Buffer, firstInfo );
+}
+
+#if VK_KHR_acceleration_structure
+void DescriptorUpdateBatch::QueueAccelerationStructureWrite( VkDescriptorSet set, uint32_t binding, uint32_t arrayElement, std::span<const VkAccelerationStructureKHR> accelerationStructures )
+{
+    if (accelerationStructures.empty())
+        return;
+    std::lock_guard<std::mutex> lock( m_QueueMutex );
+    const uint32_t firstInfo = (uint32_t) m_Queue.AccelerationStructures.size();
+    m_Queue.AccelerationStructures.insert( m_Queue.AccelerationStructures.end(), accelerationStructures.begin(), accelerationStructures.end() );
+    PushLocked( set, binding, arrayElement, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, (uint32_t) accelerationStructures.size(), InfoArray::AccelerationStructure, firstInfo );
+}
+#endif // VK_KHR_acceleration_structure
+
+DescriptorUpdateBatch::PreparedWrites DescriptorUpdateBatch::Prepare()
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    PreparedWrites prepared;
+    PrepareLocked( prepared );
+    m_NumUnapplied.fetch_sub( (uint32_t) prepared.m_Arena.Writes.size(), std::memory_order_release );
+    return prepared;
+}
+
+bool DescriptorUpdateBatch::UpdateWritten( const QueuedWrite& write, const Arena& arena )
+{
+    // Raw bytes of the descriptor infos.
+    m_Contents.clear();
+#if VK_KHR_acceleration_structure
+    if (write.Infos == InfoArray::AccelerationStructure)
+        m_Contents.append( (const char*) &arena.AccelerationStructures[write.FirstInfo], write.Count * sizeof( VkAccelerationStructureKHR ) );
+    else
+#endif // VK_KHR_acceleration_structure
+    if (write.Infos == InfoArray::Image)
+    {
+        // Only compare the fields Vulkan reads for this descriptor type (the others may be uninitialized).
+        for (uint32_t i = 0; i < write.Count; ++i)
+        {
+            const VkDescriptorImageInfo& info = arena.ImageInfos[write.FirstInfo + i];
+            const VkSampler sampler = (write.Type == VK_DESCRIPTOR_TYPE_SAMPLER || write.Type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) ? info.sampler : VK_NULL_HANDLE;
+            const VkImageView imageView = (write.Type != VK_DESCRIPTOR_TYPE_SAMPLER) ? info.imageView : VK_NULL_HANDLE;
+            const VkImageLayout imageLayout = (write.Type != VK_DESCRIPTOR_TYPE_SAMPLER) ? info.imageLayout : VK_IMAGE_LAYOUT_UNDEFINED;
+            m_Contents.append( (const char*) &sampler, sizeof( sampler ) );
+            m_Contents.append( (const char*) &imageView, sizeof( imageView ) );
+            m_Contents.append( (const char*) &imageLayout, sizeof( imageLayout ) );
+        }
+    }
+    else
+        m_Contents.append( (const char*) &arena.BufferInfos[write.FirstInfo], write.Count * sizeof( VkDescriptorBufferInfo ) );
+
+    const WrittenKey key{ write.Set, write.Binding, write.ArrayElement };
+    auto it = m_Written.lower_bound( key );
+    // Tracked ranges in a binding never overlap, so only the range before this write can overlap its start...
+    if (it != m_Written.begin())
+    {
+        const auto prev = std::prev( it );
+        if (prev->first.Set == write.Set && prev->first.Binding == write.Binding && prev->first.ArrayElement + prev->second.Count > write.ArrayElement)
+            m_Written.erase( prev );
+    }
+    // ... and any range starting inside this write is overwritten by it (an exact match is checked for redundancy and reused).
+    bool redundant = false;
+    auto match = m_Written.end();
+    while (it != m_Written.end() && it->first.Set == write.Set && it->first.Binding == write.Binding && it->first.ArrayElement < write.ArrayElement + write.Count)
+    {
+        if (it->first.ArrayElement == write.ArrayElement && it->second.Count == write.Count)
+        {
+            redundant = it->second.Type == write.Type && it->second.Contents == m_Contents;
+            match = it++;
+        }
+        else
+            it = m_Written.erase( it );
+    }
+    if (match == m_Written.end())
+        match = m_Written.emplace_hint( it, key, WrittenDescriptors{ write.Count, write.Type, {} } );
+    match->second.Type = write.Type;
+    match->second.Contents.assign( m_Contents );   // reuses the tracked string's capacity
+    return redundant;
+}
+
+void DescriptorUpdateBatch::PrepareLocked( PreparedWrites& prepared )
+{
+    // Take the queued writes, giving the queue the (empty) arena prepared had last time so its capacity is reused.
+    prepared.Clear();
+    {
+        std::lock_guard<std::mutex> lock( m_QueueMutex );
+        std::swap( prepared.m_Arena, m_Queue );
+    }
+    const Arena& arena = prepared.m_Arena;
+    if (arena.Writes.empty())
+        return;
+
+    // Handle values may have been reused since the last flush, forget everything tracked.
+    const uint64_t resourceDestroyedEpoch = sm_ResourceDestroyedEpoch.load( std::memory_order_relaxed );
+    if (resourceDestroyedEpoch != m_WrittenEpoch)
+    {
+        m_Written.clear();
+        m_WrittenEpoch = resourceDestroyedEpoch;
+    }
+
+    // Find the last write to each exact set/binding/element range, earlier writes to the same range are superseded.
+    m_LastWriteToRange.clear();
+    for (size_t i = 0; i < arena.Writes.size(); ++i)
+    {
+        const QueuedWrite& write = arena.Writes[i];
+        if (write.Set == VK_NULL_HANDLE)
+            continue;   // forgotten
+        ++prepared.NumQueued;
+        m_LastWriteToRange[{ write.Set, write.Binding, write.ArrayElement, write.Count }] = i;
+    }
+
+    prepared.Writes.reserve( m_LastWriteToRange.size() );
+#if VK_KHR_acceleration_structure
+    // Written to while building the writes, which point in to it (so must not reallocate).
+    prepared.m_AccelerationStructureWrites.reserve( m_LastWriteToRange.size() );
+#endif // VK_KHR_acceleration_structure
+    for (size_t i = 0; i < arena.Writes.size(); ++i)
+    {
+        const QueuedWrite& write = arena.Writes[i];
+        if (write.Set == VK_NULL_HANDLE)
+            continue;
+        if (m_LastWriteToRange[{ write.Set, write.Binding, write.ArrayElement, write.Count }] != i)
+        {
+            ++prepared.NumSuperseded;
+            continue;
+        }
+
+        // Compare with (and update) what we last wrote to this range.
+        if (m_SkipRedundantWrites && UpdateWritten( write, arena ))
+        {
+            ++prepared.NumRedundant;
+            continue;
+        }
+
+        VkWriteDescriptorSet& vkWrite = prepared.Writes.emplace_back( VkWriteDescriptorSet{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET } );
+        vkWrite.dstSet = write.Set;
+        vkWrite.dstBinding = write.Binding;
+        vkWrite.dstArrayElement = write.ArrayElement;
+        vkWrite.descriptorCount = write.Count;
+        vkWrite.descriptorType = write.Type;
+#if VK_KHR_acceleration_structure
+        if (write.Infos == InfoArray::AccelerationStructure)
+        {
+            auto& accelerationStructureWrite = prepared.m_AccelerationStructureWrites.emplace_back( VkWriteDescriptorSetAccelerationStructureKHR{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR } );
+            accelerationStructureWrite.accelerationStructureCount = write.Count;
+            accelerationStructureWrite.pAccelerationStructures = &arena.AccelerationStructures[write.FirstInfo];
+            vkWrite.pNext = &accelerationStructureWrite;
+            continue;
+        }
+#endif // VK_KHR_acceleration_structure
+        if (write.Infos == InfoArray::Image)
+            vkWrite.pImageInfo = &arena.ImageInfos[write.FirstInfo];
+        else
+            vkWrite.pBufferInfo = &arena.BufferInfos[write.FirstInfo];
+    }
+
+    m_Stats.Superseded += prepared.NumSuperseded;
+    m_Stats.Redundant += prepared.NumRedundant;
+}
+
+uint32_t DescriptorUpdateBatch::Flush( VkDevice device )
+{
+    // Nothing queued, and no other Flush is part way through applying writes this thread may have queued.
+    if (m_NumUnapplied.load( std::memory_order_acquire ) == 0)
+        return 0;
+
+    // Hold the lock while the writes are applied, so a Flush on another thread cannot return before writes it was expecting to be applied (but were taken by this Flush) are done.
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    PrepareLocked( m_Prepared );
+    const uint32_t numApplied = (uint32_t) m_Prepared.Writes.size();
+    if (numApplied > 0)
+    {
+        vkUpdateDescriptorSets( device, numApplied, m_Prepared.Writes.data(), 0, nullptr );
+        m_Stats.Applied += numApplied;
+        ++m_Stats.Flushes;
+    }
+    m_NumUnapplied.fetch_sub( (uint32_t) m_Prepared.m_Arena.Writes.size(), std::memory_order_release );
+    return numApplied;
+}
+
+void DescriptorUpdateBatch::ForgetDescriptorSets( std::span<const VkDescriptorSet> sets )
+{
+    if (sets.empty())
+        return;
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    {
+        // Queued writes to the sets are left in the arena but marked as dropped.
+        const std::unordered_set<VkDescriptorSet> forget( sets.begin(), sets.end() );
+        std::lock_guard<std::mutex> queueLock( m_QueueMutex );
+        for (auto& write : m_Queue.Writes)
+            if (forget.contains( write.Set ))
+                write.Set = VK_NULL_HANDLE;
+    }
+    for (const VkDescriptorSet set : sets)
+    {
+        auto it = m_Written.lower_bound( { set, 0, 0 } );
+        while (it != m_Written.end() && it->first.Set == set)
+            it = m_Written.erase( it );
+    }
+}
+
+void DescriptorUpdateBatch::InvalidateCache()
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    m_Written.clear();
+}
+
+void DescriptorUpdateBatch::SetSkipRedundantWrites( bool skip )
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    // Contents are only tracked while skipping is enabled, anything tracked before it was last disabled may be stale.
+    if (skip != m_SkipRedundantWrites)
+        m_Written.clear();
+    m_SkipRedundantWrites = skip;
+}
+
+DescriptorUpdateBatch::Stats DescriptorUpdateBatch::GetStats() const
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    Stats stats = m_Stats;
+    stats.Queued = m_NumQueued.load( std::memory_order_relaxed );
+    return stats;
+}
@@ -0,0 +1,175 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+/// @file descriptorUpdateBatch.hpp
+/// Batching of descriptor set writes in to (as few as possible) vkUpdateDescriptorSets calls.
+/// @ingroup Vulkan
+
+#include <volk/volk.h>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+/// Collects descriptor set writes (from any thread) and applies them with a single vkUpdateDescriptorSets call.
+///
+/// Queued writes (and the descriptor infos they point to) are appended to an arena that is reused from flush to flush, so once the
+/// arena has grown to the size of a typical frame's writes queuing does no allocations (only takes a short lock to append).
+/// Flush takes everything queued so far, drops writes that are superseded (a later write in the same flush to exactly the same
+/// set/binding/elements) and applies the rest.
+///
+/// Writes that are redundant across flushes (same resources as the last write flushed to those elements) are also dropped (SetSkipRedundantWrites, on by default).
+/// Redundancy is detected from the Vulkan handle values, which the driver may reuse once a resource is destroyed, so every destroy of a resource that
+/// can be bound to a descriptor (buffers, images, image views, samplers, acceleration structures) must call NotifyResourceDestroyed (the framework's
+/// destroy paths do) which makes the next flush forget everything it has tracked.
+/// Redundancy tracking assumes writes stay within their binding; disable skipping if relying on writes spilling in to the following bindings.
+class DescriptorUpdateBatch
+{
+    DescriptorUpdateBatch( const DescriptorUpdateBatch& ) = delete;
+    DescriptorUpdateBatch& operator=( const DescriptorUpdateBatch& ) = delete;
+    enum class InfoArray : uint32_t { Image, Buffer, AccelerationStructure };
+    struct QueuedWrite
+    {
+        VkDescriptorSet     Set;        ///< VK_NULL_HANDLE if dropped by ForgetDescriptorSets
+        uint32_t            Binding;
+        uint32_t            ArrayElement;
+        VkDescriptorType    Type;
+        uint32_t            Count;
+        InfoArray           Infos;      ///< Arena array holding the descriptor infos
+        uint32_t            FirstInfo;  ///< index of the first descriptor info in that array
+    };
+    struct Arena
+    {
+        std::vector<QueuedWrite>                Writes;
+        std::vector<VkDescriptorImageInfo>      ImageInfos;
+        std::vector<VkDescriptorBufferInfo>     BufferInfos;
+#if VK_KHR_acceleration_structure
+        std::vector<VkAccelerationStructureKHR> AccelerationStructures;
+#endif // VK_KHR_acceleration_structure
+        void Clear();
+    };
+public:
+    DescriptorUpdateBatch() noexcept;
+    ~DescriptorUpdateBatch();
+
+    /// Queue a write of image (or combined image sampler, or sampler) descriptors.  Thread safe.
+    void QueueImageWrite( VkDescriptorSet set, uint32_t binding, uint32_t arrayElement, VkDescriptorType type, std::span<const VkDescriptorImageInfo> imageInfos );
+    /// Queue a write of buffer descriptors.  Thread safe.
+    void QueueBufferWrite( VkDescriptorSet set, uint32_t binding, uint32_t arrayElement, VkDescriptorType type, std::span<const VkDescriptorBufferInfo> bufferInfos );
+#if VK_KHR_acceleration_structure
+    /// Queue a write of acceleration structure descriptors.  Thread safe.
+    void QueueAccelerationStructureWrite( VkDescriptorSet set, uint32_t binding, uint32_t arrayElement, std::span<const VkAccelerationStructureKHR> accelerationStructures );
+#endif // VK_KHR_acceleration_structure
+
+    /// Writes ready to be passed to vkUpdateDescriptorSets.  Owns the descriptor info storage the writes point to.
+    class PreparedWrites
+    {
+        friend class DescriptorUpdateBatch;
+    public:
+        PreparedWrites() noexcept;
+        PreparedWrites( PreparedWrites&& ) noexcept;
+        PreparedWrites& operator=( PreparedWrites&& ) noexcept;
+        ~PreparedWrites();
+        std::vector<VkWriteDescriptorSet>   Writes;
+        uint32_t                            NumQueued = 0;      ///< number of writes that were queued
+        uint32_t                            NumSuperseded = 0;  ///< number of queued writes dropped because a later write replaced them
+        uint32_t                            NumRedundant = 0;   ///< number of queued writes dropped because the descriptors already contained the same resources
+    private:
+        void Clear();
+        Arena                               m_Arena;
+#if VK_KHR_acceleration_structure
+        std::vector<VkWriteDescriptorSetAccelerationStructureKHR> m_AccelerationStructureWrites;
+#endif // VK_KHR_acceleration_structure
+    };
+
+    /// Take all the queued writes and prepare them for vkUpdateDescriptorSets (without calling it).
+    /// Updates the redundancy tracking, so assumes the returned writes will be applied.
+    PreparedWrites Prepare();
+
+    /// Apply (with a single vkUpdateDescriptorSets) all the writes queued so far.  Thread safe, on return every write queued
+    /// by the calling thread before the call has been applied (possibly by a Flush on another thread).
+    /// Returns immediately (without locking) when there is nothing queued or being applied.
+    /// @return number of VkWriteDescriptorSet applied
+    uint32_t Flush( VkDevice device );
+
+    /// Stop tracking the given descriptor sets (eg they are about to be freed) and drop any queued (not yet flushed) writes to them.
+    void ForgetDescriptorSets( std::span<const VkDescriptorSet> sets );
+    /// Forget the contents of every descriptor set (next write to each descriptor will not be treated as redundant).
+    void InvalidateCache();
+    /// Enable/disable dropping of writes that are redundant with previous flushes (on by default, see class notes).  Superseded writes are always dropped.
+    void SetSkipRedundantWrites( bool skip );
+
+    /// Must be called whenever a resource that may be referenced by a descriptor is destroyed (its handle value may be reused by a new resource).
+    /// Invalidates the redundancy tracking of every DescriptorUpdateBatch (on their next flush).  Thread safe.
+    static void NotifyResourceDestroyed() noexcept { sm_ResourceDestroyedEpoch.fetch_add( 1, std::memory_order_relaxed ); }
+
+    struct Stats
+    {
+        uint64_t Queued = 0;
+        uint64_t Applied = 0;
+        uint64_t Superseded = 0;
+        uint64_t Redundant = 0;
+        uint64_t Flushes = 0;       ///< number of vkUpdateDescriptorSets calls
+    };
+    Stats GetStats() const;
+
+private:
+    /// Append a write to m_Queue (infos must already have been appended to the matching m_Queue array).  m_QueueMutex must be held.
+    void PushLocked( VkDescriptorSet set, uint32_t binding, uint32_t arrayElement, VkDescriptorType type, uint32_t count, InfoArray infos, uint32_t firstInfo );
+    /// Take everything queued and fill prepared with the writes to apply.  m_Mutex must be held.
+    void PrepareLocked( PreparedWrites& prepared );
+    /// True if the write is redundant with the tracked contents (and updates the tracking).  m_Mutex must be held.
+    bool UpdateWritten( const QueuedWrite& write, const Arena& arena );
+
+    struct WrittenKey
+    {
+        VkDescriptorSet     Set;
+        uint32_t            Binding;
+        uint32_t            ArrayElement;
+        bool operator<( const WrittenKey& other ) const { return Set != other.Set ? Set < other.Set : (Binding != other.Binding ? Binding < other.Binding : ArrayElement < other.ArrayElement); }
+    };
+    struct WrittenDescriptors
+    {
+        uint32_t            Count;
+        VkDescriptorType    Type;
+        std::string         Contents;   ///< raw bytes of the descriptor infos last written
+    };
+    struct RangeKey
+    {
+        VkDescriptorSet Set;
+        uint32_t Binding;
+        uint32_t ArrayElement;
+        uint32_t Count;
+        bool operator==( const RangeKey& ) const = default;
+    };
+    struct RangeKeyHash
+    {
+        size_t operator()( const RangeKey& k ) const { return std::hash<VkDescriptorSet>()(k.Set) ^ size_t( (uint64_t( k.Binding ) * 0x9E3779B97F4A7C15ull) ^ (uint64_t( k.ArrayElement ) << 20) ^ (uint64_t( k.Count ) << 40) ); }
+    };
+
+    static inline std::atomic<uint64_t>                                         sm_ResourceDestroyedEpoch{ 0 };
+
+    std::mutex                                                                  m_QueueMutex;       ///< protects m_Queue
+    Arena                                                                       m_Queue;            ///< writes queued since the last flush (capacity reused from flush to flush)
+    std::atomic<uint32_t>                                                       m_NumUnapplied{ 0 };///< writes queued but not yet applied (or dropped) by a flush
+    mutable std::mutex                                                          m_Mutex;            ///< serializes Prepare/Flush/Forget (and protects everything below)
+    PreparedWrites                                                              m_Prepared;         ///< reused by Flush
+    std::unordered_map<RangeKey, size_t, RangeKeyHash>                          m_LastWriteToRange; ///< scratch for finding superseded writes
+    std::map<WrittenKey, WrittenDescriptors>                                    m_Written;          ///< last flushed contents of each tracked range (ranges in a binding never overlap)
+    std::string                                                                 m_Contents;         ///< scratch for the contents of the write being checked
+    uint64_t                                                                    m_WrittenEpoch = 0; ///< sm_ResourceDestroyedEpoch when m_Written was last valid
+    bool                                                                        m_SkipRedundantWrites = true;
+    Stats                                                                       m_Stats;            ///< all except Queued
+    std::atomic<uint64_t>                                                       m_NumQueued{ 0 };
+};
@@ -401,6 +401,26 @@ namespace ExtensionLib
 
 #endif // Ext_VK_EXT_debug_marker
 
+#if VK_EXT_calibrated_timestamps
+
+    struct Ext_VK_EXT_calibrated_timestamps : public VulkanFunctionPointerExtensionHelper<VulkanExtensionType::eDevice>
+    {
+        static constexpr auto Name = VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+        explicit Ext_VK_EXT_calibrated_timestamps( VulkanExtensionStatus status = VulkanExtensionStatus::eRequired ) : VulkanFunctionPointerExtensionHelper( Name, status ) {}
+        void LookupFunctionPointers( VkInstance vkInstance ) override
+        {
+            m_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT = (PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT) vkGetInstanceProcAddr( vkInstance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT" );
+        }
+        void LookupFunctionPointers( VkDevice vkDevice, PFN_vkGetDeviceProcAddr fpGetDeviceProcAddr ) override
+        {
+            m_vkGetCalibratedTimestampsEXT = (PFN_vkGetCalibratedTimestampsEXT) fpGetDeviceProcAddr( vkDevice, "vkGetCalibratedTimestampsEXT" );
+        }
+        PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT m_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT = nullptr;
+        PFN_vkGetCalibratedTimestampsEXT                   m_vkGetCalibratedTimestampsEXT = nullptr;
+    };
+
+#endif // VK_EXT_calibrated_timestamps
+
 #if VK_EXT_subgroup_size_control
 
     struct Ext_VK_EXT_subgroup_size_control : public VulkanDeviceFeaturePropertiesExtensionHelper<
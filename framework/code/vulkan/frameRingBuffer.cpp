@@ -0,0 +1,226 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameRingBuffer.hpp"
+#include "descriptorUpdateBatch.hpp"
+#include "vulkan.hpp"
+#include "memory/vulkan/memoryManager.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------
+// FrameRingBuffer::Fence
+//-----------------------------------------------------------------------------
+
+bool FrameRingBuffer::Fence::IsSignalled() const
+{
+    return Handle == VK_NULL_HANDLE || vkGetFenceStatus( Device, Handle ) == VK_SUCCESS;
+}
+
+void FrameRingBuffer::Fence::Wait() const
+{
+    if (Handle != VK_NULL_HANDLE)
+        CheckVkError( "vkWaitForFences()", vkWaitForFences( Device, 1, &Handle, VK_TRUE, UINT64_MAX ) );
+}
+
+
+//-----------------------------------------------------------------------------
+// FrameRingBuffer
+//-----------------------------------------------------------------------------
+
+FrameRingBuffer::FrameRingBuffer( Vulkan& vulkan ) noexcept : m_Vulkan( vulkan )
+{
+}
+
+FrameRingBuffer::~FrameRingBuffer()
+{
+    assert( m_DescriptorPool == VK_NULL_HANDLE && "call Destroy" );
+}
+
+bool FrameRingBuffer::Initialize( const Config& config )
+{
+    assert( m_DescriptorPool == VK_NULL_HANDLE );
+    const auto& limits = m_Vulkan.GetGpuProperties().Base.properties.limits;
+    m_Config = config;
+    m_Config.Size = (config.Size + cMaxAlignment - 1) & ~(cMaxAlignment - 1);
+    m_Config.UniformRange = std::min( config.UniformRange, limits.maxUniformBufferRange );
+    m_Config.StorageRange = std::min( config.StorageRange, limits.maxStorageBufferRange );
+    m_UniformAlignment = std::max( (size_t) limits.minUniformBufferOffsetAlignment, size_t( 1 ) );
+    m_StorageAlignment = std::max( (size_t) limits.minStorageBufferOffsetAlignment, size_t( 1 ) );
+    if (m_Config.Size == 0 || m_Config.UniformRange == 0 || m_UniformAlignment > cMaxAlignment || m_StorageAlignment > cMaxAlignment)
+    {
+        LOGE( "FrameRingBuffer: invalid configuration" );
+        return false;
+    }
+    m_Allocator.Reset( m_Config.Size );
+
+    // Buffer is over-allocated by the largest descriptor range, so a descriptor range starting at any dynamic offset in the ring is in bounds.
+    const size_t bufferSize = m_Config.Size + std::max( m_Config.UniformRange, m_Config.StorageRange );
+    m_Buffer = m_Vulkan.GetMemoryManager().CreateBuffer( bufferSize, BufferUsageFlags::Uniform | BufferUsageFlags::Storage | BufferUsageFlags::Vertex | BufferUsageFlags::Index, MemoryUsage::CpuToGpu );
+    if (!m_Buffer)
+    {
+        LOGE( "FrameRingBuffer: failed to create buffer (%zu bytes)", bufferSize );
+        Destroy();
+        return false;
+    }
+    m_Mapped.emplace( m_Vulkan.GetMemoryManager().Map<uint8_t>( m_Buffer ) );
+    if (m_Mapped->data() == nullptr)
+    {
+        LOGE( "FrameRingBuffer: failed to map buffer" );
+        Destroy();
+        return false;
+    }
+
+    std::vector<VkDescriptorSetLayoutBinding> layoutBindings{ { cUniformBinding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, m_Config.Stages, nullptr } };
+    std::vector<VkDescriptorPoolSize> poolSizes{ { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 } };
+    if (m_Config.StorageRange > 0)
+    {
+        layoutBindings.push_back( { cStorageBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1, m_Config.Stages, nullptr } );
+        poolSizes.push_back( { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1 } );
+    }
+    VkDescriptorSetLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    layoutInfo.bindingCount = (uint32_t) layoutBindings.size();
+    layoutInfo.pBindings = layoutBindings.data();
+    if (VK_SUCCESS != vkCreateDescriptorSetLayout( m_Vulkan.m_VulkanDevice, &layoutInfo, nullptr, &m_DescriptorSetLayout ))
+    {
+        LOGE( "FrameRingBuffer: failed to create descriptor set layout" );
+        Destroy();
+        return false;
+    }
+
+    // The descriptor set never changes (only the dynamic offsets it is bound with), so one set serves every frame.
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = (uint32_t) poolSizes.size();
+    poolInfo.pPoolSizes = poolSizes.data();
+    if (VK_SUCCESS != vkCreateDescriptorPool( m_Vulkan.m_VulkanDevice, &poolInfo, nullptr, &m_DescriptorPool ))
+    {
+        LOGE( "FrameRingBuffer: failed to create descriptor pool" );
+        Destroy();
+        return false;
+    }
+    VkDescriptorSetAllocateInfo allocateInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocateInfo.descriptorPool = m_DescriptorPool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &m_DescriptorSetLayout;
+    if (VK_SUCCESS != vkAllocateDescriptorSets( m_Vulkan.m_VulkanDevice, &allocateInfo, &m_DescriptorSet ))
+    {
+        LOGE( "FrameRingBuffer: failed to allocate descriptor set" );
+        Destroy();
+        return false;
+    }
+
+    auto& updateBatch = m_Vulkan.GetDescriptorUpdateBatch();
+    const VkDescriptorBufferInfo uniformBufferInfo{ m_Buffer.GetVkBuffer(), 0, m_Config.UniformRange };
+    updateBatch.QueueBufferWrite( m_DescriptorSet, cUniformBinding, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, { &uniformBufferInfo, 1 } );
+    const VkDescriptorBufferInfo storageBufferInfo{ m_Buffer.GetVkBuffer(), 0, m_Config.StorageRange };
+    if (m_Config.StorageRange > 0)
+        updateBatch.QueueBufferWrite( m_DescriptorSet, cStorageBinding, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, { &storageBufferInfo, 1 } );
+
+    LOGI( "FrameRingBuffer: %zu bytes, uniform range %u, storage range %u", m_Config.Size, m_Config.UniformRange, m_Config.StorageRange );
+    return true;
+}
+
+void FrameRingBuffer::Destroy()
+{
+    if (m_DescriptorSet != VK_NULL_HANDLE)
+    {
+        m_Vulkan.GetDescriptorUpdateBatch().ForgetDescriptorSets( { &m_DescriptorSet, 1 } );
+        m_DescriptorSet = VK_NULL_HANDLE;
+    }
+    if (m_DescriptorPool != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorPool( m_Vulkan.m_VulkanDevice, m_DescriptorPool, nullptr );
+        m_DescriptorPool = VK_NULL_HANDLE;
+    }
+    if (m_DescriptorSetLayout != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorSetLayout( m_Vulkan.m_VulkanDevice, m_DescriptorSetLayout, nullptr );
+        m_DescriptorSetLayout = VK_NULL_HANDLE;
+    }
+    auto& memoryManager = m_Vulkan.GetMemoryManager();
+    if (m_Mapped.has_value())
+    {
+        if (m_Mapped->data() != nullptr)
+            memoryManager.Unmap( m_Buffer, std::move( *m_Mapped ) );
+        m_Mapped.reset();
+    }
+    if (m_Buffer)
+        memoryManager.Destroy( std::move( m_Buffer ) );
+    m_Allocator.Reset( 0 );
+}
+
+void FrameRingBuffer::BeginFrame( uint32_t bufferIdx, VkFence frameFence )
+{
+    m_Allocator.BeginFrame( bufferIdx, Fence{ m_Vulkan.m_VulkanDevice, frameFence } );
+}
+
+FrameRingBuffer::Allocation FrameRingBuffer::Allocate( size_t size, size_t alignment )
+{
+    if (!m_Mapped.has_value())
+        return {};
+    const size_t offset = m_Allocator.Allocate( size, std::max( alignment, size_t( 1 ) ) );
+    if (offset == FrameRingAllocator<Fence>::cInvalidOffset)
+    {
+        LOGE( "FrameRingBuffer: failed to allocate %zu bytes (%zu of %zu used this frame)", size, m_Allocator.GetFrameUsed(), m_Allocator.GetCapacity() );
+        return {};
+    }
+    return { m_Buffer.GetVkBuffer(), (uint32_t) offset, (uint32_t) size, m_Mapped->data() + offset };
+}
+
+FrameRingBuffer::Allocation FrameRingBuffer::AllocateUniform( size_t size )
+{
+    if (size > m_Config.UniformRange)
+    {
+        LOGE( "FrameRingBuffer: uniform allocation of %zu bytes is larger than the uniform range (%u bytes)", size, m_Config.UniformRange );
+        return {};
+    }
+    return Allocate( size, m_UniformAlignment );
+}
+
+FrameRingBuffer::Allocation FrameRingBuffer::AllocateStorage( size_t size )
+{
+    if (m_Config.StorageRange > 0 && size > m_Config.StorageRange)
+    {
+        LOGE( "FrameRingBuffer: storage allocation of %zu bytes is larger than the storage range (%u bytes)", size, m_Config.StorageRange );
+        return {};
+    }
+    return Allocate( size, m_StorageAlignment );
+}
+
+bool FrameRingBuffer::FlushMapped()
+{
+    if (!m_Mapped.has_value())
+        return true;
+    bool success = true;
+    auto& memoryManager = m_Vulkan.GetMemoryManager();
+    m_Allocator.TakeUnflushedRanges( [&]( size_t offset, size_t size ) {
+        success &= memoryManager.FlushMapped( *m_Mapped, offset, size );
+    } );
+    if (!success)
+        LOGE( "FrameRingBuffer: failed to flush mapped memory" );
+    return success;
+}
+
+void FrameRingBuffer::Bind( VkCommandBuffer cmdBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t setIndex, uint32_t uniformOffset, uint32_t storageOffset ) const
+{
+    // Dynamic offsets are in binding order.
+    const uint32_t dynamicOffsets[2] = { uniformOffset, storageOffset };
+    m_Vulkan.FlushDescriptorUpdates();
+    vkCmdBindDescriptorSets( cmdBuffer, bindPoint, pipelineLayout, setIndex, 1, &m_DescriptorSet, m_Config.StorageRange > 0 ? 2 : 1, dynamicOffsets );
+}
+
+void FrameRingBuffer::LogStats()
+{
+    const auto& stats = m_Allocator.GetStats();
+    LOGI( "FrameRingBuffer: %u allocations (%zu bytes), %u failed, %u fence waits, peak %zu of %zu bytes", stats.Allocations, stats.BytesAllocated, stats.FailedAllocations, stats.FenceWaits, stats.PeakUsed, m_Allocator.GetCapacity() );
+    m_Allocator.ResetStats();
+}
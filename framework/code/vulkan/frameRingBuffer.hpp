@@ -0,0 +1,281 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+/// @file frameRingBuffer.hpp
+/// Persistently mapped ring buffer for per-frame (uniform, instance and other dynamic) data.
+/// @ingroup Vulkan
+
+#include <volk/volk.h>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <type_traits>
+#include "memory/vulkan/memoryMapped.hpp"
+
+// Forward declarations
+class Vulkan;
+
+
+/// Ring sub-allocator, with allocations grouped in to frames that are released once the gpu has finished with them.
+/// Makes no Vulkan calls.  T_FENCE identifies a frame's gpu work, it needs
+///     bool IsSignalled() const    - true once the gpu has finished the frame
+///     void Wait() const           - block until IsSignalled
+/// Offsets are tracked unwrapped (monotonically increasing), so 'used' is simply head - tail.
+template<typename T_FENCE>
+class FrameRingAllocator
+{
+public:
+    static constexpr size_t cInvalidOffset = SIZE_MAX;
+
+    struct Stats
+    {
+        uint32_t Allocations = 0;
+        uint32_t FailedAllocations = 0;
+        uint32_t FenceWaits = 0;        ///< times Allocate had to block on an in-flight frame
+        size_t   BytesAllocated = 0;    ///< including alignment padding and space skipped at the end of the ring
+        size_t   PeakUsed = 0;          ///< most bytes in use (in flight plus the current frame)
+    };
+
+    explicit FrameRingAllocator( size_t capacity = 0 ) noexcept     { Reset( capacity ); }
+
+    /// Release everything (without waiting on any fences) and change the capacity.
+    void Reset( size_t capacity )
+    {
+        m_Capacity = capacity;
+        m_Head = m_Tail = m_FrameBegin = m_FlushedHead = 0;
+        m_InFlight.clear();
+        m_FrameFence.reset();
+        m_Stats = {};
+    }
+
+    /// Start a new frame.  Closes the current frame (its allocations stay live until its fence is signalled).
+    /// Allocations made before the first BeginFrame become part of the first frame.
+    /// @param frameIdx buffer index of the new frame.  The caller guarantees the gpu has finished the previous frame with this index (eg Vulkan::SetNextBackBuffer has waited on its fence), so it (and every older frame) is released without querying fences.
+    /// @param fence signalled when the gpu has finished the new frame
+    void BeginFrame( uint32_t frameIdx, T_FENCE fence )
+    {
+        if (m_FrameFence.has_value())
+        {
+            m_InFlight.push_back( { m_FrameBegin, m_Head, m_FrameIdx, std::move( *m_FrameFence ) } );
+            m_FrameBegin = m_Head;
+        }
+        auto completed = std::find_if( m_InFlight.rbegin(), m_InFlight.rend(), [frameIdx]( const Frame& frame ) { return frame.FrameIdx == frameIdx; } );
+        m_InFlight.erase( m_InFlight.begin(), completed.base() );
+        while (!m_InFlight.empty() && m_InFlight.front().Fence.IsSignalled())
+            m_InFlight.pop_front();
+        UpdateTail();
+        m_FrameIdx = frameIdx;
+        m_FrameFence.emplace( std::move( fence ) );
+    }
+
+    /// Allocate from the current frame.
+    /// @param alignment power of 2, capacity must be a multiple of it
+    /// @param allowWait if the ring is full block on the oldest in flight frame, otherwise fail
+    /// @return offset in to the ring, cInvalidOffset if there is no space
+    size_t Allocate( size_t size, size_t alignment, bool allowWait = true )
+    {
+        assert( alignment != 0 && (alignment & (alignment - 1)) == 0 );
+        assert( m_Capacity % alignment == 0 );
+        if (size == 0 || size > m_Capacity)
+        {
+            ++m_Stats.FailedAllocations;
+            return cInvalidOffset;
+        }
+        for (;;)
+        {
+            uint64_t begin = (m_Head + alignment - 1) & ~uint64_t( alignment - 1 );
+            if ((begin % m_Capacity) + size > m_Capacity)
+                begin = (begin / m_Capacity + 1) * m_Capacity;  // does not fit before the end, skip to the start of the ring
+            if (begin + size - m_Tail <= m_Capacity)
+            {
+                ++m_Stats.Allocations;
+                m_Stats.BytesAllocated += size_t( begin + size - m_Head );
+                m_Head = begin + size;
+                m_Stats.PeakUsed = std::max( m_Stats.PeakUsed, GetUsed() );
+                return size_t( begin % m_Capacity );
+            }
+            // Full, release the oldest in flight frame (if we can).
+            if (m_InFlight.empty())
+            {
+                ++m_Stats.FailedAllocations;
+                return cInvalidOffset;  // current frame alone has filled the ring
+            }
+            if (!m_InFlight.front().Fence.IsSignalled())
+            {
+                if (!allowWait)
+                {
+                    ++m_Stats.FailedAllocations;
+                    return cInvalidOffset;
+                }
+                m_InFlight.front().Fence.Wait();
+                ++m_Stats.FenceWaits;
+            }
+            m_InFlight.pop_front();
+            UpdateTail();
+        }
+    }
+
+    /// Call fn( offset, size ) for the ring ranges allocated since the last call (two ranges if they wrap past the end of the ring),
+    /// eg to flush cpu writes to memory that is not host coherent.  Ranges include alignment padding.
+    template<typename T_FN>
+    void TakeUnflushedRanges( const T_FN& fn )
+    {
+        // Space released since the last call does not need flushing.
+        const uint64_t begin = std::max( m_FlushedHead, m_Tail );
+        m_FlushedHead = m_Head;
+        if (begin >= m_Head)
+            return;
+        const size_t offset = size_t( begin % m_Capacity );
+        const size_t size = size_t( m_Head - begin );
+        if (offset + size <= m_Capacity)
+            fn( offset, size );
+        else
+        {
+            fn( offset, m_Capacity - offset );
+            fn( size_t( 0 ), offset + size - m_Capacity );
+        }
+    }
+
+    size_t GetCapacity() const                  { return m_Capacity; }
+    /// Bytes in use by in flight frames and the current frame
+    size_t GetUsed() const                      { return size_t( m_Head - m_Tail ); }
+    /// Bytes allocated by the current frame
+    size_t GetFrameUsed() const                 { return size_t( m_Head - m_FrameBegin ); }
+    uint32_t GetNumFramesInFlight() const       { return (uint32_t) m_InFlight.size(); }
+    const Stats& GetStats() const               { return m_Stats; }
+    void ResetStats()                           { m_Stats = {}; }
+
+private:
+    struct Frame
+    {
+        uint64_t    Begin;
+        uint64_t    End;
+        uint32_t    FrameIdx;
+        T_FENCE     Fence;
+    };
+
+    void UpdateTail()                           { m_Tail = m_InFlight.empty() ? m_FrameBegin : m_InFlight.front().Begin; }
+
+    size_t                  m_Capacity = 0;
+    uint64_t                m_Head = 0;         ///< next free byte (unwrapped)
+    uint64_t                m_Tail = 0;         ///< oldest live byte (unwrapped)
+    uint64_t                m_FrameBegin = 0;   ///< first byte of the current frame (unwrapped)
+    uint64_t                m_FlushedHead = 0;  ///< m_Head at the last TakeUnflushedRanges (unwrapped)
+    uint32_t                m_FrameIdx = 0;
+    std::optional<T_FENCE>  m_FrameFence;       ///< fence of the current frame (empty before the first BeginFrame)
+    std::deque<Frame>       m_InFlight;         ///< oldest first
+    Stats                   m_Stats;
+};
+
+
+/// Persistently mapped, per-frame ring buffer for dynamic data (uniforms, instance data etc).
+///
+/// Replaces a buffer (and descriptor set) per uniform per frame with sub-allocations from one buffer, referenced with dynamic offsets:
+///   binding 0 - VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC (Config::UniformRange bytes visible from the dynamic offset)
+///   binding 1 - VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC (only if Config::StorageRange is non zero)
+/// The buffer can also be bound directly (eg as a vertex buffer) with Allocation::Buffer/Offset.
+///
+/// Opt-in, created by Vulkan::CreateFrameRingBuffer.  Space is reused once the fence of the frame that allocated it (from Vulkan::SetNextBackBuffer) has signalled.
+/// The memory may not be host coherent, Vulkan::QueueSubmit calls FlushMapped so writes are visible to the command buffers it submits.
+/// Not thread safe (which includes submitting with Vulkan::QueueSubmit while another thread allocates from the ring).
+class FrameRingBuffer
+{
+    FrameRingBuffer( const FrameRingBuffer& ) = delete;
+    FrameRingBuffer& operator=( const FrameRingBuffer& ) = delete;
+public:
+    struct Config
+    {
+        size_t      Size = 4 * 1024 * 1024;             ///< ring size (bytes), rounded up to cMaxAlignment
+        uint32_t    UniformRange = 64 * 1024;           ///< bytes addressable by the uniform buffer descriptor (clamped to maxUniformBufferRange)
+        uint32_t    StorageRange = 0;                   ///< bytes addressable by the storage buffer descriptor, 0 for no storage buffer binding
+        VkShaderStageFlags Stages = VK_SHADER_STAGE_ALL;
+    };
+
+    /// FrameRingAllocator fence for a Vulkan frame fence
+    struct Fence
+    {
+        VkDevice    Device = VK_NULL_HANDLE;
+        VkFence     Handle = VK_NULL_HANDLE;
+        bool IsSignalled() const;
+        void Wait() const;
+    };
+
+    struct Allocation
+    {
+        VkBuffer    Buffer = VK_NULL_HANDLE;
+        uint32_t    Offset = 0;     ///< byte offset in Buffer (and the dynamic offset to bind the descriptor set with)
+        uint32_t    Size = 0;
+        void*       pCpu = nullptr; ///< persistently mapped
+        explicit operator bool() const { return pCpu != nullptr; }
+    };
+
+    static constexpr uint32_t cUniformBinding = 0;
+    static constexpr uint32_t cStorageBinding = 1;
+    /// Largest offset alignment Vulkan allows for minUniformBufferOffsetAlignment/minStorageBufferOffsetAlignment
+    static constexpr size_t cMaxAlignment = 256;
+
+    explicit FrameRingBuffer( Vulkan& vulkan ) noexcept;
+    ~FrameRingBuffer();
+
+    bool Initialize( const Config& config );
+    void Destroy();
+
+    /// Called once per frame (by Vulkan::SetNextBackBuffer) after waiting on the frame's fence.
+    void BeginFrame( uint32_t bufferIdx, VkFence frameFence );
+
+    /// Allocate from the current frame (aligned for use as a dynamic uniform buffer offset).
+    /// Data must be written before the command buffer using it is submitted.
+    /// Fails if size is larger than Config::UniformRange (the descriptor could not address all of it).
+    Allocation AllocateUniform( size_t size );
+    /// Allocate from the current frame (aligned for use as a dynamic storage buffer offset).
+    /// Fails if size is larger than Config::StorageRange (when there is a storage binding).
+    Allocation AllocateStorage( size_t size );
+    Allocation Allocate( size_t size, size_t alignment );
+    /// Allocate and copy data in to the ring (uniform alignment).
+    template<typename T>
+    Allocation PushUniform( const T& data )
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "ring buffer data must be trivially copyable");
+        Allocation allocation = AllocateUniform( sizeof( T ) );
+        if (allocation)
+            std::memcpy( allocation.pCpu, &data, sizeof( T ) );
+        return allocation;
+    }
+
+    /// Flush the data allocated since the last call, so cpu writes are visible to the gpu if the memory is not host coherent (does nothing if it is).
+    /// Called by Vulkan::QueueSubmit, only needed when submitting some other way.
+    bool FlushMapped();
+
+    /// Bind the ring's descriptor set with the given dynamic offsets (storageOffset ignored if there is no storage binding).
+    void Bind( VkCommandBuffer cmdBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t setIndex, uint32_t uniformOffset, uint32_t storageOffset = 0 ) const;
+
+    VkDescriptorSetLayout GetVkDescriptorSetLayout() const  { return m_DescriptorSetLayout; }
+    VkDescriptorSet GetVkDescriptorSet() const              { return m_DescriptorSet; }
+    VkBuffer GetVkBuffer() const                            { return m_Buffer.GetVkBuffer(); }
+    size_t GetUniformAlignment() const                      { return m_UniformAlignment; }
+    size_t GetStorageAlignment() const                      { return m_StorageAlignment; }
+    const FrameRingAllocator<Fence>& GetAllocator() const   { return m_Allocator; }
+    /// Log (LOGI) and reset the allocation stats
+    void LogStats();
+
+private:
+    Vulkan&                                         m_Vulkan;
+    Config                                          m_Config;
+    FrameRingAllocator<Fence>                       m_Allocator;
+    MemoryAllocatedBuffer<Vulkan, VkBuffer>         m_Buffer;
+    std::optional<MemoryCpuMapped<Vulkan, uint8_t>> m_Mapped;
+    size_t                                          m_UniformAlignment = cMaxAlignment;
+    size_t                                          m_StorageAlignment = cMaxAlignment;
+    VkDescriptorSetLayout                           m_DescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool                                m_DescriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet                                 m_DescriptorSet = VK_NULL_HANDLE;
+};
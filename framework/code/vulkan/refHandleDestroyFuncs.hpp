@@ -11,6 +11,7 @@
 #include <atomic>
 #include <cassert>
 #include <volk/volk.h>
+#include "descriptorUpdateBatch.hpp"
 
 namespace VulkanTraits
 {
@@ -32,6 +33,7 @@ namespace VulkanTraits
         static void Call(VkDevice device, VkImageView imageView, const VkAllocationCallbacks* pAllocator)
         {
             vkDestroyImageView(device, imageView, pAllocator);
+            DescriptorUpdateBatch::NotifyResourceDestroyed();
         }
     };
 
@@ -41,6 +43,7 @@ namespace VulkanTraits
         static void Call(VkDevice device, VkImage image, const VkAllocationCallbacks* pAllocator)
         {
             vkDestroyImage(device, image, pAllocator);
+            DescriptorUpdateBatch::NotifyResourceDestroyed();
         }
     };
 
@@ -50,6 +53,7 @@ namespace VulkanTraits
         static void Call(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks* pAllocator)
         {
             vkDestroyBuffer(device, buffer, pAllocator);
+            DescriptorUpdateBatch::NotifyResourceDestroyed();
         }
     };
 
@@ -113,6 +117,7 @@ namespace VulkanTraits
         static void Call(VkDevice device, VkSampler sampler, const VkAllocationCallbacks* pAllocator)
         {
             vkDestroySampler(device, sampler, pAllocator);
+            DescriptorUpdateBatch::NotifyResourceDestroyed();
         }
     };
 
@@ -70,6 +70,8 @@ protected:
     /// Get the number of nanoseconds in a single GPU timer tick (
     float GetTimestampPeriod() const { return m_TimeStampPeriod; }
 
+    Vulkan& GetVulkan() const { return m_Vulkan; }
+
 private:
 
     void ResetQueryPool(uint32_t firstResetQuery, uint32_t queryResetCount);
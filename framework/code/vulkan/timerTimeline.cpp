@@ -0,0 +1,126 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "timerTimeline.hpp"
+#include "extensionLib.hpp"
+#include <vector>
+#if !defined(OS_WINDOWS)
+#include <time.h>
+#endif
+
+// Re-calibrate periodically so the gpu and cpu clocks cannot drift apart.
+static constexpr uint32_t cCalibrationIntervalFrames = 256;
+
+
+void TimerTimeline::Update(uint32_t whichFrame, uint64_t startTick, uint64_t stopTick)
+{
+    // Skip in-flight results from before a Reset (see TimerSimple::Update)
+    if (InvalidatedFrame != -1)
+    {
+        if (InvalidatedFrame != int(whichFrame))
+            return;
+        InvalidatedFrame = -1;
+    }
+    if (pTimeline && pTimelineTimer)
+        pTimeline->AddResult(*pTimelineTimer, startTick, stopTick);
+}
+
+
+TimerPoolTimeline::TimerPoolTimeline(Vulkan& vulkan, uint32_t historySize) noexcept : TTimerPool<TimerTimeline>(vulkan), m_Timeline(historySize)
+{
+}
+
+bool TimerPoolTimeline::Initialize(uint32_t maxTimers)
+{
+    if (!TimerPoolBase::Initialize(maxTimers))
+        return false;
+    m_Timeline.SetTimestampPeriod(GetTimestampPeriod());
+
+    Vulkan& vulkan = GetVulkan();
+    m_HostTimeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    m_pCalibratedTimestampsExt = vulkan.GetExtension<ExtensionLib::Ext_VK_EXT_calibrated_timestamps>();
+    if (m_pCalibratedTimestampsExt && m_pCalibratedTimestampsExt->Status == VulkanExtensionStatus::eLoaded && m_pCalibratedTimestampsExt->m_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT && m_pCalibratedTimestampsExt->m_vkGetCalibratedTimestampsEXT)
+    {
+        uint32_t domainCount = 0;
+        m_pCalibratedTimestampsExt->m_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(vulkan.m_VulkanGpu, &domainCount, nullptr);
+        std::vector<VkTimeDomainEXT> domains(domainCount);
+        m_pCalibratedTimestampsExt->m_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(vulkan.m_VulkanGpu, &domainCount, domains.data());
+        bool hasDeviceDomain = false;
+        for (auto domain : domains)
+        {
+            if (domain == VK_TIME_DOMAIN_DEVICE_EXT)
+                hasDeviceDomain = true;
+#if defined(OS_WINDOWS)
+            else if (domain == VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT)
+                m_HostTimeDomain = domain;
+#else
+            else if (domain == VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_EXT || (domain == VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT && m_HostTimeDomain == VK_TIME_DOMAIN_DEVICE_EXT))
+                m_HostTimeDomain = domain;
+#endif
+        }
+        if (!hasDeviceDomain)
+            m_HostTimeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    }
+    else
+        m_pCalibratedTimestampsExt = nullptr;
+
+    if (!Calibrate())
+        LOGI("TimerPoolTimeline: calibrated timestamps not available, gpu to cpu timestamp offset will be estimated");
+    return true;
+}
+
+TimerPoolBase::TimerBase* TimerPoolTimeline::FindOrAddTimer(std::string_view timerName, uint32_t deviceQueueFamilyIndex)
+{
+    auto* pTimer = static_cast<TimerTimeline*>(TTimerPool<TimerTimeline>::FindOrAddTimer(timerName, deviceQueueFamilyIndex));
+    if (!pTimer->pTimelineTimer)
+    {
+        pTimer->pTimeline = &m_Timeline;
+        pTimer->pTimelineTimer = &m_Timeline.FindOrAddTimer(timerName, deviceQueueFamilyIndex);
+    }
+    return pTimer;
+}
+
+void TimerPoolTimeline::UpdateResults(uint32_t whichFrame)
+{
+    TimerPoolBase::UpdateResults(whichFrame);
+
+    if (++m_FramesSinceCalibration >= cCalibrationIntervalFrames)
+        Calibrate();
+    m_Timeline.EndFrame(CpuTrace::Now());
+}
+
+bool TimerPoolTimeline::Calibrate()
+{
+    m_FramesSinceCalibration = 0;
+    if (!m_pCalibratedTimestampsExt || m_HostTimeDomain == VK_TIME_DOMAIN_DEVICE_EXT)
+        return false;
+
+    VkCalibratedTimestampInfoEXT timestampInfos[2] = { { VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT }, { VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT } };
+    timestampInfos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    timestampInfos[1].timeDomain = m_HostTimeDomain;
+    uint64_t timestamps[2] = {};
+    uint64_t maxDeviation = 0;
+    if (m_pCalibratedTimestampsExt->m_vkGetCalibratedTimestampsEXT(GetVulkan().m_VulkanDevice, 2, timestampInfos, timestamps, &maxDeviation) != VK_SUCCESS)
+        return false;
+
+    // Host timestamp is in the calibrated domain, take the cpu trace time now and step it back by however long has elapsed on the host clock since.
+    const uint64_t cpuTraceTicks = CpuTrace::Now();
+    double hostElapsedUs;
+#if defined(OS_WINDOWS)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    hostElapsedUs = double(int64_t(uint64_t(counter.QuadPart) - timestamps[1])) * 1e6 / double(frequency.QuadPart);
+#else
+    timespec now;
+    clock_gettime(m_HostTimeDomain == VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_EXT ? CLOCK_MONOTONIC_RAW : CLOCK_MONOTONIC, &now);
+    hostElapsedUs = double(int64_t(uint64_t(now.tv_sec) * 1000000000ull + uint64_t(now.tv_nsec) - timestamps[1])) * 1e-3;
+#endif
+    m_Timeline.SetCalibration(timestamps[0], cpuTraceTicks - uint64_t(int64_t(hostElapsedUs * CpuTrace::TicksPerMicrosecond())));
+    return true;
+}
@@ -0,0 +1,83 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+/// @file timerTimeline.hpp
+/// Vulkan timer pool implementation (frame history timers - raw per frame results with percentile stats, and gpu timers shown on the CpuTrace timeline).
+/// Gpu timestamps are calibrated against the cpu using VK_EXT_calibrated_timestamps when the application enables it
+/// (config.OptionalExtension<ExtensionLib::Ext_VK_EXT_calibrated_timestamps>()), otherwise the calibration is estimated from when results are read back.
+/// @ingroup Vulkan
+
+#include "timerPool.hpp"
+#include "system/frameTimeline.hpp"
+
+// Forward declarations
+namespace ExtensionLib {
+    struct Ext_VK_EXT_calibrated_timestamps;
+};
+
+
+/// Data for a single timer.  Results are stored in the pool's FrameTimeline.
+struct TimerTimeline final : public TimerPoolBase::TimerBase
+{
+    auto operator<=>(const std::pair<std::string_view, uint32_t> a ) const noexcept
+    {
+        auto result = Name.compare( a.first );
+        return result == 0 ? (int(a.second) - int(DeviceQueueFamilyIndex)) : result;
+    }
+    auto operator<=>(const TimerTimeline& a) const noexcept
+    {
+        auto result = Name.compare(a.Name);
+        return result == 0 ? (int(a.DeviceQueueFamilyIndex) - int(DeviceQueueFamilyIndex)) : result;
+    }
+    explicit TimerTimeline(std::string_view name, uint32_t deviceQueueFamilyIndex) noexcept : Name(name), DeviceQueueFamilyIndex(deviceQueueFamilyIndex) {}
+
+    /// @brief Ignore results for this timer until we get results from currentFrame (see TimerSimple::Reset).  Does not discard the history.
+    void Reset(int currentFrame) { InvalidatedFrame = currentFrame; }
+
+    const std::string Name;
+    int InvalidatedFrame = -1;
+    uint32_t DeviceQueueFamilyIndex = 0;
+    FrameTimeline* pTimeline = nullptr;             // set by TimerPoolTimeline
+    FrameTimeline::Timer* pTimelineTimer = nullptr;
+protected:
+    void Update(uint32_t whichFrame, uint64_t startTick, uint64_t stopTick) override;
+};
+
+
+class TimerPoolTimeline : public TTimerPool<TimerTimeline>
+{
+public:
+    /// @param historySize number of results kept (per timer) for the statistics
+    explicit TimerPoolTimeline(Vulkan& vulkan, uint32_t historySize = 256) noexcept;
+
+    /// Initialize the timer pool (TimerPoolBase::Initialize) and the gpu to cpu timestamp calibration.
+    bool Initialize(uint32_t maxTimers);
+
+    /// Read back the completed frame's results (TimerPoolBase::UpdateResults) and add them to the timeline.
+    void UpdateResults(uint32_t whichFrame) override;
+
+    FrameTimeline& GetTimeline() { return m_Timeline; }
+    const FrameTimeline& GetTimeline() const { return m_Timeline; }
+
+    /// Log the percentile statistics for every timer (using LOGI)
+    void Log() const { m_Timeline.Log(); }
+
+protected:
+    TimerBase* FindOrAddTimer(std::string_view timerName, uint32_t deviceQueueFamilyIndex) override;
+
+    /// Take a new calibration point with vkGetCalibratedTimestampsEXT
+    /// @return false if calibrated timestamps are unavailable
+    bool Calibrate();
+
+private:
+    FrameTimeline                                           m_Timeline;
+    const ExtensionLib::Ext_VK_EXT_calibrated_timestamps*   m_pCalibratedTimestampsExt = nullptr;
+    VkTimeDomainEXT                                         m_HostTimeDomain = VK_TIME_DOMAIN_DEVICE_EXT;   // cpu time domain to calibrate against (VK_TIME_DOMAIN_DEVICE_EXT if there is none)
+    uint32_t                                                m_FramesSinceCalibration = 0;
+};
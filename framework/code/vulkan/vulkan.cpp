@@ -8,6 +8,8 @@
 
 #include "vulkanDebugCallback.hpp"
 #include "vulkan.hpp"
+#include "descriptorUpdateBatch.hpp"
+#include "descriptorPoolAllocator.hpp"
 #include "extensionLib.hpp"
 #include "system/os_common.h"
 #include "system/config.h"
@@ -136,6 +138,9 @@ Vulkan::Vulkan()
     m_SetupCmdBuffer = VK_NULL_HANDLE;
 
     m_PipelineCache = VK_NULL_HANDLE;
+
+    m_DescriptorUpdateBatch = std::make_unique<DescriptorUpdateBatch>();
+    m_DescriptorPoolAllocator = std::make_unique<DescriptorPoolAllocator>(*this);
 }
 
 //-----------------------------------------------------------------------------
@@ -146,6 +151,13 @@ Vulkan::~Vulkan()
     DestroySwapchainRenderPass();
     DestroySwapChain();
 
+    if (m_FrameRingBuffer)
+        m_FrameRingBuffer->Destroy();
+    m_FrameRingBuffer.reset();
+    if (m_BindlessDescriptorHeap)
+        m_BindlessDescriptorHeap->Destroy();
+    m_BindlessDescriptorHeap.reset();
+    m_DescriptorPoolAllocator->Destroy();
     m_MemoryManager.Destroy();
 
     for (auto& queue : m_VulkanQueues)
@@ -2249,6 +2261,45 @@ bool Vulkan::InitMemoryManager()
     return m_MemoryManager.Initialize(m_VulkanGpu, m_VulkanDevice, m_VulkanInstance, HasLoadedVulkanDeviceExtension("VK_KHR_buffer_device_address"));
 }
 
+//-----------------------------------------------------------------------------
+uint32_t Vulkan::FlushDescriptorUpdates()
+//-----------------------------------------------------------------------------
+{
+    return m_DescriptorUpdateBatch->Flush(m_VulkanDevice);
+}
+
+//-----------------------------------------------------------------------------
+BindlessDescriptorHeap* Vulkan::CreateBindlessDescriptorHeap(const BindlessDescriptorHeap::Config& config)
+//-----------------------------------------------------------------------------
+{
+    if (m_BindlessDescriptorHeap)
+    {
+        LOGE("Bindless descriptor heap already created");
+        return nullptr;
+    }
+    auto heap = std::make_unique<BindlessDescriptorHeap>(*this);
+    if (!heap->Initialize(config))
+        return nullptr;
+    m_BindlessDescriptorHeap = std::move(heap);
+    return m_BindlessDescriptorHeap.get();
+}
+
+//-----------------------------------------------------------------------------
+FrameRingBuffer* Vulkan::CreateFrameRingBuffer(const FrameRingBuffer::Config& config)
+//-----------------------------------------------------------------------------
+{
+    if (m_FrameRingBuffer)
+    {
+        LOGE("Frame ring buffer already created");
+        return nullptr;
+    }
+    auto ringBuffer = std::make_unique<FrameRingBuffer>(*this);
+    if (!ringBuffer->Initialize(config))
+        return nullptr;
+    m_FrameRingBuffer = std::move(ringBuffer);
+    return m_FrameRingBuffer.get();
+}
+
 //-----------------------------------------------------------------------------
 bool Vulkan::InitPipelineCache()
 //-----------------------------------------------------------------------------
@@ -3358,6 +3409,7 @@ void Vulkan::DestroySwapChain()
         assert(!swapchainBuffer.framebuffer);                   // framebuffers destroyed by DestroyFramebuffers
         swapchainBuffer.image = VK_NULL_HANDLE;                 // images are owned by the m_VulkanSwapchain
     }
+    DescriptorUpdateBatch::NotifyResourceDestroyed();
     m_SwapchainBuffers.clear();
     
 #if defined (OS_WINDOWS) || defined (OS_LINUX)
@@ -4402,6 +4454,17 @@ Vulkan::BufferIndexAndFence Vulkan::SetNextBackBuffer()
     retVal = vkWaitForFences(m_VulkanDevice, 1, &Fence, VK_TRUE, UINT64_MAX);
     CheckVkError( "vkWaitForFences()", retVal );
 
+    // Gpu has now finished with the frame m_SwapchainImageCount frames ago, free any descriptor sets released since then.
+    m_DescriptorPoolAllocator->NextFrame(m_SwapchainImageCount);
+    // ... and upload any modified bindless material records to this frame's copy of the material table.
+    if (m_BindlessDescriptorHeap)
+        m_BindlessDescriptorHeap->BeginFrame(m_SwapchainCurrentIndx);
+    // ... and release the ring buffer space used by that frame (Fence protects the space this frame allocates).
+    if (m_FrameRingBuffer)
+        m_FrameRingBuffer->BeginFrame(m_SwapchainCurrentIndx, Fence);
+    // ... and apply every descriptor write queued since the last frame (in one vkUpdateDescriptorSets).
+    FlushDescriptorUpdates();
+
     // Reset Fence, ready to be set by the GPU when the command buffer has been submitted and completed.
     vkResetFences(m_VulkanDevice, 1, &Fence);
 
@@ -4460,6 +4523,10 @@ bool Vulkan::QueueSubmit(const std::span<const VkCommandBuffer> CommandBuffers,
 bool Vulkan::QueueSubmit(const std::span<const VkSubmitInfo> SubmitInfo, uint32_t QueueIndex, VkFence CompletedFence)
 //-----------------------------------------------------------------------------
 {
+    // Per-frame ring buffer data written since the last submit has to be visible to the gpu (if the memory is not host coherent).
+    if (m_FrameRingBuffer)
+        m_FrameRingBuffer->FlushMapped();
+
     VkQueue Queue = m_VulkanQueues[QueueIndex].Queue;
     assert(Queue != VK_NULL_HANDLE);
     VkResult retVal = vkQueueSubmit(Queue, (uint32_t)SubmitInfo.size(), SubmitInfo.data(), CompletedFence);
@@ -4474,6 +4541,10 @@ bool Vulkan::QueueSubmit(const std::span<const VkSubmitInfo> SubmitInfo, uint32_
 bool Vulkan::QueueSubmit(const std::span<const VkSubmitInfo2KHR> SubmitInfo, uint32_t QueueIndex, VkFence CompletedFence)
 //-----------------------------------------------------------------------------
 {
+    // As above, ring buffer data has to be visible to the gpu.
+    if (m_FrameRingBuffer)
+        m_FrameRingBuffer->FlushMapped();
+
     VkQueue Queue = m_VulkanQueues[QueueIndex].Queue;
     assert(Queue != VK_NULL_HANDLE);
     assert( m_ExtKhrSynchronization2 && m_ExtKhrSynchronization2->Status == VulkanExtensionStatus::eLoaded );
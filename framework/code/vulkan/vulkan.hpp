@@ -28,6 +28,8 @@
 #include <volk/volk.h>
 #include "extension.hpp"
 #include "memory/vulkan/memoryManager.hpp"
+#include "bindlessDescriptorHeap.hpp"
+#include "frameRingBuffer.hpp"
 #include "texture/textureFormat.hpp"
 #include "framebuffer.hpp"
 #include "../material/pipeline.hpp"///TODO: move pipeline.[ch]pp
@@ -84,6 +86,8 @@ namespace ExtensionLib {
 };
 namespace vk {};
 class VulkanDebugCallback;
+class DescriptorUpdateBatch;
+class DescriptorPoolAllocator;
 enum class TextureFormat;
 enum class Msaa;
 
@@ -719,6 +723,26 @@ public:
     // Accessors
     MemoryManager& GetMemoryManager() { return m_MemoryManager; }
     const MemoryManager& GetMemoryManager() const { return m_MemoryManager; }
+    /// Device wide batch of descriptor set writes (see DescriptorUpdateBatch).
+    /// Queued writes are applied once per frame by SetNextBackBuffer; writes queued during the frame are applied by the next descriptor set bind
+    /// (Drawable, Computable, Traceable, FrameRingBuffer and BindlessDescriptorHeap all flush before binding), so there is no need to flush after queuing.
+    DescriptorUpdateBatch& GetDescriptorUpdateBatch() { return *m_DescriptorUpdateBatch; }
+    /// Apply all the descriptor set writes queued on GetDescriptorUpdateBatch (in a single vkUpdateDescriptorSets).
+    /// Cheap (no lock) when nothing is queued, call before binding descriptor sets that may have writes queued.
+    /// @return number of descriptor writes applied
+    uint32_t FlushDescriptorUpdates();
+    /// Shared descriptor pools that (material) descriptor sets are allocated from.
+    DescriptorPoolAllocator& GetDescriptorPoolAllocator() { return *m_DescriptorPoolAllocator; }
+    /// Create the (opt-in) global bindless descriptor heap, must be called (after the swapchain is created) before loading any shaders with a "Bindless" descriptor set.
+    /// @return nullptr if the heap could not be created (eg descriptor indexing is not supported)
+    BindlessDescriptorHeap* CreateBindlessDescriptorHeap(const BindlessDescriptorHeap::Config& config);
+    /// @return the bindless descriptor heap, nullptr if CreateBindlessDescriptorHeap was not (successfully) called
+    BindlessDescriptorHeap* GetBindlessDescriptorHeap() const { return m_BindlessDescriptorHeap.get(); }
+    /// Create the (opt-in) per-frame ring buffer for uniform and other dynamic data, must be called after the swapchain is created.
+    /// @return nullptr if the ring buffer could not be created
+    FrameRingBuffer* CreateFrameRingBuffer(const FrameRingBuffer::Config& config);
+    /// @return the per-frame ring buffer, nullptr if CreateFrameRingBuffer was not (successfully) called
+    FrameRingBuffer* GetFrameRingBuffer() const { return m_FrameRingBuffer.get(); }
     VkInstance GetVulkanInstance() const { return m_VulkanInstance; }
     const auto& GetGpuProperties() const { return m_VulkanGpuProperties; }
     const auto& GetGpuFeatures() const { return m_VulkanGpuFeatures; }
@@ -1107,6 +1131,10 @@ private:
     mutable std::unordered_map<VkFormat, VkFormatProperties> m_FormatProperties;///< Known format properties - filled in as new formats are queried by @GetFormatProperties
 
     MemoryManager                       m_MemoryManager;
+    std::unique_ptr<DescriptorUpdateBatch> m_DescriptorUpdateBatch;
+    std::unique_ptr<DescriptorPoolAllocator> m_DescriptorPoolAllocator;
+    std::unique_ptr<BindlessDescriptorHeap> m_BindlessDescriptorHeap;
+    std::unique_ptr<FrameRingBuffer>    m_FrameRingBuffer;
 
     VkCommandBuffer                     m_SetupCmdBuffer;
 
@@ -46,9 +46,9 @@ bool MeshUpdateRT::Create(Vulkan& vulkan, const MeshObjectIntermediate& meshObje
     m_VertexBufferDeviceAddress = {};
     m_IndexBufferDeviceAddress = {};
 
-    // Convert the 'intermediate' mesh vertex data in to 'vertexFormat' and then copy in to a VertexBuffer (device memory).  Make WRITABLE from compute.
+    // Convert the 'intermediate' mesh vertex data in to 'vertexFormat' and then copy in to a VertexBuffer (device memory).  Make WRITABLE from compute (and by transfer, eg GpuSkinning's cpu fallback).
     // We COULD recycle the Buffer created by MeshObjectRT (with the storage flag added) but although this is slower it is also cleaner!
-    m_VertexBuffer = MeshObjectRT::CreateRtVertexBuffer(memoryManager, meshObject, BufferUsageFlags::AccelerationStructureBuild| BufferUsageFlags::Storage|BufferUsageFlags::ShaderDeviceAddress);
+    m_VertexBuffer = MeshObjectRT::CreateRtVertexBuffer(memoryManager, meshObject, BufferUsageFlags::AccelerationStructureBuild| BufferUsageFlags::Storage|BufferUsageFlags::TransferDst|BufferUsageFlags::ShaderDeviceAddress);
     if (m_VertexBuffer.GetVkBuffer() == VK_NULL_HANDLE)
         return false;
     m_VertexBufferDeviceAddress = memoryManager.GetBufferDeviceAddress(m_VertexBuffer);
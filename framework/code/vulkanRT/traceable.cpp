@@ -422,6 +422,7 @@ void Traceable::DispatchPass(VkCommandBuffer cmdBuffer, const TraceablePass& tra
     // Bind everything the shaders need
     const auto& descriptorSets = traceablePass.GetVkDescriptorSets();
     VkDescriptorSet descriptorSet = descriptorSets.size() >= 1 ? descriptorSets[bufferIdx] : descriptorSets[0];
+    mVulkanRt.GetVulkan().FlushDescriptorUpdates();
     vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, traceablePass.mPipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
 
     // Dispatch the compute task
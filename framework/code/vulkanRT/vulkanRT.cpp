@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include "vulkan/descriptorUpdateBatch.hpp"
 #include "vulkan/extensionLib.hpp"
 #include "memory/vulkan/uniform.hpp"
 #include "vulkan/vulkan_support.hpp"
@@ -104,6 +105,7 @@ VkAccelerationStructureKHR VulkanRT::vkCreateAccelerationStructureKHR(const VkAc
 void VulkanRT::vkDestroyAccelerationStructureKHR(VkAccelerationStructureKHR as) const
 {
     m_fpDestroyAccelerationStructureKHR(m_vulkan.m_VulkanDevice, as, nullptr);
+    DescriptorUpdateBatch::NotifyResourceDestroyed();
 }
 
 void VulkanRT::vkCmdBuildAccelerationStructuresKHR(VkCommandBuffer commandBuffer, uint32_t infoCount, const VkAccelerationStructureBuildGeometryInfoKHR* pInfos, const VkAccelerationStructureBuildRangeInfoKHR* const* ppOffsetInfos) const
@@ -0,0 +1,229 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "animationTestData.hpp"
+#include "animation/animationBlend.hpp"
+#include "animation/animationClip.hpp"
+#include "animation/skeletonData.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    float MaxDifference(const AnimationNodeTransform& a, const AnimationNodeTransform& b)
+    {
+        const glm::vec3 translation = glm::abs(a.Translation - b.Translation);
+        const glm::vec3 scale = glm::abs(a.Scale - b.Scale);
+        const float rotation = 1.0f - std::abs(glm::dot(a.Rotation, b.Rotation));
+        return std::max({ translation.x, translation.y, translation.z, scale.x, scale.y, scale.z, rotation });
+    }
+
+    /// Time a 4 layer blend (crossfade of clips 0 and 1, override layer of clip 2 on half the joints, additive layer of clip 3)
+    /// for numCharacters characters at staggered times.
+    void TimeLayeredBlend(std::span<const AnimationClip* const> clips, const std::vector<AnimationNodeTransform>& restPose, uint32_t numCharacters, uint32_t numFrames)
+    {
+        AnimationBlendGraph::JointMask halfMask(restPose.size(), 0.0f);
+        for (size_t nodeId = 0; nodeId < halfMask.size(); nodeId += 2)
+            halfMask[nodeId] = 1.0f;
+
+        std::vector<std::unique_ptr<AnimationBlendGraph>> graphs;
+        graphs.reserve(numCharacters);
+        for (uint32_t character = 0; character < numCharacters; ++character)
+        {
+            auto graph = std::make_unique<AnimationBlendGraph>(restPose);
+            const auto clip0 = graph->AddClip(*clips[0], 1.0f, true);
+            const auto clip1 = graph->AddClip(*clips[1], 1.0f, true);
+            const auto clip2 = graph->AddClip(*clips[2]);
+            const auto clip3 = graph->AddClip(*clips[3]);
+            const auto crossfade = graph->AddBlend(clip0, clip1, float(character) / float(numCharacters));
+            const auto layered = graph->AddBlend(crossfade, clip2, 0.75f, halfMask);
+            graph->AddAdditive(layered, clip3, 0.5f);
+            graph->Update(float(character) * 0.1f);
+            graphs.push_back(std::move(graph));
+        }
+        std::vector<AnimationNodeTransform> pose(restPose.size());
+
+        const double microseconds = FrameworkTest::TimeMicroseconds(numFrames, [&]() {
+            for (auto& graph : graphs)
+            {
+                graph->Update(1.0f / 60.0f);
+                graph->Evaluate(pose);
+            }
+        });
+        LOGI("AnimationBlendGraph: 4 layer blend, %u characters x %zu nodes, %.1fus per frame (%u frames), %u pooled poses per character", numCharacters, restPose.size(), microseconds, numFrames, graphs[0]->GetNumPooledPoses());
+    }
+}
+
+TEST_CASE(AnimationBlendGraph_CrossfadeEndpointsMatchClips)
+{
+    const AnimationClip clip0 = AnimationClip::Compile(MakeTestAnimationData(20, 30, 2.0f, 1), 2.0f, {});
+    const AnimationClip clip1 = AnimationClip::Compile(MakeTestAnimationData(20, 30, 2.0f, 2), 2.0f, {});
+    AnimationBlendGraph graph(std::vector<AnimationNodeTransform>(20));
+    const auto clipNode0 = graph.AddClip(clip0);
+    const auto clipNode1 = graph.AddClip(clip1);
+    const auto blendNode = graph.AddBlend(clipNode0, clipNode1, 0.0f);
+    graph.SetClipTime(clipNode0, 0.7f);
+    graph.SetClipTime(clipNode1, 0.7f);
+
+    std::vector<AnimationNodeTransform> pose(20);
+    for (const float weight : { 0.0f, 1.0f })
+    {
+        graph.SetWeight(blendNode, weight);
+        graph.Evaluate(pose);
+        const AnimationClip& clip = weight == 0.0f ? clip0 : clip1;
+        float maxDifference = 0.0f;
+        for (uint32_t clipNodeIdx = 0; clipNodeIdx < clip.GetNumNodes(); ++clipNodeIdx)
+            maxDifference = std::max(maxDifference, MaxDifference(pose[clip.GetNodeId(clipNodeIdx)], clip.EvaluateNode(clipNodeIdx, 0.7f)));
+        CHECK(maxDifference < 0.0001f);
+    }
+}
+
+TEST_CASE(AnimationBlendGraph_AdditiveAtFirstFrameAddsNothing)
+{
+    const AnimationClip base = AnimationClip::Compile(MakeTestAnimationData(20, 30, 2.0f, 3), 2.0f, {});
+    const AnimationClip additive = AnimationClip::Compile(MakeTestAnimationData(20, 30, 2.0f, 4), 2.0f, {});
+    AnimationBlendGraph graph(std::vector<AnimationNodeTransform>(20));
+    const auto baseNode = graph.AddClip(base);
+    const auto additiveNode = graph.AddClip(additive);
+    graph.AddAdditive(baseNode, additiveNode, 1.0f);
+    graph.SetClipTime(baseNode, 1.1f);
+    graph.SetClipTime(additiveNode, 0.0f);
+
+    std::vector<AnimationNodeTransform> pose(20);
+    graph.Evaluate(pose);
+    float maxDifference = 0.0f;
+    for (uint32_t clipNodeIdx = 0; clipNodeIdx < base.GetNumNodes(); ++clipNodeIdx)
+        maxDifference = std::max(maxDifference, MaxDifference(pose[base.GetNodeId(clipNodeIdx)], base.EvaluateNode(clipNodeIdx, 1.1f)));
+    CHECK(maxDifference < 0.0001f);
+}
+
+TEST_CASE(AnimationBlendGraph_PosePoolStopsGrowing)
+{
+    const AnimationClip clip0 = AnimationClip::Compile(MakeTestAnimationData(20, 30, 2.0f, 5), 2.0f, {});
+    const AnimationClip clip1 = AnimationClip::Compile(MakeTestAnimationData(20, 30, 2.0f, 6), 2.0f, {});
+    AnimationBlendGraph graph(std::vector<AnimationNodeTransform>(20));
+    const auto crossfade = graph.AddBlend(graph.AddClip(clip0, 1.0f, true), graph.AddClip(clip1, 1.0f, true), 0.5f);
+    graph.AddBlend(crossfade, graph.AddClip(clip0), 0.5f);
+
+    std::vector<AnimationNodeTransform> pose(20);
+    graph.Update(1.0f / 60.0f);
+    graph.Evaluate(pose);
+    const uint32_t numPooledPoses = graph.GetNumPooledPoses();
+    for (uint32_t frame = 0; frame < 100; ++frame)
+    {
+        graph.Update(1.0f / 60.0f);
+        graph.Evaluate(pose);
+    }
+    CHECK(numPooledPoses > 0);
+    CHECK(graph.GetNumPooledPoses() == numPooledPoses);
+    CHECK(graph.GetPhase() >= 0.0f && graph.GetPhase() < 1.0f);
+}
+
+TEST_CASE(AnimationBlendGraph_SynchronizedClipsShareThePhase)
+{
+    const AnimationClip walk = AnimationClip::Compile(MakeTestAnimationData(20, 30, 2.0f, 7), 2.0f, {});
+    const AnimationClip run = AnimationClip::Compile(MakeTestAnimationData(20, 30, 3.0f, 8), 3.0f, {});
+    const AnimationClip idle = AnimationClip::Compile(MakeTestAnimationData(20, 30, 4.0f, 9), 4.0f, {});
+    AnimationBlendGraph graph(std::vector<AnimationNodeTransform>(20));
+    const auto walkNode = graph.AddClip(walk, 1.0f, true);
+    const auto runNode = graph.AddClip(run, 1.0f, true);
+    const auto crossfade = graph.AddBlend(walkNode, runNode, 0.5f);
+    const auto idleNode = graph.AddClip(idle, 0.5f);
+    graph.SetRoot(crossfade);
+
+    // Halfway crossfade of a 2 and a 3 second cycle, the phase advances over 2.5 seconds.
+    graph.Update(1.25f);
+    CHECK_NEAR(graph.GetPhase(), 0.5f, 0.0001f);
+    // At the run's duration (weight 1) another 0.75 seconds is another quarter of the cycle.
+    graph.SetWeight(crossfade, 1.0f);
+    graph.Update(0.75f);
+    CHECK_NEAR(graph.GetPhase(), 0.75f, 0.0001f);
+    // Wraps at the end of the cycle.
+    graph.Update(1.5f);
+    CHECK_NEAR(graph.GetPhase(), 0.25f, 0.0001f);
+
+    // Both synchronized clips play at the phase (scaled to their own duration), the unsynchronized clip at its own rate.
+    std::vector<AnimationNodeTransform> pose(20);
+    for (const auto& [weight, pClip] : { std::pair{ 0.0f, &walk }, std::pair{ 1.0f, &run } })
+    {
+        graph.SetWeight(crossfade, weight);
+        graph.Evaluate(pose);
+        float maxDifference = 0.0f;
+        for (uint32_t clipNodeIdx = 0; clipNodeIdx < pClip->GetNumNodes(); ++clipNodeIdx)
+            maxDifference = std::max(maxDifference, MaxDifference(pose[pClip->GetNodeId(clipNodeIdx)], pClip->EvaluateNode(clipNodeIdx, 0.25f * pClip->GetEndTime())));
+        CHECK(maxDifference < 0.0001f);
+    }
+    graph.SetRoot(idleNode);
+    graph.Evaluate(pose);
+    CHECK(MaxDifference(pose[idle.GetNodeId(0)], idle.EvaluateNode(0, 0.5f * (1.25f + 0.75f + 1.5f))) < 0.0001f);
+}
+
+TEST_CASE(AnimationBlendGraph_JointMaskLimitsBlend)
+{
+    // Node 1 and its subtree (3, 4 and 5) are the masked 'upper body'.
+    const int parents[] = { -1, 0, 0, 1, 1, 3, 2, 2 };
+    const std::vector<glm::mat4> localTransforms(8, glm::identity<glm::mat4>());
+    const SkeletonData skeletonData = SkeletonData::FromParents(parents, localTransforms);
+    const AnimationBlendGraph::JointMask mask = AnimationBlendGraph::MakeMask(skeletonData, 1, 0.5f);
+    CHECK(mask == AnimationBlendGraph::JointMask({ 0.0f, 0.5f, 0.0f, 0.5f, 0.5f, 0.5f, 0.0f, 0.0f }));
+
+    const AnimationClip base = AnimationClip::Compile(MakeTestAnimationData(8, 30, 2.0f, 11), 2.0f, {});
+    const AnimationClip layer = AnimationClip::Compile(MakeTestAnimationData(8, 30, 2.0f, 12), 2.0f, {});
+    AnimationBlendGraph graph(AnimationBlendGraph::MakeRestPose(skeletonData));
+    const auto baseNode = graph.AddClip(base);
+    const auto layerNode = graph.AddClip(layer);
+    graph.AddBlend(baseNode, layerNode, 1.0f, mask);
+    graph.SetClipTime(baseNode, 0.3f);
+    graph.SetClipTime(layerNode, 0.3f);
+
+    // Unmasked joints are the base clip, masked joints halfway (mask weight) to the layer.
+    std::vector<AnimationNodeTransform> pose(8);
+    graph.Evaluate(pose);
+    for (uint32_t nodeId = 0; nodeId < 8; ++nodeId)
+    {
+        const AnimationNodeTransform base0 = base.EvaluateNode(nodeId, 0.3f);
+        const AnimationNodeTransform layer0 = layer.EvaluateNode(nodeId, 0.3f);
+        if (mask[nodeId] == 0.0f)
+        {
+            CHECK(MaxDifference(pose[nodeId], base0) < 0.0001f);
+            continue;
+        }
+        CHECK(glm::length(pose[nodeId].Translation - glm::mix(base0.Translation, layer0.Translation, 0.5f)) < 0.0001f);
+        CHECK(glm::length(pose[nodeId].Scale - glm::mix(base0.Scale, layer0.Scale, 0.5f)) < 0.0001f);
+    }
+
+    // Additive layer masked to the lower body leaves the upper body alone.
+    AnimationBlendGraph::JointMask lowerBodyMask(8, 1.0f);
+    for (uint32_t nodeId = 0; nodeId < 8; ++nodeId)
+        lowerBodyMask[nodeId] -= mask[nodeId] * 2.0f;
+    AnimationBlendGraph additiveGraph(AnimationBlendGraph::MakeRestPose(skeletonData));
+    const auto additiveBaseNode = additiveGraph.AddClip(base);
+    const auto additiveNode = additiveGraph.AddClip(layer);
+    additiveGraph.AddAdditive(additiveBaseNode, additiveNode, 1.0f, lowerBodyMask);
+    additiveGraph.SetClipTime(additiveBaseNode, 0.3f);
+    additiveGraph.SetClipTime(additiveNode, 0.9f);
+    additiveGraph.Evaluate(pose);
+    for (uint32_t nodeId = 0; nodeId < 8; ++nodeId)
+    {
+        const float difference = MaxDifference(pose[nodeId], base.EvaluateNode(nodeId, 0.3f));
+        CHECK(lowerBodyMask[nodeId] == 0.0f ? difference < 0.0001f : difference > 0.001f);
+    }
+}
+
+BENCHMARK_CASE(AnimationBlendGraph_LayeredBlend)
+{
+    std::vector<AnimationClip> clips;
+    for (uint32_t clipIdx = 0; clipIdx < 4; ++clipIdx)
+        clips.push_back(AnimationClip::Compile(MakeTestAnimationData(60, 60, 2.0f + float(clipIdx) * 0.25f, 10 + clipIdx), 2.0f + float(clipIdx) * 0.25f, {}));
+    const AnimationClip* const pClips[4] = { &clips[0], &clips[1], &clips[2], &clips[3] };
+    TimeLayeredBlend(pClips, std::vector<AnimationNodeTransform>(60), 100, 100);
+}
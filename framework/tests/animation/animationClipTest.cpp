@@ -0,0 +1,193 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "animationTestData.hpp"
+#include "animation/animation.hpp"
+#include "animation/animationClip.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    /// Memory, speed and accuracy of a clip compared with the Animation it was compiled from.
+    struct Comparison
+    {
+        size_t SourceBytes = 0;
+        size_t ClipBytes = 0;
+        uint32_t SourceKeys = 0;            ///< source frames (each holding translation, rotation and scale)
+        uint32_t ClipKeys = 0;              ///< clip keys (each holding translation, rotation and scale)
+        double SourceMicroseconds = 0.0;    ///< per pose, Animation::CalcLocal* for every node
+        double ClipMicroseconds = 0.0;      ///< per pose, AnimationClip::Evaluate
+        float MaxTranslationError = 0.0f;
+        float MaxRotationError = 0.0f;      ///< radians
+        float MaxScaleError = 0.0f;
+    };
+
+    float RotationAngle(const glm::quat& a, const glm::quat& b)
+    {
+        return 2.0f * std::acos(std::min(std::abs(glm::dot(a, b)), 1.0f));
+    }
+
+    float MaxAbsDifference(const glm::vec3& a, const glm::vec3& b)
+    {
+        const glm::vec3 d = glm::abs(a - b);
+        return std::max(d.x, std::max(d.y, d.z));
+    }
+
+    /// Evaluate both at numSamples times across the animation (stepping forwards, as when playing) and compare.
+    /// @param numTimingIterations 0 to skip the timing
+    Comparison Compare(const Animation& source, const AnimationClip& clip, uint32_t numSamples, uint32_t numTimingIterations)
+    {
+        Comparison comparison;
+        const auto& sourceNodes = source.GetAnimationData().GetNodes();
+        comparison.SourceBytes = AnimationClip::GetMemorySize(source.GetAnimationData());
+        comparison.ClipBytes = clip.GetMemorySize();
+        for (const auto& node : sourceNodes)
+            comparison.SourceKeys += (uint32_t)node.Frames.size();
+        comparison.ClipKeys = clip.GetNumKeys();
+
+        const uint32_t numNodes = clip.GetNumNodes();
+        const float endTime = source.GetEndTime();
+        auto sampleTime = [endTime, numSamples](uint32_t sample) { return endTime * float(sample) / float(numSamples); };
+
+        // Source: per node, per channel evaluation (as AnimationList::UpdateSkeletonMatrixes).
+        std::vector<AnimationNodeTransform> sourcePose(numNodes);
+        std::vector<uint32_t> frameHints(numNodes, 0);
+        auto evaluateSource = [&](float time) {
+            for (uint32_t nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+            {
+                sourcePose[nodeIdx].Translation = source.CalcLocalTranslation(nodeIdx, time, frameHints[nodeIdx]);
+                sourcePose[nodeIdx].Rotation = source.CalcLocalRotation(nodeIdx, time, frameHints[nodeIdx]);
+                sourcePose[nodeIdx].Scale = source.CalcLocalScale(nodeIdx, time, frameHints[nodeIdx]);
+            }
+        };
+        std::vector<AnimationNodeTransform> clipPose(numNodes);
+        AnimationClip::Cursor cursor = clip.MakeCursor();
+
+        if (numTimingIterations > 0)
+        {
+            comparison.SourceMicroseconds = FrameworkTest::TimeMicroseconds(numTimingIterations, [&]() {
+                for (uint32_t sample = 0; sample < numSamples; ++sample)
+                    evaluateSource(sampleTime(sample));
+            }) / numSamples;
+            comparison.ClipMicroseconds = FrameworkTest::TimeMicroseconds(numTimingIterations, [&]() {
+                for (uint32_t sample = 0; sample < numSamples; ++sample)
+                    clip.Evaluate(sampleTime(sample), clipPose, &cursor);
+            }) / numSamples;
+        }
+
+        for (uint32_t sample = 0; sample < numSamples; ++sample)
+        {
+            const float time = sampleTime(sample);
+            evaluateSource(time);
+            clip.Evaluate(time, clipPose, &cursor);
+            for (uint32_t nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+            {
+                if (sourceNodes[nodeIdx].Frames.empty())
+                    continue;
+                comparison.MaxTranslationError = std::max(comparison.MaxTranslationError, MaxAbsDifference(sourcePose[nodeIdx].Translation, clipPose[nodeIdx].Translation));
+                comparison.MaxRotationError = std::max(comparison.MaxRotationError, RotationAngle(glm::normalize(sourcePose[nodeIdx].Rotation), clipPose[nodeIdx].Rotation));
+                comparison.MaxScaleError = std::max(comparison.MaxScaleError, MaxAbsDifference(sourcePose[nodeIdx].Scale, clipPose[nodeIdx].Scale));
+            }
+        }
+        return comparison;
+    }
+
+    void LogComparison(const char* name, const Comparison& comparison)
+    {
+        LOGI("AnimationClip %s: %zu bytes (%u keys) vs %zu bytes (%u frames) source, %.1f%% of the memory", name, comparison.ClipBytes, comparison.ClipKeys, comparison.SourceBytes, comparison.SourceKeys, comparison.SourceBytes ? 100.0 * double(comparison.ClipBytes) / double(comparison.SourceBytes) : 0.0);
+        LOGI("AnimationClip %s: %.2fus per pose vs %.2fus source (%.2fx)", name, comparison.ClipMicroseconds, comparison.SourceMicroseconds, comparison.ClipMicroseconds > 0.0 ? comparison.SourceMicroseconds / comparison.ClipMicroseconds : 0.0);
+        LOGI("AnimationClip %s: max error translation %f, rotation %f radians, scale %f", name, comparison.MaxTranslationError, comparison.MaxRotationError, comparison.MaxScaleError);
+    }
+
+    /// One node with keys at times 0.5, 1.0 and 1.5 (of a 2 second animation), translation x is the key time.
+    AnimationData MakeInsetKeysAnimationData()
+    {
+        std::vector<AnimationFrameData> frames(3);
+        for (uint32_t frameIdx = 0; frameIdx < 3; ++frameIdx)
+        {
+            frames[frameIdx].Timestamp = 0.5f + 0.5f * float(frameIdx);
+            frames[frameIdx].Translation = glm::vec3(frames[frameIdx].Timestamp, 0.0f, 0.0f);
+        }
+        std::vector<AnimationNodeData> nodes;
+        nodes.emplace_back(std::move(frames), 0);
+        return AnimationData("inset", std::move(nodes));
+    }
+}
+
+TEST_CASE(AnimationClip_MatchesSourceAnimation)
+{
+    const Animation source(MakeTestAnimationData(20, 30, 2.0f));
+    const AnimationClip clip = AnimationClip::Compile(source, {});
+    const Comparison comparison = Compare(source, clip, 997, 0);
+    // Quantization (16 bits across the track range, 15 bits per rotation component) and nlerp (rather than slerp) rotations.
+    CHECK(comparison.MaxTranslationError < 0.001f);
+    CHECK(comparison.MaxRotationError < 0.005f);
+    CHECK(comparison.MaxScaleError < 0.001f);
+    CHECK(comparison.ClipBytes < comparison.SourceBytes);
+}
+
+TEST_CASE(AnimationClip_ReducedKeysWithinError)
+{
+    // Many more keys than needed, so most are removed.
+    const Animation source(MakeTestAnimationData(20, 960, 2.0f));
+    AnimationClip::Config config;
+    config.ReduceKeys = true;
+    const AnimationClip clip = AnimationClip::Compile(source, config);
+    const Comparison comparison = Compare(source, clip, 997, 0);
+    CHECK(comparison.ClipKeys < comparison.SourceKeys / 2);   // unreduced has a key for every source frame
+    CHECK(comparison.MaxTranslationError < config.TranslationError + 0.001f);
+    CHECK(comparison.MaxRotationError < config.RotationError + 0.005f);
+    CHECK(comparison.MaxScaleError < config.ScaleError + 0.001f);
+}
+
+TEST_CASE(AnimationClip_NonLoopingHoldsEndKeys)
+{
+    AnimationClip::Config config;
+    config.Looping = false;
+    const AnimationClip clip = AnimationClip::Compile(MakeInsetKeysAnimationData(), 2.0f, config);
+    CHECK(!clip.IsLooping());
+    // Before the first key and after the last key hold those keys.
+    CHECK_NEAR(clip.EvaluateNode(0, 0.1f).Translation.x, 0.5f, 0.001f);
+    CHECK_NEAR(clip.EvaluateNode(0, 1.9f).Translation.x, 1.5f, 0.001f);
+    // Between keys interpolates.
+    CHECK_NEAR(clip.EvaluateNode(0, 0.75f).Translation.x, 0.75f, 0.001f);
+
+    // Same with a cursor (stepping backwards and forwards through the hints).
+    std::vector<AnimationNodeTransform> pose(clip.GetNumNodes());
+    AnimationClip::Cursor cursor = clip.MakeCursor();
+    for (float time : { 1.9f, 0.1f, 1.2f, 1.99f, 0.0f })
+    {
+        clip.Evaluate(time, pose, &cursor);
+        CHECK_NEAR(pose[0].Translation.x, std::clamp(time, 0.5f, 1.5f), 0.001f);
+    }
+}
+
+TEST_CASE(AnimationClip_LoopingWrapsFromLastKey)
+{
+    const AnimationClip clip = AnimationClip::Compile(MakeInsetKeysAnimationData(), 2.0f, {});
+    CHECK(clip.IsLooping());
+    // Last key (1.5) to the first (0.5 + 2.0) spans a second, halfway through is time 0.0 (and 2.0).
+    CHECK_NEAR(clip.EvaluateNode(0, 0.0f).Translation.x, 1.0f, 0.001f);
+    CHECK_NEAR(clip.EvaluateNode(0, 1.75f).Translation.x, 1.25f, 0.001f);
+}
+
+BENCHMARK_CASE(AnimationClip_CompareWithSource)
+{
+    const Animation source(MakeTestAnimationData(60, 120, 4.0f));
+    LogComparison("full", Compare(source, AnimationClip::Compile(source, {}), 1000, 10));
+    AnimationClip::Config config;
+    config.ReduceKeys = true;
+    LogComparison("reduced", Compare(source, AnimationClip::Compile(source, config), 1000, 10));
+    // Every channel of the test data moves, so reduction (at the default errors) only removes keys when they are closer together.
+    const Animation oversampled(MakeTestAnimationData(60, 480, 4.0f));
+    LogComparison("reduced 120fps", Compare(oversampled, AnimationClip::Compile(oversampled, config), 1000, 10));
+}
@@ -0,0 +1,121 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "animationTestData.hpp"
+#include "animation/animationPoseBatch.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    /// Instances of one clip at staggered times, with their own cursors and output matrices
+    struct Crowd
+    {
+        Crowd(const AnimationClip& clip, uint32_t numInstances) : Clip(clip)
+        {
+            MatricesPerInstance = *std::max_element(clip.GetNodeIds().begin(), clip.GetNodeIds().end()) + 1;
+            Matrices.assign(size_t(numInstances) * MatricesPerInstance, AnimationPoseBatch::ToMat3x4(glm::identity<glm::mat4>()));
+            Cursors.assign(numInstances, clip.MakeCursor());
+            Instances.resize(numInstances);
+            for (uint32_t instanceIdx = 0; instanceIdx < numInstances; ++instanceIdx)
+                Instances[instanceIdx] = { &clip, 0.0f, &Cursors[instanceIdx], { Matrices.data() + size_t(instanceIdx) * MatricesPerInstance, MatricesPerInstance } };
+        }
+        /// Instances are staggered across the clip, each frame steps them all forward (wrapping) by 1/60th of a second.
+        void SetFrameTimes(uint32_t frame)
+        {
+            const float endTime = std::max(Clip.GetEndTime(), 0.0001f);
+            const uint32_t numInstances = (uint32_t)Instances.size();
+            for (uint32_t instanceIdx = 0; instanceIdx < numInstances; ++instanceIdx)
+                Instances[instanceIdx].Time = std::fmod(endTime * float(instanceIdx) / float(numInstances) + float(frame) / 60.0f, endTime);
+        }
+        float MaxDifference(const std::vector<glm::mat3x4>& other) const
+        {
+            float maxDifference = 0.0f;
+            for (size_t i = 0; i < Matrices.size(); ++i)
+                for (int row = 0; row < 3; ++row)
+                {
+                    const glm::vec4 difference = glm::abs(Matrices[i][row] - other[i][row]);
+                    maxDifference = std::max(maxDifference, std::max(std::max(difference.x, difference.y), std::max(difference.z, difference.w)));
+                }
+            return maxDifference;
+        }
+
+        const AnimationClip&                Clip;
+        uint32_t                            MatricesPerInstance = 0;
+        std::vector<glm::mat3x4>            Matrices;
+        std::vector<AnimationClip::Cursor>  Cursors;
+        std::vector<AnimationPoseBatch::Instance> Instances;
+    };
+}
+
+TEST_CASE(AnimationPoseBatch_MatchesScalar)
+{
+    const AnimationClip clip = AnimationClip::Compile(MakeTestAnimationData(37, 30, 1.0f), 1.0f, {});
+    Crowd crowd(clip, 16);
+    for (uint32_t frame = 0; frame < 10; ++frame)
+    {
+        crowd.SetFrameTimes(frame * 7);
+        for (const auto& instance : crowd.Instances)
+            AnimationPoseBatch::EvaluateInstanceScalar(instance);
+        const std::vector<glm::mat3x4> scalarMatrices = crowd.Matrices;
+        for (const auto& instance : crowd.Instances)
+            AnimationPoseBatch::EvaluateInstance(instance);
+        CHECK(crowd.MaxDifference(scalarMatrices) < 1e-4f);
+    }
+}
+
+TEST_CASE(AnimationPoseBatch_ParallelMatchesBatch)
+{
+    const AnimationClip clip = AnimationClip::Compile(MakeTestAnimationData(20, 30, 2.0f), 2.0f, {});
+    Crowd crowd(clip, 100);
+    crowd.SetFrameTimes(3);
+    for (const auto& instance : crowd.Instances)
+        AnimationPoseBatch::EvaluateInstance(instance);
+    const std::vector<glm::mat3x4> batchMatrices = crowd.Matrices;
+
+    ThreadWorker worker;
+    worker.Initialize("AnimationPoseBatchTest", 4);
+    AnimationPoseBatch::Evaluate(crowd.Instances, &worker);
+    CHECK(crowd.MaxDifference(batchMatrices) == 0.0f);
+}
+
+BENCHMARK_CASE(AnimationPoseBatch_Crowd)
+{
+    // 1000 characters of a 60 node clip, 100 frames.
+    const uint32_t numInstances = 1000;
+    const uint32_t numFrames = 100;
+    const AnimationClip clip = AnimationClip::Compile(MakeTestAnimationData(60, 60, 2.0f), 2.0f, {});
+    Crowd crowd(clip, numInstances);
+
+    uint32_t frame = 0;
+    const double scalarMicroseconds = FrameworkTest::TimeMicroseconds(numFrames, [&]() {
+        crowd.SetFrameTimes(frame++);
+        for (const auto& instance : crowd.Instances)
+            AnimationPoseBatch::EvaluateInstanceScalar(instance);
+    });
+    frame = 0;
+    const double batchMicroseconds = FrameworkTest::TimeMicroseconds(numFrames, [&]() {
+        crowd.SetFrameTimes(frame++);
+        for (const auto& instance : crowd.Instances)
+            AnimationPoseBatch::EvaluateInstance(instance);
+    });
+    ThreadWorker worker;
+    const uint32_t numThreads = worker.Initialize("AnimationPoseBatchBench");
+    frame = 0;
+    const double parallelMicroseconds = FrameworkTest::TimeMicroseconds(numFrames, [&]() {
+        crowd.SetFrameTimes(frame++);
+        AnimationPoseBatch::Evaluate(crowd.Instances, &worker);
+    });
+
+    LOGI("AnimationPoseBatch: %u instances x %u nodes, %u frames", numInstances, clip.GetNumNodes(), numFrames);
+    LOGI("AnimationPoseBatch: scalar %.1fus per frame, batch %.1fus per frame (%.2fx), batch on %u threads %.1fus per frame", scalarMicroseconds, batchMicroseconds, batchMicroseconds > 0.0 ? scalarMicroseconds / batchMicroseconds : 0.0, numThreads, parallelMicroseconds);
+}
@@ -0,0 +1,44 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "system/glm_common.hpp"
+#include "animation/animationData.hpp"
+
+/// Synthetic animation (nodes 0 to numNodes-1, each with numFrames keys over [0, endTime]), smooth enough to be interpolated but with every channel moving.
+inline AnimationData MakeTestAnimationData(uint32_t numNodes, uint32_t numFrames, float endTime, uint32_t seed = 1234)
+{
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<AnimationNodeData> nodes;
+    nodes.reserve(numNodes);
+    for (uint32_t nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        glm::vec3 axis(unit(random), unit(random), unit(random));
+        axis = glm::length(axis) > 0.001f ? glm::normalize(axis) : glm::vec3(0.0f, 1.0f, 0.0f);
+        const glm::vec3 offset(unit(random), unit(random), unit(random));
+        const float phase = unit(random) * 3.14159f;
+        std::vector<AnimationFrameData> frames(numFrames);
+        for (uint32_t frameIdx = 0; frameIdx < numFrames; ++frameIdx)
+        {
+            const float t = numFrames > 1 ? float(frameIdx) / float(numFrames - 1) : 0.0f;
+            const float angle = phase + t * 6.28318f;
+            auto& frame = frames[frameIdx];
+            frame.Timestamp = t * endTime;
+            frame.Translation = offset + glm::vec3(std::sin(angle), std::cos(angle), 0.5f * std::sin(2.0f * angle));
+            frame.Rotation = glm::angleAxis(angle, axis);
+            frame.Scale = glm::vec3(1.0f + 0.25f * std::sin(angle));
+        }
+        nodes.emplace_back(std::move(frames), nodeIdx);
+    }
+    return AnimationData("test", std::move(nodes));
+}
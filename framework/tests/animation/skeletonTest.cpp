@@ -0,0 +1,185 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "animation/animationPoseBatch.hpp"
+#include "animation/skeleton.hpp"
+#include "animation/skeletonData.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /// Each node the child of the previous one (deepest possible hierarchy).
+    std::vector<int> MakeChain(int numNodes)
+    {
+        std::vector<int> parents(numNodes);
+        std::iota(parents.begin(), parents.end(), -1);
+        return parents;
+    }
+
+    /// Every node a child of node 0 (widest possible hierarchy).
+    std::vector<int> MakeFan(int numNodes)
+    {
+        std::vector<int> parents(numNodes, 0);
+        parents[0] = -1;
+        return parents;
+    }
+
+    /// Random parent for every node, numRoots trees and node ids shuffled (so parents are not always lower ids than their children).
+    std::vector<int> MakeRandomForest(int numNodes, int numRoots, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<int> ordered(numNodes);
+        for (int nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+            ordered[nodeIdx] = nodeIdx < numRoots ? -1 : int(rng() % uint32_t(nodeIdx));
+        std::vector<int> nodeIds(numNodes);
+        std::iota(nodeIds.begin(), nodeIds.end(), 0);
+        std::shuffle(nodeIds.begin(), nodeIds.end(), rng);
+        std::vector<int> parents(numNodes);
+        for (int nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+            parents[nodeIds[nodeIdx]] = ordered[nodeIdx] < 0 ? -1 : nodeIds[ordered[nodeIdx]];
+        return parents;
+    }
+
+    /// Small rotations and translations (and scales near 1), so deep chains stay in a sensible range.
+    std::vector<glm::mat4> MakeLocalTransforms(size_t numNodes, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<glm::mat4> transforms(numNodes);
+        for (auto& transform : transforms)
+        {
+            const glm::vec3 axis = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.0f, 0.0f, 2.0f));
+            transform = glm::translate(glm::vec3(unit(rng), unit(rng), unit(rng))) * glm::rotate(0.2f * unit(rng), axis) * glm::scale(glm::vec3(1.0f + 0.01f * unit(rng)));
+        }
+        return transforms;
+    }
+
+    struct Hierarchy
+    {
+        const char*         Name;
+        std::vector<int>    Parents;
+    };
+
+    std::vector<Hierarchy> MakeHierarchies()
+    {
+        return { { "single", MakeChain(1) },
+                 { "chain", MakeChain(300) },
+                 { "fan", MakeFan(300) },
+                 { "tree", MakeRandomForest(300, 1, 1) },
+                 { "forest", MakeRandomForest(300, 7, 2) } };
+    }
+
+    /// Reorder node id ordered matrices in to sorted (SkeletonData::GetSortedNodeIds) order.
+    template<typename T_MATRIX>
+    std::vector<T_MATRIX> ToSorted(const SkeletonData& skeletonData, const std::vector<T_MATRIX>& byNodeId)
+    {
+        std::vector<T_MATRIX> sorted;
+        for (uint32_t nodeId : skeletonData.GetSortedNodeIds())
+            sorted.push_back(byNodeId[nodeId]);
+        return sorted;
+    }
+
+    /// TransformLocalToWorldRecursive, TransformLocalToWorld and TransformSortedLocalToWorld (per pose, averaged over numIterations).
+    void TimeHierarchy(const char* name, const std::vector<int>& parents, uint32_t numIterations)
+    {
+        const std::vector<glm::mat4> local = MakeLocalTransforms(parents.size(), 3);
+        const SkeletonData skeletonData = SkeletonData::FromParents(parents, local);
+        const Skeleton skeleton(skeletonData);
+        std::vector<glm::mat4> world(local.size());
+        const std::vector<glm::mat4> sortedLocal = ToSorted(skeletonData, local);
+        std::vector<glm::mat3x4> sortedLocal3x4(local.size());
+        std::transform(sortedLocal.begin(), sortedLocal.end(), sortedLocal3x4.begin(), AnimationPoseBatch::ToMat3x4);
+        std::vector<glm::mat3x4> world3x4(local.size());
+
+        const double recursiveMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { skeleton.TransformLocalToWorldRecursive(local, world); });
+        const double flatMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { skeleton.TransformLocalToWorld(local, world); });
+        const double sortedMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { skeleton.TransformSortedLocalToWorld(sortedLocal, world); });
+        const double sorted3x4Microseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { skeleton.TransformSortedLocalToWorld(sortedLocal3x4, world3x4); });
+        LOGI("Skeleton %s: %zu nodes, recursive %.2fus, flat %.2fus (%.2fx), sorted %.2fus (%.2fx), sorted 3x4 %.2fus (%.2fx)", name, parents.size(), recursiveMicroseconds,
+             flatMicroseconds, recursiveMicroseconds / flatMicroseconds, sortedMicroseconds, recursiveMicroseconds / sortedMicroseconds, sorted3x4Microseconds, recursiveMicroseconds / sorted3x4Microseconds);
+    }
+}
+
+TEST_CASE(Skeleton_FromParentsSortsParentsFirst)
+{
+    for (const auto& hierarchy : MakeHierarchies())
+    {
+        const SkeletonData skeletonData = SkeletonData::FromParents(hierarchy.Parents, MakeLocalTransforms(hierarchy.Parents.size(), 4));
+        const auto& sortedNodeIds = skeletonData.GetSortedNodeIds();
+        const auto& sortedParents = skeletonData.GetSortedParents();
+        CHECK(sortedNodeIds.size() == hierarchy.Parents.size());
+
+        bool parentsFirst = true;
+        for (size_t sortedIdx = 0; sortedIdx < sortedNodeIds.size(); ++sortedIdx)
+        {
+            const int parentIdx = sortedParents[sortedIdx];
+            const int parentId = hierarchy.Parents[sortedNodeIds[sortedIdx]];
+            parentsFirst = parentsFirst && parentIdx < (int)sortedIdx && (parentIdx < 0 ? parentId < 0 : (int)sortedNodeIds[parentIdx] == parentId);
+        }
+        CHECK(parentsFirst);
+    }
+}
+
+TEST_CASE(Skeleton_FlatMatchesRecursive)
+{
+    uint32_t seed = 5;
+    for (const auto& hierarchy : MakeHierarchies())
+    {
+        const std::vector<glm::mat4> local = MakeLocalTransforms(hierarchy.Parents.size(), seed++);
+        const SkeletonData skeletonData = SkeletonData::FromParents(hierarchy.Parents, local);
+        const Skeleton skeleton(skeletonData);
+
+        // Same matrix multiplies in the same order, so the results are bitwise identical.
+        std::vector<glm::mat4> recursiveWorld(local.size());
+        std::vector<glm::mat4> flatWorld(local.size());
+        skeleton.TransformLocalToWorldRecursive(local, recursiveWorld);
+        skeleton.TransformLocalToWorld(local, flatWorld);
+        CHECK(flatWorld == recursiveWorld);
+
+        // In place (local and world the same data).
+        std::vector<glm::mat4> inPlace = local;
+        skeleton.TransformLocalToWorld(inPlace, inPlace);
+        CHECK(inPlace == recursiveWorld);
+
+        // Sorted order (in place too) is the same multiplies.
+        std::vector<glm::mat4> sortedWorld = ToSorted(skeletonData, local);
+        skeleton.TransformSortedLocalToWorld(sortedWorld, sortedWorld);
+        CHECK(sortedWorld == ToSorted(skeletonData, recursiveWorld));
+
+        // 3x4 rows sum in a different order, so only close.
+        std::vector<glm::mat3x4> local3x4(local.size());
+        std::transform(local.begin(), local.end(), local3x4.begin(), AnimationPoseBatch::ToMat3x4);
+        std::vector<glm::mat3x4> world3x4(local.size());
+        skeleton.TransformLocalToWorld(local3x4, world3x4);
+        float maxError = 0.0f;
+        for (size_t nodeId = 0; nodeId < local.size(); ++nodeId)
+        {
+            const glm::mat3x4 expected = AnimationPoseBatch::ToMat3x4(recursiveWorld[nodeId]);
+            for (int row = 0; row < 3; ++row)
+                for (int col = 0; col < 4; ++col)
+                    maxError = std::max(maxError, std::abs(world3x4[nodeId][row][col] - expected[row][col]) / (1.0f + std::abs(expected[row][col])));
+        }
+        CHECK(maxError < 0.0001f);
+        std::vector<glm::mat3x4> sortedWorld3x4 = ToSorted(skeletonData, local3x4);
+        skeleton.TransformSortedLocalToWorld(sortedWorld3x4, sortedWorld3x4);
+        CHECK(sortedWorld3x4 == ToSorted(skeletonData, world3x4));
+    }
+}
+
+BENCHMARK_CASE(Skeleton_FlatVersusRecursive)
+{
+    TimeHierarchy("chain", MakeChain(1000), 1000);
+    TimeHierarchy("fan", MakeFan(1000), 1000);
+    TimeHierarchy("tree", MakeRandomForest(1000, 1, 6), 1000);
+}
@@ -0,0 +1,154 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "camera/cameraFrustum.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include <algorithm>
+#include <bit>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /// Random bounds around a camera at the origin looking down -z (structure of arrays, spheres and aabbs share centers).
+    struct RandomBounds
+    {
+        RandomBounds(uint32_t numBounds, uint32_t seed)
+            : X(numBounds), Y(numBounds), Z(numBounds), Radius(numBounds), ExtentX(numBounds), ExtentY(numBounds), ExtentZ(numBounds)
+        {
+            std::mt19937 random(seed);
+            std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+            std::uniform_real_distribution<float> size(0.5f, 5.0f);
+            for (uint32_t i = 0; i < numBounds; ++i)
+            {
+                X[i] = position(random);
+                Y[i] = position(random);
+                Z[i] = position(random);
+                Radius[i] = size(random);
+                ExtentX[i] = size(random);
+                ExtentY[i] = size(random);
+                ExtentZ[i] = size(random);
+            }
+        }
+        CameraFrustum::Spheres Spheres() const { return { X, Y, Z, Radius }; }
+        CameraFrustum::Aabbs Aabbs() const { return { X, Y, Z, ExtentX, ExtentY, ExtentZ }; }
+        uint32_t size() const { return (uint32_t)X.size(); }
+
+        std::vector<float> X, Y, Z, Radius, ExtentX, ExtentY, ExtentZ;
+    };
+
+    CameraFrustum MakeFrustum(CameraFrustum::DepthMode depthMode = CameraFrustum::DepthMode::ZeroToOne)
+    {
+        const glm::mat4 view = glm::lookAtRH(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return CameraFrustum(glm::perspectiveRH(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f) * view, depthMode);
+    }
+
+    /// IsSphereVisible on each bound, as a bitset.
+    std::vector<uint64_t> ScalarSphereBits(const CameraFrustum& frustum, const RandomBounds& bounds)
+    {
+        std::vector<uint64_t> bits((bounds.size() + 63) / 64, 0);
+        for (uint32_t i = 0; i < bounds.size(); ++i)
+            if (frustum.IsSphereVisible(glm::vec3(bounds.X[i], bounds.Y[i], bounds.Z[i]), bounds.Radius[i]))
+                bits[i / 64] |= 1ull << (i & 63);
+        return bits;
+    }
+
+    /// IsAabbVisible on each bound, as a bitset.
+    std::vector<uint64_t> ScalarAabbBits(const CameraFrustum& frustum, const RandomBounds& bounds)
+    {
+        std::vector<uint64_t> bits((bounds.size() + 63) / 64, 0);
+        for (uint32_t i = 0; i < bounds.size(); ++i)
+            if (frustum.IsAabbVisible(glm::vec3(bounds.X[i], bounds.Y[i], bounds.Z[i]), glm::vec3(bounds.ExtentX[i], bounds.ExtentY[i], bounds.ExtentZ[i])))
+                bits[i / 64] |= 1ull << (i & 63);
+        return bits;
+    }
+
+    /// @return true if the first numVisible indices are the set bits, in order
+    bool IndicesMatchBits(std::span<const uint32_t> indices, uint32_t numVisible, const std::vector<uint64_t>& bits)
+    {
+        uint32_t visibleIdx = 0;
+        for (size_t word = 0; word < bits.size(); ++word)
+            for (uint64_t wordBits = bits[word]; wordBits != 0; wordBits &= wordBits - 1)
+                if (visibleIdx >= numVisible || indices[visibleIdx++] != word * 64 + std::countr_zero(wordBits))
+                    return false;
+        return visibleIdx == numVisible;
+    }
+}
+
+TEST_CASE(CameraFrustum_BatchedMatchesScalar)
+{
+    // Not a multiple of 4 (or 64), so the tail is tested too.
+    const RandomBounds bounds(10001, 1234);
+    ThreadWorker worker;
+    worker.Initialize("CameraFrustum", 4);
+
+    for (const auto depthMode : { CameraFrustum::DepthMode::ZeroToOne, CameraFrustum::DepthMode::ReverseZ, CameraFrustum::DepthMode::ReverseZInfiniteFar })
+    {
+        const CameraFrustum frustum = MakeFrustum(depthMode);
+        std::vector<uint64_t> bits((bounds.size() + 63) / 64, ~0ull);
+        std::vector<uint32_t> indices(bounds.size());
+
+        const std::vector<uint64_t> scalarSphereBits = ScalarSphereBits(frustum, bounds);
+        frustum.CullSpheres(bounds.Spheres(), std::span<uint64_t>(bits));
+        CHECK(bits == scalarSphereBits);
+        CHECK(IndicesMatchBits(indices, frustum.CullSpheres(bounds.Spheres(), std::span<uint32_t>(indices)), scalarSphereBits));
+        std::fill(bits.begin(), bits.end(), ~0ull);
+        frustum.CullSpheres(bounds.Spheres(), std::span<uint64_t>(bits), &worker);
+        CHECK(bits == scalarSphereBits);
+
+        const std::vector<uint64_t> scalarAabbBits = ScalarAabbBits(frustum, bounds);
+        frustum.CullAabbs(bounds.Aabbs(), std::span<uint64_t>(bits));
+        CHECK(bits == scalarAabbBits);
+        CHECK(IndicesMatchBits(indices, frustum.CullAabbs(bounds.Aabbs(), std::span<uint32_t>(indices)), scalarAabbBits));
+        std::fill(bits.begin(), bits.end(), ~0ull);
+        frustum.CullAabbs(bounds.Aabbs(), std::span<uint64_t>(bits), &worker);
+        CHECK(bits == scalarAabbBits);
+    }
+}
+
+TEST_CASE(CameraFrustum_Planes)
+{
+    const CameraFrustum frustum = MakeFrustum();
+    CHECK(frustum.GetNumPlanes() == CameraFrustum::NumPlanes);
+    CHECK(MakeFrustum(CameraFrustum::DepthMode::ReverseZInfiniteFar).GetNumPlanes() == CameraFrustum::NumPlanes - 1);
+
+    CHECK(frustum.IsSphereVisible(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f));
+    CHECK(!frustum.IsSphereVisible(glm::vec3(0.0f, 0.0f, 10.0f), 1.0f));       // behind
+    CHECK(!frustum.IsSphereVisible(glm::vec3(0.0f, 0.0f, -1010.0f), 1.0f));    // beyond the far plane
+    CHECK(frustum.IsSphereVisible(glm::vec3(0.0f, 0.0f, 0.5f), 1.0f));         // straddling the near plane
+    CHECK(frustum.IsAabbVisible(glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(1.0f)));
+    CHECK(!frustum.IsAabbVisible(glm::vec3(100.0f, 0.0f, -10.0f), glm::vec3(1.0f)));
+}
+
+BENCHMARK_CASE(CameraFrustum_CullTiming)
+{
+    const uint32_t numIterations = 10;
+    const RandomBounds bounds(100000, 1234);
+    const CameraFrustum frustum = MakeFrustum();
+    ThreadWorker worker;
+    worker.Initialize("CameraFrustum", 4);
+    std::vector<uint64_t> bits((bounds.size() + 63) / 64);
+    std::vector<uint32_t> indices(bounds.size());
+    uint32_t numVisibleSpheres = 0;
+    uint32_t numVisibleAabbs = 0;
+
+    const double scalarSphereMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { ScalarSphereBits(frustum, bounds); });
+    const double sphereBitsMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { frustum.CullSpheres(bounds.Spheres(), std::span<uint64_t>(bits)); });
+    const double sphereIndicesMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { numVisibleSpheres = frustum.CullSpheres(bounds.Spheres(), std::span<uint32_t>(indices)); });
+    const double parallelSphereBitsMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { frustum.CullSpheres(bounds.Spheres(), std::span<uint64_t>(bits), &worker); });
+    const double scalarAabbMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { ScalarAabbBits(frustum, bounds); });
+    const double aabbBitsMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { frustum.CullAabbs(bounds.Aabbs(), std::span<uint64_t>(bits)); });
+    const double aabbIndicesMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { numVisibleAabbs = frustum.CullAabbs(bounds.Aabbs(), std::span<uint32_t>(indices)); });
+
+    LOGI("CameraFrustum: %u bounds, %u spheres and %u aabbs visible", bounds.size(), numVisibleSpheres, numVisibleAabbs);
+    LOGI("CameraFrustum: spheres scalar %.1fus, bits %.1fus, indices %.1fus", scalarSphereMicroseconds, sphereBitsMicroseconds, sphereIndicesMicroseconds);
+    LOGI("CameraFrustum: aabbs scalar %.1fus, bits %.1fus, indices %.1fus", scalarAabbMicroseconds, aabbBitsMicroseconds, aabbIndicesMicroseconds);
+    LOGI("CameraFrustum: sphere bits on %u threads %.1fus", worker.NumThreads(), parallelSphereBitsMicroseconds);
+}
@@ -0,0 +1,172 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "camera/temporalContext.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <span>
+#include <vector>
+
+namespace
+{
+    /// Star discrepancy of a jitter sequence (lower is more evenly distributed), exact for the point set, O(n^3)
+    float CalcStarDiscrepancy(std::span<const glm::vec2> jitter)
+    {
+        if (jitter.empty())
+            return 0.0f;
+        // Largest difference between the fraction of points in a box anchored at the origin and the box's area.  Only boxes with
+        // corners at point coordinates (or 1) need testing, counting points both on and strictly inside the box edges.
+        std::vector<float> xs, ys;
+        for (const auto& position : jitter)
+        {
+            xs.push_back(position.x + 0.5f);
+            ys.push_back(position.y + 0.5f);
+        }
+        xs.push_back(1.0f);
+        ys.push_back(1.0f);
+        const float numPoints = (float)jitter.size();
+        float discrepancy = 0.0f;
+        for (float boxX : xs)
+        {
+            for (float boxY : ys)
+            {
+                uint32_t numOpen = 0, numClosed = 0;
+                for (const auto& position : jitter)
+                {
+                    const float x = position.x + 0.5f;
+                    const float y = position.y + 0.5f;
+                    numOpen += (x < boxX && y < boxY) ? 1 : 0;
+                    numClosed += (x <= boxX && y <= boxY) ? 1 : 0;
+                }
+                const float area = boxX * boxY;
+                discrepancy = std::max({ discrepancy, std::abs((float)numOpen / numPoints - area), std::abs((float)numClosed / numPoints - area) });
+            }
+        }
+        return discrepancy;
+    }
+
+    /// Smallest (toroidal) distance between any two positions (higher is better separated)
+    float CalcMinDistance(std::span<const glm::vec2> jitter)
+    {
+        float minDistanceSq = FLT_MAX;
+        for (size_t i = 0; i < jitter.size(); ++i)
+            for (size_t j = i + 1; j < jitter.size(); ++j)
+            {
+                glm::vec2 d = glm::abs(jitter[i] - jitter[j]);
+                d = glm::min(d, glm::vec2(1.0f) - d);
+                minDistanceSq = std::min(minDistanceSq, glm::dot(d, d));
+            }
+        return jitter.size() > 1 ? std::sqrt(minDistanceSq) : 0.0f;
+    }
+
+    const char* SequenceName(TemporalContext::JitterSequence sequence)
+    {
+        switch (sequence)
+        {
+        case TemporalContext::JitterSequence::None: return "None";
+        case TemporalContext::JitterSequence::Halton23: return "Halton23";
+        case TemporalContext::JitterSequence::R2: return "R2";
+        case TemporalContext::JitterSequence::BlueNoise: return "BlueNoise";
+        }
+        return "";
+    }
+}
+
+TEST_CASE(TemporalContext_JitterInPixelRange)
+{
+    CHECK(TemporalContext::MakeJitterSequence(TemporalContext::JitterSequence::None, 32).empty());
+    for (auto sequence : { TemporalContext::JitterSequence::Halton23, TemporalContext::JitterSequence::R2, TemporalContext::JitterSequence::BlueNoise })
+    {
+        const auto jitter = TemporalContext::MakeJitterSequence(sequence, 64);
+        CHECK(jitter.size() == 64);
+        CHECK(std::all_of(jitter.begin(), jitter.end(), [](const glm::vec2& position) { return position.x >= -0.5f && position.x < 0.5f && position.y >= -0.5f && position.y < 0.5f; }));
+        // Deterministic (the same every run).
+        CHECK(TemporalContext::MakeJitterSequence(sequence, 64) == jitter);
+    }
+}
+
+TEST_CASE(TemporalContext_StarDiscrepancyBounds)
+{
+    // Bounds are a little above the measured values (32 positions Halton23 0.100, R2 0.173, BlueNoise 0.135; 256 positions 0.019,
+    // 0.026 and 0.041), all under the 0.2 to 0.25 typical of 32 uniform random positions and falling as the sequence gets longer.
+    const float cMaxDiscrepancy32[] = { 0.11f, 0.19f, 0.15f };
+    const float cMaxDiscrepancy256[] = { 0.025f, 0.03f, 0.05f };
+    uint32_t sequenceIdx = 0;
+    for (auto sequence : { TemporalContext::JitterSequence::Halton23, TemporalContext::JitterSequence::R2, TemporalContext::JitterSequence::BlueNoise })
+    {
+        CHECK(CalcStarDiscrepancy(TemporalContext::MakeJitterSequence(sequence, 32)) < cMaxDiscrepancy32[sequenceIdx]);
+        CHECK(CalcStarDiscrepancy(TemporalContext::MakeJitterSequence(sequence, 256)) < cMaxDiscrepancy256[sequenceIdx]);
+        ++sequenceIdx;
+    }
+}
+
+TEST_CASE(TemporalContext_BlueNoiseWellSeparated)
+{
+    // Best candidate keeps every prefix well separated (32 positions in a square could be at most ~0.19 apart).
+    CHECK(CalcMinDistance(TemporalContext::MakeJitterSequence(TemporalContext::JitterSequence::BlueNoise, 32)) > 0.1f);
+    CHECK(CalcMinDistance(TemporalContext::MakeJitterSequence(TemporalContext::JitterSequence::BlueNoise, 256)) > 0.03f);
+}
+
+TEST_CASE(TemporalContext_HaltonTableMatchesSequence)
+{
+    constexpr auto cTable = TemporalContext::MakeHaltonJitter<32>();
+    const auto jitter = TemporalContext::MakeJitterSequence(TemporalContext::JitterSequence::Halton23, 32);
+    CHECK(std::equal(cTable.begin(), cTable.end(), jitter.begin(), jitter.end()));
+    CHECK(cTable[0] == glm::vec2(0.0f, 1.0f / 3.0f - 0.5f));
+}
+
+TEST_CASE(TemporalContext_HistoryAdvancesInBeginFrame)
+{
+    TemporalContext temporal;
+    const glm::mat4 projection = glm::perspectiveRH(1.0f, 1.5f, 0.1f, 100.0f);
+    const glm::mat4 views[3] = { glm::translate(glm::vec3(0.0f, 0.0f, -5.0f)), glm::translate(glm::vec3(1.0f, 0.0f, -5.0f)), glm::translate(glm::vec3(2.0f, 0.0f, -5.0f)) };
+
+    // First frame has no history (previous is the current).
+    temporal.SetMatrices(projection, views[0], false);
+    CHECK(!temporal.HasHistory() && temporal.IsCameraStill());
+
+    // Setting the matrices more than once in a frame (eg the constructor then the frame's update) keeps the previous frame.
+    temporal.BeginFrame();
+    temporal.SetMatrices(projection, views[2], false);
+    temporal.SetMatrices(projection, views[1], false);
+    CHECK(temporal.HasHistory() && !temporal.IsCameraStill());
+    CHECK(temporal.GetPreviousViewProjection() == projection * views[0]);
+    CHECK(temporal.GetViewProjection() == projection * views[1]);
+    const glm::vec4 clipPosition = projection * views[1] * glm::vec4(0.5f, 0.25f, 0.0f, 1.0f);
+    const glm::vec4 previousClipPosition = temporal.GetClipToPreviousClip() * clipPosition;
+    const glm::vec4 expectedClipPosition = projection * views[0] * glm::vec4(0.5f, 0.25f, 0.0f, 1.0f);
+    CHECK(glm::length(previousClipPosition / previousClipPosition.w - expectedClipPosition / expectedClipPosition.w) < 0.0001f);
+
+    // Jitter only advances in BeginFrame.
+    temporal.SetJitterSequence(TemporalContext::JitterSequence::Halton23, 8);
+    const glm::vec2 jitter = temporal.GetJitter();
+    temporal.SetMatrices(projection, views[1], false);
+    CHECK(temporal.GetJitter() == jitter);
+    temporal.BeginFrame();
+    CHECK(temporal.GetJitter() != jitter);
+
+    // Cut drops the history for the frame it happens in.
+    temporal.SetMatrices(projection, views[2], true);
+    CHECK(!temporal.HasHistory() && temporal.IsCameraStill());
+    temporal.BeginFrame();
+    temporal.SetMatrices(projection, views[2], false);
+    CHECK(temporal.HasHistory() && temporal.IsCameraStill());
+}
+
+BENCHMARK_CASE(TemporalContext_SequenceQuality)
+{
+    for (uint32_t length : { 8u, 16u, 32u, 256u })
+        for (auto sequence : { TemporalContext::JitterSequence::Halton23, TemporalContext::JitterSequence::R2, TemporalContext::JitterSequence::BlueNoise })
+        {
+            const auto jitter = TemporalContext::MakeJitterSequence(sequence, length);
+            LOGI("TemporalContext: %s %u positions, star discrepancy %f, min distance %f", SequenceName(sequence), length, CalcStarDiscrepancy(jitter), CalcMinDistance(jitter));
+        }
+}
@@ -0,0 +1,50 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+/// Minimal self registering test (and benchmark) cases for the framework_tests executable.
+/// TEST_CASE bodies run by default and report failed CHECKs; BENCHMARK_CASE bodies run with --bench and log their timings.
+namespace FrameworkTest
+{
+    typedef void (*tCaseFn)();
+
+    struct Registration
+    {
+        Registration(const char* pName, tCaseFn fn, bool benchmark);
+    };
+
+    void ReportFailure(const char* pFile, int line, const char* pExpression);
+
+    /// @return average microseconds per call of fn (called numIterations times)
+    template<typename T_FN>
+    double TimeMicroseconds(uint32_t numIterations, const T_FN& fn)
+    {
+        numIterations = numIterations > 0 ? numIterations : 1;
+        const auto startTime = std::chrono::steady_clock::now();
+        for (uint32_t iteration = 0; iteration < numIterations; ++iteration)
+            fn();
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count() / numIterations;
+    }
+}
+
+#define FRAMEWORK_TEST_REGISTER(NAME, BENCHMARK) \
+    static void NAME(); \
+    static const FrameworkTest::Registration NAME##_Registration(#NAME, &NAME, BENCHMARK); \
+    static void NAME()
+
+#define TEST_CASE(NAME)         FRAMEWORK_TEST_REGISTER(NAME, false)
+#define BENCHMARK_CASE(NAME)    FRAMEWORK_TEST_REGISTER(NAME, true)
+
+#define CHECK(EXPRESSION) \
+    do { if (!(EXPRESSION)) FrameworkTest::ReportFailure(__FILE__, __LINE__, #EXPRESSION); } while (0)
+#define CHECK_NEAR(A, B, TOLERANCE) \
+    do { if (!(std::abs((A) - (B)) <= (TOLERANCE))) FrameworkTest::ReportFailure(__FILE__, __LINE__, #A " ~= " #B); } while (0)
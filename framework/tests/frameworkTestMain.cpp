@@ -0,0 +1,77 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "system/os_common.h"
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    struct Case
+    {
+        const char*             pName;
+        FrameworkTest::tCaseFn  Fn;
+        bool                    Benchmark;
+    };
+
+    std::vector<Case>& Cases()
+    {
+        static std::vector<Case> cases;    // function static so registration does not depend on static initialization order
+        return cases;
+    }
+
+    uint32_t gNumFailures = 0;
+}
+
+FrameworkTest::Registration::Registration(const char* pName, tCaseFn fn, bool benchmark)
+{
+    Cases().push_back({ pName, fn, benchmark });
+}
+
+void FrameworkTest::ReportFailure(const char* pFile, int line, const char* pExpression)
+{
+    LOGE("%s(%d): CHECK failed: %s", pFile, line, pExpression);
+    ++gNumFailures;
+}
+
+/// framework_tests [--bench] [name filter]
+/// Runs the tests (or the benchmarks) whose name contains the filter, returns non zero if any test failed.
+int main(int argc, const char* const* argv)
+{
+    bool benchmark = false;
+    const char* pFilter = nullptr;
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (strcmp(argv[arg], "--bench") == 0)
+            benchmark = true;
+        else
+            pFilter = argv[arg];
+    }
+
+    uint32_t numRun = 0;
+    uint32_t numFailedCases = 0;
+    for (const auto& testCase : Cases())
+    {
+        if (testCase.Benchmark != benchmark || (pFilter && !strstr(testCase.pName, pFilter)))
+            continue;
+        LOGI("[ RUN  ] %s", testCase.pName);
+        const uint32_t previousFailures = gNumFailures;
+        testCase.Fn();
+        ++numRun;
+        if (gNumFailures != previousFailures)
+        {
+            ++numFailedCases;
+            LOGI("[ FAIL ] %s", testCase.pName);
+        }
+        else
+            LOGI("[  OK  ] %s", testCase.pName);
+    }
+    LOGI("%u %s run, %u failed", numRun, benchmark ? "benchmarks" : "tests", numFailedCases);
+    return numFailedCases == 0 ? 0 : 1;
+}
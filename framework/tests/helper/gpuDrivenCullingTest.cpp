@@ -0,0 +1,169 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+// Tests of the cpu reference culling (which the application's culling shader must match), no device needed.
+// Most tests view through an identity ViewProjection, so a box's x and y are its ndc position and z its depth.
+
+#include "frameworkTest.hpp"
+#include "system/glm_common.hpp"
+#include "helper/gpuDrivenCulling.hpp"
+#include <vector>
+
+namespace
+{
+    GpuDrivenCulling::CullInstance MakeInstance(const glm::vec3& center, const glm::vec3& halfSize, uint32_t firstInstance)
+    {
+        return { glm::vec4(center, 0.0f), glm::vec4(halfSize, 0.0f), 36, firstInstance * 36, 0, firstInstance };
+    }
+
+    /// Depth buffer filled with depth, with an optional rectangle (in texels) of holeDepth.
+    std::vector<float> MakeDepth(uint32_t width, uint32_t height, float depth, glm::uvec4 hole = glm::uvec4(0), float holeDepth = 1.0f)
+    {
+        std::vector<float> depthBuffer(size_t(width) * height, depth);
+        for (uint32_t y = hole.y; y < hole.w; ++y)
+            for (uint32_t x = hole.x; x < hole.z; ++x)
+                depthBuffer[size_t(y) * width + x] = holeDepth;
+        return depthBuffer;
+    }
+}
+
+TEST_CASE(GpuDrivenCulling_FrustumTest)
+{
+    const auto params = GpuDrivenCulling::MakeCullParams(glm::mat4(1.0f), GpuDrivenCulling::FrustumCull, { 32, 32 }, 6, 100);
+    CHECK(GpuDrivenCulling::FrustumTest(MakeInstance({ 0.0f, 0.0f, 0.5f }, glm::vec3(0.1f), 0), params));
+    // Outside each side, and straddling an edge (kept).
+    CHECK(!GpuDrivenCulling::FrustumTest(MakeInstance({ -1.5f, 0.0f, 0.5f }, glm::vec3(0.2f), 0), params));
+    CHECK(!GpuDrivenCulling::FrustumTest(MakeInstance({ 0.0f, 1.5f, 0.5f }, glm::vec3(0.2f), 0), params));
+    CHECK(!GpuDrivenCulling::FrustumTest(MakeInstance({ 0.0f, 0.0f, 1.5f }, glm::vec3(0.2f), 0), params));
+    CHECK(GpuDrivenCulling::FrustumTest(MakeInstance({ 1.1f, 0.0f, 0.5f }, glm::vec3(0.2f), 0), params));
+    // Box containing the whole frustum.
+    CHECK(GpuDrivenCulling::FrustumTest(MakeInstance({ 0.0f, 0.0f, 0.0f }, glm::vec3(10.0f), 0), params));
+}
+
+TEST_CASE(GpuDrivenCulling_CullReferenceCompacts)
+{
+    std::vector<GpuDrivenCulling::CullInstance> instances;
+    for (uint32_t i = 0; i < 8; ++i)
+        instances.push_back(MakeInstance({ (i & 1) ? 5.0f : 0.0f, 0.0f, 0.5f }, glm::vec3(0.1f), i));     // odd instances are off screen
+
+    auto params = GpuDrivenCulling::MakeCullParams(glm::mat4(1.0f), GpuDrivenCulling::FrustumCull, { 32, 32 }, 6, (uint32_t)instances.size());
+    std::vector<VkDrawIndexedIndirectCommand> draws(instances.size());
+    CHECK(GpuDrivenCulling::CullReference(instances, params, nullptr, draws) == 4);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        // Survivors in instance order, with the instance's draw parameters.
+        CHECK(draws[i].firstInstance == i * 2 && draws[i].instanceCount == 1);
+        CHECK(draws[i].indexCount == 36 && draws[i].firstIndex == i * 2 * 36);
+    }
+
+    // No culling flags draws everything, limited by NumInstances and by the output size.
+    params.Flags = 0;
+    CHECK(GpuDrivenCulling::CullReference(instances, params, nullptr, draws) == 8);
+    params.NumInstances = 5;
+    CHECK(GpuDrivenCulling::CullReference(instances, params, nullptr, draws) == 5);
+    CHECK(GpuDrivenCulling::CullReference(instances, params, nullptr, std::span(draws).first(3)) == 3);
+}
+
+TEST_CASE(GpuDrivenCulling_HiZBuild)
+{
+    // Each mip texel holds the farthest depth of the texels it covers.
+    auto depth = MakeDepth(8, 8, 0.25f, { 5, 6, 6, 7 }, 0.75f);
+    const auto hiZ = GpuDrivenCulling::HiZReference::Build(depth, 8, 8, 3, false);
+    CHECK(hiZ.Width == 4 && hiZ.Height == 4 && hiZ.Mips.size() == 3);
+    CHECK(hiZ.Fetch(0, 2, 3) == 0.75f && hiZ.Fetch(0, 1, 3) == 0.25f && hiZ.Fetch(0, 2, 2) == 0.25f);
+    CHECK(hiZ.Fetch(1, 1, 1) == 0.75f && hiZ.Fetch(1, 0, 0) == 0.25f);
+    CHECK(hiZ.Fetch(2, 0, 0) == 0.75f);
+    // Fetch clamps to the mip edge.
+    CHECK(hiZ.Fetch(2, 5, 5) == 0.75f);
+
+    // Reverse z keeps the smallest depth.
+    const auto reverseHiZ = GpuDrivenCulling::HiZReference::Build(depth, 8, 8, 3, true);
+    CHECK(reverseHiZ.Fetch(0, 2, 3) == 0.25f && reverseHiZ.Fetch(2, 0, 0) == 0.25f);
+
+    // Odd sizes stay conservative: the last column of a 5 wide buffer is covered by mip 0 (2 wide).
+    auto oddDepth = MakeDepth(5, 5, 0.25f, { 4, 0, 5, 5 }, 0.75f);
+    const auto oddHiZ = GpuDrivenCulling::HiZReference::Build(oddDepth, 5, 5, 2, false);
+    CHECK(oddHiZ.Width == 2 && oddHiZ.Fetch(0, 1, 0) == 0.75f && oddHiZ.Fetch(0, 0, 0) == 0.25f);
+}
+
+TEST_CASE(GpuDrivenCulling_OcclusionTest)
+{
+    // Occluder at depth 0.5 covering the whole 64x64 depth buffer (Hi-Z 32x32, 6 mips).
+    auto depth = MakeDepth(64, 64, 0.5f);
+    const auto hiZ = GpuDrivenCulling::HiZReference::Build(depth, 64, 64, 6, false);
+    const auto params = GpuDrivenCulling::MakeCullParams(glm::mat4(1.0f), GpuDrivenCulling::FrustumCull | GpuDrivenCulling::OcclusionCull, { hiZ.Width, hiZ.Height }, 6, 4);
+
+    const auto behind = MakeInstance({ 0.1f, -0.2f, 0.75f }, { 0.1f, 0.1f, 0.05f }, 0);
+    const auto inFront = MakeInstance({ 0.1f, -0.2f, 0.25f }, { 0.1f, 0.1f, 0.05f }, 1);
+    const auto intersecting = MakeInstance({ 0.1f, -0.2f, 0.5f }, { 0.1f, 0.1f, 0.05f }, 2);
+    CHECK(GpuDrivenCulling::OcclusionTest(behind, params, hiZ));
+    CHECK(!GpuDrivenCulling::OcclusionTest(inFront, params, hiZ));
+    CHECK(!GpuDrivenCulling::OcclusionTest(intersecting, params, hiZ));
+
+    // Partially off screen boxes are tested against the on screen part.
+    CHECK(GpuDrivenCulling::OcclusionTest(MakeInstance({ 1.0f, 0.0f, 0.75f }, { 0.3f, 0.1f, 0.05f }, 3), params, hiZ));
+
+    const std::vector<GpuDrivenCulling::CullInstance> instances = { behind, inFront, intersecting, MakeInstance({ 5.0f, 0.0f, 0.25f }, glm::vec3(0.1f), 3) };
+    std::vector<VkDrawIndexedIndirectCommand> draws(instances.size());
+    CHECK(GpuDrivenCulling::CullReference(instances, params, &hiZ, draws) == 2);
+    CHECK(draws[0].firstInstance == 1 && draws[1].firstInstance == 2);
+
+    // A hole in the occluder (at the farthest depth) under part of the box makes it visible.
+    auto holeDepth = MakeDepth(64, 64, 0.5f, { 36, 22, 38, 24 });
+    const auto holeHiZ = GpuDrivenCulling::HiZReference::Build(holeDepth, 64, 64, 6, false);
+    CHECK(!GpuDrivenCulling::OcclusionTest(behind, params, holeHiZ));
+
+    // Boxes crossing the camera plane (w <= 0) are visible.
+    glm::mat4 perspective(1.0f);
+    perspective[2][3] = 1.0f;   // w = z
+    perspective[3][3] = 0.0f;
+    const auto perspectiveParams = GpuDrivenCulling::MakeCullParams(perspective, GpuDrivenCulling::OcclusionCull, { hiZ.Width, hiZ.Height }, 6, 1);
+    CHECK(!GpuDrivenCulling::OcclusionTest(MakeInstance({ 0.0f, 0.0f, 0.0f }, glm::vec3(0.5f), 0), perspectiveParams, hiZ));
+}
+
+TEST_CASE(GpuDrivenCulling_OcclusionTestReverseZ)
+{
+    // Reverse z: near is 1, the occluder at 0.5 hides boxes with a smaller depth.
+    auto depth = MakeDepth(64, 64, 0.5f);
+    const auto hiZ = GpuDrivenCulling::HiZReference::Build(depth, 64, 64, 6, true);
+    const auto params = GpuDrivenCulling::MakeCullParams(glm::mat4(1.0f), GpuDrivenCulling::OcclusionCull | GpuDrivenCulling::ReverseZ, { hiZ.Width, hiZ.Height }, 6, 1);
+    CHECK(GpuDrivenCulling::OcclusionTest(MakeInstance({ 0.0f, 0.0f, 0.25f }, { 0.1f, 0.1f, 0.05f }, 0), params, hiZ));
+    CHECK(!GpuDrivenCulling::OcclusionTest(MakeInstance({ 0.0f, 0.0f, 0.75f }, { 0.1f, 0.1f, 0.05f }, 0), params, hiZ));
+
+    auto holeDepth = MakeDepth(64, 64, 0.5f, { 30, 30, 32, 32 }, 0.0f);
+    const auto holeHiZ = GpuDrivenCulling::HiZReference::Build(holeDepth, 64, 64, 6, true);
+    CHECK(!GpuDrivenCulling::OcclusionTest(MakeInstance({ 0.0f, 0.0f, 0.25f }, { 0.1f, 0.1f, 0.05f }, 0), params, holeHiZ));
+}
+
+TEST_CASE(GpuDrivenCulling_OcclusionTestClampedMip)
+{
+    // Box covering most of the screen, behind the occluder apart from a hole in the middle.
+    // Its bounds are 26 texels across so need mip 5, a pyramid with fewer mips cannot cover it with the 4 texels sampled.
+    const auto largeBox = MakeInstance({ 0.0f, 0.0f, 0.75f }, { 0.8f, 0.8f, 0.05f }, 0);
+    auto holeDepth = MakeDepth(64, 64, 0.5f, { 30, 30, 34, 34 });
+    for (uint32_t numMips = 1; numMips <= 6; ++numMips)
+    {
+        const auto holeHiZ = GpuDrivenCulling::HiZReference::Build(holeDepth, 64, 64, numMips, false);
+        const auto params = GpuDrivenCulling::MakeCullParams(glm::mat4(1.0f), GpuDrivenCulling::OcclusionCull, { holeHiZ.Width, holeHiZ.Height }, numMips, 1);
+        CHECK(!GpuDrivenCulling::OcclusionTest(largeBox, params, holeHiZ));
+    }
+
+    // Without the hole it is culled when the mip chain reaches mip 5, and conservatively kept when it does not.
+    auto depth = MakeDepth(64, 64, 0.5f);
+    for (uint32_t numMips = 1; numMips <= 6; ++numMips)
+    {
+        const auto hiZ = GpuDrivenCulling::HiZReference::Build(depth, 64, 64, numMips, false);
+        const auto params = GpuDrivenCulling::MakeCullParams(glm::mat4(1.0f), GpuDrivenCulling::OcclusionCull, { hiZ.Width, hiZ.Height }, numMips, 1);
+        CHECK(GpuDrivenCulling::OcclusionTest(largeBox, params, hiZ) == (numMips >= 6));
+    }
+
+    // No mips at all, nothing is occluded.
+    const auto hiZ = GpuDrivenCulling::HiZReference::Build(depth, 64, 64, 1, false);
+    const auto params = GpuDrivenCulling::MakeCullParams(glm::mat4(1.0f), GpuDrivenCulling::OcclusionCull, { hiZ.Width, hiZ.Height }, 0, 1);
+    CHECK(!GpuDrivenCulling::OcclusionTest(MakeInstance({ 0.0f, 0.0f, 0.75f }, glm::vec3(0.01f), 0), params, hiZ));
+}
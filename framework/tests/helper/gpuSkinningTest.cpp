@@ -0,0 +1,218 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+// GpuSkinning::SkinReference (the SIMD cpu reference for the skinning compute shader) against a plain scalar implementation of
+// the same skinning, written with glm matrices and quaternions.
+
+#include "frameworkTest.hpp"
+#include "helper/gpuSkinning.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /// Joint matrices with rotations of up to maxAngle (radians), translations and (optionally non uniform, optionally mirrored) scales.
+    std::vector<glm::mat4> MakeJoints(uint32_t numJoints, float maxAngle, bool scaled, bool mirrored, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<glm::mat4> joints(numJoints);
+        for (auto& joint : joints)
+        {
+            glm::vec3 axis(unit(rng), unit(rng), unit(rng));
+            axis = glm::length(axis) > 0.001f ? glm::normalize(axis) : glm::vec3(0.0f, 1.0f, 0.0f);
+            glm::vec3 scale(1.0f);
+            if (scaled)
+                scale = glm::vec3(1.25f + 0.75f * unit(rng), 1.25f + 0.75f * unit(rng), 1.25f + 0.75f * unit(rng));
+            if (mirrored)
+                scale.x = -scale.x;
+            joint = glm::translate(glm::vec3(unit(rng), unit(rng), unit(rng)) * 2.0f) * glm::rotate(maxAngle * unit(rng), axis) * glm::scale(scale);
+        }
+        return joints;
+    }
+
+    /// Vertices influenced by up to 4 random joints (some with a single joint), unit normals.
+    std::vector<GpuSkinning::SkinVertex> MakeVertices(uint32_t numVertices, uint32_t numJoints, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<GpuSkinning::SkinVertex> vertices(numVertices);
+        for (uint32_t vertexIdx = 0; vertexIdx < numVertices; ++vertexIdx)
+        {
+            auto& vertex = vertices[vertexIdx];
+            vertex.Position = glm::vec4(unit(rng), unit(rng), unit(rng), 1.0f);
+            glm::vec3 normal(unit(rng), unit(rng), unit(rng));
+            normal = glm::length(normal) > 0.001f ? glm::normalize(normal) : glm::vec3(0.0f, 0.0f, 1.0f);
+            vertex.Normal = glm::vec4(normal, 0.0f);
+            const int numInfluences = vertexIdx % 5 == 0 ? 1 : 4;
+            float totalWeight = 0.0f;
+            for (int influence = 0; influence < 4; ++influence)
+            {
+                vertex.Joints[influence] = rng() % numJoints;
+                vertex.Weights[influence] = influence < numInfluences ? 0.1f + std::abs(unit(rng)) : 0.0f;
+                totalWeight += vertex.Weights[influence];
+            }
+            vertex.Weights /= totalWeight;
+        }
+        return vertices;
+    }
+
+    glm::mat4 BlendMatrices(const GpuSkinning::SkinVertex& vertex, std::span<const glm::mat4> joints)
+    {
+        glm::mat4 blended(0.0f);
+        for (int influence = 0; influence < 4; ++influence)
+            blended += joints[vertex.Joints[influence]] * vertex.Weights[influence];
+        return blended;
+    }
+
+    void SkinLinearBlendScalar(std::span<const GpuSkinning::SkinVertex> vertices, std::span<const glm::mat4> joints, std::span<glm::vec3> positionsOut, std::span<glm::vec3> normalsOut)
+    {
+        for (size_t vertexIdx = 0; vertexIdx < vertices.size(); ++vertexIdx)
+        {
+            const glm::mat4 blended = BlendMatrices(vertices[vertexIdx], joints);
+            positionsOut[vertexIdx] = glm::vec3(blended * glm::vec4(glm::vec3(vertices[vertexIdx].Position), 1.0f));
+            normalsOut[vertexIdx] = glm::normalize(glm::transpose(glm::inverse(glm::mat3(blended))) * glm::vec3(vertices[vertexIdx].Normal));
+        }
+    }
+
+    void SkinDualQuaternionScalar(std::span<const GpuSkinning::SkinVertex> vertices, std::span<const glm::mat4> joints, std::span<glm::vec3> positionsOut, std::span<glm::vec3> normalsOut)
+    {
+        // Rigid joints, dual quaternion from rotation and translation.
+        std::vector<glm::quat> reals(joints.size());
+        std::vector<glm::quat> duals(joints.size());
+        for (size_t jointIdx = 0; jointIdx < joints.size(); ++jointIdx)
+        {
+            reals[jointIdx] = glm::normalize(glm::quat_cast(glm::mat3(joints[jointIdx])));
+            const glm::vec3 translation(joints[jointIdx][3]);
+            duals[jointIdx] = glm::quat(0.0f, translation.x, translation.y, translation.z) * reals[jointIdx] * 0.5f;
+        }
+        for (size_t vertexIdx = 0; vertexIdx < vertices.size(); ++vertexIdx)
+        {
+            const auto& vertex = vertices[vertexIdx];
+            glm::quat real(0.0f, 0.0f, 0.0f, 0.0f);
+            glm::quat dual(0.0f, 0.0f, 0.0f, 0.0f);
+            for (int influence = 0; influence < 4; ++influence)
+            {
+                const uint32_t jointIdx = vertex.Joints[influence];
+                const float weight = glm::dot(reals[vertex.Joints[0]], reals[jointIdx]) < 0.0f ? -vertex.Weights[influence] : vertex.Weights[influence];
+                real = real + reals[jointIdx] * weight;
+                dual = dual + duals[jointIdx] * weight;
+            }
+            const float length = glm::length(real);
+            real = real / length;
+            dual = dual / length;
+            // Back to a rotation matrix and translation.
+            const glm::mat3 rotation = glm::mat3_cast(real);
+            const glm::quat translation = (dual * glm::conjugate(real)) * 2.0f;
+            positionsOut[vertexIdx] = rotation * glm::vec3(vertex.Position) + glm::vec3(translation.x, translation.y, translation.z);
+            normalsOut[vertexIdx] = rotation * glm::vec3(vertex.Normal);
+        }
+    }
+
+    float MaxDifference(std::span<const glm::vec3> a, std::span<const glm::vec3> b)
+    {
+        float maxDifference = 0.0f;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            const glm::vec3 difference = glm::abs(a[i] - b[i]);
+            maxDifference = std::max(maxDifference, std::max(difference.x, std::max(difference.y, difference.z)));
+        }
+        return maxDifference;
+    }
+}
+
+TEST_CASE(GpuSkinning_LinearBlendMatchesScalar)
+{
+    const std::vector<GpuSkinning::SkinVertex> vertices = MakeVertices(10000, 32, 1);
+    for (const bool mirrored : { false, true })
+    {
+        const std::vector<glm::mat4> joints = MakeJoints(32, 0.6f, true, mirrored, 2);
+        std::vector<glm::vec4> packedJoints;
+        GpuSkinning::PackJoints(joints, GpuSkinning::Mode::LinearBlend, packedJoints);
+
+        std::vector<glm::vec3> positions(vertices.size()), normals(vertices.size());
+        GpuSkinning::SkinReference(vertices, packedJoints, GpuSkinning::Mode::LinearBlend, positions, normals);
+        std::vector<glm::vec3> scalarPositions(vertices.size()), scalarNormals(vertices.size());
+        SkinLinearBlendScalar(vertices, joints, scalarPositions, scalarNormals);
+        CHECK(MaxDifference(positions, scalarPositions) < 0.0001f);
+        CHECK(MaxDifference(normals, scalarNormals) < 0.0001f);
+
+        // Non uniform scales, so normals transformed by the blended matrix (rather than its inverse transpose) would not stay
+        // perpendicular to the (skinned) surface.
+        float maxDot = 0.0f;
+        for (size_t vertexIdx = 0; vertexIdx < vertices.size(); ++vertexIdx)
+        {
+            const glm::vec3 normal(vertices[vertexIdx].Normal);
+            const glm::vec3 tangent = glm::normalize(glm::cross(normal, std::abs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f)));
+            const glm::vec3 skinnedTangent = glm::normalize(glm::mat3(BlendMatrices(vertices[vertexIdx], joints)) * tangent);
+            maxDot = std::max(maxDot, std::abs(glm::dot(skinnedTangent, normals[vertexIdx])));
+        }
+        CHECK(maxDot < 0.0001f);
+    }
+}
+
+TEST_CASE(GpuSkinning_DualQuaternionMatchesScalar)
+{
+    // Rigid joints, with any rotation (so blends cross quaternion hemispheres).
+    const std::vector<GpuSkinning::SkinVertex> vertices = MakeVertices(10000, 32, 3);
+    const std::vector<glm::mat4> joints = MakeJoints(32, 3.14159f, false, false, 4);
+    std::vector<glm::vec4> packedJoints;
+    GpuSkinning::PackJoints(joints, GpuSkinning::Mode::DualQuaternion, packedJoints);
+
+    std::vector<glm::vec3> positions(vertices.size()), normals(vertices.size());
+    GpuSkinning::SkinReference(vertices, packedJoints, GpuSkinning::Mode::DualQuaternion, positions, normals);
+    std::vector<glm::vec3> scalarPositions(vertices.size()), scalarNormals(vertices.size());
+    SkinDualQuaternionScalar(vertices, joints, scalarPositions, scalarNormals);
+    // Different (but equivalent) math for the rotation and translation, so slightly looser.
+    CHECK(MaxDifference(positions, scalarPositions) < 0.001f);
+    CHECK(MaxDifference(normals, scalarNormals) < 0.001f);
+}
+
+TEST_CASE(GpuSkinning_ThreadedMatchesSingleThreaded)
+{
+    const std::vector<GpuSkinning::SkinVertex> vertices = MakeVertices(50000, 32, 5);
+    const std::vector<glm::mat4> joints = MakeJoints(32, 0.6f, true, false, 6);
+    std::vector<glm::vec4> packedJoints;
+    GpuSkinning::PackJoints(joints, GpuSkinning::Mode::LinearBlend, packedJoints);
+
+    std::vector<glm::vec3> positions(vertices.size()), normals(vertices.size());
+    GpuSkinning::SkinReference(vertices, packedJoints, GpuSkinning::Mode::LinearBlend, positions, normals);
+
+    ThreadWorker worker;
+    worker.Initialize("GpuSkinningTest", 4);
+    std::vector<glm::vec3> threadedPositions(vertices.size()), threadedNormals(vertices.size());
+    GpuSkinning::SkinReference(vertices, packedJoints, GpuSkinning::Mode::LinearBlend, threadedPositions, threadedNormals, &worker);
+    CHECK(positions == threadedPositions);
+    CHECK(normals == threadedNormals);
+}
+
+BENCHMARK_CASE(GpuSkinning_ReferenceVersusScalar)
+{
+    const uint32_t numIterations = 20;
+    const std::vector<GpuSkinning::SkinVertex> vertices = MakeVertices(100000, 64, 7);
+    const std::vector<glm::mat4> joints = MakeJoints(64, 0.6f, true, false, 8);
+    std::vector<glm::vec3> positions(vertices.size()), normals(vertices.size());
+
+    for (const auto mode : { GpuSkinning::Mode::LinearBlend, GpuSkinning::Mode::DualQuaternion })
+    {
+        std::vector<glm::vec4> packedJoints;
+        GpuSkinning::PackJoints(joints, mode, packedJoints);
+        const double referenceMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { GpuSkinning::SkinReference(vertices, packedJoints, mode, positions, normals); });
+        const double scalarMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() {
+            if (mode == GpuSkinning::Mode::LinearBlend)
+                SkinLinearBlendScalar(vertices, joints, positions, normals);
+            else
+                SkinDualQuaternionScalar(vertices, joints, positions, normals);
+        });
+        LOGI("GpuSkinning %s: %zu vertices, reference %.1fus, scalar %.1fus (%.2fx)", mode == GpuSkinning::Mode::LinearBlend ? "linear blend" : "dual quaternion", vertices.size(), referenceMicroseconds, scalarMicroseconds, referenceMicroseconds > 0.0 ? scalarMicroseconds / referenceMicroseconds : 0.0);
+    }
+}
@@ -0,0 +1,159 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "camera/cameraFrustum.hpp"
+#include "helper/softwareOcclusion.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /// Box occluder (unit footprint, y from 0 to 1)
+    const glm::vec3 cBoxPositions[8] = {
+        { -0.5f, 0.0f, -0.5f }, { 0.5f, 0.0f, -0.5f }, { 0.5f, 0.0f, 0.5f }, { -0.5f, 0.0f, 0.5f },
+        { -0.5f, 1.0f, -0.5f }, { 0.5f, 1.0f, -0.5f }, { 0.5f, 1.0f, 0.5f }, { -0.5f, 1.0f, 0.5f },
+    };
+    const uint32_t cBoxIndices[36] = {
+        0, 2, 1, 0, 3, 2,   // bottom
+        4, 5, 6, 4, 6, 7,   // top
+        0, 1, 5, 0, 5, 4,   // -z
+        2, 3, 7, 2, 7, 6,   // +z
+        3, 0, 4, 3, 4, 7,   // -x
+        1, 2, 6, 1, 6, 5,   // +x
+    };
+
+    /// City (gridSize x gridSize blocks of box buildings, the occluders) with numObjects small boxes scattered through it, viewed from street level.
+    struct CityScene
+    {
+        CityScene(SoftwareOcclusion& occlusion, uint32_t gridSize, uint32_t numObjects)
+        {
+            // City blocks every 30 units (20x20 building footprint, 10 wide streets), buildings 10 to 60 high.
+            const float blockSpacing = 30.0f;
+            const float cityHalfSize = 0.5f * blockSpacing * (float)gridSize;
+            std::mt19937 random(1234);
+            std::uniform_real_distribution<float> buildingHeight(10.0f, 60.0f);
+            std::uniform_real_distribution<float> objectPosition(-cityHalfSize, cityHalfSize);
+            std::uniform_real_distribution<float> objectSize(1.0f, 4.0f);
+
+            BoxIdx = occlusion.AddOccluder(cBoxPositions, cBoxIndices);
+            Buildings.reserve(gridSize * gridSize);
+            for (uint32_t blockZ = 0; blockZ < gridSize; ++blockZ)
+            {
+                for (uint32_t blockX = 0; blockX < gridSize; ++blockX)
+                {
+                    const glm::vec3 center(((float)blockX + 0.5f) * blockSpacing - cityHalfSize, 0.0f, ((float)blockZ + 0.5f) * blockSpacing - cityHalfSize);
+                    Buildings.push_back({ BoxIdx, glm::scale(glm::translate(glm::mat4(1.0f), center), glm::vec3(20.0f, buildingHeight(random), 20.0f)) });
+                }
+            }
+
+            // Eye level, at the end of a street looking along it (and slightly across the blocks).
+            const glm::vec3 eye(0.0f, 2.0f, cityHalfSize + 10.0f);
+            ViewProjection = glm::perspectiveRH(glm::radians(60.0f), 2.0f, 0.5f, 2000.0f) * glm::lookAtRH(eye, glm::vec3(0.3f * cityHalfSize, 2.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+            // Only boxes in the frustum are occlusion tested.
+            const CameraFrustum frustum(ViewProjection);
+            for (uint32_t objectIdx = 0; objectIdx < numObjects; ++objectIdx)
+            {
+                glm::vec3 position(0.0f), size;
+                position.x = objectPosition(random);
+                position.z = objectPosition(random);
+                size.x = objectSize(random);
+                size.y = objectSize(random);
+                size.z = objectSize(random);
+                if (frustum.IsAabbVisible(position + 0.5f * size, 0.5f * size))
+                    Objects.push_back({ position, position + size });
+            }
+        }
+
+        uint32_t                                        BoxIdx = 0;
+        std::vector<SoftwareOcclusion::OccluderInstance> Buildings;
+        std::vector<SoftwareOcclusion::Aabb>            Objects;        ///< in the view frustum
+        glm::mat4                                       ViewProjection;
+    };
+}
+
+TEST_CASE(SoftwareOcclusion_BoxBehindWallCulled)
+{
+    SoftwareOcclusion occlusion;
+    CHECK(occlusion.Initialize(256, 128));
+    CHECK(occlusion.GetWidth() == 256 && occlusion.GetHeight() == 128);
+
+    // 40 wide, 20 high wall 20 units in front of a camera at the origin looking down -z.
+    const uint32_t boxIdx = occlusion.AddOccluder(cBoxPositions, cBoxIndices);
+    const SoftwareOcclusion::OccluderInstance wall{ boxIdx, glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -10.0f, -20.0f)), glm::vec3(40.0f, 20.0f, 1.0f)) };
+    const glm::mat4 viewProjection = glm::perspectiveRH(glm::radians(60.0f), 2.0f, 0.5f, 1000.0f) * glm::lookAtRH(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    occlusion.Render(viewProjection, std::span(&wall, 1));
+    CHECK(occlusion.GetNumBinnedTriangles() > 0);
+
+    const SoftwareOcclusion::Aabb aabbs[] = {
+        { glm::vec3(-1.0f, -1.0f, -51.0f), glm::vec3(1.0f, 1.0f, -49.0f) },     // behind the wall
+        { glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f) },      // in front of the wall
+        { glm::vec3(-1.0f, 30.0f, -51.0f), glm::vec3(1.0f, 32.0f, -49.0f) },    // behind, but above the wall
+        { glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f) },        // crossing the near plane
+    };
+    CHECK(!occlusion.IsAabbVisible(aabbs[0]));
+    CHECK(occlusion.IsAabbVisible(aabbs[1]));
+    CHECK(occlusion.IsAabbVisible(aabbs[2]));
+    CHECK(occlusion.IsAabbVisible(aabbs[3]));
+
+    uint32_t visible[4];
+    CHECK(occlusion.CullAabbs(aabbs, visible) == 3);
+    CHECK(visible[0] == 1 && visible[1] == 2 && visible[2] == 3);
+}
+
+TEST_CASE(SoftwareOcclusion_ParallelMatchesSingleThread)
+{
+    SoftwareOcclusion occlusion;
+    occlusion.Initialize(256, 128);
+    const CityScene city(occlusion, 8, 5000);
+    ThreadWorker worker;
+    worker.Initialize("SoftwareOcclusion", 4);
+
+    occlusion.Render(city.ViewProjection, city.Buildings);
+    const std::vector<float> depth(occlusion.GetDepthBuffer().begin(), occlusion.GetDepthBuffer().end());
+    std::vector<uint32_t> visible(city.Objects.size());
+    const uint32_t numVisible = occlusion.CullAabbs(city.Objects, visible);
+    // Most of a street level city is hidden behind the nearest buildings.
+    CHECK(numVisible > 0);
+    CHECK(numVisible < city.Objects.size() / 2);
+
+    occlusion.Render(city.ViewProjection, city.Buildings, &worker);
+    CHECK(std::equal(depth.begin(), depth.end(), occlusion.GetDepthBuffer().begin(), occlusion.GetDepthBuffer().end()));
+    std::vector<uint32_t> parallelVisible(city.Objects.size());
+    const uint32_t numParallelVisible = occlusion.CullAabbs(city.Objects, parallelVisible, &worker);
+    CHECK(std::equal(visible.begin(), visible.begin() + numVisible, parallelVisible.begin(), parallelVisible.begin() + numParallelVisible));
+
+    // Hierarchical z levels hold the farthest depth of the level above.
+    const auto& levels = occlusion.GetHiZLevels();
+    CHECK(levels.back().Width == 1 && levels.back().Height == 1);
+    CHECK(levels.back().Depth[0] == *std::max_element(depth.begin(), depth.end()));
+}
+
+BENCHMARK_CASE(SoftwareOcclusion_CityScene)
+{
+    const uint32_t numIterations = 10;
+    SoftwareOcclusion occlusion;
+    occlusion.Initialize(256, 128);
+    const CityScene city(occlusion, 16, 20000);
+    ThreadWorker worker;
+    worker.Initialize("SoftwareOcclusion", 4);
+    std::vector<uint32_t> visible(city.Objects.size());
+    uint32_t numVisible = 0;
+
+    const double renderMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { occlusion.Render(city.ViewProjection, city.Buildings); });
+    const double testMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { numVisible = occlusion.CullAabbs(city.Objects, visible); });
+    const double parallelRenderMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { occlusion.Render(city.ViewProjection, city.Buildings, &worker); });
+    const double parallelTestMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() { occlusion.CullAabbs(city.Objects, visible, &worker); });
+
+    LOGI("SoftwareOcclusion: %zu occluder instances (%zu triangles, %u binned), 20000 objects, %zu in frustum, %u visible", city.Buildings.size(), city.Buildings.size() * occlusion.GetNumOccluderTriangles(city.BoxIdx), occlusion.GetNumBinnedTriangles(), city.Objects.size(), numVisible);
+    LOGI("SoftwareOcclusion: render %.1fus (%u threads %.1fus), test %.1fus (%u threads %.1fus)", renderMicroseconds, worker.NumThreads(), parallelRenderMicroseconds, testMicroseconds, worker.NumThreads(), parallelTestMicroseconds);
+}
@@ -0,0 +1,139 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "light/light.hpp"
+#include "light/lightClusters.hpp"
+#include "light/lightList.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const float cFov = glm::radians(60.0f);
+    const float cAspect = 16.0f / 9.0f;
+    const float cNearPlane = 0.1f;
+    const float cFarPlane = 200.0f;
+
+    /// Random lights around (and mostly in front of) a camera at the origin looking down -z, half point and half spot.
+    LightList MakeRandomLights(uint32_t numLights, uint32_t seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<Light<PointLightData>> pointLights;
+        std::vector<Light<SpotLightData>> spotLights;
+        for (uint32_t i = 0; i < numLights; ++i)
+        {
+            const glm::vec3 position(unit(random) * 200.0f - 100.0f, unit(random) * 40.0f - 20.0f, unit(random) * -220.0f + 10.0f);
+            const float range = 1.0f + unit(random) * 7.0f;
+            if ((i & 1) == 0)
+            {
+                PointLightData data{};
+                data.Color = glm::vec3(1.0f);
+                data.Intensity = 1.0f;
+                data.NodeId = -1;
+                data.Position = position;
+                data.Range = range;
+                pointLights.emplace_back(data);
+            }
+            else
+            {
+                SpotLightData data{};
+                data.Color = glm::vec3(1.0f);
+                data.Intensity = 1.0f;
+                data.NodeId = -1;
+                data.Position = position;
+                data.Range = range;
+                data.Direction = glm::normalize(glm::vec3(unit(random) - 0.5f, unit(random) - 0.5f, unit(random) - 0.5f) + glm::vec3(0.0f, 0.0f, 1e-3f));
+                data.SpotAngle = 0.2f + unit(random);
+                spotLights.emplace_back(data);
+            }
+        }
+        return LightList(std::move(pointLights), std::move(spotLights), {}, {});
+    }
+
+    /// @return number of clusters where the two binnings have different light lists
+    uint32_t CountMismatchedClusters(const LightClusters& clusters, const LightClusters& reference)
+    {
+        uint32_t numMismatched = 0;
+        for (size_t clusterIdx = 0; clusterIdx < clusters.GetClusters().size(); ++clusterIdx)
+        {
+            const auto& cluster = clusters.GetClusters()[clusterIdx];
+            const auto& referenceCluster = reference.GetClusters()[clusterIdx];
+            const auto lightIndices = clusters.GetLightIndices().begin() + cluster.Offset;
+            if (cluster.Count != referenceCluster.Count || !std::equal(lightIndices, lightIndices + cluster.Count, reference.GetLightIndices().begin() + referenceCluster.Offset))
+                ++numMismatched;
+        }
+        return numMismatched;
+    }
+}
+
+TEST_CASE(LightClusters_BuildMatchesReference)
+{
+    const LightList lightList = MakeRandomLights(1000, 1234);
+    const glm::mat4 viewMatrix(1.0f);
+
+    LightClusters reference;
+    reference.BuildReference(viewMatrix, cFov, cAspect, cNearPlane, cFarPlane, lightList);
+    LightClusters clusters;
+    clusters.Build(viewMatrix, cFov, cAspect, cNearPlane, cFarPlane, lightList);
+    CHECK(clusters.GetClusters().size() == size_t(clusters.GetNumX() * clusters.GetNumY() * clusters.GetNumZ()));
+    CHECK(clusters.GetClusters().size() == reference.GetClusters().size());
+    CHECK(!clusters.GetLightIndices().empty());
+    CHECK(clusters.GetLightIndices().size() == reference.GetLightIndices().size());
+    CHECK(CountMismatchedClusters(clusters, reference) == 0);
+
+    // Split across threads gives the same (ordered) output.
+    ThreadWorker worker;
+    worker.Initialize("LightClusters", 4);
+    LightClusters parallelClusters;
+    parallelClusters.Build(viewMatrix, cFov, cAspect, cNearPlane, cFarPlane, lightList, &worker);
+    CHECK(parallelClusters.GetLightIndices() == clusters.GetLightIndices());
+    CHECK(CountMismatchedClusters(parallelClusters, reference) == 0);
+}
+
+TEST_CASE(LightClusters_LightBehindCameraInNoCluster)
+{
+    PointLightData data{};
+    data.Color = glm::vec3(1.0f);
+    data.Intensity = 1.0f;
+    data.NodeId = -1;
+    data.Position = glm::vec3(0.0f, 0.0f, 10.0f);
+    data.Range = 1.0f;
+    std::vector<Light<PointLightData>> pointLights;
+    pointLights.emplace_back(data);
+    const LightList lightList(std::move(pointLights), {}, {}, {});
+
+    LightClusters clusters;
+    clusters.Build(glm::mat4(1.0f), cFov, cAspect, cNearPlane, cFarPlane, lightList);
+    CHECK(clusters.GetLightIndices().empty());
+    CHECK(clusters.GetClusterParams().NumLights == 1);
+}
+
+BENCHMARK_CASE(LightClusters_BinningTiming)
+{
+    const uint32_t numLights = 10000;
+    const uint32_t numFrames = 10;
+    const LightList lightList = MakeRandomLights(numLights, 1234);
+    const glm::mat4 viewMatrix(1.0f);
+    ThreadWorker worker;
+    worker.Initialize("LightClusters", 4);
+
+    LightClusters reference;
+    const double referenceMicroseconds = FrameworkTest::TimeMicroseconds(numFrames, [&]() { reference.BuildReference(viewMatrix, cFov, cAspect, cNearPlane, cFarPlane, lightList); });
+    LightClusters clusters;
+    const double simdMicroseconds = FrameworkTest::TimeMicroseconds(numFrames, [&]() { clusters.Build(viewMatrix, cFov, cAspect, cNearPlane, cFarPlane, lightList); });
+    const double parallelMicroseconds = FrameworkTest::TimeMicroseconds(numFrames, [&]() { clusters.Build(viewMatrix, cFov, cAspect, cNearPlane, cFarPlane, lightList, &worker); });
+
+    LOGI("LightClusters: %u lights, %zu clusters, %zu light indices", numLights, clusters.GetClusters().size(), clusters.GetLightIndices().size());
+    LOGI("LightClusters: reference %.1fus, simd %.1fus (%.2fx), %u mismatched clusters", referenceMicroseconds, simdMicroseconds, simdMicroseconds > 0.0 ? referenceMicroseconds / simdMicroseconds : 0.0, CountMismatchedClusters(clusters, reference));
+    LOGI("LightClusters: simd on %u threads %.1fus", worker.NumThreads(), parallelMicroseconds);
+}
@@ -0,0 +1,201 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+// DrawQueue and DrawStateCache make no graphics api calls, so draws are 'recorded' in to a stub command buffer that just stores
+// the commands.  Replaying the stub checks every draw sees exactly the state it asked for.
+
+#include "frameworkTest.hpp"
+#include "material/drawQueue.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    enum class Command { BindPipeline, BindDescriptorSet, BindVertexBuffers, BindIndexBuffer, Draw };
+
+    /// Command buffer stand in, records the commands (and their state) in order.
+    struct RecordingCommandBuffer
+    {
+        struct Entry
+        {
+            Command             Cmd;
+            DrawStateHandles    State;
+            uint32_t            DrawIdx = 0;
+        };
+        std::vector<Entry> Entries;
+
+        void Record(Command cmd, const DrawStateHandles& state)   { Entries.push_back({ cmd, state }); }
+        void Draw(uint32_t drawIdx)                             { Entries.push_back({ Command::Draw, {}, drawIdx }); }
+        size_t NumBinds() const                                 { return Entries.size() - std::count_if(Entries.begin(), Entries.end(), [](const Entry& e) { return e.Cmd == Command::Draw; }); }
+    };
+
+    /// Same pattern as Drawable<Vulkan>::DrawPass
+    void RecordDraw(RecordingCommandBuffer& cmdBuffer, DrawStateCache& cache, const DrawState& state, uint32_t drawIdx)
+    {
+        if (cache.BindPipeline(state.Pipeline))
+            cmdBuffer.Record(Command::BindPipeline, state.Pipeline);
+        if (!state.DescriptorSet.empty() && cache.BindDescriptorSet(state.DescriptorSet))
+            cmdBuffer.Record(Command::BindDescriptorSet, state.DescriptorSet);
+        if (!state.VertexBuffers.empty() && cache.BindVertexBuffers(state.VertexBuffers))
+            cmdBuffer.Record(Command::BindVertexBuffers, state.VertexBuffers);
+        if (!state.IndexBuffer.empty() && cache.BindIndexBuffer(state.IndexBuffer))
+            cmdBuffer.Record(Command::BindIndexBuffer, state.IndexBuffer);
+        cache.CountDraw();
+        cmdBuffer.Draw(drawIdx);
+    }
+
+    /// Replay the recorded commands and check each draw had the state it was added with.
+    bool ReplayMatches(const RecordingCommandBuffer& cmdBuffer, std::span<const DrawState> drawStates)
+    {
+        DrawState bound;
+        for (const auto& entry : cmdBuffer.Entries)
+        {
+            switch (entry.Cmd)
+            {
+            case Command::BindPipeline:      bound.Pipeline = entry.State; break;
+            case Command::BindDescriptorSet: bound.DescriptorSet = entry.State; break;
+            case Command::BindVertexBuffers: bound.VertexBuffers = entry.State; break;
+            case Command::BindIndexBuffer:   bound.IndexBuffer = entry.State; break;
+            case Command::Draw:
+            {
+                const DrawState& wanted = drawStates[entry.DrawIdx];
+                if (bound.Pipeline != wanted.Pipeline || bound.DescriptorSet != wanted.DescriptorSet || bound.VertexBuffers != wanted.VertexBuffers || bound.IndexBuffer != wanted.IndexBuffer)
+                    return false;
+                break;
+            }
+            }
+        }
+        return true;
+    }
+
+    /// Draws from a small set of pipelines/materials/meshes, vertex buffers share a buffer at different offsets (as sub allocated meshes do).
+    std::vector<DrawState> MakeDrawStates(uint32_t numDraws, uint32_t numPipelines, uint32_t numMaterials, uint32_t numMeshes, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<DrawState> states(numDraws);
+        for (auto& state : states)
+        {
+            const uint64_t pipeline = 0x1000 + rng() % numPipelines;
+            const uint64_t material = 0x2000 + rng() % numMaterials;
+            const uint64_t mesh = rng() % numMeshes;
+            state.Pipeline = { pipeline };
+            state.DescriptorSet = { material, 0x3000 + pipeline };
+            state.VertexBuffers = { 0x4000, mesh * 4096, 0x5000, 0 };
+            state.IndexBuffer = { 0x6000 + (mesh & 1), 1 };
+        }
+        return states;
+    }
+}
+
+TEST_CASE(DrawStateCache_SkipsOnlyIdenticalState)
+{
+    DrawStateCache cache;
+    CHECK(cache.BindVertexBuffers({ 0x10, 0 }));
+    CHECK(!cache.BindVertexBuffers({ 0x10, 0 }));
+    // Same buffer, different offset must be bound.
+    CHECK(cache.BindVertexBuffers({ 0x10, 256 }));
+    // Same handles in a different arrangement are different state.
+    CHECK(cache.BindDescriptorSet({ 0x20, 0x30 }));
+    CHECK(cache.BindDescriptorSet({ 0x30, 0x20 }));
+    CHECK(cache.BindDescriptorSet({ 0x30, 0x20, 1 }));
+    CHECK(!cache.BindDescriptorSet({ 0x30, 0x20, 1 }));
+    // Everything binds again after a reset.
+    cache.Reset();
+    CHECK(cache.BindVertexBuffers({ 0x10, 256 }));
+
+    const auto& stats = cache.GetStats();
+    CHECK(stats.VertexBuffers.Bound == 3 && stats.VertexBuffers.Skipped == 1);
+    CHECK(stats.DescriptorSet.Bound == 3 && stats.DescriptorSet.Skipped == 1);
+}
+
+TEST_CASE(DrawStateCache_OverflowedStateAlwaysBinds)
+{
+    DrawStateHandles many;
+    for (uint64_t i = 0; i <= DrawStateHandles::cMaxHandles; ++i)
+        many.Push(0x100 + i);
+    CHECK(many.Overflowed && !many.empty());
+
+    DrawStateCache cache;
+    CHECK(cache.BindVertexBuffers(many));
+    CHECK(cache.BindVertexBuffers(many));
+    // And does not leave the cache thinking something else is bound.
+    CHECK(cache.BindVertexBuffers({ 0x100 }));
+    CHECK(!cache.BindVertexBuffers({ 0x100 }));
+}
+
+TEST_CASE(DrawQueue_SortedReplayMatchesRequestedState)
+{
+    const std::vector<DrawState> states = MakeDrawStates(2000, 4, 16, 32, 1);
+    DrawQueue<uint32_t> queue;
+    for (uint32_t i = 0; i < (uint32_t) states.size(); ++i)
+        queue.Add(states[i], float(i % 97) / 97.0f, i);
+
+    RecordingCommandBuffer cmdBuffer;
+    DrawStateCache cache;
+    queue.ForEachSorted([&](const DrawQueue<uint32_t>::Item& item) { RecordDraw(cmdBuffer, cache, item.State, item.Payload); });
+
+    CHECK(cache.GetStats().Draws == states.size());
+    CHECK(ReplayMatches(cmdBuffer, states));
+    // Sorted by pipeline first, so each pipeline is bound once.
+    CHECK(cache.GetStats().Pipeline.Bound == 4);
+    CHECK(cmdBuffer.NumBinds() == cache.GetStats().BindsIssued());
+    CHECK(cache.GetStats().BindsAvoided() > cache.GetStats().BindsIssued());
+}
+
+TEST_CASE(DrawQueue_BackToFrontOrdersByDepth)
+{
+    const std::vector<DrawState> states = MakeDrawStates(256, 3, 5, 7, 2);
+    DrawQueue<float> queue(DrawSortMode::BackToFront);
+    std::mt19937 rng(3);
+    for (const auto& state : states)
+    {
+        const float depth = float(rng() % 1000) / 1000.0f;
+        queue.Add(state, depth, depth);
+    }
+    float lastDepth = 2.0f;
+    bool ordered = true;
+    queue.ForEachSorted([&](const DrawQueue<float>::Item& item) {
+        ordered = ordered && item.Payload <= lastDepth;
+        lastDepth = item.Payload;
+    });
+    CHECK(ordered);
+}
+
+BENCHMARK_CASE(DrawQueue_RecordSortedVersusUnsorted)
+{
+    const std::vector<DrawState> states = MakeDrawStates(10000, 8, 64, 128, 4);
+    const uint32_t numIterations = 20;
+
+    size_t unsortedCommands = 0;
+    const double unsortedMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() {
+        RecordingCommandBuffer cmdBuffer;
+        cmdBuffer.Entries.reserve(states.size() * 5);
+        DrawStateCache cache;
+        for (uint32_t i = 0; i < (uint32_t) states.size(); ++i)
+            RecordDraw(cmdBuffer, cache, states[i], i);
+        unsortedCommands = cmdBuffer.Entries.size();
+    });
+
+    size_t sortedCommands = 0;
+    DrawQueue<uint32_t> queue;
+    const double sortedMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() {
+        queue.Clear();
+        for (uint32_t i = 0; i < (uint32_t) states.size(); ++i)
+            queue.Add(states[i], float(i & 1023) / 1023.0f, i);
+        RecordingCommandBuffer cmdBuffer;
+        cmdBuffer.Entries.reserve(states.size() * 5);
+        DrawStateCache cache;
+        queue.ForEachSorted([&](const DrawQueue<uint32_t>::Item& item) { RecordDraw(cmdBuffer, cache, item.State, item.Payload); });
+        sortedCommands = cmdBuffer.Entries.size();
+    });
+
+    LOGI("DrawQueue: %zu draws, in submission order %zu commands (%.1fus), sorted %zu commands (%.1fus including the sort)",
+         states.size(), unsortedCommands, unsortedMicroseconds, sortedCommands, sortedMicroseconds);
+}
@@ -0,0 +1,144 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+// FrameRingAllocator (the FrameRingBuffer sub-allocator) against fake fences, no device needed.
+
+#include "frameworkTest.hpp"
+#include "vulkan/frameRingBuffer.hpp"
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    struct FakeFenceState
+    {
+        bool        Signalled = false;
+        uint32_t    Waits = 0;
+    };
+
+    /// Fence the test signals by hand.  Wait 'completes the gpu work' (signals) and counts the wait.
+    struct FakeFence
+    {
+        std::shared_ptr<FakeFenceState> pState = std::make_shared<FakeFenceState>();
+        bool IsSignalled() const    { return pState->Signalled; }
+        void Wait() const           { ++pState->Waits; pState->Signalled = true; }
+    };
+
+    typedef std::vector<std::pair<size_t, size_t>> tRanges;   ///< offset, size
+
+    tRanges TakeUnflushed(FrameRingAllocator<FakeFence>& ring)
+    {
+        tRanges ranges;
+        ring.TakeUnflushedRanges([&](size_t offset, size_t size) { ranges.push_back({ offset, size }); });
+        return ranges;
+    }
+}
+
+TEST_CASE(FrameRingAllocator_Wraparound)
+{
+    FrameRingAllocator<FakeFence> ring(1024);
+    FakeFence fences[2];
+    ring.BeginFrame(0, fences[0]);
+    CHECK(ring.Allocate(400, 16) == 0);
+    ring.BeginFrame(1, fences[1]);
+    CHECK(ring.Allocate(390, 16) == 400);
+    CHECK(ring.GetNumFramesInFlight() == 1 && ring.GetUsed() == 790);
+
+    // Frame 0 is done (the caller waited on its fence before reusing index 0), so its space is free.
+    ring.BeginFrame(0, FakeFence{});
+    CHECK(ring.GetNumFramesInFlight() == 1 && ring.GetUsed() == 390);
+    // Aligned to 800, does not fit before the end of the ring so skips back to the start.
+    CHECK(ring.Allocate(400, 16) == 0);
+    CHECK(ring.GetUsed() == 390 + 10 + 224 + 400);
+    CHECK(ring.GetFrameUsed() == 10 + 224 + 400);
+    CHECK(ring.GetStats().BytesAllocated == 400 + 390 + 10 + 224 + 400);
+    CHECK(ring.GetStats().FenceWaits == 0 && fences[1].pState->Waits == 0);
+
+    // Empty and larger than the ring allocations always fail.
+    CHECK(ring.Allocate(0, 16) == FrameRingAllocator<FakeFence>::cInvalidOffset);
+    CHECK(ring.Allocate(2000, 16) == FrameRingAllocator<FakeFence>::cInvalidOffset);
+    CHECK(ring.GetStats().FailedAllocations == 2);
+}
+
+TEST_CASE(FrameRingAllocator_WaitsOnUnsignalledFence)
+{
+    FrameRingAllocator<FakeFence> ring(1024);
+    FakeFence fence0, fence1;
+    ring.BeginFrame(0, fence0);
+    CHECK(ring.Allocate(768, 256) == 0);
+    ring.BeginFrame(1, fence1);
+
+    // Frame 0 is still on the gpu: without waiting the allocation fails, the ring is untouched.
+    CHECK(ring.Allocate(512, 256, false) == FrameRingAllocator<FakeFence>::cInvalidOffset);
+    CHECK(ring.GetStats().FailedAllocations == 1 && fence0.pState->Waits == 0);
+    CHECK(ring.GetUsed() == 768 && ring.GetNumFramesInFlight() == 1);
+
+    // With waiting it blocks on frame 0 (once) then reuses its space.
+    CHECK(ring.Allocate(512, 256) == 0);
+    CHECK(fence0.pState->Waits == 1 && ring.GetStats().FenceWaits == 1);
+    CHECK(ring.GetNumFramesInFlight() == 0 && ring.GetUsed() == 256 + 512);
+
+    // Current frame alone filling the ring fails (there is nothing to wait on).
+    CHECK(ring.Allocate(512, 256) == FrameRingAllocator<FakeFence>::cInvalidOffset);
+    CHECK(fence1.pState->Waits == 0);
+}
+
+TEST_CASE(FrameRingAllocator_ReuseAfterSignal)
+{
+    FrameRingAllocator<FakeFence> ring(1024);
+    FakeFence fences[3];
+    for (uint32_t frame = 0; frame < 3; ++frame)
+    {
+        ring.BeginFrame(frame, fences[frame]);
+        CHECK(ring.Allocate(256, 256) == frame * 256);
+    }
+    CHECK(ring.GetNumFramesInFlight() == 2);
+
+    // Signalled frames are released at the next BeginFrame (oldest first, stopping at the first unsignalled one).
+    fences[1].pState->Signalled = true;
+    ring.BeginFrame(3, FakeFence{});
+    CHECK(ring.GetNumFramesInFlight() == 3 && ring.GetUsed() == 768);
+    fences[0].pState->Signalled = true;
+    ring.BeginFrame(4, FakeFence{});
+    CHECK(ring.GetNumFramesInFlight() == 2 && ring.GetUsed() == 256);
+
+    // Released space is reused without waiting (does not fit at the end, so wraps to frame 0 and 1's space).
+    CHECK(ring.Allocate(512, 256) == 0);
+    CHECK(ring.GetStats().FenceWaits == 0);
+    for (const auto& fence : fences)
+        CHECK(fence.pState->Waits == 0);
+
+    ring.Reset(512);
+    CHECK(ring.GetCapacity() == 512 && ring.GetUsed() == 0 && ring.GetNumFramesInFlight() == 0);
+}
+
+TEST_CASE(FrameRingAllocator_UnflushedRanges)
+{
+    FrameRingAllocator<FakeFence> ring(1024);
+    CHECK(TakeUnflushed(ring).empty());
+    ring.BeginFrame(0, FakeFence{});
+    ring.Allocate(100, 16);
+    ring.Allocate(100, 16);
+    CHECK(TakeUnflushed(ring) == tRanges({ { 0, 212 } }));
+    CHECK(TakeUnflushed(ring).empty());
+
+    // Range that wraps is split in two.
+    ring.BeginFrame(1, FakeFence{});
+    ring.Allocate(700, 16);
+    ring.BeginFrame(0, FakeFence{});
+    ring.Allocate(50, 16);
+    ring.Allocate(200, 16);
+    CHECK(TakeUnflushed(ring) == tRanges({ { 212, 1024 - 212 }, { 0, 200 } }));
+
+    // Space released before it was flushed is skipped.
+    ring.Allocate(16, 16);
+    ring.BeginFrame(1, FakeFence{});
+    ring.BeginFrame(0, FakeFence{});
+    CHECK(TakeUnflushed(ring).empty());
+}
@@ -0,0 +1,196 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+// UploadManager ring and batching logic against a mock backend (no device).  The mock only 'executes' a batch's copies (reading the
+// staging memory) when the batch completes, so staging memory reused too early shows up as corrupt destination contents.
+
+#include "frameworkTest.hpp"
+#include "memory/vulkan/uploadManager.hpp"
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace
+{
+    VkBuffer FakeBuffer(uint64_t value)
+    {
+        return (VkBuffer) (uintptr_t) value;
+    }
+
+    class MockBackend final : public UploadManager::Backend
+    {
+    public:
+        explicit MockBackend(size_t stagingSize) : m_Staging(stagingSize) {}
+
+        std::span<std::byte> GetStagingMemory() override      { return m_Staging; }
+        bool Submit(std::span<const UploadManager::DestinationCopies> copies, UploadManager::Ticket ticket) override
+        {
+            Batch batch{ ticket };
+            for (const auto& destination : copies)
+                for (const auto& region : destination.Regions)
+                    batch.Copies.push_back({ destination.Buffer, region });
+            m_Submitted.push_back(std::move(batch));
+            return true;
+        }
+        UploadManager::Ticket GetCompletedTicket() const override  { return m_Completed; }
+        void Wait(UploadManager::Ticket ticket) const override
+        {
+            // Completing batches is not really const, but the 'gpu' is outside the UploadManager.
+            const_cast<MockBackend*>(this)->Complete(ticket);
+        }
+
+        /// Execute (copy from staging) all the submitted batches up to and including ticket.
+        void Complete(UploadManager::Ticket ticket)
+        {
+            while (!m_Submitted.empty() && m_Submitted.front().Ticket <= ticket)
+            {
+                for (const auto& [buffer, region] : m_Submitted.front().Copies)
+                {
+                    auto& destination = Destinations[buffer];
+                    if (destination.size() < region.dstOffset + region.size)
+                        destination.resize(region.dstOffset + region.size);
+                    std::memcpy(destination.data() + region.dstOffset, m_Staging.data() + region.srcOffset, region.size);
+                }
+                m_Completed = m_Submitted.front().Ticket;
+                m_Submitted.erase(m_Submitted.begin());
+            }
+        }
+        size_t NumInFlight() const                              { return m_Submitted.size(); }
+
+        std::map<VkBuffer, std::vector<std::byte>> Destinations;
+
+    private:
+        struct Batch
+        {
+            UploadManager::Ticket Ticket;
+            std::vector<std::pair<VkBuffer, VkBufferCopy>> Copies;
+        };
+        std::vector<std::byte>  m_Staging;
+        std::vector<Batch>      m_Submitted;
+        UploadManager::Ticket   m_Completed = UploadManager::cInvalidTicket;
+    };
+
+    std::vector<std::byte> MakeData(size_t size, uint32_t seed)
+    {
+        std::vector<std::byte> data(size);
+        for (size_t i = 0; i < size; ++i)
+            data[i] = std::byte(uint8_t((i * 31 + seed * 17) ^ (i >> 8)));
+        return data;
+    }
+
+    bool Matches(const std::vector<std::byte>& destination, size_t offset, const std::vector<std::byte>& data)
+    {
+        return destination.size() >= offset + data.size() && std::memcmp(destination.data() + offset, data.data(), data.size()) == 0;
+    }
+}
+
+TEST_CASE(UploadManager_DataArrivesOnCompletion)
+{
+    auto backend = std::make_unique<MockBackend>(4096);
+    MockBackend& mock = *backend;
+    UploadManager uploadManager;
+    CHECK(uploadManager.Initialize({}, std::move(backend)));
+
+    const VkBuffer buffer = FakeBuffer(0x100);
+    const auto data = MakeData(300, 1);
+    const UploadManager::Ticket ticket = uploadManager.Upload<std::byte>(buffer, 64, data);
+    CHECK(ticket != UploadManager::cInvalidTicket);
+    CHECK(!uploadManager.IsComplete(ticket));
+    CHECK(uploadManager.Flush() == ticket);
+    CHECK(mock.Destinations.empty());
+
+    uploadManager.Wait(ticket);
+    CHECK(uploadManager.IsComplete(ticket));
+    CHECK(Matches(mock.Destinations[buffer], 64, data));
+    uploadManager.Destroy();
+}
+
+TEST_CASE(UploadManager_CoalescesContiguousUploads)
+{
+    auto backend = std::make_unique<MockBackend>(8192);
+    MockBackend& mock = *backend;
+    UploadManager uploadManager;
+    CHECK(uploadManager.Initialize({}, std::move(backend)));
+
+    // Aligned sizes so consecutive uploads are also contiguous in the staging ring.
+    const VkBuffer buffer = FakeBuffer(0x100);
+    const auto data = MakeData(16 * 64, 2);
+    for (size_t i = 0; i < 16; ++i)
+        uploadManager.Upload<std::byte>(buffer, i * 64, std::span(data).subspan(i * 64, 64));
+    uploadManager.WaitIdle();
+
+    CHECK(uploadManager.GetStats().Uploads == 16);
+    CHECK(uploadManager.GetStats().Submits == 1);
+    CHECK(uploadManager.GetStats().Copies == 1);
+    CHECK(Matches(mock.Destinations[buffer], 0, data));
+    uploadManager.Destroy();
+}
+
+TEST_CASE(UploadManager_OverlappingUploadsKeepOrder)
+{
+    auto backend = std::make_unique<MockBackend>(4096);
+    MockBackend& mock = *backend;
+    UploadManager uploadManager;
+    CHECK(uploadManager.Initialize({}, std::move(backend)));
+
+    const VkBuffer buffer = FakeBuffer(0x100);
+    const auto first = MakeData(128, 3);
+    const auto second = MakeData(64, 4);
+    const UploadManager::Ticket firstTicket = uploadManager.Upload<std::byte>(buffer, 0, first);
+    const UploadManager::Ticket secondTicket = uploadManager.Upload<std::byte>(buffer, 32, second);
+    CHECK(secondTicket == firstTicket + 1);
+    CHECK(uploadManager.GetStats().OverlapFlushes == 1);
+    uploadManager.WaitIdle();
+
+    auto expected = first;
+    std::copy(second.begin(), second.end(), expected.begin() + 32);
+    CHECK(Matches(mock.Destinations[buffer], 0, expected));
+    uploadManager.Destroy();
+}
+
+TEST_CASE(UploadManager_RingReusedOnlyAfterCompletion)
+{
+    // Small ring and batches, many uploads without the 'gpu' completing anything unless the ring has to wait.
+    auto backend = std::make_unique<MockBackend>(1024);
+    MockBackend& mock = *backend;
+    UploadManager uploadManager;
+    CHECK(uploadManager.Initialize({ .FlushThreshold = 256, .MaxCopiesPerSubmit = 4 }, std::move(backend)));
+
+    std::vector<std::vector<std::byte>> uploads;
+    for (uint32_t i = 0; i < 40; ++i)
+    {
+        uploads.push_back(MakeData(96 + (i % 5) * 16, 10 + i));
+        CHECK(uploadManager.Upload<std::byte>(FakeBuffer(0x100 + (i % 3)), (i / 3) * 256, uploads.back()) != UploadManager::cInvalidTicket);
+    }
+    CHECK(uploadManager.GetStats().RingWaits > 0);
+    uploadManager.WaitIdle();
+    CHECK(mock.NumInFlight() == 0);
+
+    bool allMatch = true;
+    for (uint32_t i = 0; i < 40; ++i)
+        allMatch = allMatch && Matches(mock.Destinations[FakeBuffer(0x100 + (i % 3))], (i / 3) * 256, uploads[i]);
+    CHECK(allMatch);
+    uploadManager.Destroy();
+}
+
+TEST_CASE(UploadManager_SplitsUploadsLargerThanTheRing)
+{
+    auto backend = std::make_unique<MockBackend>(1024);
+    MockBackend& mock = *backend;
+    UploadManager uploadManager;
+    CHECK(uploadManager.Initialize({}, std::move(backend)));
+
+    const VkBuffer buffer = FakeBuffer(0x200);
+    const auto data = MakeData(5000, 5);
+    const UploadManager::Ticket ticket = uploadManager.Upload<std::byte>(buffer, 16, data);
+    CHECK(ticket != UploadManager::cInvalidTicket);
+    uploadManager.Wait(ticket);
+    CHECK(Matches(mock.Destinations[buffer], 16, data));
+    CHECK(uploadManager.GetStats().BytesUploaded == data.size());
+    uploadManager.Destroy();
+}
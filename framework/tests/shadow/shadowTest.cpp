@@ -0,0 +1,237 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+// Cascaded shadow fitting (Shadow::CalcCascadeSplits, FitCascade and Update) and per cascade caster culling.  All cpu math, no device.
+
+#include "frameworkTest.hpp"
+#include "mesh/octree.hpp"
+#include "shadow/shadow.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    constexpr float cEyeFov = 1.0f;
+    constexpr float cEyeAspect = 1.5f;
+
+    /// Corners of the eye frustum slice between splitNear and splitFar (eye view space, looking down -z).
+    std::array<glm::vec4, 8> SliceCorners(float fov, float aspect, float splitNear, float splitFar)
+    {
+        const float tanHalfFov = std::tan(fov * 0.5f);
+        std::array<glm::vec4, 8> corners;
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const float depth = (corner & 4) ? splitFar : splitNear;
+            const float halfHeight = depth * tanHalfFov;
+            corners[corner] = glm::vec4((corner & 1) ? halfHeight * aspect : -halfHeight * aspect, (corner & 2) ? halfHeight : -halfHeight, -depth, 1.0f);
+        }
+        return corners;
+    }
+
+    /// Size of one shadow map texel (light view space) for a cascade fitted at the given resolution.
+    float CascadeTexelSize(const Shadow::Cascade& cascade, uint32_t resolution)
+    {
+        return 2.0f / (cascade.Proj[0][0] * (float)resolution);
+    }
+
+    /// Largest distance (in cascade clip space) of a slice corner outside the cascade; 0 when the cascade covers its slice.
+    float CalcCascadeCoverError(const Shadow::Cascade& cascade, const glm::mat4& inverseEyeView)
+    {
+        float maxError = 0.0f;
+        for (const glm::vec4& corner : SliceCorners(cEyeFov, cEyeAspect, cascade.SplitNear, cascade.SplitFar))
+        {
+            const glm::vec4 clipPosition = cascade.ViewProj * (inverseEyeView * corner);
+            maxError = std::max({ maxError, std::abs(clipPosition.x) - 1.0f, std::abs(clipPosition.y) - 1.0f, -clipPosition.z, clipPosition.z - 1.0f });
+        }
+        return maxError;
+    }
+
+    /// Distance of x from the nearest whole number.
+    float WholeError(float x)
+    {
+        return std::abs(x - std::round(x));
+    }
+
+    glm::mat4 MakeEyeView(const glm::vec3& position, float yaw, float pitch)
+    {
+        const glm::vec3 forward(std::sin(yaw) * std::cos(pitch), std::sin(pitch), -std::cos(yaw) * std::cos(pitch));
+        return glm::lookAtRH(position, position + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    const glm::mat4 cLightView = glm::lookAtRH(glm::vec3(50.0f, 100.0f, 30.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+TEST_CASE(Shadow_CascadeSplitsMonotonic)
+{
+    const float nearPlane = 0.5f;
+    const float farPlane = 200.0f;
+    for (const float lambda : { 0.0f, 0.5f, 0.75f, 1.0f })
+    {
+        for (uint32_t numCascades = 1; numCascades <= Shadow::cMaxCascades; ++numCascades)
+        {
+            std::array<float, Shadow::cMaxCascades> splits;
+            Shadow::CalcCascadeSplits(nearPlane, farPlane, lambda, std::span(splits.data(), numCascades));
+            CHECK(splits[0] > nearPlane);
+            CHECK(splits[numCascades - 1] == farPlane);
+            bool increasing = true;
+            for (uint32_t i = 1; i < numCascades; ++i)
+                increasing = increasing && splits[i] > splits[i - 1];
+            CHECK(increasing);
+        }
+    }
+
+    // Endpoints of the blend are the uniform and logarithmic distributions.
+    std::array<float, 4> uniform, logarithmic;
+    Shadow::CalcCascadeSplits(nearPlane, farPlane, 0.0f, uniform);
+    Shadow::CalcCascadeSplits(nearPlane, farPlane, 1.0f, logarithmic);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        const float fraction = float(i + 1) / 4.0f;
+        CHECK_NEAR(uniform[i], nearPlane + (farPlane - nearPlane) * fraction, 0.001f);
+        CHECK_NEAR(logarithmic[i], nearPlane * std::pow(farPlane / nearPlane, fraction), 0.001f);
+    }
+}
+
+TEST_CASE(Shadow_CascadeSphereContainsSlice)
+{
+    const uint32_t resolution = 1024;
+    const float slices[][2] = { { 0.5f, 4.0f }, { 4.0f, 20.0f }, { 20.0f, 200.0f }, { 0.1f, 1000.0f } };
+    const float orientations[][2] = { { 0.0f, 0.0f }, { 1.0f, 0.3f }, { -2.5f, -0.8f }, { 3.0f, 1.2f } };
+    for (const auto& slice : slices)
+    {
+        float firstRadius = -1.0f;
+        for (const auto& orientation : orientations)
+        {
+            const glm::mat4 inverseEyeView = glm::inverse(MakeEyeView(glm::vec3(3.0f, 2.0f, -7.0f), orientation[0], orientation[1]));
+            const Shadow::Cascade cascade = Shadow::FitCascade(cLightView, inverseEyeView, cEyeFov, cEyeAspect, slice[0], slice[1], resolution, resolution, 10.0f);
+            CHECK(cascade.SplitNear == slice[0] && cascade.SplitFar == slice[1]);
+
+            // Every corner inside the sphere (its center is snapped, so allow up to a texel) and inside the cascade's projection.
+            const float texelSize = CascadeTexelSize(cascade, resolution);
+            float maxSphereError = 0.0f;
+            for (const glm::vec4& corner : SliceCorners(cEyeFov, cEyeAspect, slice[0], slice[1]))
+            {
+                const glm::vec3 lightPosition(cLightView * (inverseEyeView * corner));
+                maxSphereError = std::max(maxSphereError, glm::length(lightPosition - cascade.SphereCenter) - cascade.SphereRadius - texelSize);
+            }
+            CHECK(maxSphereError <= cascade.SphereRadius * 0.0001f);
+            CHECK(CalcCascadeCoverError(cascade, inverseEyeView) < 0.0001f);
+
+            // Radius only depends on the projection (not the eye camera's orientation), so the texel size does not change as it rotates.
+            if (firstRadius < 0.0f)
+                firstRadius = cascade.SphereRadius;
+            CHECK_NEAR(cascade.SphereRadius, firstRadius, firstRadius * 0.0001f);
+        }
+    }
+}
+
+TEST_CASE(Shadow_CascadeSnappingKeepsOriginStable)
+{
+    // Move the eye camera in sub-texel steps.  The cascade may only move by whole texels, so a fixed world position (the origin)
+    // always lands at the same position within a texel.
+    const uint32_t resolution = 512;
+    const glm::mat4 startEyeView = MakeEyeView(glm::vec3(0.0f, 2.0f, 10.0f), 0.4f, -0.2f);
+    const float texelSize = CascadeTexelSize(Shadow::FitCascade(cLightView, glm::inverse(startEyeView), cEyeFov, cEyeAspect, 2.0f, 12.0f, resolution, resolution, 0.0f), resolution);
+
+    float firstFraction[2] = {};
+    glm::vec3 lastCenter;
+    float maxFractionError = 0.0f;
+    float maxSnapError = 0.0f;
+    float maxStep = 0.0f;
+    for (int step = 0; step < 50; ++step)
+    {
+        const glm::vec3 offset = glm::vec3(0.37f, 0.11f, -0.23f) * (texelSize * (float)step);
+        const glm::mat4 inverseEyeView = glm::translate(offset) * glm::inverse(startEyeView);
+        const Shadow::Cascade cascade = Shadow::FitCascade(cLightView, inverseEyeView, cEyeFov, cEyeAspect, 2.0f, 12.0f, resolution, resolution, 0.0f);
+
+        const glm::vec4 clipOrigin = cascade.ViewProj * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            const float texel = (clipOrigin[axis] * 0.5f + 0.5f) * (float)resolution;
+            const float fraction = texel - std::floor(texel);
+            if (step == 0)
+                firstFraction[axis] = fraction;
+            const float fractionError = std::abs(fraction - firstFraction[axis]);
+            maxFractionError = std::max(maxFractionError, std::min(fractionError, 1.0f - fractionError));
+            maxSnapError = std::max(maxSnapError, WholeError(cascade.SphereCenter[axis] / texelSize));
+            if (step > 0)
+                maxStep = std::max(maxStep, std::abs(cascade.SphereCenter[axis] - lastCenter[axis]) / texelSize);
+        }
+        lastCenter = cascade.SphereCenter;
+    }
+    CHECK(maxFractionError < 0.01f);
+    CHECK(maxSnapError < 0.01f);
+    CHECK(maxStep < 1.01f);
+}
+
+TEST_CASE(Shadow_UpdateCascadesCoverSlices)
+{
+    Shadow shadow;
+    shadow.Initialize(2048, 2048, false);
+    shadow.SetLightPos(glm::vec3(50.0f, 100.0f, 30.0f), glm::vec3(0.0f));
+    shadow.SetEyeClipPlanes(cEyeFov, cEyeAspect, 0.5f, 150.0f);
+    for (uint32_t numCascades = 2; numCascades <= Shadow::cMaxCascades; ++numCascades)
+    {
+        shadow.SetCascades(numCascades, 0.75f, 20.0f);
+        const glm::mat4 eyeView = MakeEyeView(glm::vec3(5.0f, 3.0f, 8.0f), 0.7f, -0.1f);
+        shadow.Update(eyeView);
+        CHECK(shadow.GetNumCascades() == numCascades);
+
+        const glm::mat4 inverseEyeView = glm::inverse(eyeView);
+        for (uint32_t cascadeIdx = 0; cascadeIdx < numCascades; ++cascadeIdx)
+        {
+            const auto& cascade = shadow.GetCascade(cascadeIdx);
+            CHECK(cascade.SplitNear == (cascadeIdx == 0 ? 0.5f : shadow.GetCascade(cascadeIdx - 1).SplitFar));
+            CHECK(shadow.GetCascadeSplitDistances()[cascadeIdx] == cascade.SplitFar);
+            CHECK(CalcCascadeCoverError(cascade, inverseEyeView) < 0.0001f);
+
+            uint32_t tileX, tileY, tileWidth, tileHeight;
+            shadow.GetCascadeTile(cascadeIdx, tileX, tileY, tileWidth, tileHeight);
+            const float texelSize = CascadeTexelSize(cascade, tileWidth);
+            // Square texels (2 cascades have 2:1 tiles).
+            CHECK_NEAR(2.0f / (cascade.Proj[1][1] * (float)tileHeight), texelSize, texelSize * 0.0001f);
+            CHECK(WholeError(cascade.SphereCenter.x / texelSize) < 0.01f && WholeError(cascade.SphereCenter.y / texelSize) < 0.01f);
+        }
+        CHECK(shadow.GetCascade(numCascades - 1).SplitFar == 150.0f);
+    }
+}
+
+TEST_CASE(Shadow_QueryCascadeCastersCullsOutsideCascade)
+{
+    Shadow shadow;
+    shadow.Initialize(2048, 2048, false);
+    shadow.SetLightPos(glm::vec3(50.0f, 100.0f, 30.0f), glm::vec3(0.0f));
+    shadow.SetEyeClipPlanes(cEyeFov, cEyeAspect, 0.5f, 150.0f);
+    const float casterDistance = 20.0f;
+    shadow.SetCascades(4, 0.75f, casterDistance);
+    shadow.Update(MakeEyeView(glm::vec3(0.0f, 2.0f, 10.0f), 0.0f, 0.0f));
+
+    // Objects placed around the first cascade (in light view space, light looks down -z).
+    const auto& cascade = shadow.GetCascade(0);
+    const glm::mat4 inverseLightView = glm::inverse(shadow.GetView());
+    const glm::vec3 lightOffsets[] = {
+        { 0.0f, 0.0f, 0.0f },                                               // 0: in the cascade
+        { 0.0f, 0.0f, cascade.SphereRadius + casterDistance * 0.5f },        // 1: between the cascade and the light, casts in to it
+        { 60.0f, 0.0f, 0.0f },                                              // 2: to the side
+        { 0.0f, -60.0f, 0.0f },                                             // 3: to the side
+        { 0.0f, 0.0f, -cascade.SphereRadius - 60.0f },                      // 4: behind the cascade (away from the light)
+    };
+    Octree<uint32_t, 5> octree(glm::vec3(0.0f), glm::vec3(400.0f), 8);
+    for (uint32_t objectIdx = 0; objectIdx < std::size(lightOffsets); ++objectIdx)
+    {
+        const glm::vec4 worldPosition = inverseLightView * glm::vec4(cascade.SphereCenter + lightOffsets[objectIdx], 1.0f);
+        octree.AddObject(worldPosition, glm::vec4(0.5f, 0.5f, 0.5f, 0.0f), uint32_t(objectIdx));
+    }
+
+    std::vector<uint32_t> casters;
+    shadow.QueryCascadeCasters(0, octree, [&casters](uint32_t objectIdx) { casters.push_back(objectIdx); });
+    std::sort(casters.begin(), casters.end());
+    CHECK((casters == std::vector<uint32_t>{ 0, 1 }));
+}
@@ -0,0 +1,125 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "system/assetCache.hpp"
+#include "system/assetManager.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// AssetCache serving files from memory (rather than through the AssetManager)
+    class TestAssetCache : public AssetCache
+    {
+    public:
+        TestAssetCache(AssetManager& assetManager, size_t budgetBytes) : AssetCache(assetManager, budgetBytes) {}
+
+        void AddFile(const std::string& name, size_t size, uint8_t fill) { Files[name] = std::vector<uint8_t>(size, fill); }
+
+        std::map<std::string, std::vector<uint8_t>> Files;
+        uint32_t NumStorageLoads = 0;
+
+    protected:
+        bool LoadFromStorage(const std::string& portableFileName, std::vector<uint8_t>& fileData) override
+        {
+            auto it = Files.find(portableFileName);
+            if (it == Files.end())
+                return false;
+            ++NumStorageLoads;
+            fileData = it->second;
+            return true;
+        }
+    };
+}
+
+TEST_CASE(AssetCache_EvictsLeastRecentlyUsedOverBudget)
+{
+    AssetManager assetManager;
+    TestAssetCache cache(assetManager, 300);
+    cache.AddFile("a", 100, 1);
+    cache.AddFile("b", 100, 2);
+    cache.AddFile("c", 100, 3);
+    cache.AddFile("d", 100, 4);
+
+    cache.Load("a");
+    cache.Load("b");
+    cache.Load("c");
+    CHECK(cache.GetStats().ResidentBytes == 300);
+    CHECK(cache.GetStats().Evictions == 0);
+
+    // Touch 'a' so 'b' is the least recently used, then go over budget.
+    cache.Load("a");
+    CHECK(cache.GetStats().Hits == 1);
+    cache.Load("d");
+    CHECK(cache.GetStats().Evictions == 1);
+    CHECK(cache.GetStats().ResidentBytes == 300);
+    CHECK(cache.GetStats().ResidentEntries == 3);
+
+    // 'a', 'c' and 'd' are still cached, 'b' has to be reloaded (evicting 'c', now the least recently used).
+    const uint32_t loadsBefore = cache.NumStorageLoads;
+    cache.Load("a");
+    cache.Load("d");
+    CHECK(cache.NumStorageLoads == loadsBefore);
+    cache.Load("b");
+    CHECK(cache.NumStorageLoads == loadsBefore + 1);
+    CHECK(cache.GetStats().Evictions == 2);
+    cache.Load("c");
+    CHECK(cache.NumStorageLoads == loadsBefore + 2);
+}
+
+TEST_CASE(AssetCache_EvictedBuffersStayValid)
+{
+    AssetManager assetManager;
+    TestAssetCache cache(assetManager, 100);
+    cache.AddFile("a", 100, 1);
+    cache.AddFile("b", 100, 2);
+
+    const AssetBuffer a = cache.Load("a");
+    cache.Load("b");    // evicts 'a'
+    CHECK(cache.GetStats().Evictions == 1);
+    CHECK(a.size() == 100 && a.data()[0] == 1 && a.data()[99] == 1);
+    CHECK(a.use_count() == 1);
+}
+
+TEST_CASE(AssetCache_KeepsMostRecentEntryOverBudget)
+{
+    AssetManager assetManager;
+    TestAssetCache cache(assetManager, 50);
+    cache.AddFile("big", 100, 1);
+    CHECK(cache.Load("big").size() == 100);
+    CHECK(cache.GetStats().ResidentEntries == 1);
+    cache.Load("big");
+    CHECK(cache.NumStorageLoads == 1);
+}
+
+TEST_CASE(AssetCache_DeduplicatesIdenticalContent)
+{
+    AssetManager assetManager;
+    TestAssetCache cache(assetManager, 1000);
+    cache.AddFile("x", 100, 7);
+    cache.AddFile("dir/../y", 100, 7);
+
+    const AssetBuffer x = cache.Load("x");
+    const AssetBuffer y = cache.Load("dir/../y");
+    CHECK(x.SharesDataWith(y));
+    CHECK(cache.GetStats().DedupedLoads == 1);
+    CHECK(cache.GetStats().ResidentBytes == 100);
+    CHECK(cache.GetStats().ResidentEntries == 2);
+
+    // Canonical path lookup hits.
+    cache.Load("y");
+    CHECK(cache.GetStats().Hits == 1);
+
+    // Content stays resident until both paths are evicted.
+    cache.Evict("x");
+    CHECK(cache.GetStats().ResidentBytes == 100);
+    cache.Evict("y");
+    CHECK(cache.GetStats().ResidentBytes == 0);
+}
@@ -0,0 +1,279 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "system/cpuTrace.hpp"
+#include "system/os_common.h"
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /// @return tid (as a string) of the thread_name metadata record for the named thread, or empty if there is none
+    std::string FindThreadId(const std::string& json, const char* pThreadName)
+    {
+        const size_t namePos = json.find(std::string("\"args\":{\"name\":\"") + pThreadName + "\"}");
+        if (namePos == std::string::npos)
+            return {};
+        const size_t tidPos = json.rfind("\"tid\":", namePos);
+        return tidPos == std::string::npos ? std::string() : json.substr(tidPos + 6, json.find(',', tidPos) - tidPos - 6);
+    }
+
+    /// Minimal protobuf reader (for checking ExportPerfettoTrace)
+    struct ProtoField
+    {
+        uint32_t            Field;
+        uint32_t            WireType;
+        uint64_t            Value;      ///< varint (or fixed64 bits)
+        std::string_view    Bytes;      ///< length delimited
+    };
+    bool ReadVarint(std::string_view& data, uint64_t& value)
+    {
+        value = 0;
+        for (uint32_t shift = 0; !data.empty() && shift < 64; shift += 7)
+        {
+            const uint8_t byte = (uint8_t)data.front();
+            data.remove_prefix(1);
+            value |= uint64_t(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+    /// @return false if the message is malformed
+    bool ReadFields(std::string_view data, std::vector<ProtoField>& fields)
+    {
+        fields.clear();
+        while (!data.empty())
+        {
+            uint64_t tag, value = 0;
+            if (!ReadVarint(data, tag))
+                return false;
+            ProtoField field{ uint32_t(tag >> 3), uint32_t(tag & 7), 0, {} };
+            if (field.WireType == 0)
+            {
+                if (!ReadVarint(data, field.Value))
+                    return false;
+            }
+            else if (field.WireType == 1)
+            {
+                if (data.size() < 8)
+                    return false;
+                for (int byte = 0; byte < 8; ++byte)
+                    field.Value |= uint64_t((uint8_t)data[byte]) << (byte * 8);
+                data.remove_prefix(8);
+            }
+            else if (field.WireType == 2)
+            {
+                if (!ReadVarint(data, value) || value > data.size())
+                    return false;
+                field.Bytes = data.substr(0, size_t(value));
+                data.remove_prefix(size_t(value));
+            }
+            else
+                return false;
+            fields.push_back(field);
+        }
+        return true;
+    }
+    const ProtoField* FindField(const std::vector<ProtoField>& fields, uint32_t fieldNumber)
+    {
+        for (const auto& field : fields)
+            if (field.Field == fieldNumber)
+                return &field;
+        return nullptr;
+    }
+}
+
+TEST_CASE(CpuTrace_RingAllocatedOnFirstEnabledEvent)
+{
+    CpuTrace::Initialize(1024);
+    CpuTrace::SetEnabled(false);
+
+    // Naming a thread, or recording with tracing disabled, allocates no ring buffer.
+    const size_t bytesBefore = CpuTrace::GetEventStorageBytes();
+    std::thread([]() {
+        CpuTrace::SetThreadName("CpuTraceTest idle");
+        CpuTraceScope scope("Disabled");
+        CpuTrace::Instant("Disabled");
+    }).join();
+    CHECK(CpuTrace::GetEventStorageBytes() == bytesBefore);
+
+    // First recorded event (with tracing enabled) allocates.
+    CpuTrace::SetEnabled(true);
+    std::thread([]() {
+        CpuTrace::SetThreadName("CpuTraceTest recording");
+        CpuTraceScope scope("CpuTraceTest enabled scope");
+    }).join();
+    CpuTrace::SetEnabled(false);
+    CHECK(CpuTrace::GetEventStorageBytes() > bytesBefore);
+
+    const std::string json = CpuTrace::ExportChromeTrace();
+    CHECK(json.find("CpuTraceTest idle") != std::string::npos);
+    CHECK(json.find("CpuTraceTest enabled scope") != std::string::npos);
+}
+
+TEST_CASE(CpuTrace_ExportWhileRecording)
+{
+    // Small ring that the writer laps many times during each export, every exported event must be one the writer actually recorded.
+    CpuTrace::Initialize(1024);
+    CpuTrace::SetEnabled(true);
+    std::atomic<bool> stop{ false };
+    std::atomic<bool> started{ false };
+    std::thread writer([&stop, &started]() {
+        CpuTrace::SetThreadName("CpuTraceTest writer");
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            CpuTraceScope scope("CpuTraceTest outer");
+            CpuTrace::Counter("CpuTraceTest counter", 1.0);
+            CpuTraceScope inner("CpuTraceTest inner");
+            started.store(true, std::memory_order_release);
+        }
+    });
+    while (!started.load(std::memory_order_acquire))
+        std::this_thread::yield();
+    uint32_t numBadEvents = 0;
+    uint32_t numWriterEvents = 0;
+    for (uint32_t iteration = 0; iteration < 20; ++iteration)
+    {
+        const std::string json = CpuTrace::ExportChromeTrace();
+        CHECK(json.rfind("\n]}\n") == json.size() - 4);
+        // Only the writer's named events (other threads, eg ThreadWorker threads from other tests, may also have recorded).
+        const std::string writerTid = FindThreadId(json, "CpuTraceTest writer");
+        CHECK(!writerTid.empty());
+        for (size_t lineBegin = 0; lineBegin < json.size();)
+        {
+            const size_t lineEnd = std::min(json.find('\n', lineBegin), json.size());
+            const std::string line = json.substr(lineBegin, lineEnd - lineBegin);
+            lineBegin = lineEnd + 1;
+            const size_t tidPos = line.find("\"tid\":" + writerTid);
+            const size_t tidEnd = tidPos + 6 + writerTid.size();
+            const bool writerEvent = tidPos != std::string::npos && tidEnd < line.size() && (line[tidEnd] == ',' || line[tidEnd] == '}');
+            if (line.rfind("{\"name\":", 0) != 0 || line.find("\"ph\":\"M\"") != std::string::npos || !writerEvent)
+                continue;
+            const size_t nameEnd = line.find('"', 9);
+            if (nameEnd < 21 || line.compare(9, 12, "CpuTraceTest") != 0)
+                ++numBadEvents;
+            ++numWriterEvents;
+        }
+    }
+    stop = true;
+    writer.join();
+    CpuTrace::SetEnabled(false);
+    CHECK(numBadEvents == 0);
+    CHECK(numWriterEvents > 0);
+}
+
+TEST_CASE(CpuTrace_PerfettoExport)
+{
+    CpuTrace::Initialize(1024);
+    CpuTrace::SetEnabled(true);
+    std::thread([]() {
+        CpuTrace::SetThreadName("CpuTraceTest perfetto");
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            CpuTraceScope scope("CpuTraceTest perfetto scope");
+            CpuTrace::Counter("CpuTraceTest perfetto counter", double(i) + 0.5);
+        }
+    }).join();
+    CpuTrace::SetEnabled(false);
+
+    // Every top level field is a TracePacket (Trace.packet = 1), descriptors before events.
+    const std::string trace = CpuTrace::ExportPerfettoTrace();
+    std::vector<ProtoField> packets, packetFields, fields, threadFields;
+    CHECK(ReadFields(trace, packets));
+    uint64_t threadUuid = 0;
+    uint32_t numBegins = 0, numEnds = 0, numCounters = 0;
+    double counterSum = 0.0;
+    bool allPackets = true, allSequenced = true, descriptorAfterEvent = false, seenEvent = false;
+    uint64_t previousTimestamp = 0;
+    bool timestampsOrdered = true;
+    for (const auto& packet : packets)
+    {
+        allPackets = allPackets && packet.Field == 1 && packet.WireType == 2 && ReadFields(packet.Bytes, packetFields);
+        if (!allPackets)
+            break;
+        allSequenced = allSequenced && FindField(packetFields, 10) && FindField(packetFields, 10)->Value == 1;
+        if (const ProtoField* pDescriptor = FindField(packetFields, 60))
+        {
+            descriptorAfterEvent = descriptorAfterEvent || seenEvent;
+            CHECK(ReadFields(pDescriptor->Bytes, fields));
+            const ProtoField* pThread = FindField(fields, 4);
+            if (pThread && ReadFields(pThread->Bytes, threadFields) && FindField(threadFields, 5) && FindField(threadFields, 5)->Bytes == "CpuTraceTest perfetto")
+                threadUuid = FindField(fields, 1)->Value;
+        }
+        else if (const ProtoField* pEvent = FindField(packetFields, 11))
+        {
+            seenEvent = true;
+            CHECK(ReadFields(pEvent->Bytes, fields));
+            const ProtoField* pType = FindField(fields, 9);
+            const ProtoField* pTrack = FindField(fields, 11);
+            const ProtoField* pName = FindField(fields, 23);
+            if (!pType || !pTrack)
+                continue;
+            if (pTrack->Value == threadUuid && threadUuid != 0)
+            {
+                const uint64_t timestamp = FindField(packetFields, 8) ? FindField(packetFields, 8)->Value : 0;
+                timestampsOrdered = timestampsOrdered && timestamp >= previousTimestamp;
+                previousTimestamp = timestamp;
+                numBegins += (pType->Value == 1 && pName && pName->Bytes == "CpuTraceTest perfetto scope") ? 1 : 0;
+                numEnds += pType->Value == 2 ? 1 : 0;
+            }
+            if (pType->Value == 4 && FindField(fields, 44))
+            {
+                double value;
+                const uint64_t bits = FindField(fields, 44)->Value;
+                memcpy(&value, &bits, sizeof(value));
+                counterSum += value;
+                ++numCounters;
+            }
+        }
+    }
+    CHECK(allPackets);
+    CHECK(allSequenced);
+    CHECK(!descriptorAfterEvent);
+    CHECK(threadUuid != 0);
+    CHECK(numBegins == 3);
+    CHECK(numEnds == 3);
+    CHECK(timestampsOrdered);
+    CHECK(numCounters >= 3);
+    CHECK(counterSum >= 0.5 + 1.5 + 2.5);
+}
+
+BENCHMARK_CASE(CpuTrace_ScopeCost)
+{
+    CpuTrace::Initialize(64 * 1024);
+    const uint32_t numIterations = 1000000;
+
+    const double nowMicroseconds = FrameworkTest::TimeMicroseconds(1, [&]() {
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < numIterations; ++i)
+            sum += CpuTrace::Now();
+        if (sum == 0)
+            LOGI("CpuTrace: (unused) %llu", (unsigned long long) sum);
+    });
+    CpuTrace::SetEnabled(false);
+    const double disabledMicroseconds = FrameworkTest::TimeMicroseconds(1, [&]() {
+        for (uint32_t i = 0; i < numIterations; ++i)
+            CpuTraceScope scope("CpuTraceBench");
+    });
+    CpuTrace::SetEnabled(true);
+    const double enabledMicroseconds = FrameworkTest::TimeMicroseconds(1, [&]() {
+        for (uint32_t i = 0; i < numIterations; ++i)
+            CpuTraceScope scope("CpuTraceBench");
+    });
+    CpuTrace::SetEnabled(false);
+
+    const double toNanoseconds = 1000.0 / numIterations;
+    LOGI("CpuTrace: Now() %.1fns, scope (constant name) disabled %.1fns, enabled %.1fns (two Now() calls and two ring buffer writes)",
+         nowMicroseconds * toNanoseconds, disabledMicroseconds * toNanoseconds, enabledMicroseconds * toNanoseconds);
+}
@@ -0,0 +1,128 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "system/frameTimeline.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST_CASE(FrameTimeline_StatsPercentiles)
+{
+    std::vector<double> durations;
+    for (uint32_t i = 100; i > 0; --i)
+        durations.push_back(double(i));
+    const auto stats = FrameTimeline::CalculateStats(durations);
+    CHECK(stats.Count == 100);
+    CHECK(stats.MinMs == 1.0 && stats.MaxMs == 100.0);
+    CHECK_NEAR(stats.MeanMs, 50.5, 1e-9);
+    // Nearest rank: the smallest value with at least p% of the values at or below it.
+    CHECK(stats.P50Ms == 50.0);
+    CHECK(stats.P95Ms == 95.0);
+    CHECK(stats.P99Ms == 99.0);
+
+    std::vector<double> tenDurations = { 10.0, 1.0, 9.0, 2.0, 8.0, 3.0, 7.0, 4.0, 6.0, 5.0 };
+    const auto tenStats = FrameTimeline::CalculateStats(tenDurations);
+    CHECK(tenStats.P50Ms == 5.0);
+    CHECK(tenStats.P95Ms == 10.0 && tenStats.P99Ms == 10.0);
+
+    std::vector<double> oneDuration = { 3.0 };
+    const auto oneStats = FrameTimeline::CalculateStats(oneDuration);
+    CHECK(oneStats.Count == 1 && oneStats.MinMs == 3.0 && oneStats.P50Ms == 3.0 && oneStats.P99Ms == 3.0 && oneStats.MaxMs == 3.0);
+
+    std::vector<double> noDurations;
+    CHECK(FrameTimeline::CalculateStats(noDurations).Count == 0);
+}
+
+TEST_CASE(FrameTimeline_HistoryWraps)
+{
+    FrameTimeline timeline(4);
+    timeline.SetTimestampPeriod(1.0e6);     // 1ms per tick
+    auto& timer = timeline.FindOrAddTimer("Pass", 0);
+    CHECK(&timeline.FindOrAddTimer("Pass", 0) == &timer);
+    CHECK(&timeline.FindOrAddTimer("Pass", 1) != &timer);
+
+    // Durations 1 to 6ms, one result per frame.
+    for (uint64_t i = 1; i <= 6; ++i)
+    {
+        timeline.AddResult(timer, i * 100, i * 100 + i);
+        timeline.EndFrame(i * 1000000);
+    }
+    CHECK(timeline.GetFrameNumber() == 6);
+    CHECK(timer.TotalSamples == 6);
+    CHECK(timer.Samples.size() == 4);
+    CHECK(timer.NextSample == 2);
+    // Oldest results (1 and 2ms) were overwritten by the newest (5 and 6ms).
+    CHECK(timer.Samples[0].StopTick - timer.Samples[0].StartTick == 5);
+    CHECK(timer.Samples[1].StopTick - timer.Samples[1].StartTick == 6);
+    CHECK(timer.Samples[2].Frame == 2);
+    const auto stats = timeline.GetStats(timer);
+    CHECK(stats.Count == 4);
+    CHECK_NEAR(stats.MinMs, 3.0, 1e-9);
+    CHECK_NEAR(stats.MaxMs, 6.0, 1e-9);
+    CHECK_NEAR(stats.MeanMs, 4.5, 1e-9);
+
+    timeline.Clear();
+    CHECK(timer.Samples.empty() && timer.NextSample == 0);
+    CHECK(timeline.GetStats(timer).Count == 0);
+}
+
+TEST_CASE(FrameTimeline_EstimatedCalibrationTracksDrift)
+{
+    // Gpu timestamps in nanoseconds, but the gpu clock runs 200ppm slow or fast compared to the cpu.
+    for (const double drift : { 1.0 + 200e-6, 1.0 - 200e-6 })
+    {
+        FrameTimeline timeline;
+        timeline.SetTimestampPeriod(1.0);
+        auto& timer = timeline.FindOrAddTimer("Frame", 0);
+        const double cpuTicksPerGpuTick = CpuTrace::TicksPerMicrosecond() * 1e-3;
+        const uint64_t gpuBase = 1ull << 40;        // unrelated to the cpu timebase
+        const uint64_t cpuBase = 1ull << 36;
+
+        // 60 seconds of 16ms frames, read back between 0.1 and 2.1ms after the gpu finished.
+        const uint64_t frameGpuTicks = 16000000;
+        double maxErrorMs = 0.0;
+        for (uint64_t frame = 0; frame < 60 * 60; ++frame)
+        {
+            const uint64_t stopTick = gpuBase + frame * frameGpuTicks;
+            const double trueCpuTicks = double(cpuBase) + double(stopTick - gpuBase) * cpuTicksPerGpuTick * drift;
+            const double readbackLagMs = 0.1 + double((frame * 8) % 21) * 0.1;
+            const uint64_t readbackTicks = uint64_t(trueCpuTicks + readbackLagMs * 1000.0 * CpuTrace::TicksPerMicrosecond());
+            timeline.AddResult(timer, stopTick - frameGpuTicks / 2, stopTick);
+            timeline.EndFrame(readbackTicks);
+
+            const auto& calibration = timeline.GetCalibration();
+            CHECK(calibration.IsValid() && !calibration.Exact);
+            // Never maps the gpu work to after the cpu read it back.
+            CHECK(int64_t(readbackTicks - calibration.ToCpuTicks(stopTick)) >= 0);
+            if (frame >= FrameTimeline::cCalibrationWindow)
+                maxErrorMs = std::max(maxErrorMs, std::abs(double(calibration.ToCpuTicks(stopTick)) - trueCpuTicks) / (1000.0 * CpuTrace::TicksPerMicrosecond()));
+        }
+        // Within the smallest readback lag plus the drift across the calibration window (200ppm of 1.9 seconds is 0.4ms).
+        CHECK(maxErrorMs < 0.1 + 0.4 + 0.01);
+    }
+}
+
+TEST_CASE(FrameTimeline_ExactCalibration)
+{
+    FrameTimeline timeline;
+    timeline.SetTimestampPeriod(2.0);       // 2ns per gpu tick
+    timeline.SetCalibration(1000, 5000);
+    const auto& calibration = timeline.GetCalibration();
+    CHECK(calibration.Exact && calibration.IsValid());
+    CHECK_NEAR(calibration.CpuTicksPerGpuTick, 2.0 * CpuTrace::TicksPerMicrosecond() * 1e-3, 1e-12);
+    // Gpu ticks before the calibration point map backwards.
+    CHECK(calibration.ToCpuTicks(1000) == 5000);
+    CHECK(int64_t(calibration.ToCpuTicks(500) - 5000) < 0);
+
+    // Readback times do not override an exact calibration.
+    auto& timer = timeline.FindOrAddTimer("Frame", 0);
+    timeline.AddResult(timer, 100000, 200000);
+    timeline.EndFrame(1);
+    CHECK(timeline.GetCalibration().GpuTicks == 1000 && timeline.GetCalibration().CpuTicks == 5000);
+}
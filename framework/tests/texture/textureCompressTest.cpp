@@ -0,0 +1,302 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "texture/textureCompress.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    /// Synthetic RGBA8 test image; smooth gradients, a soft ring pattern and some hard edged rectangles (the hard case for 4x4 block formats).
+    std::vector<uint8_t> MakeTestImage(uint32_t width, uint32_t height)
+    {
+        std::vector<uint8_t> image(size_t(width) * height * 4);
+        for (uint32_t y = 0; y < height; ++y)
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                const float u = float(x) / width, v = float(y) / height;
+                const float ring = 0.5f + 0.5f * std::sin(40.0f * std::sqrt((u - 0.5f) * (u - 0.5f) + (v - 0.5f) * (v - 0.5f)));
+                float rgb[3] = { u, v, ring * 0.8f + 0.1f };
+                if (((x / 24) + (y / 40)) % 5 == 0)
+                {
+                    rgb[0] = 1.0f - rgb[0];
+                    rgb[2] *= 0.25f;
+                }
+                uint8_t* pPixel = &image[(size_t(y) * width + x) * 4];
+                for (int c = 0; c < 3; ++c)
+                    pPixel[c] = uint8_t(std::clamp(rgb[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+                pPixel[3] = 255;
+            }
+        return image;
+    }
+
+    uint64_t ReadLittleEndian(const uint8_t* pSrc, uint32_t numBytes)
+    {
+        uint64_t value = 0;
+        for (uint32_t i = 0; i < numBytes; ++i)
+            value |= uint64_t(pSrc[i]) << (8 * i);
+        return value;
+    }
+
+    uint64_t ReadBigEndian(const uint8_t* pSrc, uint32_t numBytes)
+    {
+        uint64_t value = 0;
+        for (uint32_t i = 0; i < numBytes; ++i)
+            value = (value << 8) | pSrc[i];
+        return value;
+    }
+
+    //
+    // Reference block decoders (written from the format specifications, independent of the encoder).  Output pixels are indexed y*4+x.
+    //
+
+    void DecodeBc1Block(const uint8_t* pBlock, uint8_t rgba[16][4])
+    {
+        const uint32_t color0 = uint32_t(ReadLittleEndian(pBlock, 2));
+        const uint32_t color1 = uint32_t(ReadLittleEndian(pBlock + 2, 2));
+        const uint32_t indices = uint32_t(ReadLittleEndian(pBlock + 4, 4));
+        int palette[4][4];
+        const uint32_t colors[2] = { color0, color1 };
+        for (int i = 0; i < 2; ++i)
+        {
+            const uint32_t r = colors[i] >> 11, g = (colors[i] >> 5) & 63, b = colors[i] & 31;
+            palette[i][0] = int((r << 3) | (r >> 2));
+            palette[i][1] = int((g << 2) | (g >> 4));
+            palette[i][2] = int((b << 3) | (b >> 2));
+            palette[i][3] = 255;
+        }
+        for (int c = 0; c < 3; ++c)
+        {
+            if (color0 > color1)
+            {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+            else
+            {
+                palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                palette[3][c] = 0;
+            }
+        }
+        palette[2][3] = 255;
+        palette[3][3] = color0 > color1 ? 255 : 0;
+        for (uint32_t i = 0; i < 16; ++i)
+            for (int c = 0; c < 4; ++c)
+                rgba[i][c] = uint8_t(palette[(indices >> (2 * i)) & 3][c]);
+    }
+
+    void DecodeBc4Block(const uint8_t* pBlock, uint8_t values[16])
+    {
+        const int e0 = pBlock[0], e1 = pBlock[1];
+        const uint64_t indices = ReadLittleEndian(pBlock + 2, 6);
+        int palette[8] = { e0, e1 };
+        if (e0 > e1)
+        {
+            for (int i = 1; i < 7; ++i)
+                palette[i + 1] = ((7 - i) * e0 + i * e1) / 7;
+        }
+        else
+        {
+            for (int i = 1; i < 5; ++i)
+                palette[i + 1] = ((5 - i) * e0 + i * e1) / 5;
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+        for (uint32_t i = 0; i < 16; ++i)
+            values[i] = uint8_t(palette[(indices >> (3 * i)) & 7]);
+    }
+
+    /// ETC1 compatible (individual and differential) ETC2 RGB blocks only.
+    /// @return false if the block uses one of the ETC2 only (T, H or planar) modes, which the encoder should never output.
+    bool DecodeEtc2RgbBlock(const uint8_t* pBlock, uint8_t rgba[16][4])
+    {
+        static const int cModifiers[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
+        const uint64_t bits = ReadBigEndian(pBlock, 8);
+        const uint32_t high = uint32_t(bits >> 32), low = uint32_t(bits);
+        const bool differential = (high & 2) != 0;
+        const bool flip = (high & 1) != 0;
+        int base[2][3];
+        for (int c = 0; c < 3; ++c)
+        {
+            const uint32_t shift = 24 - 8 * c;
+            if (differential)
+            {
+                const int color = int((high >> (shift + 3)) & 31);
+                const int delta = int((high >> shift) & 7) - (((high >> shift) & 4) ? 8 : 0);
+                if (color + delta < 0 || color + delta > 31)
+                    return false;
+                base[0][c] = (color << 3) | (color >> 2);
+                base[1][c] = ((color + delta) << 3) | ((color + delta) >> 2);
+            }
+            else
+            {
+                const int color0 = int((high >> (shift + 4)) & 15), color1 = int((high >> shift) & 15);
+                base[0][c] = color0 * 17;
+                base[1][c] = color1 * 17;
+            }
+        }
+        const uint32_t tables[2] = { (high >> 5) & 7, (high >> 2) & 7 };
+        for (uint32_t y = 0; y < 4; ++y)
+            for (uint32_t x = 0; x < 4; ++x)
+            {
+                const uint32_t subblock = flip ? (y >= 2 ? 1 : 0) : (x >= 2 ? 1 : 0);
+                const uint32_t bit = x * 4 + y;
+                const uint32_t msb = (low >> (16 + bit)) & 1, lsb = (low >> bit) & 1;
+                const int magnitude = cModifiers[tables[subblock]][lsb];
+                const int modifier = msb ? -magnitude : magnitude;
+                for (int c = 0; c < 3; ++c)
+                    rgba[y * 4 + x][c] = uint8_t(std::clamp(base[subblock][c] + modifier, 0, 255));
+                rgba[y * 4 + x][3] = 255;
+            }
+        return true;
+    }
+
+    /// Decode a whole (block aligned) image of the given format back to RGBA8 (channels the format does not store are zero, alpha is 255 for the color formats).
+    bool DecodeImage(const std::vector<uint8_t>& compressed, TextureFormat format, uint32_t width, uint32_t height, std::vector<uint8_t>& decoded)
+    {
+        const uint32_t blocksX = width / 4, blocksY = height / 4;
+        const size_t blockBytes = compressed.size() / (size_t(blocksX) * blocksY);
+        for (uint32_t by = 0; by < blocksY; ++by)
+            for (uint32_t bx = 0; bx < blocksX; ++bx)
+            {
+                const uint8_t* pBlock = &compressed[(size_t(by) * blocksX + bx) * blockBytes];
+                uint8_t rgba[16][4];
+                for (auto& pixel : rgba)
+                    pixel[0] = pixel[1] = pixel[2] = pixel[3] = 0;
+                switch (format) {
+                case TextureFormat::BC1_RGB_UNORM_BLOCK:
+                    DecodeBc1Block(pBlock, rgba);
+                    break;
+                case TextureFormat::BC4_UNORM_BLOCK:
+                case TextureFormat::BC5_UNORM_BLOCK:
+                {
+                    uint8_t values[16];
+                    for (uint32_t channel = 0; channel < (format == TextureFormat::BC5_UNORM_BLOCK ? 2u : 1u); ++channel)
+                    {
+                        DecodeBc4Block(pBlock + channel * 8, values);
+                        for (uint32_t i = 0; i < 16; ++i)
+                            rgba[i][channel] = values[i];
+                    }
+                    break;
+                }
+                case TextureFormat::ETC2_R8G8B8_UNORM_BLOCK:
+                    if (!DecodeEtc2RgbBlock(pBlock, rgba))
+                        return false;
+                    break;
+                default:
+                    return false;
+                }
+                for (uint32_t i = 0; i < 16; ++i)
+                    memcpy(&decoded[((size_t(by) * 4 + i / 4) * width + bx * 4 + i % 4) * 4], rgba[i], 4);
+            }
+        return true;
+    }
+
+    /// @return peak signal to noise ratio (dB) of the first numChannels channels of two RGBA8 images
+    double CalcPsnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, uint32_t numChannels)
+    {
+        double sumSq = 0.0;
+        size_t count = 0;
+        for (size_t i = 0; i < a.size(); i += 4)
+            for (uint32_t c = 0; c < numChannels; ++c, ++count)
+                sumSq += double(int(a[i + c]) - int(b[i + c])) * double(int(a[i + c]) - int(b[i + c]));
+        const double mse = sumSq / double(count);
+        return mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+    }
+
+    /// Compress and decode the test image, @return psnr (or 0 on failure)
+    double CompressedPsnr(const std::vector<uint8_t>& image, uint32_t width, uint32_t height, TextureFormat format, BlockCompressQuality quality, uint32_t numChannels, ThreadWorker* pWorker = nullptr)
+    {
+        const std::vector<uint8_t> compressed = BlockCompressImage(image.data(), TextureFormat::R8G8B8A8_UNORM, width, height, format, quality, pWorker);
+        if (compressed.size() != BlockCompressedSize(format, width, height))
+            return 0.0;
+        std::vector<uint8_t> decoded(image.size());
+        if (!DecodeImage(compressed, format, width, height, decoded))
+            return 0.0;
+        return CalcPsnr(image, decoded, numChannels);
+    }
+
+    struct FormatCase
+    {
+        const char*     pName;
+        TextureFormat   Format;
+        uint32_t        NumChannels;
+        double          MinPsnr;        ///< at BlockCompressQuality::Normal
+    };
+    const FormatCase cFormatCases[] = {
+        { "BC1", TextureFormat::BC1_RGB_UNORM_BLOCK, 3, 34.0 },
+        { "BC4", TextureFormat::BC4_UNORM_BLOCK, 1, 42.0 },
+        { "BC5", TextureFormat::BC5_UNORM_BLOCK, 2, 42.0 },
+        { "ETC2", TextureFormat::ETC2_R8G8B8_UNORM_BLOCK, 3, 29.5 },   // ETC modifiers only change luminance, the chroma gradients cost it ~5dB vs BC1
+    };
+    const BlockCompressQuality cQualities[] = { BlockCompressQuality::Fastest, BlockCompressQuality::Normal, BlockCompressQuality::Best };
+    const char* const cQualityNames[] = { "Fastest", "Normal", "Best" };
+}
+
+TEST_CASE(TextureCompress_Psnr)
+{
+    const uint32_t width = 128, height = 128;
+    const std::vector<uint8_t> image = MakeTestImage(width, height);
+    for (const auto& formatCase : cFormatCases)
+    {
+        double psnr[3];
+        for (uint32_t q = 0; q < 3; ++q)
+            psnr[q] = CompressedPsnr(image, width, height, formatCase.Format, cQualities[q], formatCase.NumChannels);
+        LOGI("TextureCompress: %s psnr Fastest %.2fdB, Normal %.2fdB, Best %.2fdB", formatCase.pName, psnr[0], psnr[1], psnr[2]);
+        CHECK(psnr[0] > formatCase.MinPsnr - 3.0);
+        CHECK(psnr[1] > formatCase.MinPsnr);
+        // Higher quality settings should never be (meaningfully) worse.
+        CHECK(psnr[1] >= psnr[0] - 0.05);
+        CHECK(psnr[2] >= psnr[1] - 0.05);
+    }
+}
+
+TEST_CASE(TextureCompress_ParallelMatchesSerial)
+{
+    const uint32_t width = 96, height = 64;
+    const std::vector<uint8_t> image = MakeTestImage(width, height);
+    ThreadWorker worker;
+    worker.Initialize("TextureCompressTest", 4);
+    for (const auto& formatCase : cFormatCases)
+    {
+        const auto serial = BlockCompressImage(image.data(), TextureFormat::R8G8B8A8_UNORM, width, height, formatCase.Format, BlockCompressQuality::Normal);
+        const auto parallel = BlockCompressImage(image.data(), TextureFormat::R8G8B8A8_UNORM, width, height, formatCase.Format, BlockCompressQuality::Normal, &worker);
+        CHECK(!serial.empty() && serial == parallel);
+    }
+}
+
+BENCHMARK_CASE(TextureCompress_Throughput)
+{
+    const uint32_t width = 1024, height = 1024;
+    const std::vector<uint8_t> image = MakeTestImage(width, height);
+    ThreadWorker worker;
+    const uint32_t numThreads = worker.Initialize("TextureCompressBench");
+    for (const auto& formatCase : cFormatCases)
+    {
+        std::vector<uint8_t> compressed(BlockCompressedSize(formatCase.Format, width, height));
+        for (uint32_t q = 0; q < 3; ++q)
+        {
+            const uint32_t numIterations = cQualities[q] == BlockCompressQuality::Best ? 1 : 3;
+            const double microseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() {
+                BlockCompressImage(image.data(), TextureFormat::R8G8B8A8_UNORM, width, height, compressed.data(), formatCase.Format, cQualities[q]);
+            });
+            const double parallelMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() {
+                BlockCompressImage(image.data(), TextureFormat::R8G8B8A8_UNORM, width, height, compressed.data(), formatCase.Format, cQualities[q], &worker);
+            });
+            const double megapixels = double(width) * height / 1000000.0;
+            LOGI("TextureCompress: %s %s %ux%u, %.1fms (%.1f Mpixels/s), on %u threads %.1fms (%.1f Mpixels/s)", formatCase.pName, cQualityNames[q], width, height,
+                 microseconds / 1000.0, microseconds > 0.0 ? megapixels / (microseconds / 1000000.0) : 0.0,
+                 numThreads, parallelMicroseconds / 1000.0, parallelMicroseconds > 0.0 ? megapixels / (parallelMicroseconds / 1000000.0) : 0.0);
+        }
+    }
+}
@@ -0,0 +1,223 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "texture/textureConvert.hpp"
+#include "system/os_common.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+    /// Double precision sRGB encode, rounded to nearest.
+    uint8_t ReferenceLinearToSrgb8(float linearF)
+    {
+        const double linear = std::min(std::max(double(linearF), 0.0), 1.0);
+        return uint8_t(255.0 * (linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055) + 0.5);
+    }
+
+    float FloatFromBits(uint32_t bits)
+    {
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    /// Encode every float in the given bit pattern range (stepping by stride) and count the results that differ from the reference.
+    uint32_t CountEncodeMismatches(uint32_t beginBits, uint32_t endBits, uint32_t stride)
+    {
+        std::vector<float> linear;
+        for (uint32_t bits = beginBits; bits < endBits; bits += stride)
+            linear.push_back(FloatFromBits(bits));
+        std::vector<uint8_t> encoded(linear.size());
+        ConvertLinearToSrgb8(linear.data(), encoded.data(), linear.size());
+        uint32_t numMismatches = 0;
+        for (size_t i = 0; i < linear.size(); ++i)
+            numMismatches += encoded[i] != ReferenceLinearToSrgb8(linear[i]) ? 1 : 0;
+        return numMismatches;
+    }
+    /// Correctly rounded (to nearest, ties to even) unsigned float with a 5 bit exponent and the given mantissa bits, finite values clamped to the largest finite value.
+    uint32_t ReferenceUfloat(float value, uint32_t mantissaBits)
+    {
+        const uint32_t maxFinite = (30u << mantissaBits) | ((1u << mantissaBits) - 1);
+        auto decode = [mantissaBits](uint32_t code) {
+            const uint32_t exponent = code >> mantissaBits;
+            const double mantissa = double(code & ((1u << mantissaBits) - 1)) / double(1u << mantissaBits);
+            return exponent == 0 ? std::ldexp(mantissa, -14) : std::ldexp(1.0 + mantissa, int(exponent) - 15);
+        };
+        if (std::isnan(value))
+            return (31u << mantissaBits) | ((1u << mantissaBits) - 1);
+        if (value <= 0.0f)
+            return 0;
+        if (std::isinf(value))
+            return 31u << mantissaBits;
+        // Codes are in increasing value order, find the first code >= value.
+        uint32_t lo = 0, hi = maxFinite + 1;
+        while (lo < hi)
+        {
+            const uint32_t mid = (lo + hi) / 2;
+            if (decode(mid) < value)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo > maxFinite)
+            return maxFinite;
+        if (lo == 0)
+            return 0;
+        const double below = value - decode(lo - 1), above = decode(lo) - value;
+        return (below < above || (below == above && ((lo - 1) & 1) == 0)) ? lo - 1 : lo;
+    }
+
+    uint32_t ReferencePackR11G11B10(const float* rgb)
+    {
+        return ReferenceUfloat(rgb[0], 6) | (ReferenceUfloat(rgb[1], 6) << 11) | (ReferenceUfloat(rgb[2], 5) << 22);
+    }
+}
+
+TEST_CASE(TextureConvert_LinearToSrgb8CorrectlyRounded)
+{
+    // Sparse sweep of every float in 0-1 (a full sweep is ~1 billion values)...
+    const uint32_t oneBits = 0x3f800000u;
+    CHECK(CountEncodeMismatches(0, oneBits + 1, 997) == 0);
+
+    // ... and every float close to each of the 255 rounding boundaries (where table errors would show up).
+    for (uint32_t value = 0; value < 255; ++value)
+    {
+        const double srgb = (value + 0.5) / 255.0;
+        const float boundary = float(srgb <= 0.04045 ? srgb / 12.92 : std::pow((srgb + 0.055) / 1.055, 2.4));
+        uint32_t boundaryBits;
+        memcpy(&boundaryBits, &boundary, sizeof(boundaryBits));
+        CHECK(CountEncodeMismatches(boundaryBits - 1024, boundaryBits + 1024, 1) == 0);
+    }
+
+    // Out of range values clamp.
+    const float special[] = { -1.0f, -0.0f, 0.0f, 1.0f, 2.0f, INFINITY, -INFINITY, NAN, -NAN };
+    const uint8_t expected[] = { 0, 0, 0, 255, 255, 255, 0, 0, 0 };
+    uint8_t encoded[std::size(special)];
+    ConvertLinearToSrgb8(special, encoded, std::size(special));
+    CHECK(memcmp(encoded, expected, sizeof(expected)) == 0);
+}
+
+TEST_CASE(TextureConvert_Srgb8RoundTrips)
+{
+    uint8_t srgb[256];
+    for (uint32_t i = 0; i < 256; ++i)
+        srgb[i] = uint8_t(i);
+    float linear[256];
+    ConvertSrgb8ToLinear(srgb, linear, 256);
+    uint8_t roundTrip[256];
+    ConvertLinearToSrgb8(linear, roundTrip, 256);
+    CHECK(memcmp(srgb, roundTrip, sizeof(srgb)) == 0);
+    for (uint32_t i = 0; i < 256; ++i)
+        CHECK_NEAR(linear[i], SrgbToLinear(i / 255.0f), 1e-6f);
+}
+
+TEST_CASE(TextureConvert_HalfMatchesScalar)
+{
+    // Every half converts to float and back unchanged (nans stay nans).
+    std::vector<uint16_t> halves(65536);
+    for (uint32_t i = 0; i < 65536; ++i)
+        halves[i] = uint16_t(i);
+    std::vector<float> floats(halves.size());
+    ConvertHalfToFloat(halves.data(), floats.data(), halves.size());
+    std::vector<uint16_t> roundTrip(halves.size());
+    ConvertFloatToHalf(floats.data(), roundTrip.data(), floats.size());
+    uint32_t numMismatches = 0;
+    for (uint32_t i = 0; i < 65536; ++i)
+    {
+        const bool isNan = (i & 0x7c00u) == 0x7c00u && (i & 0x3ffu) != 0;
+        numMismatches += (floats[i] == HalfToFloat(halves[i]) || isNan) && (roundTrip[i] == halves[i] || (isNan && (roundTrip[i] & 0x7c00u) == 0x7c00u && (roundTrip[i] & 0x3ffu) != 0)) ? 0 : 1;
+    }
+    CHECK(numMismatches == 0);
+
+    // Batched conversion (simd) matches the scalar FloatToHalf across a sparse sweep of all floats.
+    std::vector<float> sweep;
+    for (uint64_t bits = 0; bits <= 0xffffffffull; bits += 65521)
+        sweep.push_back(FloatFromBits(uint32_t(bits)));
+    std::vector<uint16_t> converted(sweep.size());
+    ConvertFloatToHalf(sweep.data(), converted.data(), sweep.size());
+    numMismatches = 0;
+    for (size_t i = 0; i < sweep.size(); ++i)
+        numMismatches += converted[i] == FloatToHalf(sweep[i]) ? 0 : 1;
+    CHECK(numMismatches == 0);
+
+    // Round to nearest even, overflow to infinity.
+    CHECK(FloatToHalf(1.0f + 1.0f / 2048.0f) == 0x3c00);            // tie, rounds to even
+    CHECK(FloatToHalf(1.0f + 3.0f / 2048.0f) == 0x3c02);            // tie, rounds to even
+    CHECK(FloatToHalf(65504.0f) == 0x7bff);
+    CHECK(FloatToHalf(65520.0f) == 0x7c00);
+    CHECK(FloatToHalf(-2.0f) == 0xc000);
+    CHECK(FloatToHalf(5.9604645e-08f) == 0x0001);                   // smallest subnormal
+}
+
+TEST_CASE(TextureConvert_R11G11B10CorrectlyRounded)
+{
+    // Sparse sweep of every positive float (and some negatives) packed in all three channels.
+    std::vector<float> rgb;
+    for (uint64_t bits = 0; bits <= 0x80100000ull; bits += 4093)
+        rgb.push_back(FloatFromBits(uint32_t(bits)));
+    rgb.resize(rgb.size() - rgb.size() % 3);
+    std::vector<uint32_t> packed(rgb.size() / 3);
+    PackR11G11B10(rgb.data(), 3, packed.data(), packed.size());
+    uint32_t numMismatches = 0;
+    for (size_t i = 0; i < packed.size(); ++i)
+        numMismatches += packed[i] == ReferencePackR11G11B10(&rgb[i * 3]) ? 0 : 1;
+    CHECK(numMismatches == 0);
+
+    // Rounded once (going through a half first rounds 1 + 2^-7 + 2^-20 down to the 1 + 2^-7 tie, then down again to 1.0).
+    const float justOverTie[4] = { 1.0f + 1.0f / 128.0f + 1.0f / (1024.0f * 1024.0f), 0.0f, 0.0f, 0.0f };
+    uint32_t justOverTiePacked;
+    PackR11G11B10(justOverTie, 4, &justOverTiePacked, 1);
+    CHECK(justOverTiePacked == ((15u << 6) | 1u));
+
+    // Large values clamp to the largest finite value, infinity and nan are kept, negatives clamp to zero.
+    const float special[] = { 65520.0f, 65520.0f, 65520.0f, 1.0e30f, 70000.0f, 64600.0f, INFINITY, NAN, -1.0f };
+    uint32_t specialPacked[3];
+    PackR11G11B10(special, 3, specialPacked, 3);
+    CHECK(specialPacked[0] == (0x7bfu | (0x7bfu << 11) | (0x3dfu << 22)));
+    CHECK(specialPacked[1] == (0x7bfu | (0x7bfu << 11) | (0x3dfu << 22)));
+    CHECK(specialPacked[2] == (0x7c0u | (0x7ffu << 11)));
+
+    // Unpacking is exact, and packing an unpacked value gives back the same bits.
+    std::vector<uint32_t> allCodes;
+    for (uint32_t code = 0; code < 0x7c0u; ++code)
+        allCodes.push_back(code | (code << 11) | ((code >> 1) << 22));
+    std::vector<float> unpacked(allCodes.size() * 4, -1.0f);
+    UnpackR11G11B10(allCodes.data(), unpacked.data(), 4, allCodes.size());
+    std::vector<uint32_t> repacked(allCodes.size());
+    PackR11G11B10(unpacked.data(), 4, repacked.data(), repacked.size());
+    CHECK(repacked == allCodes);
+    CHECK(unpacked[3] == -1.0f);    // alpha untouched
+    CHECK(unpacked[0x7bfu * 4] == 65024.0f);
+}
+
+BENCHMARK_CASE(TextureConvert_SrgbThroughput)
+{
+    // 4 million values (a 1024x1024 RGBA8 image).
+    const size_t numValues = 4 * 1024 * 1024;
+    const uint32_t numIterations = 20;
+    std::vector<float> linear(numValues);
+    std::vector<uint8_t> srgb(numValues);
+    for (size_t i = 0; i < numValues; ++i)
+        srgb[i] = uint8_t((i * 7919) >> 3);
+
+    const double decodeMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() {
+        ConvertSrgb8ToLinear(srgb.data(), linear.data(), numValues);
+    });
+    const double encodeMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() {
+        ConvertLinearToSrgb8(linear.data(), srgb.data(), numValues);
+    });
+
+    LOGI("TextureConvert: %zu values, sRGB decode %.1fus (%.0f Mvalues/s), sRGB encode %.1fus (%.0f Mvalues/s)", numValues,
+         decodeMicroseconds, decodeMicroseconds > 0.0 ? numValues / decodeMicroseconds : 0.0,
+         encodeMicroseconds, encodeMicroseconds > 0.0 ? numValues / encodeMicroseconds : 0.0);
+}
@@ -0,0 +1,170 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "system/assetCache.hpp"
+#include "system/assetManager.hpp"
+#include "system/os_common.h"
+#include "system/Worker.h"
+#include "texture/vulkan/loaderKtx.hpp"
+#include "vulkan/vulkan.hpp"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// Ktx (version 1) file holding an uncompressed RGBA8 2d texture with a full mip chain (filled with a pattern based on seed).
+    std::vector<uint8_t> MakeKtxFile(uint32_t size, uint32_t seed)
+    {
+        const uint8_t cIdentifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+        uint32_t numLevels = 1;
+        while ((size >> numLevels) > 0)
+            ++numLevels;
+        const uint32_t header[13] = {
+            0x04030201, // endianness
+            0x1401,     // glType GL_UNSIGNED_BYTE
+            1,          // glTypeSize
+            0x1908,     // glFormat GL_RGBA
+            0x8058,     // glInternalFormat GL_RGBA8
+            0x1908,     // glBaseInternalFormat GL_RGBA
+            size, size, 0/*pixelDepth*/, 0/*numberOfArrayElements*/, 1/*numberOfFaces*/, numLevels, 0/*bytesOfKeyValueData*/ };
+
+        std::vector<uint8_t> file(sizeof(cIdentifier) + sizeof(header));
+        memcpy(file.data(), cIdentifier, sizeof(cIdentifier));
+        memcpy(file.data() + sizeof(cIdentifier), header, sizeof(header));
+        for (uint32_t level = 0; level < numLevels; ++level)
+        {
+            // RGBA8 rows are always 4 byte aligned (no row or mip padding needed).
+            const uint32_t levelSize = std::max(size >> level, 1u);
+            const uint32_t imageSize = levelSize * levelSize * 4;
+            const size_t offset = file.size();
+            file.resize(offset + sizeof(imageSize) + imageSize);
+            memcpy(file.data() + offset, &imageSize, sizeof(imageSize));
+            for (uint32_t i = 0; i < imageSize; ++i)
+                file[offset + sizeof(imageSize) + i] = uint8_t(i * 31 + seed * 17 + level);
+        }
+        return file;
+    }
+
+    /// AssetCache serving the generated files from memory.  With a zero budget every load is a miss (copied out of Files, like a read from storage).
+    class TestAssetCache : public AssetCache
+    {
+    public:
+        TestAssetCache(AssetManager& assetManager) : AssetCache(assetManager, 0) {}
+
+        std::map<std::string, std::vector<uint8_t>> Files;
+
+    protected:
+        bool LoadFromStorage(const std::string& portableFileName, std::vector<uint8_t>& fileData) override
+        {
+            auto it = Files.find(portableFileName);
+            if (it == Files.end())
+                return false;
+            fileData = it->second;
+            return true;
+        }
+    };
+
+    struct TextureFiles
+    {
+        TextureFiles(uint32_t numTextures, uint32_t size) : Cache(Assets)
+        {
+            Assets.SetAssetCache(&Cache);
+            for (uint32_t i = 0; i < numTextures; ++i)
+            {
+                Names.push_back("texture" + std::to_string(i) + ".ktx");
+                Cache.Files[Names.back()] = MakeKtxFile(size, i);
+            }
+        }
+        ~TextureFiles() { Assets.SetAssetCache(nullptr); }
+
+        AssetManager                Assets;
+        TestAssetCache              Cache;
+        std::vector<std::string>    Names;
+    };
+}
+
+TEST_CASE(TextureLoad_ReadAndTranscode)
+{
+    TextureFiles files(2, 64);
+    Vulkan vulkan;  // not initialized, Transcode only needs the loader's (default) target format
+    TextureKtx<Vulkan> loader(vulkan);
+
+    auto textureFile = loader.Transcode(loader.LoadFile(files.Assets, files.Names[0].c_str()));
+    CHECK(textureFile);
+    uint32_t width = 0, height = 0, numLevels = 0;
+    CHECK(loader.Get2dDimensions(textureFile, width, height, numLevels));
+    CHECK(width == 64 && height == 64 && numLevels == 7);
+    const auto levelSizes = loader.GetLevelDataSizes(textureFile);
+    CHECK(levelSizes.size() == 7 && levelSizes[0] == 64 * 64 * 4 && levelSizes[6] == 4);
+    CHECK(loader.CanStream(textureFile));
+
+    CHECK(!loader.LoadFile(files.Assets, "missing.ktx"));
+}
+
+BENCHMARK_CASE(TextureLoad_ReadTranscodeTiming)
+{
+    // The read and transcode stages of TextureManager::BatchLoad (file data comes from memory, so 'read' is the copy and ktx header parse).
+    // Generated files are uncompressed so the transcode stage is the image data load; basis/zstd textures will be considerably slower to transcode.
+    const uint32_t numTextures = 32;
+    const uint32_t numIterations = 4;
+    TextureFiles files(numTextures, 512);
+    Vulkan vulkan;
+    TextureKtx<Vulkan> loader(vulkan);
+    ThreadWorker worker;
+    worker.Initialize("TextureLoad", 4);
+
+    std::vector<TextureKtxFileWrapper> readFiles(numTextures);
+    std::vector<TextureKtxFileWrapper> transcodedFiles(numTextures);
+    const double readMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() {
+        for (uint32_t i = 0; i < numTextures; ++i)
+        {
+            readFiles[i].Release();
+            readFiles[i] = loader.LoadFile(files.Assets, files.Names[i].c_str());
+        }
+    });
+    double transcodeMicroseconds = 0.0;
+    for (uint32_t iteration = 0; iteration < numIterations; ++iteration)
+    {
+        for (uint32_t i = 0; i < numTextures; ++i)
+        {
+            readFiles[i].Release();
+            readFiles[i] = loader.LoadFile(files.Assets, files.Names[i].c_str());
+        }
+        transcodeMicroseconds += FrameworkTest::TimeMicroseconds(1, [&]() {
+            for (uint32_t i = 0; i < numTextures; ++i)
+            {
+                transcodedFiles[i].Release();
+                transcodedFiles[i] = loader.Transcode(std::move(readFiles[i]));
+            }
+        });
+    }
+    transcodeMicroseconds /= numIterations;
+    const double parallelMicroseconds = FrameworkTest::TimeMicroseconds(numIterations, [&]() {
+        worker.ParallelFor(numTextures, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                transcodedFiles[i].Release();
+                transcodedFiles[i] = loader.Transcode(loader.LoadFile(files.Assets, files.Names[i].c_str()));
+            }
+        });
+    });
+
+    size_t transcodedBytes = 0;
+    for (const auto& transcodedFile : transcodedFiles)
+    {
+        const auto levelSizes = loader.GetLevelDataSizes(transcodedFile);
+        for (size_t levelSize : levelSizes)
+            transcodedBytes += levelSize;
+    }
+    LOGI("TextureLoad: %u textures (%.1fMB transcoded)", numTextures, double(transcodedBytes) / (1024.0 * 1024.0));
+    LOGI("TextureLoad: read %.1fus, transcode %.1fus, read+transcode on %u threads %.1fus", readMicroseconds, transcodeMicroseconds, worker.NumThreads(), parallelMicroseconds);
+}
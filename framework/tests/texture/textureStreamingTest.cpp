@@ -0,0 +1,151 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+#include "frameworkTest.hpp"
+#include "texture/textureStreaming.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    /// Level sizes of an RGBA8 square texture with a full mip chain.
+    std::vector<size_t> MakeLevelBytes(uint32_t size)
+    {
+        std::vector<size_t> levelBytes;
+        for (uint32_t levelSize = size; levelSize > 0; levelSize >>= 1)
+            levelBytes.push_back(size_t(levelSize) * levelSize * 4);
+        return levelBytes;
+    }
+
+    size_t SumTargetBytes(const TextureStreamingResidency& residency, std::span<const TextureStreamingResidency::tHandle> handles, const std::vector<size_t>& levelBytes)
+    {
+        size_t bytes = 0;
+        for (auto handle : handles)
+            for (size_t level = residency.GetTargetMip(handle); level < levelBytes.size(); ++level)
+                bytes += levelBytes[level];
+        return bytes;
+    }
+}
+
+TEST_CASE(TextureStreaming_MipTailFirstLevel)
+{
+    CHECK(TextureStreamingResidency::CalculateMipTailFirstLevel(1024, 1024, 11, 256) == 2);
+    CHECK(TextureStreamingResidency::CalculateMipTailFirstLevel(1024, 256, 11, 256) == 2);
+    CHECK(TextureStreamingResidency::CalculateMipTailFirstLevel(256, 256, 9, 256) == 0);
+    // Only the smallest mip fits (never past the last level).
+    CHECK(TextureStreamingResidency::CalculateMipTailFirstLevel(1024, 1024, 3, 16) == 2);
+}
+
+TEST_CASE(TextureStreaming_LoadsWithinBudget)
+{
+    const auto levelBytes = MakeLevelBytes(1024);   // mip 0 4MB, mip 1 1MB, mip 2 256KB ...
+    TextureStreamingResidency residency(64 * 1024 * 1024);
+    const auto handle = residency.Register(levelBytes, 2);
+    CHECK(residency.GetResidentMip(handle) == 2);
+    CHECK(residency.GetResidentBytes() == residency.GetMipTailBytes());
+
+    // Plenty of budget, get the requested mip.
+    residency.RequestMip(handle, 0.5f, 1.0f);
+    const auto changes = residency.Update();
+    CHECK(changes.size() == 1);
+    CHECK(changes[0].Handle == handle && changes[0].FromMip == 2 && changes[0].ToMip == 0);
+    residency.SetResidentMip(handle, changes[0].ToMip);
+    CHECK(residency.GetResidentBytes() == levelBytes[0] + levelBytes[1] + residency.GetMipTailBytes());
+
+    // Unrequested textures keep their mips for the eviction delay, then drop back to the tail.
+    residency.SetEvictionDelayFrames(2);
+    CHECK(residency.Update().empty());
+    CHECK(residency.Update().empty());
+    const auto evictions = residency.Update();
+    CHECK(evictions.size() == 1 && evictions[0].ToMip == 2);
+}
+
+TEST_CASE(TextureStreaming_BudgetLimit)
+{
+    const auto levelBytes = MakeLevelBytes(1024);
+    std::vector<TextureStreamingResidency::tHandle> handles;
+    TextureStreamingResidency residency(0);
+    for (uint32_t i = 0; i < 8; ++i)
+        handles.push_back(residency.Register(levelBytes, 3));
+
+    // Budget for the tails plus about two full textures.
+    const size_t budget = residency.GetMipTailBytes() + 2 * (levelBytes[0] + levelBytes[1] + levelBytes[2]);
+    residency.SetBudget(budget);
+    for (uint32_t i = 0; i < 8; ++i)
+        residency.RequestMip(handles[i], 0.0f, 1.0f + float(i));
+    residency.Update();
+    CHECK(SumTargetBytes(residency, handles, levelBytes) <= budget);
+    // Higher priority textures never get a smaller mip than lower priority ones.
+    for (uint32_t i = 1; i < 8; ++i)
+        CHECK(residency.GetTargetMip(handles[i]) <= residency.GetTargetMip(handles[i - 1]));
+    CHECK(residency.GetTargetMip(handles[7]) < 3);
+
+    // Budget smaller than the tails, everything goes to (but not past) the tail.
+    residency.SetBudget(residency.GetMipTailBytes() / 2);
+    for (auto handle : handles)
+        residency.RequestMip(handle, 0.0f, 1.0f);
+    residency.Update();
+    for (auto handle : handles)
+        CHECK(residency.GetTargetMip(handle) == 3);
+}
+
+TEST_CASE(TextureStreaming_ReductionsSpreadAcrossTextures)
+{
+    const auto levelBytes = MakeLevelBytes(1024);
+    TextureStreamingResidency residency(0);
+    const auto lowHandle = residency.Register(levelBytes, 3);
+    const auto highHandle = residency.Register(levelBytes, 3);
+
+    // Room for both textures at mip 1, the low priority texture should not be cut to its tail (to keep the other at mip 0).
+    residency.SetBudget(residency.GetMipTailBytes() + 2 * (levelBytes[1] + levelBytes[2]));
+    residency.RequestMip(lowHandle, 0.0f, 0.5f);
+    residency.RequestMip(highHandle, 0.0f, 1.0f);
+    residency.Update();
+    CHECK(residency.GetTargetMip(lowHandle) == 1);
+    CHECK(residency.GetTargetMip(highHandle) == 1);
+
+    // Same for textures that have no priority.
+    residency.RequestMip(lowHandle, 0.0f, 0.0f);
+    residency.RequestMip(highHandle, 0.0f, 0.0f);
+    residency.Update();
+    CHECK(residency.GetTargetMip(lowHandle) == 1);
+    CHECK(residency.GetTargetMip(highHandle) == 1);
+}
+
+TEST_CASE(TextureStreaming_MipClampedToTail)
+{
+    const auto levelBytes = MakeLevelBytes(1024);
+    TextureStreamingResidency residency(64 * 1024 * 1024);
+    const auto handle = residency.Register(levelBytes, 3);
+
+    // Requests coarser than the tail are clamped to it (nothing to do), negative requests to mip 0.
+    residency.RequestMip(handle, 8.0f, 1.0f);
+    CHECK(residency.Update().empty());
+    CHECK(residency.GetTargetMip(handle) == 3);
+    residency.RequestMip(handle, -2.0f, 1.0f);
+    residency.Update();
+    CHECK(residency.GetTargetMip(handle) == 0);
+
+    // Tail past the last level is clamped to the last level.
+    const auto smallHandle = residency.Register(levelBytes, 100);
+    CHECK(residency.GetMipTailFirstLevel(smallHandle) == uint32_t(levelBytes.size() - 1));
+}
+
+TEST_CASE(TextureStreaming_LoadsLimitedPerUpdate)
+{
+    const auto levelBytes = MakeLevelBytes(1024);
+    TextureStreamingResidency residency(64 * 1024 * 1024);
+    residency.SetMaxLoadBytesPerUpdate(1);
+    const auto handleA = residency.Register(levelBytes, 3);
+    const auto handleB = residency.Register(levelBytes, 3);
+    residency.RequestMip(handleA, 0.0f, 1.0f);
+    residency.RequestMip(handleB, 0.0f, 2.0f);
+    // At least one load is returned, the highest priority first.
+    const auto changes = residency.Update();
+    CHECK(changes.size() == 1 && changes[0].Handle == handleB);
+}
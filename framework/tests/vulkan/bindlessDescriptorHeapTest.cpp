@@ -0,0 +1,97 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+// BindlessHandleAllocator and BindlessMaterialTable make no Vulkan calls, so these tests need no device.
+
+#include "frameworkTest.hpp"
+#include "vulkan/bindlessDescriptorHeap.hpp"
+#include <vector>
+
+TEST_CASE(BindlessHandleAllocator_AllocateLowestFirst)
+{
+    BindlessHandleAllocator handles(4);
+    CHECK(handles.GetCapacity() == 4);
+    for (uint32_t i = 0; i < 4; ++i)
+        CHECK(handles.Allocate() == i);
+    CHECK(handles.Allocate() == BindlessHandleAllocator::cInvalidHandle);
+    CHECK(handles.GetNumAllocated() == 4 && handles.GetHighWaterMark() == 4);
+
+    // Freed handles are reused lowest first (keeping the live range compact).
+    CHECK(handles.Release(3) && handles.Release(1));
+    handles.NextFrame(0);
+    CHECK(handles.Allocate() == 1);
+    CHECK(handles.Allocate() == 3);
+
+    handles.Reset(2);
+    CHECK(handles.GetCapacity() == 2 && handles.GetNumAllocated() == 0 && !handles.IsAllocated(0));
+    CHECK(handles.Allocate() == 0);
+}
+
+TEST_CASE(BindlessHandleAllocator_RetireByFrame)
+{
+    BindlessHandleAllocator handles(8);
+    const uint32_t handleA = handles.Allocate();
+    const uint32_t handleB = handles.Allocate();
+
+    // Released handles stay allocated until framesInFlight frames have completed.
+    CHECK(handles.Release(handleA));
+    CHECK(handles.IsAllocated(handleA) && handles.IsRetired(handleA));
+    CHECK(handles.GetNumRetired() == 1 && handles.GetNumAllocated() == 2);
+    handles.NextFrame(2);
+    CHECK(handles.IsAllocated(handleA));
+    CHECK(handles.Allocate() == 2);     // not handleA
+    CHECK(handles.Release(handleB));    // released a frame later than handleA
+    handles.NextFrame(2);
+    CHECK(!handles.IsAllocated(handleA) && !handles.IsRetired(handleA));
+    CHECK(handles.IsAllocated(handleB) && handles.IsRetired(handleB));
+    CHECK(handles.GetNumRetired() == 1 && handles.GetNumAllocated() == 2);
+    handles.NextFrame(2);
+    CHECK(!handles.IsAllocated(handleB) && handles.GetNumRetired() == 0 && handles.GetNumAllocated() == 1);
+
+    // Both are free to be allocated (lowest first).
+    CHECK(handles.Allocate() == handleA);
+    CHECK(handles.Allocate() == handleB);
+    CHECK(handles.GetHighWaterMark() == 3);
+}
+
+TEST_CASE(BindlessHandleAllocator_DoubleReleaseRejected)
+{
+    BindlessHandleAllocator handles(4);
+    const uint32_t handle = handles.Allocate();
+    CHECK(handles.Release(handle));
+    // Second release (before or after the frame advances) is rejected, so the handle is only queued once.
+    CHECK(!handles.Release(handle));
+    handles.NextFrame(2);
+    CHECK(!handles.Release(handle));
+    CHECK(handles.GetNumRetired() == 1);
+    handles.NextFrame(2);
+    CHECK(handles.GetNumAllocated() == 0);
+
+    // The handle has one owner when it is reused.
+    CHECK(handles.Allocate() == handle);
+    CHECK(handles.Allocate() == 1);
+    CHECK(handles.GetNumAllocated() == 2);
+
+    // Reallocated handle can be released again.
+    CHECK(handles.Release(handle));
+}
+
+TEST_CASE(BindlessMaterialTable_SetAndRelease)
+{
+    BindlessMaterialTable table(20, 4);
+    CHECK(table.GetStride() == 32);     // rounded up to cStrideAlignment
+    const uint32_t materialId = table.Allocate();
+    CHECK(materialId == 0);
+    const float color[4] = { 1.0f, 0.5f, 0.25f, 1.0f };
+    CHECK(table.Set(materialId, color));
+    CHECK(!table.Set(materialId, color, 20));   // does not fit in the record
+    CHECK(!table.Set(3, color));                // not allocated
+
+    CHECK(table.Release(materialId));
+    CHECK(!table.Release(materialId));
+}
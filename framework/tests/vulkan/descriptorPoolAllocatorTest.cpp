@@ -0,0 +1,166 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+// DescriptorPoolBuckets holds all the DescriptorPoolAllocator policy (and makes no Vulkan calls), so these tests need no device.
+// Set handles are made up values (never passed to Vulkan).
+
+#include "frameworkTest.hpp"
+#include "vulkan/descriptorPoolAllocator.hpp"
+#include <vector>
+
+namespace
+{
+    VkDescriptorSet FakeSet(uint64_t value)
+    {
+        return (VkDescriptorSet) (uintptr_t) value;
+    }
+
+    const VkDescriptorPoolSize cMaterialSet[] = { { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 3 }, { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 } };
+}
+
+TEST_CASE(DescriptorPoolBuckets_SizeClass)
+{
+    // Types are merged, sorted and rounded up to a power of two, empty types are dropped.
+    const VkDescriptorPoolSize poolSizes[] = { { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 }, { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2 }, { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0 }, { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 3 } };
+    const auto sizeClass = DescriptorPoolBuckets::CalculateSizeClass(poolSizes);
+    CHECK(sizeClass.size() == 2);
+    CHECK(sizeClass[0].type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER && sizeClass[0].descriptorCount == 8);
+    CHECK(sizeClass[1].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER && sizeClass[1].descriptorCount == 1);
+    CHECK(DescriptorPoolBuckets::DescriptorCount(poolSizes) == 6);
+}
+
+TEST_CASE(DescriptorPoolBuckets_BucketSelection)
+{
+    DescriptorPoolBuckets buckets(4, 16);
+    bool newPool = false;
+    const auto slot = buckets.Allocate(cMaterialSet, 0, newPool);
+    CHECK(newPool && slot.IsValid() && slot.Bucket == 0 && slot.Pool == 0);
+
+    // 4 images is the same size class as 3, so shares the bucket (and pool).
+    const VkDescriptorPoolSize fourImages[] = { { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 }, { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 } };
+    const auto sameClassSlot = buckets.Allocate(fourImages, 0, newPool);
+    CHECK(!newPool && sameClassSlot.Bucket == 0 && sameClassSlot.Pool == 0);
+
+    // 5 images is the next size class, different pool flags are a different bucket too.
+    const VkDescriptorPoolSize fiveImages[] = { { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 5 }, { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 } };
+    CHECK(buckets.Allocate(fiveImages, 0, newPool).Bucket == 1 && newPool);
+    CHECK(buckets.Allocate(cMaterialSet, VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT, newPool).Bucket == 2 && newPool);
+    CHECK(buckets.GetNumBuckets() == 3);
+    CHECK(buckets.GetPoolFlags(slot) == 0);
+
+    // Pool holds a whole number of size class sets.
+    const auto poolSizes = buckets.GetPoolSizes(slot);
+    CHECK(buckets.GetPoolSetCount(slot) == 4);
+    CHECK(poolSizes.size() == 2 && poolSizes[0].descriptorCount == 4 * 4 && poolSizes[1].descriptorCount == 4 * 1);
+
+    const auto stats = buckets.GetStats();
+    CHECK(stats.Buckets == 3 && stats.Pools == 3 && stats.SetsAllocated == 4 && stats.SetsCapacity == 12);
+    CHECK(stats.DescriptorsRequested == 4 + 5 + 6 + 4);
+    CHECK(stats.DescriptorsReserved == 5 + 5 + 9 + 5);
+}
+
+TEST_CASE(DescriptorPoolBuckets_GrowsWhenPoolFull)
+{
+    // Pools double in size up to the maximum.
+    DescriptorPoolBuckets buckets(2, 8);
+    std::vector<uint32_t> setsPerPool;
+    for (uint32_t i = 0; i < 2 + 4 + 8 + 8; ++i)
+    {
+        bool newPool = false;
+        const auto slot = buckets.Allocate(cMaterialSet, 0, newPool);
+        if (newPool)
+        {
+            CHECK(slot.Pool == setsPerPool.size());
+            setsPerPool.push_back(buckets.GetPoolSetCount(slot));
+        }
+    }
+    CHECK(setsPerPool == std::vector<uint32_t>({ 2, 4, 8, 8 }));
+    CHECK(buckets.GetStats().Fragmentation() == 0.0f);
+
+    // A pool the driver reported as full is skipped until a set is freed from it.
+    DescriptorPoolBuckets fullBuckets(2, 8);
+    bool newPool = false;
+    const auto firstSlot = fullBuckets.Allocate(cMaterialSet, 0, newPool);
+    fullBuckets.MarkPoolFull(firstSlot);
+    CHECK(fullBuckets.Allocate(cMaterialSet, 0, newPool).Pool == 1 && newPool);
+    fullBuckets.Free(firstSlot, DescriptorPoolBuckets::DescriptorCount(cMaterialSet));
+    CHECK(fullBuckets.Allocate(cMaterialSet, 0, newPool).Pool == 0 && !newPool);
+}
+
+TEST_CASE(DescriptorPoolBuckets_RetireAndReuse)
+{
+    DescriptorPoolBuckets buckets(2, 8);
+    bool newPool = false;
+    const uint32_t numDescriptors = DescriptorPoolBuckets::DescriptorCount(cMaterialSet);
+    const auto slotA = buckets.Allocate(cMaterialSet, 0, newPool);
+    const auto slotB = buckets.Allocate(cMaterialSet, 0, newPool);
+
+    // Retired sets keep their space until framesInFlight frames have passed.
+    buckets.Retire(slotA, FakeSet(0x100), numDescriptors);
+    CHECK(buckets.GetStats().SetsRetired == 1 && buckets.GetStats().SetsAllocated == 2);
+    CHECK(buckets.NextFrame(2).empty());
+    CHECK(buckets.Allocate(cMaterialSet, 0, newPool).Pool == 1 && newPool);
+    const auto released = buckets.NextFrame(2);
+    CHECK(released.size() == 1 && released[0].Set == FakeSet(0x100) && released[0].PoolSlot.Pool == slotA.Pool);
+    CHECK(buckets.GetStats().SetsRetired == 0);
+
+    // Freed space is reused (earliest pool first) without a new pool.
+    CHECK(buckets.Allocate(cMaterialSet, 0, newPool).Pool == 0 && !newPool);
+
+    // TakeAllRetired frees regardless of frame.
+    buckets.Retire(slotB, FakeSet(0x200), numDescriptors);
+    CHECK(buckets.TakeAllRetired().size() == 1);
+    CHECK(buckets.GetStats().SetsRetired == 0 && buckets.GetStats().SetsAllocated == 2);
+    CHECK(buckets.GetStats().DescriptorsRequested == 2 * numDescriptors);
+
+    buckets.Clear();
+    CHECK(buckets.GetNumBuckets() == 0 && buckets.GetStats().Pools == 0);
+}
+
+TEST_CASE(DescriptorPoolBuckets_ReleasesEmptyPools)
+{
+    const uint32_t releaseDelayFrames = 3;
+    DescriptorPoolBuckets buckets(2, 8, releaseDelayFrames);
+    const uint32_t numDescriptors = DescriptorPoolBuckets::DescriptorCount(cMaterialSet);
+    std::vector<DescriptorPoolBuckets::Slot> slots;
+    bool newPool = false;
+    for (uint32_t i = 0; i < 2 + 4; ++i)
+        slots.push_back(buckets.Allocate(cMaterialSet, 0, newPool));
+    CHECK(buckets.GetNumPools(0) == 2);
+
+    // Empty every pool, only the second pool is released (the first pool of a bucket is kept), and only after the delay.
+    for (const auto& slot : slots)
+        buckets.Free(slot, numDescriptors);
+    for (uint32_t frame = 0; frame < releaseDelayFrames - 1; ++frame)
+    {
+        buckets.NextFrame(2);
+        CHECK(buckets.TakeReleasedPools().empty());
+    }
+    buckets.NextFrame(2);
+    const auto releasedPools = buckets.TakeReleasedPools();
+    CHECK(releasedPools.size() == 1 && releasedPools[0].Bucket == 0 && releasedPools[0].Pool == 1);
+    CHECK(buckets.IsPoolReleased(releasedPools[0]));
+    CHECK(buckets.GetStats().Pools == 1 && buckets.GetStats().SetsCapacity == 2);
+    buckets.NextFrame(2);
+    CHECK(buckets.TakeReleasedPools().empty());
+
+    // Released slot is reused (at its original size) for the next new pool.
+    for (uint32_t i = 0; i < 3; ++i)
+        slots[i] = buckets.Allocate(cMaterialSet, 0, newPool);
+    CHECK(slots[2].Pool == 1 && newPool && buckets.GetPoolSetCount(slots[2]) == 4);
+
+    // Pool that is used again before the delay is kept.
+    buckets.Free(slots[2], numDescriptors);
+    buckets.NextFrame(2);
+    slots[2] = buckets.Allocate(cMaterialSet, 0, newPool);
+    CHECK(slots[2].Pool == 1 && !newPool);
+    for (uint32_t frame = 0; frame < 2 * releaseDelayFrames; ++frame)
+        buckets.NextFrame(2);
+    CHECK(buckets.TakeReleasedPools().empty());
+    CHECK(buckets.GetNumPools(0) == 2 && buckets.GetStats().Pools == 2);
+}
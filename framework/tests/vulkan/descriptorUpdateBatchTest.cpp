@@ -0,0 +1,236 @@
+//============================================================================================================
+//
+//
+//                  Copyright (c) 2025, Qualcomm Innovation Center, Inc. All rights reserved.
+//                              SPDX-License-Identifier: BSD-3-Clause
+//
+//============================================================================================================
+
+// DescriptorUpdateBatch::Prepare does everything Flush does except call vkUpdateDescriptorSets, so these tests need no device.
+// Handles are made up values (never passed to Vulkan).  Every batch skips redundant writes unless the test says otherwise.
+
+#include "frameworkTest.hpp"
+#include "vulkan/descriptorUpdateBatch.hpp"
+#include <thread>
+#include <vector>
+
+namespace
+{
+    template<typename T_HANDLE>
+    T_HANDLE FakeHandle(uint64_t value)
+    {
+        return (T_HANDLE) (uintptr_t) value;
+    }
+
+    VkDescriptorImageInfo ImageInfo(uint64_t imageView)
+    {
+        return { FakeHandle<VkSampler>(0x5000), FakeHandle<VkImageView>(imageView), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+    }
+
+    VkDescriptorBufferInfo BufferInfo(uint64_t buffer, VkDeviceSize offset = 0)
+    {
+        return { FakeHandle<VkBuffer>(buffer), offset, 256 };
+    }
+}
+
+TEST_CASE(DescriptorUpdateBatch_BatchesWritesInQueueOrder)
+{
+    DescriptorUpdateBatch batch;
+    const VkDescriptorSet setA = FakeHandle<VkDescriptorSet>(0x100);
+    const VkDescriptorSet setB = FakeHandle<VkDescriptorSet>(0x200);
+    const VkDescriptorImageInfo images[] = { ImageInfo(0x10), ImageInfo(0x11) };
+    const VkDescriptorBufferInfo buffer = BufferInfo(0x20);
+    batch.QueueImageWrite(setA, 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, images);
+    batch.QueueBufferWrite(setA, 1, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &buffer, 1 });
+    batch.QueueBufferWrite(setB, 0, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, { &buffer, 1 });
+
+    const auto prepared = batch.Prepare();
+    CHECK(prepared.NumQueued == 3);
+    CHECK(prepared.Writes.size() == 3);
+    CHECK(prepared.Writes[0].dstSet == setA && prepared.Writes[0].dstBinding == 0 && prepared.Writes[0].descriptorCount == 2);
+    CHECK(prepared.Writes[0].pImageInfo && prepared.Writes[0].pImageInfo[1].imageView == images[1].imageView);
+    CHECK(prepared.Writes[1].dstSet == setA && prepared.Writes[1].dstBinding == 1 && prepared.Writes[1].pBufferInfo->buffer == buffer.buffer);
+    CHECK(prepared.Writes[2].dstSet == setB && prepared.Writes[2].descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+
+    // Queue is empty after a Prepare.
+    CHECK(batch.Prepare().NumQueued == 0);
+}
+
+TEST_CASE(DescriptorUpdateBatch_DropsSupersededWrites)
+{
+    DescriptorUpdateBatch batch;
+    const VkDescriptorSet set = FakeHandle<VkDescriptorSet>(0x100);
+    for (uint64_t view = 0x10; view < 0x14; ++view)
+    {
+        const VkDescriptorImageInfo image = ImageInfo(view);
+        batch.QueueImageWrite(set, 0, 3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &image, 1 });
+    }
+    // Different element of the same binding is not superseded.
+    const VkDescriptorImageInfo other = ImageInfo(0x30);
+    batch.QueueImageWrite(set, 0, 4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &other, 1 });
+
+    const auto prepared = batch.Prepare();
+    CHECK(prepared.NumQueued == 5);
+    CHECK(prepared.NumSuperseded == 3);
+    CHECK(prepared.Writes.size() == 2);
+    CHECK(prepared.Writes[0].dstArrayElement == 3 && prepared.Writes[0].pImageInfo->imageView == FakeHandle<VkImageView>(0x13));
+    CHECK(prepared.Writes[1].dstArrayElement == 4);
+}
+
+TEST_CASE(DescriptorUpdateBatch_RedundantWritesSkippedByDefault)
+{
+    DescriptorUpdateBatch batch;
+    const VkDescriptorSet set = FakeHandle<VkDescriptorSet>(0x100);
+    const VkDescriptorBufferInfo buffer = BufferInfo(0x20);
+    for (int flush = 0; flush < 3; ++flush)
+    {
+        batch.QueueBufferWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &buffer, 1 });
+        const auto prepared = batch.Prepare();
+        CHECK(prepared.Writes.size() == (flush == 0 ? 1 : 0));
+    }
+    CHECK(batch.GetStats().Redundant == 2);
+
+    // Identical writes in separate flushes are all applied when skipping is disabled.
+    batch.SetSkipRedundantWrites(false);
+    for (int flush = 0; flush < 2; ++flush)
+    {
+        batch.QueueBufferWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &buffer, 1 });
+        const auto prepared = batch.Prepare();
+        CHECK(prepared.Writes.size() == 1 && prepared.NumRedundant == 0);
+    }
+}
+
+TEST_CASE(DescriptorUpdateBatch_ResourceDestroyedForgetsContents)
+{
+    // A destroyed resource's handle value may be reused by a new resource, so the same handle values must be written again.
+    DescriptorUpdateBatch batch;
+    const VkDescriptorSet set = FakeHandle<VkDescriptorSet>(0x100);
+    const VkDescriptorImageInfo image = ImageInfo(0x10);
+    batch.QueueImageWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &image, 1 });
+    CHECK(batch.Prepare().Writes.size() == 1);
+    batch.QueueImageWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &image, 1 });
+    CHECK(batch.Prepare().Writes.empty());
+
+    DescriptorUpdateBatch::NotifyResourceDestroyed();
+    batch.QueueImageWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &image, 1 });
+    CHECK(batch.Prepare().Writes.size() == 1);
+    // ... and tracked again from then on.
+    batch.QueueImageWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &image, 1 });
+    CHECK(batch.Prepare().Writes.empty());
+}
+
+TEST_CASE(DescriptorUpdateBatch_OverlappingWritesTracked)
+{
+    // Element ranges of a binding written by different sized writes (eg bindless arrays).
+    DescriptorUpdateBatch batch;
+    const VkDescriptorSet set = FakeHandle<VkDescriptorSet>(0x100);
+    const VkDescriptorImageInfo images[] = { ImageInfo(0x10), ImageInfo(0x11), ImageInfo(0x12), ImageInfo(0x13) };
+    for (uint32_t element = 0; element < 4; ++element)
+        batch.QueueImageWrite(set, 1, element, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &images[element], 1 });
+    CHECK(batch.Prepare().Writes.size() == 4);
+
+    // Rewriting elements 1 and 2 (with the same images) together is not known to be redundant, afterwards elements 0 and 3 still are.
+    batch.QueueImageWrite(set, 1, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &images[1], 2 });
+    CHECK(batch.Prepare().Writes.size() == 1);
+    batch.QueueImageWrite(set, 1, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &images[0], 1 });
+    batch.QueueImageWrite(set, 1, 3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &images[3], 1 });
+    batch.QueueImageWrite(set, 1, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &images[1], 2 });
+    auto prepared = batch.Prepare();
+    CHECK(prepared.Writes.empty() && prepared.NumRedundant == 3);
+
+    // A write covering the start of a tracked range makes that range unknown (element 1 was part of the 1-2 range).
+    batch.QueueImageWrite(set, 1, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &images[0], 2 });
+    batch.Prepare();
+    batch.QueueImageWrite(set, 1, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &images[1], 2 });
+    CHECK(batch.Prepare().Writes.size() == 1);
+    // Other bindings and sets are unaffected.
+    batch.QueueImageWrite(set, 1, 3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { &images[3], 1 });
+    CHECK(batch.Prepare().Writes.empty());
+}
+
+TEST_CASE(DescriptorUpdateBatch_SkipRedundantWrites)
+{
+    DescriptorUpdateBatch batch;
+    batch.SetSkipRedundantWrites(true);
+    const VkDescriptorSet set = FakeHandle<VkDescriptorSet>(0x100);
+    const VkDescriptorBufferInfo buffer = BufferInfo(0x20);
+    const VkDescriptorBufferInfo offsetBuffer = BufferInfo(0x20, 256);
+
+    batch.QueueBufferWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &buffer, 1 });
+    CHECK(batch.Prepare().Writes.size() == 1);
+
+    // Same contents again, dropped.
+    batch.QueueBufferWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &buffer, 1 });
+    auto prepared = batch.Prepare();
+    CHECK(prepared.Writes.empty() && prepared.NumRedundant == 1);
+
+    // Different offset is a real change.
+    batch.QueueBufferWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &offsetBuffer, 1 });
+    CHECK(batch.Prepare().Writes.size() == 1);
+
+    // After forgetting the set (eg it was freed and the handle reused) the same contents are written again.
+    batch.ForgetDescriptorSets({ &set, 1 });
+    batch.QueueBufferWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &offsetBuffer, 1 });
+    CHECK(batch.Prepare().Writes.size() == 1);
+
+    // Likewise after InvalidateCache (eg a bound buffer was destroyed and recreated with the same handle value).
+    batch.InvalidateCache();
+    batch.QueueBufferWrite(set, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &offsetBuffer, 1 });
+    CHECK(batch.Prepare().Writes.size() == 1);
+
+    // A write overlapping a tracked range makes that range unknown.
+    const VkDescriptorBufferInfo buffers[] = { BufferInfo(0x21), BufferInfo(0x22) };
+    batch.QueueBufferWrite(set, 2, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, buffers);
+    batch.Prepare();
+    batch.QueueBufferWrite(set, 2, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, { &buffers[1], 1 });
+    batch.Prepare();
+    batch.QueueBufferWrite(set, 2, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, buffers);
+    CHECK(batch.Prepare().Writes.size() == 1);
+
+    CHECK(batch.GetStats().Redundant == 1);
+}
+
+TEST_CASE(DescriptorUpdateBatch_ForgetDropsQueuedWrites)
+{
+    DescriptorUpdateBatch batch;
+    const VkDescriptorSet setA = FakeHandle<VkDescriptorSet>(0x100);
+    const VkDescriptorSet setB = FakeHandle<VkDescriptorSet>(0x200);
+    const VkDescriptorBufferInfo buffer = BufferInfo(0x20);
+    batch.QueueBufferWrite(setA, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &buffer, 1 });
+    batch.QueueBufferWrite(setB, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &buffer, 1 });
+    batch.ForgetDescriptorSets({ &setA, 1 });
+    const auto prepared = batch.Prepare();
+    CHECK(prepared.Writes.size() == 1 && prepared.Writes[0].dstSet == setB);
+}
+
+TEST_CASE(DescriptorUpdateBatch_QueueFromManyThreads)
+{
+    DescriptorUpdateBatch batch;
+    const uint32_t numThreads = 4;
+    const uint32_t writesPerThread = 1000;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < numThreads; ++t)
+        threads.emplace_back([&batch, t]() {
+            const VkDescriptorSet set = FakeHandle<VkDescriptorSet>(0x1000 + t);
+            for (uint32_t i = 0; i < writesPerThread; ++i)
+            {
+                const VkDescriptorBufferInfo buffer = BufferInfo(0x20, i * 256);
+                batch.QueueBufferWrite(set, 0, i, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, { &buffer, 1 });
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    const auto prepared = batch.Prepare();
+    CHECK(prepared.Writes.size() == numThreads * writesPerThread);
+    // Each thread's writes stay in the order it queued them.
+    std::vector<uint32_t> nextElement(numThreads, 0);
+    bool inOrder = true;
+    for (const auto& write : prepared.Writes)
+    {
+        const uint32_t t = uint32_t((uintptr_t) write.dstSet - 0x1000);
+        inOrder &= write.dstArrayElement == nextElement[t]++;
+    }
+    CHECK(inOrder);
+    CHECK(batch.GetStats().Queued == numThreads * writesPerThread);
+}
@@ -263,6 +263,10 @@ bool Application::LoadMeshObjects()
             const auto* pComputeShader = m_ShaderManager->GetShader("VarianceShadowMap");
             assert(pComputeShader);
 
+            // Blur is clamped to the (cascade) tile of the shadow map.
+            uint32_t tileX, tileY, tileWidth, tileHeight;
+            m_Shadows[0].GetCascadeTile(0, tileX, tileY, tileWidth, tileHeight);
+
             auto material = m_MaterialManager->CreateMaterial(*pComputeShader, NUM_VULKAN_BUFFERS,
                 [this](const std::string& texName) -> MaterialManagerBase::tPerFrameTexInfo {
                     if (texName == "ShadowDepth")
@@ -274,6 +278,14 @@ bool Application::LoadMeshObjects()
                 },
                 [this](const std::string& bufferName) -> PerFrameBufferVulkan {
                     return { m_ComputeCtrlUniform.buf.GetVkBuffer() };
+                }, nullptr, nullptr,
+                [tileWidth, tileHeight](const std::string& constantName) -> const VertexElementData {
+                    if (constantName == "TileWidth")
+                        return VertexElementData{ VertexFormat::Element::ElementType::t::Int32, (int)tileWidth };
+                    else if (constantName == "TileHeight")
+                        return VertexElementData{ VertexFormat::Element::ElementType::t::Int32, (int)tileHeight };
+                    assert(0);
+                    return {};
                 });
 
             auto vsmComputable = std::make_unique<Computable>(*pVulkan, std::move(material));
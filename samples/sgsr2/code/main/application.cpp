@@ -230,6 +230,7 @@ bool Application::InitializeCamera()
     m_Camera.SetAspect(float(gRenderWidth) / float(gRenderHeight));
     m_Camera.SetFov(gFov * TO_RADIANS);
     m_Camera.SetClipPlanes(gNearPlane, gFarPlane);
+    m_Camera.Temporal().SetRenderSize(gRenderWidth, gRenderHeight);
 
     // Camera Controller //
 
@@ -892,32 +893,25 @@ void Application::Render(float fltDiffTime)
 
     UpdateGui();
 
-    const auto prev_view_proj_matrix = m_Camera.ProjectionMatrixNoJitter() * m_Camera.ViewMatrix();
-
-    // Update camera
-    switch (gUpscaleMode)
+    // Update camera, jittered (Halton 2,3, as SGSR2 expects) when upscaling
+    const auto jitterSequence = gUpscaleMode == 0 ? TemporalContext::JitterSequence::None : TemporalContext::JitterSequence::Halton23;
+    if (m_Camera.Temporal().GetJitterSequenceType() != jitterSequence)
     {
-        case 0:
-        default:
-            break;
-        case 1:
-            m_Camera.SetJitter(m_sgsr2_context->GetJitter() / glm::vec2(gRenderWidth, gRenderHeight));
-            break;
-        case 2:
-            m_Camera.SetJitter(m_sgsr2_context_frag->GetJitter() / glm::vec2(gRenderWidth, gRenderHeight));
-            break;
-    } 
+        m_Camera.Temporal().SetJitterSequence(jitterSequence, 32);
+        m_Camera.SetJitter(glm::vec2(0.0f));
+    }
 
     static float cameraSpeedFactor = 1.0f;
     cameraSpeedFactor = std::max(0.25f, cameraSpeedFactor + ImGui::GetIO().MouseWheel * 0.25f);
 
     m_Camera.UpdateController(fltDiffTime * cameraSpeedFactor, *m_CameraController);
+    m_Camera.BeginFrame();
     m_Camera.UpdateMatrices();
     
     // Update uniform buffers with latest data
     UpdateUniforms(whichBuffer);
-    m_sgsr2_context->UpdateUniforms( *GetVulkan(), m_Camera, prev_view_proj_matrix );
-    m_sgsr2_context_frag->UpdateUniforms( *GetVulkan(), m_Camera, prev_view_proj_matrix );
+    m_sgsr2_context->UpdateUniforms( *GetVulkan(), m_Camera );
+    m_sgsr2_context_frag->UpdateUniforms( *GetVulkan(), m_Camera );
 
     // First time through, wait for the back buffer to be ready
     std::span<const VkSemaphore> pWaitSemaphores = { &currentVulkanBuffer.semaphore, 1 };
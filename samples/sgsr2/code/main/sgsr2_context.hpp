@@ -82,16 +82,12 @@ public:
 
     void UpdateUniforms(
         Vulkan&             vulkan,
-        const Camera&       camera,
-        const glm::mat4&    prev_view_proj_matrix);
+        const Camera&       camera);
 
     void Dispatch(
         Vulkan&,
         CommandListVulkan&);
 
-    /// @return Current camera jitter (in pixel offsets)
-    glm::vec2 GetJitter() const;
-
 protected:
     std::unique_ptr<Computable<Vulkan>> m_computable;
 
@@ -119,7 +115,6 @@ protected:
 
     std::unique_ptr<TextureVulkan>      m_scene_color_output;
 
-    int                                 m_jitter_index             = 0;
     int                                 m_buffer_index             = 0;
     uint32_t                            m_camera_still_frame_count = 0;
 };
@@ -13,6 +13,7 @@
 #include "mesh/meshHelper.hpp"
 #include "vulkan/commandBuffer.hpp"
 #include "memory/vulkan/uniform.hpp"
+#include "camera/temporalContext.hpp"
 #include <cassert>
 
 namespace
@@ -21,28 +22,6 @@ namespace
     {
         return (dividend + divisor - 1) / divisor;
     }
-
-    consteval float Halton( int32_t Index, int32_t Base )
-    {
-        float Result = 0.0f;
-        float InvBase = 1.0f / Base;
-        float Fraction = InvBase;
-        while (Index > 0) {
-            Result += (Index % Base) * Fraction;
-            Index /= Base;
-            Fraction *= InvBase;
-        }
-        return Result;
-    }
-    template<int32_t T_SIZE> std::array<glm::vec2, T_SIZE> consteval MakeHaltonArray( int32_t BaseX, int32_t BaseY )
-    {
-        std::array<glm::vec2, T_SIZE> Array;
-        int count = 0;
-        for (int32_t Index = 0; Index < T_SIZE; ++Index)
-            Array[Index] = {Halton( Index + 1, BaseX ) - 0.5f, Halton( Index + 1, BaseY ) - 0.5f};
-        return Array;
-    }
-    constexpr std::array<glm::vec2, 32> cJitterPositions = MakeHaltonArray<32>( 2, 3 );
 }
 
 SGSR2_Frag::Context::Context()
@@ -294,33 +273,11 @@ const TextureBase* const SGSR2_Frag::Context::GetSceneColorOutput() const
 
 void SGSR2_Frag::Context::UpdateUniforms(
     Vulkan&          vulkan, 
-    const Camera&    camera,
-    const glm::mat4& prev_view_proj_matrix)
+    const Camera&    camera)
 {
-    auto IsCameraStill = [](const glm::mat4& curVP, const glm::mat4& prevVP, float threshold=1e-5)
-    {
-        float vpDiff = 0;
-        for(int i = 0; i < 4; i++)
-        {
-            for(int j = 0; j < 4; j++)
-            {
-                vpDiff += abs(curVP[i][j] - prevVP[i][j]);
-            }
-        }
-        if (vpDiff < threshold) 
-        {
-            return true;
-        }
-        return false;
-    };
-
-    const auto camera_view                  = camera.ViewMatrix();
-    const auto camera_proj                  = camera.ProjectionMatrixNoJitter();
-    const auto curr_view_proj_matrix        = camera_proj * camera_view;
-    const auto inv_current_view_proj_matrix = glm::inverse( camera_view ) * glm::inverse( camera_proj );
-    const auto mt                           = prev_view_proj_matrix * inv_current_view_proj_matrix;
-
-    const bool is_camera_still              = IsCameraStill(curr_view_proj_matrix, prev_view_proj_matrix, 1e-5);
+    // Jitter, reprojection and history from the camera's temporal context (Camera::BeginFrame and UpdateMatrices have been called this frame)
+    const auto& temporal                    = camera.Temporal();
+    const bool is_camera_still              = temporal.IsCameraStill(1e-5f);
 
     m_camera_still_frame_count              = is_camera_still ? m_camera_still_frame_count + 1 : 0;
 
@@ -334,14 +291,14 @@ void SGSR2_Frag::Context::UpdateUniforms(
     m_upscaler_uniform_data.outputSizeRcp               = {
         1.0f / float(m_configuration.display_size.x),
         1.0f / float(m_configuration.display_size.y)};
-    m_upscaler_uniform_data.jitterOffset                = GetJitter();
+    m_upscaler_uniform_data.jitterOffset                = temporal.GetJitter();
     m_upscaler_uniform_data.scaleRatio                  = {
         float(m_configuration.display_size.x) / float(m_configuration.render_size.x),
         std::min(20.0f, pow( float(m_configuration.display_size.x * m_configuration.display_size.y) / float(m_configuration.render_size.x * m_configuration.render_size.y), 3.0f ))};
-    m_upscaler_uniform_data.clipToPrevClip              = mt;
+    m_upscaler_uniform_data.clipToPrevClip              = temporal.GetClipToPreviousClip();
     m_upscaler_uniform_data.cameraFovAngleHor           = camera_fov_angle_horizontal;
     m_upscaler_uniform_data.minLerpContribution         = m_camera_still_frame_count > 5 ? 0.3f : 0.0f;
-    m_upscaler_uniform_data.reset                       = false;
+    m_upscaler_uniform_data.reset                       = !temporal.HasHistory();
     m_upscaler_uniform_data.bSameCamera                 = is_camera_still ? 1 : 0;
 
     UpdateUniformBuffer(&vulkan, m_upscaler_uniform, m_upscaler_uniform_data, m_buffer_index % vulkan.m_SwapchainImageCount);
@@ -360,10 +317,4 @@ void SGSR2_Frag::Context::Dispatch(
     command_list.EndRenderPass();
 
     m_buffer_index = (m_buffer_index + 1) % (vulkan.m_SwapchainImageCount * 2);
-    m_jitter_index++;
-}
-
-glm::vec2 SGSR2_Frag::Context::GetJitter() const
-{
-    return cJitterPositions[m_jitter_index % cJitterPositions.size()];
 }
@@ -80,16 +80,12 @@ public:
 
     void UpdateUniforms(
         Vulkan&             vulkan,
-        const Camera&       camera,
-        const glm::mat4&    prev_view_proj_matrix);
+        const Camera&       camera);
 
     void Dispatch(
         Vulkan&,
         CommandListVulkan&);
 
-    /// @return Current camera jitter (in pixel offsets)
-    glm::vec2 GetJitter() const;
-
 protected:
 
     std::unique_ptr<Drawable<Vulkan>>   m_drawable;
@@ -111,7 +107,6 @@ protected:
     RenderContext<Vulkan>               m_convertRenderContext;
     RenderContext<Vulkan>               m_upscaleRenderContext[2];
 
-    int                                 m_jitter_index             = 0;
     int                                 m_buffer_index             = 0;
     uint32_t                            m_camera_still_frame_count = 0;
 };